@@ -193,6 +193,18 @@ dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create grab_retries telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&stats->bds_nvme_read_lat, D_TM_LOG_HISTOGRAM,
+			     "NVMe read latency distribution", "us",
+			     "dmabuff/nvme_read_lat/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create nvme_read_lat telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_nvme_write_lat, D_TM_LOG_HISTOGRAM,
+			     "NVMe write latency distribution", "us",
+			     "dmabuff/nvme_write_lat/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create nvme_write_lat telemetry: "DF_RC"\n", DP_RC(rc));
+
 }
 
 struct bio_dma_buffer *
@@ -1072,6 +1084,15 @@ rw_completion(void *cb_arg, int err)
 
 done:
 	if (biod->bd_inflights == 0) {
+		/* Only record the latency once per biod, from the first DMA issued */
+		if (biod->bd_result == 0 && biod->bd_dma_start != 0) {
+			struct bio_dma_stats *stats = &iod_dma_buf(biod)->bdb_stats;
+
+			d_tm_record_loghist(biod->bd_type == BIO_IOD_TYPE_UPDATE ?
+					    stats->bds_nvme_write_lat : stats->bds_nvme_read_lat,
+					    d_timeus_secdiff(0) - biod->bd_dma_start);
+		}
+		biod->bd_dma_start = 0;
 		iod_dma_completion(biod, err);
 		if (biod->bd_async_post && biod->bd_buffer_prep) {
 			iod_release_buffer(biod);
@@ -1183,6 +1204,8 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 
 		drain_inflight_ios(xs_ctxt, bxb);
 
+		if (!biod->bd_dma_issued)
+			biod->bd_dma_start = d_timeus_secdiff(0);
 		biod->bd_dma_issued = 1;
 		biod->bd_inflights++;
 		bio_io_lug_enqueue(xs_ctxt, bxb, &biod->bd_io_lug);
@@ -113,6 +113,8 @@ struct bio_dma_stats {
 	struct d_tm_node_t	*bds_queued_iods;
 	struct d_tm_node_t	*bds_grab_errs;
 	struct d_tm_node_t	*bds_grab_retries;
+	struct d_tm_node_t	*bds_nvme_read_lat;
+	struct d_tm_node_t	*bds_nvme_write_lat;
 };
 
 /*
@@ -495,6 +497,8 @@ struct bio_desc {
 	unsigned int		 bd_type;
 	/* Total bytes landed to data blob */
 	unsigned int		 bd_nvme_bytes;
+	/* When the first NVMe DMA transfer was issued, in us */
+	uint64_t		 bd_dma_start;
 	/* Flags */
 	unsigned int		 bd_buffer_prep:1,
 				 bd_dma_issued:1,
@@ -83,6 +83,234 @@ crt_bulk_desc_valid(struct crt_bulk_desc *bulk_desc)
 	}
 }
 
+int
+crt_bulk_cache_init(struct crt_context *ctx)
+{
+	struct crt_bulk_cache *cache = &ctx->cc_bulk_cache;
+	int                    i;
+
+	for (i = 0; i < ARRAY_SIZE(cache->bc_buckets); i++)
+		D_INIT_LIST_HEAD(&cache->bc_buckets[i]);
+	D_INIT_LIST_HEAD(&cache->bc_lru);
+	cache->bc_nr  = 0;
+	cache->bc_max = crt_gdata.cg_bulk_cache_size;
+
+	return D_MUTEX_INIT(&cache->bc_mutex, NULL);
+}
+
+static inline d_list_t *
+crt_bulk_cache_bucket(struct crt_bulk_cache *cache, uint64_t start, uint64_t len)
+{
+	uint64_t key[2] = {start, len};
+	uint64_t hash;
+
+	hash = d_hash_murmur64((unsigned char *)key, sizeof(key), 0);
+	return &cache->bc_buckets[hash & (ARRAY_SIZE(cache->bc_buckets) - 1)];
+}
+
+/* Unlink an entry, caller drops the cache reference once the lock is released */
+static void
+crt_bulk_cache_unlink(struct crt_context *ctx, struct crt_bulk_cache_entry *ent, d_list_t *victims)
+{
+	d_list_del(&ent->be_hash_link);
+	d_list_move_tail(&ent->be_lru_link, victims);
+	ctx->cc_bulk_cache.bc_nr--;
+	CRT_METRIC_INC(ctx, CM_BULK_CACHE_EVICT);
+}
+
+static void
+crt_bulk_cache_release(d_list_t *victims)
+{
+	struct crt_bulk_cache_entry *ent;
+	hg_return_t                  hg_ret;
+
+	while ((ent = d_list_pop_entry(victims, struct crt_bulk_cache_entry, be_lru_link))) {
+		hg_ret = HG_Bulk_free(ent->be_hdl);
+		if (hg_ret != HG_SUCCESS)
+			D_ERROR("HG_Bulk_free() failed (%s)\n", HG_Error_to_string(hg_ret));
+		D_FREE(ent);
+	}
+}
+
+/* Flush and disable the cache, must be called before the HG context is finalized */
+void
+crt_bulk_cache_fini(struct crt_context *ctx)
+{
+	struct crt_bulk_cache       *cache = &ctx->cc_bulk_cache;
+	struct crt_bulk_cache_entry *ent;
+	struct crt_bulk_cache_entry *tmp;
+	d_list_t                     victims;
+
+	D_INIT_LIST_HEAD(&victims);
+
+	D_MUTEX_LOCK(&cache->bc_mutex);
+	cache->bc_max = 0;
+	d_list_for_each_entry_safe(ent, tmp, &cache->bc_lru, be_lru_link)
+		crt_bulk_cache_unlink(ctx, ent, &victims);
+	D_MUTEX_UNLOCK(&cache->bc_mutex);
+
+	crt_bulk_cache_release(&victims);
+}
+
+static struct crt_bulk_cache_entry *
+crt_bulk_cache_find(d_list_t *bucket, uint64_t start, uint64_t len, crt_bulk_perm_t perm)
+{
+	struct crt_bulk_cache_entry *ent;
+
+	d_list_for_each_entry(ent, bucket, be_hash_link) {
+		if (ent->be_start == start && ent->be_len == len && ent->be_perm == perm)
+			return ent;
+	}
+	return NULL;
+}
+
+/*
+ * Create a mercury bulk handle for \a sgl, reusing a cached registration of the
+ * same range when possible. \a cached is set if the returned handle is shared
+ * with the cache.
+ */
+static int
+crt_bulk_cache_create(struct crt_context *ctx, d_sg_list_t *sgl, crt_bulk_perm_t bulk_perm,
+		      hg_bulk_t *hdl, bool *cached)
+{
+	struct crt_bulk_cache       *cache = &ctx->cc_bulk_cache;
+	struct crt_bulk_cache_entry *ent;
+	d_list_t                    *bucket;
+	d_list_t                     victims;
+	uint64_t                     start;
+	uint64_t                     len;
+	hg_return_t                  hg_ret;
+	int                          rc;
+
+	*cached = false;
+
+	/* Only contiguous buffers are cached, it covers the large buffer reuse case */
+	if (cache->bc_max == 0 || sgl->sg_nr != 1)
+		return crt_hg_bulk_create(&ctx->cc_hg_ctx, sgl, bulk_perm, hdl);
+
+	start  = (uint64_t)sgl->sg_iovs[0].iov_buf;
+	len    = sgl->sg_iovs[0].iov_buf_len;
+	bucket = crt_bulk_cache_bucket(cache, start, len);
+
+	D_MUTEX_LOCK(&cache->bc_mutex);
+	ent = crt_bulk_cache_find(bucket, start, len, bulk_perm);
+	if (ent != NULL) {
+		hg_ret = HG_Bulk_ref_incr(ent->be_hdl);
+		if (hg_ret == HG_SUCCESS) {
+			d_list_move(&ent->be_lru_link, &cache->bc_lru);
+			*hdl = ent->be_hdl;
+			D_MUTEX_UNLOCK(&cache->bc_mutex);
+
+			*cached = true;
+			CRT_METRIC_INC(ctx, CM_BULK_CACHE_HIT);
+			return 0;
+		}
+		D_ERROR("HG_Bulk_ref_incr() failed (%s)\n", HG_Error_to_string(hg_ret));
+	}
+	D_MUTEX_UNLOCK(&cache->bc_mutex);
+
+	CRT_METRIC_INC(ctx, CM_BULK_CACHE_MISS);
+
+	rc = crt_hg_bulk_create(&ctx->cc_hg_ctx, sgl, bulk_perm, hdl);
+	if (rc != 0)
+		return rc;
+
+	/* failing to cache the new handle is not fatal */
+	D_ALLOC_PTR(ent);
+	if (ent == NULL)
+		return 0;
+
+	hg_ret = HG_Bulk_ref_incr(*hdl);
+	if (hg_ret != HG_SUCCESS) {
+		D_FREE(ent);
+		return 0;
+	}
+
+	ent->be_start = start;
+	ent->be_len   = len;
+	ent->be_perm  = bulk_perm;
+	ent->be_hdl   = *hdl;
+	D_INIT_LIST_HEAD(&victims);
+
+	D_MUTEX_LOCK(&cache->bc_mutex);
+	/* lost a race with another creator, or the cache was disabled meanwhile */
+	if (cache->bc_max == 0 || crt_bulk_cache_find(bucket, start, len, bulk_perm) != NULL) {
+		d_list_add(&ent->be_lru_link, &victims);
+	} else {
+		d_list_add(&ent->be_hash_link, bucket);
+		d_list_add(&ent->be_lru_link, &cache->bc_lru);
+		cache->bc_nr++;
+		*cached = true;
+
+		while (cache->bc_nr > cache->bc_max) {
+			ent = d_list_entry(cache->bc_lru.prev, struct crt_bulk_cache_entry,
+					   be_lru_link);
+			crt_bulk_cache_unlink(ctx, ent, &victims);
+		}
+	}
+	D_MUTEX_UNLOCK(&cache->bc_mutex);
+
+	crt_bulk_cache_release(&victims);
+	return 0;
+}
+
+static void
+crt_bulk_cache_ctx_invalidate(struct crt_context *ctx, uint64_t start, uint64_t len)
+{
+	struct crt_bulk_cache       *cache = &ctx->cc_bulk_cache;
+	struct crt_bulk_cache_entry *ent;
+	struct crt_bulk_cache_entry *tmp;
+	d_list_t                     victims;
+
+	D_INIT_LIST_HEAD(&victims);
+
+	D_MUTEX_LOCK(&cache->bc_mutex);
+	d_list_for_each_entry_safe(ent, tmp, &cache->bc_lru, be_lru_link) {
+		if (len == 0 || (ent->be_start < start + len && start < ent->be_start + ent->be_len))
+			crt_bulk_cache_unlink(ctx, ent, &victims);
+	}
+	D_MUTEX_UNLOCK(&cache->bc_mutex);
+
+	crt_bulk_cache_release(&victims);
+}
+
+int
+crt_bulk_cache_invalidate(void *buf, size_t len)
+{
+	struct crt_context *ctx;
+	d_list_t           *ctx_list;
+	int                 i;
+
+	if ((buf == NULL) != (len == 0)) {
+		D_ERROR("invalid parameter, buf: %p, len: %zu.\n", buf, len);
+		return -DER_INVAL;
+	}
+
+	if (!crt_initialized()) {
+		D_ERROR("CRT not initialized.\n");
+		return -DER_UNINIT;
+	}
+
+	if (crt_gdata.cg_bulk_cache_size == 0)
+		return 0;
+
+	D_RWLOCK_RDLOCK(&crt_gdata.cg_rwlock);
+
+	ctx_list = crt_provider_get_ctx_list(true, crt_gdata.cg_primary_prov);
+	d_list_for_each_entry(ctx, ctx_list, cc_link)
+		crt_bulk_cache_ctx_invalidate(ctx, (uint64_t)buf, len);
+
+	for (i = 0; i < crt_gdata.cg_num_secondary_provs; i++) {
+		ctx_list = crt_provider_get_ctx_list(false, crt_gdata.cg_secondary_provs[i]);
+		d_list_for_each_entry(ctx, ctx_list, cc_link)
+			crt_bulk_cache_ctx_invalidate(ctx, (uint64_t)buf, len);
+	}
+
+	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
+
+	return 0;
+}
+
 int
 crt_bulk_create(crt_context_t crt_ctx, d_sg_list_t *sgl,
 		crt_bulk_perm_t bulk_perm, crt_bulk_t *bulk_hdl)
@@ -134,10 +362,11 @@ crt_bulk_create(crt_context_t crt_ctx, d_sg_list_t *sgl,
 		D_GOTO(out, rc = DER_SUCCESS);
 	}
 
-	ret_hdl->deferred = false;
-	ret_hdl->crt_ctx  = crt_ctx;
+	ret_hdl->deferred  = false;
+	ret_hdl->crt_ctx   = crt_ctx;
+	ret_hdl->bulk_perm = bulk_perm;
 
-	rc = crt_hg_bulk_create(&ctx->cc_hg_ctx, sgl, bulk_perm, &ret_hdl->hg_bulk_hdl);
+	rc = crt_bulk_cache_create(ctx, sgl, bulk_perm, &ret_hdl->hg_bulk_hdl, &ret_hdl->cached);
 	if (rc != 0) {
 		CRT_METRIC_INC(ctx, CM_BULK_CREATE_FAILED);
 		D_ERROR("crt_hg_bulk_create() failed, rc: " DF_RC "\n", DP_RC(rc));
@@ -156,6 +385,29 @@ out:
 	return rc;
 }
 
+/* Replace a handle shared with the bulk cache by a private registration */
+static int
+crt_bulk_uncache(struct crt_bulk *bulk, struct crt_context *ctx)
+{
+	d_iov_t     iov;
+	d_sg_list_t sgl = {.sg_nr = 1, .sg_iovs = &iov};
+	hg_bulk_t   hdl;
+	int         rc;
+
+	rc = crt_hg_bulk_access(bulk->hg_bulk_hdl, &sgl);
+	if (rc != 0)
+		return rc;
+
+	rc = crt_hg_bulk_create(&ctx->cc_hg_ctx, &sgl, bulk->bulk_perm, &hdl);
+	if (rc != 0)
+		return rc;
+
+	HG_Bulk_free(bulk->hg_bulk_hdl);
+	bulk->hg_bulk_hdl = hdl;
+	bulk->cached      = false;
+	return 0;
+}
+
 int
 crt_bulk_bind(crt_bulk_t crt_bulk, crt_context_t crt_ctx)
 {
@@ -173,6 +425,13 @@ crt_bulk_bind(crt_bulk_t crt_bulk, crt_context_t crt_ctx)
 		D_GOTO(out, rc = DER_SUCCESS);
 	}
 
+	/* binding modifies the handle, don't do it on one shared with the cache */
+	if (bulk->cached) {
+		rc = crt_bulk_uncache(bulk, ctx);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
 	rc = crt_hg_bulk_bind(bulk->hg_bulk_hdl, &ctx->cc_hg_ctx);
 	if (rc != 0) {
 		D_ERROR("crt_hg_bulk_bind() failed, rc: %d.\n", rc);
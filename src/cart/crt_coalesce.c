@@ -0,0 +1,618 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of CaRT. It implements the coalescing of small RPCs sent
+ * to the same endpoint into a single CRT_OPC_COALESCE request.
+ *
+ * On the origin, crt_req_send() of an RPC registered with
+ * CRT_RPC_FEAT_COALESCE goes through the usual tracking (quota, credits and
+ * timeout) and address resolution, but instead of being forwarded, the RPC is
+ * queued per destination in the RPC_STATE_COALESCED state. The progress loop
+ * flushes a queue once it has waited for D_RPC_COALESCE_DELAY or is full: the
+ * request of each RPC, common header included, is packed into one iov of a
+ * CRT_OPC_COALESCE request. Its completion unpacks one reply per RPC and
+ * completes them one by one. An RPC which times out or is aborted while
+ * coalesced is completed right away and skipped by its batch.
+ *
+ * On the target, crt_hdlr_coalesce() unpacks each request and dispatches it
+ * as if it was received on its own. crt_reply_send() of such an RPC packs its
+ * reply into the slot of the batch reply, which is sent once all of them have
+ * replied. The RPCs share the mercury handle of the batch, and hold a
+ * reference on it, so that bulk transfers behave as usual.
+ */
+#define D_LOGFAC	DD_FAC(rpc)
+
+#include "crt_internal.h"
+
+/* a batch in flight, argument of crt_coalesce_batch_cb() */
+struct crt_coalesce_batch {
+	uint32_t		 ccb_nr;
+	struct crt_rpc_priv	*ccb_rpcs[];
+};
+
+int
+crt_coalesce_init(struct crt_context *ctx)
+{
+	struct crt_coalesce *cco = &ctx->cc_coalesce;
+	int                  i;
+
+	for (i = 0; i < ARRAY_SIZE(cco->cco_buckets); i++)
+		D_INIT_LIST_HEAD(&cco->cco_buckets[i]);
+	D_INIT_LIST_HEAD(&cco->cco_active);
+	atomic_init(&cco->cco_nr, 0);
+
+	return D_MUTEX_INIT(&cco->cco_mutex, NULL);
+}
+
+static inline d_list_t *
+crt_coalesce_bucket(struct crt_coalesce *cco, d_rank_t rank, uint32_t tag)
+{
+	uint64_t key = ((uint64_t)rank << 32) | tag;
+	uint64_t hash;
+
+	hash = d_hash_murmur64((unsigned char *)&key, sizeof(key), 0);
+	return &cco->cco_buckets[hash & (ARRAY_SIZE(cco->cco_buckets) - 1)];
+}
+
+bool
+crt_coalesce_enabled(struct crt_rpc_priv *rpc_priv)
+{
+	return crt_gdata.cg_coalesce_delay != 0 && rpc_priv->crp_opc_info->coi_coalesce &&
+	       !rpc_priv->crp_coalesce_flushed && !rpc_priv->crp_coll && !rpc_priv->crp_forward;
+}
+
+/*
+ * Complete a coalesced RPC which could not be sent, and drop the reference
+ * taken by crt_coalesce_add().
+ */
+static void
+crt_coalesce_fail(struct crt_rpc_priv *rpc_priv, int rc)
+{
+	crt_rpc_lock(rpc_priv);
+	if (rpc_priv->crp_state == RPC_STATE_COALESCED) {
+		rpc_priv->crp_state = RPC_STATE_INITED;
+		crt_context_req_untrack(rpc_priv);
+		crt_rpc_complete_and_unlock(rpc_priv, rc);
+	} else {
+		crt_rpc_unlock(rpc_priv);
+	}
+	RPC_DECREF(rpc_priv);
+}
+
+void
+crt_coalesce_fini(struct crt_context *ctx)
+{
+	struct crt_coalesce       *cco = &ctx->cc_coalesce;
+	struct crt_coalesce_queue *ccq;
+	struct crt_coalesce_queue *tmp;
+	struct crt_rpc_priv       *rpc_priv;
+	d_list_t                   queues;
+
+	D_INIT_LIST_HEAD(&queues);
+
+	D_MUTEX_LOCK(&cco->cco_mutex);
+	d_list_for_each_entry_safe(ccq, tmp, &cco->cco_active, ccq_link) {
+		d_list_del(&ccq->ccq_hash_link);
+		d_list_move_tail(&ccq->ccq_link, &queues);
+	}
+	atomic_store_relaxed(&cco->cco_nr, 0);
+	D_MUTEX_UNLOCK(&cco->cco_mutex);
+
+	while ((ccq = d_list_pop_entry(&queues, struct crt_coalesce_queue, ccq_link))) {
+		while ((rpc_priv = d_list_pop_entry(&ccq->ccq_rpcs, struct crt_rpc_priv,
+						    crp_coalesce_link)))
+			crt_coalesce_fail(rpc_priv, -DER_CANCELED);
+		D_FREE(ccq);
+	}
+}
+
+/*
+ * Queue \a rpc_priv, tracked and with its address resolved, instead of sending
+ * it. Called with the rpc lock held, so the queue is never flushed from here.
+ */
+int
+crt_coalesce_add(struct crt_rpc_priv *rpc_priv)
+{
+	struct crt_context        *ctx = rpc_priv->crp_pub.cr_ctx;
+	struct crt_coalesce       *cco = &ctx->cc_coalesce;
+	struct crt_coalesce_queue *ccq;
+	d_list_t                  *bucket;
+	d_rank_t                   rank;
+	uint32_t                   tag;
+
+	rank   = crt_grp_priv_get_primary_rank(rpc_priv->crp_grp_priv,
+					       rpc_priv->crp_pub.cr_ep.ep_rank);
+	tag    = rpc_priv->crp_pub.cr_ep.ep_tag;
+	bucket = crt_coalesce_bucket(cco, rank, tag);
+
+	D_MUTEX_LOCK(&cco->cco_mutex);
+	d_list_for_each_entry(ccq, bucket, ccq_hash_link) {
+		if (ccq->ccq_rank == rank && ccq->ccq_tag == tag)
+			goto found;
+	}
+
+	D_ALLOC_PTR(ccq);
+	if (ccq == NULL) {
+		D_MUTEX_UNLOCK(&cco->cco_mutex);
+		return -DER_NOMEM;
+	}
+	D_INIT_LIST_HEAD(&ccq->ccq_rpcs);
+	ccq->ccq_rank     = rank;
+	ccq->ccq_tag      = tag;
+	ccq->ccq_deadline = d_timeus_secdiff(0) + crt_gdata.cg_coalesce_delay;
+	d_list_add(&ccq->ccq_hash_link, bucket);
+	/* all queues wait for the same delay, so the list stays ordered by deadline */
+	d_list_add_tail(&ccq->ccq_link, &cco->cco_active);
+
+found:
+	/* released once the RPC is completed by its batch, or skipped */
+	RPC_ADDREF(rpc_priv);
+	rpc_priv->crp_state = RPC_STATE_COALESCED;
+	d_list_add_tail(&rpc_priv->crp_coalesce_link, &ccq->ccq_rpcs);
+	ccq->ccq_nr++;
+	atomic_fetch_add(&cco->cco_nr, 1);
+
+	/* full, have it flushed by the next progress call */
+	if (ccq->ccq_nr >= crt_gdata.cg_coalesce_max && ccq->ccq_deadline != 0) {
+		ccq->ccq_deadline = 0;
+		d_list_move(&ccq->ccq_link, &cco->cco_active);
+	}
+	D_MUTEX_UNLOCK(&cco->cco_mutex);
+
+	RPC_TRACE(DB_TRACE, rpc_priv, "queued for coalescing to rank %u tag %u.\n", rank, tag);
+	return 0;
+}
+
+/* Complete the coalesced \a rpc_priv with the reply packed in \a iov, or with \a rc */
+static void
+crt_coalesce_complete(struct crt_rpc_priv *rpc_priv, d_iov_t *iov, int rc)
+{
+	crt_rpc_lock(rpc_priv);
+
+	/* timed out or aborted while the batch was in flight */
+	if (rpc_priv->crp_state != RPC_STATE_COALESCED) {
+		crt_rpc_unlock(rpc_priv);
+		goto out;
+	}
+
+	if (rc == 0) {
+		rc = crt_hg_unpack_coalesced_reply(rpc_priv, iov);
+		if (rc == 0)
+			rc = rpc_priv->crp_reply_hdr.cch_rc;
+		/* HLC is checked during unpacking of the response */
+		if (rc == 0 && rpc_priv->crp_fail_hlc)
+			rc = -DER_HLC_SYNC;
+	}
+
+	rpc_priv->crp_state = (rc == -DER_CANCELED) ? RPC_STATE_CANCELED : RPC_STATE_COMPLETED;
+	crt_context_req_untrack(rpc_priv);
+	crt_rpc_complete_and_unlock(rpc_priv, rc);
+out:
+	/* reference taken by crt_coalesce_add() */
+	RPC_DECREF(rpc_priv);
+}
+
+static void
+crt_coalesce_batch_cb(const struct crt_cb_info *cb_info)
+{
+	struct crt_coalesce_batch *ccb = cb_info->cci_arg;
+	struct crt_coalesce_in    *in;
+	struct crt_coalesce_out   *out = NULL;
+	int                        rc  = cb_info->cci_rc;
+	int                        i;
+
+	in = crt_req_get(cb_info->cci_rpc);
+	if (rc == 0) {
+		out = crt_reply_get(cb_info->cci_rpc);
+		rc  = out->cco_rc;
+		if (rc == 0 && out->cco_replies.ca_count != ccb->ccb_nr) {
+			D_ERROR("batch of %u RPCs got %zu replies\n", ccb->ccb_nr,
+				out->cco_replies.ca_count);
+			rc = -DER_PROTO;
+		}
+	}
+
+	for (i = 0; i < ccb->ccb_nr; i++) {
+		crt_coalesce_complete(ccb->ccb_rpcs[i],
+				      rc == 0 ? &out->cco_replies.ca_arrays[i] : NULL, rc);
+		D_FREE(in->cci_reqs.ca_arrays[i].iov_buf);
+	}
+
+	D_FREE(in->cci_reqs.ca_arrays);
+	in->cci_reqs.ca_count = 0;
+	D_FREE(ccb);
+}
+
+/* Pack the RPCs of \a rpcs into one CRT_OPC_COALESCE request and send it */
+static void
+crt_coalesce_send_batch(struct crt_context *ctx, d_list_t *rpcs, uint32_t nr)
+{
+	struct crt_coalesce_batch *ccb = NULL;
+	struct crt_coalesce_in    *in;
+	struct crt_rpc_priv       *batch_priv;
+	struct crt_rpc_priv       *rpc_priv;
+	crt_rpc_t                 *batch = NULL;
+	uint32_t                   timeout = 0;
+	int                        rc;
+
+	rpc_priv = d_list_entry(rpcs->next, struct crt_rpc_priv, crp_coalesce_link);
+	rc       = crt_req_create(ctx, &rpc_priv->crp_pub.cr_ep, CRT_OPC_COALESCE, &batch);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	batch_priv = container_of(batch, struct crt_rpc_priv, crp_pub);
+	in         = crt_req_get(batch);
+
+	D_ALLOC(ccb, offsetof(struct crt_coalesce_batch, ccb_rpcs[nr]));
+	if (ccb == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	D_ALLOC_ARRAY(in->cci_reqs.ca_arrays, nr);
+	if (in->cci_reqs.ca_arrays == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	while ((rpc_priv = d_list_pop_entry(rpcs, struct crt_rpc_priv, crp_coalesce_link))) {
+		crt_rpc_lock(rpc_priv);
+		/* timed out or aborted while queued */
+		if (rpc_priv->crp_state != RPC_STATE_COALESCED) {
+			crt_rpc_unlock(rpc_priv);
+			RPC_DECREF(rpc_priv);
+			continue;
+		}
+
+		rc = crt_hg_pack_coalesced(rpc_priv, false, &in->cci_reqs.ca_arrays[ccb->ccb_nr]);
+		if (rc != 0) {
+			crt_rpc_unlock(rpc_priv);
+			crt_coalesce_fail(rpc_priv, rc);
+			continue;
+		}
+
+		/* released in crt_coalesce_req_destroy() */
+		RPC_ADDREF(batch_priv);
+		rpc_priv->crp_coalesce = batch_priv;
+		timeout                = max(timeout, rpc_priv->crp_timeout_sec);
+		crt_rpc_unlock(rpc_priv);
+
+		ccb->ccb_rpcs[ccb->ccb_nr++] = rpc_priv;
+	}
+	in->cci_reqs.ca_count = ccb->ccb_nr;
+
+	if (ccb->ccb_nr == 0) {
+		D_FREE(in->cci_reqs.ca_arrays);
+		D_FREE(ccb);
+		crt_req_decref(batch);
+		return;
+	}
+
+	crt_req_set_timeout(batch, timeout);
+	CRT_METRIC_INC(ctx, CM_RPC_COALESCE_BATCHES);
+	CRT_METRIC_ADD(ctx, CM_RPC_COALESCED, ccb->ccb_nr);
+	RPC_TRACE(DB_TRACE, batch_priv, "sending %u coalesced RPCs.\n", ccb->ccb_nr);
+
+	/* errors are reported through crt_coalesce_batch_cb() */
+	crt_req_send(batch, crt_coalesce_batch_cb, ccb);
+	return;
+
+out:
+	DL_ERROR(rc, "failed to coalesce %u RPCs", nr);
+	while ((rpc_priv = d_list_pop_entry(rpcs, struct crt_rpc_priv, crp_coalesce_link)))
+		crt_coalesce_fail(rpc_priv, rc);
+	if (batch != NULL) {
+		in = crt_req_get(batch);
+		D_FREE(in->cci_reqs.ca_arrays);
+		crt_req_decref(batch);
+	}
+	D_FREE(ccb);
+}
+
+/* Send a lone coalesced RPC on its own, as if it was never queued */
+static void
+crt_coalesce_send_one(struct crt_rpc_priv *rpc_priv)
+{
+	int rc;
+
+	crt_rpc_lock(rpc_priv);
+	if (rpc_priv->crp_state != RPC_STATE_COALESCED) {
+		crt_rpc_unlock(rpc_priv);
+		goto out;
+	}
+
+	rpc_priv->crp_state            = RPC_STATE_INITED;
+	rpc_priv->crp_coalesce_flushed = 1;
+	rc = crt_req_send_internal(rpc_priv);
+	if (rc != 0) {
+		RPC_ERROR(rpc_priv, "crt_req_send_internal() failed, " DF_RC "\n", DP_RC(rc));
+		crt_context_req_untrack(rpc_priv);
+		crt_rpc_complete_and_unlock(rpc_priv, rc);
+	} else {
+		crt_rpc_unlock(rpc_priv);
+	}
+out:
+	/* reference taken by crt_coalesce_add() */
+	RPC_DECREF(rpc_priv);
+}
+
+static void
+crt_coalesce_flush(struct crt_context *ctx, struct crt_coalesce_queue *ccq)
+{
+	struct crt_rpc_priv *rpc_priv;
+	d_list_t             rpcs;
+	uint32_t             nr;
+
+	while (!d_list_empty(&ccq->ccq_rpcs)) {
+		D_INIT_LIST_HEAD(&rpcs);
+		for (nr = 0; nr < crt_gdata.cg_coalesce_max; nr++) {
+			rpc_priv = d_list_pop_entry(&ccq->ccq_rpcs, struct crt_rpc_priv,
+						    crp_coalesce_link);
+			if (rpc_priv == NULL)
+				break;
+			d_list_add_tail(&rpc_priv->crp_coalesce_link, &rpcs);
+		}
+
+		if (nr == 1) {
+			rpc_priv = d_list_pop_entry(&rpcs, struct crt_rpc_priv, crp_coalesce_link);
+			crt_coalesce_send_one(rpc_priv);
+		} else {
+			crt_coalesce_send_batch(ctx, &rpcs, nr);
+		}
+	}
+}
+
+/* Flush the queues which have waited long enough, called by the progress loop */
+void
+crt_coalesce_progress(struct crt_context *ctx)
+{
+	struct crt_coalesce       *cco = &ctx->cc_coalesce;
+	struct crt_coalesce_queue *ccq;
+	struct crt_coalesce_queue *tmp;
+	d_list_t                   expired;
+	uint64_t                   now;
+
+	if (atomic_load_relaxed(&cco->cco_nr) == 0)
+		return;
+
+	D_INIT_LIST_HEAD(&expired);
+	now = d_timeus_secdiff(0);
+
+	D_MUTEX_LOCK(&cco->cco_mutex);
+	d_list_for_each_entry_safe(ccq, tmp, &cco->cco_active, ccq_link) {
+		if (ccq->ccq_deadline > now)
+			break;
+		d_list_del(&ccq->ccq_hash_link);
+		d_list_move_tail(&ccq->ccq_link, &expired);
+		atomic_fetch_sub(&cco->cco_nr, ccq->ccq_nr);
+	}
+	D_MUTEX_UNLOCK(&cco->cco_mutex);
+
+	while ((ccq = d_list_pop_entry(&expired, struct crt_coalesce_queue, ccq_link))) {
+		crt_coalesce_flush(ctx, ccq);
+		D_FREE(ccq);
+	}
+}
+
+/* Shorten the progress \a timeout (in us, negative for infinite) to the next flush */
+int64_t
+crt_coalesce_timeout(struct crt_context *ctx, int64_t timeout)
+{
+	struct crt_coalesce       *cco = &ctx->cc_coalesce;
+	struct crt_coalesce_queue *ccq;
+	uint64_t                   now;
+	int64_t                    remain = -1;
+
+	if (timeout == 0 || atomic_load_relaxed(&cco->cco_nr) == 0)
+		return timeout;
+
+	now = d_timeus_secdiff(0);
+
+	D_MUTEX_LOCK(&cco->cco_mutex);
+	ccq = d_list_pop_entry(&cco->cco_active, struct crt_coalesce_queue, ccq_link);
+	if (ccq != NULL) {
+		remain = ccq->ccq_deadline > now ? ccq->ccq_deadline - now : 0;
+		d_list_add(&ccq->ccq_link, &cco->cco_active);
+	}
+	D_MUTEX_UNLOCK(&cco->cco_mutex);
+
+	if (remain >= 0 && (timeout < 0 || remain < timeout))
+		return remain;
+	return timeout;
+}
+
+/* Release what a coalesced RPC holds in place of a mercury handle */
+void
+crt_coalesce_req_destroy(struct crt_rpc_priv *rpc_priv)
+{
+	struct crt_rpc_priv *batch = rpc_priv->crp_coalesce;
+
+	D_ASSERT(batch != NULL);
+	crt_hg_free_coalesced(rpc_priv);
+	rpc_priv->crp_coalesce = NULL;
+
+	/* reference taken when the RPC was attached to its batch */
+	RPC_DECREF(batch);
+}
+
+/* Drop one pending reply of \a batch, and send the batch reply after the last one */
+static void
+crt_coalesce_reply_put(struct crt_rpc_priv *batch)
+{
+	struct crt_coalesce_out *out;
+	int                      rc;
+	int                      i;
+
+	if (atomic_fetch_sub(&batch->crp_coalesce_pending, 1) != 1)
+		return;
+
+	rc = crt_reply_send(&batch->crp_pub);
+	if (rc != 0)
+		RPC_ERROR(batch, "crt_reply_send() failed, " DF_RC "\n", DP_RC(rc));
+
+	/* mercury has encoded the reply, the packed ones can go */
+	out = crt_reply_get(&batch->crp_pub);
+	for (i = 0; i < out->cco_replies.ca_count; i++)
+		D_FREE(out->cco_replies.ca_arrays[i].iov_buf);
+	D_FREE(out->cco_replies.ca_arrays);
+	out->cco_replies.ca_count = 0;
+}
+
+/*
+ * Pack the reply of \a rpc_priv, or only its common header carrying \a rc
+ * when it is not zero, into slot \a idx of the reply of \a batch.
+ */
+static int
+crt_coalesce_reply_fill(struct crt_rpc_priv *batch, uint32_t idx,
+			struct crt_rpc_priv *rpc_priv, int rc)
+{
+	struct crt_coalesce_out *out = crt_reply_get(&batch->crp_pub);
+	d_iov_t                 *slot = &out->cco_replies.ca_arrays[idx];
+
+	if (slot->iov_buf != NULL) {
+		RPC_ERROR(rpc_priv, "coalesced RPC already replied.\n");
+		return -DER_ALREADY;
+	}
+
+	if (rc != 0)
+		rpc_priv->crp_reply_hdr.cch_rc = rc;
+	rc = crt_hg_pack_coalesced(rpc_priv, true, slot);
+	if (rc != 0) {
+		/* at least let the origin know, the slot stays empty otherwise */
+		rpc_priv->crp_reply_hdr.cch_rc = rc;
+		crt_hg_pack_coalesced(rpc_priv, true, slot);
+	}
+
+	crt_coalesce_reply_put(batch);
+	return rc;
+}
+
+/* crt_reply_send() of an RPC unpacked from a batch */
+int
+crt_coalesce_reply(struct crt_rpc_priv *rpc_priv, int rc)
+{
+	D_ASSERT(rpc_priv->crp_srv);
+
+	rpc_priv->crp_reply_pending = 0;
+	return crt_coalesce_reply_fill(rpc_priv->crp_coalesce, rpc_priv->crp_coalesce_idx,
+				       rpc_priv, rc);
+}
+
+/* Unpack request \a idx of \a batch and dispatch it as if it was received on its own */
+static void
+crt_coalesce_dispatch(struct crt_rpc_priv *batch, uint32_t idx, d_iov_t *iov)
+{
+	struct crt_context  *ctx     = batch->crp_pub.cr_ctx;
+	struct crt_rpc_priv  rpc_tmp = {0};
+	struct crt_rpc_priv *rpc_priv;
+	crt_rpc_t           *rpc_pub;
+	crt_proc_t           proc = NULL;
+	int                  rc;
+
+	/* share the handle of the batch, for bulk transfers and the origin address */
+	rpc_tmp.crp_hg_addr    = batch->crp_hg_addr;
+	rpc_tmp.crp_hg_hdl     = batch->crp_hg_hdl;
+	rpc_tmp.crp_pub.cr_ctx = ctx;
+
+	CRT_METRIC_INC(ctx, CM_RPC_RECV);
+
+	rc = crt_hg_unpack_coalesced_header(iov, &rpc_tmp, &proc);
+	if (unlikely(rc != 0)) {
+		D_ERROR("crt_hg_unpack_coalesced_header failed, rc: %d.\n", rc);
+		crt_coalesce_reply_fill(batch, idx, &rpc_tmp, -DER_MISC);
+		return;
+	}
+
+	rc = crt_rpc_priv_alloc(rpc_tmp.crp_req_hdr.cch_opc, &rpc_priv, false /* forward */);
+	if (unlikely(rc != 0)) {
+		if (rc == -DER_NOMEM)
+			rc = -DER_DOS;
+		else
+			D_ERROR("crt_rpc_priv_alloc() failed, rc: %d.\n", rc);
+		crt_hg_unpack_cleanup(proc);
+		crt_coalesce_reply_fill(batch, idx, &rpc_tmp, rc);
+		return;
+	}
+
+	rc = crt_hg_process_header(&rpc_tmp, rpc_priv);
+	if (unlikely(rc != 0)) {
+		RPC_WARN(rpc_priv, "RPC expired. Deadline was %d\n", rpc_priv->crp_deadline_sec);
+		crt_hg_unpack_cleanup(proc);
+		crt_rpc_priv_free(rpc_priv);
+		crt_coalesce_reply_fill(batch, idx, &rpc_tmp, -DER_TIMEDOUT);
+		return;
+	}
+
+	rpc_pub                = &rpc_priv->crp_pub;
+	rpc_priv->crp_fail_hlc = rpc_tmp.crp_fail_hlc;
+	rpc_pub->cr_ep.ep_rank = rpc_priv->crp_req_hdr.cch_dst_rank;
+	rpc_pub->cr_ep.ep_tag  = rpc_priv->crp_req_hdr.cch_dst_tag;
+
+	crt_rpc_priv_init(rpc_priv, ctx, true /* srv_flag */);
+
+	/* from now on the reply goes to the batch, see crt_coalesce_reply() */
+	RPC_ADDREF(batch);
+	rpc_priv->crp_coalesce     = batch;
+	rpc_priv->crp_coalesce_idx = idx;
+
+	if (unlikely(rpc_priv->crp_flags & CRT_RPC_FLAG_COLL)) {
+		RPC_ERROR(rpc_priv, "corpc cannot be coalesced.\n");
+		crt_hg_unpack_cleanup(proc);
+		D_GOTO(out, rc = -DER_PROTO);
+	}
+
+	if (rpc_pub->cr_input_size > 0) {
+		/* released by crt_hg_free_coalesced() */
+		rc = crt_hg_unpack_body(rpc_priv, proc);
+		if (rc == 0) {
+			rpc_priv->crp_input_got = 1;
+			rpc_pub->cr_ep.ep_grp   = NULL;
+		} else {
+			DHL_ERROR(rpc_priv, rc, "_unpack_body failed, opc: %#x", rpc_pub->cr_opc);
+			D_GOTO(out, rc = -DER_MISC);
+		}
+	} else {
+		crt_hg_unpack_cleanup(proc);
+	}
+
+	if (unlikely(rpc_priv->crp_opc_info->coi_rpc_cb == NULL))
+		D_GOTO(out, rc = -DER_UNREG);
+
+	if (unlikely(rpc_priv->crp_fail_hlc))
+		D_GOTO(out, rc = -DER_HLC_SYNC);
+
+	rc = crt_rpc_common_hdlr(rpc_priv);
+	if (unlikely(rc != 0))
+		RPC_INFO(rpc_priv, "failed to invoke RPC handler, rc: " DF_RC "\n", DP_RC(rc));
+
+out:
+	if (rc != 0) {
+		crt_coalesce_reply(rpc_priv, rc);
+		RPC_DECREF(rpc_priv);
+	}
+}
+
+void
+crt_hdlr_coalesce(crt_rpc_t *rpc_req)
+{
+	struct crt_rpc_priv     *batch = container_of(rpc_req, struct crt_rpc_priv, crp_pub);
+	struct crt_coalesce_in  *in    = crt_req_get(rpc_req);
+	struct crt_coalesce_out *out   = crt_reply_get(rpc_req);
+	uint32_t                 nr    = in->cci_reqs.ca_count;
+	uint32_t                 i;
+	int                      rc;
+
+	D_ALLOC_ARRAY(out->cco_replies.ca_arrays, nr);
+	if (out->cco_replies.ca_arrays == NULL) {
+		out->cco_rc = -DER_NOMEM;
+		rc          = crt_reply_send(rpc_req);
+		if (rc != 0)
+			D_ERROR("crt_reply_send() failed. rc: %d\n", rc);
+		return;
+	}
+	out->cco_replies.ca_count = nr;
+
+	/* one per RPC, plus one dropped once all of them are dispatched */
+	atomic_store_relaxed(&batch->crp_coalesce_pending, nr + 1);
+	for (i = 0; i < nr; i++)
+		crt_coalesce_dispatch(batch, i, &in->cci_reqs.ca_arrays[i]);
+	crt_coalesce_reply_put(batch);
+}
@@ -165,7 +165,11 @@ crt_context_add_counters(struct crt_context *ctx)
 	if (rc != 0)                                                                               \
 		DL_WARN(rc, "Failed to add metric " #name "\n");
 
-	CRT_METRICS_LIST;
+	if (crt_is_service()) {
+		CRT_METRICS_LIST;
+	} else if (crt_gdata.cg_bulk_cache_size != 0) {
+		CRT_BULK_CACHE_METRICS_LIST;
+	}
 #undef X
 }
 
@@ -215,10 +219,29 @@ crt_context_init(struct crt_context *ctx)
 		D_GOTO(out_binheap_destroy, rc);
 	}
 
+	rc = crt_bulk_cache_init(ctx);
+	if (rc != 0)
+		D_GOTO(out_epi_destroy, rc);
+
+	rc = crt_coalesce_init(ctx);
+	if (rc != 0)
+		D_GOTO(out_bulk_cache_destroy, rc);
+
+	rc = crt_local_init(ctx);
+	if (rc != 0)
+		D_GOTO(out_coalesce_destroy, rc);
+
 	context_quotas_init(ctx);
 
 	return 0;
 
+out_coalesce_destroy:
+	D_MUTEX_DESTROY(&ctx->cc_coalesce.cco_mutex);
+out_bulk_cache_destroy:
+	crt_bulk_cache_fini(ctx);
+	D_MUTEX_DESTROY(&ctx->cc_bulk_cache.bc_mutex);
+out_epi_destroy:
+	d_hash_table_destroy_inplace(&ctx->cc_epi_table, true /* force */);
 out_binheap_destroy:
 	d_binheap_destroy_inplace(&ctx->cc_bh_timeout);
 out_mutex_destroy:
@@ -313,8 +336,8 @@ crt_context_provider_create(crt_context_t *crt_ctx, crt_provider_t provider, boo
 
 	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
 
-	/** initialize sensors for servers */
-	if (crt_gdata.cg_use_sensors && crt_is_service()) {
+	/** initialize sensors for servers, and for the bulk cache of clients */
+	if (crt_gdata.cg_use_sensors) {
 		crt_context_add_counters(ctx);
 	}
 
@@ -830,6 +853,11 @@ crt_context_destroy(crt_context_t crt_ctx, int force)
 	if (!force && rc && i == CRT_SWIM_FLUSH_ATTEMPTS)
 		D_GOTO(out, rc);
 
+	/* cancel the RPCs still waiting to be coalesced */
+	crt_coalesce_fini(ctx);
+	/* and the ones delivered in process but not handled yet */
+	crt_local_fini(ctx);
+
 	if (crt_gdata.cg_swim_inited && crt_gdata.cg_swim_ctx_idx == ctx_idx)
 		crt_swim_fini();
 
@@ -852,6 +880,9 @@ crt_context_destroy(crt_context_t crt_ctx, int force)
 
 	provider = ctx->cc_hg_ctx.chc_provider;
 
+	/* drop the cached registrations before the HG class goes away */
+	crt_bulk_cache_fini(ctx);
+
 	rc = crt_hg_ctx_fini(&ctx->cc_hg_ctx);
 	if (rc) {
 		D_ERROR("crt_hg_ctx_fini failed() rc: " DF_RC "\n", DP_RC(rc));
@@ -867,6 +898,9 @@ crt_context_destroy(crt_context_t crt_ctx, int force)
 
 	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
 
+	D_MUTEX_DESTROY(&ctx->cc_local.cli_mutex);
+	D_MUTEX_DESTROY(&ctx->cc_coalesce.cco_mutex);
+	D_MUTEX_DESTROY(&ctx->cc_bulk_cache.bc_mutex);
 	D_MUTEX_DESTROY(&ctx->cc_mutex);
 	D_DEBUG(DB_TRACE, "destroyed context (idx %d, force %d)\n", ctx->cc_idx, force);
 	D_FREE(ctx);
@@ -1158,6 +1192,22 @@ crt_req_timeout_hdlr(struct crt_rpc_priv *rpc_priv)
 	crt_ctx = rpc_priv->crp_pub.cr_ctx;
 
 	switch (rpc_priv->crp_state) {
+	case RPC_STATE_COALESCED:
+		/* the batch skips RPCs which are no longer in the COALESCED state */
+		RPC_INFO(rpc_priv, "aborting coalesced rpc to group %s, tgt %d:%d\n",
+			 grp_priv->gp_pub.cg_grpid, tgt_ep->ep_rank, tgt_ep->ep_tag);
+		rpc_priv->crp_state = RPC_STATE_INITED;
+		crt_context_req_untrack(rpc_priv);
+		crt_rpc_complete_and_unlock(rpc_priv, -DER_TIMEDOUT);
+		break;
+	case RPC_STATE_LOCAL:
+		/* the handler may still run, its reply is dropped by crt_local_progress() */
+		RPC_INFO(rpc_priv, "aborting local rpc to tgt %d:%d\n", tgt_ep->ep_rank,
+			 tgt_ep->ep_tag);
+		rpc_priv->crp_state = RPC_STATE_INITED;
+		crt_context_req_untrack(rpc_priv);
+		crt_rpc_complete_and_unlock(rpc_priv, -DER_TIMEDOUT);
+		break;
 	case RPC_STATE_INITED:
 	case RPC_STATE_QUEUED:
 		RPC_INFO(rpc_priv, "aborting %s rpc to group %s, tgt %d:%d, tgt_uri %s\n",
@@ -1293,6 +1343,11 @@ crt_context_timeout_check(struct crt_context *crt_ctx)
 		RPC_DECREF(rpc_priv);
 	}
 
+	/* send the coalesced RPCs which have waited long enough */
+	crt_coalesce_progress(crt_ctx);
+	/* handle the RPCs delivered in process, and complete the ones sent from here */
+	crt_local_progress(crt_ctx);
+
 #ifdef HG_HAS_DIAG
 	/* periodically republish Mercury-level counters as DAOS metrics */
 	if (should_republish)
@@ -1316,6 +1371,7 @@ crt_context_req_track(struct crt_rpc_priv *rpc_priv)
 	int			 rc = 0;
 	int 			quota_rc = 0;
 	struct crt_grp_priv	*grp_priv;
+	bool			 coalesce;
 
 	D_ASSERT(crt_ctx != NULL);
 
@@ -1325,8 +1381,15 @@ crt_context_req_track(struct crt_rpc_priv *rpc_priv)
 		D_GOTO(out, rc = CRT_REQ_TRACK_IN_INFLIGHQ);
 	}
 
+	/*
+	 * The RPCs carried by a coalesced batch already hold the quota and the
+	 * credits, the batch must not wait for them.
+	 */
+	coalesce = (rpc_priv->crp_pub.cr_opc == CRT_OPC_COALESCE);
+
 	/* check inflight quota. if exceeded, queue this rpc */
-	quota_rc = get_quota_resource(rpc_priv->crp_pub.cr_ctx, CRT_QUOTA_RPCS);
+	if (!coalesce)
+		quota_rc = get_quota_resource(rpc_priv->crp_pub.cr_ctx, CRT_QUOTA_RPCS);
 
 	grp_priv = crt_grp_pub2priv(rpc_priv->crp_pub.cr_ep.ep_grp);
 	ep_rank = crt_grp_priv_get_primary_rank(grp_priv,
@@ -1383,7 +1446,7 @@ crt_context_req_track(struct crt_rpc_priv *rpc_priv)
 		epi->epi_req_num++;
 		rpc_priv->crp_state = RPC_STATE_QUEUED;
 		rc = CRT_REQ_TRACK_IN_WAITQ;
-	} else if (crt_gdata.cg_credit_ep_ctx != 0 &&
+	} else if (!coalesce && crt_gdata.cg_credit_ep_ctx != 0 &&
 	    (epi->epi_req_num - epi->epi_reply_num) >= crt_gdata.cg_credit_ep_ctx) {
 		if (rpc_priv->crp_opc_info->coi_queue_front)
 			d_list_add(&rpc_priv->crp_epi_link, &epi->epi_req_waitq);
@@ -1587,18 +1650,21 @@ crt_context_req_untrack(struct crt_rpc_priv *rpc_priv)
 	epi = rpc_priv->crp_epi;
 	D_ASSERT(epi != NULL);
 
+	D_INIT_LIST_HEAD(&submit_list);
+
 	/* Dispatch one rpc from wait_q if any or return resource back */
-	D_MUTEX_LOCK(&crt_ctx->cc_mutex);
-	tmp_rpc = d_list_pop_entry(&crt_ctx->cc_quotas.rpc_waitq,
-				   struct crt_rpc_priv, crp_waitq_link);
-	D_MUTEX_UNLOCK(&crt_ctx->cc_mutex);
+	if (rpc_priv->crp_pub.cr_opc != CRT_OPC_COALESCE) {
+		D_MUTEX_LOCK(&crt_ctx->cc_mutex);
+		tmp_rpc = d_list_pop_entry(&crt_ctx->cc_quotas.rpc_waitq,
+					   struct crt_rpc_priv, crp_waitq_link);
+		D_MUTEX_UNLOCK(&crt_ctx->cc_mutex);
 
-	D_INIT_LIST_HEAD(&submit_list);
-	if (tmp_rpc != NULL) {
-		add_rpc_to_list(tmp_rpc, &submit_list);
-		CRT_METRIC_DEC_GAUGE(crt_ctx, CM_RPC_WAITQ_DEPTH, 1);
-	} else {
-		put_quota_resource(rpc_priv->crp_pub.cr_ctx, CRT_QUOTA_RPCS);
+		if (tmp_rpc != NULL) {
+			add_rpc_to_list(tmp_rpc, &submit_list);
+			CRT_METRIC_DEC_GAUGE(crt_ctx, CM_RPC_WAITQ_DEPTH, 1);
+		} else {
+			put_quota_resource(rpc_priv->crp_pub.cr_ctx, CRT_QUOTA_RPCS);
+		}
 	}
 
 	crt_context_req_untrack_internal(rpc_priv);
@@ -1821,6 +1887,8 @@ crt_progress_legacy(struct crt_context *ctx, int64_t timeout)
 	crt_context_timeout_check(ctx);
 	if (ctx->cc_prog_cb != NULL)
 		timeout = ctx->cc_prog_cb(ctx, timeout, ctx->cc_prog_cb_arg);
+	timeout = crt_coalesce_timeout(ctx, timeout);
+	timeout = crt_local_timeout(ctx, timeout);
 
 	if (timeout != 0 && (rc == 0 || rc == -DER_TIMEDOUT)) {
 		/** call progress once again with the real timeout */
@@ -1841,6 +1909,8 @@ crt_progress_event(struct crt_context *ctx, int64_t timeout_us)
 	crt_context_timeout_check(ctx);
 	if (ctx->cc_prog_cb != NULL)
 		timeout_us = ctx->cc_prog_cb(ctx, timeout_us, ctx->cc_prog_cb_arg);
+	timeout_us = crt_coalesce_timeout(ctx, timeout_us);
+	timeout_us = crt_local_timeout(ctx, timeout_us);
 
 	if (timeout_us > 0) {
 		rc = d_gettime_coarse(&now);
@@ -1934,6 +2004,8 @@ crt_progress_cond_legacy(struct crt_context *ctx, int64_t timeout, crt_progress_
 			else
 				hg_timeout = timeout;
 		}
+		hg_timeout = crt_coalesce_timeout(ctx, hg_timeout);
+		hg_timeout = crt_local_timeout(ctx, hg_timeout);
 
 		rc = crt_hg_progress(&ctx->cc_hg_ctx, hg_timeout);
 		if (unlikely(rc && rc != -DER_TIMEDOUT)) {
@@ -479,8 +479,9 @@ corpc_add_child_rpc(struct crt_rpc_priv *parent_rpc_priv,
 	child_rpc->cr_input_size = parent_rpc->cr_input_size;
 	child_rpc->cr_input = parent_rpc->cr_input;
 
-	/* inherit crp_flag from parent */
-	child_rpc_priv->crp_flags = parent_rpc_priv->crp_flags;
+	/* inherit crp_flag and trace ID from parent */
+	child_rpc_priv->crp_flags    = parent_rpc_priv->crp_flags;
+	child_rpc_priv->crp_trace_id = parent_rpc_priv->crp_trace_id;
 
 	/* inherit crp_coreq_hdr from parent */
 	parent_co_hdr = &parent_rpc_priv->crp_coreq_hdr;
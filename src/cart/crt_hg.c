@@ -1318,6 +1318,7 @@ crt_rpc_handler_common(hg_handle_t hg_hdl)
 		  &rpc_priv->crp_pub);
 
 	crt_rpc_priv_init(rpc_priv, crt_ctx, true /* srv_flag */);
+	d_gettime(&rpc_priv->crp_recv_time);
 
 	D_ASSERT(rpc_priv->crp_srv != 0);
 	if (rpc_pub->cr_input_size > 0) {
@@ -1429,6 +1430,17 @@ crt_hg_req_destroy(struct crt_rpc_priv *rpc_priv)
 	hg_return_t hg_ret;
 
 	D_ASSERT(rpc_priv != NULL);
+	if (rpc_priv->crp_coalesce != NULL) {
+		crt_coalesce_req_destroy(rpc_priv);
+		/* the handle of a coalesced RPC on the target is the one of its batch */
+		if (rpc_priv->crp_srv) {
+			crt_rpc_priv_fini(rpc_priv);
+			D_GOTO(mem_free, 0);
+		}
+	}
+	/* no mercury handle behind an RPC delivered in process */
+	if (rpc_priv->crp_local)
+		crt_local_req_destroy(rpc_priv);
 	if (rpc_priv->crp_output_got != 0) {
 		hg_ret = HG_Free_output(rpc_priv->crp_hg_hdl,
 					&rpc_priv->crp_pub.cr_output);
@@ -2275,6 +2287,15 @@ crt_hg_bulk_transfer(struct crt_bulk_desc *bulk_desc, crt_bulk_cb_t verify_cb,
 		if (rpc_priv->crp_hg_hdl != HG_HANDLE_NULL) {
 			remote_ctx_idx = HG_Get_info(rpc_priv->crp_hg_hdl)->context_id;
 			remote_addr    = rpc_priv->crp_hg_addr;
+		} else if (rpc_priv->crp_local_origin != NULL) {
+			/*
+			 * RPC delivered in process, the remote buffer belongs to the origin
+			 * context of this engine. Mercury turns a transfer with self into a
+			 * memcpy.
+			 */
+			remote_ctx_idx =
+			    ((struct crt_context *)rpc_priv->crp_local_origin->crp_pub.cr_ctx)->cc_idx;
+			remote_addr    = hg_ctx->chc_self_addr;
 		} else {
 			/*
 			 * CoRPC executing on the root node (self) does not have a mercury handle.
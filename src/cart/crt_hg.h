@@ -191,6 +191,11 @@ void crt_hg_unpack_cleanup(crt_proc_t proc);
 int crt_hg_unpack_body(struct crt_rpc_priv *rpc_priv, crt_proc_t proc);
 int crt_proc_in_common(crt_proc_t proc, crt_rpc_input_t *data);
 int crt_proc_out_common(crt_proc_t proc, crt_rpc_output_t *data);
+int crt_hg_unpack_coalesced_header(d_iov_t *iov, struct crt_rpc_priv *rpc_priv,
+				   crt_proc_t *proc);
+int crt_hg_pack_coalesced(struct crt_rpc_priv *rpc_priv, bool reply, d_iov_t *iov);
+int crt_hg_unpack_coalesced_reply(struct crt_rpc_priv *rpc_priv, d_iov_t *iov);
+void crt_hg_free_coalesced(struct crt_rpc_priv *rpc_priv);
 
 bool crt_provider_is_contig_ep(crt_provider_t provider);
 bool crt_provider_is_port_based(crt_provider_t provider);
@@ -512,6 +512,55 @@ do {									\
 	}								\
 } while (0)
 
+/* Decode the request common header, and sync the HLC with it */
+static int
+crt_hg_unpack_header_proc(hg_proc_t hg_proc, struct crt_rpc_priv *rpc_priv)
+{
+	uint64_t	clock_offset;
+	int		rc;
+
+	/* Decode header */
+	rc = crt_proc_common_hdr(hg_proc, &rpc_priv->crp_req_hdr);
+	if (rc != 0) {
+		RPC_ERROR(rpc_priv, "crt_proc_common_hdr failed: " DF_RC "\n", DP_RC(rc));
+		D_GOTO(out, rc);
+	}
+
+	/* Sync the HLC. Clients never decode requests. */
+	D_ASSERT(crt_is_service());
+	rc = d_hlc_get_msg(rpc_priv->crp_req_hdr.cch_hlc, NULL /* hlc_out */, &clock_offset);
+	if (rc != 0) {
+		REPORT_HLC_SYNC_ERR("failed to sync HLC for request: opc=%x ts="
+				    DF_U64" offset="DF_U64" from=%u\n",
+				    rpc_priv->crp_req_hdr.cch_opc,
+				    rpc_priv->crp_req_hdr.cch_hlc,
+				    clock_offset,
+				    rpc_priv->crp_req_hdr.cch_src_rank);
+
+		/* Fail all but SWIM requests. */
+		if (!crt_opc_is_swim(rpc_priv->crp_req_hdr.cch_opc))
+			rpc_priv->crp_fail_hlc = 1;
+
+		rc = 0;
+	}
+
+	rpc_priv->crp_flags = rpc_priv->crp_req_hdr.cch_flags;
+	if (rpc_priv->crp_flags & CRT_RPC_FLAG_COLL) {
+		rc = crt_proc_corpc_hdr(hg_proc, &rpc_priv->crp_coreq_hdr);
+		if (rc != 0) {
+			RPC_ERROR(rpc_priv, "crt_proc_corpc_hdr failed: "
+				  DF_RC"\n", DP_RC(rc));
+			D_GOTO(out, rc);
+		}
+	}
+
+	if (rpc_priv->crp_flags & CRT_RPC_FLAG_TRACED)
+		rpc_priv->crp_trace_id = rpc_priv->crp_req_hdr.cch_rpcid;
+
+out:
+	return rc;
+}
+
 /* For unpacking only the common header to know about the CRT opc */
 int
 crt_hg_unpack_header(hg_handle_t handle, struct crt_rpc_priv *rpc_priv,
@@ -530,7 +579,6 @@ crt_hg_unpack_header(hg_handle_t handle, struct crt_rpc_priv *rpc_priv,
 	hg_class_t		*hg_class;
 	struct crt_context	*ctx;
 	struct crt_hg_context	*hg_ctx;
-	uint64_t		 clock_offset;
 	hg_proc_t		 hg_proc = HG_PROC_NULL;
 	hg_return_t		 hg_ret = HG_SUCCESS;
 	int			 rc;
@@ -561,45 +609,39 @@ crt_hg_unpack_header(hg_handle_t handle, struct crt_rpc_priv *rpc_priv,
 		D_GOTO(out, rc = crt_hgret_2_der(hg_ret));
 	}
 
-	/* Decode header */
-	rc = crt_proc_common_hdr(hg_proc, &rpc_priv->crp_req_hdr);
-	if (rc != 0) {
-		RPC_ERROR(rpc_priv, "crt_proc_common_hdr failed: " DF_RC "\n", DP_RC(rc));
+	rc = crt_hg_unpack_header_proc(hg_proc, rpc_priv);
+	if (rc != 0)
 		D_GOTO(out, rc);
-	}
 
-	/* Sync the HLC. Clients never decode requests. */
-	D_ASSERT(crt_is_service());
-	rc = d_hlc_get_msg(rpc_priv->crp_req_hdr.cch_hlc, NULL /* hlc_out */, &clock_offset);
-	if (rc != 0) {
-		REPORT_HLC_SYNC_ERR("failed to sync HLC for request: opc=%x ts="
-				    DF_U64" offset="DF_U64" from=%u\n",
-				    rpc_priv->crp_req_hdr.cch_opc,
-				    rpc_priv->crp_req_hdr.cch_hlc,
-				    clock_offset,
-				    rpc_priv->crp_req_hdr.cch_src_rank);
+	*proc = hg_proc;
 
-		/* Fail all but SWIM requests. */
-		if (!crt_opc_is_swim(rpc_priv->crp_req_hdr.cch_opc))
-			rpc_priv->crp_fail_hlc = 1;
+out:
+	return rc;
+}
 
-		rc = 0;
-	}
+/*
+ * Same as crt_hg_unpack_header() but for a request packed by
+ * crt_hg_pack_coalesced() and carried in a CRT_OPC_COALESCE batch.
+ */
+int
+crt_hg_unpack_coalesced_header(d_iov_t *iov, struct crt_rpc_priv *rpc_priv, crt_proc_t *proc)
+{
+	crt_proc_t	hg_proc = NULL;
+	int		rc;
 
-	rpc_priv->crp_flags = rpc_priv->crp_req_hdr.cch_flags;
-	if (rpc_priv->crp_flags & CRT_RPC_FLAG_COLL) {
-		rc = crt_proc_corpc_hdr(hg_proc, &rpc_priv->crp_coreq_hdr);
-		if (rc != 0) {
-			RPC_ERROR(rpc_priv, "crt_proc_corpc_hdr failed: "
-				  DF_RC"\n", DP_RC(rc));
-			D_GOTO(out, rc);
-		}
+	rc = crt_proc_create(rpc_priv->crp_pub.cr_ctx, iov->iov_buf, iov->iov_len,
+			     CRT_PROC_DECODE, &hg_proc);
+	if (rc != 0)
+		return rc;
+
+	rc = crt_hg_unpack_header_proc(hg_proc, rpc_priv);
+	if (rc != 0) {
+		crt_proc_destroy(hg_proc);
+		return rc;
 	}
 
 	*proc = hg_proc;
-
-out:
-	return rc;
+	return 0;
 }
 
 /* Process header.
@@ -624,6 +666,7 @@ crt_hg_process_header(struct crt_rpc_priv *in, struct crt_rpc_priv *out)
 	out->crp_flags             = in->crp_flags;
 	out->crp_req_hdr           = in->crp_req_hdr;
 	out->crp_reply_hdr.cch_hlc = in->crp_reply_hdr.cch_hlc;
+	out->crp_trace_id          = in->crp_trace_id;
 
 	src_val = in->crp_req_hdr.cch_src_deadline_sec;
 
@@ -895,6 +938,117 @@ out:
 	return crt_der_2_hgret(rc);
 }
 
+/* initial buffer size to pack one coalesced request or reply */
+#define CRT_COALESCE_PACK_SIZE	(512)
+
+/*
+ * Pack the request (on the origin) or the reply (on the target) of \a rpc_priv,
+ * including its common header, into a standalone buffer so that it can be
+ * carried in a CRT_OPC_COALESCE batch. The buffer is returned in \a iov and
+ * shall be freed by the caller.
+ */
+int
+crt_hg_pack_coalesced(struct crt_rpc_priv *rpc_priv, bool reply, d_iov_t *iov)
+{
+	crt_proc_t	 proc = NULL;
+	void		*buf = NULL;
+	size_t		 buf_size = CRT_COALESCE_PACK_SIZE;
+	size_t		 size_used;
+	int		 rc;
+
+again:
+	D_ALLOC(buf, buf_size);
+	if (buf == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	if (proc == NULL)
+		rc = crt_proc_create(rpc_priv->crp_pub.cr_ctx, buf, buf_size,
+				     CRT_PROC_ENCODE, &proc);
+	else
+		rc = crt_proc_reset(proc, buf, buf_size, CRT_PROC_ENCODE);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (reply)
+		rc = crt_proc_out_common(proc, &rpc_priv->crp_pub.cr_output);
+	else
+		rc = crt_proc_in_common(proc, &rpc_priv->crp_pub.cr_input);
+	rc = crt_hgret_2_der(rc);
+	if (rc != 0) {
+		RPC_ERROR(rpc_priv, "failed to pack %s: "DF_RC"\n",
+			  reply ? "reply" : "request", DP_RC(rc));
+		D_GOTO(out, rc);
+	}
+
+	/* mercury overflows into an extra buffer, pack again into a large enough one */
+	size_used = crp_proc_get_size_used(proc);
+	if (size_used > buf_size) {
+		D_FREE(buf);
+		buf_size = size_used;
+		goto again;
+	}
+
+	d_iov_set(iov, buf, size_used);
+	buf = NULL;
+out:
+	if (proc != NULL)
+		crt_proc_destroy(proc);
+	D_FREE(buf);
+	return rc;
+}
+
+/* Unpack the reply of \a rpc_priv packed by crt_hg_pack_coalesced() */
+int
+crt_hg_unpack_coalesced_reply(struct crt_rpc_priv *rpc_priv, d_iov_t *iov)
+{
+	crt_proc_t	proc;
+	int		rc;
+
+	rc = crt_proc_create(rpc_priv->crp_pub.cr_ctx, iov->iov_buf, iov->iov_len,
+			     CRT_PROC_DECODE, &proc);
+	if (rc != 0)
+		return rc;
+
+	rc = crt_hgret_2_der(crt_proc_out_common(proc, &rpc_priv->crp_pub.cr_output));
+	if (rc == 0)
+		rpc_priv->crp_output_got = 1;
+	else
+		RPC_ERROR(rpc_priv, "failed to unpack reply: "DF_RC"\n", DP_RC(rc));
+
+	crt_proc_destroy(proc);
+	return rc;
+}
+
+/*
+ * Release what was allocated while unpacking a coalesced request or reply,
+ * the counterpart of HG_Free_input()/HG_Free_output() for a coalesced RPC.
+ */
+void
+crt_hg_free_coalesced(struct crt_rpc_priv *rpc_priv)
+{
+	crt_proc_t	proc;
+	int		rc;
+
+	if (!rpc_priv->crp_input_got && !rpc_priv->crp_output_got)
+		return;
+
+	rc = crt_proc_create(rpc_priv->crp_pub.cr_ctx, NULL, 0, CRT_PROC_FREE, &proc);
+	if (rc != 0) {
+		RPC_ERROR(rpc_priv, "failed to create free proc: "DF_RC"\n", DP_RC(rc));
+		goto out;
+	}
+
+	if (rpc_priv->crp_input_got)
+		crt_proc_in_common(proc, &rpc_priv->crp_pub.cr_input);
+	if (rpc_priv->crp_output_got)
+		crt_proc_out_common(proc, &rpc_priv->crp_pub.cr_output);
+
+	crt_proc_destroy(proc);
+out:
+	rpc_priv->crp_input_got = 0;
+	rpc_priv->crp_output_got = 0;
+}
+
 int
 crt_proc_create(crt_context_t crt_ctx, void *buf, size_t buf_size,
 		crt_proc_op_t proc_op, crt_proc_t *proc)
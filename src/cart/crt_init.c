@@ -256,11 +256,15 @@ crt_gdata_dump(void)
 	DUMP_GDATA_FIELD("%d", cg_use_sensors);
 	DUMP_GDATA_FIELD("%d", cg_thread_mode_single);
 	DUMP_GDATA_FIELD("%d", cg_mem_device);
+	DUMP_GDATA_FIELD("%d", cg_local_rpc);
 	DUMP_GDATA_FIELD("%d", cg_provider_is_primary);
 	DUMP_GDATA_FIELD("0x%lx", cg_rpcid);
 	DUMP_GDATA_FIELD("%ld", cg_num_cores);
 	DUMP_GDATA_FIELD("%d", cg_rpc_quota);
 	DUMP_GDATA_FIELD("%d", cg_bulk_quota);
+	DUMP_GDATA_FIELD("%u", cg_bulk_cache_size);
+	DUMP_GDATA_FIELD("%u", cg_coalesce_delay);
+	DUMP_GDATA_FIELD("%u", cg_coalesce_max);
 }
 
 static enum crt_traffic_class
@@ -314,6 +318,7 @@ data_init(int server, crt_init_options_t *opt)
 	uint32_t     fi_univ_size   = 0;
 	uint32_t     mem_pin_enable = 0;
 	uint32_t     is_secondary;
+	uint32_t     local_rpc;
 	uint32_t     post_init = CRT_HG_POST_INIT, post_incr = CRT_HG_POST_INCR;
 	unsigned int mrecv_buf          = CRT_HG_MRECV_BUF;
 	unsigned int mrecv_buf_copy     = 0; /* buf copy disabled by default */
@@ -391,6 +396,27 @@ data_init(int server, crt_init_options_t *opt)
 		crt_gdata.cg_bulk_quota = 0;
 	}
 
+	/* bulk registration cache is opt-in and client only */
+	crt_gdata.cg_bulk_cache_size = 0;
+	crt_env_get(D_BULK_CACHE_SIZE, &crt_gdata.cg_bulk_cache_size);
+	if (server && crt_gdata.cg_bulk_cache_size) {
+		D_WARN("BULK cache not supported on the server. auto-disabling it\n");
+		crt_gdata.cg_bulk_cache_size = 0;
+	}
+
+	/* RPC coalescing is opt-in, a batch needs at least two RPCs */
+	crt_gdata.cg_coalesce_delay = 0;
+	crt_env_get(D_RPC_COALESCE_DELAY, &crt_gdata.cg_coalesce_delay);
+	crt_gdata.cg_coalesce_max = CRT_COALESCE_MAX_DEFAULT;
+	crt_env_get(D_RPC_COALESCE_MAX, &crt_gdata.cg_coalesce_max);
+	if (crt_gdata.cg_coalesce_max < 2)
+		crt_gdata.cg_coalesce_max = 2;
+
+	/* only an engine sends RPCs to itself */
+	local_rpc = 1;
+	crt_env_get(D_RPC_LOCAL, &local_rpc);
+	crt_gdata.cg_local_rpc = server && local_rpc != 0;
+
 	/* Must be set on the server when using UCX, will not affect OFI */
 	if (server)
 		d_setenv("UCX_IB_FORK_INIT", "n", 1);
@@ -66,6 +66,12 @@ crt_bulk_desc_dup(struct crt_bulk_desc *bulk_desc_new,
 void
 crt_bulk_free_common(struct crt_bulk *bulk);
 
+int
+crt_bulk_cache_init(struct crt_context *ctx);
+
+void
+crt_bulk_cache_fini(struct crt_context *ctx);
+
 void
 crt_hdlr_proto_query(crt_rpc_t *rpc_req);
 
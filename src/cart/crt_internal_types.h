@@ -197,6 +197,9 @@ struct crt_gdata {
 	/** use memory device */
 	bool                     cg_mem_device;
 
+	/** deliver RPCs sent to this engine in process, see crt_local.c */
+	bool                     cg_local_rpc;
+
 	ATOMIC uint64_t		cg_rpcid; /* rpc id */
 
 	/* protects crt_gdata (see the lock order comment on crp_mutex) */
@@ -219,6 +222,12 @@ struct crt_gdata {
 	uint32_t                 cg_rpc_quota;
 	/** bulk quota limit */
 	uint32_t                 cg_bulk_quota;
+	/** max number of cached bulk registrations per context, 0 to disable */
+	uint32_t                 cg_bulk_cache_size;
+	/** max delay (in us) of a coalescable RPC before it is sent, 0 to disable coalescing */
+	uint32_t                 cg_coalesce_delay;
+	/** max number of RPCs packed into one coalesced batch */
+	uint32_t                 cg_coalesce_max;
 	/** Retry count of HG_Init_opt2() on failure when using CXI provider */
 	uint32_t                 cg_hg_init_retry_cnt;
 };
@@ -289,6 +298,10 @@ struct crt_event_cb_priv {
 	ENV_STR(SLINGSHOT_VNIS)                                                                    \
 	ENV(D_QUOTA_RPCS)                                                                          \
 	ENV(D_QUOTA_BULKS)                                                                         \
+	ENV(D_BULK_CACHE_SIZE)                                                                     \
+	ENV(D_RPC_COALESCE_DELAY)                                                                  \
+	ENV(D_RPC_COALESCE_MAX)                                                                    \
+	ENV(D_RPC_LOCAL)                                                                           \
 	ENV(FI_OFI_RXM_USE_SRX)                                                                    \
 	ENV(FI_UNIVERSE_SIZE)                                                                      \
 	ENV(SWIM_PING_TIMEOUT)                                                                     \
@@ -472,6 +485,98 @@ struct crt_bulk {
 	ATOMIC uint32_t refcount;    /** reference count for this struct */
 	bool            bound;       /** whether crt_bulk_bind() was used on it */
 	bool            deferred;    /** whether handle allocation was deferred */
+	bool            cached;      /** whether hg_bulk_hdl is shared with the bulk cache */
+};
+
+/* (1 << CRT_BULK_CACHE_BITS) is the number of buckets of the bulk cache */
+#define CRT_BULK_CACHE_BITS		(6)
+
+/*
+ * crt_bulk_cache - per-context cache of mercury bulk handles
+ *
+ * Registering memory with the fabric is expensive, and clients tend to issue
+ * bulk I/O from the same large buffers over and over. When enabled through
+ * D_BULK_CACHE_SIZE, crt_bulk_create() of a single-iov sgl looks up a cached
+ * handle registered for exactly the same range and permissions and takes a
+ * mercury reference on it instead of registering the memory again.
+ *
+ * The cache holds one reference on each handle and drops it on LRU eviction,
+ * on crt_bulk_cache_invalidate() of an overlapping range, or when the context
+ * is destroyed. Bulks created from the cache keep the handle alive until they
+ * are freed. Since the cache cannot tell when memory is unmapped, users must
+ * invalidate a range before releasing it to the system.
+ */
+struct crt_bulk_cache_entry {
+	/** link to crt_bulk_cache::bc_buckets */
+	d_list_t		 be_hash_link;
+	/** link to crt_bulk_cache::bc_lru, most recently used first */
+	d_list_t		 be_lru_link;
+	uint64_t		 be_start;
+	uint64_t		 be_len;
+	crt_bulk_perm_t		 be_perm;
+	hg_bulk_t		 be_hdl;
+};
+
+struct crt_bulk_cache {
+	d_list_t		 bc_buckets[1 << CRT_BULK_CACHE_BITS];
+	d_list_t		 bc_lru;
+	uint32_t		 bc_nr;
+	uint32_t		 bc_max;
+	/** protects all fields above */
+	pthread_mutex_t		 bc_mutex;
+};
+
+/* (1 << CRT_COALESCE_BITS) is the number of buckets of the coalesce queues */
+#define CRT_COALESCE_BITS		(6)
+
+/*
+ * crt_coalesce - per-context queues of RPCs waiting to be coalesced
+ *
+ * When D_RPC_COALESCE_DELAY is set, RPCs of opcodes registered with
+ * CRT_RPC_FEAT_COALESCE are not forwarded right away but queued per
+ * destination (primary rank and tag) for up to that delay. A queue is flushed
+ * by the progress loop when its delay expires or when it holds
+ * D_RPC_COALESCE_MAX RPCs, and all its RPCs are then packed into a single
+ * CRT_OPC_COALESCE request, see crt_coalesce.c.
+ */
+struct crt_coalesce_queue {
+	/** link to crt_coalesce::cco_buckets */
+	d_list_t		 ccq_hash_link;
+	/** link to crt_coalesce::cco_active, ordered by deadline */
+	d_list_t		 ccq_link;
+	/** queued RPCs, linked through crt_rpc_priv::crp_coalesce_link */
+	d_list_t		 ccq_rpcs;
+	d_rank_t		 ccq_rank;
+	uint32_t		 ccq_tag;
+	uint32_t		 ccq_nr;
+	/** absolute time (in us) the queue should be flushed */
+	uint64_t		 ccq_deadline;
+};
+
+struct crt_coalesce {
+	d_list_t		 cco_buckets[1 << CRT_COALESCE_BITS];
+	d_list_t		 cco_active;
+	/** protects the fields above */
+	pthread_mutex_t		 cco_mutex;
+	/** total number of queued RPCs, checked without the lock by progress */
+	ATOMIC uint32_t		 cco_nr;
+};
+
+/*
+ * crt_local_inbox - RPCs delivered in process to a context
+ *
+ * Filled by any thread, drained by the progress loop of the context so that
+ * handlers and completion callbacks run where they would for a network RPC.
+ */
+struct crt_local_inbox {
+	/** requests to handle, linked through crt_rpc_priv::crp_local_link */
+	d_list_t		 cli_reqs;
+	/** RPCs sent from this context whose handling is done */
+	d_list_t		 cli_replies;
+	/** protects the lists above */
+	pthread_mutex_t		 cli_mutex;
+	/** number of queued entries, checked without the lock by progress */
+	ATOMIC uint32_t		 cli_nr;
 };
 
 #define CRT_METRIC_INC(ctx, name)                                                                  \
@@ -481,6 +586,13 @@ struct crt_bulk {
 		}                                                                                  \
 	} while (0)
 
+#define CRT_METRIC_ADD(ctx, name, value)                                                           \
+	do {                                                                                       \
+		if (crt_gdata.cg_use_sensors) {                                                    \
+			d_tm_inc_counter(ctx->cc_metrics.name, value);                             \
+		}                                                                                  \
+	} while (0)
+
 #define CRT_METRIC_SET_GAUGE(ctx, name, value)                                                     \
 	do {                                                                                       \
 		if (crt_gdata.cg_use_sensors) {                                                    \
@@ -523,6 +635,11 @@ struct crt_bulk {
 	X(CM_RPC_TIMEDOUT, D_TM_COUNTER, "Total number of timed out RPC send requests", "rpcs")    \
 	X(CM_RPC_DOUBLE_COMPLETE, D_TM_COUNTER,                                                    \
 	  "Total number of RPCs having a duplicate completion ", "rpcs")                           \
+	X(CM_RPC_COALESCED, D_TM_COUNTER, "Total number of RPCs sent in a coalesced batch",        \
+	  "rpcs")                                                                                  \
+	X(CM_RPC_COALESCE_BATCHES, D_TM_COUNTER, "Total number of coalesced batches sent",         \
+	  "batches")                                                                               \
+	X(CM_RPC_LOCAL, D_TM_COUNTER, "Total number of RPCs delivered in process", "rpcs")         \
 	X(CM_BULK_CREATE, D_TM_COUNTER, "Total number of bulks created", "bulks")                  \
 	X(CM_BULK_CREATE_FAILED, D_TM_COUNTER, "Total number of bulks that failed to create",      \
 	  "bulks")                                                                                 \
@@ -534,11 +651,21 @@ struct crt_bulk {
 	X(CM_CORPC_COMPLETED_ERR, D_TM_COUNTER,                                                    \
 	  "Total number of corpcs that completed with error", "corpcs")
 
+/* Metrics of the bulk cache, which is client only */
+#define CRT_BULK_CACHE_METRICS_LIST                                                                \
+	X(CM_BULK_CACHE_HIT, D_TM_COUNTER, "Total number of bulks created from the bulk cache",    \
+	  "bulks")                                                                                 \
+	X(CM_BULK_CACHE_MISS, D_TM_COUNTER, "Total number of bulk cache lookups that missed",      \
+	  "bulks")                                                                                 \
+	X(CM_BULK_CACHE_EVICT, D_TM_COUNTER,                                                       \
+	  "Total number of registrations evicted or invalidated from the bulk cache", "bulks")
+
 #undef X
 #define X(name, type, desc, unit_desc) struct d_tm_node_t *name;
 
 struct crt_metric_t {
 	CRT_METRICS_LIST
+	CRT_BULK_CACHE_METRICS_LIST
 };
 
 #undef X
@@ -583,6 +710,15 @@ struct crt_context {
 	/** Stores quotas */
 	struct crt_quotas	cc_quotas;
 
+	/** cache of registered bulk handles */
+	struct crt_bulk_cache	cc_bulk_cache;
+
+	/** small RPCs waiting to be coalesced */
+	struct crt_coalesce	cc_coalesce;
+
+	/** RPCs delivered in process to, or completed for, this context */
+	struct crt_local_inbox	cc_local;
+
 	/** Stores metrics */
 	struct crt_metric_t      cc_metrics;
 };
@@ -635,7 +771,9 @@ struct crt_opc_info {
 				 coi_coops_init:1,
 				 coi_no_reply:1, /* flag of one-way RPC */
 				 coi_queue_front:1, /* add to front of queue */
-				 coi_reset_timer:1; /* reset timer on timeout */
+				 coi_reset_timer:1, /* reset timer on timeout */
+				 coi_coalesce:1, /* may be coalesced with others */
+				 coi_local:1; /* may be delivered in process */
 
 	crt_rpc_cb_t		 coi_rpc_cb;
 	struct crt_corpc_ops	*coi_co_ops;
@@ -0,0 +1,274 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of CaRT. It implements the in-process delivery of RPCs
+ * sent by an engine to one of its own contexts.
+ *
+ * Once tracked, an RPC registered with CRT_RPC_FEAT_LOCAL and addressed to the
+ * local rank is not forwarded through mercury: a target RPC sharing the input
+ * of the origin one is queued to the inbox of the target context, whose
+ * progress loop invokes the handler as for a network RPC. The reply is packed
+ * into a buffer of the origin RPC by crt_reply_send(), because handlers are
+ * free to release what it points to right after. Once the target RPC is
+ * released, the origin one is queued to the inbox of its own context, where
+ * the reply is unpacked and the completion callback invoked.
+ */
+#define D_LOGFAC	DD_FAC(rpc)
+
+#include "crt_internal.h"
+
+int
+crt_local_init(struct crt_context *ctx)
+{
+	struct crt_local_inbox *cli = &ctx->cc_local;
+
+	D_INIT_LIST_HEAD(&cli->cli_reqs);
+	D_INIT_LIST_HEAD(&cli->cli_replies);
+	atomic_init(&cli->cli_nr, 0);
+
+	return D_MUTEX_INIT(&cli->cli_mutex, NULL);
+}
+
+static void
+crt_local_queue(struct crt_context *ctx, struct crt_rpc_priv *rpc_priv, bool reply)
+{
+	struct crt_local_inbox *cli = &ctx->cc_local;
+
+	D_MUTEX_LOCK(&cli->cli_mutex);
+	d_list_add_tail(&rpc_priv->crp_local_link, reply ? &cli->cli_replies : &cli->cli_reqs);
+	atomic_fetch_add(&cli->cli_nr, 1);
+	D_MUTEX_UNLOCK(&cli->cli_mutex);
+}
+
+bool
+crt_local_enabled(struct crt_rpc_priv *rpc_priv)
+{
+	return crt_gdata.cg_local_rpc && crt_gdata.cg_provider_is_primary &&
+	       rpc_priv->crp_opc_info->coi_local && !rpc_priv->crp_coll &&
+	       !rpc_priv->crp_forward && crt_req_is_self(rpc_priv);
+}
+
+/*
+ * Hand \a origin over to the context it is addressed to, instead of sending it.
+ * Called with the rpc lock held.
+ */
+int
+crt_local_send(struct crt_rpc_priv *origin)
+{
+	struct crt_context    *ctx = origin->crp_pub.cr_ctx;
+	struct crt_context    *tgt_ctx;
+	struct crt_rpc_priv   *rpc_priv;
+	struct crt_common_hdr *hdr;
+	d_rank_t               self_rank;
+	int                    rc;
+
+	tgt_ctx = crt_context_lookup(origin->crp_pub.cr_ep.ep_tag);
+	if (tgt_ctx == NULL) {
+		RPC_ERROR(origin, "no local context with tag %d\n", origin->crp_pub.cr_ep.ep_tag);
+		return -DER_NONEXIST;
+	}
+
+	rc = crt_rpc_priv_alloc(origin->crp_pub.cr_opc, &rpc_priv, false /* forward */);
+	if (rc != 0) {
+		RPC_ERROR(origin, "crt_rpc_priv_alloc() failed, " DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+	crt_rpc_priv_init(rpc_priv, tgt_ctx, true /* srv_flag */);
+	d_gettime(&rpc_priv->crp_recv_time);
+
+	/* what crt_hg_unpack_header() would have found on the wire */
+	self_rank                 = crt_gdata.cg_grp->gg_primary_grp->gp_self;
+	hdr                       = &rpc_priv->crp_req_hdr;
+	*hdr                      = origin->crp_req_hdr;
+	hdr->cch_flags            = origin->crp_flags;
+	hdr->cch_dst_rank         = self_rank;
+	hdr->cch_src_rank         = self_rank;
+	hdr->cch_dst_tag          = tgt_ctx->cc_idx;
+	hdr->cch_hlc              = d_hlc_get();
+	hdr->cch_src_deadline_sec = origin->crp_deadline_sec;
+
+	rpc_priv->crp_reply_hdr.cch_opc   = hdr->cch_opc;
+	rpc_priv->crp_reply_hdr.cch_rpcid = hdr->cch_rpcid;
+	rpc_priv->crp_flags               = origin->crp_flags;
+	rpc_priv->crp_timeout_sec         = origin->crp_timeout_sec;
+	rpc_priv->crp_deadline_sec        = origin->crp_deadline_sec;
+	rpc_priv->crp_trace_id            = origin->crp_trace_id;
+	rpc_priv->crp_pub.cr_ep.ep_rank   = self_rank;
+	rpc_priv->crp_pub.cr_ep.ep_tag    = tgt_ctx->cc_idx;
+
+	/* no copy, the input of the origin RPC is the one of the target RPC */
+	rpc_priv->crp_pub.cr_input      = origin->crp_pub.cr_input;
+	rpc_priv->crp_pub.cr_input_size = origin->crp_pub.cr_input_size;
+
+	/* released in crt_local_complete() */
+	RPC_ADDREF(origin);
+	rpc_priv->crp_local        = 1;
+	rpc_priv->crp_local_origin = origin;
+	origin->crp_local          = 1;
+	origin->crp_state          = RPC_STATE_LOCAL;
+
+	CRT_METRIC_INC(ctx, CM_RPC_LOCAL);
+	RPC_TRACE(DB_TRACE, origin, "delivered in process to tag %d.\n", tgt_ctx->cc_idx);
+
+	crt_local_queue(tgt_ctx, rpc_priv, false);
+	return 0;
+}
+
+/* Invoke the handler of \a rpc_priv, as crt_rpc_handler_common() does for a network RPC */
+static void
+crt_local_dispatch(struct crt_rpc_priv *rpc_priv)
+{
+	int rc;
+
+	CRT_METRIC_INC(((struct crt_context *)rpc_priv->crp_pub.cr_ctx), CM_RPC_RECV);
+
+	rc = crt_rpc_common_hdlr(rpc_priv);
+	if (unlikely(rc != 0)) {
+		RPC_INFO(rpc_priv, "failed to invoke RPC handler, rc: " DF_RC "\n", DP_RC(rc));
+		crt_local_reply(rpc_priv, rc);
+		RPC_DECREF(rpc_priv);
+	}
+}
+
+/* Complete \a origin once its target RPC has been released */
+static void
+crt_local_complete(struct crt_rpc_priv *origin)
+{
+	int rc;
+
+	crt_rpc_lock(origin);
+
+	/* timed out or aborted while the handler was running */
+	if (origin->crp_state != RPC_STATE_LOCAL) {
+		crt_rpc_unlock(origin);
+		goto out;
+	}
+
+	/* the reply buffer is released along with the RPC, its output points to it */
+	if (origin->crp_local_reply.iov_buf == NULL) {
+		/* dropped before its handler was invoked */
+		rc = -DER_CANCELED;
+	} else {
+		rc = crt_hg_unpack_coalesced_reply(origin, &origin->crp_local_reply);
+		if (rc == 0)
+			rc = origin->crp_reply_hdr.cch_rc;
+		if (rc == 0 && origin->crp_fail_hlc)
+			rc = -DER_HLC_SYNC;
+	}
+
+	origin->crp_state = (rc == -DER_CANCELED) ? RPC_STATE_CANCELED : RPC_STATE_COMPLETED;
+	crt_context_req_untrack(origin);
+	crt_rpc_complete_and_unlock(origin, rc);
+out:
+	/* reference taken by crt_local_send() */
+	RPC_DECREF(origin);
+}
+
+/* Drain the inbox of \a ctx, called by the progress loop */
+void
+crt_local_progress(struct crt_context *ctx)
+{
+	struct crt_local_inbox *cli = &ctx->cc_local;
+	struct crt_rpc_priv    *rpc_priv;
+	d_list_t                reqs;
+	d_list_t                replies;
+
+	if (atomic_load_relaxed(&cli->cli_nr) == 0)
+		return;
+
+	D_INIT_LIST_HEAD(&reqs);
+	D_INIT_LIST_HEAD(&replies);
+
+	D_MUTEX_LOCK(&cli->cli_mutex);
+	d_list_splice_init(&cli->cli_reqs, &reqs);
+	d_list_splice_init(&cli->cli_replies, &replies);
+	atomic_store_relaxed(&cli->cli_nr, 0);
+	D_MUTEX_UNLOCK(&cli->cli_mutex);
+
+	while ((rpc_priv = d_list_pop_entry(&reqs, struct crt_rpc_priv, crp_local_link)))
+		crt_local_dispatch(rpc_priv);
+	while ((rpc_priv = d_list_pop_entry(&replies, struct crt_rpc_priv, crp_local_link)))
+		crt_local_complete(rpc_priv);
+}
+
+/* Do not let the progress loop wait while the inbox is not empty */
+int64_t
+crt_local_timeout(struct crt_context *ctx, int64_t timeout)
+{
+	if (atomic_load_relaxed(&ctx->cc_local.cli_nr) != 0)
+		return 0;
+	return timeout;
+}
+
+void
+crt_local_fini(struct crt_context *ctx)
+{
+	struct crt_local_inbox *cli = &ctx->cc_local;
+	struct crt_rpc_priv    *rpc_priv;
+	d_list_t                list;
+
+	D_INIT_LIST_HEAD(&list);
+
+	/* releasing the requests queues their origin RPCs, possibly to this context */
+	D_MUTEX_LOCK(&cli->cli_mutex);
+	d_list_splice_init(&cli->cli_reqs, &list);
+	D_MUTEX_UNLOCK(&cli->cli_mutex);
+	while ((rpc_priv = d_list_pop_entry(&list, struct crt_rpc_priv, crp_local_link))) {
+		atomic_fetch_sub(&cli->cli_nr, 1);
+		RPC_DECREF(rpc_priv);
+	}
+
+	D_MUTEX_LOCK(&cli->cli_mutex);
+	d_list_splice_init(&cli->cli_replies, &list);
+	atomic_store_relaxed(&cli->cli_nr, 0);
+	D_MUTEX_UNLOCK(&cli->cli_mutex);
+	while ((rpc_priv = d_list_pop_entry(&list, struct crt_rpc_priv, crp_local_link)))
+		crt_local_complete(rpc_priv);
+}
+
+/* crt_reply_send() of an RPC delivered in process */
+int
+crt_local_reply(struct crt_rpc_priv *rpc_priv, int rc)
+{
+	d_iov_t *iov = &rpc_priv->crp_local_origin->crp_local_reply;
+
+	D_ASSERT(rpc_priv->crp_srv);
+
+	if (iov->iov_buf != NULL) {
+		RPC_ERROR(rpc_priv, "local RPC already replied.\n");
+		return -DER_ALREADY;
+	}
+
+	/* same encoding as the reply of a coalesced RPC, see crt_hg_pack_coalesced() */
+	if (rc != 0)
+		rpc_priv->crp_reply_hdr.cch_rc = rc;
+	rc = crt_hg_pack_coalesced(rpc_priv, true, iov);
+	if (rc != 0) {
+		/* at least let the origin know */
+		rpc_priv->crp_reply_hdr.cch_rc = rc;
+		crt_hg_pack_coalesced(rpc_priv, true, iov);
+	}
+
+	rpc_priv->crp_reply_pending = 0;
+	return rc;
+}
+
+/* Release what an RPC delivered in process holds in place of a mercury handle */
+void
+crt_local_req_destroy(struct crt_rpc_priv *rpc_priv)
+{
+	struct crt_rpc_priv *origin = rpc_priv->crp_local_origin;
+
+	if (origin != NULL) {
+		/* the handler is done with the input, the origin RPC can complete */
+		rpc_priv->crp_local_origin = NULL;
+		crt_local_queue(origin->crp_pub.cr_ctx, origin, true);
+		return;
+	}
+
+	crt_hg_free_coalesced(rpc_priv);
+	D_FREE(rpc_priv->crp_local_reply.iov_buf);
+}
@@ -116,6 +116,8 @@ crt_hdlr_ctl_fi_attr_set(crt_rpc_t *rpc_req)
 /* CRT internal RPC format definitions uri lookup */
 CRT_RPC_DEFINE(crt_uri_lookup, CRT_ISEQ_URI_LOOKUP, CRT_OSEQ_URI_LOOKUP)
 
+CRT_RPC_DEFINE(crt_coalesce, CRT_ISEQ_COALESCE, CRT_OSEQ_COALESCE)
+
 /* for self-test service */
 CRT_RPC_DEFINE(crt_st_send_id_reply_iov,
 	       CRT_ISEQ_ST_SEND_ID, CRT_OSEQ_ST_REPLY_IOV)
@@ -766,6 +768,65 @@ out:
 	return rc;
 }
 
+int
+crt_req_set_trace_id(crt_rpc_t *req, uint64_t trace_id)
+{
+	struct crt_rpc_priv	*rpc_priv;
+
+	if (req == NULL) {
+		D_ERROR("invalid parameter (NULL req).\n");
+		return -DER_INVAL;
+	}
+
+	rpc_priv = container_of(req, struct crt_rpc_priv, crp_pub);
+	rpc_priv->crp_trace_id = trace_id;
+	if (trace_id != 0) {
+		/* The RPC ID is only used to correlate logs, peers which don't know about
+		 * trace IDs keep decoding the header and the body unchanged.
+		 */
+		RPC_TRACE(DB_TRACE, rpc_priv, "trace ID " DF_X64 "\n", trace_id);
+		rpc_priv->crp_req_hdr.cch_rpcid   = trace_id;
+		rpc_priv->crp_reply_hdr.cch_rpcid = trace_id;
+		rpc_priv->crp_flags |= CRT_RPC_FLAG_TRACED;
+	} else {
+		rpc_priv->crp_flags &= ~CRT_RPC_FLAG_TRACED;
+	}
+
+	return 0;
+}
+
+int
+crt_req_get_trace_id(crt_rpc_t *req, uint64_t *trace_id)
+{
+	struct crt_rpc_priv	*rpc_priv;
+
+	if (req == NULL || trace_id == NULL) {
+		D_ERROR("invalid parameter (NULL req or trace_id).\n");
+		return -DER_INVAL;
+	}
+
+	rpc_priv = container_of(req, struct crt_rpc_priv, crp_pub);
+	*trace_id = rpc_priv->crp_trace_id;
+
+	return 0;
+}
+
+int
+crt_req_get_recv_time(crt_rpc_t *req, struct timespec *recv_time)
+{
+	struct crt_rpc_priv	*rpc_priv;
+
+	if (req == NULL || recv_time == NULL) {
+		D_ERROR("invalid parameter (NULL req or recv_time).\n");
+		return -DER_INVAL;
+	}
+
+	rpc_priv = container_of(req, struct crt_rpc_priv, crp_pub);
+	*recv_time = rpc_priv->crp_recv_time;
+
+	return 0;
+}
+
 /* Called from a decref() call when the count drops to zero */
 void
 crt_req_destroy(struct crt_rpc_priv *rpc_priv)
@@ -777,7 +838,12 @@ crt_req_destroy(struct crt_rpc_priv *rpc_priv)
 		 * handler forgot to call crt_reply_send(). We send a
 		 * CART level error message to notify the client
 		 */
-		crt_hg_reply_error_send(rpc_priv, -DER_NOREPLY);
+		if (rpc_priv->crp_coalesce != NULL)
+			crt_coalesce_reply(rpc_priv, -DER_NOREPLY);
+		else if (rpc_priv->crp_local_origin != NULL)
+			crt_local_reply(rpc_priv, -DER_NOREPLY);
+		else
+			crt_hg_reply_error_send(rpc_priv, -DER_NOREPLY);
 	}
 
 	crt_hg_req_destroy(rpc_priv);
@@ -1320,6 +1386,14 @@ crt_req_send_immediately(struct crt_rpc_priv *rpc_priv)
 	D_ASSERT(rpc_priv != NULL);
 	D_ASSERT(rpc_priv->crp_hg_addr != NULL);
 
+	if (crt_coalesce_enabled(rpc_priv)) {
+		/* sent later along with others, see crt_coalesce_progress() */
+		rc = crt_coalesce_add(rpc_priv);
+		if (rc == 0)
+			return 0;
+		/* otherwise send it on its own */
+	}
+
 	req = &rpc_priv->crp_pub;
 	ctx = req->cr_ctx;
 	rc = crt_hg_req_create(&ctx->cc_hg_ctx, rpc_priv);
@@ -1348,6 +1422,12 @@ crt_req_send_internal(struct crt_rpc_priv *rpc_priv)
 	case RPC_STATE_QUEUED:
 		rpc_priv->crp_state = RPC_STATE_INITED;
 	case RPC_STATE_INITED:
+		/* hand it over to the target context, no address needed */
+		if (crt_local_enabled(rpc_priv)) {
+			rc = crt_local_send(rpc_priv);
+			break;
+		}
+
 		/* lookup local cache  */
 		rpc_priv->crp_hg_addr = NULL;
 		rc = crt_req_ep_lc_lookup(rpc_priv, &uri_exists);
@@ -1547,7 +1627,15 @@ crt_reply_send(crt_rpc_t *req)
 
 	rpc_priv = container_of(req, struct crt_rpc_priv, crp_pub);
 
-	if (rpc_priv->crp_coll == 1) {
+	if (rpc_priv->crp_coalesce != NULL) {
+		/* packed into the reply of the batch it came with */
+		RPC_TRACE(DB_ALL, rpc_priv, "reply_send coalesced\n");
+		rc = crt_coalesce_reply(rpc_priv, 0);
+	} else if (rpc_priv->crp_local_origin != NULL) {
+		/* copied back to the origin RPC */
+		RPC_TRACE(DB_ALL, rpc_priv, "reply_send local\n");
+		rc = crt_local_reply(rpc_priv, 0);
+	} else if (rpc_priv->crp_coll == 1) {
 		struct crt_cb_info	cb_info;
 
 		RPC_TRACE(DB_ALL, rpc_priv, "collect reply.\n");
@@ -1691,6 +1779,8 @@ crt_rpc_priv_init(struct crt_rpc_priv *rpc_priv, crt_context_t crt_ctx, bool srv
 	D_INIT_LIST_HEAD(&rpc_priv->crp_tmp_link_submit);
 	D_INIT_LIST_HEAD(&rpc_priv->crp_tmp_link_timeout);
 	D_INIT_LIST_HEAD(&rpc_priv->crp_parent_link);
+	D_INIT_LIST_HEAD(&rpc_priv->crp_coalesce_link);
+	D_INIT_LIST_HEAD(&rpc_priv->crp_local_link);
 	rpc_priv->crp_complete_cb = NULL;
 	rpc_priv->crp_arg = NULL;
 	rpc_priv->crp_completed = 0;
@@ -23,6 +23,9 @@
 #define CRT_QUOTA_RPCS_DEFAULT          64
 #define CRT_QUOTA_BULKS_DEFAULT         64
 
+/* default max number of RPCs in a coalesced batch */
+#define CRT_COALESCE_MAX_DEFAULT        16
+
 /* uri lookup max retry times */
 #define CRT_URI_LOOKUP_RETRY_MAX	(8)
 
@@ -40,6 +43,8 @@ enum crt_rpc_flags_internal {
 	CRT_RPC_FLAG_PRIMARY_GRP = (1U << 17),
 	/* flag of using deadlines instead of timeouts in RPC headers */
 	CRT_RPC_FLAG_DEADLINES_USED = (1U << 18),
+	/* flag of carrying a trace ID in cch_rpcid, logged as the RPC ID by older peers */
+	CRT_RPC_FLAG_TRACED = (1U << 19),
 };
 
 struct crt_corpc_hdr {
@@ -113,6 +118,8 @@ typedef enum {
 	RPC_STATE_TIMEOUT,
 	RPC_STATE_URI_LOOKUP,
 	RPC_STATE_FWD_UNREACH,
+	RPC_STATE_COALESCED, /* queued for, or sent in, a coalesced batch */
+	RPC_STATE_LOCAL, /* delivered in process, see crt_local.c */
 } crt_rpc_state_t;
 
 /* corpc info to track the tree topo and child RPCs info */
@@ -168,6 +175,10 @@ struct crt_rpc_priv {
 	uint32_t		crp_timeout_sec;
 	/* the deadline corresponding to crp_timeout_sec */
 	uint32_t                 crp_deadline_sec;
+	/* trace ID set by user, see crt_req_set_trace_id() */
+	uint64_t                 crp_trace_id;
+	/* arrival time of a received request, see crt_req_get_recv_time() */
+	struct timespec          crp_recv_time;
 	/* time stamp to be timeout, the key of timeout binheap */
 	uint64_t		crp_timeout_ts;
 	crt_cb_t		crp_complete_cb;
@@ -218,7 +229,31 @@ struct crt_rpc_priv {
 	    /* release input buffer early */
 	    crp_release_input_early : 1,
 	    /* rpc expired */
-	    crp_expired             : 1;
+	    crp_expired             : 1,
+	    /* already went through a coalesce queue, send it on its own */
+	    crp_coalesce_flushed    : 1,
+	    /* delivered in process, no mercury handle involved */
+	    crp_local               : 1;
+
+	/*
+	 * Coalesced batch this RPC is carried by, see crt_coalesce.c. On the
+	 * origin it is the CRT_OPC_COALESCE request sending it, on the target
+	 * the CRT_OPC_COALESCE request it was unpacked from.
+	 */
+	struct crt_rpc_priv	*crp_coalesce;
+	/* link to crt_coalesce_queue::ccq_rpcs */
+	d_list_t		crp_coalesce_link;
+	/* index of this RPC in its batch (target only) */
+	uint32_t		crp_coalesce_idx;
+	/* number of RPCs of this batch not replied yet (target only) */
+	ATOMIC uint32_t		crp_coalesce_pending;
+
+	/* origin RPC of an RPC delivered in process (target only) */
+	struct crt_rpc_priv	*crp_local_origin;
+	/* reply packed by the target of an RPC delivered in process (origin only) */
+	d_iov_t			crp_local_reply;
+	/* link to crt_local_inbox::cli_reqs (target) or ::cli_replies (origin) */
+	d_list_t		crp_local_link;
 
 	struct crt_opc_info	*crp_opc_info;
 	/* corpc info, only valid when (crp_coll == 1) */
@@ -252,7 +287,8 @@ crt_rpc_unlock(struct crt_rpc_priv *rpc_priv)
 	D_MUTEX_UNLOCK(&rpc_priv->crp_mutex);
 }
 
-#define CRT_PROTO_INTERNAL_VERSION 4
+/* 5: CRT_OPC_COALESCE and the coalesced request and reply format */
+#define CRT_PROTO_INTERNAL_VERSION 5
 #define CRT_PROTO_FI_VERSION 3
 #define CRT_PROTO_ST_VERSION 1
 #define CRT_PROTO_CTL_VERSION 1
@@ -267,24 +303,28 @@ crt_rpc_unlock(struct crt_rpc_priv *rpc_priv)
 #define CRT_INTERNAL_RPCS_LIST                                                                     \
 	X(CRT_OPC_URI_LOOKUP, 0, &CQF_crt_uri_lookup, crt_hdlr_uri_lookup, NULL)                   \
 	X(CRT_OPC_PROTO_QUERY, 0, &CQF_crt_proto_query, crt_hdlr_proto_query, NULL)                \
-	X(CRT_OPC_CTL_LS, 0, &CQF_crt_ctl_ep_ls, crt_hdlr_ctl_ls, NULL)
+	X(CRT_OPC_CTL_LS, 0, &CQF_crt_ctl_ep_ls, crt_hdlr_ctl_ls, NULL)                            \
+	X(CRT_OPC_COALESCE, 0, &CQF_crt_coalesce, crt_hdlr_coalesce, NULL)
 
 #define CRT_FI_RPCS_LIST                                                                           \
 	X(CRT_OPC_CTL_FI_TOGGLE, 0, &CQF_crt_ctl_fi_toggle, crt_hdlr_ctl_fi_toggle, NULL)          \
 	X(CRT_OPC_CTL_FI_SET_ATTR, 0, &CQF_crt_ctl_fi_attr_set, crt_hdlr_ctl_fi_attr_set, NULL)
 
 #define CRT_ST_RPCS_LIST                                                                           \
-	X(CRT_OPC_SELF_TEST_BOTH_EMPTY, 0, NULL, crt_self_test_msg_handler, NULL)                  \
-	X(CRT_OPC_SELF_TEST_SEND_ID_REPLY_IOV, 0, &CQF_crt_st_send_id_reply_iov,                   \
-	  crt_self_test_msg_handler, NULL)                                                         \
-	X(CRT_OPC_SELF_TEST_SEND_IOV_REPLY_EMPTY, 0, &CQF_crt_st_send_iov_reply_empty,             \
+	X(CRT_OPC_SELF_TEST_BOTH_EMPTY, CRT_RPC_FEAT_LOCAL, NULL, crt_self_test_msg_handler,       \
+	  NULL)                                                                                    \
+	X(CRT_OPC_SELF_TEST_SEND_ID_REPLY_IOV, CRT_RPC_FEAT_LOCAL, &CQF_crt_st_send_id_reply_iov,  \
 	  crt_self_test_msg_handler, NULL)                                                         \
-	X(CRT_OPC_SELF_TEST_BOTH_IOV, 0, &CQF_crt_st_both_iov, crt_self_test_msg_handler, NULL)    \
-	X(CRT_OPC_SELF_TEST_SEND_BULK_REPLY_IOV, 0, &CQF_crt_st_send_bulk_reply_iov,               \
+	X(CRT_OPC_SELF_TEST_SEND_IOV_REPLY_EMPTY, CRT_RPC_FEAT_LOCAL,                              \
+	  &CQF_crt_st_send_iov_reply_empty, crt_self_test_msg_handler, NULL)                       \
+	X(CRT_OPC_SELF_TEST_BOTH_IOV, CRT_RPC_FEAT_LOCAL, &CQF_crt_st_both_iov,                    \
 	  crt_self_test_msg_handler, NULL)                                                         \
-	X(CRT_OPC_SELF_TEST_SEND_IOV_REPLY_BULK, 0, &CQF_crt_st_send_iov_reply_bulk,               \
+	X(CRT_OPC_SELF_TEST_SEND_BULK_REPLY_IOV, CRT_RPC_FEAT_LOCAL,                               \
+	  &CQF_crt_st_send_bulk_reply_iov, crt_self_test_msg_handler, NULL)                        \
+	X(CRT_OPC_SELF_TEST_SEND_IOV_REPLY_BULK, CRT_RPC_FEAT_LOCAL,                               \
+	  &CQF_crt_st_send_iov_reply_bulk, crt_self_test_msg_handler, NULL)                        \
+	X(CRT_OPC_SELF_TEST_BOTH_BULK, CRT_RPC_FEAT_LOCAL, &CQF_crt_st_both_bulk,                  \
 	  crt_self_test_msg_handler, NULL)                                                         \
-	X(CRT_OPC_SELF_TEST_BOTH_BULK, 0, &CQF_crt_st_both_bulk, crt_self_test_msg_handler, NULL)  \
 	X(CRT_OPC_SELF_TEST_OPEN_SESSION, 0, &CQF_crt_st_open_session,                             \
 	  crt_self_test_open_session_handler, NULL)                                                \
 	X(CRT_OPC_SELF_TEST_CLOSE_SESSION, 0, &CQF_crt_st_close_session,                           \
@@ -305,10 +345,10 @@ crt_rpc_unlock(struct crt_rpc_priv *rpc_priv)
 
 #define CRT_IV_RPCS_LIST						\
 	X(CRT_OPC_IV_FETCH,						\
-		0, &CQF_crt_iv_fetch,					\
+		CRT_RPC_FEAT_LOCAL, &CQF_crt_iv_fetch,			\
 		crt_hdlr_iv_fetch, NULL)				\
 	X(CRT_OPC_IV_UPDATE,						\
-		0, &CQF_crt_iv_update,					\
+		CRT_RPC_FEAT_LOCAL, &CQF_crt_iv_update,			\
 		crt_hdlr_iv_update, NULL)				\
 	X(CRT_OPC_IV_SYNC,						\
 		0, &CQF_crt_iv_sync,					\
@@ -384,6 +424,16 @@ CRT_GEN_STRUCT(crt_grp_cache, CRT_SEQ_GRP_CACHE)
 
 CRT_RPC_DECLARE(crt_uri_lookup, CRT_ISEQ_URI_LOOKUP, CRT_OSEQ_URI_LOOKUP)
 
+/* each iov is one packed request, or its packed reply, see crt_coalesce.c */
+#define CRT_ISEQ_COALESCE	/* input fields */		 \
+	((d_iov_t)		(cci_reqs)		CRT_ARRAY)
+
+#define CRT_OSEQ_COALESCE	/* output fields */		 \
+	((d_iov_t)		(cco_replies)		CRT_ARRAY) \
+	((int32_t)		(cco_rc)		CRT_VAR)
+
+CRT_RPC_DECLARE(crt_coalesce, CRT_ISEQ_COALESCE, CRT_OSEQ_COALESCE)
+
 #define CRT_ISEQ_ST_SEND_ID	/* input fields */		 \
 	((uint64_t)		(unused1)		CRT_VAR)
 
@@ -673,6 +723,7 @@ int crt_req_create_internal(crt_context_t crt_ctx, crt_endpoint_t *tgt_ep,
 int crt_internal_rpc_register(bool server);
 int crt_rpc_common_hdlr(struct crt_rpc_priv *rpc_priv);
 int crt_req_send_internal(struct crt_rpc_priv *rpc_priv);
+bool crt_req_is_self(struct crt_rpc_priv *rpc_priv);
 
 static inline bool
 crt_req_timedout(struct crt_rpc_priv *rpc_priv)
@@ -721,4 +772,25 @@ int crt_iv_sync_corpc_pre_forward(crt_rpc_t *rpc, void *arg);
 int
 crt_proto_register_internal(struct crt_proto_format *crf);
 
+/* crt_coalesce.c */
+int crt_coalesce_init(struct crt_context *ctx);
+void crt_coalesce_fini(struct crt_context *ctx);
+bool crt_coalesce_enabled(struct crt_rpc_priv *rpc_priv);
+int crt_coalesce_add(struct crt_rpc_priv *rpc_priv);
+void crt_coalesce_progress(struct crt_context *ctx);
+int64_t crt_coalesce_timeout(struct crt_context *ctx, int64_t timeout);
+int crt_coalesce_reply(struct crt_rpc_priv *rpc_priv, int rc);
+void crt_coalesce_req_destroy(struct crt_rpc_priv *rpc_priv);
+void crt_hdlr_coalesce(crt_rpc_t *rpc_req);
+
+/* crt_local.c */
+int crt_local_init(struct crt_context *ctx);
+void crt_local_fini(struct crt_context *ctx);
+bool crt_local_enabled(struct crt_rpc_priv *rpc_priv);
+int crt_local_send(struct crt_rpc_priv *rpc_priv);
+void crt_local_progress(struct crt_context *ctx);
+int64_t crt_local_timeout(struct crt_context *ctx, int64_t timeout);
+int crt_local_reply(struct crt_rpc_priv *rpc_priv, int rc);
+void crt_local_req_destroy(struct crt_rpc_priv *rpc_priv);
+
 #endif /* __CRT_RPC_H__ */
@@ -873,6 +873,36 @@ daos_cont_snap_oit_destroy(daos_handle_t coh, daos_handle_t oh, daos_event_t *ev
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_cont_diff(daos_handle_t coh, const daos_epoch_range_t *epr, uint32_t tgt,
+	       daos_anchor_t *anchor, uint32_t *nr, daos_cont_diff_entry_t *entries,
+	       daos_event_t *ev)
+{
+	daos_cont_diff_t	*args;
+	tse_task_t		*task;
+	int			 rc;
+
+	DAOS_API_ARG_ASSERT(*args, CONT_DIFF);
+
+	if (epr == NULL || epr->epr_lo >= epr->epr_hi || anchor == NULL || nr == NULL ||
+	    *nr == 0 || entries == NULL)
+		return -DER_INVAL;
+
+	rc = dc_task_create(dc_cont_diff, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->coh	= coh;
+	args->epr	= *epr;
+	args->tgt	= tgt;
+	args->nr	= nr;
+	args->anchor	= anchor;
+	args->entries	= entries;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_cont_create_snap(daos_handle_t coh, daos_epoch_t *epoch, char *name,
 		      daos_event_t *ev)
@@ -140,6 +140,9 @@ const struct daos_task_api dc_funcs[] = {
 
 	/** Pipeline */
 	{dc_pipeline_run, sizeof(daos_pipeline_run_t)},
+	{dc_pipeline_run_cont, sizeof(daos_pipeline_run_cont_t)},
+
+	{dc_cont_diff, sizeof(daos_cont_diff_t)},
 };
 
 /* clang-format on */
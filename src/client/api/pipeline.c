@@ -154,3 +154,23 @@ daos_pipeline_run(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline
 
 	return dc_task_schedule(task, true);
 }
+
+int
+daos_pipeline_run_cont(daos_handle_t coh, daos_pipeline_t *pipeline, uint64_t flags,
+		       uint32_t nr_iods, daos_iod_t *iods, d_sg_list_t *sgl_agg,
+		       daos_pipeline_stats_t *stats, daos_event_t *ev)
+{
+	tse_task_t *task;
+	int         rc;
+
+	rc = dc_pipeline_check(pipeline);
+	if (rc != 0)
+		return rc; /** bad pipeline */
+
+	rc = dc_pipeline_run_cont_task_create(coh, pipeline, flags, nr_iods, iods, sgl_agg, stats,
+					      ev, NULL, &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
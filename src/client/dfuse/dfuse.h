@@ -42,6 +42,8 @@ struct dfuse_info {
 	bool                 di_wb_cache;
 	bool                 di_read_only;
 	bool                 di_local_flock;
+	/* Total size of write-back buffers, 0 if disabled */
+	uint64_t             di_wb_buffer_size;
 
 	/* Per process spinlock
 	 * This is used to lock readdir against closedir where they share a readdir handle,
@@ -1033,6 +1035,9 @@ struct dfuse_inode_entry {
 
 	struct active_inode      *ie_active;
 
+	/* Write-back buffer, allocated on first buffered write */
+	struct dfuse_wb          *ie_wb;
+
 	/* Entry on the evict list */
 	d_list_t                  ie_evict_entry;
 };
@@ -1055,18 +1060,40 @@ active_oh_decref(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh);
 void
 active_ie_decref(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *ie);
 
-/* Flush write-back cache writes to a inode.  It does this by waiting for and then releasing an
- * exclusive lock on the inode.  Writes take a shared lock so this will block until all pending
- * writes are complete.
+/* Write-back buffering of small writes, see wb.c */
+
+/* Copy a write into the write-back buffer of the inode, called with a shared lock on ie_wlock
+ * which is kept by the buffer or released.  Returns EAGAIN if the write should not be buffered,
+ * in which case the lock is still held.
  */
+int
+dfuse_wb_write(struct dfuse_info *dfuse_info, struct dfuse_eq *eqt, struct dfuse_obj_hdl *oh,
+	       struct fuse_bufvec *bufv, off_t position, size_t len);
 
-#define DFUSE_IE_WFLUSH(_ie)                                                                       \
-	do {                                                                                       \
-		if ((_ie)->ie_dfs->dfc_wb_cache && S_ISREG((_ie)->ie_stat.st_mode)) {              \
-			D_RWLOCK_WRLOCK(&(_ie)->ie_wlock);                                         \
-			D_RWLOCK_UNLOCK(&(_ie)->ie_wlock);                                         \
-		}                                                                                  \
-	} while (0)
+/* Flush write-back cache writes to a inode.  It does this by writing any buffered data then
+ * waiting for and releasing an exclusive lock on the inode.  Writes take a shared lock so this
+ * will block until all pending writes are complete.  Write-back errors are kept for
+ * dfuse_wb_sync().
+ */
+void
+dfuse_wb_flush(struct dfuse_inode_entry *ie);
+
+/* Flush as above for flush and fsync, returns and clears the first write-back error since the
+ * last call.
+ */
+int
+dfuse_wb_sync(struct dfuse_inode_entry *ie);
+
+void
+dfuse_wb_fini(struct dfuse_inode_entry *ie);
+
+int
+dfuse_wb_thread_start(struct dfuse_info *dfuse_info);
+
+void
+dfuse_wb_thread_stop();
+
+#define DFUSE_IE_WFLUSH(_ie) dfuse_wb_flush(_ie)
 
 /* Lookup an inode and take a ref on it. */
 static inline struct dfuse_inode_entry *
@@ -1238,6 +1265,7 @@ dfuse_ie_init(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *ie);
 #define dfuse_ie_free(_di, _ie)                                                                    \
 	do {                                                                                       \
 		atomic_fetch_sub_relaxed(&(_di)->di_inode_count, 1);                               \
+		dfuse_wb_fini(_ie);                                                                \
 		D_FREE(_ie);                                                                       \
 	} while (0)
 
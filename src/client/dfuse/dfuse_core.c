@@ -1716,6 +1716,9 @@ dfuse_fs_stop(struct dfuse_info *dfuse_info)
 
 	DFUSE_TRA_INFO(dfuse_info, "Flushing inode table");
 
+	/* Write back any buffered data while the progress threads are still running */
+	dfuse_wb_thread_stop();
+
 	dfuse_info->di_shutdown = true;
 
 	for (int i = 0; i < dfuse_info->di_eq_count; i++) {
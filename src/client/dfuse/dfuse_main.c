@@ -203,6 +203,12 @@ dfuse_launch_fuse(struct dfuse_info *dfuse_info, struct fuse_args *args)
 	if (rc != 0)
 		D_GOTO(umount, rc = daos_errno2der(rc));
 
+	if (dfuse_info->di_wb_buffer_size != 0) {
+		rc = dfuse_wb_thread_start(dfuse_info);
+		if (rc != 0)
+			D_GOTO(umount, rc = daos_errno2der(rc));
+	}
+
 	rc = dfuse_send_to_fg(0);
 	if (rc != -DER_SUCCESS)
 		DFUSE_TRA_ERROR(dfuse_info, "Error sending signal to fg: "DF_RC, DP_RC(rc));
@@ -290,6 +296,7 @@ show_help(char *name)
 	    "	   --enable-local-flock	Enable the support of local flock\n"
 	    "	   --disable-caching	Disable all caching\n"
 	    "	   --disable-wb-cache	Use write-through rather than write-back cache\n"
+	    "	   --write-buffer=MiB	Merge small writes into buffers of up to MiB in total\n"
 	    "	-o options		mount style options string\n"
 	    "\n"
 	    "	   --multi-user		Run dfuse in multi user mode\n"
@@ -449,6 +456,7 @@ main(int argc, char **argv)
 					     {"enable-local-flock", no_argument, 0, 'L'},
 					     {"disable-caching", no_argument, 0, 'A'},
 					     {"disable-wb-cache", no_argument, 0, 'B'},
+					     {"write-buffer", required_argument, 0, 'W'},
 					     {"dump-handles", required_argument, 0, 'D'},
 					     {"read-handles", required_argument, 0, 'R'},
 					     {"read-only", no_argument, 0, 'r'},
@@ -512,6 +520,9 @@ main(int argc, char **argv)
 		case 'B':
 			dfuse_info->di_wb_cache = false;
 			break;
+		case 'W':
+			dfuse_info->di_wb_buffer_size = strtoul(optarg, NULL, 10) << 20;
+			break;
 		case 'm':
 			dfuse_info->di_mountpoint = optarg;
 			break;
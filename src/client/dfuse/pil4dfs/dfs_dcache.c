@@ -21,6 +21,7 @@
 #include <daos/common.h>
 
 #include "dfs_dcache.h"
+#include "dfs_dcache_shm.h"
 
 #define DF_TS                "%ld.%09ld"
 #define DP_TS(t)             (t).tv_sec, (t).tv_nsec
@@ -72,6 +73,8 @@ struct dfs_dcache {
 	struct timespec     dd_expire_gc;
 	/** True iff one thread is running the garbage collection */
 	atomic_flag         dd_running_gc;
+	/** Node-local dir-cache shared with the other processes, NULL if not used */
+	dcache_shm_t       *dd_shm;
 	/** Destroy a dfs dir-cache */
 	destroy_fn_t        destroy_fn;
 	/** Return the dir-cahe record of a given location and insert it if needed */
@@ -434,7 +437,7 @@ out:
 
 static int
 dcache_create_act(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_period,
-		  uint32_t gc_reclaim_max, dfs_dcache_t **dcache)
+		  uint32_t gc_reclaim_max, uint32_t shm_bits, dfs_dcache_t **dcache)
 {
 	dfs_dcache_t *dcache_tmp;
 	dfs_obj_t    *obj;
@@ -487,6 +490,10 @@ dcache_create_act(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_p
 	if (rc != 0)
 		D_GOTO(error_add_root, rc);
 
+	/* The process keeps working with its own dir-cache if the shared one can't be used */
+	if (shm_bits != 0)
+		dcache_shm_attach(dfs, shm_bits, rec_timeout, &dcache_tmp->dd_shm);
+
 	*dcache = dcache_tmp;
 	D_GOTO(out, rc = -DER_SUCCESS);
 
@@ -522,6 +529,8 @@ dcache_destroy_act(dfs_dcache_t *dcache)
 	}
 	D_ASSERT(dcache->dd_count_gc == 0);
 
+	dcache_shm_detach(dcache->dd_shm);
+
 	rc = d_hash_table_destroy_inplace(&dcache->dd_dir_hash, false);
 	if (rc != 0) {
 		DL_ERROR(rc, "d_hash_table_destroy_inplace() failed");
@@ -573,11 +582,18 @@ dcache_add(dfs_dcache_t *dcache, dcache_rec_t *parent, const char *name, const c
 	atomic_init(&rec_tmp->dr_ref, 1);
 	atomic_flag_clear(&rec_tmp->dr_deleted);
 
-	rc = dfs_lookup_rel(dcache->dd_dfs, parent->dr_obj, name, O_RDWR, &obj, &mode, NULL);
-	if (rc != 0)
-		D_GOTO(error, rc = daos_errno2der(rc));
-	if (!S_ISDIR(mode))
-		D_GOTO(error, rc = -DER_NOTDIR);
+	/* Only directories are inserted in the shared dir-cache */
+	if (dcache->dd_shm == NULL ||
+	    dcache_shm_lookup(dcache->dd_shm, key, key_len, &obj) != -DER_SUCCESS) {
+		rc = dfs_lookup_rel(dcache->dd_dfs, parent->dr_obj, name, O_RDWR, &obj, &mode,
+				    NULL);
+		if (rc != 0)
+			D_GOTO(error, rc = daos_errno2der(rc));
+		if (!S_ISDIR(mode))
+			D_GOTO(error, rc = -DER_NOTDIR);
+		if (dcache->dd_shm != NULL)
+			dcache_shm_insert(dcache->dd_shm, key, key_len, obj);
+	}
 	rec_tmp->dr_obj = obj;
 
 	rc = dfs_obj2id(obj, &obj_id);
@@ -761,6 +777,9 @@ drec_del_act(dfs_dcache_t *dcache, char *path, dcache_rec_t *parent)
 	rc = -DER_SUCCESS;
 
 out:
+	/* The directory may be cached by the other processes even if not by this one */
+	if (key != NULL && dcache->dd_shm != NULL)
+		dcache_shm_remove(dcache->dd_shm, key, key_len);
 	D_FREE(key);
 	return rc;
 }
@@ -862,7 +881,7 @@ drec_del_at_dact(dfs_dcache_t *dcache, dcache_rec_t *rec)
 
 int
 dcache_create(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_period,
-	      uint32_t gc_reclaim_max, dfs_dcache_t **dcache)
+	      uint32_t gc_reclaim_max, uint32_t shm_bits, dfs_dcache_t **dcache)
 {
 	D_ASSERT(dcache != NULL);
 	D_ASSERT(dfs != NULL);
@@ -870,7 +889,8 @@ dcache_create(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_perio
 	if (rec_timeout == 0)
 		return dcache_create_dact(dfs, dcache);
 
-	return dcache_create_act(dfs, bits, rec_timeout, gc_period, gc_reclaim_max, dcache);
+	return dcache_create_act(dfs, bits, rec_timeout, gc_period, gc_reclaim_max, shm_bits,
+				 dcache);
 }
 int
 dcache_destroy(dfs_dcache_t *dcache)
@@ -29,13 +29,16 @@ typedef struct dcache_rec dcache_rec_t;
  *				is equal to zero, the garbage collector is deactivated.
  * \param[in] gc_reclaim_max	Maximal number of dir-cache record to reclaim per garbage collector
  *				trigger
+ * \param[in] shm_bits		Power2(shm_bits) is the size of the node-local dir-cache shared with
+ *				the other processes.  When this value is equal to zero, the shared
+ *				dir-cache is not used.
  * \param[out] dcache		The newly created dir-cache
  *
  * \return			0 on success, negative value on error
  */
 int
 dcache_create(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_period,
-	      uint32_t gc_reclaim_max, dfs_dcache_t **dcache);
+	      uint32_t gc_reclaim_max, uint32_t shm_bits, dfs_dcache_t **dcache);
 
 /**
  * Destroy a dfs dir-cache.
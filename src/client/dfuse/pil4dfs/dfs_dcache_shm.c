@@ -0,0 +1,471 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/**
+ * Node-local shared directory cache.
+ *
+ * Every process using libpil4dfs walks and looks up the same directories of a container, all the
+ * ranks of a job on a node doing so again and again for the same inputs.  This cache is a second
+ * level of the per-process dir-cache held in a POSIX shared memory segment, named after the user
+ * and the container, so only the first process of the node has to look up a directory.  The entry
+ * of a directory is its dfs global handle, from which the other processes open the object without
+ * any RPC.
+ *
+ * The cache is a direct-mapped table of entries indexed by the hash of their dir-cache key, an
+ * entry replacing any other one in its slot.  Entries are read without lock and checked with a
+ * sequence number which is odd while an entry is being written, and with a checksum.  They expire
+ * after the dir-cache record timeout, or are removed when a process removes or renames the
+ * directory.  As the keys are made of the object ID of the parent directory, renaming a directory
+ * doesn't change the keys of its children.
+ *
+ * The sequence number also records when the entry started to be written, an entry left odd by a
+ * process killed while writing it is taken over by the next writer once DCACHE_SHM_STALE_S have
+ * passed.  The checksum rejects an entry that a writer too slow to notice it was taken over
+ * overwrote afterwards.
+ *
+ * Every attached process holds a shared lock on the segment, the last one to detach unlinks it.
+ * A segment left by killed processes is reused, or unlinked and created again if it doesn't match
+ * the configuration of the cache.
+ */
+
+#define D_LOGFAC DD_FAC(il)
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <daos/debug.h>
+#include <gurt/hash.h>
+#include <daos_fs.h>
+#include <daos/common.h>
+#include <daos/container.h>
+
+#include "dfs_dcache_shm.h"
+
+#define DCACHE_SHM_MAGIC        0xdc5a3e01
+#define DCACHE_SHM_VERSION      2
+/** Large enough for the key of a directory: the prefix of its parent and its name */
+#define DCACHE_SHM_KEY_MAX      320
+#define DCACHE_SHM_GLOB_MAX     512
+#define DCACHE_SHM_BITS_MAX     20
+/** Time to wait in micro-seconds for the process creating the cache to initialize it */
+#define DCACHE_SHM_WAIT_US      (100 * 1000)
+/** Number of attempts to remove an entry being written by another process */
+#define DCACHE_SHM_REMOVE_RETRY 1000
+/** Time in seconds after which an entry still being written was left by a killed process */
+#define DCACHE_SHM_STALE_S      2
+
+/** Entry of the shared dir-cache */
+struct dcache_shm_slot {
+	/**
+	 * Odd while the entry is being written.  The upper 32 bits are the date in seconds at which
+	 * the entry was locked, the lower ones a counter.
+	 */
+	_Atomic uint64_t ds_seq;
+	/** Expiration date in seconds of CLOCK_MONOTONIC_COARSE, the same in all processes */
+	uint64_t         ds_expire;
+	/** Checksum of the key and of the global handle */
+	uint64_t         ds_csum;
+	uint32_t         ds_key_len;
+	uint32_t         ds_glob_len;
+	char             ds_key[DCACHE_SHM_KEY_MAX];
+	char             ds_glob[DCACHE_SHM_GLOB_MAX];
+};
+
+/** Header of the shared memory segment */
+struct dcache_shm_hdr {
+	uint32_t               dh_magic;
+	uint32_t               dh_version;
+	uint32_t               dh_bits;
+	uint32_t               dh_slot_size;
+	/** Set once the header is initialized by the process creating the segment */
+	_Atomic uint32_t       dh_ready;
+	uint32_t               dh_padding;
+	struct dcache_shm_slot dh_slots[];
+};
+
+/** Attachment of a process to a shared dir-cache */
+struct dcache_shm {
+	/** Cached DAOS file system */
+	dfs_t                 *dm_dfs;
+	/** Mapped shared memory segment */
+	struct dcache_shm_hdr *dm_hdr;
+	size_t                 dm_size;
+	/** Descriptor of the segment holding the shared lock of the process */
+	int                    dm_fd;
+	char                   dm_name[NAME_MAX];
+	uint32_t               dm_mask;
+	/** Lifetime of an entry in seconds */
+	uint32_t               dm_timeout;
+};
+
+static inline uint64_t
+dcache_shm_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	return now.tv_sec;
+}
+
+static inline struct dcache_shm_slot *
+dcache_shm_slot(dcache_shm_t *shm, const char *key, size_t key_len)
+{
+	return &shm->dm_hdr->dh_slots[d_hash_string_u32(key, key_len) & shm->dm_mask];
+}
+
+static inline uint64_t
+dcache_shm_csum(const char *key, size_t key_len, const char *glob, size_t glob_len)
+{
+	return d_hash_murmur64((const unsigned char *)glob, glob_len,
+			       d_hash_string_u32(key, key_len));
+}
+
+/**
+ * Lock an entry for writing, taking it over from a process killed while writing it.  Return the
+ * odd sequence number to unlock it with, or 0 if the entry is being written by another process.
+ */
+static uint64_t
+dcache_shm_slot_lock(struct dcache_shm_slot *slot, uint64_t now)
+{
+	uint64_t seq;
+	uint64_t locked;
+
+	seq = atomic_load_relaxed(&slot->ds_seq);
+	if (seq & 1) {
+		if (now < (seq >> 32) + DCACHE_SHM_STALE_S)
+			return 0;
+		D_DEBUG(DB_TRACE, "taking over shared dir-cache entry locked at %" PRIu64 "\n",
+			seq >> 32);
+		locked = (now << 32) | (uint32_t)(seq + 2);
+	} else {
+		locked = (now << 32) | (uint32_t)(seq + 1);
+	}
+
+	if (!atomic_compare_exchange_strong(&slot->ds_seq, &seq, locked))
+		return 0;
+	atomic_thread_fence(memory_order_release);
+	return locked;
+}
+
+static void
+dcache_shm_slot_unlock(struct dcache_shm_slot *slot, uint64_t locked)
+{
+	uint64_t seq = locked;
+
+	/* Fails if the entry was taken over, the process which did it rewrites it */
+	atomic_compare_exchange_strong_explicit(&slot->ds_seq, &seq,
+						(locked & ~(uint64_t)UINT32_MAX) |
+						    (uint32_t)(locked + 1),
+						memory_order_release, memory_order_relaxed);
+}
+
+/** Open the segment and take the shared lock of the attached processes */
+static int
+dcache_shm_open(const char *name, bool *create, int *fd)
+{
+	struct stat st;
+	int         rc;
+
+	*create = true;
+	*fd     = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (*fd < 0 && errno == EEXIST) {
+		*create = false;
+		*fd     = shm_open(name, O_RDWR, 0600);
+	}
+	if (*fd < 0)
+		return d_errno2der(errno);
+
+	/* The mode given to shm_open() is masked by the umask */
+	if (*create && fchmod(*fd, S_IRUSR | S_IWUSR) != 0)
+		D_GOTO(error, rc = d_errno2der(errno));
+
+	/* Anyone can create a segment of that name, and it gives access to the container */
+	if (fstat(*fd, &st) != 0)
+		D_GOTO(error, rc = d_errno2der(errno));
+	if (st.st_uid != getuid() || (st.st_mode & ALLPERMS) != (S_IRUSR | S_IWUSR)) {
+		D_ERROR("shared dir-cache %s owned by %u with mode %o\n", name, st.st_uid,
+			st.st_mode & ALLPERMS);
+		D_GOTO(error, rc = -DER_NO_PERM);
+	}
+
+	if (flock(*fd, LOCK_SH) != 0)
+		D_GOTO(error, rc = d_errno2der(errno));
+	return -DER_SUCCESS;
+
+error:
+	if (*create)
+		shm_unlink(name);
+	close(*fd);
+	return rc;
+}
+
+static int
+dcache_shm_map(int fd, size_t size, uint32_t bits, bool create, struct dcache_shm_hdr **hdr)
+{
+	struct dcache_shm_hdr *hdr_tmp;
+	struct stat            st;
+	void                  *addr;
+	int                    i;
+
+	if (create) {
+		if (ftruncate(fd, size) != 0)
+			return d_errno2der(errno);
+	} else {
+		/* The creating process may not have sized the segment yet */
+		for (i = 0; i < DCACHE_SHM_WAIT_US / 1000; i++) {
+			if (fstat(fd, &st) != 0)
+				return d_errno2der(errno);
+			if (st.st_size != 0)
+				break;
+			usleep(1000);
+		}
+		if (st.st_size != size)
+			return -DER_MISMATCH;
+	}
+
+	addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (addr == MAP_FAILED)
+		return d_errno2der(errno);
+	hdr_tmp = addr;
+
+	if (create) {
+		hdr_tmp->dh_magic     = DCACHE_SHM_MAGIC;
+		hdr_tmp->dh_version   = DCACHE_SHM_VERSION;
+		hdr_tmp->dh_bits      = bits;
+		hdr_tmp->dh_slot_size = sizeof(struct dcache_shm_slot);
+		atomic_store_explicit(&hdr_tmp->dh_ready, 1, memory_order_release);
+	} else {
+		for (i = 0; i < DCACHE_SHM_WAIT_US / 1000; i++) {
+			if (atomic_load_explicit(&hdr_tmp->dh_ready, memory_order_acquire))
+				break;
+			usleep(1000);
+		}
+		if (!atomic_load_explicit(&hdr_tmp->dh_ready, memory_order_acquire) ||
+		    hdr_tmp->dh_magic != DCACHE_SHM_MAGIC ||
+		    hdr_tmp->dh_version != DCACHE_SHM_VERSION || hdr_tmp->dh_bits != bits ||
+		    hdr_tmp->dh_slot_size != sizeof(struct dcache_shm_slot)) {
+			munmap(addr, size);
+			return -DER_MISMATCH;
+		}
+	}
+
+	*hdr = hdr_tmp;
+	return -DER_SUCCESS;
+}
+
+int
+dcache_shm_attach(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, dcache_shm_t **shm)
+{
+	dcache_shm_t          *shm_tmp;
+	struct dcache_shm_hdr *hdr = NULL;
+	daos_handle_t          coh;
+	uuid_t                 coh_uuid;
+	uuid_t                 cont_uuid;
+	size_t                 size;
+	bool                   create;
+	int                    fd;
+	int                    i;
+	int                    rc;
+
+	D_ASSERT(shm != NULL);
+	if (bits == 0 || bits > DCACHE_SHM_BITS_MAX)
+		return -DER_INVAL;
+
+	rc = dfs_cont_get(dfs, &coh);
+	if (rc != 0)
+		return daos_errno2der(rc);
+	rc = dc_cont_hdl2uuid(coh, &coh_uuid, &cont_uuid);
+	dfs_cont_put(dfs, coh);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_PTR(shm_tmp);
+	if (shm_tmp == NULL)
+		return -DER_NOMEM;
+	shm_tmp->dm_dfs     = dfs;
+	shm_tmp->dm_mask    = (1U << bits) - 1;
+	shm_tmp->dm_timeout = rec_timeout;
+
+	/* The segment is private to the user as it gives access to the container */
+	snprintf(shm_tmp->dm_name, sizeof(shm_tmp->dm_name), "/daos_il_dcache.%u." DF_UUIDF,
+		 getuid(), DP_UUID(cont_uuid));
+	size = sizeof(*hdr) + ((size_t)1 << bits) * sizeof(struct dcache_shm_slot);
+
+	for (i = 0;; i++) {
+		rc = dcache_shm_open(shm_tmp->dm_name, &create, &fd);
+		if (rc != -DER_SUCCESS)
+			D_GOTO(error, rc);
+
+		rc = dcache_shm_map(fd, size, bits, create, &hdr);
+		if (rc == -DER_SUCCESS)
+			break;
+		if (create)
+			shm_unlink(shm_tmp->dm_name);
+
+		/* Left by killed processes of another version or configuration of the cache, it is
+		 * created again unless other processes are still using it.
+		 */
+		if (rc != -DER_MISMATCH || i > 0 || flock(fd, LOCK_EX | LOCK_NB) != 0) {
+			close(fd);
+			D_GOTO(error, rc);
+		}
+		D_DEBUG(DB_TRACE, "unlinking stale shared dir-cache %s\n", shm_tmp->dm_name);
+		shm_unlink(shm_tmp->dm_name);
+		close(fd);
+	}
+	shm_tmp->dm_hdr  = hdr;
+	shm_tmp->dm_size = size;
+	shm_tmp->dm_fd   = fd;
+
+	D_DEBUG(DB_TRACE, "%s shared dir-cache %s: size=%zu\n", create ? "created" : "attached",
+		shm_tmp->dm_name, size);
+	*shm = shm_tmp;
+	return -DER_SUCCESS;
+
+error:
+	DL_WARN(rc, "shared dir-cache %s not used", shm_tmp->dm_name);
+	D_FREE(shm_tmp);
+	return rc;
+}
+
+void
+dcache_shm_detach(dcache_shm_t *shm)
+{
+	if (shm == NULL)
+		return;
+
+	munmap(shm->dm_hdr, shm->dm_size);
+
+	/* Only the last process attached gets the exclusive lock */
+	if (flock(shm->dm_fd, LOCK_EX | LOCK_NB) == 0) {
+		D_DEBUG(DB_TRACE, "unlinking shared dir-cache %s\n", shm->dm_name);
+		shm_unlink(shm->dm_name);
+	}
+	close(shm->dm_fd);
+	D_FREE(shm);
+}
+
+int
+dcache_shm_lookup(dcache_shm_t *shm, const char *key, size_t key_len, dfs_obj_t **obj)
+{
+	struct dcache_shm_slot *slot;
+	char                    glob_buf[DCACHE_SHM_GLOB_MAX];
+	d_iov_t                 glob;
+	uint64_t                seq;
+	uint64_t                csum = 0;
+	bool                    match;
+	int                     rc;
+
+	if (key_len >= DCACHE_SHM_KEY_MAX)
+		return -DER_NONEXIST;
+
+	slot = dcache_shm_slot(shm, key, key_len);
+	seq  = atomic_load_explicit(&slot->ds_seq, memory_order_acquire);
+	if (seq & 1)
+		return -DER_NONEXIST;
+
+	match = slot->ds_key_len == key_len && memcmp(slot->ds_key, key, key_len) == 0 &&
+		slot->ds_expire > dcache_shm_now() && slot->ds_glob_len <= sizeof(glob_buf);
+	if (match) {
+		memcpy(glob_buf, slot->ds_glob, slot->ds_glob_len);
+		csum = slot->ds_csum;
+	}
+	d_iov_set(&glob, glob_buf, slot->ds_glob_len);
+
+	/* The entry was rewritten while being read */
+	atomic_thread_fence(memory_order_acquire);
+	if (!match || atomic_load_relaxed(&slot->ds_seq) != seq)
+		return -DER_NONEXIST;
+
+	if (csum != dcache_shm_csum(key, key_len, glob_buf, glob.iov_len)) {
+		D_DEBUG(DB_TRACE, "corrupted shared dir-cache entry: key_len=%zu\n", key_len);
+		return -DER_NONEXIST;
+	}
+
+	rc = dfs_obj_global2local(shm->dm_dfs, O_RDWR, glob, obj);
+	if (rc != 0) {
+		DS_WARN(rc, "dfs_obj_global2local() failed");
+		return daos_errno2der(rc);
+	}
+	D_DEBUG(DB_TRACE, "shared dir-cache hit: key_len=%zu\n", key_len);
+	return -DER_SUCCESS;
+}
+
+void
+dcache_shm_insert(dcache_shm_t *shm, const char *key, size_t key_len, dfs_obj_t *obj)
+{
+	struct dcache_shm_slot *slot;
+	char                    glob_buf[DCACHE_SHM_GLOB_MAX];
+	d_iov_t                 glob;
+	uint64_t                now;
+	uint64_t                locked;
+	int                     rc;
+
+	if (key_len >= DCACHE_SHM_KEY_MAX)
+		return;
+
+	d_iov_set(&glob, glob_buf, 0);
+	glob.iov_buf_len = sizeof(glob_buf);
+	rc = dfs_obj_local2global(shm->dm_dfs, obj, &glob);
+	if (rc != 0) {
+		DS_WARN(rc, "dfs_obj_local2global() failed");
+		return;
+	}
+
+	/* Leave the entry to the process already writing it */
+	slot   = dcache_shm_slot(shm, key, key_len);
+	now    = dcache_shm_now();
+	locked = dcache_shm_slot_lock(slot, now);
+	if (locked == 0)
+		return;
+
+	slot->ds_expire   = now + shm->dm_timeout;
+	slot->ds_csum     = dcache_shm_csum(key, key_len, glob_buf, glob.iov_len);
+	slot->ds_key_len  = key_len;
+	slot->ds_glob_len = glob.iov_len;
+	memcpy(slot->ds_key, key, key_len);
+	memcpy(slot->ds_glob, glob_buf, glob.iov_len);
+
+	dcache_shm_slot_unlock(slot, locked);
+}
+
+void
+dcache_shm_remove(dcache_shm_t *shm, const char *key, size_t key_len)
+{
+	struct dcache_shm_slot *slot;
+	uint64_t                locked = 0;
+	int                     i;
+
+	if (key_len >= DCACHE_SHM_KEY_MAX)
+		return;
+
+	/* Unlike an insertion a removal waits for the entry to be written, an entry left odd by a
+	 * process killed while writing it is never found until it is taken over.
+	 */
+	slot = dcache_shm_slot(shm, key, key_len);
+	for (i = 0; i < DCACHE_SHM_REMOVE_RETRY; i++) {
+		locked = dcache_shm_slot_lock(slot, dcache_shm_now());
+		if (locked != 0)
+			break;
+		sched_yield();
+	}
+	if (locked == 0)
+		return;
+
+	if (slot->ds_key_len == key_len && memcmp(slot->ds_key, key, key_len) == 0)
+		slot->ds_key_len = 0;
+
+	dcache_shm_slot_unlock(slot, locked);
+}
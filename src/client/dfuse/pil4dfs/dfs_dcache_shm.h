@@ -0,0 +1,75 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+#ifndef __DFS_DCACHE_SHM_H__
+#define __DFS_DCACHE_SHM_H__
+
+#include <daos_fs.h>
+
+/** Node-local directory cache shared by all the processes of a user accessing a container */
+typedef struct dcache_shm dcache_shm_t;
+
+/**
+ * Attach the shared dir-cache of the container of a dfs, creating it if needed.  The shared memory
+ * segment of the cache is only used if it is owned by the user and only accessible to them.
+ *
+ * \param[in] dfs		The DAOS File System to cache
+ * \param[in] bits		Power2(bits) is the number of entries of the cache
+ * \param[in] rec_timeout	Timeout in seconds of an entry
+ * \param[out] shm		The attached shared dir-cache
+ *
+ * \return			0 on success, -DER_NO_PERM if the segment is not private to the
+ *				user, -DER_MISMATCH if it is used by processes with another
+ *				configuration of the cache, negative value on other errors
+ */
+int
+dcache_shm_attach(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, dcache_shm_t **shm);
+
+/**
+ * Detach from a shared dir-cache.  The cache is kept for the other processes attached to it, the
+ * last one unlinks it.
+ *
+ * \param[in] shm	The shared dir-cache to detach from
+ */
+void
+dcache_shm_detach(dcache_shm_t *shm);
+
+/**
+ * Look up a dir-cache key in a shared dir-cache and open the directory it refers to.
+ *
+ * \param[in] shm	The shared dir-cache
+ * \param[in] key	Key of the directory
+ * \param[in] key_len	Length of the key, not including null terminating ('\0').
+ * \param[out] obj	The opened directory
+ *
+ * \return		0 on success, -DER_NONEXIST if not found or expired, negative value on
+ *			other errors
+ */
+int
+dcache_shm_lookup(dcache_shm_t *shm, const char *key, size_t key_len, dfs_obj_t **obj);
+
+/**
+ * Insert a directory in a shared dir-cache, replacing any entry using the same slot.
+ *
+ * \param[in] shm	The shared dir-cache
+ * \param[in] key	Key of the directory
+ * \param[in] key_len	Length of the key, not including null terminating ('\0').
+ * \param[in] obj	The directory
+ */
+void
+dcache_shm_insert(dcache_shm_t *shm, const char *key, size_t key_len, dfs_obj_t *obj);
+
+/**
+ * Remove a directory from a shared dir-cache, for all the processes attached to it.
+ *
+ * \param[in] shm	The shared dir-cache
+ * \param[in] key	Key of the directory
+ * \param[in] key_len	Length of the key, not including null terminating ('\0').
+ */
+void
+dcache_shm_remove(dcache_shm_t *shm, const char *key, size_t key_len);
+
+#endif /* __DFS_DCACHE_SHM_H__ */
@@ -117,6 +117,7 @@ static uint32_t               dcache_size_bits;
 static uint32_t               dcache_rec_timeout;
 static uint32_t               dcache_gc_reclaim_max;
 static uint32_t               dcache_gc_period;
+static uint32_t               dcache_shm_bits;
 
 static _Atomic uint64_t        num_read;
 static _Atomic uint64_t        num_write;
@@ -925,7 +926,8 @@ retrieve_handles_from_fuse(int idx)
 	}
 
 	rc = dcache_create(dfs_list[idx].dfs, dcache_size_bits, dcache_rec_timeout,
-			   dcache_gc_period, dcache_gc_reclaim_max, &dfs_list[idx].dcache);
+			   dcache_gc_period, dcache_gc_reclaim_max, dcache_shm_bits,
+			   &dfs_list[idx].dcache);
 	if (rc != 0) {
 		errno_saved = daos_der2errno(rc);
 		D_DEBUG(DB_ANY,
@@ -1115,8 +1117,8 @@ new_dlopen(const char *filename, int flags)
  *  Dynamically allocate 2 * DFS_MAX_PATH for *parent_dir and *full_path in one malloc().
  */
 static int
-query_path(const char *szInput, int *is_target_path, struct dcache_rec **parent, char *item_name,
-	   char **parent_dir, char **full_path, struct dfs_mt **dfs_mt)
+query_path_common(const char *szInput, int *is_target_path, struct dcache_rec **parent,
+		  char *item_name, char **parent_dir, char **full_path, struct dfs_mt **dfs_mt)
 {
 	int    pos, len;
 	bool   with_daos_prefix;
@@ -1373,6 +1375,18 @@ out_oom:
 	return ENOMEM;
 }
 
+/** query_path_common() once the queued asynchronous metadata operations are done, so that the
+ *  caller sees them as if they were synchronous.
+ */
+static int
+query_path(const char *szInput, int *is_target_path, struct dcache_rec **parent, char *item_name,
+	   char **parent_dir, char **full_path, struct dfs_mt **dfs_mt)
+{
+	d_meta_async_wait();
+	return query_path_common(szInput, is_target_path, parent, item_name, parent_dir, full_path,
+				 dfs_mt);
+}
+
 static int
 remove_dot_dot(char path[], int *len)
 {
@@ -2478,7 +2492,7 @@ new_close_common(int (*next_close)(int fd), int fd)
 	if (fd_directed >= FD_DIR_BASE) {
 		/* directory */
 		free_dirfd(fd_directed - FD_DIR_BASE);
-		return 0;
+		goto out_async;
 	} else if (fd_directed >= FD_FILE_BASE) {
 		/* This fd is a kernel fd. There was a duplicate fd created. */
 		if (fd < FD_FILE_BASE)
@@ -2486,9 +2500,18 @@ new_close_common(int (*next_close)(int fd), int fd)
 
 		/* This fd is a fake fd. There exists a associated kernel fd with dup2. */
 		free_fd(fd - FD_FILE_BASE, false);
-		return 0;
+		goto out_async;
 	}
 	return next_close(fd);
+
+out_async:
+	/* report the errors of the asynchronous metadata operations, like a write-back error */
+	rc = d_meta_async_barrier();
+	if (rc) {
+		errno = rc;
+		return (-1);
+	}
+	return 0;
 }
 
 static int
@@ -4047,6 +4070,7 @@ seekdir(DIR *dirp, long loc)
 		return;
 	}
 
+	d_meta_async_wait();
 	while (num_entry) {
 		num_to_read = min(READ_DIR_BATCH_SIZE, num_entry);
 
@@ -4141,6 +4165,7 @@ new_readdir(DIR *dirp)
 	if (mydir->num_ents)
 		goto out_readdir;
 
+	d_meta_async_wait();
 	mydir->num_ents = READ_DIR_BATCH_SIZE;
 	while (!daos_anchor_is_eof(&mydir->anchor)) {
 		rc = dfs_readdir(dir_list[mydir->fd - FD_DIR_BASE]->dfs_mt->dfs, mydir->dir,
@@ -4488,6 +4513,11 @@ reset_daos_env_before_exec(void)
 {
 	int rc;
 
+	/* the queued metadata operations are lost by exec() */
+	rc = d_meta_async_barrier();
+	if (rc)
+		DS_ERROR(rc, "asynchronous metadata operations failed");
+
 	/* bash does fork(), then close opened files before exec(),
 	 * so the fd for log file probably is invalid now.
 	 */
@@ -5356,8 +5386,12 @@ fchdir(int dirfd)
 	return 0;
 }
 
+/* Remove an entry on DAOS, *is_target is set to false if the path is not on DAOS. The removal is
+ * queued to the asynchronous metadata threads if async is set and they are enabled, any error is
+ * then returned by the next fsync() or close().
+ */
 static int
-new_unlink(const char *path)
+unlink_common(const char *path, bool async, bool *is_target)
 {
 	int                is_target_path, rc;
 	char               item_name[DFS_MAX_NAME];
@@ -5366,18 +5400,24 @@ new_unlink(const char *path)
 	char              *parent_dir = NULL;
 	char              *full_path  = NULL;
 
-	if (!d_hook_enabled)
-		return libc_unlink(path);
-
-	rc = query_path(path, &is_target_path, &parent, item_name, &parent_dir,
-			&full_path, &dfs_mt);
+	/* only the parent directory is looked up, the queued removals do not need to be done */
+	if (async)
+		rc = query_path_common(path, &is_target_path, &parent, item_name, &parent_dir,
+				       &full_path, &dfs_mt);
+	else
+		rc = query_path(path, &is_target_path, &parent, item_name, &parent_dir,
+				&full_path, &dfs_mt);
 	if (rc)
 		D_GOTO(out_err, rc);
+	*is_target = is_target_path;
 	if (!is_target_path)
 		goto out_org;
 
 	atomic_fetch_add_relaxed(&num_unlink, 1);
 
+	if (async && d_meta_async_unlink(dfs_mt, parent, item_name, parent_dir, full_path) == 0)
+		return 0;
+
 	rc = dfs_remove(dfs_mt->dfs, drec2obj(parent), item_name, false, NULL);
 	if (rc)
 		D_GOTO(out_err, rc);
@@ -5396,9 +5436,10 @@ out_org:
 	if (parent != NULL)
 		drec_decref(dfs_mt->dcache, parent);
 	FREE(parent_dir);
-	return libc_unlink(path);
+	return 0;
 
 out_err:
+	*is_target = true;
 	if (parent != NULL)
 		drec_decref(dfs_mt->dcache, parent);
 	FREE(parent_dir);
@@ -5406,17 +5447,30 @@ out_err:
 	return (-1);
 }
 
+static int
+new_unlink(const char *path)
+{
+	bool is_target;
+	int  rc;
+
+	if (!d_hook_enabled)
+		return libc_unlink(path);
+
+	rc = unlink_common(path, true, &is_target);
+	if (!is_target)
+		return libc_unlink(path);
+	return rc;
+}
+
 int
 unlinkat(int dirfd, const char *path, int flags)
 {
-	int                is_target_path, rc, error = 0;
-	int                idx_dfs;
-	char               item_name[DFS_MAX_NAME];
-	struct dfs_mt     *dfs_mt          = NULL;
-	char              *full_path       = NULL;
-	struct dcache_rec *parent          = NULL;
-	char              *parent_dir      = NULL;
-	char              *full_path_dummy = NULL;
+	int   rc, error = 0;
+	int   idx_dfs;
+	bool  is_target;
+	/* a directory is only removed once its content has been */
+	bool  async     = !(flags & AT_REMOVEDIR);
+	char *full_path = NULL;
 
 	if (next_unlinkat == NULL) {
 		next_unlinkat = dlsym(RTLD_NEXT, "unlinkat");
@@ -5427,37 +5481,23 @@ unlinkat(int dirfd, const char *path, int flags)
 
 	if (path[0] == '/') {
 		/* absolute path, dirfd is ignored */
-		rc = query_path(path, &is_target_path, &parent, item_name, &parent_dir,
-				&full_path_dummy, &dfs_mt);
-		if (rc)
-			D_GOTO(out_err, rc);
-		if (!is_target_path)
-			goto out_org;
-		atomic_fetch_add_relaxed(&num_unlink, 1);
-
-		rc = dfs_remove(dfs_mt->dfs, drec2obj(parent), item_name, false, NULL);
-		if (rc)
-			D_GOTO(out_err_abs, rc);
-
-		if (parent != NULL) {
-			rc = drec_del(dfs_mt->dcache, full_path_dummy, parent);
-			if (rc != -DER_SUCCESS && rc != -DER_NONEXIST)
-				DL_ERROR(rc, "DAOS directory cache cleanup failed");
-		}
-
-		drec_decref(dfs_mt->dcache, parent);
-		FREE(parent_dir);
-		return 0;
+		rc = unlink_common(path, async, &is_target);
+		if (!is_target)
+			return next_unlinkat(dirfd, path, flags);
+		return rc;
 	}
 
 	idx_dfs = check_path_with_dirfd(dirfd, &full_path, path, &error);
 	if (error)
 		goto out_err;
 
-	if (idx_dfs >= 0)
-		rc = new_unlink(full_path);
-	else
+	if (idx_dfs >= 0) {
+		rc = unlink_common(full_path, async, &is_target);
+		if (!is_target)
+			rc = libc_unlink(full_path);
+	} else {
 		rc = next_unlinkat(dirfd, path, flags);
+	}
 
 	error = errno;
 	if (full_path)
@@ -5466,19 +5506,6 @@ unlinkat(int dirfd, const char *path, int flags)
 		errno = error;
 	return rc;
 
-out_org:
-	if (parent != NULL)
-		drec_decref(dfs_mt->dcache, parent);
-	FREE(parent_dir);
-	return next_unlinkat(dirfd, path, flags);
-
-out_err_abs:
-	if (parent != NULL)
-		drec_decref(dfs_mt->dcache, parent);
-	FREE(parent_dir);
-	errno = rc;
-	return (-1);
-
 out_err:
 	errno = error;
 	return (-1);
@@ -5487,7 +5514,7 @@ out_err:
 int
 fsync(int fd)
 {
-	int fd_directed;
+	int rc, fd_directed;
 
 	if (next_fsync == NULL) {
 		next_fsync = dlsym(RTLD_NEXT, "fsync");
@@ -5503,6 +5530,12 @@ fsync(int fd)
 	if (fd < FD_DIR_BASE && d_compatible_mode)
 		return next_fsync(fd);
 
+	rc = d_meta_async_barrier();
+	if (rc) {
+		errno = rc;
+		return (-1);
+	}
+
 	/* errno = ENOTSUP;
 	 * return (-1);
 	 */
@@ -5512,7 +5545,7 @@ fsync(int fd)
 int
 fdatasync(int fd)
 {
-	int fd_directed;
+	int rc, fd_directed;
 
 	if (next_fdatasync == NULL) {
 		next_fdatasync = dlsym(RTLD_NEXT, "fdatasync");
@@ -5528,6 +5561,12 @@ fdatasync(int fd)
 	if (fd < FD_DIR_BASE && d_compatible_mode)
 		return next_fdatasync(fd);
 
+	rc = d_meta_async_barrier();
+	if (rc) {
+		errno = rc;
+		return (-1);
+	}
+
 	return 0;
 }
 
@@ -7195,6 +7234,7 @@ init_myhook(void)
 	char    *env_no_bypass;
 	int      rc;
 	uint64_t eq_count_loc = 0;
+	uint32_t async_meta_threads;
 	float    libc_version;
 
 	/* D_IL_NO_BYPASS is ONLY for testing. It always keeps function interception enabled in
@@ -7330,6 +7370,17 @@ init_myhook(void)
 		dcache_gc_reclaim_max = DCACHE_GC_RECLAIM_MAX;
 	}
 
+	dcache_shm_bits = 0;
+	rc              = d_getenv_uint32_t("D_IL_DCACHE_SHM_BITS", &dcache_shm_bits);
+	if (rc != -DER_SUCCESS && rc != -DER_NONEXIST)
+		DL_WARN(rc, "'D_IL_DCACHE_SHM_BITS' env variable could not be used");
+
+	async_meta_threads = 0;
+	rc                 = d_getenv_uint32_t("D_IL_ASYNC_META_THREADS", &async_meta_threads);
+	if (rc != -DER_SUCCESS && rc != -DER_NONEXIST)
+		DL_WARN(rc, "'D_IL_ASYNC_META_THREADS' env variable could not be used");
+	d_meta_async_init(async_meta_threads);
+
 	register_a_hook("libc", "open64", (void *)new_open_libc, (long int *)(&libc_open));
 	register_a_hook("libpthread", "open64", (void *)new_open_pthread,
 			(long int *)(&pthread_open));
@@ -7571,7 +7622,8 @@ init_dfs(int idx)
 	}
 
 	rc = dcache_create(dfs_list[idx].dfs, dcache_size_bits, dcache_rec_timeout,
-			   dcache_gc_period, dcache_gc_reclaim_max, &dfs_list[idx].dcache);
+			   dcache_gc_period, dcache_gc_reclaim_max, dcache_shm_bits,
+			   &dfs_list[idx].dcache);
 	if (rc != 0) {
 		DL_ERROR(rc, "failed to create DFS directory cache");
 		D_GOTO(out_err_ht, rc = daos_der2errno(rc));
@@ -7606,6 +7658,8 @@ finalize_dfs(void)
 	/* Disable interception */
 	d_hook_enabled = 0;
 
+	d_meta_async_fini();
+
 	for (i = 0; i < num_dfs; i++) {
 		if (atomic_load_relaxed(&(dfs_list[i].inited)) == 0) {
 			D_ASSERT(dfs_list[i].dcache == NULL);
@@ -0,0 +1,265 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/**
+ * Asynchronous metadata operations of libpil4dfs.
+ *
+ * Bulk metadata tools such as "rm -rf" remove many entries in a row, each removal waiting for the
+ * RPCs of dfs_remove().  libdfs has no asynchronous version of its metadata calls, so when enabled
+ * the removals of files are queued to a small pool of threads which run them in parallel, and the
+ * call returns at once.  Any call looking up a path waits for the queued operations first, so that
+ * they appear to be done in order, and the first error is returned by the next fsync(), close() of
+ * a DAOS file or directory or logged on exit.  fork() also waits for the queued operations, from
+ * pthread_atfork() handlers so that none is queued by another thread in the meantime.
+ */
+
+#define D_LOGFAC DD_FAC(il)
+
+#include <pthread.h>
+
+#include <daos.h>
+#include <daos_fs.h>
+#include <daos/debug.h>
+#include <daos/common.h>
+
+#include "pil4dfs_int.h"
+
+/* Number of operations queued per thread before the caller waits */
+#define META_DEPTH_PER_THREAD 64
+#define META_THREADS_MAX      64
+
+struct meta_op {
+	d_list_t           mo_link;
+	struct dfs_mt     *mo_dfs_mt;
+	/* Reference on the parent directory, released once the entry is removed */
+	struct dcache_rec *mo_parent;
+	/* Buffer of query_path() holding the full path, freed once the entry is removed */
+	char              *mo_parent_dir;
+	char              *mo_full_path;
+	char               mo_name[DFS_MAX_NAME];
+};
+
+static pthread_mutex_t  meta_lock      = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   meta_cond      = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   meta_done_cond = PTHREAD_COND_INITIALIZER;
+static D_LIST_HEAD(meta_queue);
+static pthread_t        meta_threads[META_THREADS_MAX];
+/* Number of threads to use, 0 if asynchronous operations are disabled */
+static uint32_t         meta_thread_nr;
+static uint32_t         meta_thread_started;
+static bool             meta_stop;
+/* Number of operations queued or running */
+static _Atomic uint32_t meta_pending;
+/* First error since the last barrier */
+static int              meta_error;
+
+static int
+meta_op_exec(struct meta_op *op)
+{
+	struct dfs_mt *dfs_mt = op->mo_dfs_mt;
+	int            rc;
+
+	rc = dfs_remove(dfs_mt->dfs, drec2obj(op->mo_parent), op->mo_name, false, NULL);
+	if (rc != 0) {
+		DS_ERROR(rc, "asynchronous removal of '%s' failed", op->mo_full_path);
+	} else if (op->mo_parent != NULL) {
+		int rc2;
+
+		rc2 = drec_del(dfs_mt->dcache, op->mo_full_path, op->mo_parent);
+		if (rc2 != -DER_SUCCESS && rc2 != -DER_NONEXIST)
+			DL_ERROR(rc2, "DAOS directory cache cleanup failed");
+	}
+
+	drec_decref(dfs_mt->dcache, op->mo_parent);
+	free(op->mo_parent_dir);
+	D_FREE(op);
+	return rc;
+}
+
+static void *
+meta_thread_fn(void *arg)
+{
+	struct meta_op *op;
+	int             rc;
+
+	D_MUTEX_LOCK(&meta_lock);
+	while (1) {
+		while (!meta_stop && d_list_empty(&meta_queue))
+			pthread_cond_wait(&meta_cond, &meta_lock);
+
+		op = d_list_pop_entry(&meta_queue, struct meta_op, mo_link);
+		if (op == NULL)
+			break;
+		D_MUTEX_UNLOCK(&meta_lock);
+
+		rc = meta_op_exec(op);
+
+		D_MUTEX_LOCK(&meta_lock);
+		if (rc != 0 && meta_error == 0)
+			meta_error = rc;
+		atomic_fetch_sub_relaxed(&meta_pending, 1);
+		pthread_cond_broadcast(&meta_done_cond);
+	}
+	D_MUTEX_UNLOCK(&meta_lock);
+	return NULL;
+}
+
+/* Start the threads on the first operation, called with meta_lock held */
+static int
+meta_thread_start(void)
+{
+	int rc;
+
+	while (meta_thread_started < meta_thread_nr) {
+		rc = pthread_create(&meta_threads[meta_thread_started], NULL, meta_thread_fn, NULL);
+		if (rc != 0)
+			break;
+		pthread_setname_np(meta_threads[meta_thread_started], "pil4dfs meta");
+		meta_thread_started++;
+	}
+	if (meta_thread_started == 0) {
+		DS_WARN(rc, "pthread_create() failed");
+		return rc;
+	}
+	return 0;
+}
+
+/* The child must not see the queued operations, neither run them again */
+static void
+meta_atfork_prepare(void)
+{
+	D_MUTEX_LOCK(&meta_lock);
+	while (atomic_load_relaxed(&meta_pending) != 0)
+		pthread_cond_wait(&meta_done_cond, &meta_lock);
+}
+
+static void
+meta_atfork_parent(void)
+{
+	D_MUTEX_UNLOCK(&meta_lock);
+}
+
+/* The threads are not copied by fork(), they are started again on the next operation */
+static void
+meta_atfork_child(void)
+{
+	D_MUTEX_INIT(&meta_lock, NULL);
+	pthread_cond_init(&meta_cond, NULL);
+	pthread_cond_init(&meta_done_cond, NULL);
+	D_INIT_LIST_HEAD(&meta_queue);
+	atomic_store_relaxed(&meta_pending, 0);
+	meta_thread_started = 0;
+	meta_stop           = false;
+	meta_error          = 0;
+}
+
+void
+d_meta_async_init(uint32_t thread_nr)
+{
+	int rc;
+
+	if (thread_nr > META_THREADS_MAX) {
+		D_WARN("asynchronous metadata thread count (%u) should not exceed: %d", thread_nr,
+		       META_THREADS_MAX);
+		thread_nr = META_THREADS_MAX;
+	}
+	if (thread_nr == 0)
+		return;
+
+	rc = pthread_atfork(meta_atfork_prepare, meta_atfork_parent, meta_atfork_child);
+	if (rc != 0) {
+		DS_WARN(rc, "pthread_atfork() failed, asynchronous metadata operations disabled");
+		return;
+	}
+	meta_thread_nr = thread_nr;
+}
+
+int
+d_meta_async_unlink(struct dfs_mt *dfs_mt, struct dcache_rec *parent, const char *name,
+		    char *parent_dir, char *full_path)
+{
+	struct meta_op *op;
+	int             rc;
+
+	if (meta_thread_nr == 0)
+		return ENOTSUP;
+
+	D_ALLOC_PTR(op);
+	if (op == NULL)
+		return ENOMEM;
+	op->mo_dfs_mt     = dfs_mt;
+	op->mo_parent     = parent;
+	op->mo_parent_dir = parent_dir;
+	op->mo_full_path  = full_path;
+	strncpy(op->mo_name, name, DFS_MAX_NAME - 1);
+
+	D_MUTEX_LOCK(&meta_lock);
+	if (meta_thread_started == 0) {
+		rc = meta_thread_start();
+		if (rc != 0) {
+			D_MUTEX_UNLOCK(&meta_lock);
+			D_FREE(op);
+			return rc;
+		}
+	}
+	while (atomic_load_relaxed(&meta_pending) >= meta_thread_started * META_DEPTH_PER_THREAD)
+		pthread_cond_wait(&meta_done_cond, &meta_lock);
+
+	d_list_add_tail(&op->mo_link, &meta_queue);
+	atomic_fetch_add_relaxed(&meta_pending, 1);
+	pthread_cond_signal(&meta_cond);
+	D_MUTEX_UNLOCK(&meta_lock);
+	return 0;
+}
+
+void
+d_meta_async_wait(void)
+{
+	if (atomic_load_relaxed(&meta_pending) == 0)
+		return;
+
+	D_MUTEX_LOCK(&meta_lock);
+	while (atomic_load_relaxed(&meta_pending) != 0)
+		pthread_cond_wait(&meta_done_cond, &meta_lock);
+	D_MUTEX_UNLOCK(&meta_lock);
+}
+
+int
+d_meta_async_barrier(void)
+{
+	int rc;
+
+	if (meta_thread_started == 0)
+		return 0;
+
+	D_MUTEX_LOCK(&meta_lock);
+	while (atomic_load_relaxed(&meta_pending) != 0)
+		pthread_cond_wait(&meta_done_cond, &meta_lock);
+	rc         = meta_error;
+	meta_error = 0;
+	D_MUTEX_UNLOCK(&meta_lock);
+	return rc;
+}
+
+void
+d_meta_async_fini(void)
+{
+	uint32_t i;
+	int      rc;
+
+	rc = d_meta_async_barrier();
+	if (rc != 0)
+		DS_ERROR(rc, "asynchronous metadata operations failed");
+
+	D_MUTEX_LOCK(&meta_lock);
+	meta_stop = true;
+	pthread_cond_broadcast(&meta_cond);
+	D_MUTEX_UNLOCK(&meta_lock);
+
+	for (i = 0; i < meta_thread_started; i++)
+		pthread_join(meta_threads[i], NULL);
+	meta_thread_started = 0;
+}
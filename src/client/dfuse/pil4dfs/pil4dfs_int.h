@@ -92,4 +92,17 @@ struct dfs_mt {
 	char            *fs_root;
 };
 
+/* Asynchronous metadata operations, see meta.c */
+void
+d_meta_async_init(uint32_t thread_nr);
+int
+d_meta_async_unlink(struct dfs_mt *dfs_mt, struct dcache_rec *parent, const char *name,
+		    char *parent_dir, char *full_path);
+void
+d_meta_async_wait(void);
+int
+d_meta_async_barrier(void);
+void
+d_meta_async_fini(void);
+
 #endif
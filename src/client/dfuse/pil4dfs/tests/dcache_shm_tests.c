@@ -0,0 +1,348 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * Unit tests for the shared dir-cache of dfs_dcache_shm.c, built with it to check its entries.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <sys/wait.h>
+#include <cmocka.h>
+
+#include "../dfs_dcache_shm.c"
+
+#include <daos/tests_lib.h>
+
+#define TEST_BITS 4
+
+/*
+ * Mocks, a directory is its name and so is its global handle
+ */
+struct dfs_obj {
+	char to_name[32];
+};
+
+static struct dfs_obj test_objs[2] = {{"dir_a"}, {"dir_b"}};
+static uuid_t         test_cont_uuid;
+static char           test_name[NAME_MAX];
+
+int
+dfs_cont_get(dfs_t *dfs, daos_handle_t *coh)
+{
+	coh->cookie = 1;
+	return 0;
+}
+
+int
+dfs_cont_put(dfs_t *dfs, daos_handle_t coh)
+{
+	return 0;
+}
+
+int
+dc_cont_hdl2uuid(daos_handle_t coh, uuid_t *hdl_uuid, uuid_t *con_uuid)
+{
+	uuid_clear(*hdl_uuid);
+	uuid_copy(*con_uuid, test_cont_uuid);
+	return 0;
+}
+
+int
+dfs_obj_local2global(dfs_t *dfs, dfs_obj_t *obj, d_iov_t *glob)
+{
+	glob->iov_len = strlen(obj->to_name) + 1;
+	assert_true(glob->iov_len <= glob->iov_buf_len);
+	memcpy(glob->iov_buf, obj->to_name, glob->iov_len);
+	return 0;
+}
+
+int
+dfs_obj_global2local(dfs_t *dfs, int flags, d_iov_t glob, dfs_obj_t **obj)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(test_objs); i++) {
+		if (strcmp(glob.iov_buf, test_objs[i].to_name) == 0) {
+			*obj = &test_objs[i];
+			return 0;
+		}
+	}
+	return ENOENT;
+}
+
+/*
+ * Helpers
+ */
+static dcache_shm_t *
+shm_attach(uint32_t bits)
+{
+	dcache_shm_t *shm = NULL;
+	int           rc;
+
+	rc = dcache_shm_attach(NULL, bits, 60, &shm);
+	assert_rc_equal(rc, 0);
+	assert_non_null(shm);
+	assert_string_equal(shm->dm_name, test_name);
+	return shm;
+}
+
+static bool
+shm_exists(void)
+{
+	int fd;
+
+	fd = shm_open(test_name, O_RDWR, 0);
+	if (fd < 0) {
+		assert_int_equal(errno, ENOENT);
+		return false;
+	}
+	close(fd);
+	return true;
+}
+
+static void
+shm_check(dcache_shm_t *shm, const char *key, dfs_obj_t *expected)
+{
+	dfs_obj_t *obj = NULL;
+	int        rc;
+
+	rc = dcache_shm_lookup(shm, key, strlen(key), &obj);
+	if (expected == NULL) {
+		assert_rc_equal(rc, -DER_NONEXIST);
+	} else {
+		assert_rc_equal(rc, 0);
+		assert_ptr_equal(obj, expected);
+	}
+}
+
+/*
+ * Tests
+ */
+static void
+test_shm_insert_remove(void **state)
+{
+	dcache_shm_t *shm_a;
+	dcache_shm_t *shm_b;
+
+	/* Each attachment stands for a process */
+	shm_a = shm_attach(TEST_BITS);
+	shm_b = shm_attach(TEST_BITS);
+
+	dcache_shm_insert(shm_a, "key_a", 5, &test_objs[0]);
+	shm_check(shm_b, "key_a", &test_objs[0]);
+	shm_check(shm_b, "key_b", NULL);
+
+	/* Replaced in its slot by an entry of another key */
+	dcache_shm_insert(shm_b, "key_a", 5, &test_objs[1]);
+	shm_check(shm_a, "key_a", &test_objs[1]);
+
+	dcache_shm_remove(shm_a, "key_a", 5);
+	shm_check(shm_b, "key_a", NULL);
+
+	dcache_shm_detach(shm_a);
+	dcache_shm_detach(shm_b);
+}
+
+static void
+test_shm_unlink(void **state)
+{
+	dcache_shm_t *shm_a;
+	dcache_shm_t *shm_b;
+
+	shm_a = shm_attach(TEST_BITS);
+	shm_b = shm_attach(TEST_BITS);
+	dcache_shm_insert(shm_a, "key_a", 5, &test_objs[0]);
+
+	/* Kept for the other process attached to it */
+	dcache_shm_detach(shm_a);
+	assert_true(shm_exists());
+	shm_check(shm_b, "key_a", &test_objs[0]);
+
+	/* And unlinked by the last one */
+	dcache_shm_detach(shm_b);
+	assert_false(shm_exists());
+
+	shm_a = shm_attach(TEST_BITS);
+	shm_check(shm_a, "key_a", NULL);
+	dcache_shm_detach(shm_a);
+	assert_false(shm_exists());
+}
+
+static void
+test_shm_owner(void **state)
+{
+	dcache_shm_t *shm = NULL;
+	int           fd;
+	int           rc;
+
+	/* A segment readable by other users is not used, nor unlinked */
+	fd = shm_open(test_name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	assert_true(fd >= 0);
+	assert_int_equal(fchmod(fd, 0644), 0);
+	assert_int_equal(ftruncate(fd, 4096), 0);
+
+	rc = dcache_shm_attach(NULL, TEST_BITS, 60, &shm);
+	assert_rc_equal(rc, -DER_NO_PERM);
+	assert_null(shm);
+	assert_true(shm_exists());
+
+	/* Nor a segment that the user can't write */
+	assert_int_equal(fchmod(fd, 0400), 0);
+	rc = dcache_shm_attach(NULL, TEST_BITS, 60, &shm);
+	assert_true(rc != 0);
+	assert_null(shm);
+
+	close(fd);
+	assert_int_equal(shm_unlink(test_name), 0);
+}
+
+static void
+test_shm_mismatch(void **state)
+{
+	dcache_shm_t *shm_a;
+	dcache_shm_t *shm_b = NULL;
+	int           fd;
+	int           rc;
+
+	/* Used by a process with another configuration */
+	shm_a = shm_attach(TEST_BITS);
+	rc    = dcache_shm_attach(NULL, TEST_BITS + 1, 60, &shm_b);
+	assert_rc_equal(rc, -DER_MISMATCH);
+	assert_null(shm_b);
+	assert_true(shm_exists());
+	dcache_shm_detach(shm_a);
+	assert_false(shm_exists());
+
+	/* Left by killed processes, it is created again */
+	fd = shm_open(test_name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	assert_true(fd >= 0);
+	assert_int_equal(ftruncate(fd, 4096), 0);
+	close(fd);
+
+	shm_b = shm_attach(TEST_BITS + 1);
+	dcache_shm_insert(shm_b, "key_a", 5, &test_objs[0]);
+	shm_check(shm_b, "key_a", &test_objs[0]);
+	dcache_shm_detach(shm_b);
+	assert_false(shm_exists());
+}
+
+static void
+test_shm_killed_writer(void **state)
+{
+	struct dcache_shm_slot *slot;
+	dcache_shm_t           *shm;
+	uint64_t                seq;
+	pid_t                   pid;
+	int                     status;
+
+	shm = shm_attach(TEST_BITS);
+	dcache_shm_insert(shm, "key_a", 5, &test_objs[0]);
+	slot = dcache_shm_slot(shm, "key_a", 5);
+
+	/* A process killed while writing the entry */
+	pid = fork();
+	assert_true(pid >= 0);
+	if (pid == 0) {
+		if (dcache_shm_slot_lock(slot, dcache_shm_now()) == 0)
+			_exit(1);
+		memset(slot->ds_glob, 0, sizeof(slot->ds_glob));
+		_exit(0);
+	}
+	assert_int_equal(waitpid(pid, &status, 0), pid);
+	assert_true(WIFEXITED(status));
+	assert_int_equal(WEXITSTATUS(status), 0);
+
+	/* The entry is neither found nor written until it is stale */
+	seq = atomic_load(&slot->ds_seq);
+	assert_true(seq & 1);
+	shm_check(shm, "key_a", NULL);
+	dcache_shm_insert(shm, "key_a", 5, &test_objs[1]);
+	dcache_shm_remove(shm, "key_a", 5);
+	assert_int_equal(atomic_load(&slot->ds_seq), seq);
+
+	/* Then it is taken over by the next writer */
+	sleep(DCACHE_SHM_STALE_S + 1);
+	dcache_shm_insert(shm, "key_a", 5, &test_objs[1]);
+	seq = atomic_load(&slot->ds_seq);
+	assert_false(seq & 1);
+	shm_check(shm, "key_a", &test_objs[1]);
+
+	/* The unlock of a writer whose entry was taken over is ignored */
+	seq = dcache_shm_slot_lock(slot, dcache_shm_now() - DCACHE_SHM_STALE_S);
+	assert_true(seq & 1);
+	assert_true(dcache_shm_slot_lock(slot, dcache_shm_now()) != 0);
+	dcache_shm_slot_unlock(slot, seq);
+	assert_true(atomic_load(&slot->ds_seq) & 1);
+
+	dcache_shm_detach(shm);
+}
+
+static void
+test_shm_corrupted(void **state)
+{
+	struct dcache_shm_slot *slot;
+	dcache_shm_t           *shm;
+
+	shm = shm_attach(TEST_BITS);
+	dcache_shm_insert(shm, "key_a", 5, &test_objs[0]);
+	slot = dcache_shm_slot(shm, "key_a", 5);
+
+	/* Overwritten by a writer which didn't notice its entry was taken over */
+	slot->ds_glob[0] = 'X';
+	shm_check(shm, "key_a", NULL);
+
+	dcache_shm_insert(shm, "key_a", 5, &test_objs[0]);
+	shm_check(shm, "key_a", &test_objs[0]);
+
+	dcache_shm_detach(shm);
+}
+
+static int
+test_setup(void **state)
+{
+	/* A new container for each test, not to use the segment of another one */
+	uuid_generate(test_cont_uuid);
+	snprintf(test_name, sizeof(test_name), "/daos_il_dcache.%u." DF_UUIDF, getuid(),
+		 DP_UUID(test_cont_uuid));
+	return 0;
+}
+
+static int
+test_teardown(void **state)
+{
+	shm_unlink(test_name);
+	return 0;
+}
+
+static int
+setup(void **state)
+{
+	return d_log_init();
+}
+
+static int
+teardown(void **state)
+{
+	d_log_fini();
+	return 0;
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test_setup_teardown(test_shm_insert_remove, test_setup, test_teardown),
+	    cmocka_unit_test_setup_teardown(test_shm_unlink, test_setup, test_teardown),
+	    cmocka_unit_test_setup_teardown(test_shm_owner, test_setup, test_teardown),
+	    cmocka_unit_test_setup_teardown(test_shm_mismatch, test_setup, test_teardown),
+	    cmocka_unit_test_setup_teardown(test_shm_killed_writer, test_setup, test_teardown),
+	    cmocka_unit_test_setup_teardown(test_shm_corrupted, test_setup, test_teardown),
+	};
+
+	return cmocka_run_group_tests_name("pil4dfs_dcache_shm", tests, setup, teardown);
+}
@@ -0,0 +1,387 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+#include <pthread.h>
+
+#include "dfuse_common.h"
+#include "dfuse.h"
+
+/* Write-back buffering.
+ *
+ * With the write-back cache enabled the kernel sends writes of at most a page or so for many
+ * I/O patterns, each of which would otherwise become a dfs_write() call.  When enabled dfuse
+ * keeps one buffer per inode, contiguous writes are copied into it and replied to at once, then
+ * the buffer is written as one dfs_write() when it's full, when a write doesn't follow on from
+ * it, on flush/fsync/close/read/getattr, after DFUSE_WB_TIMEOUT seconds or when the total size
+ * of buffers exceeds the limit.  Buffers are taken from the write slab of each event queue in
+ * turn so writing them back is spread over the progress threads.
+ *
+ * A buffer holds a shared lock on ie_wlock from the first write into it until the dfs_write()
+ * completes so DFUSE_IE_WFLUSH() waits for it as for any other write-back write.  Errors are kept
+ * on the inode until returned by dfuse_wb_sync() to the next flush or fsync call, the other paths
+ * waiting for the writes leave them there.
+ *
+ * Writes larger than half a buffer bypass it.  Lock ordering is wb_lock then wb_list_lock, the
+ * timer thread only ever uses trylock on wb_lock.
+ */
+
+/* Seconds that data may sit in a buffer before being written */
+#define DFUSE_WB_TIMEOUT 1
+
+struct dfuse_wb {
+	pthread_mutex_t     wb_lock;
+	struct dfuse_event *wb_ev;
+	/* File offset of the start of the buffer */
+	off_t               wb_off;
+	/* Time of the first write into the buffer */
+	struct timespec     wb_time;
+	/* Entry on wb_dirty_list while wb_ev is set and not submitted */
+	d_list_t            wb_entry;
+	/* First error from writing the buffer, cleared when reported */
+	int                 wb_error;
+};
+
+static pthread_mutex_t wb_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static D_LIST_HEAD(wb_dirty_list);
+static sem_t           wb_sem;
+static pthread_t       wb_thread;
+static bool            wb_stop;
+static ATOMIC bool     wb_pressure;
+static ATOMIC uint64_t wb_dirty;
+
+/* Used by the tests to simulate the failure of write-back writes */
+static struct d_fault_attr_t *wb_fault_attr;
+
+static void
+wb_release(struct dfuse_event *ev)
+{
+	atomic_fetch_sub_relaxed(&wb_dirty, ev->de_iov.iov_buf_len);
+	D_RWLOCK_UNLOCK(&ev->de_oh->doh_ie->ie_wlock);
+	daos_event_fini(&ev->de_ev);
+	d_slab_release(ev->de_eqt->de_write_slab, ev);
+}
+
+static void
+wb_write_complete(struct dfuse_event *ev)
+{
+	struct dfuse_inode_entry *ie = ev->de_oh->doh_ie;
+	int                       rc = ev->de_ev.ev_error;
+
+	if (rc != 0) {
+		DHS_ERROR(ie, rc, "Write-back of %#zx-%#zx failed", ev->de_req_position,
+			  ev->de_req_position + ev->de_iov.iov_len - 1);
+		D_MUTEX_LOCK(&ie->ie_wb->wb_lock);
+		if (ie->ie_wb->wb_error == 0)
+			ie->ie_wb->wb_error = rc;
+		D_MUTEX_UNLOCK(&ie->ie_wb->wb_lock);
+	}
+	wb_release(ev);
+}
+
+/* Write the buffer to dfs, called with wb_lock held */
+static void
+wb_submit(struct dfuse_wb *wb)
+{
+	struct dfuse_event *ev = wb->wb_ev;
+	int                 rc;
+
+	if (!d_list_empty(&wb->wb_entry)) {
+		D_MUTEX_LOCK(&wb_list_lock);
+		d_list_del_init(&wb->wb_entry);
+		D_MUTEX_UNLOCK(&wb_list_lock);
+	}
+	wb->wb_ev = NULL;
+
+	DFUSE_TRA_DEBUG(ev->de_oh, "Writing back %#zx-%#zx", wb->wb_off,
+			wb->wb_off + ev->de_iov.iov_len - 1);
+
+	ev->de_req_position = wb->wb_off;
+	if (D_SHOULD_FAIL(wb_fault_attr))
+		rc = EIO;
+	else
+		rc = dfs_write(ev->de_oh->doh_dfs, ev->de_oh->doh_obj, &ev->de_sgl, wb->wb_off,
+			       &ev->de_ev);
+	if (rc != 0) {
+		DHS_ERROR(ev->de_oh, rc, "dfs_write() failed");
+		if (wb->wb_error == 0)
+			wb->wb_error = rc;
+		wb_release(ev);
+		return;
+	}
+	dfuse_eq_wakeup(ev->de_eqt);
+}
+
+static struct dfuse_wb *
+wb_get(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_wb *wb;
+
+	if (ie->ie_wb != NULL)
+		return ie->ie_wb;
+
+	D_ALLOC_PTR(wb);
+	if (wb == NULL)
+		return NULL;
+	if (D_MUTEX_INIT(&wb->wb_lock, NULL) != 0) {
+		D_FREE(wb);
+		return NULL;
+	}
+	D_INIT_LIST_HEAD(&wb->wb_entry);
+
+	/* The inode is open so ie_active is set, use it's lock against concurrent writes */
+	D_SPIN_LOCK(&ie->ie_active->lock);
+	if (ie->ie_wb == NULL) {
+		ie->ie_wb = wb;
+		wb        = NULL;
+	}
+	D_SPIN_UNLOCK(&ie->ie_active->lock);
+
+	if (wb != NULL) {
+		D_MUTEX_DESTROY(&wb->wb_lock);
+		D_FREE(wb);
+	}
+	return ie->ie_wb;
+}
+
+int
+dfuse_wb_write(struct dfuse_info *dfuse_info, struct dfuse_eq *eqt, struct dfuse_obj_hdl *oh,
+	       struct fuse_bufvec *bufv, off_t position, size_t len)
+{
+	struct dfuse_inode_entry *ie   = oh->doh_ie;
+	struct fuse_bufvec        ibuf = FUSE_BUFVEC_INIT(len);
+	struct dfuse_event       *ev;
+	struct dfuse_wb          *wb;
+	int                       rc;
+
+	wb = wb_get(ie);
+	if (wb == NULL)
+		return EAGAIN;
+
+	D_MUTEX_LOCK(&wb->wb_lock);
+
+	ev = wb->wb_ev;
+	if (ev != NULL && (position != wb->wb_off + ev->de_iov.iov_len ||
+			   len > ev->de_iov.iov_buf_len - ev->de_iov.iov_len)) {
+		wb_submit(wb);
+		ev = NULL;
+	}
+
+	if (ev == NULL) {
+		if (len > DFUSE_MAX_READ / 2)
+			D_GOTO(out, rc = EAGAIN);
+
+		if (atomic_load_relaxed(&wb_dirty) + DFUSE_MAX_READ > dfuse_info->di_wb_buffer_size) {
+			if (!atomic_exchange(&wb_pressure, true))
+				sem_post(&wb_sem);
+			D_GOTO(out, rc = EAGAIN);
+		}
+
+		ev = d_slab_acquire(eqt->de_write_slab);
+		if (ev == NULL)
+			D_GOTO(out, rc = ENOMEM);
+
+		ev->de_oh          = oh;
+		ev->de_req         = 0;
+		ev->de_len         = 0;
+		ev->de_iov.iov_len = 0;
+		ev->de_complete_cb = wb_write_complete;
+		atomic_fetch_add_relaxed(&wb_dirty, ev->de_iov.iov_buf_len);
+
+		wb->wb_ev  = ev;
+		wb->wb_off = position;
+		clock_gettime(CLOCK_MONOTONIC, &wb->wb_time);
+
+		D_MUTEX_LOCK(&wb_list_lock);
+		d_list_add_tail(&wb->wb_entry, &wb_dirty_list);
+		D_MUTEX_UNLOCK(&wb_list_lock);
+
+		d_slab_restock(eqt->de_write_slab);
+	}
+
+	ibuf.buf[0].mem = ev->de_iov.iov_buf + ev->de_iov.iov_len;
+
+	rc = fuse_buf_copy(&ibuf, bufv, 0);
+	if (rc != len) {
+		/* Write back any earlier writes, the caller drops it's own lock on error */
+		if (ev->de_iov.iov_len != 0) {
+			wb_submit(wb);
+			D_GOTO(out, rc = EIO);
+		}
+		wb->wb_ev = NULL;
+		D_MUTEX_LOCK(&wb_list_lock);
+		d_list_del_init(&wb->wb_entry);
+		D_MUTEX_UNLOCK(&wb_list_lock);
+		atomic_fetch_sub_relaxed(&wb_dirty, ev->de_iov.iov_buf_len);
+		daos_event_fini(&ev->de_ev);
+		d_slab_release(eqt->de_write_slab, ev);
+		D_GOTO(out, rc = EIO);
+	}
+
+	/* The buffer holds the lock taken for the first write into it */
+	if (ev->de_iov.iov_len != 0)
+		D_RWLOCK_UNLOCK(&ie->ie_wlock);
+	ev->de_iov.iov_len += len;
+	ev->de_len = ev->de_iov.iov_len;
+
+	if (ev->de_iov.iov_len == ev->de_iov.iov_buf_len)
+		wb_submit(wb);
+	rc = 0;
+out:
+	D_MUTEX_UNLOCK(&wb->wb_lock);
+	return rc;
+}
+
+void
+dfuse_wb_flush(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_wb *wb = ie->ie_wb;
+
+	if (!ie->ie_dfs->dfc_wb_cache || !S_ISREG(ie->ie_stat.st_mode))
+		return;
+
+	if (wb != NULL) {
+		D_MUTEX_LOCK(&wb->wb_lock);
+		if (wb->wb_ev != NULL)
+			wb_submit(wb);
+		D_MUTEX_UNLOCK(&wb->wb_lock);
+	}
+
+	D_RWLOCK_WRLOCK(&ie->ie_wlock);
+	D_RWLOCK_UNLOCK(&ie->ie_wlock);
+}
+
+int
+dfuse_wb_sync(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_wb *wb;
+	int              rc = 0;
+
+	dfuse_wb_flush(ie);
+
+	wb = ie->ie_wb;
+	if (wb != NULL) {
+		D_MUTEX_LOCK(&wb->wb_lock);
+		rc           = wb->wb_error;
+		wb->wb_error = 0;
+		D_MUTEX_UNLOCK(&wb->wb_lock);
+	}
+	return rc;
+}
+
+void
+dfuse_wb_fini(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_wb *wb = ie->ie_wb;
+
+	if (wb == NULL)
+		return;
+
+	/* Buffers are written back on release so this only happens on forced unmount */
+	if (wb->wb_ev != NULL) {
+		DFUSE_TRA_WARNING(ie, "Dropping %#zx bytes of unwritten data",
+				  wb->wb_ev->de_iov.iov_len);
+		D_MUTEX_LOCK(&wb_list_lock);
+		d_list_del_init(&wb->wb_entry);
+		D_MUTEX_UNLOCK(&wb_list_lock);
+		atomic_fetch_sub_relaxed(&wb_dirty, wb->wb_ev->de_iov.iov_buf_len);
+		daos_event_fini(&wb->wb_ev->de_ev);
+		d_slab_release(wb->wb_ev->de_eqt->de_write_slab, wb->wb_ev);
+	}
+	D_MUTEX_DESTROY(&wb->wb_lock);
+	D_FREE(ie->ie_wb);
+}
+
+/* Write back buffers older than the timeout, or all of them */
+static void
+wb_flush_expired(bool all)
+{
+	struct dfuse_wb *wb;
+	struct timespec  now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+again:
+	D_MUTEX_LOCK(&wb_list_lock);
+	d_list_for_each_entry(wb, &wb_dirty_list, wb_entry) {
+		/* The list is in order of the first write so stop at the first recent buffer */
+		if (!all && now.tv_sec - wb->wb_time.tv_sec < DFUSE_WB_TIMEOUT)
+			break;
+
+		if (pthread_mutex_trylock(&wb->wb_lock) != 0)
+			continue;
+
+		d_list_del_init(&wb->wb_entry);
+		D_MUTEX_UNLOCK(&wb_list_lock);
+		if (wb->wb_ev != NULL)
+			wb_submit(wb);
+		D_MUTEX_UNLOCK(&wb->wb_lock);
+		goto again;
+	}
+	D_MUTEX_UNLOCK(&wb_list_lock);
+}
+
+static void *
+wb_thread_fn(void *arg)
+{
+	while (1) {
+		struct timespec ts = {};
+		int             rc;
+
+		if (clock_gettime(CLOCK_REALTIME, &ts) == -1)
+			D_ERROR("Unable to set time");
+		ts.tv_sec += DFUSE_WB_TIMEOUT;
+
+		rc = sem_timedwait(&wb_sem, &ts);
+		if (rc != 0) {
+			rc = errno;
+
+			if (rc != ETIMEDOUT)
+				DS_ERROR(rc, "sem_wait");
+		}
+
+		wb_flush_expired(wb_stop || atomic_exchange(&wb_pressure, false));
+		if (wb_stop)
+			break;
+	}
+	return NULL;
+}
+
+int
+dfuse_wb_thread_start(struct dfuse_info *dfuse_info)
+{
+	int rc;
+
+	wb_fault_attr = d_fault_attr_lookup(102);
+
+	rc = sem_init(&wb_sem, 0, 0);
+	if (rc != 0)
+		return errno;
+
+	rc = pthread_create(&wb_thread, NULL, wb_thread_fn, NULL);
+	if (rc != 0) {
+		sem_destroy(&wb_sem);
+		return rc;
+	}
+	pthread_setname_np(wb_thread, "dfuse wb");
+
+	return 0;
+}
+
+/* Write back all buffers and stop the thread.  May be called without thread_start() having been
+ * called.
+ */
+void
+dfuse_wb_thread_stop()
+{
+	if (!wb_thread)
+		return;
+
+	wb_stop = true;
+	sem_post(&wb_sem);
+
+	pthread_join(wb_thread, NULL);
+	wb_thread = 0;
+	sem_destroy(&wb_sem);
+}
@@ -121,6 +121,12 @@ ds3_bucket_create(const char *name, struct ds3_bucket_info *info, dfs_attr_t *at
 		goto err;
 	}
 
+	rc = ds3_key_index_create(ds3b);
+	if (rc != 0) {
+		D_ERROR("Failed to create key index, rc = %d\n", rc);
+		goto err;
+	}
+
 	/* Create multipart index */
 	rc = dfs_mkdir(ds3->meta_dfs, ds3->meta_dirs[MULTIPART_DIR], name, DEFFILEMODE, 0);
 	if (rc != 0 && rc != EEXIST)
@@ -179,6 +185,11 @@ ds3_bucket_destroy(const char *name, bool force, ds3_t *ds3, daos_event_t *ev)
 	if (rc != 0)
 		goto err_dirents;
 
+	/* Remove the parts of the bucket's composed objects */
+	rc = dfs_remove(ds3->meta_dfs, ds3->meta_dirs[COMPOSED_DIR], name, true, NULL);
+	if (rc != 0 && rc != ENOENT)
+		goto err_dirents;
+
 	/* Finally, destroy the bucket */
 	rc = daos_cont_destroy(ds3->poh, name, true, NULL);
 	rc = daos_der2errno(rc);
@@ -215,13 +226,31 @@ ds3_bucket_open(const char *name, ds3_bucket_t **ds3b, ds3_t *ds3, daos_event_t
 	if (ds3b_tmp == NULL)
 		return -ENOMEM;
 
+	ds3b_tmp->ds3       = ds3;
+	ds3b_tmp->coh       = DAOS_HDL_INVAL;
+	ds3b_tmp->key_index = DAOS_HDL_INVAL;
+
 	rc = dfs_connect(ds3->pool, NULL, name, O_RDWR, NULL, &ds3b_tmp->dfs);
 	if (rc != 0)
 		goto err_ds3b;
 
+	rc = dfs_cont_get(ds3b_tmp->dfs, &ds3b_tmp->coh);
+	if (rc != 0)
+		goto err_dfs;
+
+	rc = ds3_key_index_open(ds3b_tmp);
+	if (rc != 0) {
+		D_ERROR("Failed to open key index, rc = %d\n", rc);
+		goto err_coh;
+	}
+
 	*ds3b = ds3b_tmp;
 	return 0;
 
+err_coh:
+	dfs_cont_put(ds3b_tmp->dfs, ds3b_tmp->coh);
+err_dfs:
+	dfs_disconnect(ds3b_tmp->dfs);
 err_ds3b:
 	D_FREE(ds3b_tmp);
 	return -rc;
@@ -232,6 +261,9 @@ ds3_bucket_close(ds3_bucket_t *ds3b, daos_event_t *ev)
 {
 	int rc = 0;
 
+	ds3_key_index_close(ds3b);
+	if (daos_handle_is_valid(ds3b->coh))
+		dfs_cont_put(ds3b->dfs, ds3b->coh);
 	rc = dfs_disconnect(ds3b->dfs);
 	D_FREE(ds3b);
 	return -rc;
@@ -316,6 +348,11 @@ ds3_bucket_list_obj(uint32_t *nobj, struct ds3_object_info *objs, uint32_t *ncp,
 	if (*nobj == 0)
 		return 0;
 
+	/* Range enumeration of the ordered key index, any delimiter */
+	if (daos_handle_is_valid(ds3b->key_index))
+		return -ds3_key_index_list(nobj, objs, ncp, cps, prefix, delim, marker,
+					   is_truncated, ds3b);
+
 	/* TODO: support the case when delim is not / */
 	if (strcmp(delim, "/") != 0)
 		return -EINVAL;
@@ -374,6 +411,10 @@ ds3_bucket_list_obj(uint32_t *nobj, struct ds3_object_info *objs, uint32_t *ncp,
 	for (i = 0; i < *nobj; i++) {
 		name = dirents[i].d_name;
 
+		/* Objects being composed are not in place yet */
+		if (strncmp(name, COMPOSE_TMP_PREFIX, sizeof(COMPOSE_TMP_PREFIX) - 1) == 0)
+			continue;
+
 		/**
 		 * Skip entries that do not start with prefix_rest
 		 * TODO handle how this affects max
@@ -0,0 +1,412 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/**
+ * Objects composed of the parts of a multipart upload.
+ *
+ * Completing an upload does not copy the parts into the object.  The upload directory holding
+ * the parts is moved from the multipart index to the composed directory of the metadata
+ * container, with a manifest listing the parts of the object in order, and the object is an empty
+ * file of the bucket whose DS3_COMPOSE_XATTR names that directory.  Reads of the object are
+ * served from the parts, and the directory is removed with the object or when it is overwritten.
+ *
+ * Only libds3 knows about the parts: through DFS or dfuse, a composed object is an empty file.
+ */
+
+#include "ds3_internal.h"
+
+/** Open the composed upload directory named by \a name, "bucket/upload_id" */
+static int
+compose_dir_open(ds3_t *ds3, const char *name, dfs_obj_t **dir)
+{
+	char *path;
+	int   rc;
+
+	D_ASPRINTF(path, "/%s/%s", meta_dir_name(COMPOSED_DIR), name);
+	if (path == NULL)
+		return ENOMEM;
+
+	rc = dfs_lookup(ds3->meta_dfs, path, O_RDWR, dir, NULL, NULL);
+	D_FREE(path);
+	return rc;
+}
+
+int
+ds3_compose_write_manifest(ds3_t *ds3, dfs_obj_t *upload_dir, uint32_t nr,
+			   struct ds3_compose_ent *ents)
+{
+	dfs_obj_t  *manifest;
+	d_sg_list_t sgl;
+	d_iov_t     iov;
+	int         rc, rc2;
+
+	rc = dfs_open(ds3->meta_dfs, upload_dir, COMPOSE_MANIFEST, DEFFILEMODE | S_IFREG,
+		      O_RDWR | O_CREAT | O_TRUNC, 0, 0, NULL, &manifest);
+	if (rc != 0)
+		return rc;
+
+	d_iov_set(&iov, ents, nr * sizeof(*ents));
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs   = &iov;
+	rc  = dfs_write(ds3->meta_dfs, manifest, &sgl, 0, NULL);
+	rc2 = dfs_release(manifest);
+	return rc == 0 ? rc2 : rc;
+}
+
+int
+ds3_compose_load(ds3_bucket_t *ds3b, ds3_obj_t *ds3o)
+{
+	struct ds3_compose *dc;
+	char                name[COMPOSE_NAME_BUFF];
+	daos_size_t         size;
+	dfs_obj_t          *manifest;
+	d_sg_list_t         sgl;
+	d_iov_t             iov;
+	uint32_t            i;
+	int                 rc;
+
+	rc = ds3_compose_name(ds3b, ds3o->dfs_obj, name);
+	if (rc != 0 || name[0] == '\0')
+		return rc;
+
+	D_ALLOC_PTR(dc);
+	if (dc == NULL)
+		return ENOMEM;
+
+	rc = compose_dir_open(ds3b->ds3, name, &dc->dc_dir);
+	if (rc != 0) {
+		D_ERROR("Failed to open composed upload %s, rc = %d\n", name, rc);
+		D_FREE(dc);
+		return rc;
+	}
+
+	rc = dfs_lookup_rel(ds3b->ds3->meta_dfs, dc->dc_dir, COMPOSE_MANIFEST, O_RDONLY, &manifest,
+			    NULL, NULL);
+	if (rc != 0)
+		goto err;
+
+	rc = dfs_get_size(ds3b->ds3->meta_dfs, manifest, &size);
+	if (rc != 0)
+		goto err_manifest;
+	if (size == 0 || size % sizeof(struct ds3_compose_ent) != 0 ||
+	    size > MULTIPART_MAX_PARTS * sizeof(struct ds3_compose_ent))
+		D_GOTO(err_manifest, rc = EIO);
+
+	dc->dc_nr = size / sizeof(struct ds3_compose_ent);
+	D_ALLOC_ARRAY(dc->dc_ents, dc->dc_nr);
+	D_ALLOC_ARRAY(dc->dc_offs, dc->dc_nr + 1);
+	D_ALLOC_ARRAY(dc->dc_parts, dc->dc_nr);
+	if (dc->dc_ents == NULL || dc->dc_offs == NULL || dc->dc_parts == NULL)
+		D_GOTO(err_manifest, rc = ENOMEM);
+
+	d_iov_set(&iov, dc->dc_ents, size);
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs   = &iov;
+	rc = dfs_read(ds3b->ds3->meta_dfs, manifest, &sgl, 0, &size, NULL);
+	if (rc != 0)
+		goto err_manifest;
+	if (size != dc->dc_nr * sizeof(struct ds3_compose_ent))
+		D_GOTO(err_manifest, rc = EIO);
+
+	for (i = 0; i < dc->dc_nr; i++)
+		dc->dc_offs[i + 1] = dc->dc_offs[i] + dc->dc_ents[i].ce_size;
+
+	rc = D_MUTEX_INIT(&dc->dc_lock, NULL);
+	if (rc != 0)
+		D_GOTO(err_manifest, rc = daos_der2errno(rc));
+
+	rc = dfs_release(manifest);
+	if (rc != 0) {
+		ds3_compose_free(dc);
+		return rc;
+	}
+	ds3o->compose = dc;
+	return 0;
+
+err_manifest:
+	dfs_release(manifest);
+err:
+	dfs_release(dc->dc_dir);
+	D_FREE(dc->dc_ents);
+	D_FREE(dc->dc_offs);
+	D_FREE(dc->dc_parts);
+	D_FREE(dc);
+	return rc;
+}
+
+void
+ds3_compose_free(struct ds3_compose *dc)
+{
+	uint32_t i;
+
+	if (dc == NULL)
+		return;
+
+	for (i = 0; i < dc->dc_nr; i++)
+		if (dc->dc_parts[i] != NULL)
+			dfs_release(dc->dc_parts[i]);
+	dfs_release(dc->dc_dir);
+	D_MUTEX_DESTROY(&dc->dc_lock);
+	D_FREE(dc->dc_ents);
+	D_FREE(dc->dc_offs);
+	D_FREE(dc->dc_parts);
+	D_FREE(dc);
+}
+
+/** Return the handle of part \a i, opened on first use */
+static int
+compose_part_get(ds3_t *ds3, struct ds3_compose *dc, uint32_t i, dfs_obj_t **part)
+{
+	char part_name_str[7];
+	int  rc = 0;
+
+	D_MUTEX_LOCK(&dc->dc_lock);
+	if (dc->dc_parts[i] == NULL) {
+		sprintf(part_name_str, "%06lu", dc->dc_ents[i].ce_part_num);
+		rc = dfs_lookup_rel(ds3->meta_dfs, dc->dc_dir, part_name_str, O_RDONLY,
+				    &dc->dc_parts[i], NULL, NULL);
+	}
+	*part = dc->dc_parts[i];
+	D_MUTEX_UNLOCK(&dc->dc_lock);
+	return rc;
+}
+
+/** Array read of the part of a composed object covered by a read */
+struct compose_part_read {
+	daos_handle_t    cr_oh;
+	daos_array_iod_t cr_iod;
+	daos_range_t     cr_rg;
+	d_sg_list_t      cr_sgl;
+	d_iov_t          cr_iov;
+};
+
+/** Arguments of the task reading a composed object */
+struct compose_read_args {
+	/** Size of the read, set to the size read on completion */
+	daos_size_t              *size;
+	/** Number of parts covered by the read */
+	uint32_t                  nr;
+	/** Reads of the parts, in object order */
+	struct compose_part_read *reads;
+};
+
+static int
+compose_read_cb(tse_task_t *task, void *data)
+{
+	struct compose_read_args *args = dc_task_get_args(task);
+	daos_size_t               done = 0;
+	uint32_t                  i;
+
+	if (task->dt_result == 0) {
+		for (i = 0; i < args->nr; i++) {
+			done += args->reads[i].cr_iod.arr_nr_read;
+			/* Short part, the object ends here */
+			if (args->reads[i].cr_iod.arr_nr_read < args->reads[i].cr_rg.rg_len)
+				break;
+		}
+		*args->size = done;
+	}
+
+	D_FREE(args->reads);
+	return 0;
+}
+
+/** Read the parts concurrently, the task completes once all of them are read */
+static int
+compose_read_task(tse_task_t *task)
+{
+	struct compose_read_args *args  = dc_task_get_args(task);
+	tse_sched_t              *sched = tse_task2sched(task);
+	tse_task_t              **tasks;
+	daos_array_io_t          *io;
+	uint32_t                  i, j;
+	int                       rc;
+
+	if (args->nr == 0) {
+		tse_task_complete(task, 0);
+		return 0;
+	}
+
+	D_ALLOC_ARRAY(tasks, args->nr);
+	if (tasks == NULL) {
+		tse_task_complete(task, -DER_NOMEM);
+		return -DER_NOMEM;
+	}
+
+	for (i = 0; i < args->nr; i++) {
+		rc = daos_task_create(DAOS_OPC_ARRAY_READ, sched, 0, NULL, &tasks[i]);
+		if (rc != 0)
+			goto err_tasks;
+
+		io      = daos_task_get_args(tasks[i]);
+		io->oh  = args->reads[i].cr_oh;
+		io->th  = DAOS_TX_NONE;
+		io->iod = &args->reads[i].cr_iod;
+		io->sgl = &args->reads[i].cr_sgl;
+	}
+
+	rc = tse_task_register_deps(task, args->nr, tasks);
+	if (rc != 0)
+		goto err_tasks;
+
+	for (i = 0; i < args->nr; i++)
+		tse_task_schedule(tasks[i], true);
+	D_FREE(tasks);
+	return 0;
+
+err_tasks:
+	D_ERROR("Failed to read the parts: " DF_RC "\n", DP_RC(rc));
+	for (j = 0; j < i; j++)
+		tse_task_complete(tasks[j], rc);
+	D_FREE(tasks);
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+int
+ds3_compose_read(void *buf, daos_off_t off, daos_size_t *size, ds3_bucket_t *ds3b, ds3_obj_t *ds3o,
+		 daos_event_t *ev)
+{
+	struct ds3_compose       *dc = ds3o->compose;
+	struct compose_read_args *args;
+	struct compose_part_read *reads;
+	struct compose_part_read *pr;
+	tse_task_t               *task;
+	dfs_obj_t                *part;
+	daos_off_t                end;
+	daos_off_t                start;
+	uint32_t                  lo = 0;
+	uint32_t                  hi = dc->dc_nr;
+	uint32_t                  nr = 0;
+	uint32_t                  i;
+	int                       rc;
+
+	/* Nothing is read past the end of the object */
+	end = max(off, min(off + *size, dc->dc_offs[dc->dc_nr]));
+
+	/* Last part starting at or before off */
+	while (hi - lo > 1) {
+		i = lo + (hi - lo) / 2;
+		if (dc->dc_offs[i] <= off)
+			lo = i;
+		else
+			hi = i;
+	}
+
+	D_ALLOC_ARRAY(reads, dc->dc_nr - lo);
+	if (reads == NULL)
+		return ENOMEM;
+
+	for (i = lo; off < end && i < dc->dc_nr && dc->dc_offs[i] < end; i++) {
+		if (dc->dc_ents[i].ce_size == 0)
+			continue;
+
+		rc = compose_part_get(ds3b->ds3, dc, i, &part);
+		if (rc != 0)
+			goto err_reads;
+
+		pr = &reads[nr++];
+		rc = dfs_get_file_oh(part, &pr->cr_oh);
+		if (rc != 0)
+			goto err_reads;
+
+		start                = max(off, dc->dc_offs[i]);
+		pr->cr_rg.rg_idx     = start - dc->dc_offs[i];
+		pr->cr_rg.rg_len     = min(end, dc->dc_offs[i + 1]) - start;
+		pr->cr_iod.arr_nr    = 1;
+		pr->cr_iod.arr_rgs   = &pr->cr_rg;
+		pr->cr_sgl.sg_nr     = 1;
+		pr->cr_sgl.sg_nr_out = 1;
+		pr->cr_sgl.sg_iovs   = &pr->cr_iov;
+		d_iov_set(&pr->cr_iov, (char *)buf + (start - off), pr->cr_rg.rg_len);
+	}
+
+	/* Without an event, the task runs on the private event of the thread and is waited for */
+	rc = dc_task_create(compose_read_task, NULL, ev, &task);
+	if (rc != 0)
+		D_GOTO(err_reads, rc = daos_der2errno(rc));
+	if (ev != NULL)
+		daos_event_errno_rc(ev);
+
+	args        = dc_task_get_args(task);
+	args->size  = size;
+	args->nr    = nr;
+	args->reads = reads;
+
+	rc = tse_task_register_comp_cb(task, compose_read_cb, NULL, 0);
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		D_GOTO(err_reads, rc = daos_der2errno(rc));
+	}
+
+	return daos_der2errno(dc_task_schedule(task, true));
+
+err_reads:
+	D_FREE(reads);
+	return rc;
+}
+
+/** Get the composed upload name of \a obj, an empty string if it is not a composed object */
+int
+ds3_compose_name(ds3_bucket_t *ds3b, dfs_obj_t *obj, char *name)
+{
+	daos_size_t size = COMPOSE_NAME_BUFF - 1;
+	int         rc;
+
+	rc = dfs_getxattr(ds3b->dfs, obj, DS3_COMPOSE_XATTR, name, &size);
+	if (rc == ENODATA)
+		size = 0;
+	else if (rc != 0)
+		return rc;
+	name[size] = '\0';
+	return 0;
+}
+
+/** Remove the composed upload directory named by \a name, "bucket/upload_id" */
+int
+ds3_compose_remove(ds3_t *ds3, const char *name)
+{
+	char       bucket[COMPOSE_NAME_BUFF];
+	dfs_obj_t *bucket_dir;
+	char      *upload_id;
+	int        rc, rc2;
+
+	strncpy(bucket, name, sizeof(bucket) - 1);
+	bucket[sizeof(bucket) - 1] = '\0';
+	upload_id = strchr(bucket, '/');
+	if (upload_id == NULL)
+		return EIO;
+	*upload_id++ = '\0';
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, ds3->meta_dirs[COMPOSED_DIR], bucket, O_RDWR,
+			    &bucket_dir, NULL, NULL);
+	if (rc == 0) {
+		rc  = dfs_remove(ds3->meta_dfs, bucket_dir, upload_id, true, NULL);
+		rc2 = dfs_release(bucket_dir);
+		rc  = rc == 0 ? rc2 : rc;
+	}
+	return rc == ENOENT ? 0 : rc;
+}
+
+/** Drop the parts of \a obj, once it no longer refers to them */
+int
+ds3_compose_drop(ds3_bucket_t *ds3b, dfs_obj_t *obj)
+{
+	char name[COMPOSE_NAME_BUFF];
+	int  rc;
+
+	rc = ds3_compose_name(ds3b, obj, name);
+	if (rc != 0 || name[0] == '\0')
+		return rc;
+
+	rc = dfs_removexattr(ds3b->dfs, obj, DS3_COMPOSE_XATTR);
+	if (rc != 0 && rc != ENODATA)
+		return rc;
+
+	return ds3_compose_remove(ds3b->ds3, name);
+}
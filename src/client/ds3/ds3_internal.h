@@ -10,6 +10,7 @@
 #define __DAOS_S3_INTERNAL_H__
 
 #include <fcntl.h>
+#include <pthread.h>
 #include <daos.h>
 #include <daos_fs.h>
 #include <daos_s3.h>
@@ -22,12 +23,18 @@
 #define RGW_DIR_ENTRY_XATTR    "rgw_entry"
 #define RGW_KEY_XATTR          "rgw_key"
 #define RGW_PART_XATTR         "rgw_part"
+#define DS3_KEY_INDEX          "ds3_key_index"
+#define DS3_COMPOSE_XATTR      "ds3_compose"
+#define COMPOSE_MANIFEST       "manifest"
+#define COMPOSE_TMP_PREFIX     ".ds3_compose."
+#define COMPOSE_NAME_BUFF      (DS3_MAX_BUCKET_NAME + DS3_MAX_UPLOAD_ID + 1)
 
 #define METADATA_DIR_LIST                                                                          \
 	X(USERS_DIR, "users")                                                                      \
 	X(EMAILS_DIR, "emails")                                                                    \
 	X(ACCESS_KEYS_DIR, "access_keys")                                                          \
-	X(MULTIPART_DIR, "multipart")
+	X(MULTIPART_DIR, "multipart")                                                              \
+	X(COMPOSED_DIR, "composed")
 
 /* Define for RPC enum population below */
 #define X(a, b) a,
@@ -51,13 +58,47 @@ struct ds3 {
 /** DAOS S3 Bucket handle */
 struct ds3_bucket {
 	/** DFS handle */
-	dfs_t *dfs;
+	dfs_t          *dfs;
+	/** Pool handle the bucket was opened from */
+	ds3_t          *ds3;
+	/** Container handle of the DFS */
+	daos_handle_t   coh;
+	/** Ordered key index, invalid if the bucket was created without it */
+	daos_handle_t   key_index;
+};
+
+/** Part of a composed object, as stored in its manifest */
+struct ds3_compose_ent {
+	/** Part number */
+	uint64_t ce_part_num;
+	/** Size of the part */
+	uint64_t ce_size;
+};
+
+/** Parts of an object composed by a multipart upload completion */
+struct ds3_compose {
+	/** Composed upload directory in the metadata container */
+	dfs_obj_t              *dc_dir;
+	/** Number of parts */
+	uint32_t                dc_nr;
+	/** Parts in object order */
+	struct ds3_compose_ent *dc_ents;
+	/** Offset of each part in the object, followed by the object size */
+	daos_off_t             *dc_offs;
+	/** Part handles, opened on first read */
+	dfs_obj_t             **dc_parts;
+	/** Protects dc_parts */
+	pthread_mutex_t         dc_lock;
 };
 
 /** DAOS S3 Object handle */
 struct ds3_obj {
 	/** DFS object handle */
-	dfs_obj_t *dfs_obj;
+	dfs_obj_t          *dfs_obj;
+	/** Key of the object in the key index, NULL if it is not indexed */
+	char               *key;
+	/** Parts the object data is read from, NULL if it has its own data */
+	struct ds3_compose *compose;
 };
 
 /** DAOS S3 Upload Part handle */
@@ -70,4 +111,46 @@ struct ds3_part {
 const char *
 meta_dir_name(enum meta_dir dir);
 
+/** Key index functions, return 0 on success, errno code on failure */
+int
+ds3_key_index_create(ds3_bucket_t *ds3b);
+int
+ds3_key_index_open(ds3_bucket_t *ds3b);
+void
+ds3_key_index_close(ds3_bucket_t *ds3b);
+int
+ds3_key_index_put(ds3_bucket_t *ds3b, const char *key, const void *info, size_t info_len);
+int
+ds3_key_index_remove(ds3_bucket_t *ds3b, const char *key);
+int
+ds3_key_index_list(uint32_t *nobj, struct ds3_object_info *objs, uint32_t *ncp,
+		   struct ds3_common_prefix_info *cps, const char *prefix, const char *delim,
+		   char *marker, bool *is_truncated, ds3_bucket_t *ds3b);
+
+/** Composed object functions, return 0 on success, errno code on failure */
+int
+ds3_compose_write_manifest(ds3_t *ds3, dfs_obj_t *upload_dir, uint32_t nr,
+			   struct ds3_compose_ent *ents);
+int
+ds3_compose_load(ds3_bucket_t *ds3b, ds3_obj_t *ds3o);
+void
+ds3_compose_free(struct ds3_compose *dc);
+int
+ds3_compose_read(void *buf, daos_off_t off, daos_size_t *size, ds3_bucket_t *ds3b, ds3_obj_t *ds3o,
+		 daos_event_t *ev);
+int
+ds3_compose_name(ds3_bucket_t *ds3b, dfs_obj_t *obj, char *name);
+int
+ds3_compose_remove(ds3_t *ds3, const char *name);
+int
+ds3_compose_drop(ds3_bucket_t *ds3b, dfs_obj_t *obj);
+
+/**
+ * Create the object \a key composed of the upload parts named by \a name, "bucket/upload_id".
+ * The object is built under a temporary name and renamed over \a key, a previous object is only
+ * replaced once the new one is complete.  Return 0 on success, errno code on failure.
+ */
+int
+ds3_obj_compose(const char *key, const char *name, ds3_bucket_t *ds3b);
+
 #endif
@@ -0,0 +1,298 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/**
+ * Ordered index of the object keys of a bucket.
+ *
+ * A DAOS KV with lexical dkeys and a single redundancy group, so that its enumeration returns the
+ * keys in lexical order, holds one entry per object with its encoded info.  Its object ID is kept
+ * in a container attribute, buckets created before it have none and are listed by walking their
+ * directories.
+ */
+
+#include "ds3_internal.h"
+#include <daos/btree.h>
+
+/** Value of an entry of the key index */
+struct ds3_key_ent {
+	/** Length of the encoded object info following, 0 until it is set */
+	uint32_t ke_info_len;
+	uint32_t ke_pad;
+	char     ke_info[];
+};
+
+/** Number of keys enumerated at once */
+#define KEY_INDEX_LIST_BATCH 64
+
+int
+ds3_key_index_create(ds3_bucket_t *ds3b)
+{
+	char const *const names[] = {DS3_KEY_INDEX};
+	size_t const      size    = sizeof(daos_obj_id_t);
+	daos_obj_id_t     oid     = {0};
+	void const       *value   = &oid;
+	int               rc;
+
+	rc = daos_cont_alloc_oids(ds3b->coh, 1, &oid.lo, NULL);
+	if (rc != 0) {
+		D_ERROR("Failed to allocate key index oid, " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_obj_generate_oid(ds3b->coh, &oid, DAOS_OT_KV_LEXICAL, OC_UNKNOWN,
+				   DAOS_OCH_SHD_TINY, 0);
+	if (rc != 0) {
+		D_ERROR("Failed to generate key index oid, " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_cont_set_attr(ds3b->coh, 1, names, &value, &size, NULL);
+	if (rc != 0) {
+		D_ERROR("Failed to set key index attribute, " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_kv_open(ds3b->coh, oid, DAOS_OO_RW, &ds3b->key_index, NULL);
+	return daos_der2errno(rc);
+}
+
+int
+ds3_key_index_open(ds3_bucket_t *ds3b)
+{
+	char const *const names[] = {DS3_KEY_INDEX};
+	size_t            size    = sizeof(daos_obj_id_t);
+	daos_obj_id_t     oid;
+	void             *value = &oid;
+	int               rc;
+
+	rc = daos_cont_get_attr(ds3b->coh, 1, names, &value, &size, NULL);
+	if (rc == -DER_NONEXIST)
+		return 0;
+	if (rc != 0)
+		return daos_der2errno(rc);
+	if (size != sizeof(daos_obj_id_t))
+		return EIO;
+
+	rc = daos_kv_open(ds3b->coh, oid, DAOS_OO_RW, &ds3b->key_index, NULL);
+	return daos_der2errno(rc);
+}
+
+void
+ds3_key_index_close(ds3_bucket_t *ds3b)
+{
+	int rc;
+
+	if (daos_handle_is_inval(ds3b->key_index))
+		return;
+
+	rc = daos_kv_close(ds3b->key_index, NULL);
+	if (rc != 0)
+		D_ERROR("Failed to close key index, " DF_RC "\n", DP_RC(rc));
+	ds3b->key_index = DAOS_HDL_INVAL;
+}
+
+int
+ds3_key_index_put(ds3_bucket_t *ds3b, const char *key, const void *info, size_t info_len)
+{
+	struct ds3_key_ent *ent;
+	int                 rc;
+
+	if (daos_handle_is_inval(ds3b->key_index))
+		return 0;
+
+	D_ALLOC(ent, sizeof(*ent) + info_len);
+	if (ent == NULL)
+		return ENOMEM;
+
+	ent->ke_info_len = info_len;
+	if (info_len != 0)
+		memcpy(ent->ke_info, info, info_len);
+
+	rc = daos_kv_put(ds3b->key_index, DAOS_TX_NONE, 0, key, sizeof(*ent) + info_len, ent,
+			 NULL);
+	D_FREE(ent);
+	return daos_der2errno(rc);
+}
+
+int
+ds3_key_index_remove(ds3_bucket_t *ds3b, const char *key)
+{
+	int rc;
+
+	if (daos_handle_is_inval(ds3b->key_index))
+		return 0;
+
+	rc = daos_kv_remove(ds3b->key_index, DAOS_TX_NONE, 0, key, NULL);
+	return daos_der2errno(rc);
+}
+
+/** Fetch the encoded info of an object, from the index or from its xattr if not set yet */
+static int
+key_index_get_info(ds3_bucket_t *ds3b, const char *key, struct ds3_key_ent *ent,
+		   struct ds3_object_info *obj)
+{
+	daos_size_t size = sizeof(*ent) + DS3_MAX_ENCODED_LEN;
+	dfs_obj_t  *dfs_obj;
+	char       *path;
+	int         rc, rc2;
+
+	rc = daos_kv_get(ds3b->key_index, DAOS_TX_NONE, 0, key, &size, ent, NULL);
+	if (rc != 0)
+		return daos_der2errno(rc);
+	if (size < sizeof(*ent))
+		return ENOENT;
+
+	if (ent->ke_info_len != 0) {
+		if (ent->ke_info_len > obj->encoded_length)
+			return ERANGE;
+		memcpy(obj->encoded, ent->ke_info, ent->ke_info_len);
+		obj->encoded_length = ent->ke_info_len;
+		return 0;
+	}
+
+	D_ASPRINTF(path, "%s%s", key[0] == '/' ? "" : "/", key);
+	if (path == NULL)
+		return ENOMEM;
+
+	rc = dfs_lookup(ds3b->dfs, path, O_RDONLY, &dfs_obj, NULL, NULL);
+	D_FREE(path);
+	if (rc != 0)
+		return rc;
+
+	rc  = dfs_getxattr(ds3b->dfs, dfs_obj, RGW_DIR_ENTRY_XATTR, obj->encoded,
+			   &obj->encoded_length);
+	rc2 = dfs_release(dfs_obj);
+	return rc == 0 ? rc2 : rc;
+}
+
+/**
+ * Set the anchor of the key index enumeration to start at \a key.  The dkeys of the lexical KV are
+ * direct keys of the VOS trees, for which the anchor embeds the key the iterator probes from.  Only
+ * its first EMBEDDED_KEY_MAX bytes fit, which is enough as they sort before the whole key.
+ */
+static void
+key_index_anchor_set(daos_anchor_t *anchor, const char *key)
+{
+	d_iov_t iov;
+
+	daos_anchor_init(anchor, 0);
+	if (key == NULL || key[0] == '\0')
+		return;
+
+	d_iov_set(&iov, (void *)key, min(strlen(key), EMBEDDED_KEY_MAX));
+	embedded_key_encode(&iov, anchor);
+	anchor->da_type = DAOS_ANCHOR_TYPE_KEY;
+}
+
+int
+ds3_key_index_list(uint32_t *nobj, struct ds3_object_info *objs, uint32_t *ncp,
+		   struct ds3_common_prefix_info *cps, const char *prefix, const char *delim,
+		   char *marker, bool *is_truncated, ds3_bucket_t *ds3b)
+{
+	daos_key_desc_t     kds[KEY_INDEX_LIST_BATCH];
+	d_sg_list_t         sgl;
+	d_iov_t             iov;
+	daos_anchor_t       anchor;
+	struct ds3_key_ent *ent      = NULL;
+	char               *buf      = NULL;
+	char               *key      = NULL;
+	char               *last     = NULL;
+	size_t              prefix_len = prefix == NULL ? 0 : strlen(prefix);
+	size_t              delim_len  = delim == NULL ? 0 : strlen(delim);
+	bool                truncated  = false;
+	bool                done       = false;
+	uint32_t            obji       = 0;
+	uint32_t            cpi        = 0;
+	uint32_t            nr;
+	uint32_t            i;
+	char               *ptr;
+	char               *sep;
+	int                 rc = 0;
+
+	D_ALLOC(buf, KEY_INDEX_LIST_BATCH * DS3_MAX_KEY_BUFF);
+	D_ALLOC(key, DS3_MAX_KEY_BUFF);
+	D_ALLOC(last, DS3_MAX_KEY_BUFF);
+	D_ALLOC(ent, sizeof(*ent) + DS3_MAX_ENCODED_LEN);
+	if (buf == NULL || key == NULL || last == NULL || ent == NULL)
+		D_GOTO(out, rc = ENOMEM);
+
+	/* Seek to the first key which may be listed, the keys up to the marker are skipped below */
+	if (marker != NULL && (prefix == NULL || strcmp(marker, prefix) > 0))
+		key_index_anchor_set(&anchor, marker);
+	else
+		key_index_anchor_set(&anchor, prefix);
+
+	last[0] = '\0';
+	d_iov_set(&iov, buf, KEY_INDEX_LIST_BATCH * DS3_MAX_KEY_BUFF);
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs   = &iov;
+
+	while (!done && !truncated && !daos_anchor_is_eof(&anchor)) {
+		nr = KEY_INDEX_LIST_BATCH;
+		rc = daos_kv_list(ds3b->key_index, DAOS_TX_NONE, &nr, kds, &sgl, &anchor, NULL);
+		if (rc != 0)
+			D_GOTO(out, rc = daos_der2errno(rc));
+
+		for (i = 0, ptr = buf; i < nr && !done; ptr += kds[i].kd_key_len, i++) {
+			memcpy(key, ptr, kds[i].kd_key_len);
+			key[kds[i].kd_key_len] = '\0';
+
+			if (marker != NULL && strcmp(key, marker) <= 0)
+				continue;
+
+			if (prefix_len != 0 && strncmp(key, prefix, prefix_len) != 0) {
+				/* The keys are sorted, none of the next ones has the prefix */
+				if (strncmp(key, prefix, prefix_len) > 0)
+					done = true;
+				continue;
+			}
+
+			sep = delim_len == 0 ? NULL : strstr(key + prefix_len, delim);
+			if (sep != NULL) {
+				/* Common prefix, listed once as it is shared by consecutive keys */
+				sep[delim_len] = '\0';
+				if ((marker != NULL && strcmp(key, marker) <= 0) ||
+				    (cpi != 0 && strcmp(key, cps[cpi - 1].prefix) == 0))
+					continue;
+				if (cpi == *ncp) {
+					truncated = true;
+					break;
+				}
+				strcpy(cps[cpi++].prefix, key);
+			} else {
+				if (obji == *nobj) {
+					truncated = true;
+					break;
+				}
+				rc = key_index_get_info(ds3b, key, ent, &objs[obji]);
+				if (rc == ENOENT) {
+					/* Removed since the enumeration */
+					rc = 0;
+					continue;
+				}
+				if (rc != 0)
+					D_GOTO(out, rc);
+				strcpy(objs[obji++].key, key);
+			}
+			strcpy(last, key);
+		}
+	}
+
+	*nobj = obji;
+	*ncp  = cpi;
+	if (is_truncated != NULL)
+		*is_truncated = truncated;
+	if (marker != NULL && truncated)
+		strcpy(marker, last);
+
+out:
+	D_FREE(buf);
+	D_FREE(key);
+	D_FREE(last);
+	D_FREE(ent);
+	return rc;
+}
@@ -518,3 +518,170 @@ ds3_part_set_info(struct ds3_multipart_part_info *info, ds3_part_t *ds3p, ds3_t
 	return -dfs_setxattr(ds3->meta_dfs, ds3p->dfs_obj, RGW_PART_XATTR, info->encoded,
 			     info->encoded_length, 0);
 }
+
+/** Move the composed upload back to the multipart index when the completion failed */
+static void
+upload_complete_undo(const char *upload_id, dfs_obj_t *multipart_dir, dfs_obj_t *composed_dir,
+		     ds3_t *ds3)
+{
+	int rc;
+
+	rc = dfs_remove(ds3->meta_dfs, multipart_dir, upload_id, true, NULL);
+	if (rc == 0 || rc == ENOENT)
+		rc = dfs_move(ds3->meta_dfs, composed_dir, upload_id, multipart_dir, upload_id,
+			      NULL);
+	if (rc != 0)
+		D_ERROR("Failed to restore upload %s, rc = %d\n", upload_id, rc);
+}
+
+int
+ds3_upload_complete(const char *bucket_name, const char *upload_id, uint32_t npart,
+		    const uint64_t *part_nums, const char *key, daos_size_t *size,
+		    ds3_obj_t **ds3o, ds3_bucket_t *ds3b, ds3_t *ds3)
+{
+	int                     rc  = 0;
+	int                     rc2 = 0;
+	struct ds3_compose_ent *ents;
+	char                    part_name_str[7];
+	char                    name[COMPOSE_NAME_BUFF];
+	void                   *encoded = NULL;
+	daos_size_t             encoded_length = DS3_MAX_ENCODED_LEN;
+	char                    upload_key[DS3_MAX_KEY_BUFF];
+	daos_size_t             key_length = DS3_MAX_KEY_BUFF - 1;
+	dfs_obj_t              *multipart_dir = NULL;
+	dfs_obj_t              *upload_dir    = NULL;
+	dfs_obj_t              *composed_dir  = NULL;
+	dfs_obj_t              *part_obj;
+	struct stat             stbuf;
+	daos_size_t             total = 0;
+	uint32_t                i;
+
+	if (bucket_name == NULL || upload_id == NULL || part_nums == NULL || key == NULL ||
+	    ds3o == NULL || ds3b == NULL || ds3 == NULL)
+		return -EINVAL;
+	if (npart == 0 || npart > MULTIPART_MAX_PARTS)
+		return -EINVAL;
+	if (strnlen(upload_id, DS3_MAX_UPLOAD_ID) > DS3_MAX_UPLOAD_ID - 1)
+		return -EINVAL;
+
+	D_ALLOC_ARRAY(ents, npart);
+	if (ents == NULL)
+		return -ENOMEM;
+
+	D_ALLOC(encoded, DS3_MAX_ENCODED_LEN);
+	if (encoded == NULL) {
+		rc = ENOMEM;
+		goto out;
+	}
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, ds3->meta_dirs[MULTIPART_DIR], bucket_name, O_RDWR,
+			    &multipart_dir, NULL, NULL);
+	if (rc != 0)
+		goto out;
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, multipart_dir, upload_id, O_RDWR, &upload_dir, NULL,
+			    NULL);
+	if (rc != 0)
+		goto out;
+
+	/* Only the sizes of the parts are needed, their data stays in place */
+	for (i = 0; i < npart; i++) {
+		sprintf(part_name_str, "%06lu", part_nums[i]);
+		rc = dfs_lookup_rel(ds3->meta_dfs, upload_dir, part_name_str, O_RDONLY, &part_obj,
+				    NULL, &stbuf);
+		if (rc != 0) {
+			D_ERROR("Failed to open part %s of upload %s, rc = %d\n", part_name_str,
+				upload_id, rc);
+			rc = rc == ENOENT ? EINVAL : rc;
+			goto out;
+		}
+		rc = dfs_release(part_obj);
+		if (rc != 0)
+			goto out;
+
+		ents[i].ce_part_num = part_nums[i];
+		ents[i].ce_size     = stbuf.st_size;
+		total += stbuf.st_size;
+	}
+
+	rc = ds3_compose_write_manifest(ds3, upload_dir, npart, ents);
+	if (rc != 0)
+		goto out;
+
+	/* Keep the upload info to recreate its entry */
+	rc = dfs_getxattr(ds3->meta_dfs, upload_dir, RGW_DIR_ENTRY_XATTR, encoded, &encoded_length);
+	if (rc != 0)
+		goto out;
+	rc = dfs_getxattr(ds3->meta_dfs, upload_dir, RGW_KEY_XATTR, upload_key, &key_length);
+	if (rc != 0)
+		goto out;
+	upload_key[key_length] = '\0';
+
+	rc         = dfs_release(upload_dir);
+	upload_dir = NULL;
+	if (rc != 0)
+		goto out;
+
+	/* Move the parts out of the multipart index */
+	rc = dfs_mkdir(ds3->meta_dfs, ds3->meta_dirs[COMPOSED_DIR], bucket_name, DEFFILEMODE, 0);
+	if (rc != 0 && rc != EEXIST)
+		goto out;
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, ds3->meta_dirs[COMPOSED_DIR], bucket_name, O_RDWR,
+			    &composed_dir, NULL, NULL);
+	if (rc != 0)
+		goto out;
+
+	rc = dfs_move(ds3->meta_dfs, multipart_dir, upload_id, composed_dir, upload_id, NULL);
+	if (rc != 0)
+		goto out;
+
+	/* The upload stays listed until it is removed, without its parts */
+	rc = dfs_mkdir(ds3->meta_dfs, multipart_dir, upload_id, DEFFILEMODE, 0);
+	if (rc != 0)
+		goto err_undo;
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, multipart_dir, upload_id, O_RDWR, &upload_dir, NULL,
+			    NULL);
+	if (rc != 0)
+		goto err_undo;
+
+	rc = dfs_setxattr(ds3->meta_dfs, upload_dir, RGW_DIR_ENTRY_XATTR, encoded, encoded_length,
+			  0);
+	if (rc == 0)
+		rc = dfs_setxattr(ds3->meta_dfs, upload_dir, RGW_KEY_XATTR, upload_key, key_length,
+				  0);
+	rc2        = dfs_release(upload_dir);
+	upload_dir = NULL;
+	rc         = rc == 0 ? rc2 : rc;
+	if (rc != 0)
+		goto err_undo;
+
+	/* Finally create the object, reading its data from the parts, or keep the previous one */
+	snprintf(name, sizeof(name), "%s/%s", bucket_name, upload_id);
+	rc = ds3_obj_compose(key, name, ds3b);
+	if (rc != 0)
+		goto err_undo;
+
+	/* The parts now belong to the object, they are not moved back from here */
+	rc = -ds3_obj_open(key, ds3o, ds3b);
+	if (rc == 0 && size != NULL)
+		*size = total;
+	goto out;
+
+err_undo:
+	upload_complete_undo(upload_id, multipart_dir, composed_dir, ds3);
+out:
+	if (composed_dir)
+		rc2 = dfs_release(composed_dir);
+	rc = rc == 0 ? rc2 : rc;
+	if (upload_dir)
+		rc2 = dfs_release(upload_dir);
+	rc = rc == 0 ? rc2 : rc;
+	if (multipart_dir)
+		rc2 = dfs_release(multipart_dir);
+	rc = rc == 0 ? rc2 : rc;
+	D_FREE(encoded);
+	D_FREE(ents);
+	return -rc;
+}
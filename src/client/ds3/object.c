@@ -29,6 +29,50 @@ ends_with(const char *str, const char *suffix)
 	return strncmp(str + lenstr - lensuffix, suffix, lensuffix) == 0;
 }
 
+/**
+ * Create and open the parent directories of the key \a path, which is cut before the file name
+ * returned in \a file_name.  \a parent is NULL for the bucket root, and to be released by the
+ * caller even on failure.
+ */
+static int
+obj_parent_open(ds3_bucket_t *ds3b, char *path, dfs_obj_t **parent, char **file_name)
+{
+	char      *file_start;
+	dfs_obj_t *dir_obj;
+	char      *sptr = NULL;
+	char      *dir;
+	int        rc;
+
+	*parent    = NULL;
+	*file_name = path;
+
+	file_start = strrchr(path, '/');
+	if (file_start == NULL)
+		return 0;
+	*file_start = '\0';
+	*file_name  = file_start + 1;
+
+	/* Recursively open parent directories */
+	for (dir = strtok_r(path, "/", &sptr); dir != NULL; dir = strtok_r(NULL, "/", &sptr)) {
+		/* Create directory */
+		rc = dfs_mkdir(ds3b->dfs, *parent, dir, DEFFILEMODE, 0);
+		if (rc != 0 && rc != EEXIST)
+			return rc;
+
+		/* Open directory */
+		rc = dfs_lookup_rel(ds3b->dfs, *parent, dir, O_RDWR, &dir_obj, NULL, NULL);
+		if (rc != 0)
+			return rc;
+
+		/* Next parent */
+		rc      = *parent != NULL ? dfs_release(*parent) : 0;
+		*parent = dir_obj;
+		if (rc != 0)
+			return rc;
+	}
+	return 0;
+}
+
 int
 ds3_obj_create(const char *key, ds3_obj_t **ds3o, ds3_bucket_t *ds3b)
 {
@@ -37,13 +81,8 @@ ds3_obj_create(const char *key, ds3_obj_t **ds3o, ds3_bucket_t *ds3b)
 	ds3_obj_t *ds3o_tmp;
 	char      *path;
 	dfs_obj_t *parent = NULL;
-	char      *file_start;
 	char      *file_name;
-	char      *parent_path = NULL;
-	mode_t     mode        = DEFFILEMODE;
-	dfs_obj_t *dir_obj;
-	char      *sptr = NULL;
-	char      *dir;
+	mode_t     mode = DEFFILEMODE;
 
 	if (ds3b == NULL || ds3o == NULL)
 		return -EINVAL;
@@ -67,45 +106,39 @@ ds3_obj_create(const char *key, ds3_obj_t **ds3o, ds3_bucket_t *ds3b)
 		goto err_ds3o;
 	}
 
-	file_start = strrchr(path, '/');
-	file_name  = path;
-	if (file_start != NULL) {
-		*file_start = '\0';
-		file_name   = file_start + 1;
-		parent_path = path;
-	}
-
-	if (parent_path != NULL) {
-		/* Recursively open parent directories */
-
-		for (dir = strtok_r(parent_path, "/", &sptr); dir != NULL;
-		     dir = strtok_r(NULL, "/", &sptr)) {
-			/* Create directory */
-			rc = dfs_mkdir(ds3b->dfs, parent, dir, mode, 0);
-
-			if (rc != 0 && rc != EEXIST)
-				goto err_parent;
+	rc = obj_parent_open(ds3b, path, &parent, &file_name);
+	if (rc != 0)
+		goto err_parent;
 
-			/* Open directory */
-			rc = dfs_lookup_rel(ds3b->dfs, parent, dir, O_RDWR, &dir_obj, NULL, NULL);
+	/* Finally create the file */
+	rc = dfs_open(ds3b->dfs, parent, file_name, mode | S_IFREG, O_RDWR | O_CREAT | O_EXCL, 0,
+		      0, NULL, &ds3o_tmp->dfs_obj);
+	if (rc == EEXIST) {
+		/* Overwrite, the previous object may have been composed of upload parts */
+		rc = dfs_open(ds3b->dfs, parent, file_name, mode | S_IFREG,
+			      O_RDWR | O_CREAT | O_TRUNC, 0, 0, NULL, &ds3o_tmp->dfs_obj);
+		if (rc == 0) {
+			rc = ds3_compose_drop(ds3b, ds3o_tmp->dfs_obj);
 			if (rc != 0)
-				goto err_parent;
-
-			/* Next parent */
-			if (parent) {
-				rc = dfs_release(parent);
-				if (rc != 0)
-					goto err_parent;
-			}
-			parent = dir_obj;
+				dfs_release(ds3o_tmp->dfs_obj);
 		}
 	}
+	if (rc != 0)
+		goto err_parent;
 
-	/* Finally create the file */
-	rc = dfs_open(ds3b->dfs, parent, file_name, mode | S_IFREG, O_RDWR | O_CREAT | O_TRUNC, 0,
-		      0, NULL, &ds3o_tmp->dfs_obj);
-	if (rc == 0)
-		*ds3o = ds3o_tmp;
+	/* Index the key, its info is added once set */
+	if (daos_handle_is_valid(ds3b->key_index)) {
+		rc = ds3_key_index_put(ds3b, key, NULL, 0);
+		if (rc == 0)
+			D_STRNDUP(ds3o_tmp->key, key, DS3_MAX_KEY_BUFF - 1);
+		if (rc == 0 && ds3o_tmp->key == NULL)
+			rc = ENOMEM;
+		if (rc != 0) {
+			dfs_release(ds3o_tmp->dfs_obj);
+			goto err_parent;
+		}
+	}
+	*ds3o = ds3o_tmp;
 
 err_parent:
 	if (parent)
@@ -118,6 +151,90 @@ err_ds3o:
 	return -rc;
 }
 
+int
+ds3_obj_compose(const char *key, const char *name, ds3_bucket_t *ds3b)
+{
+	char        old_name[COMPOSE_NAME_BUFF] = "";
+	char        tmp_name[sizeof(COMPOSE_TMP_PREFIX) + DS3_MAX_UPLOAD_ID];
+	const char *upload_id;
+	char       *path;
+	char       *file_name;
+	dfs_obj_t  *parent = NULL;
+	dfs_obj_t  *obj;
+	mode_t      mode;
+	int         rc, rc2;
+
+	upload_id = strchr(name, '/');
+	if (upload_id == NULL)
+		return EINVAL;
+	snprintf(tmp_name, sizeof(tmp_name), COMPOSE_TMP_PREFIX "%s", upload_id + 1);
+
+	D_STRNDUP(path, key, DS3_MAX_KEY_BUFF - 1);
+	if (path == NULL)
+		return ENOMEM;
+
+	rc = obj_parent_open(ds3b, path, &parent, &file_name);
+	if (rc != 0)
+		goto out;
+
+	/* Build the object under a temporary name, readers still get the previous one */
+	rc = dfs_open(ds3b->dfs, parent, tmp_name, DEFFILEMODE | S_IFREG,
+		      O_RDWR | O_CREAT | O_TRUNC, 0, 0, NULL, &obj);
+	if (rc != 0)
+		goto out;
+	rc  = dfs_setxattr(ds3b->dfs, obj, DS3_COMPOSE_XATTR, name, strlen(name), 0);
+	rc2 = dfs_release(obj);
+	rc  = rc == 0 ? rc2 : rc;
+	if (rc != 0)
+		goto err_tmp;
+
+	/* The parts of the object being replaced are dropped once it is gone */
+	rc = dfs_lookup_rel(ds3b->dfs, parent, file_name, O_RDONLY | O_NOFOLLOW, &obj, &mode,
+			    NULL);
+	if (rc == 0) {
+		if (S_ISREG(mode))
+			rc = ds3_compose_name(ds3b, obj, old_name);
+		rc2 = dfs_release(obj);
+		rc  = rc == 0 ? rc2 : rc;
+	} else if (rc == ENOENT) {
+		rc = 0;
+	}
+	if (rc != 0)
+		goto err_tmp;
+
+	rc = dfs_move(ds3b->dfs, parent, tmp_name, parent, file_name, NULL);
+	if (rc != 0)
+		goto err_tmp;
+
+	/* The object is in place, the failures below are only logged */
+	if (old_name[0] != '\0') {
+		rc2 = ds3_compose_remove(ds3b->ds3, old_name);
+		if (rc2 != 0)
+			D_ERROR("Failed to remove the previous parts of %s, rc = %d\n", key, rc2);
+	}
+
+	/* Index the key, its info is added once set, which indexes it again on failure here */
+	if (daos_handle_is_valid(ds3b->key_index)) {
+		rc2 = ds3_key_index_put(ds3b, key, NULL, 0);
+		if (rc2 != 0)
+			D_ERROR("Failed to index %s, rc = %d\n", key, rc2);
+	}
+	goto out;
+
+err_tmp:
+	/* The parts stay with the upload, removing the temporary object does not drop them */
+	rc2 = dfs_remove(ds3b->dfs, parent, tmp_name, false, NULL);
+	if (rc2 != 0)
+		D_ERROR("Failed to remove %s, rc = %d\n", tmp_name, rc2);
+out:
+	if (parent) {
+		rc2 = dfs_release(parent);
+		rc  = rc == 0 ? rc2 : rc;
+	}
+	D_FREE(path);
+	return rc;
+}
+
 int
 ds3_obj_open(const char *key, ds3_obj_t **ds3o, ds3_bucket_t *ds3b)
 {
@@ -161,8 +278,27 @@ ds3_obj_open(const char *key, ds3_obj_t **ds3o, ds3_bucket_t *ds3b)
 			rc = dfs_lookup(ds3b->dfs, path, O_RDWR, &ds3o_tmp->dfs_obj, NULL, NULL);
 		}
 	}
-	if (rc == 0)
-		*ds3o = ds3o_tmp;
+	if (rc != 0)
+		goto err_path;
+
+	rc = ds3_compose_load(ds3b, ds3o_tmp);
+	if (rc != 0) {
+		dfs_release(ds3o_tmp->dfs_obj);
+		goto err_path;
+	}
+
+	/* Versioned instances are reached through links, only plain keys are indexed */
+	if (daos_handle_is_valid(ds3b->key_index) && !ends_with(key, LATEST_INSTANCE_SUFFIX)) {
+		D_STRNDUP(ds3o_tmp->key, key, DS3_MAX_KEY_BUFF - 1);
+		if (ds3o_tmp->key == NULL) {
+			ds3_compose_free(ds3o_tmp->compose);
+			dfs_release(ds3o_tmp->dfs_obj);
+			D_GOTO(err_path, rc = ENOMEM);
+		}
+	}
+	*ds3o = ds3o_tmp;
+
+err_path:
 
 	D_FREE(path);
 err_ds3o:
@@ -179,7 +315,9 @@ ds3_obj_close(ds3_obj_t *ds3o)
 	if (ds3o == NULL)
 		return -EINVAL;
 
+	ds3_compose_free(ds3o->compose);
 	rc = dfs_release(ds3o->dfs_obj);
+	D_FREE(ds3o->key);
 	D_FREE(ds3o);
 	return -rc;
 }
@@ -197,11 +335,16 @@ ds3_obj_get_info(struct ds3_object_info *info, ds3_bucket_t *ds3b, ds3_obj_t *ds
 int
 ds3_obj_set_info(struct ds3_object_info *info, ds3_bucket_t *ds3b, ds3_obj_t *ds3o)
 {
+	int rc;
+
 	if (ds3b == NULL || info == NULL || ds3o == NULL)
 		return -EINVAL;
 
-	return -dfs_setxattr(ds3b->dfs, ds3o->dfs_obj, RGW_DIR_ENTRY_XATTR, info->encoded,
-			     info->encoded_length, 0);
+	rc = dfs_setxattr(ds3b->dfs, ds3o->dfs_obj, RGW_DIR_ENTRY_XATTR, info->encoded,
+			  info->encoded_length, 0);
+	if (rc == 0 && ds3o->key != NULL)
+		rc = ds3_key_index_put(ds3b, ds3o->key, info->encoded, info->encoded_length);
+	return -rc;
 }
 
 static int
@@ -237,6 +380,9 @@ ds3_obj_read(void *buf, daos_off_t off, daos_size_t *size, ds3_bucket_t *ds3b, d
 	if (ds3b == NULL || buf == NULL || ds3o == NULL)
 		return -EINVAL;
 
+	if (ds3o->compose != NULL)
+		return -ds3_compose_read(buf, off, size, ds3b, ds3o, ev);
+
 	if (ev == NULL) {
 		d_iov_t     iov;
 		d_sg_list_t rsgl;
@@ -262,6 +408,9 @@ ds3_obj_destroy(const char *key, ds3_bucket_t *ds3b)
 	const char *file_name;
 	const char *parent_path = NULL;
 	char       *lookup_path = NULL;
+	char        name[COMPOSE_NAME_BUFF] = "";
+	dfs_obj_t  *obj;
+	mode_t      mode;
 
 	if (ds3b == NULL)
 		return -EINVAL;
@@ -294,7 +443,25 @@ ds3_obj_destroy(const char *key, ds3_bucket_t *ds3b)
 			goto err_parent;
 	}
 
+	/* The upload parts of a composed object, links only point to it */
+	rc = dfs_lookup_rel(ds3b->dfs, parent, file_name, O_RDWR | O_NOFOLLOW, &obj, &mode, NULL);
+	if (rc != 0)
+		goto err_parent;
+	if (S_ISREG(mode))
+		rc = ds3_compose_name(ds3b, obj, name);
+	rc2 = dfs_release(obj);
+	rc  = rc == 0 ? rc2 : rc;
+	if (rc != 0)
+		goto err_parent;
+
+	/* Remove the object first, its parts are only dropped once nothing refers to them */
 	rc = dfs_remove(ds3b->dfs, parent, file_name, false, NULL);
+	if (rc == 0) {
+		if (name[0] != '\0')
+			rc = ds3_compose_remove(ds3b->ds3, name);
+		rc2 = ds3_key_index_remove(ds3b, key);
+		rc  = rc == 0 ? rc2 : rc;
+	}
 
 err_parent:
 	if (parent)
@@ -333,6 +500,10 @@ ds3_obj_write(void *buf, daos_off_t off, daos_size_t *size, ds3_bucket_t *ds3b,
 	if (ds3b == NULL || buf == NULL || ds3o == NULL)
 		return -EINVAL;
 
+	/* The data of a composed object belongs to the upload parts */
+	if (ds3o->compose != NULL)
+		return -ENOTSUP;
+
 	if (ev == NULL) {
 		d_iov_t     iov;
 		d_sg_list_t wsgl;
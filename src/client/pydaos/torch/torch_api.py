@@ -32,6 +32,9 @@ PARALLEL_SCAN_WORKERS = 16
 DIR_CACHE_SIZE = 64 * 1024
 DEFAULT_CHUNK_SIZE = 64 * 1024 * 1024
 DEFAULT_CHUNKS_LIMIT = 1024 // DEFAULT_CHUNK_SIZE
+PACK_INDEX_NAME = ".daos_pack_index"
+PACK_FILE_PREFIX = "pack."
+DEFAULT_PACK_SIZE = 1024 * 1024 * 1024
 
 
 def transform_fn_default(data):
@@ -48,6 +51,9 @@ class Dataset(TorchDataset):
     The samples are accessed by index operator __getitem__ or its optimized version
     __getitems__ that accepts batch of indices and load them in parallel.
 
+    If the path holds a dataset packed by pack_dataset(), the samples are listed from its index
+    instead, and the samples of a batch stored in the same pack file are read at once.
+
     If this Dataset is planned to be used via multiple workers in different processes,
     before accessing the data, workers needs to call worker_init function to re-initialize
     DAOS internals after fork(s).
@@ -71,6 +77,12 @@ class Dataset(TorchDataset):
         Number of directory object entries to cache in memory.
     readdir_workers: int (optional)
         Number of parallel workers for namespace scanning.
+    prefetch: int (optional)
+        Number of batches to read ahead of their use, following the order given by
+        set_epoch_order(). Default is 0, the batches are read when requested.
+    prefetch_zero_copy: bool (optional)
+        Returns the samples of a prefetched batch as memoryview objects into buffers reused
+        once they are released, instead of bytes objects copied from them. Default is False.
 
     Methods
     -------
@@ -83,6 +95,10 @@ class Dataset(TorchDataset):
     __getitems__(indices):
         Returns batch of the items by their indices read in parallel.
 
+    set_epoch_order(indices, batch_size):
+        Sets the order in which the sampler draws the samples in the coming epoch, so that the
+        next batches can be prefetched.
+
     worker_init(worker_id):
         (Re)Initializes worker on the current running process to be able access DAOS Dataset,
         after the fork, which is default way for pytorch.DataLoader to run multiple workers.
@@ -94,7 +110,9 @@ class Dataset(TorchDataset):
                  transform_fn=transform_fn_default,
                  readdir_batch_size=READDIR_BATCH_SIZE,
                  dir_cache_size=DIR_CACHE_SIZE,
-                 readdir_workers=PARALLEL_SCAN_WORKERS):
+                 readdir_workers=PARALLEL_SCAN_WORKERS,
+                 prefetch=0,
+                 prefetch_zero_copy=False):
         super().__init__()
 
         self._pool = pool
@@ -104,8 +122,21 @@ class Dataset(TorchDataset):
         self._readdir_batch_size = readdir_batch_size
         self._closed = False
 
-        self.objects = self._dfs.parallel_list(
-            path, readdir_batch_size=self._readdir_batch_size, workers=readdir_workers)
+        self._prefetch = prefetch
+        self._prefetcher = None
+        if prefetch > 0:
+            self._prefetcher = _Prefetcher(self._dfs, prefetch, prefetch_zero_copy)
+        self._plan = None
+        self._plan_pid = None
+        self._worker_plan = None
+        self._worker_plan_pos = None
+
+        self._packed = self._dfs.is_packed(path)
+        if self._packed:
+            self.objects = self._dfs.load_pack_index(path)
+        else:
+            self.objects = self._dfs.parallel_list(
+                path, readdir_batch_size=self._readdir_batch_size, workers=readdir_workers)
 
     def __len__(self):
         """ Returns number of items in this dataset """
@@ -116,16 +147,71 @@ class Dataset(TorchDataset):
         """ Read item by its index """
 
         obj = self.objects[idx]
+        if self._packed:
+            return self._transform_fn(self._dfs.batch_read_packed([obj])[0])
+
         path, size = obj
         return self._transform_fn(self._dfs.read(path, size))
 
     def __getitems__(self, indices):
         """ Batch read of multiple items in parallel by their indices """
 
-        items = [self.objects[idx] for idx in indices]
-        result = self._dfs.batch_read(items)
+        result = None
+        if self._prefetcher is not None and self._plan:
+            result = self._prefetched_read(indices)
+
+        if result is None:
+            items = [self.objects[idx] for idx in indices]
+            if self._packed:
+                result = self._dfs.batch_read_packed(items)
+            else:
+                result = self._dfs.batch_read(items)
         return [self._transform_fn(x) for x in result]
 
+    def set_epoch_order(self, indices, batch_size):
+        """
+        Sets the order in which the samples are drawn in the coming epoch, so that the batches
+        following the requested one are read ahead.
+
+        The same order has to be given to the DataLoader, e.g. as its sampler, and it has to be
+        set before the DataLoader starts its workers, which are assumed to receive the batches in
+        turn.
+        """
+
+        indices = list(indices)
+        self._plan = [tuple(indices[i:i + batch_size])
+                      for i in range(0, len(indices), batch_size)]
+        self._plan_pid = None
+
+    def _prefetched_read(self, indices):
+        """ Returns the batch from the prefetcher, None if it is not part of the epoch order """
+
+        if self._plan_pid != os.getpid():
+            # every worker prefetches only the batches it will be asked for
+            worker_info = get_worker_info()
+            plan = self._plan
+            if worker_info is not None:
+                plan = plan[worker_info.id::worker_info.num_workers]
+            self._worker_plan = plan
+            self._worker_plan_pos = {key: pos for pos, key in enumerate(plan)}
+            self._plan_pid = os.getpid()
+
+        key = tuple(indices)
+        pos = self._worker_plan_pos.get(key)
+        if pos is None:
+            return None
+
+        pf = self._prefetcher
+        for stale in pf.keys():
+            if self._worker_plan_pos[stale] < pos:
+                pf.discard(stale)
+
+        for ahead in self._worker_plan[pos:pos + self._prefetch + 1]:
+            if ahead not in pf:
+                pf.submit(ahead, [_sample_read(self.objects[idx], self._packed) for idx in ahead])
+
+        return pf.wait(key)
+
     def worker_init(self, worker_id):
         """ Re-initializes DAOS internals after fork """
 
@@ -142,6 +228,8 @@ class Dataset(TorchDataset):
             return
         self._closed = True
 
+        if self._prefetcher is not None:
+            self._prefetcher.close()
         self._dfs.disconnect()
         self.objects = None
 
@@ -180,6 +268,9 @@ class IterableDataset(TorchIterableDataset):
 
     The samples are accessed by iterator returned by __iter__ method.
 
+    If the path holds a dataset packed by pack_dataset(), the samples are listed from its index
+    instead, and the samples of a batch stored in the same pack file are read at once.
+
     If this Dataset is planned to be used via multiple workers in different processes,
     before accessing the data, workers needs to call worker_init function to re-initialize
     DAOS internals after fork(s) and to split work between them.
@@ -221,6 +312,12 @@ class IterableDataset(TorchIterableDataset):
         Number of directory object entries to cache in memory.
     readdir_workers: int (optional)
         Number of parallel workers for namespace scanning.
+    prefetch: int (optional)
+        Number of batches to read ahead of their use. Default is 0, the batches are read when
+        requested.
+    prefetch_zero_copy: bool (optional)
+        Returns the samples of a prefetched batch as memoryview objects into buffers reused
+        once they are released, instead of bytes objects copied from them. Default is False.
 
 
     Methods
@@ -239,7 +336,9 @@ class IterableDataset(TorchIterableDataset):
                  readdir_batch_size=READDIR_BATCH_SIZE,
                  batch_size=ITER_BATCH_SIZE,
                  dir_cache_size=DIR_CACHE_SIZE,
-                 readdir_workers=PARALLEL_SCAN_WORKERS):
+                 readdir_workers=PARALLEL_SCAN_WORKERS,
+                 prefetch=0,
+                 prefetch_zero_copy=False):
         super().__init__()
 
         self._pool = pool
@@ -250,8 +349,17 @@ class IterableDataset(TorchIterableDataset):
         self._batch_size = batch_size
         self._closed = False
 
-        self.objects = self._dfs.parallel_list(
-            path, readdir_batch_size=self._readdir_batch_size, workers=readdir_workers)
+        self._prefetch = prefetch
+        self._prefetcher = None
+        if prefetch > 0:
+            self._prefetcher = _Prefetcher(self._dfs, prefetch, prefetch_zero_copy)
+
+        self._packed = self._dfs.is_packed(path)
+        if self._packed:
+            self.objects = self._dfs.load_pack_index(path)
+        else:
+            self.objects = self._dfs.parallel_list(
+                path, readdir_batch_size=self._readdir_batch_size, workers=readdir_workers)
         self.workset = self.objects
 
     def __iter__(self):
@@ -261,11 +369,30 @@ class IterableDataset(TorchIterableDataset):
         there's no need to implement Iterator Protocol.
         """
 
+        if self._prefetcher is not None:
+            yield from self.__prefetch_batches()
+            return
+
         batches = (self.workset[i:i + self._batch_size]
                    for i in range(0, len(self.workset), self._batch_size))
         for batch in batches:
             yield from self.__load_batch(batch)
 
+    def __prefetch_batches(self):
+        """ Iterates over the items, keeping the next batches in flight """
+
+        pf = self._prefetcher
+        # batches left in flight by an iteration stopped early
+        pf.drain()
+
+        batches = [self.workset[i:i + self._batch_size]
+                   for i in range(0, len(self.workset), self._batch_size)]
+        for pos in range(len(batches)):
+            for ahead in range(pos, min(pos + self._prefetch + 1, len(batches))):
+                if ahead not in pf:
+                    pf.submit(ahead, [_sample_read(obj, self._packed) for obj in batches[ahead]])
+            yield from [self._transform_fn(x) for x in pf.wait(pos)]
+
     def worker_init(self, worker_id):
         """
         Re-initializes DAOS internals after fork and split the work between the workers.
@@ -296,6 +423,8 @@ class IterableDataset(TorchIterableDataset):
             return
         self._closed = True
 
+        if self._prefetcher is not None:
+            self._prefetcher.close()
         self._dfs.disconnect()
         self.workset = None
         self.objects = None
@@ -328,7 +457,10 @@ class IterableDataset(TorchIterableDataset):
     def __load_batch(self, items):
         """ load items in batch and applies data transformation function """
 
-        result = self._dfs.batch_read(items)
+        if self._packed:
+            result = self._dfs.batch_read_packed(items)
+        else:
+            result = self._dfs.batch_read(items)
         return [self._transform_fn(x) for x in result]
 
 
@@ -653,6 +785,89 @@ class Checkpoint():
                            self._chunks_limit, self._workers)
 
 
+# pylint: disable=too-many-arguments,too-many-locals
+def pack_dataset(pool, cont, src=None, dst=None,
+                 pack_size=DEFAULT_PACK_SIZE,
+                 class_name="OC_UNKNOWN",
+                 batch_size=ITER_BATCH_SIZE,
+                 readdir_workers=PARALLEL_SCAN_WORKERS):
+    """
+    Packs the samples found under `src` into a few large files under `dst`, so that a dataset of
+    many small files can be loaded without opening each of them.
+
+    The samples are stored back to back in files named pack.<n> of up to `pack_size` bytes, and
+    are listed in an index file of which each line holds: pack number, offset, size and name
+    of the sample relative to `src`.
+    Dataset and IterableDataset created with `dst` as path use the index transparently.
+
+    Returns the number of samples packed.
+    """
+
+    if dst is None:
+        raise ValueError("destination path is required")
+    if pack_size <= 0:
+        raise ValueError("pack size should be a positive number")
+
+    if src is None:
+        src = os.sep
+
+    mode = stat.S_IFREG | stat.S_IRUSR | stat.S_IWUSR | stat.S_IRGRP | stat.S_IROTH
+    oflags = os.O_CREAT | os.O_RDWR
+
+    dfs = _Dfs(pool=pool, cont=cont, rd_only=False)
+    try:
+        if dfs.is_packed(dst):
+            raise FileExistsError(errno.EEXIST, os.strerror(errno.EEXIST), dst)
+        dfs.mkdirall(dst)
+
+        samples = sorted(dfs.parallel_list(src, workers=readdir_workers))
+
+        index = []
+        pack_id = 0
+        pack_off = 0
+        # offset in the current pack of the data buffered in `buf`
+        buf_off = 0
+        buf = bytearray()
+
+        for i in range(0, len(samples), batch_size):
+            batch = samples[i:i + batch_size]
+            for (path, size), data in zip(batch, dfs.batch_read(batch)):
+                name = os.path.relpath(path, src)
+                if "\n" in name:
+                    raise ValueError(f"sample name can not contain a new line: {name!r}")
+
+                if pack_off > 0 and pack_off + size > pack_size:
+                    if buf:
+                        dfs.write(os.path.join(dst, f"{PACK_FILE_PREFIX}{pack_id}"), mode,
+                                  oflags, class_name, 0, buf_off, buf)
+                    pack_id += 1
+                    pack_off = 0
+                    buf_off = 0
+                    buf = bytearray()
+
+                index.append(f"{pack_id} {pack_off} {size} {name}\n")
+                buf.extend(data)
+                pack_off += size
+
+                if len(buf) >= DEFAULT_CHUNK_SIZE:
+                    dfs.write(os.path.join(dst, f"{PACK_FILE_PREFIX}{pack_id}"), mode, oflags,
+                              class_name, 0, buf_off, buf)
+                    buf_off = pack_off
+                    buf = bytearray()
+
+        if buf:
+            dfs.write(os.path.join(dst, f"{PACK_FILE_PREFIX}{pack_id}"), mode, oflags,
+                      class_name, 0, buf_off, buf)
+
+        # the index is written last: an interrupted packing leaves no usable dataset behind
+        dfs.write(os.path.join(dst, PACK_INDEX_NAME), mode, oflags, class_name, 0, 0,
+                  "".join(index).encode())
+    finally:
+        dfs.disconnect()
+
+    return len(samples)
+
+
 def _readdir_worker_init(dfs, readdir_batch_size):
     """
     Worker init for parallel readdir.
@@ -829,6 +1044,61 @@ class _Dfs():
 
         return [item[1] for item in to_read]
 
+    def is_packed(self, path):
+        """ Returns True if `path` holds a dataset packed by pack_dataset() """
+
+        if path is None:
+            path = os.sep
+
+        ret, _ = torch_shim.torch_get_fsize(DAOS_MAGIC, self._dfs,
+                                            os.path.join(path, PACK_INDEX_NAME))
+        if ret == errno.ENOENT:
+            return False
+        if ret != 0:
+            raise OSError(ret, os.strerror(ret), path)
+        return True
+
+    def load_pack_index(self, path):
+        """
+        Loads the index of the packed dataset at `path`.
+        Returns list of tuples (name, size, pack_path, offset), one per sample.
+        """
+
+        if path is None:
+            path = os.sep
+
+        index = os.path.join(path, PACK_INDEX_NAME)
+        data = self.read(index, self.get_file_size(index))
+
+        result = []
+        for line in data.decode().splitlines():
+            pack_id, offset, size, name = line.split(" ", 3)
+            result.append((name, int(size),
+                           os.path.join(path, f"{PACK_FILE_PREFIX}{pack_id}"), int(offset)))
+        return result
+
+    def batch_read_packed(self, items):
+        """
+        Reads samples of a packed dataset, given as tuples (name, size, pack_path, offset).
+        The samples stored in the same pack file are fetched by a single multi-extent read.
+        The result list is in the same order as the input list.
+        """
+
+        result = [bytearray(item[1]) for item in items]
+        groups = {}
+        for item, buf in zip(items, result):
+            if item[1] > 0:
+                groups.setdefault(item[2], []).append((buf, item[3]))
+
+        if not groups:
+            return result
+
+        ret = torch_shim.torch_batch_read_packed(DAOS_MAGIC, self._dfs, list(groups.items()))
+        if ret != 0:
+            raise OSError(ret, os.strerror(ret))
+
+        return result
+
     def worker_init(self):
         """ Tries to reinitialize DAOS DFS for the current process after fork """
 
@@ -858,3 +1128,152 @@ class _Dfs():
             ret = torch_shim.torch_mkdir(DAOS_MAGIC, self._dfs, parent, mode)
             if ret not in (0, errno.EEXIST):
                 raise OSError(ret, os.strerror(ret), parent)
+
+
+def _sample_read(obj, packed):
+    """ Returns (path, size, offset) to read the sample described by a dataset object """
+
+    if packed:
+        return (obj[2], obj[1], obj[3])
+    return (obj[0], obj[1], 0)
+
+
+class _Prefetcher():
+    """
+    Keeps batches of reads in flight ahead of their use on a dedicated DAOS event queue.
+    Each batch is read into one buffer of a bounded pool, reused by the later batches, and its
+    samples are returned as bytes objects copied from it.
+    With `zero_copy` the samples are returned as memoryview slices of the buffer instead, which
+    is reused only once none of them is referenced anymore.
+    Should not be used directly.
+    """
+
+    def __init__(self, dfs, depth, zero_copy=False):
+        self._dfs = dfs
+        self._depth = depth
+        self._zero_copy = zero_copy
+        self._pf = None
+        self._pid = None
+        # key -> (batch, buffer, samples), in submission order
+        self._inflight = {}
+        self._free = []
+
+    def __contains__(self, key):
+        self._handle()
+        return key in self._inflight
+
+    def keys(self):
+        """ Returns the keys of the batches in flight """
+        self._handle()
+        return list(self._inflight)
+
+    def _handle(self):
+        """ Returns the prefetcher of the current process, after fork the parent's is dropped """
+
+        if self._pid != os.getpid():
+            # only frees the parent's copy, its event queue is left alone
+            if self._pf is not None:
+                torch_shim.torch_prefetch_destroy(DAOS_MAGIC, self._pf)
+            self._inflight = {}
+            self._pf = None
+            # pylint: disable=protected-access
+            ret, pf = torch_shim.torch_prefetch_create(DAOS_MAGIC, self._dfs._dfs)
+            if ret != 0:
+                raise OSError(ret, os.strerror(ret), "could not create prefetcher")
+            self._pf = pf
+            self._pid = os.getpid()
+        return self._pf
+
+    def _get_buffer(self, size):
+        """ Returns a free buffer of at least `size` bytes """
+
+        while self._free:
+            buf = self._free.pop()
+            try:
+                # resizing fails while views of the buffer are still alive
+                if len(buf) < size:
+                    buf.extend(bytes(size - len(buf)))
+                else:
+                    buf.append(0)
+                    del buf[-1]
+                return buf
+            except BufferError:
+                continue
+        return bytearray(size)
+
+    def submit(self, key, reads):
+        """ Starts reading a batch of samples given as (path, size, offset) """
+
+        pf = self._handle()
+        buf = self._get_buffer(sum(read[1] for read in reads))
+        view = memoryview(buf)
+
+        samples = []
+        to_read = []
+        pos = 0
+        for path, size, offset in reads:
+            sample = view[pos:pos + size]
+            samples.append(sample)
+            to_read.append((path, sample, offset))
+            pos += size
+
+        ret, batch = torch_shim.torch_prefetch_submit(DAOS_MAGIC, pf, to_read)
+        if ret != 0:
+            raise OSError(ret, os.strerror(ret))
+        self._inflight[key] = (batch, buf, samples)
+
+    def wait(self, key):
+        """ Waits for a batch submitted under `key` and returns its samples """
+
+        batch, buf, samples = self._inflight.pop(key)
+        ret = torch_shim.torch_prefetch_wait(DAOS_MAGIC, self._pf, batch)
+
+        if ret != 0:
+            views = samples
+        elif not self._zero_copy:
+            views = samples
+            samples = [bytes(view) for view in views]
+        else:
+            views = []
+        # the buffer can be reused at once unless its views are handed out
+        for view in views:
+            view.release()
+
+        if len(self._free) <= self._depth:
+            self._free.append(buf)
+
+        if ret != 0:
+            raise OSError(ret, os.strerror(ret))
+        return samples
+
+    def discard(self, key):
+        """ Waits for a batch that will not be used, dropping its samples and error """
+
+        try:
+            self.wait(key)
+        except OSError:
+            pass
+
+    def drain(self):
+        """ Waits for all batches in flight, dropping their samples and errors """
+
+        # the batches inherited from the parent process are not ours to wait for
+        if self._pid != os.getpid():
+            return
+
+        for key in list(self._inflight):
+            self.discard(key)
+
+    def close(self):
+        """ Waits for the batches in flight and frees the prefetcher """
+
+        if self._pf is None:
+            return
+
+        if self._pid == os.getpid():
+            self.drain()
+        ret = torch_shim.torch_prefetch_destroy(DAOS_MAGIC, self._pf)
+        self._pf = None
+        self._inflight = {}
+        if ret != 0:
+            raise OSError(ret, os.strerror(ret))
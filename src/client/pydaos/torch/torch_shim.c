@@ -712,10 +712,13 @@ struct io_op {
 
 	/* Buffer view that implements Python Buffer Protocol, has to be release after use */
 	Py_buffer    buf_view;
+
+	/* Batch the op belongs to, when started by a prefetcher */
+	struct prefetch_batch *batch;
 };
 
 static int
-start_read_op(struct dfs_handle *hdl, PyObject *item, struct io_op *op)
+start_read_op(struct dfs_handle *hdl, daos_handle_t eq, PyObject *item, struct io_op *op)
 {
 	assert(op != NULL);
 
@@ -758,7 +761,7 @@ start_read_op(struct dfs_handle *hdl, PyObject *item, struct io_op *op)
 		goto err;
 	}
 
-	rc = daos_event_init(evp, hdl->eq, NULL);
+	rc = daos_event_init(evp, eq, NULL);
 	if (rc) {
 		D_ERROR("Could not init event: %s (rc=%d)", d_errstr(rc), rc);
 		rc = daos_der2errno(rc);
@@ -899,7 +902,7 @@ __shim_handle__torch_batch_read(PyObject *self, PyObject *args)
 			break;
 		}
 
-		rc = start_read_op(hdl, item, &ops[i]);
+		rc = start_read_op(hdl, hdl->eq, item, &ops[i]);
 		if (rc) {
 			nr = i;
 			break;
@@ -936,6 +939,416 @@ __shim_handle__torch_batch_read(PyObject *self, PyObject *args)
 	return PyLong_FromLong(rc);
 }
 
+/*
+  Prefetcher: keeps batches of reads in flight ahead of their use.
+  It has its own event queue, so that batch_read() of the same handle does not reap its events,
+  and it must be created by the process using it, e.g. in a DataLoader worker.
+*/
+struct prefetcher {
+	struct dfs_handle *hdl;
+	daos_handle_t      eq;
+	pid_t              owner_pid;
+};
+
+struct prefetch_batch {
+	Py_ssize_t   nr;
+	Py_ssize_t   completed;
+	int          rc;
+	struct io_op ops[];
+};
+
+static PyObject *
+__shim_handle__torch_prefetch_create(PyObject *self, PyObject *args)
+{
+	struct dfs_handle *hdl = NULL;
+	struct prefetcher *pf  = NULL;
+	int                rc  = 0;
+
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "L", &hdl);
+	assert(hdl->dfs != NULL);
+
+	D_ALLOC_PTR(pf);
+	if (pf == NULL) {
+		return Py_BuildValue("iN", ENOMEM, PyLong_FromVoidPtr(NULL));
+	}
+
+	rc = daos_eq_create(&pf->eq);
+	if (rc) {
+		D_ERROR("Could not create event queue: %s (rc=%d)", d_errstr(rc), rc);
+		D_FREE(pf);
+		return Py_BuildValue("iN", daos_der2errno(rc), PyLong_FromVoidPtr(NULL));
+	}
+	pf->hdl       = hdl;
+	pf->owner_pid = getpid();
+
+	return Py_BuildValue("iN", 0, PyLong_FromVoidPtr(pf));
+}
+
+static PyObject *
+__shim_handle__torch_prefetch_destroy(PyObject *self, PyObject *args)
+{
+	struct prefetcher *pf = NULL;
+	int                rc = 0;
+
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "L", &pf);
+
+	/* The event queue of the parent process can not be used after fork */
+	if (pf->owner_pid == getpid()) {
+		rc = daos_eq_destroy(pf->eq, DAOS_EQ_DESTROY_FORCE);
+		if (rc) {
+			D_ERROR("Could not destroy event queue: %s (rc=%d)", d_errstr(rc), rc);
+			rc = daos_der2errno(rc);
+		}
+	}
+	D_FREE(pf);
+
+	return PyLong_FromLong(rc);
+}
+
+/*
+  Starts the reads of a batch of items (path, bytearray, [offset]) and returns immediately.
+  The returned batch must be passed to torch_prefetch_wait(), even when some reads failed to start.
+ */
+static PyObject *
+__shim_handle__torch_prefetch_submit(PyObject *self, PyObject *args)
+{
+	struct prefetcher     *pf    = NULL;
+	struct prefetch_batch *batch = NULL;
+	PyObject              *items = NULL;
+	Py_ssize_t             nr    = 0;
+	int                    rc    = 0;
+
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LO", &pf, &items);
+
+	if (pf->owner_pid != getpid()) {
+		return Py_BuildValue("iN", EACCES, PyLong_FromVoidPtr(NULL));
+	}
+
+	nr = PyList_Size(items);
+	if (nr <= 0) {
+		return Py_BuildValue("iN", EINVAL, PyLong_FromVoidPtr(NULL));
+	}
+
+	D_ALLOC(batch, sizeof(*batch) + nr * sizeof(batch->ops[0]));
+	if (batch == NULL) {
+		return Py_BuildValue("iN", ENOMEM, PyLong_FromVoidPtr(NULL));
+	}
+
+	for (Py_ssize_t i = 0; i < nr; ++i) {
+		PyObject *item = PyList_GetItem(items, i);
+		if (item == NULL) {
+			D_ERROR("Unexpected NULL entry in the prefetch list");
+			rc = EINVAL;
+		} else {
+			batch->ops[i].batch = batch;
+			rc = start_read_op(pf->hdl, pf->eq, item, &batch->ops[i]);
+		}
+		if (rc) {
+			batch->rc = rc;
+			break;
+		}
+		batch->nr++;
+	}
+
+	return Py_BuildValue("iN", 0, PyLong_FromVoidPtr(batch));
+}
+
+/*
+  Waits for the reads of a prefetched batch and frees it.
+  Reads of the other batches completing meanwhile are accounted to their own batch.
+ */
+static PyObject *
+__shim_handle__torch_prefetch_wait(PyObject *self, PyObject *args)
+{
+	struct prefetcher     *pf    = NULL;
+	struct prefetch_batch *batch = NULL;
+	int                    rc    = 0;
+	daos_event_t          *evp[EQ_POLL_BATCH_SIZE];
+
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LL", &pf, &batch);
+
+	while (batch->completed < batch->nr) {
+		int eq_rc;
+
+		/* Let the other threads, e.g. the training loop, run while waiting on storage */
+		Py_BEGIN_ALLOW_THREADS
+		eq_rc = daos_eq_poll(pf->eq, 1, DAOS_EQ_WAIT, EQ_POLL_BATCH_SIZE, evp);
+		Py_END_ALLOW_THREADS
+
+		if (eq_rc < 0) {
+			D_ERROR("Could not poll event queue: %s (rc=%d)", d_errstr(eq_rc), eq_rc);
+			rc = daos_der2errno(eq_rc);
+			break;
+		}
+
+		for (int i = 0; i < eq_rc; ++i) {
+			struct io_op *op    = container_of(evp[i], struct io_op, ev);
+			int           op_rc = complete_read_op(pf->hdl, op);
+
+			if (op_rc) {
+				D_ERROR("ERROR in fetching the results: %s (rc=%d)",
+					strerror(op_rc), op_rc);
+				if (op->batch->rc == 0)
+					op->batch->rc = op_rc;
+			}
+			op->batch->completed++;
+		}
+	}
+
+	/* On poll failure the batch is leaked: its reads may still be in flight */
+	if (rc == 0) {
+		rc = batch->rc;
+		D_FREE(batch);
+	}
+
+	return PyLong_FromLong(rc);
+}
+
+/*
+  Describes the read of several samples of a packed dataset stored in the same pack file:
+  all of them are fetched at once by a single list-io read of their extents.
+*/
+struct pack_op {
+	daos_event_t ev;
+
+	/* Purely for debug purpose: should not be freed as it's not the owner of the data */
+	const char  *path;
+
+	dfs_iod_t    iod;
+	d_sg_list_t  sgl;
+
+	daos_size_t  size;
+	daos_size_t  read;
+
+	/* Per sample extents, iovs and buffer views; views have to be released after use */
+	daos_range_t *rgs;
+	d_iov_t      *iovs;
+	Py_buffer    *views;
+	Py_ssize_t    nr_views;
+};
+
+static void
+pack_op_release(struct pack_op *op)
+{
+	for (Py_ssize_t i = 0; i < op->nr_views; ++i) {
+		PyBuffer_Release(&op->views[i]);
+	}
+	op->nr_views = 0;
+
+	D_FREE(op->rgs);
+	D_FREE(op->iovs);
+	D_FREE(op->views);
+}
+
+static int
+start_pack_read_op(struct dfs_handle *hdl, PyObject *group, struct pack_op *op)
+{
+	assert(op != NULL);
+
+	int        rc      = 0;
+	int        rc2     = 0;
+	dfs_obj_t *obj     = NULL;
+	Py_ssize_t nr      = 0;
+	PyObject  *py_path = PyTuple_GetItem(group, 0);
+	PyObject  *samples = PyTuple_GetItem(group, 1);
+
+	if (py_path == NULL || samples == NULL || !PyList_Check(samples)) {
+		D_ERROR("Each group must contain exactly two elements: path and list of samples");
+		return EINVAL;
+	}
+
+	op->path = PyUnicode_AsUTF8(py_path);
+	if (op->path == NULL) {
+		D_ERROR("First element of a group does not look like a path");
+		return EINVAL;
+	}
+
+	nr = PyList_Size(samples);
+	if (nr <= 0) {
+		return EINVAL;
+	}
+
+	D_ALLOC_ARRAY(op->rgs, nr);
+	D_ALLOC_ARRAY(op->iovs, nr);
+	D_ALLOC_ARRAY(op->views, nr);
+	if (op->rgs == NULL || op->iovs == NULL || op->views == NULL) {
+		rc = ENOMEM;
+		goto err;
+	}
+
+	for (Py_ssize_t i = 0; i < nr; ++i) {
+		PyObject  *sample = PyList_GetItem(samples, i);
+		PyObject  *py_buf = NULL;
+		Py_buffer *view   = &op->views[i];
+
+		if (sample == NULL || PyTuple_Size(sample) != 2) {
+			D_ERROR("Each sample must contain exactly two elements: bytearray and offset");
+			rc = EINVAL;
+			goto err;
+		}
+
+		py_buf = PyTuple_GetItem(sample, 0);
+		if (PyObject_GetBuffer(py_buf, view, PyBUF_WRITE) == -1) {
+			D_ERROR("Buffer is not writable");
+			rc = EINVAL;
+			goto err;
+		}
+		op->nr_views++;
+
+		if (!PyBuffer_IsContiguous(view, 'C')) {
+			D_ERROR("Buffer for '%s' is not contiguous", op->path);
+			rc = EINVAL;
+			goto err;
+		}
+
+		op->rgs[i].rg_idx = PyLong_AsUnsignedLongLong(PyTuple_GetItem(sample, 1));
+		op->rgs[i].rg_len = view->len;
+		d_iov_set(&op->iovs[i], view->buf, view->len);
+		op->size += view->len;
+	}
+
+	op->iod.iod_nr  = nr;
+	op->iod.iod_rgs = op->rgs;
+
+	op->sgl.sg_nr     = nr;
+	op->sgl.sg_nr_out = 0;
+	op->sgl.sg_iovs   = op->iovs;
+
+	/* Pack files are few and large, they are kept open in the objects cache */
+	rc = lookup_or_insert_dir_obj(hdl, op->path, &obj);
+	if (rc) {
+		D_ERROR("Could not lookup '%s': %s (rc=%d)", op->path, strerror(rc), rc);
+		goto err;
+	}
+
+	rc = daos_event_init(&op->ev, hdl->eq, NULL);
+	if (rc) {
+		D_ERROR("Could not init event: %s (rc=%d)", d_errstr(rc), rc);
+		rc = daos_der2errno(rc);
+		goto err;
+	}
+
+	rc = dfs_readx(hdl->dfs, obj, &op->iod, &op->sgl, &op->read, &op->ev);
+	if (rc) {
+		D_ERROR("Could not start async read on '%s': %s (rc=%d)", op->path, strerror(rc),
+			rc);
+		rc2 = daos_event_fini(&op->ev);
+		if (rc2) {
+			D_ERROR("Could not finalize event: %s (rc=%d)", d_errstr(rc2), rc2);
+		}
+		goto err;
+	}
+
+	return 0;
+
+err:
+	pack_op_release(op);
+	return rc;
+}
+
+static int
+complete_pack_read_op(struct dfs_handle *hdl, struct pack_op *op)
+{
+	int rc  = 0;
+	int rc2 = 0;
+
+	assert(op != NULL);
+
+	D_DEBUG(DB_ANY, "READ of %zd samples from '%s' completed with status: %s (rc = %d)",
+		op->nr_views, op->path, d_errstr(op->ev.ev_error), op->ev.ev_error);
+
+	rc = op->ev.ev_error;
+	if (rc == 0 && op->read != op->size) {
+		rc = EIO;
+	}
+
+	rc2 = daos_event_fini(&op->ev);
+	if (rc2) {
+		D_ERROR("Could not finalize event handler of '%s': %s (rc=%d)", op->path,
+			d_errstr(rc2), rc2);
+		if (rc == 0)
+			rc = rc2;
+	}
+
+	pack_op_release(op);
+	return rc;
+}
+
+/*
+  Batch read of samples from a packed dataset.
+  It expects a list of groups (pack_path, [(bytearray, offset), ...]), one per pack file,
+  and issues a single multi-extent read for each group.
+ */
+static PyObject *
+__shim_handle__torch_batch_read_packed(PyObject *self, PyObject *args)
+{
+	int                rc        = 0;
+	int                completed = 0;
+	PyObject          *groups    = NULL;
+	Py_ssize_t         nr        = 0;
+	struct pack_op    *ops       = NULL;
+	struct dfs_handle *hdl       = NULL;
+	daos_event_t      *evp[EQ_POLL_BATCH_SIZE];
+
+	RETURN_NULL_IF_FAILED_TO_PARSE(args, "LO", &hdl, &groups);
+	assert(hdl->dfs != NULL);
+
+	nr = PyList_Size(groups);
+	if (nr <= 0) {
+		return PyLong_FromLong(EINVAL);
+	}
+
+	D_ALLOC_ARRAY(ops, nr);
+	if (ops == NULL) {
+		return PyLong_FromLong(ENOMEM);
+	}
+
+	for (Py_ssize_t i = 0; i < nr; ++i) {
+		PyObject *group = PyList_GetItem(groups, i);
+		if (group == NULL) {
+			D_ERROR("Unexpected NULL entry in the batch read list");
+			rc = EINVAL;
+
+			nr = i;
+			break;
+		}
+
+		rc = start_pack_read_op(hdl, group, &ops[i]);
+		if (rc) {
+			nr = i;
+			break;
+		}
+	}
+
+	while (completed < nr) {
+		int eq_rc = daos_eq_poll(hdl->eq, 0, DAOS_EQ_NOWAIT, EQ_POLL_BATCH_SIZE, evp);
+		if (eq_rc < 0) {
+			D_ERROR("Could not poll event queue: %s (rc=%d)", d_errstr(eq_rc), eq_rc);
+			rc = daos_der2errno(eq_rc);
+			break;
+		}
+
+		for (int i = 0; i < eq_rc; ++i) {
+			struct pack_op *op    = container_of(evp[i], struct pack_op, ev);
+			int             op_rc = complete_pack_read_op(hdl, op);
+
+			if (rc == 0 && op_rc != 0) {
+				rc = op_rc;
+			}
+
+			if (op_rc) {
+				D_ERROR("ERROR in fetching the results: %s (rc=%d)",
+					strerror(op_rc), op_rc);
+			}
+		}
+		completed += eq_rc;
+	}
+
+	D_FREE(ops);
+
+	return PyLong_FromLong(rc);
+}
+
 static PyObject *
 __shim_handle__torch_write(PyObject *self, PyObject *args)
 {
@@ -1110,6 +1523,11 @@ static PyMethodDef torchMethods[] = {
     EXPORT_PYTHON_METHOD(torch_read),
     EXPORT_PYTHON_METHOD(torch_write),
     EXPORT_PYTHON_METHOD(torch_batch_read),
+    EXPORT_PYTHON_METHOD(torch_batch_read_packed),
+    EXPORT_PYTHON_METHOD(torch_prefetch_create),
+    EXPORT_PYTHON_METHOD(torch_prefetch_destroy),
+    EXPORT_PYTHON_METHOD(torch_prefetch_submit),
+    EXPORT_PYTHON_METHOD(torch_prefetch_wait),
     EXPORT_PYTHON_METHOD(torch_recommended_dir_split),
     EXPORT_PYTHON_METHOD(torch_list_with_anchor),
     EXPORT_PYTHON_METHOD(torch_get_fsize),
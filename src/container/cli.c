@@ -3223,6 +3223,121 @@ out:
 	return rc;
 }
 
+struct cont_diff_arg {
+	struct dc_cont		*cda_cont;
+	crt_rpc_t		*cda_rpc;
+};
+
+static int
+cont_diff_complete(tse_task_t *task, void *data)
+{
+	struct cont_diff_arg	*arg  = data;
+	daos_cont_diff_t	*args = dc_task_get_args(task);
+	struct cont_diff_out	*out  = crt_reply_get(arg->cda_rpc);
+	int			 rc   = task->dt_result;
+
+	if (rc != 0) {
+		DL_ERROR(rc, DF_UUID ": container diff RPC failed", DP_UUID(arg->cda_cont->dc_uuid));
+		goto out;
+	}
+
+	rc = out->cdo_rc;
+	if (rc != 0) {
+		DL_ERROR(rc, DF_UUID ": container diff failed", DP_UUID(arg->cda_cont->dc_uuid));
+		goto out;
+	}
+
+	if (out->cdo_ents.ca_count > *args->nr) {
+		D_ERROR(DF_UUID ": %zu entries returned for %u\n",
+			DP_UUID(arg->cda_cont->dc_uuid), out->cdo_ents.ca_count, *args->nr);
+		D_GOTO(out, rc = -DER_PROTO);
+	}
+
+	memcpy(args->entries, out->cdo_ents.ca_arrays,
+	       out->cdo_ents.ca_count * sizeof(*args->entries));
+	*args->nr     = out->cdo_ents.ca_count;
+	*args->anchor = out->cdo_anchor;
+out:
+	crt_req_decref(arg->cda_rpc);
+	dc_cont_put(arg->cda_cont);
+	return rc;
+}
+
+int
+dc_cont_diff(tse_task_t *task)
+{
+	daos_cont_diff_t	*args;
+	struct cont_diff_arg	 arg  = {0};
+	struct dc_pool		*pool = NULL;
+	struct pool_target	*tgt;
+	struct cont_diff_in	*in;
+	crt_endpoint_t		 ep;
+	crt_opcode_t		 opc;
+	int			 rc;
+
+	args = dc_task_get_args(task);
+	D_ASSERTF(args != NULL, "Task Argument OPC does not match DC OPC\n");
+
+	arg.cda_cont = dc_hdl2cont(args->coh);
+	if (arg.cda_cont == NULL)
+		D_GOTO(out, rc = -DER_NO_HDL);
+	pool = dc_hdl2pool(arg.cda_cont->dc_pool_hdl);
+	D_ASSERT(pool != NULL);
+
+	/* the objects are listed by the target itself, not by the container service */
+	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+	if (args->tgt >= pool_map_target_nr(pool->dp_map)) {
+		D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+		D_GOTO(out, rc = -DER_NONEXIST);
+	}
+	tgt = &pool_map_targets(pool->dp_map)[args->tgt];
+	if (pool_target_unavail(tgt, false)) {
+		D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+		D_GOTO(out, rc = -DER_UNREACH);
+	}
+	ep.ep_grp  = pool->dp_sys->sy_group;
+	ep.ep_rank = tgt->ta_comp.co_rank;
+	ep.ep_tag  = daos_rpc_tag(DAOS_REQ_IO, tgt->ta_comp.co_index);
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+
+	opc = DAOS_RPC_OPCODE(CONT_DIFF, DAOS_CONT_MODULE, dc_cont_proto_version);
+	rc  = crt_req_create(daos_task2ctx(task), &ep, opc, &arg.cda_rpc);
+	if (rc != 0) {
+		DL_ERROR(rc, "failed to create rpc");
+		goto out;
+	}
+
+	in = crt_req_get(arg.cda_rpc);
+	uuid_copy(in->cdi_pool_uuid, pool->dp_pool);
+	uuid_copy(in->cdi_co_uuid, arg.cda_cont->dc_uuid);
+	uuid_copy(in->cdi_co_hdl, arg.cda_cont->dc_cont_hdl);
+	in->cdi_epr    = args->epr;
+	in->cdi_anchor = *args->anchor;
+	in->cdi_nr     = min(*args->nr, CONT_DIFF_NR_MAX);
+
+	D_DEBUG(DB_MD, DF_CONT ": diff " DF_X64 "-" DF_X64 " on target %u\n",
+		DP_CONT(pool->dp_pool, arg.cda_cont->dc_uuid), args->epr.epr_lo,
+		args->epr.epr_hi, args->tgt);
+
+	crt_req_addref(arg.cda_rpc);
+	rc = tse_task_register_comp_cb(task, cont_diff_complete, &arg, sizeof(arg));
+	if (rc != 0) {
+		crt_req_decref(arg.cda_rpc);
+		crt_req_decref(arg.cda_rpc);
+		goto out;
+	}
+
+	dc_pool_put(pool);
+	return daos_rpc_send(arg.cda_rpc, task);
+out:
+	if (pool != NULL)
+		dc_pool_put(pool);
+	if (arg.cda_cont != NULL)
+		dc_cont_put(arg.cda_cont);
+	tse_task_complete(task, rc);
+	return rc;
+}
+
 int
 dc_cont_destroy_snap(tse_task_t *task)
 {
@@ -67,6 +67,31 @@ crt_proc_daos_obj_id_t(crt_proc_t proc, crt_proc_op_t proc_op,
 	return 0;
 }
 
+static int
+crt_proc_daos_cont_diff_entry_t(crt_proc_t proc, crt_proc_op_t proc_op,
+				daos_cont_diff_entry_t *ent)
+{
+	int rc;
+
+	rc = crt_proc_daos_obj_id_t(proc, proc_op, &ent->de_oid);
+	if (rc != 0)
+		return rc;
+
+	rc = crt_proc_uint64_t(proc, proc_op, &ent->de_epoch);
+	if (rc != 0)
+		return -DER_HG;
+
+	rc = crt_proc_uint32_t(proc, proc_op, &ent->de_flags);
+	if (rc != 0)
+		return -DER_HG;
+
+	rc = crt_proc_uint32_t(proc, proc_op, &ent->de_pad);
+	if (rc != 0)
+		return -DER_HG;
+
+	return 0;
+}
+
 CRT_RPC_DEFINE(cont_op, DAOS_ISEQ_CONT_OP, DAOS_OSEQ_CONT_OP)
 CRT_RPC_DEFINE(cont_op_v8, DAOS_ISEQ_CONT_OP_V8, DAOS_OSEQ_CONT_OP)
 CRT_RPC_DEFINE(cont_op_v9, DAOS_ISEQ_CONT_OP_V9, DAOS_OSEQ_CONT_OP)
@@ -148,6 +173,7 @@ CRT_RPC_DEFINE(cont_acl_update_v8, DAOS_ISEQ_CONT_ACL_UPDATE_V8, DAOS_OSEQ_CONT_
 CRT_RPC_DEFINE(cont_acl_update_v9, DAOS_ISEQ_CONT_ACL_UPDATE_V9, DAOS_OSEQ_CONT_ACL_UPDATE)
 CRT_RPC_DEFINE(cont_acl_delete_v8, DAOS_ISEQ_CONT_ACL_DELETE_V8, DAOS_OSEQ_CONT_ACL_DELETE)
 CRT_RPC_DEFINE(cont_acl_delete_v9, DAOS_ISEQ_CONT_ACL_DELETE_V9, DAOS_OSEQ_CONT_ACL_DELETE)
+CRT_RPC_DEFINE(cont_diff, DAOS_ISEQ_CONT_DIFF, DAOS_OSEQ_CONT_DIFF)
 
 /* Define for cont_rpcs[] array population below.
  * See CONT_PROTO_*_RPC_LIST macro definition
@@ -18,6 +18,7 @@
 #include <uuid/uuid.h>
 #include <daos/rpc.h>
 #include <daos/rsvc.h>
+#include <daos_cont.h>
 
 /*
  * RPC operation codes
@@ -83,7 +84,8 @@
 	X(CONT_SNAP_OIT_CREATE, 0, ver >= 9 ? &CQF_cont_epoch_op_v9 : &CQF_cont_epoch_op_v8,       \
 	  ds_cont_op_handler, NULL)                                                                \
 	X(CONT_SNAP_OIT_DESTROY, 0, ver >= 9 ? &CQF_cont_epoch_op_v9 : &CQF_cont_epoch_op_v8,      \
-	  ds_cont_op_handler, NULL)
+	  ds_cont_op_handler, NULL)                                                                \
+	X(CONT_DIFF, 0, &CQF_cont_diff, ds_cont_diff_handler, NULL)
 
 #define CONT_PROTO_SRV_RPC_LIST                                                                    \
 	X(CONT_TGT_DESTROY, 0, &CQF_cont_tgt_destroy, ds_cont_tgt_destroy_handler,                 \
@@ -970,6 +972,27 @@ CRT_RPC_DECLARE(cont_prop_set_v9, DAOS_ISEQ_CONT_PROP_SET_V9, DAOS_OSEQ_CONT_PRO
 
 CRT_RPC_DECLARE(cont_prop_set_bylabel, DAOS_ISEQ_CONT_PROP_SET_BYLABEL, DAOS_OSEQ_CONT_PROP_SET)
 
+/** Maximum number of objects returned by a CONT_DIFF RPC */
+#define CONT_DIFF_NR_MAX	512
+
+/** Sent by the client to the target to list the objects it modified in an epoch range */
+#define DAOS_ISEQ_CONT_DIFF	/* input fields */		 \
+	((uuid_t)		(cdi_pool_uuid)		CRT_VAR) \
+	((uuid_t)		(cdi_co_uuid)		CRT_VAR) \
+	((uuid_t)		(cdi_co_hdl)		CRT_VAR) \
+	((daos_epoch_range_t)	(cdi_epr)		CRT_VAR) \
+	((daos_anchor_t)	(cdi_anchor)		CRT_RAW) \
+	((uint32_t)		(cdi_nr)		CRT_VAR) \
+	((uint32_t)		(cdi_flags)		CRT_VAR)
+
+#define DAOS_OSEQ_CONT_DIFF	/* output fields */		 \
+	((daos_cont_diff_entry_t) (cdo_ents)		CRT_ARRAY) \
+	((daos_anchor_t)	(cdo_anchor)		CRT_RAW) \
+	((int32_t)		(cdo_rc)		CRT_VAR) \
+	((uint32_t)		(cdo_pad32)		CRT_VAR)
+
+CRT_RPC_DECLARE(cont_diff, DAOS_ISEQ_CONT_DIFF, DAOS_OSEQ_CONT_DIFF)
+
 /* clang-format on */
 
 static inline void
@@ -0,0 +1,318 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * ds_cont: Container Diff
+ *
+ * List the objects of a target modified in an epoch range, for incremental
+ * backups. Nothing is scanned in the objects whose last update, kept by VOS,
+ * is in the range or before it, only the objects updated again after the end
+ * of the range have their keys and values searched for an update in the range.
+ * Objects can be reported while not modified, such as an object punched before
+ * the range and created again after it, but a modified one is never missed.
+ *
+ * Each object is reported by one shard of each of its redundancy groups, the
+ * first replica or the last parity shard which is healthy, so that the objects
+ * of a group whose first replica is down are still reported.
+ */
+#define D_LOGFAC	DD_FAC(container)
+
+#include <daos/object.h>
+#include <daos/placement.h>
+#include <daos_srv/container.h>
+#include <daos_srv/daos_engine.h>
+#include <daos_srv/security.h>
+#include <daos_srv/vos.h>
+#include "rpc.h"
+#include "srv_internal.h"
+
+struct cont_diff_scan {
+	struct ds_cont_child	*cds_cont;
+	daos_epoch_range_t	 cds_epr;
+	daos_cont_diff_entry_t	*cds_ents;
+	/* shard of each entry */
+	daos_unit_oid_t		*cds_oids;
+	uint32_t		 cds_nr;
+	uint32_t		 cds_max;
+};
+
+/*
+ * Check whether the shard \a oid reports its object: the first replica, or the
+ * last parity shard for EC objects, on a healthy target of the group. Return 1
+ * if it does, 0 if not, negative DER on failure.
+ */
+static int
+cont_diff_reporter(struct ds_cont_child *cont, daos_unit_oid_t oid)
+{
+	struct ds_pool		*pool = cont->sc_pool->spc_pool;
+	struct daos_obj_md	 md = {0};
+	struct pl_obj_layout	*layout = NULL;
+	struct daos_oclass_attr	*oca;
+	struct pl_obj_shard	*shard;
+	struct pool_target	*target;
+	struct pl_map		*map;
+	uint32_t		 grp_size;
+	uint32_t		 start;
+	uint32_t		 i;
+	bool			 is_ec;
+	int			 rc;
+
+	oca = daos_oclass_attr_find(oid.id_pub, NULL);
+	if (oca == NULL)
+		return 0;
+
+	grp_size = daos_oclass_grp_size(oca);
+	if (grp_size == 1)
+		return 1;
+	is_ec = daos_oclass_is_ec(oca);
+
+	map = pl_map_find(pool->sp_uuid, oid.id_pub);
+	if (map == NULL) {
+		D_ERROR("Failed to find pool map to check reporter of "DF_UOID"\n",
+			DP_UOID(oid));
+		return -DER_INVAL;
+	}
+
+	md.omd_id       = oid.id_pub;
+	md.omd_grp_spec = oid.id_shard / grp_size;
+	md.omd_flags    = PL_FL_GRP_SPEC;
+	md.omd_ver      = pool->sp_map_version;
+	md.omd_fdom_lvl = cont->sc_props.dcp_redun_lvl;
+	md.omd_pdom_lvl = cont->sc_props.dcp_perf_domain;
+	md.omd_pda      = is_ec ? cont->sc_props.dcp_ec_pda : cont->sc_props.dcp_rp_pda;
+	rc = pl_obj_place(map, oid.id_layout_ver, &md, DAOS_OO_RO, NULL, &layout);
+	if (rc != 0) {
+		DL_ERROR(rc, "Failed to load layout of "DF_UOID, DP_UOID(oid));
+		goto out;
+	}
+
+	/* replicas are searched from the first one, EC shards from the last parity */
+	rc    = -DER_NONEXIST;
+	start = md.omd_grp_spec * grp_size;
+	for (i = 0; i < grp_size; i++) {
+		shard = &layout->ol_shards[start + (is_ec ? grp_size - 1 - i : i)];
+		if (shard->po_target == -1 || shard->po_shard == -1 || shard->po_rebuilding)
+			continue;
+
+		rc = pool_map_find_target(map->pl_poolmap, shard->po_target, &target);
+		D_ASSERT(rc == 1);
+		if (target->ta_comp.co_status != PO_COMP_ST_UPIN) {
+			rc = -DER_NONEXIST;
+			continue;
+		}
+
+		rc = dss_self_rank() == target->ta_comp.co_rank &&
+		     dss_get_module_info()->dmi_tgt_id == target->ta_comp.co_index;
+		break;
+	}
+	if (rc < 0)
+		DL_ERROR(rc, DF_UOID" has no healthy shard to report it", DP_UOID(oid));
+out:
+	if (layout != NULL)
+		pl_obj_layout_free(layout);
+	pl_map_decref(map);
+	return rc;
+}
+
+static int
+cont_diff_filter_cb(daos_handle_t ih, vos_iter_desc_t *desc, void *cb_arg, unsigned int *acts)
+{
+	struct cont_diff_scan	*scan = cb_arg;
+	int			 rc;
+
+	/* the last write is conservative, the ilog of the object is not even loaded */
+	if (desc->id_agg_write <= scan->cds_epr.epr_lo) {
+		*acts |= VOS_ITER_CB_SKIP;
+		return 0;
+	}
+
+	rc = cont_diff_reporter(scan->cds_cont, desc->id_oid);
+	if (rc < 0)
+		return rc;
+	if (rc == 0)
+		*acts |= VOS_ITER_CB_SKIP;
+
+	return 0;
+}
+
+static int
+cont_diff_obj_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
+		 vos_iter_param_t *param, void *cb_arg, unsigned int *acts)
+{
+	struct cont_diff_scan	*scan = cb_arg;
+	daos_cont_diff_entry_t	*ent;
+
+	if (entry->ie_last_update <= scan->cds_epr.epr_lo)
+		return 0;
+
+	/* the anchor is left on this object, it is the first one of the next call */
+	if (scan->cds_nr == scan->cds_max) {
+		*acts |= VOS_ITER_CB_EXIT;
+		return 0;
+	}
+
+	scan->cds_oids[scan->cds_nr] = entry->ie_oid;
+	ent                          = &scan->cds_ents[scan->cds_nr++];
+	ent->de_oid   = entry->ie_oid.id_pub;
+	ent->de_epoch = entry->ie_last_update;
+	ent->de_flags = 0;
+	ent->de_pad   = 0;
+	if (entry->ie_vis_flags & VOS_VIS_FLAG_COVERED)
+		ent->de_flags |= DAOS_CONT_DIFF_PUNCHED;
+
+	return 0;
+}
+
+static int
+cont_diff_key_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
+		 vos_iter_param_t *param, void *cb_arg, unsigned int *acts)
+{
+	bool *modified = cb_arg;
+
+	switch (type) {
+	case VOS_ITER_DKEY:
+	case VOS_ITER_AKEY:
+		if (entry->ie_punch < param->ip_epr.epr_lo ||
+		    entry->ie_punch > param->ip_epr.epr_hi)
+			return 0;
+		break;
+	case VOS_ITER_SINGLE:
+	case VOS_ITER_RECX:
+		break;
+	default:
+		return 0;
+	}
+
+	*modified = true;
+	*acts |= VOS_ITER_CB_EXIT;
+	return 0;
+}
+
+/* Search the keys and values of an object updated after the range for one in the range */
+static int
+cont_diff_obj_check(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_range_t *epr,
+		    bool *modified)
+{
+	struct vos_iter_anchors	anchors = {0};
+	vos_iter_param_t	param   = {0};
+	int			rc;
+
+	param.ip_hdl        = coh;
+	param.ip_ih         = DAOS_HDL_INVAL;
+	param.ip_oid        = oid;
+	param.ip_epr.epr_lo = epr->epr_lo + 1;
+	param.ip_epr.epr_hi = epr->epr_hi;
+	param.ip_epc_expr   = VOS_IT_EPC_RE;
+	param.ip_flags      = VOS_IT_PUNCHED;
+
+	*modified = false;
+	rc = vos_iterate(&param, VOS_ITER_DKEY, true, &anchors, cont_diff_key_cb, NULL, modified,
+			 NULL);
+	return rc < 0 ? rc : 0;
+}
+
+static int
+cont_diff_scan(struct ds_cont_child *cont, struct cont_diff_in *in, daos_anchor_t *anchor,
+	       struct cont_diff_scan *scan)
+{
+	struct vos_iter_anchors	anchors = {0};
+	vos_iter_param_t	param   = {0};
+	daos_cont_diff_entry_t	*ent;
+	bool			modified;
+	uint32_t		nr;
+	uint32_t		i;
+	int			rc;
+
+	param.ip_hdl        = cont->sc_hdl;
+	param.ip_ih         = DAOS_HDL_INVAL;
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = in->cdi_epr.epr_hi;
+	param.ip_epc_expr   = VOS_IT_EPC_RR;
+	param.ip_flags      = VOS_IT_PUNCHED;
+	param.ip_filter_cb  = cont_diff_filter_cb;
+	param.ip_filter_arg = scan;
+
+	anchors.ia_obj = in->cdi_anchor;
+	rc = vos_iterate(&param, VOS_ITER_OBJ, false, &anchors, cont_diff_obj_cb, NULL, scan,
+			 NULL);
+	if (rc < 0)
+		return rc;
+	*anchor = anchors.ia_obj;
+
+	/* the objects still alive and updated again after the range are searched */
+	nr = 0;
+	for (i = 0; i < scan->cds_nr; i++) {
+		ent = &scan->cds_ents[i];
+		if (ent->de_epoch > in->cdi_epr.epr_hi &&
+		    (ent->de_flags & DAOS_CONT_DIFF_PUNCHED) == 0) {
+			rc = cont_diff_obj_check(cont->sc_hdl, scan->cds_oids[i], &in->cdi_epr,
+						 &modified);
+			if (rc != 0)
+				return rc;
+			if (!modified)
+				continue;
+		}
+		scan->cds_ents[nr++] = *ent;
+	}
+	scan->cds_nr = nr;
+
+	return 0;
+}
+
+void
+ds_cont_diff_handler(crt_rpc_t *rpc)
+{
+	struct cont_diff_in	*in   = crt_req_get(rpc);
+	struct cont_diff_out	*out  = crt_reply_get(rpc);
+	struct ds_cont_hdl	*hdl  = NULL;
+	struct cont_diff_scan	 scan = {0};
+	int			 rc;
+
+	D_DEBUG(DB_MD, DF_CONT ": diff " DF_X64 "-" DF_X64 ", nr %u\n",
+		DP_CONT(in->cdi_pool_uuid, in->cdi_co_uuid), in->cdi_epr.epr_lo,
+		in->cdi_epr.epr_hi, in->cdi_nr);
+
+	if (in->cdi_epr.epr_lo >= in->cdi_epr.epr_hi || in->cdi_nr == 0 ||
+	    in->cdi_nr > CONT_DIFF_NR_MAX)
+		D_GOTO(out, rc = -DER_INVAL);
+
+	/* the handle may not have been propagated to this target yet */
+	rc = ds_cont_find_hdl(in->cdi_pool_uuid, in->cdi_co_hdl, &hdl);
+	if (rc != 0)
+		D_GOTO(out, rc = (rc == -DER_NONEXIST ? -DER_NO_HDL : rc));
+	if (hdl->sch_cont == NULL ||
+	    uuid_compare(hdl->sch_cont->sc_uuid, in->cdi_co_uuid) != 0 ||
+	    uuid_compare(hdl->sch_cont->sc_pool_uuid, in->cdi_pool_uuid) != 0)
+		D_GOTO(out, rc = -DER_NO_HDL);
+
+	if (!ds_sec_cont_can_read_data(hdl->sch_sec_capas))
+		D_GOTO(out, rc = -DER_NO_PERM);
+
+	D_ALLOC_ARRAY(scan.cds_ents, in->cdi_nr);
+	D_ALLOC_ARRAY(scan.cds_oids, in->cdi_nr);
+	if (scan.cds_ents == NULL || scan.cds_oids == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	scan.cds_cont = hdl->sch_cont;
+	scan.cds_epr  = in->cdi_epr;
+	scan.cds_max = in->cdi_nr;
+
+	rc = cont_diff_scan(hdl->sch_cont, in, &out->cdo_anchor, &scan);
+	if (rc == 0) {
+		out->cdo_ents.ca_arrays = scan.cds_ents;
+		out->cdo_ents.ca_count  = scan.cds_nr;
+	}
+out:
+	if (rc != 0)
+		DL_CDEBUG(rc == -DER_INPROGRESS, DB_MD, DLOG_ERR, rc, DF_CONT ": diff failed",
+			  DP_CONT(in->cdi_pool_uuid, in->cdi_co_uuid));
+	if (hdl != NULL)
+		ds_cont_hdl_put(hdl);
+	out->cdo_rc = rc;
+	rc          = crt_reply_send(rpc);
+	if (rc != 0)
+		DL_ERROR(rc, "send reply failed");
+	D_FREE(scan.cds_ents);
+	D_FREE(scan.cds_oids);
+}
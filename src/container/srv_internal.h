@@ -280,6 +280,9 @@ int ds_cont_tgt_refresh_track_eph(uuid_t pool_uuid, uuid_t cont_uuid,
 				  daos_epoch_t ec_agg_eph, daos_epoch_t stable_eph);
 int ds_cont_tgt_prop_update(uuid_t pool_uuid, uuid_t cont_uuid, daos_prop_t *prop);
 
+/* srv_diff.c */
+void ds_cont_diff_handler(crt_rpc_t *rpc);
+
 /* oid_iv.c */
 int ds_oid_iv_init(void);
 int ds_oid_iv_fini(void);
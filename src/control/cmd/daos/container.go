@@ -63,6 +63,7 @@ type containerCmd struct {
 	DestroySnapshot containerSnapDestroyCmd      `command:"destroy-snap" description:"destroy container snapshot"`
 	ListSnapshots   containerSnapListCmd         `command:"list-snap" alias:"list-snaps" description:"list container snapshots"`
 	Rollback        containerSnapshotRollbackCmd `command:"rollback" description:"roll back container to specified snapshot"`
+	Diff            containerSnapDiffCmd         `command:"diff" description:"list objects modified between two container snapshots"`
 }
 
 type containerBaseCmd struct {
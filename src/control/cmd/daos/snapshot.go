@@ -1,6 +1,7 @@
 //
 // (C) Copyright 2021-2024 Intel Corporation.
 // (C) Copyright 2025 Google LLC
+// (C) Copyright 2026 Hewlett Packard Enterprise Development LP
 //
 // SPDX-License-Identifier: BSD-2-Clause-Patent
 //
@@ -11,6 +12,7 @@ import (
 	"fmt"
 	"io"
 	"strings"
+	"sync"
 	"unsafe"
 
 	"github.com/pkg/errors"
@@ -318,3 +320,136 @@ func (cmd *containerSnapshotRollbackCmd) Execute(args []string) error {
 
 	return nil
 }
+
+type containerSnapDiffCmd struct {
+	existingContainerCmd
+
+	FromEpoch EpochFlag `long:"from-epc" description:"epoch of the previous backup (excluded)"`
+	FromName  string    `long:"from-snap" description:"snapshot name of the previous backup (excluded)"`
+	ToEpoch   EpochFlag `long:"to-epc" description:"epoch of the new backup"`
+	ToName    string    `long:"to-snap" description:"snapshot name of the new backup"`
+	Parallel  uint32    `long:"parallel" default:"16" description:"number of targets scanned in parallel"`
+}
+
+type diffObject struct {
+	OID     string `json:"oid"`
+	Epoch   uint64 `json:"epoch"`
+	Punched bool   `json:"punched"`
+}
+
+func resolveSnapEpoch(ap *C.struct_cmd_args_s, containerID string, epoch EpochFlag, name, which string) (C.uint64_t, error) {
+	switch {
+	case epoch.Set && name != "":
+		return 0, errors.Errorf("cannot specify both %s snapshot epoch and name", which)
+	case epoch.Set:
+		return C.uint64_t(epoch.Value), nil
+	case name != "":
+		return resolveSnapName(ap, containerID, name)
+	default:
+		return 0, errors.Errorf("must specify one of %s snapshot name or epoch", which)
+	}
+}
+
+// diffTarget lists the objects reported by one target of the pool.
+func diffTarget(cont C.daos_handle_t, epr *C.daos_epoch_range_t, tgt uint32) ([]*diffObject, error) {
+	var objs []*diffObject
+	var nr C.uint32_t
+	ents := [C.OID_ARR_SIZE]C.daos_cont_diff_entry_t{}
+	anchor := C.daos_anchor_t{}
+
+	for !C.daos_anchor_is_eof(&anchor) {
+		nr = C.OID_ARR_SIZE
+		rc := C.daos_cont_diff(cont, epr, C.uint32_t(tgt), &anchor, &nr, &ents[0], nil)
+		if err := daosError(rc); err != nil {
+			return nil, errors.Wrapf(err, "target %d", tgt)
+		}
+
+		for i := C.uint32_t(0); i < nr; i++ {
+			objs = append(objs, &diffObject{
+				OID:     fmt.Sprintf("%d.%d", ents[i].de_oid.hi, ents[i].de_oid.lo),
+				Epoch:   uint64(ents[i].de_epoch),
+				Punched: ents[i].de_flags&C.DAOS_CONT_DIFF_PUNCHED != 0,
+			})
+		}
+	}
+
+	return objs, nil
+}
+
+func (cmd *containerSnapDiffCmd) Execute(args []string) error {
+	ap, deallocCmdArgs, err := allocCmdArgs(cmd.Logger)
+	if err != nil {
+		return err
+	}
+	defer deallocCmdArgs()
+
+	cleanup, err := cmd.resolveAndOpen(C.DAOS_COO_RO, ap)
+	if err != nil {
+		return err
+	}
+	defer cleanup()
+
+	var epr C.daos_epoch_range_t
+	epr.epr_lo, err = resolveSnapEpoch(ap, cmd.ContainerID().String(), cmd.FromEpoch, cmd.FromName, "from")
+	if err != nil {
+		return err
+	}
+	epr.epr_hi, err = resolveSnapEpoch(ap, cmd.ContainerID().String(), cmd.ToEpoch, cmd.ToName, "to")
+	if err != nil {
+		return err
+	}
+	if epr.epr_lo >= epr.epr_hi {
+		return errors.New("from snapshot must be older than to snapshot")
+	}
+
+	poolInfo, err := cmd.pool.Query(cmd.MustLogCtx(), daos.HealthOnlyPoolQueryMask)
+	if err != nil {
+		return errors.Wrapf(err, "failed to query pool %s", cmd.PoolID())
+	}
+
+	if cmd.Parallel == 0 {
+		return errors.New("--parallel must be at least 1")
+	}
+
+	// Up to Parallel targets are scanned at once, each object is reported by one of them.
+	tgtObjs := make([][]*diffObject, poolInfo.TotalTargets)
+	tgtErrs := make([]error, poolInfo.TotalTargets)
+	tgts := make(chan uint32)
+	var wg sync.WaitGroup
+	for i := uint32(0); i < cmd.Parallel && i < poolInfo.TotalTargets; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for tgt := range tgts {
+				tgtObjs[tgt], tgtErrs[tgt] = diffTarget(ap.cont, &epr, tgt)
+			}
+		}()
+	}
+	for tgt := uint32(0); tgt < poolInfo.TotalTargets; tgt++ {
+		tgts <- tgt
+	}
+	close(tgts)
+	wg.Wait()
+
+	var objs []*diffObject
+	for tgt := range tgtObjs {
+		if tgtErrs[tgt] != nil {
+			return errors.Wrapf(tgtErrs[tgt], "failed to diff container %s", cmd.ContainerID())
+		}
+		objs = append(objs, tgtObjs[tgt]...)
+	}
+
+	if cmd.JSONOutputEnabled() {
+		return cmd.OutputJSON(objs, nil)
+	}
+
+	for _, obj := range objs {
+		if obj.Punched {
+			cmd.Infof("%s punched", obj.OID)
+			continue
+		}
+		cmd.Infof("%s", obj.OID)
+	}
+
+	return nil
+}
@@ -0,0 +1,133 @@
+//
+// (C) Copyright 2024 Intel Corporation.
+//
+// SPDX-License-Identifier: BSD-2-Clause-Patent
+//
+//go:build linux && (amd64 || arm64)
+// +build linux
+// +build amd64 arm64
+
+//
+
+package telemetry
+
+/*
+#cgo LDFLAGS: -lgurt
+
+#include "gurt/telemetry_common.h"
+#include "gurt/telemetry_consumer.h"
+*/
+import "C"
+
+import (
+	"context"
+	"fmt"
+)
+
+var _ Metric = (*LogHistogram)(nil)
+
+// LogHistogramPercentiles are the percentiles reported for log histograms.
+var LogHistogramPercentiles = []float64{50, 90, 99, 99.9}
+
+// LogHistogram is a log-linear histogram of the recorded values, with a
+// relative error of 1/16 on its percentiles.
+type LogHistogram struct {
+	metricBase
+	hist C.struct_d_tm_loghist_t
+}
+
+// Type returns the type of the log histogram.
+func (h *LogHistogram) Type() MetricType {
+	return MetricTypeLogHist
+}
+
+// FloatValue returns the median of the recorded values as a float.
+func (h *LogHistogram) FloatValue() float64 {
+	return float64(h.Value())
+}
+
+// Value reads the histogram and returns the median of the recorded values.
+func (h *LogHistogram) Value() uint64 {
+	if h.handle == nil || h.node == nil {
+		return BadUintVal
+	}
+
+	fetch := func() C.int {
+		return C.d_tm_get_loghist(h.handle.ctx, &h.hist, h.node)
+	}
+	if h.fetchValWithRetry(fetch) != C.DER_SUCCESS {
+		return BadUintVal
+	}
+
+	return h.Percentile(50)
+}
+
+// Percentile returns an estimate of the percentile (0-100) of the values
+// recorded when the histogram was last read.
+func (h *LogHistogram) Percentile(percentile float64) uint64 {
+	return uint64(C.d_tm_loghist_percentile(&h.hist, C.double(percentile)))
+}
+
+// Min returns the smallest recorded value.
+func (h *LogHistogram) Min() uint64 {
+	return uint64(h.hist.dtl_min)
+}
+
+// Max returns the largest recorded value.
+func (h *LogHistogram) Max() uint64 {
+	return uint64(h.hist.dtl_max)
+}
+
+// Sum returns the sum of the recorded values.
+func (h *LogHistogram) Sum() uint64 {
+	return uint64(h.hist.dtl_sum)
+}
+
+// Mean returns the mean of the recorded values.
+func (h *LogHistogram) Mean() float64 {
+	if h.hist.dtl_count == 0 {
+		return 0
+	}
+	return float64(h.hist.dtl_sum) / float64(h.hist.dtl_count)
+}
+
+// SampleSize returns the number of recorded values.
+func (h *LogHistogram) SampleSize() uint64 {
+	return uint64(h.hist.dtl_count)
+}
+
+func newLogHistogram(hdl *handle, path string, name *string, node *C.struct_d_tm_node_t) *LogHistogram {
+	h := &LogHistogram{
+		metricBase: metricBase{
+			handle: hdl,
+			path:   path,
+			name:   name,
+			node:   node,
+		},
+	}
+
+	// Load up the histogram
+	_ = h.Value()
+
+	return h
+}
+
+// GetLogHistogram finds the log histogram with the requested name in the telemetry tree.
+func GetLogHistogram(ctx context.Context, name string) (*LogHistogram, error) {
+	hdl, err := getHandle(ctx)
+	if err != nil {
+		return nil, err
+	}
+
+	node, err := findNode(hdl, name)
+	if err != nil {
+		return nil, err
+	}
+
+	if node.dtn_type != C.D_TM_LOG_HISTOGRAM {
+		return nil, fmt.Errorf("metric %q is not a log histogram", name)
+	}
+
+	n, p := splitFullName(name)
+	return newLogHistogram(hdl, p, &n, node), nil
+}
@@ -0,0 +1,101 @@
+//
+// (C) Copyright 2024 Intel Corporation.
+//
+// SPDX-License-Identifier: BSD-2-Clause-Patent
+//
+//go:build linux && (amd64 || arm64)
+// +build linux
+// +build amd64 arm64
+
+//
+
+package telemetry
+
+import (
+	"context"
+	"testing"
+
+	"github.com/pkg/errors"
+
+	"github.com/daos-stack/daos/src/control/common/test"
+)
+
+func TestTelemetry_GetLogHistogram(t *testing.T) {
+	testCtx, testMetrics := setupTestMetrics(t)
+	defer cleanupTestMetrics(testCtx, t)
+
+	realHist := &TestMetric{
+		Type:  MetricTypeLogHist,
+		Name:  "test_loghist",
+		path:  "test",
+		desc:  "some log histogram",
+		units: "us",
+	}
+	for i := uint64(1); i <= 1000; i++ {
+		realHist.Values = append(realHist.Values, i)
+	}
+	AddTestMetric(t, realHist)
+	histName := realHist.FullPath()
+
+	for name, tc := range map[string]struct {
+		ctx        context.Context
+		metricName string
+		expResult  *TestMetric
+		expErr     error
+	}{
+		"non-handle ctx": {
+			ctx:        test.Context(t),
+			metricName: histName,
+			expErr:     errors.New("no handle"),
+		},
+		"bad name": {
+			ctx:        testCtx,
+			metricName: "not_a_real_metric",
+			expErr:     errors.New("unable to find metric"),
+		},
+		"bad type": {
+			ctx:        testCtx,
+			metricName: testMetrics[MetricTypeCounter].FullPath(),
+			expErr:     errors.New("not a log histogram"),
+		},
+		"success": {
+			ctx:        testCtx,
+			metricName: histName,
+			expResult:  realHist,
+		},
+	} {
+		t.Run(name, func(t *testing.T) {
+			result, err := GetLogHistogram(tc.ctx, tc.metricName)
+
+			test.CmpErr(t, tc.expErr, err)
+
+			if tc.expResult != nil {
+				if result == nil {
+					t.Fatalf("expected non-nil result matching %+v", tc.expResult)
+				}
+
+				test.AssertEqual(t, tc.expResult.Name, result.Name(), "Name() failed")
+				test.AssertEqual(t, tc.expResult.FullPath(), result.FullPath(), "FullPath() failed")
+				test.AssertEqual(t, result.Type(), MetricTypeLogHist, "bad type")
+				test.AssertEqual(t, uint64(1000), result.SampleSize(), "SampleSize() failed")
+				test.AssertEqual(t, uint64(1), result.Min(), "Min() failed")
+				test.AssertEqual(t, uint64(1000), result.Max(), "Max() failed")
+				test.AssertEqual(t, uint64(500500), result.Sum(), "Sum() failed")
+				test.AssertEqual(t, 500.5, result.Mean(), "Mean() failed")
+
+				// Percentiles are the upper bound of their bucket, within 1/16 of the value
+				for _, p := range LogHistogramPercentiles {
+					exp := p * 10
+					got := float64(result.Percentile(p))
+					if got < exp || got > exp*17/16 {
+						t.Fatalf("p%v: expected %v within 1/16, got %v", p, exp, got)
+					}
+				}
+				test.AssertEqual(t, result.FloatValue(), float64(result.Percentile(50)),
+					"bad float value")
+			} else if result != nil {
+				t.Fatalf("expected nil result, got %+v", result)
+			}
+		})
+	}
+}
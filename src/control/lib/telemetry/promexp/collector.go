@@ -76,7 +76,8 @@ func (c *metricsCollector) Collect(ch chan<- prometheus.Metric) {
 		case telemetry.MetricTypeGauge, telemetry.MetricTypeTimestamp,
 			telemetry.MetricTypeSnapshot:
 			err = sm.gvm.set(sm.baseName, sm.metric.FloatValue(), sm.labels)
-		case telemetry.MetricTypeStatsGauge, telemetry.MetricTypeDuration:
+		case telemetry.MetricTypeStatsGauge, telemetry.MetricTypeDuration,
+			telemetry.MetricTypeLogHist:
 			if telemetry.HasBuckets(sm.metric) {
 				sample, err := telemetry.SampleHistogram(sm.metric)
 				if err != nil {
@@ -136,7 +136,8 @@ func newSourceMetric(log logging.Logger, m telemetry.Metric, baseName string, la
 	case telemetry.MetricTypeGauge, telemetry.MetricTypeTimestamp,
 		telemetry.MetricTypeSnapshot:
 		sm.gvm.add(sm.baseName, desc, sm.labels)
-	case telemetry.MetricTypeStatsGauge, telemetry.MetricTypeDuration:
+	case telemetry.MetricTypeStatsGauge, telemetry.MetricTypeDuration,
+		telemetry.MetricTypeLogHist:
 		if telemetry.HasBuckets(sm.metric) {
 			buckets, err := telemetry.GetBuckets(sm.metric)
 			if err != nil {
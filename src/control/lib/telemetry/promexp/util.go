@@ -11,6 +11,7 @@ package promexp
 
 import (
 	"sort"
+	"strconv"
 	"strings"
 	"unicode"
 
@@ -139,7 +140,60 @@ type metricStat struct {
 	isCounter bool
 }
 
+func getLogHistStats(baseName string, h *telemetry.LogHistogram) (stats []*metricStat) {
+	for name, s := range map[string]struct {
+		fn        func() float64
+		desc      string
+		isCounter bool
+	}{
+		"min": {
+			fn:   func() float64 { return float64(h.Min()) },
+			desc: " (min value)",
+		},
+		"max": {
+			fn:   func() float64 { return float64(h.Max()) },
+			desc: " (max value)",
+		},
+		"mean": {
+			fn:   h.Mean,
+			desc: " (mean)",
+		},
+		"sum": {
+			fn:        func() float64 { return float64(h.Sum()) },
+			isCounter: true,
+			desc:      " (sum)",
+		},
+		"samples": {
+			fn:        func() float64 { return float64(h.SampleSize()) },
+			desc:      " (samples)",
+			isCounter: true,
+		},
+	} {
+		stats = append(stats, &metricStat{
+			name:      baseName + "_" + name,
+			desc:      h.Desc() + s.desc,
+			value:     s.fn(),
+			isCounter: s.isCounter,
+		})
+	}
+
+	for _, p := range telemetry.LogHistogramPercentiles {
+		pName := strings.ReplaceAll(strconv.FormatFloat(p, 'f', -1, 64), ".", "_")
+		stats = append(stats, &metricStat{
+			name:  baseName + "_p" + pName,
+			desc:  h.Desc() + " (p" + pName + ")",
+			value: float64(h.Percentile(p)),
+		})
+	}
+
+	return
+}
+
 func getMetricStats(baseName string, m telemetry.Metric) (stats []*metricStat) {
+	if h, ok := m.(*telemetry.LogHistogram); ok {
+		return getLogHistStats(baseName, h)
+	}
+
 	ms, ok := m.(telemetry.StatsMetric)
 	if !ok {
 		return []*metricStat{}
@@ -73,6 +73,7 @@ const (
 	MetricTypeTimestamp  MetricType = C.D_TM_TIMESTAMP
 	MetricTypeDirectory  MetricType = C.D_TM_DIRECTORY
 	MetricTypeLink       MetricType = C.D_TM_LINK
+	MetricTypeLogHist    MetricType = C.D_TM_LOG_HISTOGRAM
 
 	ClientJobRootID          = C.DC_TM_JOB_ROOT_ID
 	ClientJobMax             = 1024
@@ -168,6 +169,8 @@ func (mt MetricType) String() string {
 		return strFmt("gauge (stats)")
 	case MetricTypeLink:
 		return strFmt("link")
+	case MetricTypeLogHist:
+		return strFmt("log histogram")
 	default:
 		return strFmt("unknown")
 	}
@@ -525,6 +528,8 @@ func (s *Schema) Add(hdl *handle, id string, typ C.int, node *C.struct_d_tm_node
 		m = newCounter(hdl, path, &name, node)
 	case typ == C.D_TM_TIMESTAMP:
 		m = newTimestamp(hdl, path, &name, node)
+	case typ == C.D_TM_LOG_HISTOGRAM:
+		m = newLogHistogram(hdl, path, &name, node)
 	case (typ & C.D_TM_TIMER_SNAPSHOT) != 0:
 		m = newSnapshot(hdl, path, &name, node)
 	case (typ & C.D_TM_DURATION) != 0:
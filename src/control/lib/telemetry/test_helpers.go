@@ -125,6 +125,8 @@ func (tm *TestMetric) GetMetric(ctx context.Context) (Metric, error) {
 		return GetGauge(ctx, tm.FullPath())
 	case MetricTypeStatsGauge:
 		return GetStatsGauge(ctx, tm.FullPath())
+	case MetricTypeLogHist:
+		return GetLogHistogram(ctx, tm.FullPath())
 	default:
 		return nil, errors.Errorf("unsupported metric type %s", tm.Type)
 	}
@@ -199,6 +201,14 @@ func AddTestMetric(t *testing.T, tm *TestMetric) {
 		if rc != 0 {
 			t.Fatalf("failed to add %s: %s", fullName, daos.Status(rc))
 		}
+	case MetricTypeLogHist:
+		rc := C.add_metric(&tm.node, C.D_TM_LOG_HISTOGRAM, C.CString(tm.desc), C.CString(tm.units), C.CString(fullName))
+		if rc != 0 {
+			t.Fatalf("failed to add %s: %s", fullName, daos.Status(rc))
+		}
+		for _, val := range tm.Values {
+			C.d_tm_record_loghist(tm.node, C.uint64_t(val))
+		}
 	case MetricTypeLink:
 		rc := C.add_eph_dir(&tm.node, 1024, C.CString(fullName))
 		if rc != 0 {
@@ -24,6 +24,7 @@ uint32_t dtx_agg_thd_cnt_lo;
 uint32_t dtx_agg_thd_age_up;
 uint32_t dtx_agg_thd_age_lo;
 uint32_t dtx_batched_ult_max;
+bool     dtx_cmt_adaptive;
 
 struct dtx_batched_pool_args {
 	/* Link to dss_module_info::dmi_dtx_batched_pool_list. */
@@ -50,6 +51,15 @@ struct dtx_batched_cont_args {
 	struct dtx_batched_pool_args	*dbca_pool;
 	int                              dbca_refs;
 	uint32_t                         dbca_cleanup_thd;
+	/* Adaptive batched commit: last sample time (us) and committable total. */
+	uint64_t                         dbca_cmt_ts;
+	uint64_t                         dbca_cmt_total;
+	/* The last time (us) that new committable DTXs were seen. */
+	uint64_t                         dbca_cmt_busy_ts;
+	/* New committable DTXs per second, commit RPC cost (us) and max age (second). */
+	uint32_t                         dbca_cmt_rate;
+	uint32_t                         dbca_cmt_cost;
+	uint32_t                         dbca_cmt_age;
 	uint32_t dbca_deregister : 1, dbca_cleanup_done : 1, dbca_commit_done : 1,
 	    dbca_agg_done : 1, dbca_flush_pending : 1;
 };
@@ -622,6 +632,77 @@ dtx_need_batched_commit(struct dtx_batched_cont_args *dbca)
 	return dtx_cont_opened(dbca->dbca_cont) || dbca->dbca_flush_pending;
 }
 
+/* Size the batch of committable DTXs from the samples of their rate, see DTX_CMT_COST_RATIO. */
+static void
+dtx_cmt_adapt(struct dtx_batched_cont_args *dbca)
+{
+	struct ds_cont_child *cont = dbca->dbca_cont;
+	uint64_t              now  = daos_getutime();
+	uint64_t              added;
+	uint64_t              rate;
+	uint64_t              batch;
+
+	if (!dtx_cmt_adaptive)
+		return;
+
+	if (dbca->dbca_cmt_ts == 0) {
+		dbca->dbca_cmt_ts      = now;
+		dbca->dbca_cmt_busy_ts = now;
+		dbca->dbca_cmt_total   = cont->sc_dtx_committable_total;
+		return;
+	}
+
+	if (now - dbca->dbca_cmt_ts < DTX_CMT_SAMPLE_US)
+		return;
+
+	added = cont->sc_dtx_committable_total - dbca->dbca_cmt_total;
+	rate  = added * 1000000 / (now - dbca->dbca_cmt_ts);
+	dbca->dbca_cmt_rate  = (dbca->dbca_cmt_rate * 3 + min(rate, UINT32_MAX)) / 4;
+	dbca->dbca_cmt_ts    = now;
+	dbca->dbca_cmt_total = cont->sc_dtx_committable_total;
+	if (added > 0)
+		dbca->dbca_cmt_busy_ts = now;
+
+	batch = (uint64_t)dbca->dbca_cmt_rate *
+		(dbca->dbca_cmt_cost != 0 ? dbca->dbca_cmt_cost : DTX_CMT_COST_DEF) *
+		DTX_CMT_COST_RATIO / 1000000;
+	batch = max(batch, DTX_CMT_BATCH_MIN);
+	batch = min(batch, DTX_THRESHOLD_COUNT);
+	cont->sc_dtx_cmt_batch = batch;
+
+	/* Waiting for longer than the time to fill the batch does not make it larger. */
+	if (dbca->dbca_cmt_rate == 0)
+		dbca->dbca_cmt_age = DTX_COMMIT_THRESHOLD_AGE;
+	else
+		dbca->dbca_cmt_age = min((batch + dbca->dbca_cmt_rate - 1) / dbca->dbca_cmt_rate,
+					 DTX_COMMIT_THRESHOLD_AGE);
+	dbca->dbca_cmt_age = max(dbca->dbca_cmt_age, 1);
+}
+
+/* Whether the committable DTXs of the container should be committed by the batched commit. */
+static bool
+dtx_cmt_due(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat)
+{
+	uint32_t batch = DTX_THRESHOLD_COUNT;
+	uint32_t age   = DTX_COMMIT_THRESHOLD_AGE;
+
+	if (stat->dtx_committable_coll_count > 0)
+		return true;
+
+	if (dtx_cmt_adaptive && dbca->dbca_cmt_ts != 0) {
+		batch = dtx_cmt_batch(dbca->dbca_cont);
+		age   = dbca->dbca_cmt_age;
+		/* No more DTX to batch them with, the burst is over. */
+		if (stat->dtx_committable_count > 0 &&
+		    daos_getutime() - dbca->dbca_cmt_busy_ts >= DTX_CMT_IDLE_US)
+			return true;
+	}
+
+	return stat->dtx_committable_count > batch ||
+	       (stat->dtx_oldest_committable_time != 0 &&
+		d_hlc_age2sec(stat->dtx_oldest_committable_time) >= age);
+}
+
 static void
 dtx_batched_commit_one(void *arg)
 {
@@ -639,6 +720,8 @@ dtx_batched_commit_one(void *arg)
 		struct dtx_entry	**dtes = NULL;
 		struct dtx_coll_entry	 *dce = NULL;
 		struct dtx_stat		  stat = { 0 };
+		uint64_t		  start;
+		uint64_t		  cost;
 		int			  cnt;
 		int			  rc;
 
@@ -659,6 +742,7 @@ dtx_batched_commit_one(void *arg)
 			break;
 		}
 
+		start = daos_getutime();
 		if (dce != NULL) {
 			/* Currently, commit collective DTX one by one. */
 			D_ASSERT(cnt == 1);
@@ -666,8 +750,14 @@ dtx_batched_commit_one(void *arg)
 			rc = dtx_coll_commit(cont, dce, NULL, true);
 		} else {
 			rc = dtx_commit(cont, dtes, NULL, cnt, true);
+			if (rc == 0) {
+				cost = daos_getutime() - start;
+				dbca->dbca_cmt_cost = dbca->dbca_cmt_cost == 0 ? cost :
+						      (dbca->dbca_cmt_cost * 3 + cost) / 4;
+			}
 		}
 		dtx_free_committable(dtes, NULL, dce, cnt);
+		d_tm_record_loghist(tls->dt_cmt_batch_hist, cnt);
 		if (rc != 0) {
 			D_WARN("Fail to batched commit %d entries for "DF_UUID": "DF_RC"\n",
 			       cnt, DP_UUID(cont->sc_uuid), DP_RC(rc));
@@ -680,11 +770,7 @@ dtx_batched_commit_one(void *arg)
 		    dbca->dbca_pool->dbpa_aggregating == 0)
 			sched_req_wakeup(dmi->dmi_dtx_agg_req);
 
-		if ((stat.dtx_committable_count <= DTX_THRESHOLD_COUNT) &&
-		    (stat.dtx_committable_coll_count == 0) &&
-		    (stat.dtx_oldest_committable_time == 0 ||
-		     d_hlc_age2sec(stat.dtx_oldest_committable_time) <
-		     DTX_COMMIT_THRESHOLD_AGE))
+		if (!dtx_cmt_due(dbca, &stat))
 			break;
 	}
 
@@ -738,6 +824,7 @@ dtx_batched_commit(void *arg)
 		cont = dbca->dbca_cont;
 		d_list_move_tail(&dbca->dbca_sys_link, &dmi->dmi_dtx_batched_cont_open_list);
 		dtx_stat(cont, &stat);
+		dtx_cmt_adapt(dbca);
 
 		if (dbca->dbca_commit_req != NULL && dbca->dbca_commit_done) {
 			sched_req_put(dbca->dbca_commit_req);
@@ -747,11 +834,7 @@ dtx_batched_commit(void *arg)
 
 		if (dtx_need_batched_commit(dbca) && dbca->dbca_commit_req == NULL &&
 		    (dtx_batched_ult_max != 0 && tls->dt_batched_ult_cnt < dtx_batched_ult_max) &&
-		    ((stat.dtx_committable_count > DTX_THRESHOLD_COUNT) ||
-		     (stat.dtx_committable_coll_count > 0) ||
-		     (stat.dtx_oldest_committable_time != 0 &&
-		      d_hlc_age2sec(stat.dtx_oldest_committable_time) >=
-			  DTX_COMMIT_THRESHOLD_AGE))) {
+		    dtx_cmt_due(dbca, &stat)) {
 			D_ASSERT(!dbca->dbca_commit_done);
 			sleep_time = 0;
 			dtx_get_dbca(dbca);
@@ -1193,6 +1276,7 @@ dtx_leader_end(struct dtx_leader_handle *dlh, struct ds_cont_child *cont, int re
 
 	D_ASSERT(cont != NULL);
 
+	dss_trace_mark(dth->dth_trace_id, dth->dth_trace_opc, DSS_TRACE_DTX_END);
 	dtx_shares_fini(dth);
 
 	if (daos_is_zero_dti(&dth->dth_xid) || unlikely(result == -DER_ALREADY))
@@ -1299,7 +1383,7 @@ cache:
 
 	if (!DAOS_FAIL_CHECK(DAOS_DTX_NO_COMMITTABLE)) {
 		vos_dtx_mark_committable(dth);
-		if (cont->sc_dtx_committable_count > DTX_THRESHOLD_COUNT || dlh->dlh_coll)
+		if (cont->sc_dtx_committable_count > dtx_cmt_batch(cont) || dlh->dlh_coll)
 			sched_req_wakeup(dss_get_module_info()->dmi_dtx_cmt_req);
 	}
 
@@ -1311,6 +1395,7 @@ sync:
 		 *	batched commit.
 		 */
 		vos_dtx_mark_committable(dth);
+		dss_trace_mark(dth->dth_trace_id, dth->dth_trace_opc, DSS_TRACE_DTX_SYNC);
 
 		if (dlh->dlh_coll) {
 			rc = dtx_coll_commit(cont, dlh->dlh_coll_entry, NULL, false);
@@ -1729,6 +1814,7 @@ dtx_cont_register(struct ds_cont_child *cont)
 	 * handle potential stale DTX entries.
 	 */
 	dbca->dbca_cleanup_thd = timeout + DTX_COMMIT_THRESHOLD_AGE * 2;
+	dbca->dbca_cmt_age     = DTX_COMMIT_THRESHOLD_AGE;
 
 	memset(&uma, 0, sizeof(uma));
 	uma.uma_id = UMEM_CLASS_VMEM;
@@ -149,6 +149,7 @@ dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		d_list_add_tail(&dcrc->dcrc_gl_committable, &cont->sc_dtx_cos_list);
 	}
 	cont->sc_dtx_committable_count++;
+	cont->sc_dtx_committable_total++;
 	d_tm_inc_gauge(tls->dt_committable, 1);
 
 	if (rbund->flags & DCF_EXP_CMT) {
@@ -284,6 +285,7 @@ dtx_cos_rec_update(struct btr_instance *tins, struct btr_record *rec,
 		d_list_add_tail(&dcrc->dcrc_gl_committable, &cont->sc_dtx_cos_list);
 	}
 	cont->sc_dtx_committable_count++;
+	cont->sc_dtx_committable_total++;
 	d_tm_inc_gauge(tls->dt_committable, 1);
 
 	if (rbund->flags & DCF_EXP_CMT) {
@@ -517,8 +519,6 @@ dtx_cos_get_piggyback(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 		return rc == -DER_NONEXIST ? 0 : rc;
 
 	dcr = (struct dtx_cos_rec *)riov.iov_buf;
-	if (dcr->dcr_prio_count == 0)
-		return 0;
 
 	/* There are too many priority DTXs to be committed, as to cannot be
 	 * piggybacked via normal dispatched RPC. Return the specified @max
@@ -530,21 +530,64 @@ dtx_cos_get_piggyback(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 	else
 		count = dcr->dcr_prio_count;
 
+	/* More committable DTXs than a batch, the regular ones on the same dkey are piggybacked
+	 * in the room left, that saves the batched commit RPCs for them.
+	 */
+	if (count < max && cont->sc_dtx_committable_count > dtx_cmt_batch(cont))
+		count = min(max, count + dcr->dcr_reg_count);
+
+	if (count == 0)
+		return 0;
+
 	D_ALLOC_ARRAY(dti, count);
 	if (dti == NULL)
 		return -DER_NOMEM;
 
 	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
-		dti[i] = dcrc->dcrc_dte->dte_xid;
+		if (i >= count)
+			break;
+		dti[i++] = dcrc->dcrc_dte->dte_xid;
 		dcrc->dcrc_piggyback_refs++;
-		if (++i >= count)
+	}
+
+	d_list_for_each_entry(dcrc, &dcr->dcr_reg_list, dcrc_lo_link) {
+		if (i >= count)
 			break;
+		/* Skip the ones being committed by the batched commit. */
+		if (dcrc->dcrc_coll || !d_list_empty(&dcrc->dcrc_batched_link))
+			continue;
+		dti[i++] = dcrc->dcrc_dte->dte_xid;
+		dcrc->dcrc_piggyback_refs++;
+	}
+
+	if (i == 0) {
+		D_FREE(dti);
+		return 0;
 	}
 
-	D_ASSERTF(i == count, "Invalid count %d/%d\n", i, count);
 	*dtis = dti;
+	d_tm_record_loghist(dtx_tls_get()->dt_piggyback_hist, i);
 
-	return count;
+	return i;
+}
+
+static struct dtx_cos_rec_child *
+dtx_cos_find_piggyback(struct dtx_cos_rec *dcr, struct dtx_id *xid)
+{
+	struct dtx_cos_rec_child *dcrc;
+
+	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
+		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(struct dtx_id)) == 0)
+			return dcrc;
+	}
+
+	d_list_for_each_entry(dcrc, &dcr->dcr_reg_list, dcrc_lo_link) {
+		if (!dcrc->dcrc_coll && dcrc->dcrc_piggyback_refs > 0 &&
+		    memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(struct dtx_id)) == 0)
+			return dcrc;
+	}
+
+	return NULL;
 }
 
 void
@@ -569,18 +612,20 @@ dtx_cos_put_piggyback(struct ds_cont_child *cont, daos_unit_oid_t *oid, uint64_t
 	if (rc == 0) {
 		dcr = (struct dtx_cos_rec *)riov.iov_buf;
 		for (i = 0; i < count; i++) {
-			d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
-				if (memcmp(&dcrc->dcrc_dte->dte_xid, &xid[i],
-					   sizeof(struct dtx_id)) == 0) {
-					if (rm) {
-						rc = dtx_cos_del_one(cont, dcrc);
-						if (rc == 0)
-							del++;
-					} else {
-						dcrc->dcrc_piggyback_refs--;
-					}
-					break;
-				}
+			dcrc = dtx_cos_find_piggyback(dcr, &xid[i]);
+			if (dcrc == NULL)
+				continue;
+
+			if (rm) {
+				/* The record is released with its last DTX. */
+				if (dcr->dcr_reg_count + dcr->dcr_prio_count +
+				    dcr->dcr_expcmt_count == 1)
+					i = count;
+				rc = dtx_cos_del_one(cont, dcrc);
+				if (rc == 0)
+					del++;
+			} else {
+				dcrc->dcrc_piggyback_refs--;
 			}
 		}
 
@@ -32,13 +32,15 @@
 
 /* LIST of internal RPCS in form of:
  * OPCODE, flags, FMT, handler, corpc_hdlr,
+ *
+ * DTX_REFRESH is not DAOS_RPC_LOCAL: its handler updates di_version in the input.
  */
 #define DTX_PROTO_SRV_RPC_LIST							\
-	X(DTX_COMMIT,		0,	&CQF_dtx,	dtx_handler,		\
-	  NULL,			"dtx_commit")					\
-	X(DTX_ABORT,		0,	&CQF_dtx,	dtx_handler,		\
+	X(DTX_COMMIT,		DAOS_RPC_COALESCE | DAOS_RPC_LOCAL,		\
+	  &CQF_dtx,	dtx_handler,	NULL,	"dtx_commit")			\
+	X(DTX_ABORT,		DAOS_RPC_LOCAL,	&CQF_dtx,	dtx_handler,	\
 	  NULL,			"dtx_abort")					\
-	X(DTX_CHECK,		0,	&CQF_dtx,	dtx_handler,		\
+	X(DTX_CHECK,		DAOS_RPC_LOCAL,	&CQF_dtx,	dtx_handler,	\
 	  NULL,			"dtx_check")					\
 	X(DTX_REFRESH,		0,	&CQF_dtx,	dtx_handler,		\
 	  NULL,			"dtx_refresh")					\
@@ -176,6 +178,27 @@ extern uint32_t dtx_agg_thd_age_lo;
  */
 extern uint32_t dtx_batched_ult_max;
 
+/*
+ * Adaptive batched commit: the batch of committable DTXs for each container is sized from the
+ * rate of its new committable DTXs and the cost of its commit RPCs, for the commit RPCs to take
+ * about 1/DTX_CMT_COST_RATIO of the time. The batch is in [DTX_CMT_BATCH_MIN, DTX_THRESHOLD_COUNT]
+ * and the DTXs wait no longer than the time to fill it, or DTX_CMT_IDLE_US when no more DTX come.
+ * It can be disabled via the environment "DAOS_DTX_ADAPTIVE_COMMIT" for the fixed thresholds.
+ */
+#define DTX_CMT_COST_RATIO	8
+#define DTX_CMT_COST_DEF	500		/* us */
+#define DTX_CMT_BATCH_MIN	16
+#define DTX_CMT_SAMPLE_US	(100 * 1000)
+#define DTX_CMT_IDLE_US		(1000 * 1000)
+
+extern bool dtx_cmt_adaptive;
+
+static inline uint32_t
+dtx_cmt_batch(struct ds_cont_child *cont)
+{
+	return cont->sc_dtx_cmt_batch != 0 ? cont->sc_dtx_cmt_batch : DTX_THRESHOLD_COUNT;
+}
+
 /*
  * If the size of dtx_memberships exceeds DTX_INLINE_MBS_SIZE, then load it (DTX mbs)
  * dynamically when use it to avoid holding a lot of DRAM resource for long time that
@@ -231,6 +254,8 @@ struct dtx_tls {
 	struct d_tm_node_t	*dt_dtx_leader_total;
 	struct d_tm_node_t	*dt_async_cmt_lat;
 	struct d_tm_node_t      *dt_chore_retry;
+	struct d_tm_node_t	*dt_cmt_batch_hist;
+	struct d_tm_node_t	*dt_piggyback_hist;
 	uint64_t		 dt_agg_gen;
 	uint32_t		 dt_batched_ult_cnt;
 };
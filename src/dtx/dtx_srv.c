@@ -61,6 +61,18 @@ dtx_tls_init(int tags, int xs_id, int tgt_id)
 	if (rc != DER_SUCCESS)
 		D_WARN("Failed to create DTX chore retry metric: " DF_RC "\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&tls->dt_cmt_batch_hist, D_TM_LOG_HISTOGRAM,
+			     "DTX entries per batched commit", "entry",
+			     "io/dtx/commit_batch/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit batch metric: " DF_RC "\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_piggyback_hist, D_TM_LOG_HISTOGRAM,
+			     "DTX entries piggybacked per dispatched RPC", "entry",
+			     "io/dtx/piggyback_batch/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX piggyback batch metric: " DF_RC "\n", DP_RC(rc));
+
 	return tls;
 }
 
@@ -537,6 +549,10 @@ dtx_init(void)
 	d_getenv_uint32_t("DAOS_DTX_BATCHED_ULT_MAX", &dtx_batched_ult_max);
 	D_INFO("Set the max count of DTX batched commit ULTs as %d\n", dtx_batched_ult_max);
 
+	dtx_cmt_adaptive = true;
+	d_getenv_bool("DAOS_DTX_ADAPTIVE_COMMIT", &dtx_cmt_adaptive);
+	D_INFO("DTX adaptive batched commit is %s\n", dtx_cmt_adaptive ? "enabled" : "disabled");
+
 	rc = dbtree_class_register(DBTREE_CLASS_DTX_CF,
 				   BTR_FEAT_UINT_KEY | BTR_FEAT_DYNAMIC_ROOT,
 				   &dbtree_dtx_cf_ops);
@@ -0,0 +1,273 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Unit tests for the piggyback of the committable DTXs in the CoS cache, see dtx_cos.c
+ */
+#define D_LOGFAC DD_FAC(tests)
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <daos/btree_class.h>
+#include <daos/tests_lib.h>
+#include <daos_srv/container.h>
+#include <daos_srv/dtx_srv.h>
+#include "dtx_internal.h"
+
+#define COS_DKEY	0x1234
+#define COS_NR_MAX	8
+#define COS_TREE_ORDER	23
+
+/*
+ * Mocks
+ */
+struct dss_module_key		 dtx_module_key;
+static struct dtx_tls		 test_dtx_tls;
+static void			*test_dtls_values[1];
+static struct daos_thread_local_storage test_dtls = {
+	.dtls_values = test_dtls_values,
+};
+
+struct daos_thread_local_storage *
+dss_tls_get(void)
+{
+	return &test_dtls;
+}
+
+struct daos_module_key *
+daos_get_module_key(int index)
+{
+	assert_int_equal(index, 0);
+	return &dtx_module_key;
+}
+
+/*
+ * Helpers
+ */
+static struct ds_cont_child	 test_cont;
+static daos_unit_oid_t		 test_oid;
+
+/* Add a committable DTX on COS_DKEY, the CoS cache holds the only reference. */
+static void
+cos_add(uint32_t flags, struct dtx_id *xid)
+{
+	struct dtx_entry	*dte;
+	int			 rc;
+
+	D_ALLOC_PTR(dte);
+	assert_non_null(dte);
+	daos_dti_gen_unique(&dte->dte_xid);
+	dte->dte_refs = 1;
+	*xid = dte->dte_xid;
+
+	rc = dtx_cos_add(&test_cont, dte, &test_oid, COS_DKEY, 100, flags);
+	assert_rc_equal(rc, 0);
+	dtx_entry_put(dte);
+}
+
+/* Fetch the DTXs for the batched commit, they are linked into sc_dtx_batched_list. */
+static int
+cos_fetch(struct dtx_id *xids)
+{
+	struct dtx_entry	**dtes = NULL;
+	struct dtx_coll_entry	 *dce  = NULL;
+	int			  rc;
+	int			  i;
+
+	rc = dtx_fetch_committable(&test_cont, COS_NR_MAX, NULL, DAOS_EPOCH_MAX, false, &dtes,
+				   NULL, &dce);
+	assert_true(rc >= 0);
+	assert_null(dce);
+
+	for (i = 0; i < rc; i++) {
+		xids[i] = dtes[i]->dte_xid;
+		dtx_entry_put(dtes[i]);
+	}
+	D_FREE(dtes);
+
+	return rc;
+}
+
+static bool
+cos_xid_in(struct dtx_id *xid, struct dtx_id *xids, int nr)
+{
+	int i;
+
+	for (i = 0; i < nr; i++)
+		if (daos_dti_equal(xid, &xids[i]))
+			return true;
+
+	return false;
+}
+
+/*
+ * Tests
+ */
+static void
+test_cos_piggyback_prio(void **state)
+{
+	struct dtx_id	 prio[2];
+	struct dtx_id	 reg[3];
+	struct dtx_id	 fetched[COS_NR_MAX];
+	struct dtx_id	*dtis = NULL;
+	int		 rc;
+	int		 i;
+
+	/* Fewer committable DTXs than a batch, only the priority ones are piggybacked. */
+	test_cont.sc_dtx_cmt_batch = 16;
+	for (i = 0; i < 2; i++)
+		cos_add(DCF_SHARED, &prio[i]);
+	for (i = 0; i < 3; i++)
+		cos_add(0, &reg[i]);
+	assert_int_equal(test_cont.sc_dtx_committable_count, 5);
+
+	rc = dtx_cos_get_piggyback(&test_cont, &test_oid, COS_DKEY, COS_NR_MAX, &dtis);
+	assert_int_equal(rc, 2);
+	assert_true(daos_dti_equal(&dtis[0], &prio[0]));
+	assert_true(daos_dti_equal(&dtis[1], &prio[1]));
+
+	/* The piggybacked DTXs are not fetched by the batched commit. */
+	rc = cos_fetch(fetched);
+	assert_int_equal(rc, 3);
+	for (i = 0; i < 3; i++)
+		assert_true(cos_xid_in(&reg[i], fetched, rc));
+	dtx_cos_batched_del(&test_cont, fetched, NULL, rc);
+
+	/* The dispatched RPC failed, they are committed by the batched commit then. */
+	dtx_cos_put_piggyback(&test_cont, &test_oid, COS_DKEY, dtis, 2, false);
+	D_FREE(dtis);
+
+	rc = cos_fetch(fetched);
+	assert_int_equal(rc, 5);
+	dtx_cos_batched_del(&test_cont, fetched, (bool []){true, true, true, true, true}, rc);
+	assert_int_equal(test_cont.sc_dtx_committable_count, 0);
+}
+
+static void
+test_cos_piggyback_reg(void **state)
+{
+	struct dtx_id	 prio;
+	struct dtx_id	 reg[4];
+	struct dtx_id	 fetched[COS_NR_MAX];
+	struct dtx_id	*dtis = NULL;
+	struct dtx_id	*dtis2 = NULL;
+	int		 nr;
+	int		 rc;
+	int		 i;
+
+	/* More committable DTXs than a batch, the regular ones fill the room left. */
+	test_cont.sc_dtx_cmt_batch = 2;
+	cos_add(DCF_SHARED, &prio);
+	for (i = 0; i < 4; i++)
+		cos_add(0, &reg[i]);
+
+	rc = dtx_cos_get_piggyback(&test_cont, &test_oid, COS_DKEY, 3, &dtis);
+	assert_int_equal(rc, 3);
+	assert_true(daos_dti_equal(&dtis[0], &prio));
+	assert_true(daos_dti_equal(&dtis[1], &reg[0]));
+	assert_true(daos_dti_equal(&dtis[2], &reg[1]));
+
+	/* The batched commit only takes the ones that are not piggybacked. */
+	nr = cos_fetch(fetched);
+	assert_int_equal(nr, 2);
+	assert_true(cos_xid_in(&reg[2], fetched, nr));
+	assert_true(cos_xid_in(&reg[3], fetched, nr));
+
+	/* And the piggyback skips the ones linked into the batched commit list. */
+	rc = dtx_cos_get_piggyback(&test_cont, &test_oid, COS_DKEY, COS_NR_MAX, &dtis2);
+	assert_int_equal(rc, 3);
+	for (i = 0; i < rc; i++)
+		assert_false(cos_xid_in(&dtis2[i], fetched, nr));
+	dtx_cos_put_piggyback(&test_cont, &test_oid, COS_DKEY, dtis2, rc, false);
+	D_FREE(dtis2);
+
+	/* The dispatched RPC committed the piggybacked DTXs. */
+	dtx_cos_put_piggyback(&test_cont, &test_oid, COS_DKEY, dtis, 3, true);
+	D_FREE(dtis);
+	assert_int_equal(test_cont.sc_dtx_committable_count, 2);
+
+	/* The last ones release the record. */
+	dtx_cos_batched_del(&test_cont, fetched, (bool []){true, true}, nr);
+	assert_int_equal(test_cont.sc_dtx_committable_count, 0);
+	assert_true(d_list_empty(&test_cont.sc_dtx_batched_list));
+	rc = dtx_cos_get_piggyback(&test_cont, &test_oid, COS_DKEY, COS_NR_MAX, &dtis);
+	assert_int_equal(rc, 0);
+}
+
+static void
+test_cos_piggyback_put_all(void **state)
+{
+	struct dtx_id	 reg[3];
+	struct dtx_id	*dtis = NULL;
+	int		 rc;
+	int		 i;
+
+	/* All the DTXs of the record are piggybacked and committed at once. */
+	test_cont.sc_dtx_cmt_batch = 1;
+	for (i = 0; i < 3; i++)
+		cos_add(0, &reg[i]);
+
+	rc = dtx_cos_get_piggyback(&test_cont, &test_oid, COS_DKEY, COS_NR_MAX, &dtis);
+	assert_int_equal(rc, 3);
+
+	dtx_cos_put_piggyback(&test_cont, &test_oid, COS_DKEY, dtis, rc, true);
+	D_FREE(dtis);
+	assert_int_equal(test_cont.sc_dtx_committable_count, 0);
+	assert_true(d_list_empty(&test_cont.sc_dtx_cos_list));
+}
+
+static int
+setup(void **state)
+{
+	struct umem_attr	uma = {.uma_id = UMEM_CLASS_VMEM};
+	int			rc;
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc != 0)
+		return rc;
+
+	dtx_module_key.dmk_index = 0;
+	test_dtls_values[0]      = &test_dtx_tls;
+
+	rc = dbtree_class_register(DBTREE_CLASS_DTX_COS, 0, &dtx_btr_cos_ops);
+	if (rc != 0)
+		return rc;
+
+	test_cont.sc_open = 1;
+	D_INIT_LIST_HEAD(&test_cont.sc_dtx_cos_list);
+	D_INIT_LIST_HEAD(&test_cont.sc_dtx_coll_list);
+	D_INIT_LIST_HEAD(&test_cont.sc_dtx_batched_list);
+	test_oid.id_pub.lo = 1;
+
+	return dbtree_create_inplace_ex(DBTREE_CLASS_DTX_COS, 0, COS_TREE_ORDER, &uma,
+					&test_cont.sc_dtx_cos_btr, DAOS_HDL_INVAL, &test_cont,
+					&test_cont.sc_dtx_cos_hdl);
+}
+
+static int
+teardown(void **state)
+{
+	dbtree_destroy(test_cont.sc_dtx_cos_hdl, NULL);
+	daos_debug_fini();
+
+	return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test(test_cos_piggyback_prio),
+	    cmocka_unit_test(test_cos_piggyback_reg),
+	    cmocka_unit_test(test_cos_piggyback_put_all),
+	};
+
+	d_register_alt_assert(mock_assert);
+
+	return cmocka_run_group_tests_name("dtx_cos", tests, setup, teardown);
+}
@@ -658,8 +658,10 @@ metrics_region_size(int num_tgts)
 {
 	const uint64_t	est_std_metrics = 1024; /* high estimate to allow for pool links */
 	const uint64_t	est_tgt_metrics = 128; /* high estimate */
+	const uint64_t	est_tgt_hists = 48; /* log histograms, high estimate */
 
-	return (est_std_metrics + est_tgt_metrics * num_tgts) * D_TM_METRIC_SIZE;
+	return (est_std_metrics + est_tgt_metrics * num_tgts) * D_TM_METRIC_SIZE +
+	       est_tgt_hists * num_tgts * sizeof(struct d_tm_loghist_t);
 }
 
 static int
@@ -1256,6 +1258,7 @@ main(int argc, char **argv)
 			D_INFO("got SIGUSR1, dumping Argobots infos and ULTs stacks to %s\n",
 			       filename);
 			dss_dump_ABT_state(fp);
+			dss_trace_dump(fp);
 			/* re-add SIGUSR1 to set */
 			sigaddset(&set, SIGUSR1);
 			if (fp != stderr)
@@ -36,6 +36,9 @@ static unsigned int req_latencys[SCHED_REQ_MAX] = {
 	10,	/* SCHED_REQ_MIGRATE */
 };
 
+/* Rebuild/Reintegration takes 30% CPU when there is no space pressure */
+#define REBUILD_RATIO	30
+
 struct stats_cycle {
 	/* Kicked off weights in a schedule cycle */
 	uint64_t	sc_kicked_wts[SCHED_REQ_MAX];
@@ -181,6 +184,8 @@ unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
 unsigned int    sched_inactive_max = 300000; /* ms, 5 mins */
 bool            sched_monitor_kill = true;
+unsigned int    sched_qos_lat_target; /* us, 0: QoS controller disabled */
+unsigned int    sched_qos_pctl = 99;  /* latency percentile compared with the target */
 
 enum {
 	/* All requests for various pools are processed in FIFO */
@@ -529,6 +534,20 @@ sched_metrics_init(struct dss_xstream *dx)
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
 
+	if (sched_qos_lat_target != 0) {
+		rc = d_tm_add_metric(&info->si_qos.sq_ratio_gauge, D_TM_GAUGE,
+				     "CPU percentage for rebuild & aggregation", "%",
+				     "sched/qos_ratio/xs_%u", dx->dx_xs_id);
+		if (rc)
+			D_WARN("Failed to create qos_ratio telemetry: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&info->si_qos.sq_lat_gauge, D_TM_GAUGE,
+				     "Foreground I/O latency percentile", "us",
+				     "sched/qos_latency/xs_%u", dx->dx_xs_id);
+		if (rc)
+			D_WARN("Failed to create qos_latency telemetry: "DF_RC"\n", DP_RC(rc));
+	}
+
 	rc = d_tm_add_metric(&stats->ss_total_reject, D_TM_COUNTER, "Total rejected requests",
 			     "req", "sched/total_reject/xs_%u", dx->dx_xs_id);
 	if (rc)
@@ -606,6 +625,9 @@ sched_info_init(struct dss_xstream *dx)
 	info->si_wait_cnt = 0;
 	info->si_stop = 0;
 	info->si_hist_seqs     = NULL;
+	memset(&info->si_qos, 0, sizeof(info->si_qos));
+	info->si_qos.sq_period_ts = info->si_cur_ts;
+	info->si_qos.sq_ratio     = REBUILD_RATIO;
 	sched_metrics_init(dx);
 
 	rc = d_hash_table_create(D_HASH_FT_NOLOCK, 4,
@@ -1095,15 +1117,17 @@ done:
 		apportion_wts(avail_wts, kick, SCHED_REQ_SCRUB);
 }
 
-/* Rebuild/Reintegration takes 30% CPU when there is no space pressure */
-#define REBUILD_RATIO	30
-
 /*
  * When there is no space pressure, all IO requests will be kicked off immediately,
  * internal sys ULTs will be throttled.
+ *
+ * If the QoS latency target is set, the CPU percentage for rebuild & aggregation is
+ * driven by the foreground I/O latency (see sched_qos_update()) instead of the
+ * static ratios.
  */
 static void
-throttle_sys(struct stats_window *sw, uint32_t *kick, struct pressure_ratio *pr)
+throttle_sys(struct sched_info *info, struct stats_window *sw, uint32_t *kick,
+	     struct pressure_ratio *pr)
 {
 	uint64_t	*kicked_wts, io_wts, tot_wts, avail_wts;
 	unsigned int	 io_ratio;
@@ -1118,7 +1142,9 @@ throttle_sys(struct stats_window *sw, uint32_t *kick, struct pressure_ratio *pr)
 	if (io_wts == 0)
 		return;
 
-	if (kicked_wts[SCHED_REQ_MIGRATE] != 0 || kick[SCHED_REQ_MIGRATE] != 0)
+	if (sched_qos_lat_target != 0)
+		io_ratio = 100 - info->si_qos.sq_ratio;
+	else if (kicked_wts[SCHED_REQ_MIGRATE] != 0 || kick[SCHED_REQ_MIGRATE] != 0)
 		io_ratio = 100 - REBUILD_RATIO;
 	else
 		io_ratio = 100 - pr->pr_gc_ratio;
@@ -1202,7 +1228,7 @@ process_pool_cb(d_list_t *rlink, void *arg)
 	pr = &pressure_gauge[press];
 
 	if (press == SCHED_SPACE_PRESS_NONE)
-		throttle_sys(&spi->spi_stats_window, &kick[SCHED_REQ_UPDATE], pr);
+		throttle_sys(info, &spi->spi_stats_window, &kick[SCHED_REQ_UPDATE], pr);
 	else
 		throttle_io(info, spi, &kick[SCHED_REQ_UPDATE], pr);
 
@@ -1316,12 +1342,103 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 	}
 };
 
+/* QoS control period, in msecs */
+#define SCHED_QOS_PERIOD	200
+/* Too few samples to tell the latency, assume the foreground I/O isn't impacted */
+#define SCHED_QOS_SAMPLES_MIN	32
+/* Bounds and additive step of the CPU percentage for rebuild & aggregation */
+#define SCHED_QOS_RATIO_MIN	5
+#define SCHED_QOS_RATIO_MAX	90
+#define SCHED_QOS_RATIO_STEP	5
+
+void
+sched_io_lat_record(uint64_t usecs)
+{
+	struct sched_qos	*qos;
+	unsigned int		 bucket;
+
+	if (sched_qos_lat_target == 0)
+		return;
+
+	qos = &dss_current_xstream()->dx_sched_info.si_qos;
+	bucket = usecs == 0 ? 0 : 63 - __builtin_clzll(usecs);
+	if (bucket >= SCHED_QOS_LAT_BUCKETS)
+		bucket = SCHED_QOS_LAT_BUCKETS - 1;
+
+	qos->sq_lat_hist[bucket]++;
+	qos->sq_lat_cnt++;
+}
+
+/* Get the latency percentile from the log2 histogram, interpolating within the bucket */
+static uint64_t
+qos_lat_percentile(struct sched_qos *qos, unsigned int pctl)
+{
+	uint64_t	rank, cum = 0, lo, hi;
+	unsigned int	i;
+
+	rank = ((uint64_t)qos->sq_lat_cnt * pctl + 99) / 100;
+	if (rank == 0)
+		rank = 1;
+
+	for (i = 0; i < SCHED_QOS_LAT_BUCKETS; i++) {
+		if (cum + qos->sq_lat_hist[i] >= rank)
+			break;
+		cum += qos->sq_lat_hist[i];
+	}
+	D_ASSERT(i < SCHED_QOS_LAT_BUCKETS);
+
+	lo = i == 0 ? 0 : 1ULL << i;
+	hi = 1ULL << (i + 1);
+	return lo + (hi - lo) * (rank - cum) / qos->sq_lat_hist[i];
+}
+
+/*
+ * AIMD controller on the CPU percentage for rebuild & aggregation: halve it when the
+ * foreground latency percentile exceeds the target, grow it by a fixed step while the
+ * latency stays well below the target. So rebuild runs at full speed on an idle
+ * target and backs off quickly once the user I/O starts suffering.
+ */
+static void
+sched_qos_update(struct sched_info *info)
+{
+	struct sched_qos	*qos = &info->si_qos;
+	unsigned int		 ratio = qos->sq_ratio;
+
+	if (sched_qos_lat_target == 0 ||
+	    info->si_cur_ts < qos->sq_period_ts + SCHED_QOS_PERIOD)
+		return;
+
+	if (qos->sq_lat_cnt < SCHED_QOS_SAMPLES_MIN) {
+		qos->sq_lat = 0;
+		ratio = min(ratio + SCHED_QOS_RATIO_STEP, SCHED_QOS_RATIO_MAX);
+	} else {
+		qos->sq_lat = qos_lat_percentile(qos, sched_qos_pctl);
+		if (qos->sq_lat > sched_qos_lat_target)
+			ratio = max(ratio / 2, SCHED_QOS_RATIO_MIN);
+		else if (qos->sq_lat < (uint64_t)sched_qos_lat_target * 3 / 4)
+			ratio = min(ratio + SCHED_QOS_RATIO_STEP, SCHED_QOS_RATIO_MAX);
+	}
+
+	if (ratio != qos->sq_ratio)
+		D_DEBUG(DB_TRACE, "QoS ratio %u -> %u, p%u latency "DF_U64" us, %u samples\n",
+			qos->sq_ratio, ratio, sched_qos_pctl, qos->sq_lat, qos->sq_lat_cnt);
+	qos->sq_ratio = ratio;
+
+	d_tm_set_gauge(qos->sq_ratio_gauge, qos->sq_ratio);
+	d_tm_set_gauge(qos->sq_lat_gauge, qos->sq_lat);
+
+	memset(qos->sq_lat_hist, 0, sizeof(qos->sq_lat_hist));
+	qos->sq_lat_cnt   = 0;
+	qos->sq_period_ts = info->si_cur_ts;
+}
+
 static void
 process_all(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	int			 rc;
 
+	sched_qos_update(info);
 	prune_purge_list(dx);
 	rc = d_hash_table_traverse(info->si_pool_hash, process_pool_cb, dx);
 	if (rc)
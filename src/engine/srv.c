@@ -296,11 +296,19 @@ dss_rpc_hdlr(crt_context_t *ctx, void *hdlr_arg,
 	unsigned int		 mod_id = opc_get_mod_id(rpc->cr_opc);
 	struct dss_module	*module = dss_module_get(mod_id);
 	struct sched_req_attr	 attr = { 0 };
+	uint64_t		 trace_id;
 	int			 rc;
 
 	if (DAOS_FAIL_CHECK(DAOS_FAIL_LOST_REQ))
 		return 0;
 
+	if (dss_trace_enabled) {
+		rc = crt_req_get_trace_id(rpc, &trace_id);
+		D_ASSERT(rc == 0);
+		if (trace_id != 0)
+			dss_trace_record(trace_id, rpc->cr_opc, DSS_TRACE_RECV);
+	}
+
 	rc = crt_req_get_timeout(rpc, &attr.sra_timeout);
 	D_ASSERT(rc == 0);
 	/* convert it to msec */
@@ -690,6 +698,7 @@ static inline void
 dss_xstream_free(struct dss_xstream *dx)
 {
 	hwloc_bitmap_free(dx->dx_cpuset);
+	dss_trace_ring_free(dx);
 	D_FREE(dx);
 }
 
@@ -1140,6 +1149,18 @@ dss_xstreams_init(void)
 	D_INFO("Watchdog [runtime_max:%u ms, all:%d], Monitor [inactive_max:%u ms, kill:%d]\n",
 	       sched_unit_runtime_max, sched_watchdog_all, sched_inactive_max, sched_monitor_kill);
 
+	dss_trace_init();
+
+	d_getenv_uint("DAOS_SCHED_QOS_LATENCY", &sched_qos_lat_target);
+	d_getenv_uint("DAOS_SCHED_QOS_PERCENTILE", &sched_qos_pctl);
+	if (sched_qos_pctl == 0 || sched_qos_pctl > 100) {
+		D_WARN("Invalid QoS latency percentile %u, set to default 99.\n", sched_qos_pctl);
+		sched_qos_pctl = 99;
+	}
+	if (sched_qos_lat_target != 0)
+		D_INFO("Rebuild & aggregation QoS: p%u latency target %u us\n", sched_qos_pctl,
+		       sched_qos_lat_target);
+
 	dss_chore_credits = DSS_CHORE_CREDITS_DEF;
 	d_getenv_uint("DAOS_IO_CHORE_CREDITS", &dss_chore_credits);
 	if (dss_chore_credits < DSS_CHORE_CREDITS_MIN) {
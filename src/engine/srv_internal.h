@@ -44,6 +44,23 @@ struct sched_hist_seq {
 	uint64_t sm_last_ts;  /* Timestamp of the last sched sequence */
 };
 
+/* Number of log2 buckets of the foreground I/O latency histogram (usecs) */
+#define SCHED_QOS_LAT_BUCKETS	32
+
+/*
+ * Feedback controller which adjusts the CPU share of rebuild & aggregation against the
+ * observed foreground I/O latency, see sched_qos_update().
+ */
+struct sched_qos {
+	uint32_t		 sq_lat_hist[SCHED_QOS_LAT_BUCKETS];
+	uint32_t		 sq_lat_cnt;	/* Samples in current period */
+	uint64_t		 sq_period_ts;	/* Start of current period (ms) */
+	uint64_t		 sq_lat;	/* Latency percentile of last period (us) */
+	unsigned int		 sq_ratio;	/* CPU percentage for rebuild & aggregation */
+	struct d_tm_node_t	*sq_ratio_gauge;
+	struct d_tm_node_t	*sq_lat_gauge;
+};
+
 struct sched_info {
 	uint64_t		 si_cur_ts;	/* Current timestamp (ms) */
 	uint64_t		 si_cur_seq;	/* Current schedule sequence */
@@ -66,6 +83,7 @@ struct sched_info {
 	int			 si_wait_cnt;	/* Long wait request count */
 	/* Number of kicked requests for each type in current cycle */
 	uint32_t		 si_kicked_req_cnt[SCHED_REQ_MAX];
+	struct sched_qos	 si_qos;	/* Rebuild & aggregation QoS */
 	unsigned int		 si_stop:1;
 };
 
@@ -116,6 +134,7 @@ struct dss_xstream {
 	bool			dx_progress_started;	/* Network poll started */
 	int                     dx_tag;                 /** tag for xstream */
 	struct dss_chore_queue	dx_chore_queue;
+	struct dss_trace_ring	*dx_trace;	/* traced requests, see srv_trace.c */
 };
 
 /** Engine module's metrics */
@@ -212,6 +231,12 @@ void
 void dss_mem_total_alloc_track(void *arg, daos_size_t bytes);
 void dss_mem_total_free_track(void *arg, daos_size_t bytes);
 
+/* srv_trace.c */
+extern bool dss_trace_enabled;
+void dss_trace_init(void);
+void dss_trace_dump(FILE *fp);
+void dss_trace_ring_free(struct dss_xstream *dx);
+
 /* srv_metrics.c */
 int dss_engine_metrics_init(void);
 int dss_engine_metrics_fini(void);
@@ -263,6 +288,8 @@ extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
 extern unsigned int sched_inactive_max;
 extern bool         sched_monitor_kill;
+extern unsigned int sched_qos_lat_target;
+extern unsigned int sched_qos_pctl;
 
 void dss_sched_fini(struct dss_xstream *dx);
 int dss_sched_init(struct dss_xstream *dx);
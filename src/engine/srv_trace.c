@@ -0,0 +1,252 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Request tracing.
+ *
+ * Requests traced by the client carry a trace ID in their RPC header, see
+ * crt_req_set_trace_id(). Each stage of a traced request is recorded with a
+ * timestamp in a ring owned by the xstream handling it, only written by this
+ * xstream. The rings are dumped along with the Argobots state on SIGUSR1. Once
+ * a request is done, the time it spent in each stage is published to the
+ * trace/<stage>/xs_<id> metrics of the xstream, and its breakdown is logged if
+ * it took longer than DAOS_TRACE_SLOW_US.
+ */
+#define D_LOGFAC	DD_FAC(server)
+
+#include <daos_srv/daos_engine.h>
+#include <gurt/telemetry_producer.h>
+#include "srv_internal.h"
+
+/** Default number of records per xstream */
+#define DSS_TRACE_RING_SIZE_DEF	1024
+#define DSS_TRACE_RING_SIZE_MAX	(1 << 20)
+
+struct dss_trace_rec {
+	/** position in the ring + 1, zero while the record is written */
+	ATOMIC uint64_t	tr_seq;
+	uint64_t	tr_id;
+	uint64_t	tr_time;
+	uint32_t	tr_opc;
+	uint32_t	tr_stage;
+};
+
+struct dss_trace_ring {
+	/** position of the next record */
+	ATOMIC uint64_t		tr_head;
+	uint32_t		tr_mask;
+	/** time spent in each stage by the traced requests */
+	struct d_tm_node_t	*tr_stage_lat[DSS_TRACE_STAGE_MAX];
+	/** traced requests slower than DAOS_TRACE_SLOW_US */
+	struct d_tm_node_t	*tr_slow;
+	struct dss_trace_rec	tr_recs[];
+};
+
+static unsigned int dss_trace_ring_size = DSS_TRACE_RING_SIZE_DEF;
+static unsigned int dss_trace_slow_us;
+/* requests are not traced on this engine if DAOS_TRACE_RING_SIZE is 0 */
+bool                dss_trace_enabled;
+
+static const char *dss_trace_stage_names[DSS_TRACE_STAGE_MAX] = {
+    [DSS_TRACE_RECV] = "recv",         [DSS_TRACE_START] = "start",
+    [DSS_TRACE_FWD] = "fwd",           [DSS_TRACE_IO_PREP] = "io_prep",
+    [DSS_TRACE_BULK] = "bulk",         [DSS_TRACE_IO_POST] = "io_post",
+    [DSS_TRACE_COMMIT] = "commit",     [DSS_TRACE_RMT_DONE] = "rmt_done",
+    [DSS_TRACE_FWD_DONE] = "fwd_done", [DSS_TRACE_DTX_END] = "dtx_end",
+    [DSS_TRACE_DTX_SYNC] = "dtx_sync", [DSS_TRACE_DONE] = "done",
+};
+
+void
+dss_trace_init(void)
+{
+	d_getenv_uint("DAOS_TRACE_RING_SIZE", &dss_trace_ring_size);
+	if (dss_trace_ring_size > DSS_TRACE_RING_SIZE_MAX) {
+		D_WARN("Invalid trace ring size %u, set to %u\n", dss_trace_ring_size,
+		       DSS_TRACE_RING_SIZE_MAX);
+		dss_trace_ring_size = DSS_TRACE_RING_SIZE_MAX;
+	}
+	if (dss_trace_ring_size != 0 && (dss_trace_ring_size & (dss_trace_ring_size - 1)) != 0)
+		dss_trace_ring_size = 1U << (32 - __builtin_clz(dss_trace_ring_size));
+
+	dss_trace_enabled = dss_trace_ring_size != 0;
+
+	d_getenv_uint("DAOS_TRACE_SLOW_US", &dss_trace_slow_us);
+
+	D_INFO("Request trace ring size %u, slow request threshold %u us\n", dss_trace_ring_size,
+	       dss_trace_slow_us);
+}
+
+static void
+dss_trace_metrics_init(struct dss_trace_ring *ring, int xs_id)
+{
+	int	i;
+	int	rc;
+
+	/* no time is spent in the last stage */
+	for (i = 0; i < DSS_TRACE_DONE; i++) {
+		rc = d_tm_add_metric(&ring->tr_stage_lat[i], D_TM_STATS_GAUGE,
+				     "Time spent by the traced requests in the stage", "us",
+				     "trace/%s/xs_%u", dss_trace_stage_names[i], xs_id);
+		if (rc)
+			D_WARN("Failed to create trace telemetry: " DF_RC "\n", DP_RC(rc));
+	}
+
+	rc = d_tm_add_metric(&ring->tr_slow, D_TM_COUNTER, "Slow traced requests", "req",
+			     "trace/slow/xs_%u", xs_id);
+	if (rc)
+		D_WARN("Failed to create trace telemetry: " DF_RC "\n", DP_RC(rc));
+}
+
+/* Allocated by the xstream itself on its first traced request */
+static struct dss_trace_ring *
+dss_trace_ring_get(struct dss_xstream *dx)
+{
+	struct dss_trace_ring *ring;
+
+	if (likely(dx->dx_trace != NULL))
+		return dx->dx_trace;
+
+	if (dss_trace_ring_size == 0)
+		return NULL;
+
+	D_ALLOC(ring, sizeof(*ring) + dss_trace_ring_size * sizeof(ring->tr_recs[0]));
+	if (ring == NULL)
+		return NULL;
+	ring->tr_mask = dss_trace_ring_size - 1;
+	dss_trace_metrics_init(ring, dx->dx_xs_id);
+
+	/* publish the ring to dss_trace_dump() */
+	__atomic_store_n(&dx->dx_trace, ring, __ATOMIC_RELEASE);
+	return ring;
+}
+
+void
+dss_trace_ring_free(struct dss_xstream *dx)
+{
+	D_FREE(dx->dx_trace);
+}
+
+/*
+ * Publish the time spent by \a trace_id in each stage, and log it if the request took longer than
+ * the threshold. Called on DSS_TRACE_DONE.
+ */
+static void
+dss_trace_report(struct dss_trace_ring *ring, uint64_t head, uint64_t trace_id)
+{
+	struct dss_trace_rec	*recs[DSS_TRACE_STAGE_MAX * 2];
+	struct dss_trace_rec	*rec;
+	char			 buf[512];
+	uint64_t		 pos;
+	uint64_t		 elapsed;
+	int			 nr = 0;
+	int			 len;
+	int			 i;
+
+	/* walk back to the start of the request, there are only records of this xstream */
+	for (pos = head + 1; pos > 0 && head + 1 - pos <= ring->tr_mask; pos--) {
+		rec = &ring->tr_recs[(pos - 1) & ring->tr_mask];
+		if (rec->tr_id != trace_id)
+			continue;
+
+		recs[nr++] = rec;
+		if (rec->tr_stage == DSS_TRACE_RECV || nr == ARRAY_SIZE(recs))
+			break;
+	}
+
+	if (nr < 2)
+		return;
+
+	/* the stages are charged in the order of the records, a stage may be repeated */
+	for (i = nr - 1; i > 0; i--)
+		d_tm_set_gauge(ring->tr_stage_lat[recs[i]->tr_stage],
+			       (recs[i - 1]->tr_time - recs[i]->tr_time) / NSEC_PER_USEC);
+
+	elapsed = (recs[0]->tr_time - recs[nr - 1]->tr_time) / NSEC_PER_USEC;
+	if (dss_trace_slow_us == 0 || elapsed < dss_trace_slow_us)
+		return;
+	d_tm_inc_counter(ring->tr_slow, 1);
+
+	len = 0;
+	for (i = nr - 1; i > 0 && len < sizeof(buf); i--)
+		len += snprintf(buf + len, sizeof(buf) - len, " %s:%luus",
+				dss_trace_stage_names[recs[i]->tr_stage],
+				(recs[i - 1]->tr_time - recs[i]->tr_time) / NSEC_PER_USEC);
+
+	D_INFO("slow request trace " DF_X64 " opc %#x: %luus,%s\n", trace_id, recs[0]->tr_opc,
+	       elapsed, buf);
+}
+
+void
+dss_trace_record(uint64_t trace_id, uint32_t opc, enum dss_trace_stage stage)
+{
+	struct dss_trace_ring	*ring;
+	struct dss_trace_rec	*rec;
+	uint64_t		 head;
+
+	ring = dss_trace_ring_get(dss_current_xstream());
+	if (ring == NULL)
+		return;
+
+	/* single writer, no need for an atomic increment */
+	head = atomic_load_relaxed(&ring->tr_head);
+	rec  = &ring->tr_recs[head & ring->tr_mask];
+
+	atomic_store_relaxed(&rec->tr_seq, 0);
+	atomic_thread_fence(memory_order_release);
+	rec->tr_id    = trace_id;
+	rec->tr_time  = daos_get_ntime();
+	rec->tr_opc   = opc;
+	rec->tr_stage = stage;
+	atomic_store_release(&rec->tr_seq, head + 1);
+	atomic_store_release(&ring->tr_head, head + 1);
+
+	if (stage == DSS_TRACE_DONE)
+		dss_trace_report(ring, head, trace_id);
+}
+
+/* Dump the traced requests of all xstreams, possibly while they are being recorded */
+void
+dss_trace_dump(FILE *fp)
+{
+	struct dss_xstream	*dx;
+	struct dss_trace_ring	*ring;
+	struct dss_trace_rec	*rec;
+	struct dss_trace_rec	 copy;
+	uint64_t		 head;
+	uint64_t		 pos;
+	int			 i;
+
+	fprintf(fp, "== Traced requests ==\n");
+	for (i = 0; i < dss_xstream_cnt(); i++) {
+		dx   = dss_get_xstream(i);
+		ring = __atomic_load_n(&dx->dx_trace, __ATOMIC_ACQUIRE);
+		if (ring == NULL)
+			continue;
+
+		head = atomic_load_explicit(&ring->tr_head, memory_order_acquire);
+		fprintf(fp, "== xstream %d (%s), %lu records ==\n", dx->dx_xs_id, dx->dx_name,
+			head);
+		pos = head > ring->tr_mask + 1 ? head - ring->tr_mask - 1 : 0;
+		for (; pos < head; pos++) {
+			rec = &ring->tr_recs[pos & ring->tr_mask];
+
+			if (atomic_load_explicit(&rec->tr_seq, memory_order_acquire) != pos + 1)
+				continue;
+			copy.tr_id    = rec->tr_id;
+			copy.tr_time  = rec->tr_time;
+			copy.tr_opc   = rec->tr_opc;
+			copy.tr_stage = rec->tr_stage;
+			atomic_thread_fence(memory_order_acquire);
+			/* overwritten while being read */
+			if (atomic_load_relaxed(&rec->tr_seq) != pos + 1)
+				continue;
+
+			fprintf(fp, DF_X64 " opc %#x %s %lu\n", copy.tr_id, copy.tr_opc,
+				copy.tr_stage < DSS_TRACE_STAGE_MAX ?
+				    dss_trace_stage_names[copy.tr_stage] : "unknown",
+				copy.tr_time);
+		}
+	}
+}
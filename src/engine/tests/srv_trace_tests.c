@@ -0,0 +1,297 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * Unit tests for the request trace rings of srv_trace.c
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <daos/tests_lib.h>
+#include <gurt/telemetry_producer.h>
+#include "../srv_internal.h"
+
+/*
+ * Mocks
+ */
+struct dss_module_key		 daos_srv_modkey;
+static struct dss_module_info	 test_dmi;
+static struct dss_xstream	 test_dx;
+static void			*test_dtls_values[1];
+static struct daos_thread_local_storage test_dtls = {
+	.dtls_values = test_dtls_values,
+};
+
+struct daos_thread_local_storage *
+dss_tls_get(void)
+{
+	return &test_dtls;
+}
+
+struct daos_module_key *
+daos_get_module_key(int index)
+{
+	assert_int_equal(index, 0);
+	return &daos_srv_modkey;
+}
+
+int
+dss_xstream_cnt(void)
+{
+	return 1;
+}
+
+struct dss_xstream *
+dss_get_xstream(int stream_id)
+{
+	assert_int_equal(stream_id, 0);
+	return &test_dx;
+}
+
+/* telemetry, a node per metric of the xstream */
+struct mock_metric {
+	char		mm_path[64];
+	uint64_t	mm_value;
+	int		mm_nr;
+};
+
+static struct mock_metric	mock_metrics[DSS_TRACE_STAGE_MAX + 1];
+static int			mock_metrics_nr;
+
+int
+d_tm_add_metric(struct d_tm_node_t **node, int metric_type, char *desc, char *units,
+		const char *fmt, ...)
+{
+	struct mock_metric	*metric;
+	va_list			 args;
+
+	assert_true(mock_metrics_nr < ARRAY_SIZE(mock_metrics));
+	metric = &mock_metrics[mock_metrics_nr++];
+
+	va_start(args, fmt);
+	vsnprintf(metric->mm_path, sizeof(metric->mm_path), fmt, args);
+	va_end(args);
+
+	*node = (struct d_tm_node_t *)metric;
+	return 0;
+}
+
+void
+d_tm_set_gauge(struct d_tm_node_t *node, uint64_t value)
+{
+	struct mock_metric *metric = (struct mock_metric *)node;
+
+	assert_non_null(metric);
+	metric->mm_value = value;
+	metric->mm_nr++;
+}
+
+void
+d_tm_inc_counter(struct d_tm_node_t *node, uint64_t value)
+{
+	struct mock_metric *metric = (struct mock_metric *)node;
+
+	assert_non_null(metric);
+	metric->mm_value += value;
+	metric->mm_nr++;
+}
+
+static struct mock_metric *
+mock_metric_find(const char *path)
+{
+	int i;
+
+	for (i = 0; i < mock_metrics_nr; i++)
+		if (strcmp(mock_metrics[i].mm_path, path) == 0)
+			return &mock_metrics[i];
+
+	fail_msg("no metric %s", path);
+	return NULL;
+}
+
+/*
+ * Helpers
+ */
+static void
+trace_setup(const char *ring_size, const char *slow_us)
+{
+	dss_trace_ring_free(&test_dx);
+	memset(mock_metrics, 0, sizeof(mock_metrics));
+	mock_metrics_nr = 0;
+
+	if (ring_size != NULL)
+		setenv("DAOS_TRACE_RING_SIZE", ring_size, 1);
+	else
+		unsetenv("DAOS_TRACE_RING_SIZE");
+	if (slow_us != NULL)
+		setenv("DAOS_TRACE_SLOW_US", slow_us, 1);
+	else
+		unsetenv("DAOS_TRACE_SLOW_US");
+
+	dss_trace_init();
+}
+
+/* Dump the rings to a string, to be freed by the caller */
+static char *
+trace_dump(void)
+{
+	char	*buf = NULL;
+	size_t	 len = 0;
+	FILE	*fp;
+
+	fp = open_memstream(&buf, &len);
+	assert_non_null(fp);
+	dss_trace_dump(fp);
+	fclose(fp);
+
+	return buf;
+}
+
+/*
+ * Tests
+ */
+static void
+test_trace_untraced(void **state)
+{
+	char *dump;
+
+	trace_setup(NULL, NULL);
+
+	/* requests without a trace ID are not recorded */
+	dss_trace_mark(0, 0x1234, DSS_TRACE_RECV);
+	dss_trace_mark(0, 0x1234, DSS_TRACE_DONE);
+	assert_null(test_dx.dx_trace);
+	assert_int_equal(mock_metrics_nr, 0);
+
+	dump = trace_dump();
+	assert_string_equal(dump, "== Traced requests ==\n");
+	free(dump);
+}
+
+static void
+test_trace_disabled(void **state)
+{
+	trace_setup("0", NULL);
+
+	dss_trace_mark(0x11, 0x1234, DSS_TRACE_RECV);
+	dss_trace_mark(0x11, 0x1234, DSS_TRACE_DONE);
+	assert_null(test_dx.dx_trace);
+}
+
+static void
+test_trace_ring_wrap(void **state)
+{
+	char	 line[64];
+	char	*dump;
+	int	 i;
+
+	/* rounded up to 8 records */
+	trace_setup("5", NULL);
+
+	for (i = 1; i <= 20; i++)
+		dss_trace_mark(i, 0x1234, DSS_TRACE_START);
+	assert_non_null(test_dx.dx_trace);
+
+	dump = trace_dump();
+	print_message("%s", dump);
+	assert_non_null(strstr(dump, "20 records"));
+
+	/* only the last 8 records are kept */
+	for (i = 1; i <= 20; i++) {
+		snprintf(line, sizeof(line), "\n" DF_X64 " opc 0x1234 start ", (uint64_t)i);
+		if (i <= 12)
+			assert_null(strstr(dump, line));
+		else
+			assert_non_null(strstr(dump, line));
+	}
+	free(dump);
+}
+
+static void
+test_trace_stages(void **state)
+{
+	struct mock_metric	*metric;
+	char			 line[64];
+	char			*dump;
+
+	trace_setup("16", "1");
+
+	dss_trace_mark(0x42, 0x1234, DSS_TRACE_RECV);
+	usleep(2000);
+	dss_trace_mark(0x42, 0x1234, DSS_TRACE_START);
+	/* records of another request in between */
+	dss_trace_mark(0x43, 0x1234, DSS_TRACE_RECV);
+	usleep(4000);
+	dss_trace_mark(0x42, 0x1234, DSS_TRACE_IO_PREP);
+	dss_trace_mark(0x42, 0x1234, DSS_TRACE_DONE);
+
+	/* the time spent in each stage is published once the request is done */
+	metric = mock_metric_find("trace/recv/xs_0");
+	assert_int_equal(metric->mm_nr, 1);
+	assert_true(metric->mm_value >= 2000);
+	metric = mock_metric_find("trace/start/xs_0");
+	assert_int_equal(metric->mm_nr, 1);
+	assert_true(metric->mm_value >= 4000);
+	metric = mock_metric_find("trace/io_prep/xs_0");
+	assert_int_equal(metric->mm_nr, 1);
+	metric = mock_metric_find("trace/bulk/xs_0");
+	assert_int_equal(metric->mm_nr, 0);
+
+	/* slower than 1us */
+	metric = mock_metric_find("trace/slow/xs_0");
+	assert_int_equal(metric->mm_value, 1);
+
+	dump = trace_dump();
+	assert_non_null(strstr(dump, "5 records"));
+	snprintf(line, sizeof(line), "\n" DF_X64 " opc 0x1234 recv ", (uint64_t)0x43);
+	assert_non_null(strstr(dump, line));
+	free(dump);
+
+	/* a fast request is published but not counted as slow */
+	trace_setup("16", "1000000");
+	dss_trace_mark(0x44, 0x1234, DSS_TRACE_RECV);
+	dss_trace_mark(0x44, 0x1234, DSS_TRACE_DONE);
+	metric = mock_metric_find("trace/recv/xs_0");
+	assert_int_equal(metric->mm_nr, 1);
+	metric = mock_metric_find("trace/slow/xs_0");
+	assert_int_equal(metric->mm_value, 0);
+}
+
+static int
+setup(void **state)
+{
+	daos_srv_modkey.dmk_index = 0;
+	test_dtls_values[0]       = &test_dmi;
+	test_dmi.dmi_xstream      = &test_dx;
+	test_dx.dx_xs_id          = 0;
+	strncpy(test_dx.dx_name, "test_xs", sizeof(test_dx.dx_name) - 1);
+
+	return d_log_init();
+}
+
+static int
+teardown(void **state)
+{
+	dss_trace_ring_free(&test_dx);
+	d_log_fini();
+
+	return 0;
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test(test_trace_untraced),
+	    cmocka_unit_test(test_trace_disabled),
+	    cmocka_unit_test(test_trace_ring_wrap),
+	    cmocka_unit_test(test_trace_stages),
+	};
+
+	return cmocka_run_group_tests_name("engine_srv_trace", tests, setup, teardown);
+}
@@ -1356,6 +1356,58 @@ d_tm_print_gauge(uint64_t val, struct d_tm_stats_t *stats, char *name,
 		d_tm_print_stats(stream, stats, format);
 }
 
+/**
+ * Prints the sample count and the percentiles of the log-linear histogram
+ * \a hist with \a name to the \a stream provided
+ *
+ * \param[in]	hist		Histogram to print
+ * \param[in]	name		Histogram name
+ * \param[in]	format		Output format.
+ *				Choose D_TM_STANDARD for standard output.
+ *				Choose D_TM_CSV for comma separated values.
+ * \param[in]	units		The units expressed as a string
+ * \param[in]	opt_fields	A bitmask.  Set to D_TM_INCLUDE_TYPE to display
+ *				metric type.
+ * \param[in]	stream		Output stream (stdout, stderr)
+ */
+void
+d_tm_print_loghist(struct d_tm_loghist_t *hist, char *name, int format,
+		   char *units, int opt_fields, FILE *stream)
+{
+	uint64_t p50;
+	uint64_t p90;
+	uint64_t p99;
+	uint64_t p999;
+
+	if ((hist == NULL) || (name == NULL) || (stream == NULL))
+		return;
+
+	p50  = d_tm_loghist_percentile(hist, 50);
+	p90  = d_tm_loghist_percentile(hist, 90);
+	p99  = d_tm_loghist_percentile(hist, 99);
+	p999 = d_tm_loghist_percentile(hist, 99.9);
+
+	if (format == D_TM_CSV) {
+		fprintf(stream, "%s", name);
+		if (opt_fields & D_TM_INCLUDE_TYPE)
+			fprintf(stream, ",log_histogram");
+		fprintf(stream, ",%lu,%lu,%lu,%lu,%lu,%lu,%lu", hist->dtl_count,
+			hist->dtl_min, p50, p90, p99, p999, hist->dtl_max);
+		return;
+	}
+
+	if (opt_fields & D_TM_INCLUDE_TYPE)
+		fprintf(stream, "type: log_histogram, ");
+	fprintf(stream, "%s: samples: %lu", name, hist->dtl_count);
+	if (hist->dtl_count == 0)
+		return;
+	fprintf(stream, " [min: %lu, p50: %lu, p90: %lu, p99: %lu, p99.9: %lu, max: %lu, avg: %.0lf]",
+		hist->dtl_min, p50, p90, p99, p999, hist->dtl_max,
+		(double)hist->dtl_sum / hist->dtl_count);
+	if (units != NULL)
+		fprintf(stream, " %s", units);
+}
+
 /**
  * Client function to print the metadata strings \a desc and \a units
  * to the \a stream provided
@@ -1423,6 +1475,7 @@ d_tm_print_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level,
 	char               *desc           = NULL;
 	char               *units          = NULL;
 	struct d_tm_meminfo_t	meminfo;
+	struct d_tm_loghist_t	loghist;
 	bool                stats_printed  = false;
 	bool                show_timestamp = false;
 	bool                show_meta      = false;
@@ -1538,6 +1591,16 @@ d_tm_print_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level,
 		if (stats.sample_size > 0)
 			stats_printed = true;
 		break;
+	case D_TM_LOG_HISTOGRAM:
+		rc = d_tm_get_loghist(ctx, &loghist, node);
+		if (rc != DER_SUCCESS) {
+			fprintf(stream, "Error on log histogram read: %d\n", rc);
+			break;
+		}
+		d_tm_print_loghist(&loghist, name, format, units, opt_fields,
+				   stream);
+		stats_printed = true;
+		break;
 	default:
 		fprintf(stream, "Item: %s has unknown type: 0x%x\n", name,
 			node->dtn_type);
@@ -1634,6 +1697,7 @@ _reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node)
 	struct d_tm_stats_t	*dtm_stats = NULL;
 	struct d_tm_histogram_t *dtm_histogram = NULL;
 	struct d_tm_mem_hdr     *mem_hdr       = NULL;
+	struct d_tm_loghist_t	*loghist;
 	int			 rc;
 
 	if (ctx == NULL || node == NULL)
@@ -1649,8 +1713,11 @@ _reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node)
 
 	dtm_stats     = conv_ptr(mem_hdr, metric_data->dtm_stats);
 	dtm_histogram = conv_ptr(mem_hdr, metric_data->dtm_histogram);
+	loghist       = conv_ptr(mem_hdr, metric_data->dtm_loghist);
 	d_tm_node_lock(node);
 	memset(&metric_data->dtm_data, 0, sizeof(metric_data->dtm_data));
+	if (loghist != NULL)
+		memset(loghist, 0, sizeof(*loghist));
 	if (dtm_stats != NULL)
 		memset(dtm_stats, 0, sizeof(*dtm_stats));
 
@@ -1700,6 +1767,7 @@ d_tm_reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level, c
 	case (D_TM_DURATION | D_TM_CLOCK_THREAD_CPUTIME):
 	case D_TM_GAUGE:
 	case D_TM_STATS_GAUGE:
+	case D_TM_LOG_HISTOGRAM:
 		_reset_node(ctx, node);
 		break;
 	default:
@@ -2240,6 +2308,136 @@ d_tm_dec_gauge(struct d_tm_node_t *metric, uint64_t value)
 	d_tm_node_unlock(metric);
 }
 
+/* Index of the log-linear histogram bucket accounting \a value */
+static inline int
+loghist_index(uint64_t value)
+{
+	int msb;
+	int idx;
+
+	if (value < (1ULL << D_TM_LOGHIST_SUB_BITS))
+		return value;
+
+	msb = 63 - __builtin_clzll(value);
+	idx = ((msb - D_TM_LOGHIST_SUB_BITS + 1) << D_TM_LOGHIST_SUB_BITS) +
+	      ((value >> (msb - D_TM_LOGHIST_SUB_BITS)) & ((1ULL << D_TM_LOGHIST_SUB_BITS) - 1));
+
+	return min(idx, D_TM_LOGHIST_BUCKETS - 1);
+}
+
+/* Largest value accounted in log-linear histogram bucket \a idx */
+static inline uint64_t
+loghist_bucket_max(int idx)
+{
+	uint64_t group = idx >> D_TM_LOGHIST_SUB_BITS;
+	uint64_t sub   = idx & ((1ULL << D_TM_LOGHIST_SUB_BITS) - 1);
+
+	if (group == 0)
+		return sub;
+	if (idx == D_TM_LOGHIST_BUCKETS - 1)
+		return UINT64_MAX;
+
+	return (((1ULL << D_TM_LOGHIST_SUB_BITS) + sub + 1) << (group - 1)) - 1;
+}
+
+/**
+ * Account \a value in a log-linear histogram
+ *
+ * \param[in,out]	metric	Pointer to the metric
+ * \param[in]		value	Sample to record
+ */
+void
+d_tm_record_loghist(struct d_tm_node_t *metric, uint64_t value)
+{
+	struct d_tm_loghist_t *hist;
+
+	if (metric == NULL)
+		return;
+
+	if (metric->dtn_type != D_TM_LOG_HISTOGRAM) {
+		D_ERROR("Failed to record value in histogram [%s] on item "
+			"not a log histogram.  Operation mismatch: " DF_RC "\n",
+			metric->dtn_name, DP_RC(-DER_OP_NOT_PERMITTED));
+		return;
+	}
+
+	hist = metric->dtn_metric->dtm_loghist;
+	d_tm_node_lock(metric);
+	if (hist->dtl_count == 0 || value < hist->dtl_min)
+		hist->dtl_min = value;
+	if (value > hist->dtl_max)
+		hist->dtl_max = value;
+	hist->dtl_count++;
+	hist->dtl_sum += value;
+	hist->dtl_buckets[loghist_index(value)]++;
+	d_tm_node_unlock(metric);
+}
+
+/**
+ * Merge log-linear histogram \a from into \a hist, e.g. to aggregate the
+ * histograms of several targets or engines.
+ *
+ * \param[in,out]	hist	Histogram to merge into
+ * \param[in]		from	Histogram to merge
+ */
+void
+d_tm_loghist_merge(struct d_tm_loghist_t *hist, const struct d_tm_loghist_t *from)
+{
+	int i;
+
+	if (hist == NULL || from == NULL || from->dtl_count == 0)
+		return;
+
+	if (hist->dtl_count == 0 || from->dtl_min < hist->dtl_min)
+		hist->dtl_min = from->dtl_min;
+	if (from->dtl_max > hist->dtl_max)
+		hist->dtl_max = from->dtl_max;
+	hist->dtl_count += from->dtl_count;
+	hist->dtl_sum += from->dtl_sum;
+	for (i = 0; i < D_TM_LOGHIST_BUCKETS; i++)
+		hist->dtl_buckets[i] += from->dtl_buckets[i];
+}
+
+/**
+ * Estimate a percentile of the values recorded in a log-linear histogram
+ *
+ * The estimate is the upper bound of the bucket holding the percentile,
+ * capped by the largest value recorded.
+ *
+ * \param[in]	hist		Histogram to read
+ * \param[in]	percentile	Percentile to compute, between 0 and 100
+ *
+ * \return			The percentile, 0 if the histogram is empty
+ */
+uint64_t
+d_tm_loghist_percentile(const struct d_tm_loghist_t *hist, double percentile)
+{
+	uint64_t rank;
+	uint64_t seen = 0;
+	int      i;
+
+	if (hist == NULL || hist->dtl_count == 0)
+		return 0;
+
+	if (percentile <= 0)
+		return hist->dtl_min;
+	if (percentile >= 100)
+		return hist->dtl_max;
+
+	/* nearest rank */
+	rank = (uint64_t)ceil(percentile / 100 * hist->dtl_count);
+	if (rank == 0)
+		rank = 1;
+
+	for (i = 0; i < D_TM_LOGHIST_BUCKETS; i++) {
+		seen += hist->dtl_buckets[i];
+		if (seen >= rank)
+			return min(max(loghist_bucket_max(i), hist->dtl_min), hist->dtl_max);
+	}
+
+	return hist->dtl_max;
+}
+
 /**
  * Convert a D_TM_CLOCK_* type into a clockid_t
  *
@@ -2415,6 +2613,15 @@ add_metric(struct d_tm_context *ctx, struct d_tm_node_t **node, int metric_type,
 		}
 	}
 
+	metric->dtm_loghist = NULL;
+	if (temp->dtn_type == D_TM_LOG_HISTOGRAM) {
+		metric->dtm_loghist = tm_alloc(mem_hdr, sizeof(struct d_tm_loghist_t));
+		if (metric->dtm_loghist == NULL) {
+			rc = -DER_NO_SHMEM;
+			goto out;
+		}
+	}
+
 	buff_len = 0;
 	if (desc != NULL)
 		buff_len = strnlen(desc, D_TM_MAX_DESC_LEN);
@@ -3796,6 +4003,55 @@ d_tm_get_gauge(struct d_tm_context *ctx, uint64_t *val,
 	return DER_SUCCESS;
 }
 
+/**
+ * Client function to read a copy of a log-linear histogram.
+ *
+ * \param[in]		ctx	Client context
+ * \param[out]		hist	The histogram is copied here
+ * \param[in]		node	Pointer to the stored metric node
+ *
+ * \return		DER_SUCCESS		Success
+ *			-DER_INVAL		Invalid input
+ *			-DER_METRIC_NOT_FOUND	Metric not found
+ *			-DER_OP_NOT_PERMITTED	Node is not a log histogram
+ */
+int
+d_tm_get_loghist(struct d_tm_context *ctx, struct d_tm_loghist_t *hist,
+		 struct d_tm_node_t *node)
+{
+	struct d_tm_metric_t	*metric_data = NULL;
+	struct d_tm_loghist_t	*dtm_loghist = NULL;
+	struct d_tm_mem_hdr	*mem_hdr = NULL;
+	int			 rc;
+
+	if (ctx == NULL || hist == NULL || node == NULL)
+		return -DER_INVAL;
+
+	rc = validate_node_ptr(ctx, node, &mem_hdr);
+	if (rc != 0)
+		return rc;
+
+	if (node->dtn_type != D_TM_LOG_HISTOGRAM)
+		return -DER_OP_NOT_PERMITTED;
+
+	if (unlikely(!node_is_readable(node)))
+		return -DER_AGAIN;
+
+	metric_data = conv_ptr(mem_hdr, node->dtn_metric);
+	if (metric_data == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	dtm_loghist = conv_ptr(mem_hdr, metric_data->dtm_loghist);
+	if (dtm_loghist == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	d_tm_node_lock(node);
+	*hist = *dtm_loghist;
+	d_tm_node_unlock(node);
+
+	return DER_SUCCESS;
+}
+
 /**
  * Client function to read the metadata for the specified metric.
  * Memory is allocated for the \a desc and \a units and should be freed by the
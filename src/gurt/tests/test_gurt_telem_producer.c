@@ -1238,6 +1238,65 @@ test_find_metric(void **state)
 	assert_null(node);
 }
 
+static void
+test_log_histogram(void **state)
+{
+	struct d_tm_node_t	*hist1;
+	struct d_tm_node_t	*hist2;
+	struct d_tm_loghist_t	lh1;
+	struct d_tm_loghist_t	lh2;
+	uint64_t		val;
+	int			rc;
+	int			i;
+
+	rc = d_tm_add_metric(&hist1, D_TM_LOG_HISTOGRAM, NULL, D_TM_MICROSECOND,
+			     "gurt/tests/telem/loghist-1");
+	assert_rc_equal(rc, 0);
+	rc = d_tm_add_metric(&hist2, D_TM_LOG_HISTOGRAM, NULL, D_TM_MICROSECOND,
+			     "gurt/tests/telem/loghist-2");
+	assert_rc_equal(rc, 0);
+
+	/* exact below 2^D_TM_LOGHIST_SUB_BITS */
+	for (i = 1; i <= 10; i++)
+		d_tm_record_loghist(hist1, i);
+	rc = d_tm_get_loghist(cli_ctx, &lh1, srv_to_cli_node(hist1));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(lh1.dtl_count, 10);
+	assert_int_equal(lh1.dtl_sum, 55);
+	assert_int_equal(lh1.dtl_min, 1);
+	assert_int_equal(lh1.dtl_max, 10);
+	assert_int_equal(d_tm_loghist_percentile(&lh1, 50), 5);
+	assert_int_equal(d_tm_loghist_percentile(&lh1, 100), 10);
+
+	/* 1000 values above, 1/16 relative error at most */
+	for (i = 1; i <= 1000; i++)
+		d_tm_record_loghist(hist2, 1000 * i);
+	d_tm_record_loghist(hist2, UINT64_MAX);
+	rc = d_tm_get_loghist(cli_ctx, &lh2, srv_to_cli_node(hist2));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(lh2.dtl_count, 1001);
+	assert_int_equal(lh2.dtl_max, UINT64_MAX);
+	val = d_tm_loghist_percentile(&lh2, 50);
+	assert_true(val >= 501000 && val <= 501000 + 501000 / 16);
+	val = d_tm_loghist_percentile(&lh2, 99);
+	assert_true(val >= 991000 && val <= 991000 + 991000 / 16);
+
+	d_tm_loghist_merge(&lh1, &lh2);
+	assert_int_equal(lh1.dtl_count, 1011);
+	assert_int_equal(lh1.dtl_min, 1);
+	assert_int_equal(lh1.dtl_max, UINT64_MAX);
+	assert_int_equal(d_tm_loghist_percentile(&lh1, 0.5), 6);
+
+	rc = d_tm_get_loghist(cli_ctx, &lh1, NULL);
+	assert_rc_equal(rc, -DER_INVAL);
+
+	d_tm_reset_node(cli_ctx, srv_to_cli_node(hist1), 0, NULL, D_TM_STANDARD, 0, stdout);
+	rc = d_tm_get_loghist(cli_ctx, &lh1, srv_to_cli_node(hist1));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(lh1.dtl_count, 0);
+	assert_int_equal(d_tm_loghist_percentile(&lh1, 99), 0);
+}
+
 static void
 test_verify_object_count(void **state)
 {
@@ -1249,6 +1308,7 @@ test_verify_object_count(void **state)
 	int			exp_num_dur = 2;
 	int			exp_num_timestamp = 2;
 	int			exp_num_snap = 2;
+	int			exp_num_loghist = 2;
 	int			exp_total;
 
 	exp_total = exp_num_ctr + exp_num_gauge + exp_num_dur +
@@ -1276,6 +1336,9 @@ test_verify_object_count(void **state)
 	num = d_tm_count_metrics(cli_ctx, node, D_TM_TIMER_SNAPSHOT);
 	assert_int_equal(num, exp_num_snap);
 
+	num = d_tm_count_metrics(cli_ctx, node, D_TM_LOG_HISTOGRAM);
+	assert_int_equal(num, exp_num_loghist);
+
 	num = d_tm_count_metrics(cli_ctx, node,
 				 D_TM_COUNTER | D_TM_GAUGE | D_TM_DURATION |
 				 D_TM_TIMESTAMP | D_TM_TIMER_SNAPSHOT);
@@ -1429,6 +1492,7 @@ main(int argc, char **argv)
 	    cmocka_unit_test(test_list_subdirs),
 	    cmocka_unit_test(test_follow_link),
 	    cmocka_unit_test(test_find_metric),
+	    cmocka_unit_test(test_log_histogram),
 	    cmocka_unit_test(test_verify_object_count),
 	    cmocka_unit_test(test_print_metrics),
 	    /* Run last since nothing can be written afterward */
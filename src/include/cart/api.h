@@ -412,6 +412,44 @@ crt_req_set_timeout(crt_rpc_t *req, uint32_t timeout_sec);
 int
 crt_req_get_timeout(crt_rpc_t *req, uint32_t *timeout_sec);
 
+/**
+ * Set the trace ID of an RPC request.
+ *
+ * A non-zero trace ID replaces the RPC ID of the request header, so that the
+ * stages of a request can be correlated across processes. Peers running a
+ * version that does not know about trace IDs only log it as the RPC ID.
+ *
+ * \param[in] req              pointer to RPC request
+ * \param[in] trace_id         trace ID, zero to not trace the request
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_req_set_trace_id(crt_rpc_t *req, uint64_t trace_id);
+
+/**
+ * Get the trace ID of an RPC request, zero if it is not traced.
+ *
+ * \param[in] req              pointer to RPC request
+ * \param[out] trace_id        trace ID
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_req_get_trace_id(crt_rpc_t *req, uint64_t *trace_id);
+
+/**
+ * Get the time a request was received, before it was queued for its handler.
+ *
+ * \param[in] req              pointer to RPC request
+ * \param[out] recv_time       receive time, see d_gettime(), zero if the
+ *                             request was not received by this process
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_req_get_recv_time(crt_rpc_t *req, struct timespec *recv_time);
+
 /**
  * Add reference of the RPC request.
  *
@@ -1066,6 +1104,29 @@ crt_bulk_access(crt_bulk_t bulk_hdl, d_sg_list_t *sgl);
 int
 crt_bulk_free(crt_bulk_t bulk_hdl);
 
+/**
+ * Drop cached memory registrations overlapping a buffer range.
+ *
+ * When the bulk registration cache is enabled (D_BULK_CACHE_SIZE, clients
+ * only, off by default), bulk handles created on a single contiguous buffer
+ * keep that buffer registered after crt_bulk_free(), and a later
+ * crt_bulk_create() on the same address, length and permissions reuses the
+ * registration. The cache cannot tell when memory is released, so callers
+ * enabling it must invalidate a range before it is unmapped, freed or
+ * otherwise returned to the system. Otherwise new memory mapped at the same
+ * address is served by the registration of the old pages. Bulk handles that
+ * are still in use remain valid until they are freed. This is a no-op when
+ * the cache is disabled.
+ *
+ * \param[in] buf              start of the range, NULL to drop all cached
+ *                             registrations
+ * \param[in] len              length of the range, must be 0 if \a buf is NULL
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_cache_invalidate(void *buf, size_t len);
+
 /**
  * Start a bulk transferring (inside an RPC handler).
  *
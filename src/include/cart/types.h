@@ -325,6 +325,23 @@ typedef enum {
  */
 #define CRT_RPC_FEAT_QUEUE_FRONT	(1U << 3)
 
+/**
+ * The RPC is small and latency tolerant. When coalescing is enabled through
+ * D_RPC_COALESCE_DELAY, it may be held back for up to that delay and sent along
+ * with other RPCs to the same endpoint in a single network request. Ignored for
+ * one-way RPCs and corpcs.
+ */
+#define CRT_RPC_FEAT_COALESCE		(1U << 4)
+
+/**
+ * The RPC may be delivered in process when sent by an engine to one of its own
+ * contexts: the handler gets the input of the origin RPC as is, without any
+ * serialization, so whatever it points to shall stay valid until the RPC
+ * completes on the origin. The reply is still copied back. Ignored for one-way
+ * RPCs and corpcs, and when D_RPC_LOCAL is set to 0.
+ */
+#define CRT_RPC_FEAT_LOCAL		(1U << 5)
+
 typedef void *crt_bulk_opid_t;
 
 /** Bulk transfer permissions */
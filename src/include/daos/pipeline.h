@@ -24,4 +24,7 @@ dc_pipeline_check(daos_pipeline_t *pipeline);
 int
 dc_pipeline_run(tse_task_t *api_task);
 
+int
+dc_pipeline_run_cont(tse_task_t *api_task);
+
 #endif /* __DD_PIPE_H__ */
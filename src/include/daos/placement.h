@@ -98,6 +98,8 @@ struct pl_map {
 	struct pool_map		*pl_poolmap;
 	/** placement map operations */
 	struct pl_map_ops       *pl_ops;
+	/** cache of computed object layouts, NULL if disabled */
+	struct pl_layout_cache  *pl_lcache;
 };
 
 /** attributes of the placement map */
@@ -120,6 +122,7 @@ enum pl_layout_gen_bits {
 
 int pl_init(void);
 void pl_fini(void);
+void pl_layout_cache_size_set(unsigned int size);
 
 int pl_map_create(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 		  struct pl_map **pl_mapp);
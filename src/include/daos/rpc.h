@@ -69,15 +69,15 @@ enum daos_module_id {
 #define DAOS_VOS_VERSION      1
 #define DAOS_MGMT_VERSION     4
 #define DAOS_POOL_VERSION     7
-#define DAOS_CONT_VERSION     9
-#define DAOS_OBJ_VERSION      10
+#define DAOS_CONT_VERSION     10
+#define DAOS_OBJ_VERSION      11
 #define DAOS_REBUILD_VERSION  5
 #define DAOS_RSVC_VERSION     5
 #define DAOS_RDB_VERSION      5
 #define DAOS_RDBT_VERSION     3
 #define DAOS_SEC_VERSION      1
 #define DAOS_DTX_VERSION      4
-#define DAOS_PIPELINE_VERSION 1
+#define DAOS_PIPELINE_VERSION 2
 #define DAOS_CHK_VERSION      1
 
 #define DAOS_MAX_PROTOCOLS    2
@@ -166,6 +166,10 @@ daos_opc_to_module_str(uint32_t daos_opc)
 enum daos_rpc_flags {
 	/** flag of reply disabled */
 	DAOS_RPC_NO_REPLY	= CRT_RPC_FEAT_NO_REPLY,
+	/** flag of small request which may be coalesced with others */
+	DAOS_RPC_COALESCE	= CRT_RPC_FEAT_COALESCE,
+	/** flag of request which may be delivered in process to the local engine */
+	DAOS_RPC_LOCAL		= CRT_RPC_FEAT_LOCAL,
 };
 
 struct daos_rpc_handler {
@@ -764,6 +764,57 @@ daos_cont_snap_oit_create(daos_handle_t coh, daos_epoch_t epoch, char *name,
 int
 daos_cont_snap_oit_destroy(daos_handle_t coh, daos_handle_t oh, daos_event_t *ev);
 
+/** The object is punched, or does not exist anymore, at the end of the epoch range */
+#define DAOS_CONT_DIFF_PUNCHED	(1U << 0)
+
+/** Object modified in the epoch range passed to daos_cont_diff() */
+typedef struct {
+	/** Object ID */
+	daos_obj_id_t	de_oid;
+	/** Last epoch the object was modified at, may be past the end of the range */
+	daos_epoch_t	de_epoch;
+	/** DAOS_CONT_DIFF_* flags */
+	uint32_t	de_flags;
+	uint32_t	de_pad;
+} daos_cont_diff_entry_t;
+
+/**
+ * List the objects of the container modified by updates or punches in the epoch range
+ * (\a epr->epr_lo, \a epr->epr_hi], typically between two snapshots, so that an incremental
+ * backup only has to copy those objects. The epochs of the dkeys and extents of each object
+ * are kept by VOS, the changed ones can be enumerated with the same epoch range.
+ *
+ * The objects are listed per target of the pool, so that all targets can be scanned in
+ * parallel with one call per target. Each redundancy group of an object is reported by a single
+ * target, the one of its first healthy replica, or its last healthy parity shard for erasure
+ * coded objects.
+ *
+ * \param[in]	coh	Container open handle.
+ * \param[in]	epr	Epoch range, \a epr->epr_lo is excluded.
+ * \param[in]	tgt	Index of the target in the pool, from 0 to the number of
+ *			targets returned by daos_pool_query() (excluded).
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, it should be set to zeroes for the
+ *			first call, it should not be changed by caller between calls.
+ * \param[in,out]
+ *		nr	[in]: number of entries in \a entries. [out]: number of returned entries.
+ * \param[out]	entries	Modified objects.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			The function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid container handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NONEXIST	Invalid target index
+ *			-DER_UNREACH	The target is not available
+ */
+int
+daos_cont_diff(daos_handle_t coh, const daos_epoch_range_t *epr, uint32_t tgt,
+	       daos_anchor_t *anchor, uint32_t *nr, daos_cont_diff_entry_t *entries,
+	       daos_event_t *ev);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -335,6 +335,38 @@ daos_pipeline_run(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline
 		  d_sg_list_t *sgl_keys, d_sg_list_t *sgl_recx, daos_size_t *recx_size,
 		  d_sg_list_t *sgl_agg, daos_pipeline_stats_t *stats, daos_event_t *ev);
 
+/**
+ * Runs a pipeline on all the objects of a container, returning aggregated results. The pipeline
+ * is broadcast to all engines of the pool, each engine scans the objects of its targets in
+ * parallel, and the partial aggregates are merged on the way back. Only the first healthy replica
+ * of each redundancy group is scanned, EC objects are skipped.
+ *
+ * \params[in]		coh		Container open handle.
+ *
+ * \param[in]		pipeline	Pipeline object. It must have at least one, and at most
+ *					16 aggregation filters.
+ *
+ * \param[in]		flags		Conditional operations.
+ *
+ * \param[in]		nr_iods		Number of I/O descriptors in the iods table.
+ *
+ * \param[in]		iods		Array of I/O descriptors of the akeys used by the filters.
+ *
+ * \param[in,out]	sgl_agg		[in]: Preallocated array of iovs for aggregated values,
+ *					one per aggregation filter, see daos_pipeline_run().
+ *					[out]: All returned aggregated values.
+ *
+ * \param[out]		stats		[in]: Optional preallocated object.
+ *					[out]: The total number of objects and dkeys scanned.
+ *
+ * \param[in]		ev		Completion event. It is optional. Function will run in
+ *					blocking mode if \a ev is NULL.
+ */
+int
+daos_pipeline_run_cont(daos_handle_t coh, daos_pipeline_t *pipeline, uint64_t flags,
+		       uint32_t nr_iods, daos_iod_t *iods, d_sg_list_t *sgl_agg,
+		       daos_pipeline_stats_t *stats, daos_event_t *ev);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -349,6 +349,10 @@ ds3_bucket_set_info(struct ds3_bucket_info *info, ds3_bucket_t *ds3b, daos_event
 /**
  * List S3 objects stored in the S3 bucket identified by \a ds3b.
  *
+ * Objects are returned in lexical order of their keys from the ordered key index of the bucket.
+ * Buckets created without it are listed by walking their directories, in which case \a delim can
+ * only be "/".
+ *
  * \param[in,out]
  *		nobj	[in]:	\a objs length in items.
  *			[out]:	Number of objects returned.
@@ -589,6 +593,31 @@ int
 ds3_upload_get_info(struct ds3_multipart_upload_info *info, const char *bucket_name,
 		    const char *upload_id, ds3_t *ds3);
 
+/**
+ * Complete the S3 multipart upload identified by \a upload_id into the object \a key of the
+ * bucket identified by \a ds3b, without copying the data of its parts.
+ *
+ * The object reads its data from the parts, which are kept until the object is destroyed or
+ * overwritten, and cannot be written.  The upload entry is kept, without its parts, until it is
+ * removed by ds3_upload_remove().
+ *
+ * \param[in]	bucket_name	Name of the bucket.
+ * \param[in]	upload_id	ID of the upload.
+ * \param[in]	npart		Number of parts of the object.
+ * \param[in]	part_nums	Numbers of the parts, in the order of the object data.
+ * \param[in]	key		Key of the S3 object to create.
+ * \param[out]	size		(Optional) Size of the object.
+ * \param[out]	ds3o		Returned S3 object handle.
+ * \param[in]	ds3b		Pointer to the S3 bucket handle to use.
+ * \param[in]	ds3		Pointer to the DAOS S3 pool handle to use.
+ *
+ * \return			0 on success, -errno code on failure.
+ */
+int
+ds3_upload_complete(const char *bucket_name, const char *upload_id, uint32_t npart,
+		    const uint64_t *part_nums, const char *key, daos_size_t *size,
+		    ds3_obj_t **ds3o, ds3_bucket_t *ds3b, ds3_t *ds3);
+
 /**
  * Open an S3 multipart part identified by \a part_num.
  *
@@ -113,6 +113,10 @@ struct ds_cont_child {
 
 	uint32_t		 sc_dtx_committable_count;
 	uint32_t		 sc_dtx_committable_coll_count;
+	/* Committable DTX entries ever added, to measure their rate. */
+	uint64_t		 sc_dtx_committable_total;
+	/* Batch of committable DTX entries for the batched commit, zero before adapted. */
+	uint32_t		 sc_dtx_cmt_batch;
 
 	/* Last timestamp when EC aggregation reports -DER_INPROGRESS. */
 	uint64_t		 sc_ec_agg_busy_ts;
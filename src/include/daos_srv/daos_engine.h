@@ -300,6 +300,15 @@ void sched_cond_wait_for_business(ABT_cond cond, ABT_mutex mutex);
  */
 uint64_t sched_cur_msec(void);
 
+/**
+ * Report the service latency of a foreground I/O request handled by current
+ * xstream, it's used to throttle rebuild & aggregation when the latency target
+ * (DAOS_SCHED_QOS_LATENCY) is set.
+ *
+ * \param[in] usecs	Latency in micro-seconds.
+ */
+void sched_io_lat_record(uint64_t usecs);
+
 /**
  * Get current schedule sequence, by comparing the results of two
  * sched_cur_seq() calls, we can tell if an ULT was yielding between
@@ -634,6 +643,49 @@ void dss_rpc_cntr_enter(enum dss_rpc_cntr_id id);
 void dss_rpc_cntr_exit(enum dss_rpc_cntr_id id, bool failed);
 struct dss_rpc_cntr *dss_rpc_cntr_get(enum dss_rpc_cntr_id id);
 
+/**
+ * Stages of a traced request, see crt_req_set_trace_id(). Each stage is
+ * recorded with a timestamp in a per-xstream ring, the time spent between
+ * two stages is charged to the former.
+ */
+enum dss_trace_stage {
+	/** queued to the scheduler */
+	DSS_TRACE_RECV = 0,
+	/** handler started */
+	DSS_TRACE_START,
+	/** DTX leader forwarding to the other targets */
+	DSS_TRACE_FWD,
+	/** DMA buffer reserved, NVMe read for fetch */
+	DSS_TRACE_IO_PREP,
+	/** bulk transfer */
+	DSS_TRACE_BULK,
+	/** NVMe write for update */
+	DSS_TRACE_IO_POST,
+	/** local update committed, WAL commit included */
+	DSS_TRACE_COMMIT,
+	/** reply of a remote target, see srv_obj_remote.c */
+	DSS_TRACE_RMT_DONE,
+	/** all targets done */
+	DSS_TRACE_FWD_DONE,
+	/** DTX leader validating the DTX and adding it to the CoS cache */
+	DSS_TRACE_DTX_END,
+	/** DTX leader committing the DTX synchronously */
+	DSS_TRACE_DTX_SYNC,
+	/** handler done, shall be the last stage */
+	DSS_TRACE_DONE,
+	DSS_TRACE_STAGE_MAX,
+};
+
+void dss_trace_record(uint64_t trace_id, uint32_t opc, enum dss_trace_stage stage);
+
+/** Record \a stage of the request traced by \a trace_id on the current xstream */
+static inline void
+dss_trace_mark(uint64_t trace_id, uint32_t opc, enum dss_trace_stage stage)
+{
+	if (unlikely(trace_id != 0))
+		dss_trace_record(trace_id, opc, stage);
+}
+
 int dss_rpc_send(crt_rpc_t *rpc);
 int dss_rpc_reply(crt_rpc_t *rpc, unsigned int fail_loc);
 
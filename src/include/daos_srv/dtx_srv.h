@@ -165,7 +165,10 @@ struct dtx_handle {
 	/* DTX list to be checked */
 	d_list_t			 dth_share_tbd_list;
 	int                               dth_share_tbd_count;
-	uint32_t                          padding5;
+	/* Opcode of the traced request. */
+	uint32_t                          dth_trace_opc;
+	/* Trace ID of the request, zero if not traced, see dss_trace_mark(). */
+	uint64_t                          dth_trace_id;
 };
 /* clang-format on */
 
@@ -236,7 +239,7 @@ struct dtx_leader_handle {
 	struct dtx_sub_status		*dlh_subs;
 };
 
-_Static_assert(sizeof(struct dtx_leader_handle) == 360,
+_Static_assert(sizeof(struct dtx_leader_handle) == 368,
 	       "The size of this structure may be tracked by other modules e.g. telemetry");
 
 struct dtx_stat {
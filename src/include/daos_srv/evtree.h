@@ -382,6 +382,8 @@ struct evt_entry_array {
 	uint32_t			 ea_max;
 	/** Number of bytes per index */
 	uint32_t                         ea_inob;
+	/** Number of overlapping extents skipped because they are not available */
+	uint32_t                         ea_unavail_nr;
 	/* Small array of embedded entries */
 	struct evt_list_entry		 ea_embedded_ents[0];
 };
@@ -640,6 +642,20 @@ int evt_remove_all(daos_handle_t toh, const struct evt_extent *ext,
 int evt_find(daos_handle_t toh, const struct evt_filter *filter,
 	     struct evt_entry_array *ent_array);
 
+/**
+ * Fill \a ent_array with visible entries returned by a previous evt_find()
+ * over a wider extent, clipped to \a ext.  Entries which don't overlap with
+ * \a ext are skipped.
+ *
+ * \param ent_array	[IN,OUT]	Pass in initialized list
+ * \param ents		[IN]		Sorted visible entries
+ * \param nr		[IN]		Number of entries in \a ents
+ * \param inob		[IN]		Number of bytes per index
+ * \param ext		[IN]		The extent to clip entries to
+ */
+int evt_ent_array_load(struct evt_entry_array *ent_array, const struct evt_entry *ents,
+		       uint32_t nr, uint32_t inob, const struct evt_extent *ext);
+
 /**
  * Debug function, it outputs status of tree nodes at level \a debug_level,
  * or all levels if \a debug_level is negative.
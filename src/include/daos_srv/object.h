@@ -83,15 +83,22 @@ int
 ds_object_migrate_send(struct ds_pool *pool, uuid_t pool_hdl_uuid, uuid_t cont_uuid,
 		       uuid_t cont_hdl_uuid, int tgt_id, uint32_t version, unsigned int generation,
 		       uint64_t max_eph, daos_unit_oid_t *oids, daos_epoch_t *ephs,
-		       daos_epoch_t *punched_ephs, unsigned int *shards, int cnt,
-		       uint32_t new_gl_ver, unsigned int migrate_opc, uint64_t *enqueue_id,
+		       daos_epoch_t *punched_ephs, daos_epoch_t *last_ephs, unsigned int *shards,
+		       int cnt, uint32_t new_gl_ver, unsigned int migrate_opc, uint64_t *enqueue_id,
 		       uint32_t *max_delay);
 int
 ds_migrate_object(uuid_t pool_uuid, uuid_t po_hdl, uuid_t co_hdl, uuid_t co_uuid, uint32_t version,
 		  uint32_t generation, uint64_t max_eph, uint32_t opc, daos_unit_oid_t *oids,
-		  daos_epoch_t *epochs, daos_epoch_t *punched_epochs, unsigned int *shards,
-		  uint32_t count, unsigned int tgt_idx, uint32_t new_gl_ver);
+		  daos_epoch_t *epochs, daos_epoch_t *punched_epochs, daos_epoch_t *last_epochs,
+		  unsigned int *shards, uint32_t count, unsigned int tgt_idx, uint32_t new_gl_ver);
 void
 ds_migrate_stop(struct ds_pool *pool, uint32_t ver, unsigned int generation);
+bool
+ds_migrate_push_enabled(void);
+int
+ds_migrate_push_object(uuid_t pool_uuid, uuid_t cont_uuid, daos_handle_t coh, uint32_t version,
+		       uint32_t generation, daos_epoch_t epoch, daos_epoch_t punched_eph,
+		       daos_unit_oid_t oid, unsigned int shard, d_rank_t rank,
+		       unsigned int tgt_idx);
 
 #endif /* __DAOS_SRV_OBJ_H__ */
@@ -127,6 +127,9 @@ typedef enum {
 
 	/** Pipeline APIs */
 	DAOS_OPC_PIPELINE_RUN,
+	DAOS_OPC_PIPELINE_RUN_CONT,
+
+	DAOS_OPC_CONT_DIFF,
 
 	DAOS_OPC_MAX
 } daos_opc_t;
@@ -565,6 +568,22 @@ typedef struct {
 	daos_epoch_t		epoch;
 } daos_cont_snap_oit_destroy_t;
 
+/** Container diff args */
+typedef struct {
+	/** Container open handle. */
+	daos_handle_t		 coh;
+	/** Epoch range, epr_lo is excluded. */
+	daos_epoch_range_t	 epr;
+	/** Index of the target in the pool. */
+	uint32_t		 tgt;
+	/** [in]: number of entries. [out]: number of returned entries. */
+	uint32_t		*nr;
+	/** Anchor for the next call. */
+	daos_anchor_t		*anchor;
+	/** Modified objects. */
+	daos_cont_diff_entry_t	*entries;
+} daos_cont_diff_t;
+
 /** Transaction Open args */
 typedef struct {
 	/** Container open handle. */
@@ -1084,6 +1103,24 @@ typedef struct {
 	daos_pipeline_stats_t		*stats;
 } daos_pipeline_run_t;
 
+/** Container-wide pipeline run args */
+typedef struct {
+	/** container open handle */
+	daos_handle_t			coh;
+	/** pipeline object */
+	daos_pipeline_t			*pipeline;
+	/** conditional operations */
+	uint64_t			flags;
+	/** number of I/O descriptors */
+	uint32_t			nr_iods;
+	/** akeys */
+	daos_iod_t			*iods;
+	/** aggregations */
+	d_sg_list_t			*sgl_agg;
+	/** returned pipeline stats  */
+	daos_pipeline_stats_t		*stats;
+} daos_pipeline_run_cont_t;
+
 /**
  * Create an asynchronous task and associate it with a daos client operation.
  * For synchronous operations please use the specific API for that operation.
@@ -143,6 +143,7 @@ enum {
 	D_TM_CLOCK_THREAD_CPUTIME	= 0x200,
 	D_TM_LINK			= 0x400,
 	D_TM_MEMINFO			= 0x800,
+	D_TM_LOG_HISTOGRAM		= 0x1000,
 	D_TM_ALL_NODES			= (D_TM_DIRECTORY | \
 					   D_TM_COUNTER | \
 					   D_TM_TIMESTAMP | \
@@ -151,7 +152,8 @@ enum {
 					   D_TM_GAUGE | \
 					   D_TM_STATS_GAUGE | \
 					   D_TM_LINK | \
-					   D_TM_MEMINFO)
+					   D_TM_MEMINFO | \
+					   D_TM_LOG_HISTOGRAM)
 };
 
 enum {
@@ -220,6 +222,31 @@ struct d_tm_meminfo_t {
 	uint64_t fordblks;
 };
 
+/**
+ * Log-linear histograms split each power of two in 2^D_TM_LOGHIST_SUB_BITS
+ * linear buckets, which bounds the relative error of a percentile to
+ * 1/2^D_TM_LOGHIST_SUB_BITS. Values of D_TM_LOGHIST_VALUE_BITS bits or more
+ * are accounted in the last bucket.
+ */
+#define D_TM_LOGHIST_SUB_BITS		4
+#define D_TM_LOGHIST_VALUE_BITS		32
+#define D_TM_LOGHIST_BUCKETS                                                                       \
+	((D_TM_LOGHIST_VALUE_BITS - D_TM_LOGHIST_SUB_BITS + 1) << D_TM_LOGHIST_SUB_BITS)
+
+/**
+ * @brief Log-linear histogram
+ *
+ * Recording a value is O(1) and histograms with the same layout are merged
+ * by summing their buckets, see d_tm_loghist_merge().
+ */
+struct d_tm_loghist_t {
+	uint64_t	dtl_count;
+	uint64_t	dtl_sum;
+	uint64_t	dtl_min;
+	uint64_t	dtl_max;
+	uint64_t	dtl_buckets[D_TM_LOGHIST_BUCKETS];
+};
+
 struct d_tm_metric_t {
 	union data {
 		uint64_t	value;
@@ -230,6 +257,7 @@ struct d_tm_metric_t {
 	struct d_tm_histogram_t	*dtm_histogram;
 	char			*dtm_desc;
 	char			*dtm_units;
+	struct d_tm_loghist_t	*dtm_loghist; /** D_TM_LOG_HISTOGRAM only */
 };
 
 struct d_tm_node_t {
@@ -28,6 +28,12 @@ int d_tm_get_num_buckets(struct d_tm_context *ctx,
 int d_tm_get_bucket_range(struct d_tm_context *ctx,
 			  struct d_tm_bucket_t *bucket, int bucket_id,
 			  struct d_tm_node_t *node);
+int d_tm_get_loghist(struct d_tm_context *ctx, struct d_tm_loghist_t *hist,
+		     struct d_tm_node_t *node);
+void d_tm_loghist_merge(struct d_tm_loghist_t *hist,
+			const struct d_tm_loghist_t *from);
+uint64_t d_tm_loghist_percentile(const struct d_tm_loghist_t *hist,
+				 double percentile);
 
 /* Developer facing client API to discover topology and manage results */
 struct d_tm_context *d_tm_open(int id);
@@ -76,6 +82,8 @@ void d_tm_print_duration(struct timespec *tms, struct d_tm_stats_t *stats,
 			 FILE *stream);
 void d_tm_print_gauge(uint64_t val, struct d_tm_stats_t *stats, char *name,
 		      int format, char *units, int opt_fields, FILE *stream);
+void d_tm_print_loghist(struct d_tm_loghist_t *hist, char *name, int format,
+			char *units, int opt_fields, FILE *stream);
 void d_tm_print_metadata(char *desc, char *units, int format, FILE *stream);
 int d_tm_clock_id(int clk_id);
 char *d_tm_clock_string(int clk_id);
@@ -20,6 +20,7 @@ void d_tm_mark_duration_end(struct d_tm_node_t *metric);
 void d_tm_set_gauge(struct d_tm_node_t *metric, uint64_t value);
 void d_tm_inc_gauge(struct d_tm_node_t *metric, uint64_t value);
 void d_tm_dec_gauge(struct d_tm_node_t *metric, uint64_t value);
+void d_tm_record_loghist(struct d_tm_node_t *metric, uint64_t value);
 
 /* Other server functions */
 int d_tm_init(int id, uint64_t mem_size, int flags);
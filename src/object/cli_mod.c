@@ -23,6 +23,8 @@
 #include "obj_internal.h"
 
 unsigned int	obj_coll_thd;
+unsigned int	obj_trace_sample;
+uint64_t	obj_trace_salt;
 unsigned int	srv_io_mode = DIM_DTX_FULL_ENABLED;
 int		dc_obj_proto_version;
 
@@ -154,15 +156,15 @@ dc_obj_init(void)
 		D_GOTO(out_utils, rc);
 
 	dc_obj_proto_version = 0;
-	rc = daos_rpc_proto_query(obj_proto_fmt_v9.cpf_base, ver_array, 2, &dc_obj_proto_version);
+	rc = daos_rpc_proto_query(obj_proto_fmt_v10.cpf_base, ver_array, 2, &dc_obj_proto_version);
 	if (rc)
 		D_GOTO(out_class, rc);
 
 	if (dc_obj_proto_version == DAOS_OBJ_VERSION - 1) {
-		rc = daos_rpc_register(&obj_proto_fmt_v9, OBJ_PROTO_CLI_COUNT, NULL,
+		rc = daos_rpc_register(&obj_proto_fmt_v10, OBJ_PROTO_CLI_COUNT, NULL,
 				       DAOS_OBJ_MODULE);
 	} else if (dc_obj_proto_version == DAOS_OBJ_VERSION) {
-		rc = daos_rpc_register(&obj_proto_fmt_v10, OBJ_PROTO_CLI_COUNT, NULL,
+		rc = daos_rpc_register(&obj_proto_fmt_v11, OBJ_PROTO_CLI_COUNT, NULL,
 				       DAOS_OBJ_MODULE);
 	} else {
 		D_ERROR("%d version object RPC not supported.\n", dc_obj_proto_version);
@@ -179,9 +181,9 @@ dc_obj_init(void)
 	if (rc) {
 		D_ERROR("failed to obj_ec_codec_init: "DF_RC"\n", DP_RC(rc));
 		if (dc_obj_proto_version == DAOS_OBJ_VERSION - 1)
-			daos_rpc_unregister(&obj_proto_fmt_v9);
-		else
 			daos_rpc_unregister(&obj_proto_fmt_v10);
+		else
+			daos_rpc_unregister(&obj_proto_fmt_v11);
 		D_GOTO(out_class, rc);
 	}
 
@@ -206,6 +208,13 @@ dc_obj_init(void)
 
 	obj_init_iov_fragment_params();
 
+	obj_trace_sample = 0;
+	d_getenv_uint("DAOS_TRACE_SAMPLE", &obj_trace_sample);
+	if (obj_trace_sample != 0) {
+		obj_trace_salt = (((uint64_t)d_rand() << 32) ^ (uint64_t)d_rand()) | 1;
+		D_INFO("Trace one object I/O out of %u\n", obj_trace_sample);
+	}
+
 	tx_verify_rdg = false;
 	d_getenv_bool("DAOS_TX_VERIFY_RDG", &tx_verify_rdg);
 	D_INFO("%s TX redundancy group verification\n", tx_verify_rdg ? "Enable" : "Disable");
@@ -227,9 +236,9 @@ void
 dc_obj_fini(void)
 {
 	if (dc_obj_proto_version == DAOS_OBJ_VERSION - 1)
-		daos_rpc_unregister(&obj_proto_fmt_v9);
-	else
 		daos_rpc_unregister(&obj_proto_fmt_v10);
+	else
+		daos_rpc_unregister(&obj_proto_fmt_v11);
 	obj_ec_codec_fini();
 	obj_class_fini();
 	obj_utils_fini();
@@ -5471,6 +5471,9 @@ obj_task_init_common(tse_task_t *task, int opc, uint32_t map_ver,
 	obj_auxi->rebuilding = 0;
 	shard_task_list_init(obj_auxi);
 	obj_auxi->is_ec_obj = obj_is_ec(obj);
+	/* keep tracing the I/O across retries */
+	if (!obj_auxi->io_retry)
+		obj_auxi->traced = obj_trace_sampled();
 	*auxi = obj_auxi;
 
 	D_DEBUG(DB_IO, "client task %p init "DF_OID" opc 0x%x, try %d\n",
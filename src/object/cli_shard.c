@@ -1059,6 +1059,12 @@ out:
 	if (rc == -DER_CSUM && opc == DAOS_OBJ_RPC_FETCH)
 		dc_shard_csum_report(task, &rw_args->tgt_ep, rw_args->rpc);
 
+	if (rw_args->shard_args->auxi.obj_auxi->traced)
+		D_DEBUG(DB_IO, "rpc %p opc:%d trace " DF_X64 " rank:%d tag:%d done in %luus: %d\n",
+			rw_args->rpc, opc, obj_auxi_trace_id(rw_args->shard_args->auxi.obj_auxi),
+			rw_args->tgt_ep.ep_rank, rw_args->tgt_ep.ep_tag,
+			(daos_get_ntime() - rw_args->send_time) / NSEC_PER_USEC, ret == 0 ? rc : ret);
+
 	obj_shard_update_metrics_end(rw_args->rpc, rw_args->send_time, rw_args,
 				     ret == 0 ? rc : ret);
 
@@ -1137,6 +1143,12 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	if (DAOS_FAIL_CHECK(DAOS_SHARD_OBJ_FAIL))
 		D_GOTO(out_req, rc = -DER_INVAL);
 
+	if (auxi->obj_auxi->traced) {
+		rc = crt_req_set_trace_id(req, obj_auxi_trace_id(auxi->obj_auxi));
+		if (rc != 0)
+			D_GOTO(out_req, rc);
+	}
+
 	orw = crt_req_get(req);
 	D_ASSERT(orw != NULL);
 
@@ -1251,7 +1263,8 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	rw_args.shard_args = args;
 	/* remember the sgl to copyout the data inline for fetch */
 	rw_args.rwaa_sgls = sgls;
-	rw_args.send_time = daos_client_metric ? daos_get_ntime() : 0;
+	rw_args.send_time =
+	    (daos_client_metric || auxi->obj_auxi->traced) ? daos_get_ntime() : 0;
 	obj_shard_update_metrics_begin(req);
 	if (args->reasb_req && args->reasb_req->orr_recov) {
 		rw_args.maps = NULL;
@@ -44,6 +44,10 @@ extern bool	cli_bypass_rpc;
 /** Switch of server-side IO dispatch */
 extern unsigned int	srv_io_mode;
 extern unsigned int	obj_coll_thd;
+/** Trace one object I/O out of obj_trace_sample, zero to disable */
+extern unsigned int	obj_trace_sample;
+/** Random per-process part of the trace IDs, see obj_auxi_trace_id() */
+extern uint64_t		obj_trace_salt;
 extern btr_ops_t	dbtree_coll_ops;
 
 /** See comments in obj_sgls_dup(), tune iov merge conditions */
@@ -470,7 +474,7 @@ struct obj_auxi_args {
 	    nvme_io_err : 1, no_retry : 1, ec_wait_recov : 1, ec_in_recov : 1, rebuilding : 1,
 	    sub_anchors : 1, ec_degrade_fetch : 1, long_retry_delay : 1, cond_fetch_split : 1,
 	    cond_modify : 1, reintegrating : 1, tx_renew : 1, tx_convert : 1, req_dup_sgl : 1,
-	    for_migrate : 1;
+	    for_migrate : 1, traced : 1;
 	/* request flags. currently only: ORF_RESEND */
 	uint32_t                         specified_shard;
 	uint32_t                         flags;
@@ -510,6 +514,19 @@ D_CASSERT(sizeof(struct obj_auxi_args) + sizeof(struct shard_auxi_args) <=
 D_CASSERT(sizeof(struct obj_auxi_args) + sizeof(struct daos_task_args) <=
 	  TSE_TASK_ARG_LEN);
 
+/*
+ * The trace ID of a sampled I/O is derived from its task, which is kept across retries, so that
+ * obj_auxi_args does not grow. The salt has its low bit set, the ID is never zero.
+ */
+static inline uint64_t
+obj_auxi_trace_id(struct obj_auxi_args *obj_auxi)
+{
+	if (likely(!obj_auxi->traced))
+		return 0;
+
+	return obj_trace_salt ^ (uint64_t)(uintptr_t)obj_auxi->obj_task;
+}
+
 
 typedef int (*obj_enum_process_cb_t)(daos_key_desc_t *kds, void *ptr,
 				     unsigned int size, void *arg);
@@ -916,7 +933,11 @@ struct obj_io_context {
 	uint32_t		 ioc_map_ver;
 	uint32_t		 ioc_opc;
 	uint64_t		 ioc_start_time;
+	/* arrival time of the RPC, before it waited in the scheduler queue */
+	uint64_t		 ioc_recv_time;
 	uint64_t		 ioc_io_size;
+	/* see crt_req_get_trace_id(), zero if not traced */
+	uint64_t		 ioc_trace_id;
 	uint32_t		 ioc_began:1,
 				 ioc_update_ec_ts:1,
 				 ioc_free_sgls:1,
@@ -924,6 +945,19 @@ struct obj_io_context {
 				 ioc_fetch_snap:1;
 };
 
+/* Return true if the object I/O is sampled for tracing */
+static inline bool
+obj_trace_sampled(void)
+{
+	static __thread uint32_t	cnt;
+
+	if (likely(obj_trace_sample == 0) || ++cnt < obj_trace_sample)
+		return false;
+
+	cnt = 0;
+	return true;
+}
+
 static inline void
 obj_ptr2shards(struct dc_object *obj, uint32_t *start_shard, uint32_t *shard_nr,
 	       uint32_t *grp_nr)
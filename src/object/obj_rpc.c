@@ -1276,7 +1276,9 @@ CRT_RPC_DEFINE(obj_query_key_v10, DAOS_ISEQ_OBJ_QUERY_KEY_V10, DAOS_OSEQ_OBJ_QUE
 CRT_RPC_DEFINE(obj_sync, DAOS_ISEQ_OBJ_SYNC, DAOS_OSEQ_OBJ_SYNC)
 CRT_RPC_DEFINE(obj_sync_v10, DAOS_ISEQ_OBJ_SYNC_V10, DAOS_OSEQ_OBJ_SYNC_V10)
 CRT_RPC_DEFINE(obj_migrate, DAOS_ISEQ_OBJ_MIGRATE, DAOS_OSEQ_OBJ_MIGRATE)
+CRT_RPC_DEFINE(obj_migrate_v11, DAOS_ISEQ_OBJ_MIGRATE_V11, DAOS_OSEQ_OBJ_MIGRATE)
 CRT_RPC_DEFINE(obj_ec_agg, DAOS_ISEQ_OBJ_EC_AGG, DAOS_OSEQ_OBJ_EC_AGG)
+CRT_RPC_DEFINE(obj_migrate_push, DAOS_ISEQ_OBJ_MIGRATE_PUSH, DAOS_OSEQ_OBJ_MIGRATE_PUSH)
 CRT_RPC_DEFINE(obj_cpd, DAOS_ISEQ_OBJ_CPD, DAOS_OSEQ_OBJ_CPD)
 CRT_RPC_DEFINE(obj_ec_rep, DAOS_ISEQ_OBJ_EC_REP, DAOS_OSEQ_OBJ_EC_REP)
 CRT_RPC_DEFINE(obj_key2anchor, DAOS_ISEQ_OBJ_KEY2ANCHOR, DAOS_OSEQ_OBJ_KEY2ANCHOR)
@@ -1295,29 +1297,29 @@ CRT_RPC_DEFINE(obj_coll_query, DAOS_ISEQ_OBJ_COLL_QUERY, DAOS_OSEQ_OBJ_COLL_QUER
 	.prf_co_ops  = NULL,	\
 },
 
-static struct crt_proto_rpc_format obj_proto_rpc_fmt_v9[] = {
-	OBJ_PROTO_CLI_RPC_LIST(9)
-};
-
 static struct crt_proto_rpc_format obj_proto_rpc_fmt_v10[] = {
 	OBJ_PROTO_CLI_RPC_LIST(10)
 };
 
+static struct crt_proto_rpc_format obj_proto_rpc_fmt_v11[] = {
+	OBJ_PROTO_CLI_RPC_LIST(11)
+};
+
 #undef X
 
-struct crt_proto_format obj_proto_fmt_v9 = {
+struct crt_proto_format obj_proto_fmt_v10 = {
 	.cpf_name  = "daos-object",
 	.cpf_ver   = DAOS_OBJ_VERSION - 1,
-	.cpf_count = ARRAY_SIZE(obj_proto_rpc_fmt_v9),
-	.cpf_prf   = obj_proto_rpc_fmt_v9,
+	.cpf_count = ARRAY_SIZE(obj_proto_rpc_fmt_v10),
+	.cpf_prf   = obj_proto_rpc_fmt_v10,
 	.cpf_base  = DAOS_RPC_OPCODE(0, DAOS_OBJ_MODULE, 0)
 };
 
-struct crt_proto_format obj_proto_fmt_v10 = {
+struct crt_proto_format obj_proto_fmt_v11 = {
 	.cpf_name  = "daos-object",
 	.cpf_ver   = DAOS_OBJ_VERSION,
-	.cpf_count = ARRAY_SIZE(obj_proto_rpc_fmt_v10),
-	.cpf_prf   = obj_proto_rpc_fmt_v10,
+	.cpf_count = ARRAY_SIZE(obj_proto_rpc_fmt_v11),
+	.cpf_prf   = obj_proto_rpc_fmt_v11,
 	.cpf_base  = DAOS_RPC_OPCODE(0, DAOS_OBJ_MODULE, 0)
 };
 
@@ -85,7 +85,8 @@
 		0, ver == 9 ? &CQF_obj_punch : &CQF_obj_punch_v10,	\
 		ds_obj_tgt_punch_handler, NULL, "tgt_akey_punch")	\
 	X(DAOS_OBJ_RPC_MIGRATE,						\
-		0, &CQF_obj_migrate,					\
+		DAOS_RPC_LOCAL,						\
+		ver >= 11 ? &CQF_obj_migrate_v11 : &CQF_obj_migrate,	\
 		ds_obj_migrate_handler, NULL, "migrate")		\
 	X(DAOS_OBJ_RPC_EC_AGGREGATE,					\
 		0, &CQF_obj_ec_agg,					\
@@ -105,19 +106,24 @@
 		NULL, "obj_coll_punch")					\
 	X(DAOS_OBJ_RPC_COLL_QUERY,					\
 		0, &CQF_obj_coll_query, ds_obj_coll_query_handler,	\
-		NULL, "obj_coll_query")
+		NULL, "obj_coll_query")					\
+	X(DAOS_OBJ_RPC_MIGRATE_PUSH,					\
+		DAOS_RPC_LOCAL,						\
+		ver >= 11 ? &CQF_obj_migrate_push : NULL,		\
+		ver >= 11 ? ds_obj_migrate_push_handler : NULL,		\
+		NULL, "migrate_push")
 
 /* Define for RPC enum population below */
 #define X(a, b, c, d, e, f) a,
 enum obj_rpc_opc {
-	OBJ_PROTO_CLI_RPC_LIST(10)
+	OBJ_PROTO_CLI_RPC_LIST(11)
 	OBJ_PROTO_CLI_COUNT,
 	OBJ_PROTO_CLI_LAST = OBJ_PROTO_CLI_COUNT - 1,
 };
 #undef X
 
-extern struct crt_proto_format obj_proto_fmt_v9;
 extern struct crt_proto_format obj_proto_fmt_v10;
+extern struct crt_proto_format obj_proto_fmt_v11;
 extern int dc_obj_proto_version;
 
 /* Helper function to convert opc to name */
@@ -126,7 +132,7 @@ obj_opc_to_str(crt_opcode_t opc)
 {
 	switch (opc) {
 #define X(a, b, c, d, e, f) case a: return f;
-		OBJ_PROTO_CLI_RPC_LIST(10)
+		OBJ_PROTO_CLI_RPC_LIST(11)
 #undef X
 	}
 	return "unknown";
@@ -422,6 +428,13 @@ CRT_RPC_DECLARE(obj_sync_v10, DAOS_ISEQ_OBJ_SYNC_V10, DAOS_OSEQ_OBJ_SYNC_V10)
 
 CRT_RPC_DECLARE(obj_migrate, DAOS_ISEQ_OBJ_MIGRATE, DAOS_OSEQ_OBJ_MIGRATE)
 
+/* Last update epochs of the objects, for incremental reintegration */
+#define DAOS_ISEQ_OBJ_MIGRATE_V11 /* input fields */			\
+	DAOS_ISEQ_OBJ_MIGRATE						\
+	((uint64_t)		(om_last_ephs)		CRT_ARRAY)
+
+CRT_RPC_DECLARE(obj_migrate_v11, DAOS_ISEQ_OBJ_MIGRATE_V11, DAOS_OSEQ_OBJ_MIGRATE)
+
 #define DAOS_ISEQ_OBJ_EC_AGG	/* input fields */			\
 	((uuid_t)		(ea_pool_uuid)		CRT_VAR)	\
 	((uuid_t)		(ea_cont_uuid)		CRT_VAR)	\
@@ -445,6 +458,36 @@ CRT_RPC_DECLARE(obj_migrate, DAOS_ISEQ_OBJ_MIGRATE, DAOS_OSEQ_OBJ_MIGRATE)
 
 CRT_RPC_DECLARE(obj_ec_agg, DAOS_ISEQ_OBJ_EC_AGG, DAOS_OSEQ_OBJ_EC_AGG)
 
+/*
+ * Push-based rebuild: the rebuild source streams a batch of packed records,
+ * record punches and key punches of one object to the rebuild target, which
+ * pulls it with bulk GET (or takes it from the inline buffer for small
+ * batches). The last batch of the object carries its totals for the rebuild
+ * progress. Only available since DAOS_OBJ_VERSION 11.
+ */
+#define DAOS_ISEQ_OBJ_MIGRATE_PUSH	/* input fields */		\
+	((uuid_t)		(mpi_pool_uuid)		CRT_VAR)	\
+	((uuid_t)		(mpi_cont_uuid)		CRT_VAR)	\
+	((daos_unit_oid_t)	(mpi_oid)		CRT_VAR)	\
+	((d_iov_t)		(mpi_inline)		CRT_VAR)	\
+	((crt_bulk_t)		(mpi_bulk)		CRT_VAR)	\
+	((uint64_t)		(mpi_bulk_size)		CRT_VAR)	\
+	((uint64_t)		(mpi_punched_eph)	CRT_VAR)	\
+	((uint64_t)		(mpi_rec_count)		CRT_VAR)	\
+	((uint64_t)		(mpi_size)		CRT_VAR)	\
+	((uint32_t)		(mpi_ent_nr)		CRT_VAR)	\
+	((uint32_t)		(mpi_version)		CRT_VAR)	\
+	((uint32_t)		(mpi_generation)	CRT_VAR)	\
+	((uint32_t)		(mpi_flags)		CRT_VAR)	\
+	((struct daos_req_comm_in) (mpi_comm_in)	CRT_VAR)
+
+#define DAOS_OSEQ_OBJ_MIGRATE_PUSH	/* output fields */		 \
+	((int32_t)		(mpo_status)		CRT_VAR) \
+	((uint32_t)		(mpo_map_ver)		CRT_VAR) \
+	((struct daos_req_comm_out) (mpo_comm_out)	CRT_VAR)
+
+CRT_RPC_DECLARE(obj_migrate_push, DAOS_ISEQ_OBJ_MIGRATE_PUSH, DAOS_OSEQ_OBJ_MIGRATE_PUSH)
+
 #define DAOS_ISEQ_OBJ_EC_REP	/* input fields */			\
 	((uuid_t)		(er_pool_uuid)		CRT_VAR)	\
 	((uuid_t)		(er_cont_uuid)		CRT_VAR)	\
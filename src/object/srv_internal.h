@@ -87,6 +87,8 @@ struct migrate_pool_tls {
 	ABT_eventual		mpt_done_eventual;
 	/* Migrate status */
 	uint64_t		mpt_obj_count;
+	/* objects skipped by incremental reint as unchanged, part of mpt_obj_count */
+	uint64_t		mpt_obj_skipped;
 	uint64_t		mpt_rec_count;
 	uint64_t		mpt_size;
 	int			mpt_status;
@@ -180,6 +182,8 @@ struct obj_tls {
 
 	/** Measure per-operation latency in us (type = gauge) */
 	struct d_tm_node_t	*ot_op_lat[OBJ_PROTO_CLI_COUNT];
+	/** Distribution of per-operation latency in us (type = log histogram) */
+	struct d_tm_node_t	*ot_op_lat_hist[OBJ_PROTO_CLI_COUNT];
 	/** Count number of per-opcode active requests (type = gauge) */
 	struct d_tm_node_t	*ot_op_active[OBJ_PROTO_CLI_COUNT];
 
@@ -308,6 +312,7 @@ void ds_obj_query_key_handler(crt_rpc_t *rpc);
 void ds_obj_coll_query_handler(crt_rpc_t *rpc);
 void ds_obj_sync_handler(crt_rpc_t *rpc);
 void ds_obj_migrate_handler(crt_rpc_t *rpc);
+void ds_obj_migrate_push_handler(crt_rpc_t *rpc);
 void ds_obj_ec_agg_handler(crt_rpc_t *rpc);
 void ds_obj_ec_rep_handler(crt_rpc_t *rpc);
 void ds_obj_cpd_handler(crt_rpc_t *rpc);
@@ -98,14 +98,14 @@ obj_mod_setup(void)
 	.dr_corpc_ops = e,	\
 },
 
-static struct daos_rpc_handler obj_handlers_v9[] = {
-	OBJ_PROTO_CLI_RPC_LIST(9)
-};
-
 static struct daos_rpc_handler obj_handlers_v10[] = {
 	OBJ_PROTO_CLI_RPC_LIST(10)
 };
 
+static struct daos_rpc_handler obj_handlers_v11[] = {
+	OBJ_PROTO_CLI_RPC_LIST(11)
+};
+
 #undef X
 
 static void *
@@ -136,6 +136,15 @@ obj_tls_init(int tags, int xs_id, int tgt_id)
 			D_WARN("Failed to create active counter: "DF_RC"\n",
 			       DP_RC(rc));
 
+		/** Latency distribution, for all opcodes regardless of the I/O size */
+		rc = d_tm_add_metric(&tls->ot_op_lat_hist[opc], D_TM_LOG_HISTOGRAM,
+				     "object RPC processing time distribution", "us",
+				     "io/ops/%s/latency_hist/tgt_%u",
+				     obj_opc_to_str(opc), tgt_id);
+		if (rc)
+			D_WARN("Failed to create latency histogram: "DF_RC"\n",
+			       DP_RC(rc));
+
 		if (opc == DAOS_OBJ_RPC_UPDATE ||
 		    opc == DAOS_OBJ_RPC_TGT_UPDATE ||
 		    opc == DAOS_OBJ_RPC_FETCH)
@@ -247,6 +256,13 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 		sched_req_attr_init(attr, SCHED_REQ_MIGRATE, &omi->om_pool_uuid);
 		break;
 	}
+	case DAOS_OBJ_RPC_MIGRATE_PUSH: {
+		struct obj_migrate_push_in *mpi = crt_req_get(rpc);
+
+		attr->sra_enqueue_id = mpi->mpi_comm_in.req_in_enqueue_id;
+		sched_req_attr_init(attr, SCHED_REQ_MIGRATE, &mpi->mpi_pool_uuid);
+		break;
+	}
 	/*
 	 * To enhance system performance, following RPCs are currently not
 	 * enqueued. Recent benchmarks have indicated a 2%~3% drop in stat
@@ -358,13 +374,6 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 		break;
 	}
 
-	/*
-	 * Proto v9 doesn't support hint return cart timeout for retry
-	 * skip RPC rejections for them.
-	 */
-	if (proto_ver == 9)
-		attr->sra_flags |= SCHED_REQ_FL_NO_REJECT;
-
 	return rc;
 }
 
@@ -375,8 +384,8 @@ obj_set_req(crt_rpc_t *rpc, struct sched_req_attr *attr)
 	int	proto_ver = crt_req_get_proto_ver(rpc);
 	int	rc = -DER_OVERLOAD_RETRY;
 
-	/* Old protocol RPCs won't be rejected. */
-	D_ASSERT(proto_ver == DAOS_OBJ_VERSION);
+	/* Both supported protocol versions carry the retry hint in the reply */
+	D_ASSERT(proto_ver == DAOS_OBJ_VERSION || proto_ver == DAOS_OBJ_VERSION - 1);
 
 	switch (opc) {
 	case DAOS_OBJ_RPC_UPDATE:
@@ -395,6 +404,13 @@ obj_set_req(crt_rpc_t *rpc, struct sched_req_attr *attr)
 		om->om_status = -DER_OVERLOAD_RETRY;
 		break;
 	}
+	case DAOS_OBJ_RPC_MIGRATE_PUSH: {
+		struct obj_migrate_push_out *mpo = crt_reply_get(rpc);
+
+		mpo->mpo_comm_out.req_out_enqueue_id = attr->sra_enqueue_id;
+		mpo->mpo_status = -DER_OVERLOAD_RETRY;
+		break;
+	}
 	case DAOS_OBJ_DKEY_RPC_ENUMERATE:
 	case DAOS_OBJ_RPC_ENUMERATE:
 	case DAOS_OBJ_AKEY_RPC_ENUMERATE:
@@ -505,9 +521,9 @@ struct dss_module obj_module = {
     .sm_fini        = obj_mod_fini,
     .sm_setup       = obj_mod_setup,
     .sm_proto_count = 2,
-    .sm_proto_fmt   = {&obj_proto_fmt_v9, &obj_proto_fmt_v10},
+    .sm_proto_fmt   = {&obj_proto_fmt_v10, &obj_proto_fmt_v11},
     .sm_cli_count   = {OBJ_PROTO_CLI_COUNT, OBJ_PROTO_CLI_COUNT},
-    .sm_handlers    = {obj_handlers_v9, obj_handlers_v10},
+    .sm_handlers    = {obj_handlers_v10, obj_handlers_v11},
     .sm_key         = &obj_module_key,
     .sm_mod_ops     = &ds_obj_mod_ops,
     .sm_metrics     = &obj_metrics,
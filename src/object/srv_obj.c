@@ -139,6 +139,7 @@ obj_rw_complete(crt_rpc_t *rpc, struct obj_io_context *ioc,
 			rc = vos_update_end(ioh, ioc->ioc_map_ver,
 					    &orwi->orw_dkey, status,
 					    &ioc->ioc_io_size, dth);
+			dss_trace_mark(ioc->ioc_trace_id, rpc->cr_opc, DSS_TRACE_COMMIT);
 			if (rc == 0)
 				obj_update_latency(ioc->ioc_opc, VOS_LATENCY,
 						   daos_get_ntime() - time, ioc->ioc_io_size);
@@ -1710,6 +1711,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 		goto out;
 
 	time = daos_get_ntime();
+	dss_trace_mark(ioc->ioc_trace_id, rpc->cr_opc, DSS_TRACE_IO_PREP);
 	biod = vos_ioh2desc(ioh);
 	rc   = bio_iod_prep(biod, BIO_CHK_TYPE_IO, rma ? rpc->cr_ctx : NULL, CRT_BULK_RW);
 	if (rc) {
@@ -1762,6 +1764,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 	}
 
 	if (rma) {
+		dss_trace_mark(ioc->ioc_trace_id, rpc->cr_opc, DSS_TRACE_BULK);
 		bulk_bind = orw->orw_flags & ORF_BULK_BIND;
 		rc = obj_bulk_transfer(rpc, bulk_op, bulk_bind, orw->orw_bulks.ca_arrays, offs,
 				       skips, ioh, NULL, iods_nr, orw->orw_bulks.ca_count, NULL);
@@ -1828,6 +1831,7 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 		obj_log_csum_err(orw->orw_oid);
 post:
 	time = daos_get_ntime();
+	dss_trace_mark(ioc->ioc_trace_id, rpc->cr_opc, DSS_TRACE_IO_POST);
 	rc = bio_iod_post_async(biod, rc);
 	bio_post_latency = daos_get_ntime() - time;
 out:
@@ -2281,6 +2285,7 @@ obj_ioc_begin_lite(uint32_t rpc_map_ver, uuid_t pool_uuid,
 {
 	struct obj_tls		*tls;
 	struct ds_pool_child	*poc;
+	struct timespec		 recv_time;
 	int			rc;
 
 	rc = obj_ioc_init(pool_uuid, coh_uuid, cont_uuid, rpc, ioc);
@@ -2372,7 +2377,14 @@ out:
 	tls = obj_tls_get();
 	d_tm_inc_gauge(tls->ot_op_active[opc_get(rpc->cr_opc)], 1);
 	ioc->ioc_start_time = daos_get_ntime();
+	crt_req_get_recv_time(rpc, &recv_time);
+	if (d_timenull(&recv_time))
+		ioc->ioc_recv_time = ioc->ioc_start_time;
+	else
+		ioc->ioc_recv_time = recv_time.tv_sec * NSEC_PER_SEC + recv_time.tv_nsec;
 	ioc->ioc_began = 1;
+	crt_req_get_trace_id(rpc, &ioc->ioc_trace_id);
+	dss_trace_mark(ioc->ioc_trace_id, rpc->cr_opc, DSS_TRACE_START);
 
 	if (rc != 0)
 		obj_ioc_end(ioc, rc);
@@ -2405,6 +2417,18 @@ obj_update_sensors(struct obj_io_context *ioc, int err)
 	time = daos_get_ntime() - ioc->ioc_start_time;
 	time >>= 10;
 
+	/*
+	 * Foreground I/O latency feeds the rebuild & aggregation QoS controller, it is measured
+	 * from the arrival of the RPC so that the time spent in the scheduler queue behind the
+	 * background ULTs is accounted.
+	 */
+	if (opc == DAOS_OBJ_RPC_UPDATE || opc == DAOS_OBJ_RPC_TGT_UPDATE ||
+	    opc == DAOS_OBJ_RPC_FETCH) {
+		orw = crt_req_get(ioc->ioc_rpc);
+		if (!(orw->orw_flags & ORF_FOR_MIGRATION))
+			sched_io_lat_record((daos_get_ntime() - ioc->ioc_recv_time) >> 10);
+	}
+
 	switch (opc) {
 	case DAOS_OBJ_RPC_UPDATE:
 		d_tm_inc_counter(opm->opm_update_bytes, ioc->ioc_io_size);
@@ -2426,6 +2450,7 @@ obj_update_sensors(struct obj_io_context *ioc, int err)
 		lat = tls->ot_op_lat[opc];
 	}
 	d_tm_set_gauge(lat, time);
+	d_tm_record_loghist(tls->ot_op_lat_hist[opc], time);
 }
 
 static void
@@ -2437,6 +2462,7 @@ obj_ioc_end(struct obj_io_context *ioc, int err)
 
 		/** Update sensors */
 		obj_update_sensors(ioc, err);
+		dss_trace_mark(ioc->ioc_trace_id, ioc->ioc_rpc->cr_opc, DSS_TRACE_DONE);
 	}
 	obj_ioc_fini(ioc, err);
 }
@@ -3235,6 +3261,8 @@ again:
 			DP_UOID(orw->orw_oid), DP_RC(rc));
 		D_GOTO(out, rc);
 	}
+	dlh->dlh_handle.dth_trace_id  = ioc.ioc_trace_id;
+	dlh->dlh_handle.dth_trace_opc = rpc->cr_opc;
 
 	exec_arg.rpc = rpc;
 	exec_arg.ioc = &ioc;
@@ -3242,7 +3270,9 @@ again:
 	exec_arg.start = orw->orw_start_shard;
 
 	/* Execute the operation on all targets */
+	dss_trace_mark(ioc.ioc_trace_id, rpc->cr_opc, DSS_TRACE_FWD);
 	rc = dtx_leader_exec_ops(dlh, obj_tgt_update, NULL, 0, &exec_arg);
+	dss_trace_mark(ioc.ioc_trace_id, rpc->cr_opc, DSS_TRACE_FWD_DONE);
 
 	if (max_ver < dlh->dlh_rmt_ver)
 		max_ver = dlh->dlh_rmt_ver;
@@ -4163,17 +4193,21 @@ again:
 			DP_UOID(opi->opi_oid), DP_RC(rc));
 		D_GOTO(out, rc);
 	}
+	dlh->dlh_handle.dth_trace_id  = ioc.ioc_trace_id;
+	dlh->dlh_handle.dth_trace_opc = rpc->cr_opc;
 
 	exec_arg.rpc = rpc;
 	exec_arg.ioc = &ioc;
 	exec_arg.flags |= flags;
 
 	/* Execute the operation on all shards */
+	dss_trace_mark(ioc.ioc_trace_id, rpc->cr_opc, DSS_TRACE_FWD);
 	if (opi->opi_api_flags & DAOS_COND_PUNCH)
 		rc = dtx_leader_exec_ops(dlh, obj_tgt_punch_disp, obj_punch_agg_cb, -DER_NONEXIST,
 					 &exec_arg);
 	else
 		rc = dtx_leader_exec_ops(dlh, obj_tgt_punch_disp, NULL, 0, &exec_arg);
+	dss_trace_mark(ioc.ioc_trace_id, rpc->cr_opc, DSS_TRACE_FWD_DONE);
 
 	if (max_ver < dlh->dlh_rmt_ver)
 		max_ver = dlh->dlh_rmt_ver;
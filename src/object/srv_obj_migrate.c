@@ -279,8 +279,8 @@ struct iter_obj_arg {
 
 static int
 migrate_try_obj_insert(struct migrate_pool_tls *tls, uuid_t co_uuid, daos_unit_oid_t oid,
-		       daos_epoch_t epoch, daos_epoch_t punched_epoch, unsigned int shard,
-		       unsigned int tgt_idx);
+		       daos_epoch_t epoch, daos_epoch_t punched_epoch, daos_epoch_t last_epoch,
+		       unsigned int shard, unsigned int tgt_idx);
 void
 migrate_pool_tls_put(struct migrate_pool_tls *tls);
 
@@ -674,6 +674,7 @@ migrate_pool_tls_create(uuid_t pool_uuid, unsigned int version, unsigned int gen
 	pool_tls->mpt_generation     = generation;
 	pool_tls->mpt_rec_count = 0;
 	pool_tls->mpt_obj_count = 0;
+	pool_tls->mpt_obj_skipped = 0;
 	pool_tls->mpt_size = 0;
 	pool_tls->mpt_root_hdl = DAOS_HDL_INVAL;
 	pool_tls->mpt_max_eph        = max_eph;
@@ -3594,24 +3595,72 @@ free_notls:
 struct migrate_obj_val {
 	daos_epoch_t	epoch;
 	daos_epoch_t	punched_epoch;
+	/* epoch of the last update/punch of the object on the source, 0 if unknown */
+	daos_epoch_t	last_epoch;
 	uint32_t	shard;
 	uint32_t	tgt_idx;
 };
 
+/*
+ * Incremental reintegration: the local shard already holds everything up to the
+ * global stable epoch of the container, so if the source has not modified the object
+ * since then, there is nothing to migrate. The object still has to be recorded in the
+ * migrated tree, otherwise the reintegration post-processing would delete it.
+ */
+static bool
+migrate_obj_unchanged(struct migrate_pool_tls *tls, uuid_t cont_uuid, daos_unit_oid_t oid,
+		      daos_epoch_t last_epoch)
+{
+	struct ds_cont_child	*cont_child = NULL;
+	daos_epoch_t		 stable_epoch = 0;
+
+	if (!tls->mpt_reintegrating || last_epoch == 0)
+		return false;
+
+	migrate_get_cont_child(tls, cont_uuid, &cont_child, false);
+	if (cont_child == NULL)
+		return false;
+
+	if (!cont_child->sc_stopping && vos_oi_exist(cont_child->sc_hdl, oid))
+		stable_epoch = vos_cont_get_global_stable_epoch(cont_child->sc_hdl);
+	ds_cont_child_put(cont_child);
+
+	return last_epoch <= stable_epoch;
+}
+
 /* This is still running on the main migration ULT */
 static int
-migrate_object(daos_unit_oid_t oid, daos_epoch_t eph, daos_epoch_t punched_eph, unsigned int shard,
-	       unsigned int tgt_idx, struct iter_cont_arg *cont_arg)
+migrate_object(daos_unit_oid_t oid, daos_epoch_t eph, daos_epoch_t punched_eph,
+	       daos_epoch_t last_eph, unsigned int shard, unsigned int tgt_idx,
+	       struct iter_cont_arg *cont_arg)
 {
 	struct iter_obj_arg	*obj_arg;
 	struct migrate_pool_tls *tls = cont_arg->pool_tls;
 	daos_handle_t		 toh = tls->mpt_migrated_root_hdl;
-	struct migrate_obj_val	 val;
+	struct migrate_obj_val	 val = {0};
 	d_iov_t			 val_iov;
 	int			 rc;
 
 	D_ASSERT(daos_handle_is_valid(toh));
 
+	if (migrate_obj_unchanged(tls, cont_arg->cont_uuid, oid, last_eph)) {
+		val.epoch      = eph;
+		val.last_epoch = last_eph;
+		val.shard      = shard;
+		val.tgt_idx    = tgt_idx;
+		d_iov_set(&val_iov, &val, sizeof(struct migrate_obj_val));
+		rc = obj_tree_insert(toh, cont_arg->cont_uuid, -1, oid, &val_iov);
+		if (rc == 0) {
+			tls->mpt_obj_count++;
+			tls->mpt_obj_skipped++;
+		}
+		D_DEBUG(DB_REBUILD,
+			DF_RB ": " DF_UUID "/" DF_UOID " unchanged since " DF_X64 ": " DF_RC "\n",
+			DP_RB_MPT(tls), DP_UUID(cont_arg->cont_uuid), DP_UOID(oid), last_eph,
+			DP_RC(rc));
+		return rc;
+	}
+
 	D_ALLOC_PTR(obj_arg);
 	if (obj_arg == NULL)
 		return -DER_NOMEM;
@@ -3667,6 +3716,7 @@ migrate_object(daos_unit_oid_t oid, daos_epoch_t eph, daos_epoch_t punched_eph,
 	}
 
 	val.epoch = eph;
+	val.last_epoch = last_eph;
 	val.shard = shard;
 	val.tgt_idx = tgt_idx;
 
@@ -3692,6 +3742,7 @@ migrate_obj_iter_cb(daos_handle_t ih, d_iov_t *key_iov, d_iov_t *val_iov, void *
 	struct migrate_obj_val		*obj_val = val_iov->iov_buf;
 	daos_epoch_t			epoch = obj_val->epoch;
 	daos_epoch_t			punched_epoch = obj_val->punched_epoch;
+	daos_epoch_t			last_epoch = obj_val->last_epoch;
 	unsigned int			tgt_idx = obj_val->tgt_idx;
 	unsigned int                     shard         = obj_val->shard;
 	int				rc;
@@ -3709,7 +3760,7 @@ migrate_obj_iter_cb(daos_handle_t ih, d_iov_t *key_iov, d_iov_t *val_iov, void *
 		return rc;
 	}
 
-	rc = migrate_object(oid, epoch, punched_epoch, shard, tgt_idx, arg);
+	rc = migrate_object(oid, epoch, punched_epoch, last_epoch, shard, tgt_idx, arg);
 	if (rc != 0) {
 		DL_ERROR(rc, DF_RB ": obj " DF_UOID " migration failed", DP_RB_MPT(arg->pool_tls),
 			 DP_UOID(oid));
@@ -3719,7 +3770,7 @@ migrate_obj_iter_cb(daos_handle_t ih, d_iov_t *key_iov, d_iov_t *val_iov, void *
 			 * and support resume in the future.
 			 */
 			migrate_try_obj_insert(arg->pool_tls, arg->cont_uuid, oid, epoch,
-					       punched_epoch, shard, tgt_idx);
+					       punched_epoch, last_epoch, shard, tgt_idx);
 		}
 		return rc;
 	}
@@ -4007,8 +4058,8 @@ migrate_try_create_object_tree(struct migrate_pool_tls *tls)
 static int
 migrate_try_obj_insert(struct migrate_pool_tls *tls, uuid_t co_uuid,
 		       daos_unit_oid_t oid, daos_epoch_t epoch,
-		       daos_epoch_t punched_epoch, unsigned int shard,
-		       unsigned int tgt_idx)
+		       daos_epoch_t punched_epoch, daos_epoch_t last_epoch,
+		       unsigned int shard, unsigned int tgt_idx)
 {
 	struct migrate_obj_val	val;
 	daos_handle_t		toh = tls->mpt_root_hdl;
@@ -4021,6 +4072,7 @@ migrate_try_obj_insert(struct migrate_pool_tls *tls, uuid_t co_uuid,
 
 	val.epoch = epoch;
 	val.punched_epoch = punched_epoch;
+	val.last_epoch = last_epoch;
 	val.shard = shard;
 	val.tgt_idx = tgt_idx;
 	D_DEBUG(DB_REBUILD,
@@ -4123,8 +4175,9 @@ out:
 int
 ds_migrate_object(uuid_t pool_uuid, uuid_t po_hdl, uuid_t co_hdl, uuid_t co_uuid, uint32_t version,
 		  unsigned int generation, uint64_t max_eph, uint32_t opc, daos_unit_oid_t *oids,
-		  daos_epoch_t *epochs, daos_epoch_t *punched_epochs, unsigned int *shards,
-		  uint32_t count, unsigned int tgt_idx, uint32_t new_layout_ver)
+		  daos_epoch_t *epochs, daos_epoch_t *punched_epochs, daos_epoch_t *last_epochs,
+		  unsigned int *shards, uint32_t count, unsigned int tgt_idx,
+		  uint32_t new_layout_ver)
 {
 	struct migrate_pool_tls   *tls = NULL;
 	int                        i;
@@ -4179,7 +4232,8 @@ skip_create:
 	for (i = 0; i < count; i++) {
 		/* firstly insert/check rebuilt tree */
 		rc = migrate_try_obj_insert(tls, co_uuid, oids[i], epochs[i], punched_epochs[i],
-					    shards[i], tgt_idx);
+					    last_epochs != NULL ? last_epochs[i] : 0, shards[i],
+					    tgt_idx);
 		if (rc == -DER_EXIST) {
 			D_DEBUG(DB_TRACE, DF_RB ": " DF_UOID "/" DF_UUID "exists.\n",
 				DP_RB_MPT(tls), DP_UOID(oids[i]), DP_UUID(co_uuid));
@@ -4228,6 +4282,7 @@ ds_obj_migrate_handler(crt_rpc_t *rpc)
 	unsigned int		oids_count;
 	daos_epoch_t		*ephs;
 	daos_epoch_t		*punched_ephs;
+	daos_epoch_t		*last_ephs = NULL;
 	unsigned int		ephs_count;
 	uint32_t		*shards;
 	unsigned int		shards_count;
@@ -4258,6 +4313,14 @@ ds_obj_migrate_handler(crt_rpc_t *rpc)
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
+	/* Last update epochs are optional, only used by incremental reintegration */
+	if (crt_req_get_proto_ver(rpc) >= 11) {
+		struct obj_migrate_v11_in *migrate_in_v11 = crt_req_get(rpc);
+
+		if (migrate_in_v11->om_last_ephs.ca_count == oids_count)
+			last_ephs = migrate_in_v11->om_last_ephs.ca_arrays;
+	}
+
 	uuid_copy(co_uuid, migrate_in->om_cont_uuid);
 	uuid_copy(co_hdl_uuid, migrate_in->om_coh_uuid);
 	uuid_copy(po_uuid, migrate_in->om_pool_uuid);
@@ -4265,7 +4328,7 @@ ds_obj_migrate_handler(crt_rpc_t *rpc)
 
 	rc = ds_migrate_object(po_uuid, po_hdl_uuid, co_hdl_uuid, co_uuid, migrate_in->om_version,
 			       migrate_in->om_generation, migrate_in->om_max_eph,
-			       migrate_in->om_opc, oids, ephs, punched_ephs, shards, oids_count,
+			       migrate_in->om_opc, oids, ephs, punched_ephs, last_ephs, shards, oids_count,
 			       migrate_in->om_tgt_idx, migrate_in->om_new_layout_ver);
 out:
 	migrate_out = crt_reply_get(rpc);
@@ -4273,6 +4336,651 @@ out:
 	dss_rpc_reply(rpc, DAOS_REBUILD_DROP_OBJ);
 }
 
+/*
+ * Push-based rebuild.
+ *
+ * With the pull model each rebuild target enumerates every object from the source
+ * and then fetches its data, which costs several round-trips per object even for
+ * tiny objects. When push is enabled, the rebuild scanner on the source instead walks
+ * the object locally at the stable epoch, the same way the pull path enumerates it,
+ * and streams it to the target. The visible records, the punched records, the key
+ * punches and the object punch are packed as entries into a batch buffer. Each push
+ * RPC carries one batch, inline when it is small and through bulk otherwise, with a
+ * bounded number of RPCs in flight per object.
+ *
+ * The last RPC of an object is only sent once all of the previous ones have been
+ * stored, and the target accounts the object in the rebuild progress when it stores
+ * that last batch. So an object that falls back to the pull path after a failure is
+ * accounted only once, by the pull path. Falling back is safe because re-writing the
+ * same records and punches at the same epochs is idempotent.
+ */
+#define MIGRATE_PUSH_ENV          "D_MIGRATE_PUSH"
+#define MIGRATE_PUSH_INFLIGHT_ENV "D_MIGRATE_PUSH_INFLIGHT"
+
+enum {
+	MIGR_PUSH_INFLIGHT_MIN = 1,
+	MIGR_PUSH_INFLIGHT_DEF = 16,
+	MIGR_PUSH_INFLIGHT_MAX = 256,
+};
+
+/* Max size of one batch, only exceeded by a batch of a single larger record */
+#define MIGR_PUSH_RPC_SIZE    (4UL << 20)
+/* Batch up to this size is packed into the RPC instead of using bulk */
+#define MIGR_PUSH_INLINE_SIZE (4UL << 10)
+/* Initial size of the batch buffer, it grows up to MIGR_PUSH_RPC_SIZE on demand */
+#define MIGR_PUSH_BUF_SIZE    (64UL << 10)
+
+/* The last push RPC of an object, it carries the totals of the object */
+#define MIGR_PUSH_FL_OBJ_LAST (1U << 0)
+
+enum migr_push_ent_type {
+	MIGR_PUSH_ENT_DKEY_PUNCH,
+	MIGR_PUSH_ENT_AKEY_PUNCH,
+	MIGR_PUSH_ENT_SINGLE,
+	MIGR_PUSH_ENT_ARRAY,
+};
+
+/*
+ * Entry of a push batch. It is followed by the dkey, the akey, the recxs of an array
+ * entry and the data, each of them padded to 8 bytes. A single value or array entry
+ * with pe_rsize 0 is a punched record and has no data.
+ */
+struct migr_push_ent {
+	uint64_t pe_epoch;
+	uint64_t pe_rsize;
+	uint32_t pe_type;
+	uint32_t pe_dkey_len;
+	uint32_t pe_akey_len;
+	uint32_t pe_recx_nr;
+};
+
+static bool         migr_push_enabled;
+static unsigned int migr_push_inflight = MIGR_PUSH_INFLIGHT_DEF;
+
+struct migr_push_arg {
+	uuid_t          pa_pool_uuid;
+	uuid_t          pa_cont_uuid;
+	daos_handle_t   pa_coh;
+	/* the local shard and the shard being rebuilt */
+	daos_unit_oid_t pa_oid;
+	daos_unit_oid_t pa_tgt_oid;
+	crt_endpoint_t  pa_ep;
+	daos_epoch_t    pa_epoch;
+	/* object punch not sent to the target yet */
+	daos_epoch_t    pa_punched_eph;
+	uint32_t        pa_version;
+	uint32_t        pa_generation;
+	daos_key_t      pa_dkey;
+	daos_key_t      pa_akey;
+	/* the batch being packed */
+	d_iov_t         pa_buf;
+	uint32_t        pa_ent_nr;
+	/* totals of the object, reported by the last RPC */
+	uint64_t        pa_rec_count;
+	uint64_t        pa_size;
+	ABT_mutex       pa_lock;
+	ABT_cond        pa_cond;
+	int             pa_inflight;
+	int             pa_status;
+};
+
+struct migr_push_req {
+	struct migr_push_arg *pr_arg;
+	crt_bulk_t            pr_bulk;
+	d_iov_t               pr_buf;
+};
+
+bool
+ds_migrate_push_enabled(void)
+{
+	return migr_push_enabled;
+}
+
+static void
+migr_push_req_free(struct migr_push_req *req)
+{
+	if (req->pr_bulk != CRT_BULK_NULL)
+		crt_bulk_free(req->pr_bulk);
+	daos_iov_free(&req->pr_buf);
+	D_FREE(req);
+}
+
+static void
+migr_push_cb(const struct crt_cb_info *cb_info)
+{
+	struct migr_push_req        *req = cb_info->cci_arg;
+	struct migr_push_arg        *arg = req->pr_arg;
+	struct obj_migrate_push_out *mpo;
+	int                          rc  = cb_info->cci_rc;
+
+	if (rc == 0) {
+		mpo = crt_reply_get(cb_info->cci_rpc);
+		rc  = mpo->mpo_status;
+	}
+	if (rc != 0)
+		DL_CDEBUG(rc == -DER_OVERLOAD_RETRY, DB_REBUILD, DLOG_ERR, rc,
+			  DF_UOID " push to %u/%u failed", DP_UOID(arg->pa_tgt_oid),
+			  arg->pa_ep.ep_rank, arg->pa_ep.ep_tag);
+	migr_push_req_free(req);
+
+	ABT_mutex_lock(arg->pa_lock);
+	if (arg->pa_status == 0)
+		arg->pa_status = rc;
+	arg->pa_inflight--;
+	ABT_cond_broadcast(arg->pa_cond);
+	ABT_mutex_unlock(arg->pa_lock);
+}
+
+/* Wait until less than @max push RPCs of the object are in flight */
+static int
+migr_push_wait(struct migr_push_arg *arg, int max)
+{
+	int rc;
+
+	ABT_mutex_lock(arg->pa_lock);
+	while (arg->pa_inflight >= max && arg->pa_status == 0)
+		ABT_cond_wait(arg->pa_cond, arg->pa_lock);
+	rc = arg->pa_status;
+	ABT_mutex_unlock(arg->pa_lock);
+
+	return rc;
+}
+
+/* Send the packed batch to the rebuild target, the batch buffer is handed over to the RPC. */
+static int
+migr_push_send(struct migr_push_arg *arg, uint32_t flags)
+{
+	struct dss_module_info     *dmi = dss_get_module_info();
+	struct obj_migrate_push_in *mpi;
+	struct migr_push_req       *req;
+	crt_rpc_t                  *rpc;
+	d_sg_list_t                 sgl;
+	int                         rc;
+
+	/* The last RPC accounts the object on the target, all of the others must be stored. */
+	rc = migr_push_wait(arg, flags & MIGR_PUSH_FL_OBJ_LAST ? 1 : migr_push_inflight);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_PTR(req);
+	if (req == NULL)
+		return -DER_NOMEM;
+	req->pr_arg = arg;
+	req->pr_buf = arg->pa_buf;
+	d_iov_set(&arg->pa_buf, NULL, 0);
+
+	if (req->pr_buf.iov_len > MIGR_PUSH_INLINE_SIZE) {
+		sgl.sg_nr     = 1;
+		sgl.sg_nr_out = 1;
+		sgl.sg_iovs   = &req->pr_buf;
+		rc = crt_bulk_create(dmi->dmi_ctx, &sgl, CRT_BULK_RO, &req->pr_bulk);
+		if (rc != 0)
+			D_GOTO(failed, rc);
+	}
+
+	rc = ds_obj_req_create(dmi->dmi_ctx, &arg->pa_ep, DAOS_OBJ_RPC_MIGRATE_PUSH, &rpc);
+	if (rc != 0)
+		D_GOTO(failed, rc);
+
+	mpi = crt_req_get(rpc);
+	uuid_copy(mpi->mpi_pool_uuid, arg->pa_pool_uuid);
+	uuid_copy(mpi->mpi_cont_uuid, arg->pa_cont_uuid);
+	mpi->mpi_oid         = arg->pa_tgt_oid;
+	mpi->mpi_bulk        = req->pr_bulk;
+	mpi->mpi_bulk_size   = req->pr_bulk == CRT_BULK_NULL ? 0 : req->pr_buf.iov_len;
+	mpi->mpi_punched_eph = arg->pa_punched_eph;
+	mpi->mpi_version     = arg->pa_version;
+	mpi->mpi_generation  = arg->pa_generation;
+	mpi->mpi_ent_nr      = arg->pa_ent_nr;
+	mpi->mpi_flags       = flags;
+	if (flags & MIGR_PUSH_FL_OBJ_LAST) {
+		mpi->mpi_rec_count = arg->pa_rec_count;
+		mpi->mpi_size      = arg->pa_size;
+	}
+	if (req->pr_bulk == CRT_BULK_NULL)
+		mpi->mpi_inline = req->pr_buf;
+	arg->pa_punched_eph = 0;
+	arg->pa_ent_nr      = 0;
+
+	ABT_mutex_lock(arg->pa_lock);
+	arg->pa_inflight++;
+	ABT_mutex_unlock(arg->pa_lock);
+
+	/* The completion callback is always invoked and releases @req */
+	return crt_req_send(rpc, migr_push_cb, req);
+
+failed:
+	migr_push_req_free(req);
+	return rc;
+}
+
+/* Make room for an entry of @size bytes in the batch, sending the batch when it is full. */
+static int
+migr_push_reserve(struct migr_push_arg *arg, daos_size_t size, bool *sent)
+{
+	d_iov_t    *buf = &arg->pa_buf;
+	daos_size_t buf_len;
+	void       *ptr;
+	int         rc;
+
+	if (arg->pa_ent_nr > 0 && buf->iov_len + size > MIGR_PUSH_RPC_SIZE) {
+		rc = migr_push_send(arg, 0);
+		if (rc != 0)
+			return rc;
+		*sent = true;
+	}
+
+	if (buf->iov_len + size <= buf->iov_buf_len)
+		return 0;
+
+	buf_len = max(buf->iov_buf_len, MIGR_PUSH_BUF_SIZE);
+	while (buf_len < buf->iov_len + size)
+		buf_len <<= 1;
+	D_REALLOC(ptr, buf->iov_buf, buf->iov_buf_len, buf_len);
+	if (ptr == NULL)
+		return -DER_NOMEM;
+	buf->iov_buf     = ptr;
+	buf->iov_buf_len = buf_len;
+
+	return 0;
+}
+
+static void *
+migr_push_append(d_iov_t *buf, const void *src, daos_size_t len)
+{
+	void *dst = (char *)buf->iov_buf + buf->iov_len;
+
+	if (src != NULL)
+		memcpy(dst, src, len);
+	buf->iov_len += roundup(len, 8);
+
+	return dst;
+}
+
+/*
+ * Pack an entry of @type for the current dkey (and akey) into the batch. The data of a
+ * single value or array entry is copied from the iterator, unless the record is punched.
+ */
+static int
+migr_push_pack(struct migr_push_arg *arg, daos_handle_t ih, vos_iter_entry_t *entry,
+	       enum migr_push_ent_type type, daos_epoch_t epoch, unsigned int *acts)
+{
+	struct migr_push_ent *ent;
+	daos_key_t           *akey      = type == MIGR_PUSH_ENT_DKEY_PUNCH ? NULL : &arg->pa_akey;
+	daos_size_t           rsize     = 0;
+	daos_size_t           data_size = 0;
+	uint32_t              recx_nr   = 0;
+	uint64_t              rec_nr    = 0;
+	bool                  sent      = false;
+	d_iov_t               data;
+	int                   rc;
+
+	if (type == MIGR_PUSH_ENT_SINGLE || type == MIGR_PUSH_ENT_ARRAY) {
+		if (type == MIGR_PUSH_ENT_ARRAY) {
+			recx_nr = 1;
+			rec_nr  = entry->ie_recx.rx_nr;
+		} else {
+			rec_nr = 1;
+		}
+		if (!bio_addr_is_hole(&entry->ie_biov.bi_addr)) {
+			rsize     = entry->ie_rsize;
+			data_size = rsize * rec_nr;
+		}
+	}
+
+	rc = migr_push_reserve(arg,
+			       sizeof(*ent) + roundup(arg->pa_dkey.iov_len, 8) +
+				   (akey == NULL ? 0 : roundup(akey->iov_len, 8)) +
+				   recx_nr * sizeof(daos_recx_t) + roundup(data_size, 8),
+			       &sent);
+	if (rc != 0)
+		return rc;
+	/* Sending may have blocked, let the iterator revalidate its position */
+	if (sent)
+		*acts |= VOS_ITER_CB_YIELD;
+
+	ent              = migr_push_append(&arg->pa_buf, NULL, sizeof(*ent));
+	ent->pe_epoch    = epoch;
+	ent->pe_rsize    = rsize;
+	ent->pe_type     = type;
+	ent->pe_dkey_len = arg->pa_dkey.iov_len;
+	ent->pe_akey_len = akey == NULL ? 0 : akey->iov_len;
+	ent->pe_recx_nr  = recx_nr;
+	migr_push_append(&arg->pa_buf, arg->pa_dkey.iov_buf, arg->pa_dkey.iov_len);
+	if (akey != NULL)
+		migr_push_append(&arg->pa_buf, akey->iov_buf, akey->iov_len);
+	if (recx_nr > 0)
+		migr_push_append(&arg->pa_buf, &entry->ie_recx, sizeof(daos_recx_t));
+
+	if (data_size > 0) {
+		d_iov_set(&data, (char *)arg->pa_buf.iov_buf + arg->pa_buf.iov_len, data_size);
+		rc = vos_iter_copy(ih, entry, &data);
+		/* e.g. a gang address, leave the object to the pull path */
+		if (rc == 0 && data.iov_len != data_size)
+			rc = -DER_NOTSUPPORTED;
+		if (rc != 0) {
+			DL_CDEBUG(rc == -DER_NOTSUPPORTED, DB_REBUILD, DLOG_ERR, rc,
+				  DF_UOID " copy data for push failed", DP_UOID(arg->pa_oid));
+			return rc;
+		}
+		migr_push_append(&arg->pa_buf, NULL, data_size);
+	}
+
+	arg->pa_ent_nr++;
+	arg->pa_rec_count += rec_nr;
+	arg->pa_size += data_size;
+
+	return 0;
+}
+
+static int
+migr_push_iter_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
+		  vos_iter_param_t *param, void *data, unsigned int *acts)
+{
+	struct migr_push_arg *arg = data;
+	int                   rc  = 0;
+
+	switch (type) {
+	case VOS_ITER_DKEY:
+		daos_iov_free(&arg->pa_dkey);
+		rc = daos_iov_copy(&arg->pa_dkey, &entry->ie_key);
+		if (rc != 0)
+			break;
+		/* Every dkey carries the object punch, it is sent once with the next batch. */
+		if (entry->ie_obj_punch != 0 && arg->pa_punched_eph == 0 &&
+		    entry->ie_obj_punch <= arg->pa_epoch)
+			arg->pa_punched_eph = entry->ie_obj_punch;
+		if (entry->ie_punch != 0 && entry->ie_punch <= arg->pa_epoch)
+			rc = migr_push_pack(arg, ih, entry, MIGR_PUSH_ENT_DKEY_PUNCH,
+					    entry->ie_punch, acts);
+		break;
+	case VOS_ITER_AKEY:
+		daos_iov_free(&arg->pa_akey);
+		rc = daos_iov_copy(&arg->pa_akey, &entry->ie_key);
+		if (rc != 0)
+			break;
+		if (entry->ie_punch != 0 && entry->ie_punch <= arg->pa_epoch)
+			rc = migr_push_pack(arg, ih, entry, MIGR_PUSH_ENT_AKEY_PUNCH,
+					    entry->ie_punch, acts);
+		break;
+	case VOS_ITER_SINGLE:
+		rc = migr_push_pack(arg, ih, entry, MIGR_PUSH_ENT_SINGLE, entry->ie_epoch, acts);
+		break;
+	case VOS_ITER_RECX:
+		rc = migr_push_pack(arg, ih, entry, MIGR_PUSH_ENT_ARRAY, entry->ie_epoch, acts);
+		break;
+	default:
+		D_ASSERTF(0, "unexpected iter type %d\n", type);
+	}
+
+	return rc;
+}
+
+/**
+ * Push object @oid as of @epoch to shard @shard on the rebuild target @rank/@tgt_idx,
+ * including the object punch at @punched_eph if it is not zero. Return 0 if the whole
+ * object has been stored on the target, otherwise the caller should fall back to the
+ * pull-based rebuild for the object.
+ */
+int
+ds_migrate_push_object(uuid_t pool_uuid, uuid_t cont_uuid, daos_handle_t coh, uint32_t version,
+		       uint32_t generation, daos_epoch_t epoch, daos_epoch_t punched_eph,
+		       daos_unit_oid_t oid, unsigned int shard, d_rank_t rank,
+		       unsigned int tgt_idx)
+{
+	struct migr_push_arg    arg     = {0};
+	vos_iter_param_t        param   = {0};
+	struct vos_iter_anchors anchors = {0};
+	uint8_t                 rpc_ver;
+	int                     rc;
+
+	/* A peer speaking the previous object protocol does not know the push RPC */
+	rc = ds_obj_rpc_protocol(&rpc_ver);
+	if (rc != 0)
+		return rc;
+	if (rpc_ver < DAOS_OBJ_VERSION)
+		return -DER_NOTSUPPORTED;
+
+	rc = ABT_mutex_create(&arg.pa_lock);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free, rc = dss_abterr2der(rc));
+
+	rc = ABT_cond_create(&arg.pa_cond);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free, rc = dss_abterr2der(rc));
+
+	uuid_copy(arg.pa_pool_uuid, pool_uuid);
+	uuid_copy(arg.pa_cont_uuid, cont_uuid);
+	arg.pa_coh              = coh;
+	arg.pa_oid              = oid;
+	arg.pa_tgt_oid          = oid;
+	arg.pa_tgt_oid.id_shard = shard;
+	arg.pa_ep.ep_grp        = NULL;
+	arg.pa_ep.ep_rank       = rank;
+	arg.pa_ep.ep_tag        = tgt_idx;
+	arg.pa_epoch            = epoch;
+	arg.pa_punched_eph      = punched_eph;
+	arg.pa_version          = version;
+	arg.pa_generation       = generation;
+
+	/* Same iteration as the rebuild enumeration, so punches and holes are seen as well */
+	param.ip_hdl        = coh;
+	param.ip_oid        = oid;
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = epoch;
+	param.ip_epc_expr   = VOS_IT_EPC_RE;
+	param.ip_flags      = VOS_IT_RECX_VISIBLE;
+	rc = vos_iterate(&param, VOS_ITER_DKEY, true, &anchors, migr_push_iter_cb, NULL, &arg,
+			 NULL);
+	/* The rest of the object, possibly nothing but the object punch, goes in the last RPC */
+	if (rc == 0)
+		rc = migr_push_send(&arg, MIGR_PUSH_FL_OBJ_LAST);
+
+	/* Wait for all of the in-flight RPCs even on failure, they reference @arg. */
+	ABT_mutex_lock(arg.pa_lock);
+	while (arg.pa_inflight > 0)
+		ABT_cond_wait(arg.pa_cond, arg.pa_lock);
+	if (rc >= 0)
+		rc = arg.pa_status;
+	ABT_mutex_unlock(arg.pa_lock);
+
+	DL_CDEBUG(rc == 0, DB_REBUILD, DLOG_WARN, rc,
+		  DF_UOID " pushed to %u/%u shard %u, eph " DF_X64 " punched " DF_X64,
+		  DP_UOID(oid), rank, tgt_idx, shard, epoch, punched_eph);
+free:
+	if (arg.pa_cond != ABT_COND_NULL)
+		ABT_cond_free(&arg.pa_cond);
+	if (arg.pa_lock != ABT_MUTEX_NULL)
+		ABT_mutex_free(&arg.pa_lock);
+	daos_iov_free(&arg.pa_dkey);
+	daos_iov_free(&arg.pa_akey);
+	daos_iov_free(&arg.pa_buf);
+
+	return rc;
+}
+
+/* Store one entry of a push batch */
+static int
+migr_push_store(struct ds_cont_child *cont, struct obj_migrate_push_in *mpi,
+		struct migr_push_ent *ent, daos_key_t *dkey, daos_key_t *akey, daos_recx_t *recxs,
+		void *data, daos_size_t data_size)
+{
+	daos_iod_t  iod = {0};
+	d_sg_list_t sgl;
+	d_iov_t     iov;
+	uint64_t    ts = daos_gettime_coarse();
+	int         rc;
+
+	switch (ent->pe_type) {
+	case MIGR_PUSH_ENT_DKEY_PUNCH:
+		return vos_obj_punch(cont->sc_hdl, mpi->mpi_oid, ent->pe_epoch, mpi->mpi_version,
+				     VOS_OF_REPLAY_PC, dkey, 0, NULL, NULL);
+	case MIGR_PUSH_ENT_AKEY_PUNCH:
+		return vos_obj_punch(cont->sc_hdl, mpi->mpi_oid, ent->pe_epoch, mpi->mpi_version,
+				     VOS_OF_REPLAY_PC, dkey, 1, akey, NULL);
+	case MIGR_PUSH_ENT_SINGLE:
+		iod.iod_type = DAOS_IOD_SINGLE;
+		break;
+	case MIGR_PUSH_ENT_ARRAY:
+		iod.iod_type  = DAOS_IOD_ARRAY;
+		iod.iod_recxs = recxs;
+		break;
+	default:
+		return -DER_PROTO;
+	}
+
+	iod.iod_name = *akey;
+	iod.iod_size = ent->pe_rsize;
+	iod.iod_nr   = 1;
+	d_iov_set(&iov, data, data_size);
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs   = &iov;
+again:
+	/* A record size of zero punches the records */
+	rc = vos_obj_update(cont->sc_hdl, mpi->mpi_oid, ent->pe_epoch, mpi->mpi_version,
+			    VOS_OF_REBUILD, dkey, 1, &iod, NULL, data_size == 0 ? NULL : &sgl);
+	OBJ_CHECK_EAGAIN(rc, ts, "vos_obj_update", mpi->mpi_oid, again);
+
+	return rc;
+}
+
+/* Take the entries out of a push batch and store them one by one */
+static int
+migr_push_unpack(struct ds_cont_child *cont, struct obj_migrate_push_in *mpi, d_iov_t *buf)
+{
+	char                 *ptr = buf->iov_buf;
+	char                 *end = ptr + buf->iov_len;
+	struct migr_push_ent *ent;
+	daos_key_t            dkey;
+	daos_key_t            akey;
+	daos_recx_t          *recxs;
+	daos_size_t           data_size;
+	uint32_t              i;
+	int                   rc;
+
+	for (i = 0; i < mpi->mpi_ent_nr; i++) {
+		if (ptr + sizeof(*ent) > end)
+			return -DER_PROTO;
+		ent = (struct migr_push_ent *)ptr;
+		ptr += sizeof(*ent);
+
+		if (ent->pe_recx_nr != (ent->pe_type == MIGR_PUSH_ENT_ARRAY ? 1 : 0) ||
+		    ptr + roundup(ent->pe_dkey_len, 8) + roundup(ent->pe_akey_len, 8) +
+			    ent->pe_recx_nr * sizeof(daos_recx_t) > end)
+			return -DER_PROTO;
+
+		d_iov_set(&dkey, ptr, ent->pe_dkey_len);
+		ptr += roundup(ent->pe_dkey_len, 8);
+		d_iov_set(&akey, ptr, ent->pe_akey_len);
+		ptr += roundup(ent->pe_akey_len, 8);
+		recxs = (daos_recx_t *)ptr;
+		ptr += ent->pe_recx_nr * sizeof(daos_recx_t);
+
+		if (ent->pe_type == MIGR_PUSH_ENT_ARRAY)
+			data_size = ent->pe_rsize * recxs->rx_nr;
+		else if (ent->pe_type == MIGR_PUSH_ENT_SINGLE)
+			data_size = ent->pe_rsize;
+		else
+			data_size = 0;
+		if (ptr + roundup(data_size, 8) > end)
+			return -DER_PROTO;
+
+		rc = migr_push_store(cont, mpi, ent, &dkey, &akey, recxs, ptr, data_size);
+		if (rc != 0) {
+			DL_ERROR(rc, DF_UOID " store pushed entry %u type %u eph " DF_X64 " failed",
+				 DP_UOID(mpi->mpi_oid), i, ent->pe_type, ent->pe_epoch);
+			return rc;
+		}
+		ptr += roundup(data_size, 8);
+	}
+
+	return 0;
+}
+
+/* Store a batch pushed by the rebuild source. */
+void
+ds_obj_migrate_push_handler(crt_rpc_t *rpc)
+{
+	struct obj_migrate_push_in  *mpi        = crt_req_get(rpc);
+	struct obj_migrate_push_out *mpo        = crt_reply_get(rpc);
+	struct ds_pool_child        *pool_child = NULL;
+	struct ds_cont_child        *cont       = NULL;
+	struct migrate_pool_tls     *tls;
+	d_sg_list_t                  sgl;
+	d_sg_list_t                 *sgls = &sgl;
+	d_iov_t                      buf  = {0};
+	int                          rc;
+
+	pool_child = ds_pool_child_lookup(mpi->mpi_pool_uuid);
+	if (pool_child == NULL)
+		D_GOTO(out, rc = -DER_NO_HDL);
+
+	mpo->mpo_map_ver = pool_child->spc_map_version;
+	/* Not aware of the pool map the rebuild is based on yet, let the source pull it. */
+	if (pool_child->spc_map_version < mpi->mpi_version)
+		D_GOTO(out, rc = -DER_STALE);
+
+	rc = ds_cont_child_open_create(mpi->mpi_pool_uuid, mpi->mpi_cont_uuid, false, &cont);
+	if (rc != 0) {
+		DL_ERROR(rc, DF_UUID " open container " DF_UUID " for push failed",
+			 DP_UUID(mpi->mpi_pool_uuid), DP_UUID(mpi->mpi_cont_uuid));
+		D_GOTO(out, rc);
+	}
+
+	if (mpi->mpi_bulk != CRT_BULK_NULL) {
+		if (mpi->mpi_bulk_size == 0)
+			D_GOTO(out, rc = -DER_PROTO);
+
+		rc = daos_iov_alloc(&buf, mpi->mpi_bulk_size, true);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		sgl.sg_nr     = 1;
+		sgl.sg_nr_out = 1;
+		sgl.sg_iovs   = &buf;
+		rc = obj_bulk_transfer(rpc, CRT_BULK_GET, false, &mpi->mpi_bulk, NULL, NULL,
+				       DAOS_HDL_INVAL, &sgls, 1, 1, NULL);
+		if (rc != 0) {
+			DL_ERROR(rc, DF_UOID " bulk transfer failed", DP_UOID(mpi->mpi_oid));
+			D_GOTO(out, rc);
+		}
+	}
+
+	/* The object punch comes with the first batch, before any of the entries */
+	if (mpi->mpi_punched_eph != 0) {
+		rc = vos_obj_punch(cont->sc_hdl, mpi->mpi_oid, mpi->mpi_punched_eph,
+				   mpi->mpi_version, VOS_OF_REPLAY_PC, NULL, 0, NULL, NULL);
+		if (rc != 0) {
+			DL_ERROR(rc, DF_UOID " punch pushed object failed", DP_UOID(mpi->mpi_oid));
+			D_GOTO(out, rc);
+		}
+	}
+
+	rc = migr_push_unpack(cont, mpi, mpi->mpi_bulk != CRT_BULK_NULL ? &buf : &mpi->mpi_inline);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (!(mpi->mpi_flags & MIGR_PUSH_FL_OBJ_LAST))
+		D_GOTO(out, rc);
+
+	tls = migrate_pool_tls_lookup(mpi->mpi_pool_uuid, mpi->mpi_version, mpi->mpi_generation);
+	if (tls != NULL) {
+		tls->mpt_obj_count++;
+		tls->mpt_rec_count += mpi->mpi_rec_count;
+		tls->mpt_size += mpi->mpi_size;
+		migrate_pool_tls_put(tls);
+	}
+out:
+	daos_iov_free(&buf);
+	if (cont != NULL)
+		ds_cont_child_put(cont);
+	if (pool_child != NULL)
+		ds_pool_child_put(pool_child);
+	mpo->mpo_status = rc;
+	dss_rpc_reply(rpc, DAOS_REBUILD_DROP_OBJ);
+}
+
 static int
 obj_tree_lookup_cont(daos_handle_t toh, uuid_t co_uuid, daos_handle_t *cont_toh)
 {
@@ -4659,6 +5367,8 @@ migrate_check_one(void *data)
 		tls->mpt_tgt_dkey_ult_cnt, tls->mpt_rec_count, tls->mpt_obj_count, tls->mpt_size);
 
 	if (reint_post_start && !tls->mpt_post_process_started) {
+		D_DEBUG(DB_REBUILD, DF_RB " incremental reint skipped " DF_U64 "/" DF_U64 " objs\n",
+			DP_RB_MQA(arg), tls->mpt_obj_skipped, tls->mpt_obj_count);
 		migrate_pool_tls_get(tls);
 		tls->mpt_post_process_started = 1;
 		D_ALLOC_PTR(ult_arg);
@@ -4759,6 +5469,8 @@ out:
  * param oids [in]		array of the objects to be migrated.
  * param ephs [in]		epoch of the objects.
  * param punched_ephs [in]	punched_epoch of objects.
+ * param last_ephs [in]		it can be NULL, otherwise the epoch of the last
+ *				update/punch of each object on the source.
  * param shards [in]		it can be NULL, otherwise it indicates
  *				the source shard of the migration, so it
  *				is only used for replicate objects.
@@ -4772,8 +5484,8 @@ int
 ds_object_migrate_send(struct ds_pool *pool, uuid_t pool_hdl_uuid, uuid_t cont_hdl_uuid,
 		       uuid_t cont_uuid, int tgt_id, uint32_t version, unsigned int generation,
 		       uint64_t max_eph, daos_unit_oid_t *oids, daos_epoch_t *ephs,
-		       daos_epoch_t *punched_ephs, unsigned int *shards, int cnt,
-		       uint32_t new_layout_ver, uint32_t migrate_opc,
+		       daos_epoch_t *punched_ephs, daos_epoch_t *last_ephs, unsigned int *shards,
+		       int cnt, uint32_t new_layout_ver, uint32_t migrate_opc,
 		       uint64_t *enqueue_id, uint32_t *max_delay)
 {
 	struct obj_migrate_in	*migrate_in = NULL;
@@ -4836,6 +5548,13 @@ ds_object_migrate_send(struct ds_pool *pool, uuid_t pool_hdl_uuid, uuid_t cont_h
 	migrate_in->om_ephs.ca_count = cnt;
 	migrate_in->om_punched_ephs.ca_arrays = punched_ephs;
 	migrate_in->om_punched_ephs.ca_count = cnt;
+	/* A peer speaking the previous protocol always migrates the objects */
+	if (last_ephs != NULL && rpc_ver >= 11) {
+		struct obj_migrate_v11_in *migrate_in_v11 = crt_req_get(rpc);
+
+		migrate_in_v11->om_last_ephs.ca_arrays = last_ephs;
+		migrate_in_v11->om_last_ephs.ca_count  = cnt;
+	}
 	migrate_in->om_comm_in.req_in_enqueue_id = *enqueue_id;
 	crt_req_get_timeout(rpc, &rpc_timeout);
 
@@ -5041,6 +5760,17 @@ obj_migrate_init(void)
 	if (rc)
 		D_GOTO(out, rc);
 
+	d_getenv_bool(MIGRATE_PUSH_ENV, &migr_push_enabled);
+	rc = d_getenv_uint(MIGRATE_PUSH_INFLIGHT_ENV, &migr_push_inflight);
+	if (rc == 0) {
+		if (migr_push_inflight < MIGR_PUSH_INFLIGHT_MIN)
+			migr_push_inflight = MIGR_PUSH_INFLIGHT_MIN;
+		if (migr_push_inflight > MIGR_PUSH_INFLIGHT_MAX)
+			migr_push_inflight = MIGR_PUSH_INFLIGHT_MAX;
+	}
+	D_INFO("push-based rebuild %s, %u RPCs in flight per object\n",
+	       migr_push_enabled ? "enabled" : "disabled", migr_push_inflight);
+
 	return 0;
 out:
 	obj_migrate_fini();
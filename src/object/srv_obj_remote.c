@@ -35,6 +35,18 @@ struct obj_remote_cb_arg {
 	void				*cpd_dcde;
 };
 
+static void
+obj_remote_trace(crt_rpc_t *parent, crt_rpc_t *child)
+{
+	uint64_t	trace_id;
+	int		rc;
+
+	rc = crt_req_get_trace_id(child, &trace_id);
+	D_ASSERT(rc == 0);
+
+	dss_trace_mark(trace_id, parent->cr_opc, DSS_TRACE_RMT_DONE);
+}
+
 static void
 shard_update_req_cb(const struct crt_cb_info *cb_info)
 {
@@ -61,6 +73,7 @@ shard_update_req_cb(const struct crt_cb_info *cb_info)
 	if (rc >= 0)
 		rc = rc1;
 
+	obj_remote_trace(parent_req, req);
 	arg->comp_cb(dlh, arg->idx, rc);
 	crt_req_decref(parent_req);
 	D_FREE(arg);
@@ -79,6 +92,21 @@ obj_inherit_timeout(crt_rpc_t *parent, crt_rpc_t *child)
 	D_ASSERT(rc == 0);
 }
 
+static void
+obj_inherit_trace(crt_rpc_t *parent, crt_rpc_t *child)
+{
+	uint64_t	trace_id;
+	int		rc;
+
+	rc = crt_req_get_trace_id(parent, &trace_id);
+	D_ASSERT(rc == 0);
+
+	if (trace_id != 0) {
+		rc = crt_req_set_trace_id(child, trace_id);
+		D_ASSERT(rc == 0);
+	}
+}
+
 /* Execute update on the remote target */
 int
 ds_obj_remote_update(struct dtx_leader_handle *dlh, void *data, int idx,
@@ -133,6 +161,7 @@ ds_obj_remote_update(struct dtx_leader_handle *dlh, void *data, int idx,
 	}
 
 	obj_inherit_timeout(parent_req, req);
+	obj_inherit_trace(parent_req, req);
 	orw_parent = crt_req_get(parent_req);
 	orw = crt_req_get(req);
 	*orw = *orw_parent;
@@ -189,6 +218,7 @@ shard_punch_req_cb(const struct crt_cb_info *cb_info)
 	if (rc >= 0)
 		rc = rc1;
 
+	obj_remote_trace(parent_req, req);
 	arg->comp_cb(dlh, arg->idx, rc);
 	crt_req_decref(parent_req);
 	D_FREE(arg);
@@ -244,6 +274,7 @@ ds_obj_remote_punch(struct dtx_leader_handle *dlh, void *data, int idx,
 	}
 
 	obj_inherit_timeout(parent_req, req);
+	obj_inherit_trace(parent_req, req);
 	opi_parent = crt_req_get(parent_req);
 	opi = crt_req_get(req);
 	*opi = *opi_parent;
@@ -722,3 +722,149 @@ out:
 
 	return rc;
 }
+
+/** Pick an available target of the pool to handle a container-wide pipeline run */
+static int
+pipeline_cont_pick_tgt(struct dc_pool *pool, crt_endpoint_t *tgt_ep)
+{
+	struct pool_target *tgts;
+	unsigned int        nr;
+	unsigned int        start;
+	unsigned int        i;
+	int                 rc = -DER_NONEXIST;
+
+	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+	tgts = pool_map_targets(pool->dp_map);
+	nr   = pool_map_target_nr(pool->dp_map);
+	if (nr == 0)
+		goto out;
+
+	/** spread the runs over the engines */
+	start = d_rand() % nr;
+	for (i = 0; i < nr; i++) {
+		struct pool_target *tgt = &tgts[(start + i) % nr];
+
+		if (pool_target_unavail(tgt, false))
+			continue;
+
+		tgt_ep->ep_grp  = pool->dp_sys->sy_group;
+		tgt_ep->ep_tag  = daos_rpc_tag(DAOS_REQ_IO, tgt->ta_comp.co_index);
+		tgt_ep->ep_rank = tgt->ta_comp.co_rank;
+		rc              = 0;
+		break;
+	}
+out:
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
+	return rc;
+}
+
+static int
+pipeline_cont_run_cb(tse_task_t *task, void *data)
+{
+	daos_pipeline_run_cont_t     *api_args = dc_task_get_args(task);
+	crt_rpc_t                    *rpc      = *((crt_rpc_t **)data);
+	struct pipeline_cont_run_out *pco;
+	uint32_t                      i;
+	int                           rc = task->dt_result;
+
+	if (rc != 0) {
+		D_ERROR("container pipeline run RPC failed, " DF_RC "\n", DP_RC(rc));
+		D_GOTO(out, rc);
+	}
+
+	pco = crt_reply_get(rpc);
+	rc  = pco->pco_ret;
+	if (rc != 0) {
+		DL_ERROR(rc, "container pipeline run failed");
+		D_GOTO(out, rc);
+	}
+	D_ASSERT(pco->pco_aggrs.nr == api_args->pipeline->num_aggr_filters);
+
+	for (i = 0; i < pco->pco_aggrs.nr; i++) {
+		*(double *)api_args->sgl_agg->sg_iovs[i].iov_buf = pco->pco_aggrs.vals[i];
+		api_args->sgl_agg->sg_iovs[i].iov_len            = sizeof(double);
+	}
+	api_args->sgl_agg->sg_nr_out = pco->pco_aggrs.nr;
+
+	if (api_args->stats != NULL)
+		*api_args->stats = pco->pco_stats;
+
+out:
+	crt_req_decref(rpc);
+	return rc;
+}
+
+int
+dc_pipeline_run_cont(tse_task_t *api_task)
+{
+	daos_pipeline_run_cont_t    *api_args = dc_task_get_args(api_task);
+	daos_pipeline_t             *pipeline = api_args->pipeline;
+	struct dc_pool              *pool     = NULL;
+	struct pipeline_cont_run_in *pci;
+	crt_endpoint_t               tgt_ep;
+	crt_opcode_t                 opcode;
+	crt_rpc_t                   *req;
+	uuid_t                       coh_uuid;
+	uuid_t                       cont_uuid;
+	uint32_t                     i;
+	int                          rc;
+
+	/** only aggregations are returned for a whole container */
+	if (pipeline->num_aggr_filters == 0 || pipeline->num_aggr_filters > PIPELINE_CONT_AGGR_MAX ||
+	    api_args->sgl_agg == NULL ||
+	    api_args->sgl_agg->sg_nr != pipeline->num_aggr_filters) {
+		D_ERROR("container pipeline run needs 1 to %d aggregations\n",
+			PIPELINE_CONT_AGGR_MAX);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+	for (i = 0; i < pipeline->num_aggr_filters; i++) {
+		if (api_args->sgl_agg->sg_iovs[i].iov_buf_len < sizeof(double))
+			D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	pool = dc_hdl2pool(dc_cont_hdl2pool_hdl(api_args->coh));
+	if (pool == NULL) {
+		D_WARN("Cannot find valid pool\n");
+		D_GOTO(out, rc = -DER_NO_HDL);
+	}
+
+	rc = dc_cont_hdl2uuid(api_args->coh, &coh_uuid, &cont_uuid);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = pipeline_cont_pick_tgt(pool, &tgt_ep);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	opcode = DAOS_RPC_OPCODE(DAOS_PIPELINE_RPC_CONT_RUN, DAOS_PIPELINE_MODULE,
+				 DAOS_PIPELINE_VERSION);
+	rc     = crt_req_create(daos_task2ctx(api_task), &tgt_ep, opcode, &req);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	pci                = crt_req_get(req);
+	pci->pci_pipe      = *pipeline;
+	pci->pci_iods.nr   = api_args->nr_iods;
+	pci->pci_iods.iods = api_args->iods;
+	pci->pci_epr       = (daos_epoch_range_t){.epr_lo = 0, .epr_hi = DAOS_EPOCH_MAX};
+	pci->pci_flags     = api_args->flags;
+	uuid_copy(pci->pci_pool_uuid, pool->dp_pool);
+	uuid_copy(pci->pci_co_hdl, coh_uuid);
+	uuid_copy(pci->pci_co_uuid, cont_uuid);
+
+	crt_req_addref(req);
+	rc = tse_task_register_comp_cb(api_task, pipeline_cont_run_cb, &req, sizeof(req));
+	if (rc != 0) {
+		crt_req_decref(req);
+		crt_req_decref(req);
+		D_GOTO(out, rc);
+	}
+
+	dc_pool_put(pool);
+	return daos_rpc_send(req, api_task);
+out:
+	if (pool != NULL)
+		dc_pool_put(pool);
+	tse_task_complete(api_task, rc);
+	return rc;
+}
@@ -116,6 +116,32 @@ pipeline_aggregations_init(daos_pipeline_t *pipeline, d_sg_list_t *sgl_agg)
 	sgl_agg->sg_nr_out = pipeline->num_aggr_filters;
 }
 
+/** Merge the partial aggregates \a src into \a dst, averages are merged as sums */
+void
+pipeline_aggregations_merge(daos_pipeline_t *pipeline, double *dst, double *src)
+{
+	uint32_t            i;
+	daos_filter_part_t *part;
+	char               *part_type;
+	size_t              part_type_s;
+
+	for (i = 0; i < pipeline->num_aggr_filters; i++) {
+		part        = pipeline->aggr_filters[i]->parts[0];
+		part_type   = (char *)part->part_type.iov_buf;
+		part_type_s = part->part_type.iov_len;
+
+		if (!strncmp(part_type, "DAOS_FILTER_FUNC_MAX", part_type_s)) {
+			if (src[i] > dst[i])
+				dst[i] = src[i];
+		} else if (!strncmp(part_type, "DAOS_FILTER_FUNC_MIN", part_type_s)) {
+			if (src[i] < dst[i])
+				dst[i] = src[i];
+		} else {
+			dst[i] += src[i];
+		}
+	}
+}
+
 /**
  * calculates the subindex of a function in filter_func_ptrs[] given its index calculated with the
  * function calc_type_idx(). There is only 4 types if we don't consider the size: unsigned int,
@@ -382,6 +408,7 @@ compile_filters(daos_filter_t **ftrs, uint32_t nftrs, struct filter_compiled_t *
 				    &type_len);
 		if (rc != 0)
 			D_GOTO(error, rc);
+		c_ftrs[i].batch = filter_batch_compile(&c_ftrs[i]);
 	}
 	return 0;
 error:
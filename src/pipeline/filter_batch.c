@@ -0,0 +1,647 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Batch evaluation of filters.
+ *
+ * Filters made only of numeric comparisons between akeys, dkeys and constants, combined with
+ * AND, OR and NOT, are evaluated over a batch of records at once. The akey and dkey values of
+ * the records are first gathered into one column per filter part, the comparisons are then
+ * evaluated over whole columns by loops the compiler can vectorize, and the result of each
+ * filter narrows a selection vector of the records still passing. Other filters are evaluated
+ * record by record on the records still selected.
+ */
+#define D_LOGFAC DD_FAC(pipeline)
+
+#include <daos/common.h>
+#include "pipeline_internal.h"
+
+#define BATCH_NR_CMP	(FILTER_BATCH_GT - FILTER_BATCH_EQ + 1)
+#define BATCH_NR_TYPES	(FILTER_BATCH_D + 1)
+
+/** Type of the akey values read by an akey part */
+enum batch_src {
+	BATCH_SRC_U1,
+	BATCH_SRC_U2,
+	BATCH_SRC_U4,
+	BATCH_SRC_U8,
+	BATCH_SRC_I1,
+	BATCH_SRC_I2,
+	BATCH_SRC_I4,
+	BATCH_SRC_I8,
+	BATCH_SRC_R4,
+	BATCH_SRC_R8,
+};
+
+static uint8_t batch_src_size[] = {1, 2, 4, 8, 1, 2, 4, 8, 4, 8};
+
+struct batch_func {
+	filter_func_t	*bf_func;
+	uint8_t		 bf_op;
+	uint8_t		 bf_type;
+};
+
+static struct batch_func batch_funcs[] = {
+    {filter_func_eq_u, FILTER_BATCH_EQ, FILTER_BATCH_U},
+    {filter_func_eq_i, FILTER_BATCH_EQ, FILTER_BATCH_I},
+    {filter_func_eq_d, FILTER_BATCH_EQ, FILTER_BATCH_D},
+    {filter_func_ne_u, FILTER_BATCH_NE, FILTER_BATCH_U},
+    {filter_func_ne_i, FILTER_BATCH_NE, FILTER_BATCH_I},
+    {filter_func_ne_d, FILTER_BATCH_NE, FILTER_BATCH_D},
+    {filter_func_lt_u, FILTER_BATCH_LT, FILTER_BATCH_U},
+    {filter_func_lt_i, FILTER_BATCH_LT, FILTER_BATCH_I},
+    {filter_func_lt_d, FILTER_BATCH_LT, FILTER_BATCH_D},
+    {filter_func_le_u, FILTER_BATCH_LE, FILTER_BATCH_U},
+    {filter_func_le_i, FILTER_BATCH_LE, FILTER_BATCH_I},
+    {filter_func_le_d, FILTER_BATCH_LE, FILTER_BATCH_D},
+    {filter_func_ge_u, FILTER_BATCH_GE, FILTER_BATCH_U},
+    {filter_func_ge_i, FILTER_BATCH_GE, FILTER_BATCH_I},
+    {filter_func_ge_d, FILTER_BATCH_GE, FILTER_BATCH_D},
+    {filter_func_gt_u, FILTER_BATCH_GT, FILTER_BATCH_U},
+    {filter_func_gt_i, FILTER_BATCH_GT, FILTER_BATCH_I},
+    {filter_func_gt_d, FILTER_BATCH_GT, FILTER_BATCH_D},
+    {filter_func_and, FILTER_BATCH_AND, 0},
+    {filter_func_or, FILTER_BATCH_OR, 0},
+    {filter_func_not, FILTER_BATCH_NOT, 0},
+    {getdata_func_dkey_u1, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_u2, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_u4, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_u8, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_i1, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_i2, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_i4, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_i8, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_r4, FILTER_BATCH_DKEY, 0},
+    {getdata_func_dkey_r8, FILTER_BATCH_DKEY, 0},
+    {getdata_func_akey_u1, FILTER_BATCH_AKEY, BATCH_SRC_U1},
+    {getdata_func_akey_u2, FILTER_BATCH_AKEY, BATCH_SRC_U2},
+    {getdata_func_akey_u4, FILTER_BATCH_AKEY, BATCH_SRC_U4},
+    {getdata_func_akey_u8, FILTER_BATCH_AKEY, BATCH_SRC_U8},
+    {getdata_func_akey_i1, FILTER_BATCH_AKEY, BATCH_SRC_I1},
+    {getdata_func_akey_i2, FILTER_BATCH_AKEY, BATCH_SRC_I2},
+    {getdata_func_akey_i4, FILTER_BATCH_AKEY, BATCH_SRC_I4},
+    {getdata_func_akey_i8, FILTER_BATCH_AKEY, BATCH_SRC_I8},
+    {getdata_func_akey_r4, FILTER_BATCH_AKEY, BATCH_SRC_R4},
+    {getdata_func_akey_r8, FILTER_BATCH_AKEY, BATCH_SRC_R8},
+    {getdata_func_const_u1, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_u2, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_u4, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_u8, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_i1, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_i2, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_i4, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_i8, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_r4, FILTER_BATCH_CONST, 0},
+    {getdata_func_const_r8, FILTER_BATCH_CONST, 0},
+};
+
+/**
+ * Comparison kernels. A record passes a comparison if its left operand matches any of the right
+ * ones, \a alive clears the records whose left operand or one of the previous right operands has
+ * no data.
+ */
+typedef void batch_cmp_func_t(uint32_t n, const void *left, const void *right,
+			      const uint8_t *alive, uint8_t *out);
+
+#define DEFINE_BATCH_CMP(op, sym, type, ctype)                                                     \
+	static void batch_cmp_##op##_##type(uint32_t n, const void *left, const void *right,       \
+					    const uint8_t *alive, uint8_t *out)                    \
+	{                                                                                          \
+		const _##ctype *restrict l = left;                                                 \
+		const _##ctype *restrict r = right;                                                \
+		const uint8_t *restrict  a = alive;                                                \
+		uint8_t *restrict        o = out;                                                  \
+		uint32_t                 i;                                                        \
+		for (i = 0; i < n; i++)                                                            \
+			o[i] |= a[i] & (uint8_t)(l[i] sym r[i]);                                   \
+	}                                                                                          \
+	static void batch_cmps_##op##_##type(uint32_t n, const void *left, const void *right,      \
+					     const uint8_t *alive, uint8_t *out)                   \
+	{                                                                                          \
+		const _##ctype *restrict l = left;                                                 \
+		const _##ctype           r = *(const _##ctype *)right;                             \
+		const uint8_t *restrict  a = alive;                                                \
+		uint8_t *restrict        o = out;                                                  \
+		uint32_t                 i;                                                        \
+		for (i = 0; i < n; i++)                                                            \
+			o[i] |= a[i] & (uint8_t)(l[i] sym r);                                      \
+	}
+
+#define DEFINE_BATCH_CMPS(op, sym)                                                                 \
+	DEFINE_BATCH_CMP(op, sym, u, uint64_t)                                                     \
+	DEFINE_BATCH_CMP(op, sym, i, int64_t)                                                      \
+	DEFINE_BATCH_CMP(op, sym, d, double)
+
+DEFINE_BATCH_CMPS(eq, ==)
+DEFINE_BATCH_CMPS(ne, !=)
+DEFINE_BATCH_CMPS(lt, <)
+DEFINE_BATCH_CMPS(le, <=)
+DEFINE_BATCH_CMPS(ge, >=)
+DEFINE_BATCH_CMPS(gt, >)
+
+#define BATCH_CMP_FUNCS(prefix, op) {prefix##_##op##_u, prefix##_##op##_i, prefix##_##op##_d}
+
+/** column against column */
+static batch_cmp_func_t *batch_cmp_funcs[BATCH_NR_CMP][BATCH_NR_TYPES] = {
+    BATCH_CMP_FUNCS(batch_cmp, eq), BATCH_CMP_FUNCS(batch_cmp, ne),
+    BATCH_CMP_FUNCS(batch_cmp, lt), BATCH_CMP_FUNCS(batch_cmp, le),
+    BATCH_CMP_FUNCS(batch_cmp, ge), BATCH_CMP_FUNCS(batch_cmp, gt),
+};
+
+/** column against constant */
+static batch_cmp_func_t *batch_cmps_funcs[BATCH_NR_CMP][BATCH_NR_TYPES] = {
+    BATCH_CMP_FUNCS(batch_cmps, eq), BATCH_CMP_FUNCS(batch_cmps, ne),
+    BATCH_CMP_FUNCS(batch_cmps, lt), BATCH_CMP_FUNCS(batch_cmps, le),
+    BATCH_CMP_FUNCS(batch_cmps, ge), BATCH_CMP_FUNCS(batch_cmps, gt),
+};
+
+/** constant on the left: the operands are swapped */
+static uint8_t batch_cmp_mirror[BATCH_NR_CMP] = {
+    FILTER_BATCH_EQ, FILTER_BATCH_NE, FILTER_BATCH_GT,
+    FILTER_BATCH_GE, FILTER_BATCH_LE, FILTER_BATCH_LT,
+};
+
+static bool
+batch_part_check(struct filter_part_compiled_t *parts, uint32_t idx)
+{
+	struct filter_part_compiled_t *part = &parts[idx];
+	uint32_t                       child;
+	uint32_t                       i;
+
+	switch (part->batch_op) {
+	case FILTER_BATCH_AND:
+	case FILTER_BATCH_OR:
+	case FILTER_BATCH_NOT:
+		child = idx + 1;
+		for (i = 0; i < part->num_operands; i++) {
+			if (!batch_part_check(parts, child))
+				return false;
+			child = parts[child].idx_end_subtree + 1;
+		}
+		return true;
+	case FILTER_BATCH_EQ:
+	case FILTER_BATCH_NE:
+	case FILTER_BATCH_LT:
+	case FILTER_BATCH_LE:
+	case FILTER_BATCH_GE:
+	case FILTER_BATCH_GT:
+		/** arithmetic operands are not supported */
+		for (i = 1; i <= part->num_operands; i++) {
+			if (parts[idx + i].batch_op != FILTER_BATCH_DKEY &&
+			    parts[idx + i].batch_op != FILTER_BATCH_AKEY &&
+			    parts[idx + i].batch_op != FILTER_BATCH_CONST)
+				return false;
+		}
+		return part->num_operands >= 2;
+	default:
+		return false;
+	}
+}
+
+/** Tag the parts of a compiled filter with their batch operation */
+bool
+filter_batch_compile(struct filter_compiled_t *filter)
+{
+	struct filter_part_compiled_t *part;
+	uint32_t                       i;
+	uint32_t                       j;
+
+	if (filter->num_parts == 0)
+		return false;
+
+	for (i = 0; i < filter->num_parts; i++) {
+		part             = &filter->parts[i];
+		part->batch_op   = FILTER_BATCH_NONE;
+		part->batch_type = 0;
+		for (j = 0; j < ARRAY_SIZE(batch_funcs); j++) {
+			if (batch_funcs[j].bf_func == part->filter_func) {
+				part->batch_op   = batch_funcs[j].bf_op;
+				part->batch_type = batch_funcs[j].bf_type;
+				break;
+			}
+		}
+	}
+
+	return batch_part_check(filter->parts, 0);
+}
+
+int
+pipeline_batch_init(struct pipeline_batch *batch, struct pipeline_compiled_t *pipe, uint32_t cap)
+{
+	uint32_t max_parts = 1;
+	uint32_t i;
+
+	memset(batch, 0, sizeof(*batch));
+	for (i = 0; i < pipe->num_filters; i++) {
+		if (pipe->filters[i].batch && pipe->filters[i].num_parts > max_parts)
+			max_parts = pipe->filters[i].num_parts;
+	}
+
+	batch->pb_cap       = cap;
+	batch->pb_max_parts = max_parts;
+	D_ALLOC_ARRAY(batch->pb_masks, (size_t)max_parts * cap);
+	D_ALLOC_ARRAY(batch->pb_valid, (size_t)max_parts * cap);
+	D_ALLOC_ARRAY(batch->pb_cols, (size_t)max_parts * cap);
+	D_ALLOC_ARRAY(batch->pb_sel, cap);
+	if (batch->pb_masks == NULL || batch->pb_valid == NULL || batch->pb_cols == NULL ||
+	    batch->pb_sel == NULL) {
+		pipeline_batch_fini(batch);
+		return -DER_NOMEM;
+	}
+
+	return 0;
+}
+
+void
+pipeline_batch_fini(struct pipeline_batch *batch)
+{
+	D_FREE(batch->pb_masks);
+	D_FREE(batch->pb_valid);
+	D_FREE(batch->pb_cols);
+	D_FREE(batch->pb_sel);
+}
+
+/**
+ * Number of records per batch when fetching \a iods: \a batch_size, reduced so that the fetch
+ * buffers of the records of a batch fit in PIPELINE_BATCH_BUF_MAX. Records are evaluated one by
+ * one if it is 1 or less.
+ */
+uint32_t
+pipeline_batch_cap(uint32_t batch_size, daos_iod_t *iods, uint32_t nr_iods)
+{
+	size_t   rec_size;
+	size_t   iod_size;
+	uint32_t i;
+	uint32_t j;
+
+	if (batch_size <= 1)
+		return batch_size;
+
+	/** as allocated by alloc_iter_bufs() in srv_pipeline.c, plus the scratch columns */
+	rec_size = sizeof(d_iov_t) + sizeof(daos_anchor_t) + sizeof(uint32_t);
+	for (i = 0; i < nr_iods; i++) {
+		iod_size = iods[i].iod_size;
+		if (iods[i].iod_type == DAOS_IOD_ARRAY) {
+			for (j = 0, iod_size = 0; j < iods[i].iod_nr; j++)
+				iod_size += iods[i].iod_recxs[j].rx_nr;
+			iod_size *= iods[i].iod_size;
+		}
+		rec_size += iod_size + sizeof(daos_iod_t) + sizeof(d_sg_list_t) + sizeof(d_iov_t);
+	}
+
+	return min(batch_size, PIPELINE_BATCH_BUF_MAX / rec_size);
+}
+
+union batch_scalar {
+	uint64_t	u;
+	int64_t		i;
+	double		d;
+};
+
+/** Records of the batch being evaluated */
+struct batch_rows {
+	struct pipeline_batch          *br_batch;
+	struct filter_part_run_t       *br_args;
+	struct filter_part_compiled_t  *br_parts;
+	d_iov_t                        *br_dkeys;
+	d_sg_list_t                   **br_akeys;
+	daos_iod_t                    **br_iods;
+	uint32_t                        br_nr;
+};
+
+static inline void
+batch_row_set(struct batch_rows *rows, uint32_t row)
+{
+	rows->br_args->dkey  = &rows->br_dkeys[row];
+	rows->br_args->akeys = rows->br_akeys[row];
+	rows->br_args->iods  = rows->br_iods[row];
+}
+
+static inline uint8_t *
+batch_mask(struct batch_rows *rows, uint32_t idx)
+{
+	return &rows->br_batch->pb_masks[(size_t)idx * rows->br_batch->pb_cap];
+}
+
+static inline uint8_t *
+batch_valid(struct batch_rows *rows, uint32_t idx)
+{
+	return &rows->br_batch->pb_valid[(size_t)idx * rows->br_batch->pb_cap];
+}
+
+static inline void *
+batch_col(struct batch_rows *rows, uint32_t idx)
+{
+	return &rows->br_batch->pb_cols[(size_t)idx * rows->br_batch->pb_cap];
+}
+
+/** Read the value of the part \a idx of one record, or of a constant if \a row is -1 */
+static inline bool
+batch_value(struct batch_rows *rows, uint32_t idx, int row, uint8_t type, void *val)
+{
+	struct filter_part_run_t *args = rows->br_args;
+
+	if (row >= 0)
+		batch_row_set(rows, rows->br_batch->pb_sel[row]);
+	args->part_idx    = idx;
+	args->value_u_out = 0;
+	args->value_i_out = 0;
+	args->value_d_out = 0;
+	rows->br_parts[idx].filter_func(args);
+
+	switch (type) {
+	case FILTER_BATCH_U:
+		*(uint64_t *)val = args->value_u_out;
+		break;
+	case FILTER_BATCH_I:
+		*(int64_t *)val = args->value_i_out;
+		break;
+	default:
+		*(double *)val = args->value_d_out;
+		break;
+	}
+	return args->data_out != NULL;
+}
+
+static inline void
+batch_load(const char *buf, uint8_t src, uint8_t type, void *val)
+{
+	union batch_scalar v;
+
+	switch (src) {
+	case BATCH_SRC_U1:
+		v.u = *(uint8_t *)buf;
+		break;
+	case BATCH_SRC_U2:
+		v.u = *(uint16_t *)buf;
+		break;
+	case BATCH_SRC_U4:
+		v.u = *(uint32_t *)buf;
+		break;
+	case BATCH_SRC_U8:
+		v.u = *(uint64_t *)buf;
+		break;
+	case BATCH_SRC_I1:
+		v.i = *(int8_t *)buf;
+		break;
+	case BATCH_SRC_I2:
+		v.i = *(int16_t *)buf;
+		break;
+	case BATCH_SRC_I4:
+		v.i = *(int32_t *)buf;
+		break;
+	case BATCH_SRC_I8:
+		v.i = *(int64_t *)buf;
+		break;
+	case BATCH_SRC_R4:
+		v.d = *(float *)buf;
+		break;
+	default:
+		v.d = *(double *)buf;
+		break;
+	}
+
+	switch (type) {
+	case FILTER_BATCH_U:
+		*(uint64_t *)val = v.u;
+		break;
+	case FILTER_BATCH_I:
+		*(int64_t *)val = v.i;
+		break;
+	default:
+		*(double *)val = v.d;
+		break;
+	}
+}
+
+/**
+ * Gather the values of the akey part \a idx of the selected records. Single values are read
+ * directly, the iod of the akey is looked up by name only when the iods of the record are not
+ * the ones of the previous record. Array values are read through the getdata function.
+ */
+static void
+batch_gather_akey(struct batch_rows *rows, uint32_t idx, uint8_t type)
+{
+	struct filter_part_compiled_t *part    = &rows->br_parts[idx];
+	uint8_t                        size    = batch_src_size[part->batch_type];
+	uint64_t                      *col     = batch_col(rows, idx);
+	uint8_t                       *valid   = batch_valid(rows, idx);
+	uint32_t                       nr_iods = rows->br_args->nr_iods;
+	void                          *name    = NULL;
+	daos_iod_t                    *iod;
+	d_iov_t                       *iov;
+	uint32_t                       row;
+	uint32_t                       i;
+	uint32_t                       k       = 0;
+
+	for (i = 0; i < rows->br_nr; i++) {
+		row = rows->br_batch->pb_sel[i];
+		iod = rows->br_iods[row];
+		if (k >= nr_iods || name == NULL || iod[k].iod_name.iov_buf != name) {
+			for (k = 0; k < nr_iods; k++) {
+				if (iod[k].iod_name.iov_len == part->iov->iov_len &&
+				    !memcmp(iod[k].iod_name.iov_buf, part->iov->iov_buf,
+					    part->iov->iov_len))
+					break;
+			}
+			name = k < nr_iods ? iod[k].iod_name.iov_buf : NULL;
+		}
+		if (k >= nr_iods) {
+			valid[i] = 0;
+			continue;
+		}
+		iod = &iod[k];
+		iov = rows->br_akeys[row][k].sg_iovs;
+		if (unlikely(iod->iod_type != DAOS_IOD_SINGLE)) {
+			valid[i] = batch_value(rows, idx, i, type, &col[i]);
+			continue;
+		}
+
+		valid[i] = iov->iov_len > 0;
+		col[i]   = 0;
+		if (valid[i] && part->data_offset + size <= iod->iod_size && size <= part->data_len)
+			batch_load((char *)iov->iov_buf + part->data_offset, part->batch_type, type,
+				   &col[i]);
+	}
+}
+
+/** Gather the values of the part \a idx of the selected records into its column */
+static void
+batch_gather(struct batch_rows *rows, uint32_t idx, uint8_t type)
+{
+	uint64_t *col   = batch_col(rows, idx);
+	uint8_t  *valid = batch_valid(rows, idx);
+	uint32_t  i;
+
+	if (rows->br_parts[idx].batch_op == FILTER_BATCH_AKEY) {
+		batch_gather_akey(rows, idx, type);
+		return;
+	}
+
+	for (i = 0; i < rows->br_nr; i++)
+		valid[i] = batch_value(rows, idx, i, type, &col[i]);
+}
+
+static void
+batch_eval_cmp(struct batch_rows *rows, uint32_t idx)
+{
+	struct filter_part_compiled_t *part  = &rows->br_parts[idx];
+	uint8_t                        op    = part->batch_op - FILTER_BATCH_EQ;
+	uint8_t                        type  = part->batch_type;
+	uint8_t                       *out   = batch_mask(rows, idx);
+	uint8_t                       *alive = batch_valid(rows, idx);
+	uint32_t                       left  = idx + 1;
+	uint32_t                       right;
+	uint8_t                       *valid;
+	union batch_scalar             lconst;
+	union batch_scalar             rconst;
+	uint8_t                        one = 1;
+	uint8_t                        res;
+	uint32_t                       i;
+
+	memset(out, 0, rows->br_nr);
+
+	if (rows->br_parts[left].batch_op == FILTER_BATCH_CONST) {
+		batch_value(rows, left, -1, type, &lconst);
+		memset(alive, 1, rows->br_nr);
+		for (right = left + 1; right <= idx + part->num_operands; right++) {
+			if (rows->br_parts[right].batch_op == FILTER_BATCH_CONST) {
+				/** constant result, the record is selected as long as alive */
+				batch_value(rows, right, -1, type, &rconst);
+				res = 0;
+				batch_cmps_funcs[op][type](1, &lconst, &rconst, &one, &res);
+				if (res) {
+					for (i = 0; i < rows->br_nr; i++)
+						out[i] |= alive[i];
+				}
+				continue;
+			}
+			batch_gather(rows, right, type);
+			valid = batch_valid(rows, right);
+			for (i = 0; i < rows->br_nr; i++)
+				alive[i] &= valid[i];
+			batch_cmps_funcs[batch_cmp_mirror[op] - FILTER_BATCH_EQ][type](
+			    rows->br_nr, batch_col(rows, right), &lconst, alive, out);
+		}
+		return;
+	}
+
+	batch_gather(rows, left, type);
+	memcpy(alive, batch_valid(rows, left), rows->br_nr);
+	for (right = left + 1; right <= idx + part->num_operands; right++) {
+		if (rows->br_parts[right].batch_op == FILTER_BATCH_CONST) {
+			batch_value(rows, right, -1, type, &rconst);
+			batch_cmps_funcs[op][type](rows->br_nr, batch_col(rows, left), &rconst,
+						   alive, out);
+			continue;
+		}
+		batch_gather(rows, right, type);
+		valid = batch_valid(rows, right);
+		for (i = 0; i < rows->br_nr; i++)
+			alive[i] &= valid[i];
+		batch_cmp_funcs[op][type](rows->br_nr, batch_col(rows, left),
+					  batch_col(rows, right), alive, out);
+	}
+}
+
+/** Evaluate the part \a idx over the selected records into its mask */
+static void
+batch_eval(struct batch_rows *rows, uint32_t idx)
+{
+	struct filter_part_compiled_t *part = &rows->br_parts[idx];
+	uint8_t                       *out  = batch_mask(rows, idx);
+	uint8_t                       *mask;
+	uint32_t                       child;
+	uint32_t                       i;
+	uint32_t                       j;
+
+	switch (part->batch_op) {
+	case FILTER_BATCH_AND:
+	case FILTER_BATCH_OR:
+		child = idx + 1;
+		batch_eval(rows, child);
+		memcpy(out, batch_mask(rows, child), rows->br_nr);
+		for (i = 1; i < part->num_operands; i++) {
+			child = rows->br_parts[child].idx_end_subtree + 1;
+			batch_eval(rows, child);
+			mask = batch_mask(rows, child);
+			if (part->batch_op == FILTER_BATCH_AND) {
+				for (j = 0; j < rows->br_nr; j++)
+					out[j] &= mask[j];
+			} else {
+				for (j = 0; j < rows->br_nr; j++)
+					out[j] |= mask[j];
+			}
+		}
+		break;
+	case FILTER_BATCH_NOT:
+		batch_eval(rows, idx + 1);
+		mask = batch_mask(rows, idx + 1);
+		for (j = 0; j < rows->br_nr; j++)
+			out[j] = !mask[j];
+		break;
+	default:
+		batch_eval_cmp(rows, idx);
+		break;
+	}
+}
+
+/**
+ * Evaluate the filters of \a pipe over \a nr records. The indexes of the records passing all
+ * the filters are returned in batch->pb_sel.
+ */
+int
+pipeline_filters_batch(struct pipeline_batch *batch, struct pipeline_compiled_t *pipe,
+		       struct filter_part_run_t *args, uint32_t nr, d_iov_t *dkeys,
+		       d_sg_list_t **akeys, daos_iod_t **iods, uint32_t *nr_sel)
+{
+	struct batch_rows rows;
+	uint8_t          *mask;
+	uint32_t          nr_pass;
+	uint32_t          i;
+	uint32_t          j;
+	int               rc;
+
+	D_ASSERT(nr <= batch->pb_cap);
+	for (i = 0; i < nr; i++)
+		batch->pb_sel[i] = i;
+
+	rows.br_batch = batch;
+	rows.br_args  = args;
+	rows.br_dkeys = dkeys;
+	rows.br_akeys = akeys;
+	rows.br_iods  = iods;
+	rows.br_nr    = nr;
+
+	for (i = 0; i < pipe->num_filters && rows.br_nr > 0; i++) {
+		rows.br_parts = pipe->filters[i].parts;
+		args->parts   = rows.br_parts;
+		nr_pass       = 0;
+
+		if (pipe->filters[i].batch) {
+			batch_eval(&rows, 0);
+			mask = batch_mask(&rows, 0);
+			/** branch-free compaction of the selection vector */
+			for (j = 0; j < rows.br_nr; j++) {
+				batch->pb_sel[nr_pass] = batch->pb_sel[j];
+				nr_pass += mask[j];
+			}
+		} else {
+			for (j = 0; j < rows.br_nr; j++) {
+				batch_row_set(&rows, batch->pb_sel[j]);
+				args->part_idx = 0;
+				rc = rows.br_parts[0].filter_func(args);
+				if (rc != 0)
+					return rc;
+				batch->pb_sel[nr_pass] = batch->pb_sel[j];
+				nr_pass += args->log_out;
+			}
+		}
+		rows.br_nr = nr_pass;
+	}
+
+	*nr_sel = rows.br_nr;
+	return 0;
+}
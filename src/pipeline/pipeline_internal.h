@@ -29,6 +29,29 @@ struct filter_part_run_t {
 
 typedef int filter_func_t(struct filter_part_run_t *args);
 
+/** Operation of a filter part in a batch evaluation, see filter_batch.c */
+enum filter_batch_op {
+	FILTER_BATCH_NONE = 0,
+	FILTER_BATCH_DKEY,
+	FILTER_BATCH_AKEY,
+	FILTER_BATCH_CONST,
+	FILTER_BATCH_AND,
+	FILTER_BATCH_OR,
+	FILTER_BATCH_NOT,
+	FILTER_BATCH_EQ,
+	FILTER_BATCH_NE,
+	FILTER_BATCH_LT,
+	FILTER_BATCH_LE,
+	FILTER_BATCH_GE,
+	FILTER_BATCH_GT,
+};
+
+enum filter_batch_type {
+	FILTER_BATCH_U = 0,
+	FILTER_BATCH_I,
+	FILTER_BATCH_D,
+};
+
 struct filter_part_compiled_t {
 	uint32_t	num_operands;
 	uint32_t	idx_end_subtree;
@@ -36,11 +59,15 @@ struct filter_part_compiled_t {
 	size_t		data_offset;
 	size_t		data_len;
 	filter_func_t	*filter_func;
+	uint8_t		batch_op;
+	uint8_t		batch_type;
 };
 
 struct filter_compiled_t {
 	uint32_t			num_parts;
 	struct filter_part_compiled_t	*parts;
+	/** all parts can be evaluated over a batch of records */
+	bool				batch;
 };
 
 struct pipeline_compiled_t {
@@ -60,19 +87,80 @@ typedef struct {
 	d_sg_list_t	*sgls;
 } daos_pipeline_sgls_t;
 
+/** Maximum number of aggregation filters of a pipeline run on a whole container */
+#define PIPELINE_CONT_AGGR_MAX	16
+
+/**
+ * Partial aggregates of a container-wide pipeline run, merged up the collective tree. Averages
+ * are carried as sums until the end, where they are divided by \a nr_pass.
+ */
+typedef struct {
+	uint64_t	nr_pass;
+	uint32_t	nr;
+	uint32_t	pad32;
+	double		vals[PIPELINE_CONT_AGGR_MAX];
+} daos_pipeline_aggrs_t;
+
+/**
+ * Default and maximum number of records whose filters are evaluated at once, batches are off by
+ * default. Each record of a batch has its own fetch buffers, which are bounded by
+ * PIPELINE_BATCH_BUF_MAX per batch.
+ */
+#define PIPELINE_BATCH_SIZE_DEF	0
+#define PIPELINE_BATCH_SIZE_MAX	1024
+#define PIPELINE_BATCH_BUF_MAX	(256 << 10)
+
+/** Number of records per batch (DAOS_PIPELINE_BATCH), per-record evaluation if <= 1 */
+extern unsigned int ds_pipeline_batch_size;
+
+/**
+ * Scratch space of the evaluation of the filters of a pipeline over a batch of records. The
+ * values read by each filter part are gathered into one column per part, the comparisons and
+ * logical operators are then evaluated over whole columns. The records passing all the filters
+ * are returned in the selection vector \a pb_sel.
+ */
+struct pipeline_batch {
+	uint32_t	 pb_cap;
+	uint32_t	 pb_max_parts;
+	/** one mask, one validity and one value column per filter part */
+	uint8_t		*pb_masks;
+	uint8_t		*pb_valid;
+	uint64_t	*pb_cols;
+	uint32_t	*pb_sel;
+};
+
 void ds_pipeline_run_handler(crt_rpc_t *rpc);
+void ds_pipeline_cont_run_handler(crt_rpc_t *rpc);
+void ds_pipeline_tgt_run_handler(crt_rpc_t *rpc);
+int ds_pipeline_tgt_run_aggregator(crt_rpc_t *source, crt_rpc_t *result, void *priv);
+extern struct crt_corpc_ops ds_pipeline_tgt_run_co_ops;
 
 int d_pipeline_check(daos_pipeline_t *pipeline);
 
 void pipeline_aggregations_init(daos_pipeline_t *pipeline,
 				d_sg_list_t *sgl_agg);
 
+void pipeline_aggregations_merge(daos_pipeline_t *pipeline, double *dst, double *src);
+
 void pipeline_aggregations_fixavgs(daos_pipeline_t *pipeline, double total, d_sg_list_t *sgl_agg);
 
 int pipeline_compile(daos_pipeline_t *pipe, struct pipeline_compiled_t *comp_pipe);
 
 void pipeline_compile_free(struct pipeline_compiled_t *comp_pipe);
 
+bool filter_batch_compile(struct filter_compiled_t *filter);
+
+int pipeline_batch_init(struct pipeline_batch *batch, struct pipeline_compiled_t *pipe,
+			uint32_t cap);
+
+void pipeline_batch_fini(struct pipeline_batch *batch);
+
+uint32_t pipeline_batch_cap(uint32_t batch_size, daos_iod_t *iods, uint32_t nr_iods);
+
+int pipeline_filters_batch(struct pipeline_batch *batch, struct pipeline_compiled_t *pipe,
+			   struct filter_part_run_t *args, uint32_t nr, d_iov_t *dkeys,
+			   d_sg_list_t **akeys, daos_iod_t **iods, uint32_t *nr_sel);
+
 typedef uint8_t _uint8_t;
 typedef uint16_t _uint16_t;
 typedef uint32_t _uint32_t;
@@ -345,6 +345,8 @@ crt_proc_daos_pipeline_stats_t(crt_proc_t proc, crt_proc_op_t proc_op, daos_pipe
 }
 
 CRT_RPC_DEFINE(pipeline_run, DAOS_ISEQ_PIPELINE_RUN, DAOS_OSEQ_PIPELINE_RUN)
+CRT_RPC_DEFINE(pipeline_cont_run, DAOS_ISEQ_PIPELINE_CONT_RUN, DAOS_OSEQ_PIPELINE_CONT_RUN)
+CRT_RPC_DEFINE(pipeline_tgt_run, DAOS_ISEQ_PIPELINE_TGT_RUN, DAOS_OSEQ_PIPELINE_TGT_RUN)
 
 #define X(a, b, c, ...)                                                                            \
 	{                                                                                          \
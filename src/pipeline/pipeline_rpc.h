@@ -17,7 +17,11 @@
  * OPCODE, flags, FMT, handler, corpc_hdlr
  */
 #define PIPELINE_PROTO_CLI_RPC_LIST                                                                \
-	X(DAOS_PIPELINE_RPC_RUN, 0, &CQF_pipeline_run, ds_pipeline_run_handler, NULL)
+	X(DAOS_PIPELINE_RPC_RUN, 0, &CQF_pipeline_run, ds_pipeline_run_handler, NULL)             \
+	X(DAOS_PIPELINE_RPC_CONT_RUN, 0, &CQF_pipeline_cont_run, ds_pipeline_cont_run_handler,    \
+	  NULL)                                                                                    \
+	X(DAOS_PIPELINE_RPC_TGT_RUN, 0, &CQF_pipeline_tgt_run, ds_pipeline_tgt_run_handler,       \
+	  &ds_pipeline_tgt_run_co_ops)
 
 #define X(a, ...) a,
 enum pipeline_rpc_opc {
@@ -66,4 +70,39 @@ extern struct crt_proto_format pipeline_proto_fmt;
 
 CRT_RPC_DECLARE(pipeline_run, DAOS_ISEQ_PIPELINE_RUN, DAOS_OSEQ_PIPELINE_RUN)
 
+/** Run a pipeline on a whole container, sent by the client to any engine of the pool */
+#define DAOS_ISEQ_PIPELINE_CONT_RUN	/* input fields */		\
+	((daos_pipeline_t)	(pci_pipe)		CRT_VAR)	\
+	((uuid_t)		(pci_pool_uuid)		CRT_VAR)	\
+	((uuid_t)		(pci_co_hdl)		CRT_VAR)	\
+	((uuid_t)		(pci_co_uuid)		CRT_VAR)	\
+	((daos_pipeline_iods_t)	(pci_iods)		CRT_VAR)	\
+	((daos_epoch_range_t)	(pci_epr)		CRT_VAR)	\
+	((uint64_t)		(pci_flags)		CRT_VAR)
+
+#define DAOS_OSEQ_PIPELINE_CONT_RUN	/* output fields */		\
+	((daos_pipeline_aggrs_t)	(pco_aggrs)	CRT_RAW)	\
+	((daos_pipeline_stats_t)	(pco_stats)	CRT_VAR)	\
+	((int32_t)			(pco_ret)	CRT_VAR)	\
+	((uint32_t)			(pco_pad32)	CRT_VAR)
+
+CRT_RPC_DECLARE(pipeline_cont_run, DAOS_ISEQ_PIPELINE_CONT_RUN, DAOS_OSEQ_PIPELINE_CONT_RUN)
+
+/** Collective RPC broadcast by the engine handling DAOS_PIPELINE_RPC_CONT_RUN */
+#define DAOS_ISEQ_PIPELINE_TGT_RUN	/* input fields */		\
+	((daos_pipeline_t)	(pti_pipe)		CRT_VAR)	\
+	((uuid_t)		(pti_pool_uuid)		CRT_VAR)	\
+	((uuid_t)		(pti_co_uuid)		CRT_VAR)	\
+	((daos_pipeline_iods_t)	(pti_iods)		CRT_VAR)	\
+	((daos_epoch_range_t)	(pti_epr)		CRT_VAR)	\
+	((uint64_t)		(pti_flags)		CRT_VAR)
+
+#define DAOS_OSEQ_PIPELINE_TGT_RUN	/* output fields */		\
+	((daos_pipeline_aggrs_t)	(pto_aggrs)	CRT_RAW)	\
+	((daos_pipeline_stats_t)	(pto_stats)	CRT_VAR)	\
+	((int32_t)			(pto_ret)	CRT_VAR)	\
+	((uint32_t)			(pto_pad32)	CRT_VAR)
+
+CRT_RPC_DECLARE(pipeline_tgt_run, DAOS_ISEQ_PIPELINE_TGT_RUN, DAOS_OSEQ_PIPELINE_TGT_RUN)
+
 #endif /* __DAOS_PIPE_RPC_H__ */
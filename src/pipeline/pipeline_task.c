@@ -45,3 +45,29 @@ dc_pipeline_run_task_create(daos_handle_t coh, daos_handle_t oh, daos_handle_t t
 
 	return 0;
 }
+
+int
+dc_pipeline_run_cont_task_create(daos_handle_t coh, daos_pipeline_t *pipeline, uint64_t flags,
+				 uint32_t nr_iods, daos_iod_t *iods, d_sg_list_t *sgl_agg,
+				 daos_pipeline_stats_t *stats, daos_event_t *ev, tse_sched_t *tse,
+				 tse_task_t **task)
+{
+	daos_pipeline_run_cont_t *args;
+	int                       rc;
+
+	DAOS_API_ARG_ASSERT(*args, PIPELINE_RUN_CONT);
+	rc = dc_task_create(dc_pipeline_run_cont, tse, ev, task);
+	if (rc)
+		return rc;
+
+	args           = dc_task_get_args(*task);
+	args->coh      = coh;
+	args->pipeline = pipeline;
+	args->flags    = flags;
+	args->nr_iods  = nr_iods;
+	args->iods     = iods;
+	args->sgl_agg  = sgl_agg;
+	args->stats    = stats;
+
+	return 0;
+}
@@ -10,9 +10,21 @@
 #include <daos/rpc.h>
 #include "pipeline_rpc.h"
 
+unsigned int ds_pipeline_batch_size = PIPELINE_BATCH_SIZE_DEF;
+
 static int
 pipeline_mod_init(void)
 {
+	d_getenv_uint("DAOS_PIPELINE_BATCH", &ds_pipeline_batch_size);
+	if (ds_pipeline_batch_size > PIPELINE_BATCH_SIZE_MAX) {
+		D_WARN("Invalid pipeline batch size %u, set to %u\n", ds_pipeline_batch_size,
+		       PIPELINE_BATCH_SIZE_MAX);
+		ds_pipeline_batch_size = PIPELINE_BATCH_SIZE_MAX;
+	}
+	if (ds_pipeline_batch_size > 1)
+		D_INFO("Pipeline filters evaluated over batches of up to %u records\n",
+		       ds_pipeline_batch_size);
+
 	return 0;
 }
 
@@ -22,6 +34,11 @@ pipeline_mod_fini(void)
 	return 0;
 }
 
+struct crt_corpc_ops ds_pipeline_tgt_run_co_ops = {
+	.co_aggregate = ds_pipeline_tgt_run_aggregator,
+	.co_pre_forward = NULL,
+};
+
 #define X(a, b, c, d, e, ...)                                                                      \
 	{                                                                                          \
 	    .dr_opc       = a,                                                                     \
@@ -9,7 +9,10 @@
 
 #include <math.h>
 #include <daos/rpc.h>
+#include <daos/object.h>
+#include <daos/placement.h>
 #include <daos_srv/container.h>
+#include <daos_srv/pool.h>
 #include <daos_srv/vos_types.h>
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/vos.h>
@@ -23,6 +26,11 @@
  */
 #define PIPELINE_ITERATION_MAX	1024
 
+/**
+ * Number of objects collected per VOS object iteration during a container scan.
+ */
+#define PIPELINE_SCAN_OBJ_BATCH	128
+
 /**
  * Used keep track of the credit system for yielding.
  */
@@ -31,6 +39,22 @@ struct enum_credits {
 	uint32_t max;
 };
 
+/**
+ * Records fetched ahead so that the filters are evaluated over a batch of them. The dkey
+ * anchor after each record is kept so that the iteration can be resumed from the first record
+ * not consumed.
+ */
+struct pipeline_rows {
+	uint32_t               pr_cap;
+	uint32_t               pr_nr;
+	uint32_t               pr_nr_iods;
+	d_iov_t               *pr_dkeys;
+	daos_iod_t           **pr_iods;
+	d_sg_list_t          **pr_sgls;
+	daos_anchor_t         *pr_anchors;
+	struct pipeline_batch  pr_batch;
+};
+
 /**
  * Used to keep track of where we need to copy data on return buffers.
  */
@@ -265,6 +289,116 @@ free_iter_bufs(uint32_t nr, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_iter)
 		D_FREE(iods_iter);
 }
 
+static void
+pipeline_rows_fini(struct pipeline_rows *rows)
+{
+	uint32_t i;
+
+	for (i = 0; i < rows->pr_cap; i++) {
+		if (rows->pr_dkeys != NULL)
+			D_FREE(rows->pr_dkeys[i].iov_buf);
+		if (rows->pr_iods != NULL && rows->pr_sgls != NULL)
+			free_iter_bufs(rows->pr_nr_iods, rows->pr_iods[i], rows->pr_sgls[i]);
+	}
+	D_FREE(rows->pr_dkeys);
+	D_FREE(rows->pr_iods);
+	D_FREE(rows->pr_sgls);
+	D_FREE(rows->pr_anchors);
+	pipeline_batch_fini(&rows->pr_batch);
+}
+
+static int
+pipeline_rows_init(struct pipeline_rows *rows, struct pipeline_compiled_t *pipe, daos_iod_t *iods,
+		   uint32_t nr_iods, uint32_t cap)
+{
+	uint32_t i;
+	int      rc;
+
+	memset(rows, 0, sizeof(*rows));
+	rows->pr_cap     = cap;
+	rows->pr_nr_iods = nr_iods;
+
+	D_ALLOC_ARRAY(rows->pr_dkeys, cap);
+	D_ALLOC_ARRAY(rows->pr_iods, cap);
+	D_ALLOC_ARRAY(rows->pr_sgls, cap);
+	D_ALLOC_ARRAY(rows->pr_anchors, cap);
+	if (rows->pr_dkeys == NULL || rows->pr_iods == NULL || rows->pr_sgls == NULL ||
+	    rows->pr_anchors == NULL)
+		D_GOTO(error, rc = -DER_NOMEM);
+
+	for (i = 0; i < cap; i++) {
+		rc = alloc_iter_bufs(iods, nr_iods, &rows->pr_iods[i], &rows->pr_sgls[i]);
+		if (rc != 0)
+			D_GOTO(error, rc);
+	}
+
+	rc = pipeline_batch_init(&rows->pr_batch, pipe, cap);
+	if (rc != 0)
+		D_GOTO(error, rc);
+
+	return 0;
+error:
+	pipeline_rows_fini(rows);
+	return rc;
+}
+
+/**
+ * Fetch the next records of an object and evaluate the filters over them. The indexes of the
+ * records passing the filters are returned in rows->pr_batch.pb_sel.
+ */
+static int
+pipeline_rows_next(struct pipeline_rows *rows, daos_handle_t vos_coh, daos_unit_oid_t oid,
+		   daos_epoch_range_t epr, struct vos_iter_anchors *anchors,
+		   struct pipeline_compiled_t *pipe, struct filter_part_run_t *run_args,
+		   struct enum_credits *credits, daos_pipeline_stats_t *stats, uint32_t *nr_sel)
+{
+	d_iov_t  d_key_iter;
+	d_iov_t *dkey;
+	uint32_t i;
+	int      rc;
+
+	rows->pr_nr = 0;
+	while (rows->pr_nr < rows->pr_cap && !daos_anchor_is_eof(&anchors->ia_dkey)) {
+		i  = rows->pr_nr;
+		rc = pipeline_fetch_record(vos_coh, oid, anchors, epr, rows->pr_iods[i],
+					   rows->pr_nr_iods, &d_key_iter, rows->pr_sgls[i]);
+		if (rc < 0)
+			return rc;
+		if (rc == 1)
+			continue;
+
+		stats->nr_dkeys += 1;
+
+		/** the dkey may not be valid anymore once the next one is fetched */
+		dkey = &rows->pr_dkeys[i];
+		if (dkey->iov_buf_len < d_key_iter.iov_len) {
+			D_FREE(dkey->iov_buf);
+			D_ALLOC(dkey->iov_buf, d_key_iter.iov_len);
+			if (dkey->iov_buf == NULL)
+				return -DER_NOMEM;
+			dkey->iov_buf_len = d_key_iter.iov_len;
+		}
+		memcpy(dkey->iov_buf, d_key_iter.iov_buf, d_key_iter.iov_len);
+		dkey->iov_len = d_key_iter.iov_len;
+
+		rows->pr_anchors[i] = anchors->ia_dkey;
+		rows->pr_nr++;
+
+		credits->used++;
+		if (credits->used > credits->max) {
+			credits->used = 0;
+			dss_sleep(0);
+		}
+	}
+
+	*nr_sel = 0;
+	if (rows->pr_nr == 0)
+		return 0;
+
+	return pipeline_filters_batch(&rows->pr_batch, pipe, run_args, rows->pr_nr, rows->pr_dkeys,
+				      rows->pr_sgls, rows->pr_iods, nr_sel);
+}
+
 static int
 pack_value(d_sg_list_t *sgl, uint32_t *iov_idx, d_iov_t *iov)
 {
@@ -348,6 +482,71 @@ pack_record(d_iov_t *d_key_iter, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_it
 	return 0;
 }
 
+/**
+ * Batched version of the record loop of ds_pipeline_run(). It returns once all the records are
+ * read or \a nr_kds records are returned, the anchor is then left on the first record not
+ * consumed.
+ */
+static int
+pipeline_run_batch(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_epoch_range_t epr,
+		   daos_pipeline_t *pipeline, struct pipeline_compiled_t *pipe,
+		   struct filter_part_run_t *run_args, daos_iod_t *iods, uint32_t nr_iods,
+		   struct vos_iter_anchors *anchors, uint32_t cap, uint32_t nr_kds,
+		   uint32_t *nr_kds_pass, struct pack_ret_data_args *pack_args,
+		   d_sg_list_t *sgl_agg, struct enum_credits *credits, daos_pipeline_stats_t *stats)
+{
+	struct pipeline_rows rows;
+	uint32_t             nr_sel;
+	uint32_t             i;
+	uint32_t             r;
+	int                  rc;
+
+	rc = pipeline_rows_init(&rows, pipe, iods, nr_iods, cap);
+	if (rc != 0)
+		return rc;
+
+	while (!daos_anchor_is_eof(&anchors->ia_dkey)) {
+		if (pipeline->num_aggr_filters == 0 && *nr_kds_pass == nr_kds)
+			break; /** all records read */
+
+		rc = pipeline_rows_next(&rows, vos_coh, oid, epr, anchors, pipe, run_args, credits,
+					stats, &nr_sel);
+		if (rc < 0)
+			D_GOTO(out, rc);
+
+		for (i = 0; i < nr_sel; i++) {
+			r = rows.pr_batch.pb_sel[i];
+			(*nr_kds_pass)++;
+
+			run_args->iods = rows.pr_iods[r];
+			rc = pipeline_aggregations(pipe, run_args, &rows.pr_dkeys[r],
+						   rows.pr_sgls[r], sgl_agg);
+			if (rc < 0)
+				D_GOTO(out, rc);
+
+			if (nr_kds == 0 ||
+			    (pipeline->num_aggr_filters > 0 && *nr_kds_pass > 1))
+				continue;
+
+			rc = pack_record(&rows.pr_dkeys[r], rows.pr_iods[r], rows.pr_sgls[r],
+					 *nr_kds_pass - 1, pack_args);
+			if (rc != 0)
+				D_GOTO(out, rc);
+
+			if (pipeline->num_aggr_filters == 0 && *nr_kds_pass == nr_kds) {
+				/** the records fetched after this one are read again next time */
+				anchors->ia_dkey = rows.pr_anchors[r];
+				stats->nr_dkeys -= rows.pr_nr - r - 1;
+				break;
+			}
+		}
+	}
+	rc = 0;
+out:
+	pipeline_rows_fini(&rows);
+	return rc;
+}
+
 /** TODO: This code still assumes dkey==NULL. The code for dkey!=NULL has to be written */
 static int
 ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipeline,
@@ -359,6 +558,7 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 {
 	int                         rc;
 	uint32_t                    nr_kds_pass;
+	uint32_t                    batch_cap;
 	d_iov_t                     d_key_iter;
 	d_sg_list_t                *sgl_recx_iter      = NULL;
 	daos_iod_t                 *iods_iter          = NULL;
@@ -420,6 +620,19 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	anchors.ia_dkey = *anchor;
 	credits.max     = PIPELINE_ITERATION_MAX;
 
+	/** no more records than returned are fetched ahead */
+	batch_cap = pipeline_batch_cap(ds_pipeline_batch_size, iods, nr_iods);
+	if (pipeline.num_aggr_filters == 0)
+		batch_cap = min(batch_cap, nr_kds);
+	if (batch_cap > 1) {
+		/** all the records are consumed in batches, nothing is left to the loop below */
+		rc = pipeline_run_batch(vos_coh, oid, epr, &pipeline, &pipeline_compiled,
+					&pipe_run_args, iods, nr_iods, &anchors, batch_cap, nr_kds,
+					&nr_kds_pass, &pack_args, sgl_agg, &credits, stats);
+		if (rc != 0)
+			D_GOTO(exit, rc);
+	}
+
 	while (!daos_anchor_is_eof(&anchors.ia_dkey)) {
 		if (pipeline.num_aggr_filters == 0 && nr_kds_pass == nr_kds)
 			break; /** all records read */
@@ -897,3 +1110,480 @@ exit:
 	d_sgl_fini(&pri->pri_sgl_recx, true);
 	d_sgl_fini(&pri->pri_sgl_agg, true);
 }
+
+/**
+ * Scan all dkeys of one object shard for a container-wide pipeline run. Matching records are
+ * only aggregated, no record is returned.
+ */
+static int
+pipeline_scan_object(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_epoch_range_t epr,
+		     struct pipeline_compiled_t *pipe, struct filter_part_run_t *run_args,
+		     daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_iter, uint32_t nr_iods,
+		     d_sg_list_t *sgl_agg, struct enum_credits *credits, struct pipeline_rows *rows,
+		     daos_pipeline_aggrs_t *aggrs, daos_pipeline_stats_t *stats)
+{
+	struct vos_iter_anchors anchors = {0};
+	d_iov_t                 d_key_iter;
+	uint32_t                nr_sel;
+	uint32_t                i;
+	uint32_t                r;
+	int                     rc;
+
+	while (rows != NULL && !daos_anchor_is_eof(&anchors.ia_dkey)) {
+		rc = pipeline_rows_next(rows, vos_coh, oid, epr, &anchors, pipe, run_args, credits,
+					stats, &nr_sel);
+		if (rc < 0)
+			return rc;
+
+		for (i = 0; i < nr_sel; i++) {
+			r = rows->pr_batch.pb_sel[i];
+			aggrs->nr_pass++;
+			run_args->iods = rows->pr_iods[r];
+			rc = pipeline_aggregations(pipe, run_args, &rows->pr_dkeys[r],
+						   rows->pr_sgls[r], sgl_agg);
+			if (rc < 0)
+				return rc;
+		}
+	}
+
+	while (!daos_anchor_is_eof(&anchors.ia_dkey)) {
+		rc = pipeline_fetch_record(vos_coh, oid, &anchors, epr, iods_iter, nr_iods,
+					   &d_key_iter, sgl_recx_iter);
+		if (rc < 0)
+			return rc;
+		if (rc == 1)
+			continue;
+
+		stats->nr_dkeys += 1;
+
+		credits->used++;
+		if (credits->used > credits->max) {
+			credits->used = 0;
+			dss_sleep(0);
+		}
+
+		rc = pipeline_filters(pipe, run_args, &d_key_iter, sgl_recx_iter);
+		if (rc < 0)
+			return rc;
+		if (rc == 1)
+			continue;
+
+		aggrs->nr_pass++;
+		rc = pipeline_aggregations(pipe, run_args, &d_key_iter, sgl_recx_iter, sgl_agg);
+		if (rc < 0)
+			return rc;
+	}
+
+	return 0;
+}
+
+/** Per-target arguments of a container scan, reduced into the engine ones */
+struct pipeline_scan_args {
+	struct pipeline_tgt_run_in *psa_in;
+	daos_pipeline_aggrs_t       psa_aggrs;
+	daos_pipeline_stats_t       psa_stats;
+};
+
+struct pipeline_obj_batch {
+	uint32_t        pob_nr;
+	daos_unit_oid_t pob_oids[PIPELINE_SCAN_OBJ_BATCH];
+};
+
+static int
+obj_batch_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
+	     vos_iter_param_t *param, void *cb_arg, unsigned int *acts)
+{
+	struct pipeline_obj_batch *batch = cb_arg;
+
+	/** the anchor is left on this object, it is the first one of the next batch */
+	if (batch->pob_nr == PIPELINE_SCAN_OBJ_BATCH) {
+		*acts |= VOS_ITER_CB_EXIT;
+		return 0;
+	}
+	batch->pob_oids[batch->pob_nr++] = entry->ie_oid;
+
+	return 0;
+}
+
+static void
+pipeline_aggrs_sgl(daos_pipeline_aggrs_t *aggrs, d_iov_t *iovs, d_sg_list_t *sgl)
+{
+	uint32_t i;
+
+	for (i = 0; i < aggrs->nr; i++)
+		d_iov_set(&iovs[i], &aggrs->vals[i], sizeof(aggrs->vals[i]));
+	sgl->sg_nr     = aggrs->nr;
+	sgl->sg_nr_out = 0;
+	sgl->sg_iovs   = iovs;
+}
+
+/**
+ * Check whether \a oid is the shard to scan of its redundancy group, the first replica of the
+ * group on a healthy target, so that replicated records are aggregated once even when the first
+ * replica is down or being rebuilt.
+ *
+ * \return	1 if the local shard shall be scanned, 0 if not, negative DER on failure.
+ */
+static int
+pipeline_shard_is_leader(struct ds_cont_child *coc, daos_unit_oid_t oid,
+			 struct daos_oclass_attr *oca)
+{
+	struct ds_pool       *pool     = coc->sc_pool->spc_pool;
+	uint32_t              grp_size = daos_oclass_grp_size(oca);
+	struct daos_obj_md    md       = {0};
+	struct pl_obj_layout *layout   = NULL;
+	struct pl_obj_shard  *shard;
+	struct pool_target   *target;
+	struct pl_map        *map;
+	uint32_t              i;
+	int                   rc;
+
+	/** nothing to choose from */
+	if (grp_size == 1)
+		return 1;
+
+	map = pl_map_find(pool->sp_uuid, oid.id_pub);
+	if (map == NULL) {
+		D_ERROR("Failed to find pool map to check leader for " DF_UOID "\n", DP_UOID(oid));
+		return -DER_INVAL;
+	}
+
+	md.omd_id       = oid.id_pub;
+	md.omd_grp_spec = oid.id_shard / grp_size;
+	md.omd_flags    = PL_FL_GRP_SPEC;
+	md.omd_ver      = pool->sp_map_version;
+	md.omd_fdom_lvl = coc->sc_props.dcp_redun_lvl;
+	md.omd_pdom_lvl = coc->sc_props.dcp_perf_domain;
+	md.omd_pda      = coc->sc_props.dcp_rp_pda;
+	rc = pl_obj_place(map, oid.id_layout_ver, &md, DAOS_OO_RO, NULL, &layout);
+	if (rc != 0) {
+		DL_ERROR(rc, "Failed to load layout of " DF_UOID, DP_UOID(oid));
+		goto out;
+	}
+
+	rc = -DER_NONEXIST;
+	for (i = md.omd_grp_spec * grp_size; i < (md.omd_grp_spec + 1) * grp_size; i++) {
+		shard = &layout->ol_shards[i];
+		if (shard->po_target == -1 || shard->po_shard == -1 || shard->po_rebuilding)
+			continue;
+
+		rc = pool_map_find_target(map->pl_poolmap, shard->po_target, &target);
+		D_ASSERT(rc == 1);
+		if (target->ta_comp.co_status != PO_COMP_ST_UPIN) {
+			rc = -DER_NONEXIST;
+			continue;
+		}
+
+		rc = dss_self_rank() == target->ta_comp.co_rank &&
+		     dss_get_module_info()->dmi_tgt_id == target->ta_comp.co_index;
+		break;
+	}
+
+	/** no healthy replica to scan, the data of the group is unavailable */
+	if (rc < 0)
+		D_ERROR(DF_UOID " has no healthy replica, layout version %u\n", DP_UOID(oid),
+			md.omd_ver);
+out:
+	if (layout != NULL)
+		pl_obj_layout_free(layout);
+	pl_map_decref(map);
+	return rc;
+}
+
+/**
+ * Scan the local shards of all objects of the container on this target. Only the first healthy
+ * replica of each redundancy group is scanned so that replicated records are aggregated once,
+ * see pipeline_shard_is_leader().
+ */
+static int
+pipeline_scan_one(void *vin)
+{
+	struct dss_coll_stream_args *reduce        = vin;
+	struct dss_stream_arg_type  *streams       = reduce->csa_streams;
+	int                          tid           = dss_get_module_info()->dmi_tgt_id;
+	struct pipeline_scan_args   *args          = streams[tid].st_arg;
+	struct pipeline_tgt_run_in  *in            = args->psa_in;
+	struct ds_cont_child        *coc           = NULL;
+	struct pipeline_obj_batch   *batch         = NULL;
+	struct pipeline_compiled_t   compiled      = {0};
+	struct filter_part_run_t     run_args      = {0};
+	struct enum_credits          credits       = {0};
+	struct vos_iter_anchors      anchors       = {0};
+	vos_iter_param_t             param         = {0};
+	struct pipeline_rows         rows;
+	bool                         batched       = false;
+	daos_iod_t                  *iods_iter     = NULL;
+	d_sg_list_t                 *sgl_recx_iter = NULL;
+	d_iov_t                      iovs_agg[PIPELINE_CONT_AGGR_MAX];
+	d_sg_list_t                  sgl_agg;
+	struct daos_oclass_attr     *oca;
+	daos_unit_oid_t              oid;
+	uint32_t                     batch_cap;
+	uint32_t                     i;
+	int                          rc;
+
+	rc = ds_cont_child_lookup(in->pti_pool_uuid, in->pti_co_uuid, &coc);
+	if (rc != 0) {
+		DL_ERROR(rc, DF_CONT ": failed to lookup container",
+			 DP_CONT(in->pti_pool_uuid, in->pti_co_uuid));
+		return rc;
+	}
+
+	pipeline_aggrs_sgl(&args->psa_aggrs, iovs_agg, &sgl_agg);
+	pipeline_aggregations_init(&in->pti_pipe, &sgl_agg);
+
+	rc = pipeline_compile(&in->pti_pipe, &compiled);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = alloc_iter_bufs(in->pti_iods.iods, in->pti_iods.nr, &iods_iter, &sgl_recx_iter);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	batch_cap = pipeline_batch_cap(ds_pipeline_batch_size, in->pti_iods.iods, in->pti_iods.nr);
+	if (batch_cap > 1) {
+		rc = pipeline_rows_init(&rows, &compiled, in->pti_iods.iods, in->pti_iods.nr,
+					batch_cap);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		batched = true;
+	}
+
+	run_args.nr_iods = in->pti_iods.nr;
+	run_args.iods    = iods_iter;
+	credits.max      = PIPELINE_ITERATION_MAX;
+
+	param.ip_hdl        = coc->sc_hdl;
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
+
+	while (!daos_anchor_is_eof(&anchors.ia_obj)) {
+		/** objects are collected first, the scan of each one yields */
+		batch->pob_nr = 0;
+		rc = vos_iterate(&param, VOS_ITER_OBJ, false, &anchors, obj_batch_cb, NULL, batch,
+				 NULL);
+		if (rc < 0)
+			D_GOTO(out, rc);
+
+		for (i = 0; i < batch->pob_nr; i++) {
+			oid = batch->pob_oids[i];
+			oca = daos_oclass_attr_find(oid.id_pub, NULL);
+			/** EC objects are not supported by pipelines */
+			if (oca == NULL || daos_oclass_is_ec(oca))
+				continue;
+
+			rc = pipeline_shard_is_leader(coc, oid, oca);
+			if (rc < 0)
+				D_GOTO(out, rc);
+			if (rc == 0)
+				continue;
+
+			args->psa_stats.nr_objs += 1;
+			rc = pipeline_scan_object(coc->sc_hdl, oid, in->pti_epr, &compiled,
+						  &run_args, iods_iter, sgl_recx_iter,
+						  in->pti_iods.nr, &sgl_agg, &credits,
+						  batched ? &rows : NULL, &args->psa_aggrs,
+						  &args->psa_stats);
+			if (rc != 0) {
+				DL_CDEBUG(rc == -DER_INPROGRESS, DB_IO, DLOG_ERR, rc,
+					  DF_UOID " pipeline scan failed", DP_UOID(oid));
+				D_GOTO(out, rc);
+			}
+		}
+	}
+	rc = 0;
+out:
+	if (batched)
+		pipeline_rows_fini(&rows);
+	D_FREE(batch);
+	pipeline_compile_free(&compiled);
+	free_iter_bufs(in->pti_iods.nr, iods_iter, sgl_recx_iter);
+	ds_cont_child_put(coc);
+	return rc;
+}
+
+static void
+pipeline_scan_reduce(void *a_args, void *s_args)
+{
+	struct pipeline_scan_args *aggregator = a_args;
+	struct pipeline_scan_args *stream     = s_args;
+
+	pipeline_aggregations_merge(&aggregator->psa_in->pti_pipe, aggregator->psa_aggrs.vals,
+				    stream->psa_aggrs.vals);
+	aggregator->psa_aggrs.nr_pass += stream->psa_aggrs.nr_pass;
+	aggregator->psa_stats.nr_objs += stream->psa_stats.nr_objs;
+	aggregator->psa_stats.nr_dkeys += stream->psa_stats.nr_dkeys;
+	aggregator->psa_stats.nr_akeys += stream->psa_stats.nr_akeys;
+}
+
+static int
+pipeline_scan_stream_alloc(struct dss_stream_arg_type *args, void *a_arg)
+{
+	D_ALLOC(args->st_arg, sizeof(struct pipeline_scan_args));
+	if (args->st_arg == NULL)
+		return -DER_NOMEM;
+	memcpy(args->st_arg, a_arg, sizeof(struct pipeline_scan_args));
+
+	return 0;
+}
+
+static void
+pipeline_scan_stream_free(struct dss_stream_arg_type *args)
+{
+	D_ASSERT(args->st_arg != NULL);
+	D_FREE(args->st_arg);
+}
+
+/** Collective handler, scan the container on all targets of this engine in parallel ULTs */
+void
+ds_pipeline_tgt_run_handler(crt_rpc_t *rpc)
+{
+	struct pipeline_tgt_run_in  *in        = crt_req_get(rpc);
+	struct pipeline_tgt_run_out *out       = crt_reply_get(rpc);
+	struct dss_coll_ops          coll_ops  = {0};
+	struct dss_coll_args         coll_args = {0};
+	struct pipeline_scan_args    scan_args = {0};
+	d_iov_t                      iovs_agg[PIPELINE_CONT_AGGR_MAX];
+	d_sg_list_t                  sgl_agg;
+	int                          rc;
+
+	if (in->pti_pipe.num_aggr_filters > PIPELINE_CONT_AGGR_MAX)
+		D_GOTO(out, rc = -DER_PROTO);
+
+	scan_args.psa_in        = in;
+	scan_args.psa_aggrs.nr  = in->pti_pipe.num_aggr_filters;
+	pipeline_aggrs_sgl(&scan_args.psa_aggrs, iovs_agg, &sgl_agg);
+	pipeline_aggregations_init(&in->pti_pipe, &sgl_agg);
+
+	coll_ops.co_func             = pipeline_scan_one;
+	coll_ops.co_reduce           = pipeline_scan_reduce;
+	coll_ops.co_reduce_arg_alloc = pipeline_scan_stream_alloc;
+	coll_ops.co_reduce_arg_free  = pipeline_scan_stream_free;
+
+	coll_args.ca_aggregator = &scan_args;
+	coll_args.ca_func_args  = &coll_args.ca_stream_args;
+
+	rc = ds_pool_thread_collective_reduce(in->pti_pool_uuid,
+					      PO_COMP_ST_NEW | PO_COMP_ST_DOWN |
+						  PO_COMP_ST_DOWNOUT,
+					      &coll_ops, &coll_args, 0);
+	if (rc != 0)
+		DL_ERROR(rc, DF_CONT ": pipeline scan failed",
+			 DP_CONT(in->pti_pool_uuid, in->pti_co_uuid));
+
+out:
+	out->pto_aggrs = scan_args.psa_aggrs;
+	out->pto_stats = scan_args.psa_stats;
+	out->pto_ret   = rc;
+	rc             = crt_reply_send(rpc);
+	if (rc != 0)
+		D_ERROR("send reply failed: " DF_RC "\n", DP_RC(rc));
+}
+
+int
+ds_pipeline_tgt_run_aggregator(crt_rpc_t *source, crt_rpc_t *result, void *priv)
+{
+	struct pipeline_tgt_run_in  *in         = crt_req_get(result);
+	struct pipeline_tgt_run_out *out_source = crt_reply_get(source);
+	struct pipeline_tgt_run_out *out_result = crt_reply_get(result);
+
+	if (out_source->pto_ret != 0) {
+		if (out_result->pto_ret == 0)
+			out_result->pto_ret = out_source->pto_ret;
+		return 0;
+	}
+
+	pipeline_aggregations_merge(&in->pti_pipe, out_result->pto_aggrs.vals,
+				    out_source->pto_aggrs.vals);
+	out_result->pto_aggrs.nr_pass += out_source->pto_aggrs.nr_pass;
+	out_result->pto_stats.nr_objs += out_source->pto_stats.nr_objs;
+	out_result->pto_stats.nr_dkeys += out_source->pto_stats.nr_dkeys;
+	out_result->pto_stats.nr_akeys += out_source->pto_stats.nr_akeys;
+	return 0;
+}
+
+/**
+ * Run a pipeline on a whole container: broadcast it to all engines of the pool, which scan their
+ * targets in parallel, the partial aggregates are merged up the collective tree.
+ */
+void
+ds_pipeline_cont_run_handler(crt_rpc_t *rpc)
+{
+	struct pipeline_cont_run_in  *pci     = crt_req_get(rpc);
+	struct pipeline_cont_run_out *pco     = crt_reply_get(rpc);
+	struct pipeline_tgt_run_in   *pti;
+	struct pipeline_tgt_run_out  *pto;
+	struct ds_cont_hdl           *coh     = NULL;
+	struct ds_pool               *pool    = NULL;
+	crt_rpc_t                    *tgt_rpc = NULL;
+	d_iov_t                       iovs_agg[PIPELINE_CONT_AGGR_MAX];
+	d_sg_list_t                   sgl_agg;
+	int                           rc;
+
+	rc = ds_cont_find_hdl(pci->pci_pool_uuid, pci->pci_co_hdl, &coh);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = d_pipeline_check(&pci->pci_pipe);
+	if (rc != 0)
+		D_GOTO(out, rc);
+	if (pci->pci_pipe.version != 1)
+		D_GOTO(out, rc = -DER_MISMATCH);
+	if (pci->pci_pipe.num_aggr_filters == 0 ||
+	    pci->pci_pipe.num_aggr_filters > PIPELINE_CONT_AGGR_MAX)
+		D_GOTO(out, rc = -DER_NOTSUPPORTED);
+
+	rc = ds_pool_lookup(pci->pci_pool_uuid, &pool);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = ds_pool_bcast_create(dss_get_module_info()->dmi_ctx, pool, DAOS_PIPELINE_MODULE,
+				  DAOS_PIPELINE_RPC_TGT_RUN, DAOS_PIPELINE_VERSION, &tgt_rpc, NULL,
+				  NULL, NULL);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	pti            = crt_req_get(tgt_rpc);
+	pti->pti_pipe  = pci->pci_pipe;
+	pti->pti_iods  = pci->pci_iods;
+	pti->pti_epr   = pci->pci_epr;
+	pti->pti_flags = pci->pci_flags;
+	uuid_copy(pti->pti_pool_uuid, pci->pci_pool_uuid);
+	uuid_copy(pti->pti_co_uuid, coh->sch_cont->sc_uuid);
+
+	rc = dss_rpc_send(tgt_rpc);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	pto = crt_reply_get(tgt_rpc);
+	rc  = pto->pto_ret;
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	pco->pco_aggrs = pto->pto_aggrs;
+	pco->pco_stats = pto->pto_stats;
+	if (pco->pco_aggrs.nr_pass > 0) {
+		pipeline_aggrs_sgl(&pco->pco_aggrs, iovs_agg, &sgl_agg);
+		pipeline_aggregations_fixavgs(&pci->pci_pipe, (double)pco->pco_aggrs.nr_pass,
+					      &sgl_agg);
+	}
+
+	D_DEBUG(DB_IO, DF_UUID ": container pipeline run, " DF_U64 " objs, " DF_U64 " dkeys\n",
+		DP_UUID(pti->pti_co_uuid), pco->pco_stats.nr_objs, pco->pco_stats.nr_dkeys);
+out:
+	if (tgt_rpc != NULL)
+		crt_req_decref(tgt_rpc);
+	if (pool != NULL)
+		ds_pool_put(pool);
+	if (coh != NULL)
+		ds_cont_hdl_put(coh);
+
+	pco->pco_ret = rc;
+	rc           = crt_reply_send(rpc);
+	if (rc != 0)
+		D_ERROR("send reply failed: " DF_RC "\n", DP_RC(rc));
+}
@@ -0,0 +1,313 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Records/sec of the pipeline filters, evaluated record by record and over batches of records
+ * of different sizes. The records are built in memory, the filter is:
+ *   (Age >= 30 AND Age < 60) OR (Score > 0.9 AND NOT Id == 7)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include <daos/common.h>
+#include <daos_pipeline.h>
+#include "pipeline_internal.h"
+
+#define NR_IODS	3
+
+static const char *akey_names[NR_IODS] = {"Age", "Score", "Id"};
+
+struct bench_records {
+	uint32_t      br_nr;
+	d_iov_t      *br_dkeys;
+	daos_iod_t  **br_iods;
+	d_sg_list_t **br_sgls;
+	uint64_t     *br_vals;
+};
+
+static daos_filter_part_t *
+part_new(const char *part_type, const char *data_type, const char *akey, uint32_t nops)
+{
+	daos_filter_part_t *part;
+
+	D_ALLOC_PTR(part);
+	D_ASSERT(part != NULL);
+	d_iov_set(&part->part_type, (char *)part_type, strlen(part_type));
+	if (data_type != NULL)
+		d_iov_set(&part->data_type, (char *)data_type, strlen(data_type));
+	if (akey != NULL) {
+		d_iov_set(&part->akey, (char *)akey, strlen(akey));
+		part->data_len = sizeof(uint64_t);
+	}
+	part->num_operands = nops;
+	return part;
+}
+
+static daos_filter_part_t *
+const_new(const char *data_type, void *val)
+{
+	daos_filter_part_t *part;
+
+	part = part_new("DAOS_FILTER_CONST", data_type, NULL, 0);
+	part->num_constants = 1;
+	D_ALLOC_PTR(part->constant);
+	D_ASSERT(part->constant != NULL);
+	d_iov_set(part->constant, val, sizeof(uint64_t));
+	return part;
+}
+
+static void
+build_pipeline(daos_pipeline_t *pipeline, daos_filter_t *filter)
+{
+	static uint64_t age_lo = 30;
+	static uint64_t age_hi = 60;
+	static double   score  = 0.9;
+	static uint64_t id     = 7;
+	const char     *u8     = "DAOS_FILTER_TYPE_UINTEGER8";
+	const char     *r8     = "DAOS_FILTER_TYPE_REAL8";
+	daos_filter_part_t *parts[] = {
+	    part_new("DAOS_FILTER_FUNC_OR", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_AND", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_GE", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Age", 0),
+	    const_new(u8, &age_lo),
+	    part_new("DAOS_FILTER_FUNC_LT", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Age", 0),
+	    const_new(u8, &age_hi),
+	    part_new("DAOS_FILTER_FUNC_AND", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_GT", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", r8, "Score", 0),
+	    const_new(r8, &score),
+	    part_new("DAOS_FILTER_FUNC_NOT", NULL, NULL, 1),
+	    part_new("DAOS_FILTER_FUNC_EQ", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Id", 0),
+	    const_new(u8, &id),
+	};
+	uint32_t i;
+	int      rc;
+
+	daos_pipeline_init(pipeline);
+	daos_filter_init(filter);
+	d_iov_set(&filter->filter_type, "DAOS_FILTER_CONDITION", strlen("DAOS_FILTER_CONDITION"));
+	for (i = 0; i < ARRAY_SIZE(parts); i++) {
+		rc = daos_filter_add(filter, parts[i]);
+		D_ASSERT(rc == 0);
+	}
+	rc = daos_pipeline_add(pipeline, filter);
+	D_ASSERT(rc == 0);
+}
+
+static int
+records_init(struct bench_records *recs, uint32_t nr)
+{
+	d_iov_t  *iovs;
+	double    score;
+	uint32_t  i;
+	uint32_t  j;
+
+	recs->br_nr = nr;
+	D_ALLOC_ARRAY(recs->br_dkeys, nr);
+	D_ALLOC_ARRAY(recs->br_iods, nr);
+	D_ALLOC_ARRAY(recs->br_sgls, nr);
+	D_ALLOC_ARRAY(recs->br_vals, (size_t)nr * NR_IODS);
+	if (recs->br_dkeys == NULL || recs->br_iods == NULL || recs->br_sgls == NULL ||
+	    recs->br_vals == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < nr; i++) {
+		D_ALLOC_ARRAY(recs->br_iods[i], NR_IODS);
+		D_ALLOC_ARRAY(recs->br_sgls[i], NR_IODS);
+		D_ALLOC_ARRAY(iovs, NR_IODS);
+		if (recs->br_iods[i] == NULL || recs->br_sgls[i] == NULL || iovs == NULL)
+			return -DER_NOMEM;
+
+		recs->br_vals[i * NR_IODS]     = rand() % 100;
+		score                          = (double)rand() / RAND_MAX;
+		memcpy(&recs->br_vals[i * NR_IODS + 1], &score, sizeof(score));
+		recs->br_vals[i * NR_IODS + 2] = rand() % 16;
+		d_iov_set(&recs->br_dkeys[i], &recs->br_vals[i * NR_IODS], sizeof(uint64_t));
+
+		for (j = 0; j < NR_IODS; j++) {
+			d_iov_set(&recs->br_iods[i][j].iod_name, (char *)akey_names[j],
+				  strlen(akey_names[j]));
+			recs->br_iods[i][j].iod_type = DAOS_IOD_SINGLE;
+			recs->br_iods[i][j].iod_size = sizeof(uint64_t);
+			recs->br_iods[i][j].iod_nr   = 1;
+			d_iov_set(&iovs[j], &recs->br_vals[i * NR_IODS + j], sizeof(uint64_t));
+			recs->br_sgls[i][j].sg_nr     = 1;
+			recs->br_sgls[i][j].sg_nr_out = 1;
+			recs->br_sgls[i][j].sg_iovs   = &iovs[j];
+		}
+	}
+	return 0;
+}
+
+/** Reference: the filters run record by record, as pipeline_filters() in srv_pipeline.c */
+static int
+run_records(struct pipeline_compiled_t *pipe, struct bench_records *recs, uint8_t *pass,
+	    uint32_t *nr_pass)
+{
+	struct filter_part_run_t args = {0};
+	uint32_t                 i;
+	uint32_t                 f;
+	int                      rc;
+
+	args.nr_iods = NR_IODS;
+	*nr_pass     = 0;
+	for (i = 0; i < recs->br_nr; i++) {
+		args.dkey  = &recs->br_dkeys[i];
+		args.akeys = recs->br_sgls[i];
+		args.iods  = recs->br_iods[i];
+		pass[i]    = 1;
+		for (f = 0; f < pipe->num_filters && pass[i]; f++) {
+			args.part_idx = 0;
+			args.parts    = pipe->filters[f].parts;
+			rc            = args.parts[0].filter_func(&args);
+			if (rc != 0)
+				return rc;
+			pass[i] = args.log_out;
+		}
+		*nr_pass += pass[i];
+	}
+	return 0;
+}
+
+static int
+run_batches(struct pipeline_compiled_t *pipe, struct pipeline_batch *batch,
+	    struct bench_records *recs, uint32_t batch_size, uint8_t *pass, uint32_t *nr_pass)
+{
+	struct filter_part_run_t args = {0};
+	uint32_t                 start;
+	uint32_t                 nr;
+	uint32_t                 nr_sel;
+	uint32_t                 i;
+	int                      rc;
+
+	args.nr_iods = NR_IODS;
+	*nr_pass     = 0;
+	memset(pass, 0, recs->br_nr);
+	for (start = 0; start < recs->br_nr; start += batch_size) {
+		nr = min(batch_size, recs->br_nr - start);
+		rc = pipeline_filters_batch(batch, pipe, &args, nr, &recs->br_dkeys[start],
+					    &recs->br_sgls[start], &recs->br_iods[start], &nr_sel);
+		if (rc != 0)
+			return rc;
+		for (i = 0; i < nr_sel; i++)
+			pass[start + batch->pb_sel[i]] = 1;
+		*nr_pass += nr_sel;
+	}
+	return 0;
+}
+
+static void
+usage(char *name)
+{
+	printf("Usage: %s [-n records] [-i iterations]\n", name);
+}
+
+int
+main(int argc, char *argv[])
+{
+	static const uint32_t      batch_sizes[] = {1, 4, 16, 64, 256, 1024};
+	struct pipeline_compiled_t pipe          = {0};
+	struct pipeline_batch      batch;
+	struct bench_records       recs          = {0};
+	daos_pipeline_t            pipeline;
+	daos_filter_t              filter;
+	struct timespec            start;
+	struct timespec            end;
+	uint8_t                   *ref           = NULL;
+	uint8_t                   *pass          = NULL;
+	uint32_t                   nr_records    = 1 << 20;
+	uint32_t                   iterations    = 10;
+	uint32_t                   nr_ref;
+	uint32_t                   nr_pass;
+	uint32_t                   i;
+	uint32_t                   b;
+	uint64_t                   nsec;
+	int                        opt;
+	int                        rc;
+
+	while ((opt = getopt(argc, argv, "n:i:h")) != -1) {
+		switch (opt) {
+		case 'n':
+			nr_records = atoi(optarg);
+			break;
+		case 'i':
+			iterations = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 1;
+		}
+	}
+	if (nr_records == 0 || iterations == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	rc = d_log_init();
+	if (rc != 0)
+		return rc;
+
+	build_pipeline(&pipeline, &filter);
+	rc = pipeline_compile(&pipeline, &pipe);
+	if (rc != 0) {
+		printf("pipeline compilation failed: " DF_RC "\n", DP_RC(rc));
+		goto out;
+	}
+	printf("filter evaluated over batches: %s\n", pipe.filters[0].batch ? "yes" : "no");
+
+	D_ALLOC(ref, nr_records);
+	D_ALLOC(pass, nr_records);
+	if (ref == NULL || pass == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	srand(0);
+	rc = records_init(&recs, nr_records);
+	if (rc != 0)
+		goto out;
+
+	d_gettime(&start);
+	for (i = 0; i < iterations && rc == 0; i++)
+		rc = run_records(&pipe, &recs, ref, &nr_ref);
+	d_gettime(&end);
+	if (rc != 0)
+		goto out;
+	nsec = d_timediff_ns(&start, &end);
+	printf("%-12s %12s %16s\n", "batch size", "passed", "records/sec");
+	printf("%-12s %12u %16.0f\n", "per-record", nr_ref,
+	       (double)nr_records * iterations * NSEC_PER_SEC / nsec);
+
+	for (b = 0; b < ARRAY_SIZE(batch_sizes); b++) {
+		rc = pipeline_batch_init(&batch, &pipe, batch_sizes[b]);
+		if (rc != 0)
+			goto out;
+
+		d_gettime(&start);
+		for (i = 0; i < iterations && rc == 0; i++)
+			rc = run_batches(&pipe, &batch, &recs, batch_sizes[b], pass, &nr_pass);
+		d_gettime(&end);
+		pipeline_batch_fini(&batch);
+		if (rc != 0)
+			goto out;
+
+		if (nr_pass != nr_ref || memcmp(pass, ref, nr_records) != 0) {
+			printf("batch size %u: %u records passed instead of %u\n", batch_sizes[b],
+			       nr_pass, nr_ref);
+			D_GOTO(out, rc = -DER_MISMATCH);
+		}
+		nsec = d_timediff_ns(&start, &end);
+		printf("%-12u %12u %16.0f\n", batch_sizes[b], nr_pass,
+		       (double)nr_records * iterations * NSEC_PER_SEC / nsec);
+	}
+out:
+	D_FREE(ref);
+	D_FREE(pass);
+	pipeline_compile_free(&pipe);
+	d_log_fini();
+	return rc == 0 ? 0 : 1;
+}
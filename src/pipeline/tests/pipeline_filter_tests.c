@@ -0,0 +1,403 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Unit tests of the evaluation of the pipeline filters over batches of records, see
+ * filter_batch.c. The records are built in memory, each filter is evaluated record by record and
+ * over batches of different sizes, and the records passing it must be the same.
+ */
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <daos/common.h>
+#include <daos/tests_lib.h>
+#include <daos_pipeline.h>
+#include "pipeline_internal.h"
+
+#define NR_IODS		3
+#define NR_RECORDS	1000
+
+static const char *akey_names[NR_IODS] = {"Age", "Score", "Id"};
+static const char *u8 = "DAOS_FILTER_TYPE_UINTEGER8";
+static const char *r8 = "DAOS_FILTER_TYPE_REAL8";
+
+static uint64_t age_lo = 30;
+static uint64_t age_hi = 60;
+static double   score  = 0.9;
+static uint64_t id     = 7;
+
+/** Records: the dkey and the first akey hold the age */
+struct test_records {
+	uint32_t      tr_nr;
+	d_iov_t      *tr_dkeys;
+	daos_iod_t  **tr_iods;
+	d_sg_list_t **tr_sgls;
+	d_iov_t     **tr_iovs;
+	uint64_t     *tr_vals;
+};
+
+static struct test_records test_recs;
+
+static daos_filter_part_t *
+part_new(const char *part_type, const char *data_type, const char *akey, uint32_t nops)
+{
+	daos_filter_part_t *part;
+
+	D_ALLOC_PTR(part);
+	assert_non_null(part);
+	d_iov_set(&part->part_type, (char *)part_type, strlen(part_type));
+	if (data_type != NULL)
+		d_iov_set(&part->data_type, (char *)data_type, strlen(data_type));
+	if (akey != NULL)
+		d_iov_set(&part->akey, (char *)akey, strlen(akey));
+	if (data_type != NULL && nops == 0)
+		part->data_len = sizeof(uint64_t);
+	part->num_operands = nops;
+	return part;
+}
+
+static daos_filter_part_t *
+const_new(const char *data_type, void *val)
+{
+	daos_filter_part_t *part;
+
+	part = part_new("DAOS_FILTER_CONST", data_type, NULL, 0);
+	part->num_constants = 1;
+	D_ALLOC_PTR(part->constant);
+	assert_non_null(part->constant);
+	d_iov_set(part->constant, val, sizeof(uint64_t));
+	return part;
+}
+
+static void
+filter_add(daos_pipeline_t *pipeline, daos_filter_part_t **parts, uint32_t nr)
+{
+	daos_filter_t *filter;
+	uint32_t       i;
+	int            rc;
+
+	D_ALLOC_PTR(filter);
+	assert_non_null(filter);
+	daos_filter_init(filter);
+	d_iov_set(&filter->filter_type, "DAOS_FILTER_CONDITION", strlen("DAOS_FILTER_CONDITION"));
+	for (i = 0; i < nr; i++) {
+		rc = daos_filter_add(filter, parts[i]);
+		assert_rc_equal(rc, 0);
+	}
+	rc = daos_pipeline_add(pipeline, filter);
+	assert_rc_equal(rc, 0);
+}
+
+static void
+pipeline_free(daos_pipeline_t *pipeline)
+{
+	daos_filter_t *filter;
+	uint32_t       i;
+	uint32_t       j;
+
+	for (i = 0; i < pipeline->num_filters; i++) {
+		filter = pipeline->filters[i];
+		for (j = 0; j < filter->num_parts; j++) {
+			D_FREE(filter->parts[j]->constant);
+			D_FREE(filter->parts[j]);
+		}
+		D_FREE(filter->parts);
+		D_FREE(filter);
+	}
+	D_FREE(pipeline->filters);
+}
+
+/** Reference: the filters run record by record, as pipeline_filters() in srv_pipeline.c */
+static void
+run_records(struct pipeline_compiled_t *pipe, uint8_t *pass, uint32_t *nr_pass)
+{
+	struct filter_part_run_t args = {0};
+	uint32_t                 i;
+	uint32_t                 f;
+	int                      rc;
+
+	args.nr_iods = NR_IODS;
+	*nr_pass     = 0;
+	for (i = 0; i < test_recs.tr_nr; i++) {
+		args.dkey  = &test_recs.tr_dkeys[i];
+		args.akeys = test_recs.tr_sgls[i];
+		args.iods  = test_recs.tr_iods[i];
+		pass[i]    = 1;
+		for (f = 0; f < pipe->num_filters && pass[i]; f++) {
+			args.part_idx = 0;
+			args.parts    = pipe->filters[f].parts;
+			rc            = args.parts[0].filter_func(&args);
+			assert_rc_equal(rc, 0);
+			pass[i] = args.log_out;
+		}
+		*nr_pass += pass[i];
+	}
+}
+
+static void
+run_batches(struct pipeline_compiled_t *pipe, uint32_t batch_size, uint8_t *pass,
+	    uint32_t *nr_pass)
+{
+	struct filter_part_run_t args = {0};
+	struct pipeline_batch    batch;
+	uint32_t                 start;
+	uint32_t                 nr;
+	uint32_t                 nr_sel;
+	uint32_t                 i;
+	int                      rc;
+
+	rc = pipeline_batch_init(&batch, pipe, batch_size);
+	assert_rc_equal(rc, 0);
+
+	args.nr_iods = NR_IODS;
+	*nr_pass     = 0;
+	memset(pass, 0, test_recs.tr_nr);
+	for (start = 0; start < test_recs.tr_nr; start += batch_size) {
+		nr = min(batch_size, test_recs.tr_nr - start);
+		rc = pipeline_filters_batch(&batch, pipe, &args, nr, &test_recs.tr_dkeys[start],
+					    &test_recs.tr_sgls[start], &test_recs.tr_iods[start],
+					    &nr_sel);
+		assert_rc_equal(rc, 0);
+		assert_true(nr_sel <= nr);
+		for (i = 0; i < nr_sel; i++) {
+			/** in order, each record once */
+			if (i > 0)
+				assert_true(batch.pb_sel[i] > batch.pb_sel[i - 1]);
+			pass[start + batch.pb_sel[i]] = 1;
+		}
+		*nr_pass += nr_sel;
+	}
+	pipeline_batch_fini(&batch);
+}
+
+/**
+ * Check that the filters of \a pipeline select the same records whether they are evaluated one
+ * by one or over batches. \a batched tells whether the first filter has a batch evaluation.
+ */
+static void
+filters_check(daos_pipeline_t *pipeline, bool batched)
+{
+	static const uint32_t      batch_sizes[] = {2, 3, 16, 64, 333, NR_RECORDS, 1024};
+	struct pipeline_compiled_t pipe          = {0};
+	uint8_t                    ref[NR_RECORDS];
+	uint8_t                    pass[NR_RECORDS];
+	uint32_t                   nr_ref;
+	uint32_t                   nr_pass;
+	uint32_t                   b;
+	int                        rc;
+
+	rc = pipeline_compile(pipeline, &pipe);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(pipe.filters[0].batch, batched);
+
+	run_records(&pipe, ref, &nr_ref);
+	/** the records are chosen so that the filters select some, not all */
+	assert_true(nr_ref > 0 && nr_ref < NR_RECORDS);
+
+	for (b = 0; b < ARRAY_SIZE(batch_sizes); b++) {
+		run_batches(&pipe, batch_sizes[b], pass, &nr_pass);
+		print_message("batch size %u: %u of %u records passed\n", batch_sizes[b], nr_pass,
+			      NR_RECORDS);
+		assert_int_equal(nr_pass, nr_ref);
+		assert_memory_equal(pass, ref, NR_RECORDS);
+	}
+
+	pipeline_compile_free(&pipe);
+	pipeline_free(pipeline);
+}
+
+static void
+test_batch_logical(void **state)
+{
+	daos_pipeline_t     pipeline;
+	/** (Age >= 30 AND Age < 60) OR (Score > 0.9 AND NOT Id == 7) */
+	daos_filter_part_t *parts[] = {
+	    part_new("DAOS_FILTER_FUNC_OR", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_AND", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_GE", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Age", 0),
+	    const_new(u8, &age_lo),
+	    part_new("DAOS_FILTER_FUNC_LT", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Age", 0),
+	    const_new(u8, &age_hi),
+	    part_new("DAOS_FILTER_FUNC_AND", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_GT", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", r8, "Score", 0),
+	    const_new(r8, &score),
+	    part_new("DAOS_FILTER_FUNC_NOT", NULL, NULL, 1),
+	    part_new("DAOS_FILTER_FUNC_EQ", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Id", 0),
+	    const_new(u8, &id),
+	};
+
+	daos_pipeline_init(&pipeline);
+	filter_add(&pipeline, parts, ARRAY_SIZE(parts));
+	filters_check(&pipeline, true);
+}
+
+static void
+test_batch_dkey_mirror(void **state)
+{
+	daos_pipeline_t     pipeline;
+	/** 30 <= dkey AND 7 != Id, with the constants on the left */
+	daos_filter_part_t *parts[] = {
+	    part_new("DAOS_FILTER_FUNC_AND", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_LE", NULL, NULL, 2),
+	    const_new(u8, &age_lo),
+	    part_new("DAOS_FILTER_DKEY", u8, NULL, 0),
+	    part_new("DAOS_FILTER_FUNC_NE", NULL, NULL, 2),
+	    const_new(u8, &id),
+	    part_new("DAOS_FILTER_AKEY", u8, "Id", 0),
+	};
+
+	daos_pipeline_init(&pipeline);
+	filter_add(&pipeline, parts, ARRAY_SIZE(parts));
+	filters_check(&pipeline, true);
+}
+
+static void
+test_batch_fallback(void **state)
+{
+	daos_pipeline_t     pipeline;
+	/** Age + Id > 60: arithmetic operands are evaluated record by record */
+	daos_filter_part_t *parts[] = {
+	    part_new("DAOS_FILTER_FUNC_GT", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_FUNC_ADD", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", u8, "Age", 0),
+	    part_new("DAOS_FILTER_AKEY", u8, "Id", 0),
+	    const_new(u8, &age_hi),
+	};
+	/** Score > 0.9, evaluated over the records selected by the first filter */
+	daos_filter_part_t *parts2[] = {
+	    part_new("DAOS_FILTER_FUNC_GT", NULL, NULL, 2),
+	    part_new("DAOS_FILTER_AKEY", r8, "Score", 0),
+	    const_new(r8, &score),
+	};
+
+	daos_pipeline_init(&pipeline);
+	filter_add(&pipeline, parts, ARRAY_SIZE(parts));
+	filter_add(&pipeline, parts2, ARRAY_SIZE(parts2));
+	filters_check(&pipeline, false);
+}
+
+static void
+test_batch_cap(void **state)
+{
+	daos_iod_t   iods[NR_IODS];
+	daos_recx_t  recx = {.rx_idx = 0, .rx_nr = 1 << 12};
+	uint32_t     cap;
+
+	memcpy(iods, test_recs.tr_iods[0], sizeof(iods));
+
+	/** batches are off */
+	assert_int_equal(pipeline_batch_cap(0, iods, NR_IODS), 0);
+	assert_int_equal(pipeline_batch_cap(1, iods, NR_IODS), 1);
+
+	/** small records, the batch size is kept */
+	assert_int_equal(pipeline_batch_cap(64, iods, NR_IODS), 64);
+
+	/** 32KiB records, the buffers of a batch are bounded */
+	iods[1].iod_type  = DAOS_IOD_ARRAY;
+	iods[1].iod_nr    = 1;
+	iods[1].iod_recxs = &recx;
+	cap = pipeline_batch_cap(PIPELINE_BATCH_SIZE_MAX, iods, NR_IODS);
+	assert_true(cap > 1 && cap < PIPELINE_BATCH_BUF_MAX / (recx.rx_nr * sizeof(uint64_t)));
+
+	/** records larger than the bound are evaluated one by one */
+	recx.rx_nr = PIPELINE_BATCH_BUF_MAX;
+	assert_true(pipeline_batch_cap(PIPELINE_BATCH_SIZE_MAX, iods, NR_IODS) <= 1);
+}
+
+static int
+setup(void **state)
+{
+	double   val;
+	uint32_t i;
+	uint32_t j;
+	int      rc;
+
+	rc = d_log_init();
+	if (rc != 0)
+		return rc;
+
+	srand(0);
+	test_recs.tr_nr = NR_RECORDS;
+	D_ALLOC_ARRAY(test_recs.tr_dkeys, NR_RECORDS);
+	D_ALLOC_ARRAY(test_recs.tr_iods, NR_RECORDS);
+	D_ALLOC_ARRAY(test_recs.tr_sgls, NR_RECORDS);
+	D_ALLOC_ARRAY(test_recs.tr_iovs, NR_RECORDS);
+	D_ALLOC_ARRAY(test_recs.tr_vals, NR_RECORDS * NR_IODS);
+	if (test_recs.tr_dkeys == NULL || test_recs.tr_iods == NULL ||
+	    test_recs.tr_sgls == NULL || test_recs.tr_iovs == NULL || test_recs.tr_vals == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < NR_RECORDS; i++) {
+		D_ALLOC_ARRAY(test_recs.tr_iods[i], NR_IODS);
+		D_ALLOC_ARRAY(test_recs.tr_sgls[i], NR_IODS);
+		D_ALLOC_ARRAY(test_recs.tr_iovs[i], NR_IODS);
+		if (test_recs.tr_iods[i] == NULL || test_recs.tr_sgls[i] == NULL ||
+		    test_recs.tr_iovs[i] == NULL)
+			return -DER_NOMEM;
+
+		test_recs.tr_vals[i * NR_IODS] = rand() % 100;
+		val                             = (double)rand() / RAND_MAX;
+		memcpy(&test_recs.tr_vals[i * NR_IODS + 1], &val, sizeof(val));
+		test_recs.tr_vals[i * NR_IODS + 2] = rand() % 16;
+		d_iov_set(&test_recs.tr_dkeys[i], &test_recs.tr_vals[i * NR_IODS],
+			  sizeof(uint64_t));
+
+		for (j = 0; j < NR_IODS; j++) {
+			d_iov_set(&test_recs.tr_iods[i][j].iod_name, (char *)akey_names[j],
+				  strlen(akey_names[j]));
+			test_recs.tr_iods[i][j].iod_type = DAOS_IOD_SINGLE;
+			test_recs.tr_iods[i][j].iod_size = sizeof(uint64_t);
+			test_recs.tr_iods[i][j].iod_nr   = 1;
+			d_iov_set(&test_recs.tr_iovs[i][j], &test_recs.tr_vals[i * NR_IODS + j],
+				  sizeof(uint64_t));
+			test_recs.tr_sgls[i][j].sg_nr     = 1;
+			test_recs.tr_sgls[i][j].sg_nr_out = 1;
+			test_recs.tr_sgls[i][j].sg_iovs   = &test_recs.tr_iovs[i][j];
+		}
+	}
+	return 0;
+}
+
+static int
+teardown(void **state)
+{
+	uint32_t i;
+
+	for (i = 0; i < NR_RECORDS; i++) {
+		if (test_recs.tr_iods != NULL)
+			D_FREE(test_recs.tr_iods[i]);
+		if (test_recs.tr_sgls != NULL)
+			D_FREE(test_recs.tr_sgls[i]);
+		if (test_recs.tr_iovs != NULL)
+			D_FREE(test_recs.tr_iovs[i]);
+	}
+	D_FREE(test_recs.tr_dkeys);
+	D_FREE(test_recs.tr_iods);
+	D_FREE(test_recs.tr_sgls);
+	D_FREE(test_recs.tr_iovs);
+	D_FREE(test_recs.tr_vals);
+	d_log_fini();
+
+	return 0;
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test(test_batch_logical),
+	    cmocka_unit_test(test_batch_dkey_mirror),
+	    cmocka_unit_test(test_batch_fallback),
+	    cmocka_unit_test(test_batch_cap),
+	};
+
+	return cmocka_run_group_tests_name("pipeline_filter", tests, setup, teardown);
+}
@@ -14,6 +14,7 @@
 
 #include "pl_map.h"
 #include <gurt/hash.h>
+#include <daos/lru.h>
 
 extern struct pl_map_ops        ring_map_ops;
 extern struct pl_map_ops        jump_map_ops;
@@ -48,6 +49,272 @@ static struct pl_map_dict pl_maps[] = {
 };
 
 
+/**
+ * Object layout cache.
+ *
+ * Computing a layout is expensive (jump consistent hashing for every shard, plus
+ * remapping of the failed shards), while clients open the same objects again and
+ * again, and the same objects are placed repeatedly on the server. Computed layouts
+ * are cached by each placement map in a few LRU sub-caches, each protected by its
+ * own mutex so that concurrent placers rarely contend.
+ *
+ * A placement map is created for each pool map version, and pl_map_update() evicts
+ * the cache of the replaced map, so the cache never outlives its pool map version.
+ * The pool map version is part of the key anyway, in case the pool map is updated
+ * in place. Callers always get a private copy of the layout.
+ */
+#define PL_LCACHE_SHARDS	8
+/* Default total number of cached layouts per placement map */
+#define PL_LCACHE_SIZE_DEF	(32 << 10)
+/* Don't cache layouts of widely striped objects, they are few and large */
+#define PL_LCACHE_SHARD_MAX	256
+
+static unsigned int pl_lcache_size = PL_LCACHE_SIZE_DEF;
+
+struct pl_layout_key {
+	daos_obj_id_t	plk_oid;
+	uint32_t	plk_md_ver;
+	uint32_t	plk_fdom_lvl;
+	uint32_t	plk_pda;
+	uint32_t	plk_pdom_lvl;
+	uint32_t	plk_flags;
+	uint32_t	plk_grp_spec;
+	uint32_t	plk_layout_ver;
+	uint32_t	plk_map_ver;
+	/* DAOS_OO_RO generates the layout before rebuild */
+	uint32_t	plk_ro;
+	uint32_t	plk_padding;
+};
+
+struct pl_layout_entry {
+	struct daos_llink	 ple_llink;
+	struct pl_layout_key	 ple_key;
+	struct pl_obj_layout	*ple_layout;
+};
+
+struct pl_layout_cache {
+	struct {
+		pthread_mutex_t		 lcs_lock;
+		struct daos_lru_cache	*lcs_lru;
+	} plc_shards[PL_LCACHE_SHARDS];
+};
+
+struct pl_layout_alloc_arg {
+	struct pl_obj_layout	*pla_layout;
+	bool			 pla_consumed;
+};
+
+static inline struct pl_layout_entry *
+pl_llink2entry(struct daos_llink *llink)
+{
+	return container_of(llink, struct pl_layout_entry, ple_llink);
+}
+
+static int
+pl_lop_alloc(void *key, unsigned int ksize, void *args, struct daos_llink **llink_p)
+{
+	struct pl_layout_alloc_arg	*arg = args;
+	struct pl_layout_entry		*ent;
+
+	D_ASSERT(ksize == sizeof(struct pl_layout_key));
+	D_ALLOC_PTR(ent);
+	if (ent == NULL)
+		return -DER_NOMEM;
+
+	ent->ple_key    = *(struct pl_layout_key *)key;
+	ent->ple_layout = arg->pla_layout;
+	arg->pla_consumed = true;
+	*llink_p = &ent->ple_llink;
+	return 0;
+}
+
+static void
+pl_lop_free(struct daos_llink *llink)
+{
+	struct pl_layout_entry *ent = pl_llink2entry(llink);
+
+	pl_obj_layout_free(ent->ple_layout);
+	D_FREE(ent);
+}
+
+static bool
+pl_lop_cmp_keys(const void *key, unsigned int ksize, struct daos_llink *llink)
+{
+	D_ASSERT(ksize == sizeof(struct pl_layout_key));
+	return memcmp(key, &pl_llink2entry(llink)->ple_key, ksize) == 0;
+}
+
+static uint32_t
+pl_lop_rec_hash(struct daos_llink *llink)
+{
+	return d_hash_string_u32((const char *)&pl_llink2entry(llink)->ple_key,
+				 sizeof(struct pl_layout_key));
+}
+
+static struct daos_llink_ops pl_lcache_ops = {
+	.lop_free_ref	= pl_lop_free,
+	.lop_alloc_ref	= pl_lop_alloc,
+	.lop_cmp_keys	= pl_lop_cmp_keys,
+	.lop_rec_hash	= pl_lop_rec_hash,
+};
+
+/** Set size of the layout cache for placement maps created afterwards, 0 disables it. */
+void
+pl_layout_cache_size_set(unsigned int size)
+{
+	pl_lcache_size = size;
+}
+
+static void
+pl_layout_cache_destroy(struct pl_layout_cache *cache)
+{
+	int i;
+
+	for (i = 0; i < PL_LCACHE_SHARDS; i++) {
+		if (cache->plc_shards[i].lcs_lru == NULL)
+			break;
+		daos_lru_cache_destroy(cache->plc_shards[i].lcs_lru);
+		D_MUTEX_DESTROY(&cache->plc_shards[i].lcs_lock);
+	}
+	D_FREE(cache);
+}
+
+static int
+pl_layout_cache_create(struct pl_layout_cache **cache_p)
+{
+	struct pl_layout_cache	*cache;
+	unsigned int		 per_shard;
+	int			 bits;
+	int			 i;
+	int			 rc;
+
+	D_ALLOC_PTR(cache);
+	if (cache == NULL)
+		return -DER_NOMEM;
+
+	per_shard = max(pl_lcache_size / PL_LCACHE_SHARDS, 1U);
+	bits      = 31 - __builtin_clz(per_shard);
+	for (i = 0; i < PL_LCACHE_SHARDS; i++) {
+		rc = D_MUTEX_INIT(&cache->plc_shards[i].lcs_lock, NULL);
+		if (rc != 0)
+			goto failed;
+
+		rc = daos_lru_cache_create(bits, D_HASH_FT_NOLOCK, &pl_lcache_ops,
+					   &cache->plc_shards[i].lcs_lru);
+		if (rc != 0) {
+			D_MUTEX_DESTROY(&cache->plc_shards[i].lcs_lock);
+			goto failed;
+		}
+	}
+
+	*cache_p = cache;
+	return 0;
+failed:
+	pl_layout_cache_destroy(cache);
+	return rc;
+}
+
+static void
+pl_layout_cache_evict(struct pl_layout_cache *cache)
+{
+	int i;
+
+	for (i = 0; i < PL_LCACHE_SHARDS; i++) {
+		D_MUTEX_LOCK(&cache->plc_shards[i].lcs_lock);
+		daos_lru_cache_evict(cache->plc_shards[i].lcs_lru, NULL, NULL);
+		D_MUTEX_UNLOCK(&cache->plc_shards[i].lcs_lock);
+	}
+}
+
+static int
+pl_obj_layout_dup(struct pl_obj_layout *src, struct pl_obj_layout **dst_p)
+{
+	struct pl_obj_layout	*dst;
+	int			 rc;
+
+	rc = pl_obj_layout_alloc(src->ol_grp_size, src->ol_grp_nr, &dst);
+	if (rc != 0)
+		return rc;
+
+	D_ASSERT(dst->ol_nr == src->ol_nr);
+	dst->ol_ver         = src->ol_ver;
+	dst->ol_shard_peers = src->ol_shard_peers;
+	memcpy(dst->ol_shards, src->ol_shards, sizeof(*src->ol_shards) * src->ol_nr);
+	*dst_p = dst;
+	return 0;
+}
+
+static void
+pl_layout_key_init(struct pl_map *map, uint32_t layout_gl_version, struct daos_obj_md *md,
+		   unsigned int mode, struct pl_layout_key *key)
+{
+	memset(key, 0, sizeof(*key));
+	key->plk_oid        = md->omd_id;
+	key->plk_md_ver     = md->omd_ver;
+	key->plk_fdom_lvl   = md->omd_fdom_lvl;
+	key->plk_pda        = md->omd_pda;
+	key->plk_pdom_lvl   = md->omd_pdom_lvl;
+	key->plk_flags      = md->omd_flags;
+	key->plk_grp_spec   = md->omd_grp_spec;
+	key->plk_layout_ver = layout_gl_version;
+	key->plk_map_ver    = pl_map_version(map);
+	key->plk_ro         = !!(mode & DAOS_OO_RO);
+}
+
+static inline unsigned int
+pl_layout_key2shard(struct pl_layout_key *key)
+{
+	return d_hash_string_u32((const char *)key, sizeof(*key)) % PL_LCACHE_SHARDS;
+}
+
+static int
+pl_layout_cache_lookup(struct pl_layout_cache *cache, struct pl_layout_key *key,
+		       struct pl_obj_layout **layout_pp)
+{
+	unsigned int		 idx = pl_layout_key2shard(key);
+	struct daos_lru_cache	*lru = cache->plc_shards[idx].lcs_lru;
+	struct daos_llink	*llink;
+	int			 rc;
+
+	D_MUTEX_LOCK(&cache->plc_shards[idx].lcs_lock);
+	rc = daos_lru_ref_hold(lru, key, sizeof(*key), NULL, &llink);
+	if (rc == 0) {
+		rc = pl_obj_layout_dup(pl_llink2entry(llink)->ple_layout, layout_pp);
+		daos_lru_ref_release(lru, llink);
+	}
+	D_MUTEX_UNLOCK(&cache->plc_shards[idx].lcs_lock);
+
+	return rc;
+}
+
+static void
+pl_layout_cache_insert(struct pl_layout_cache *cache, struct pl_layout_key *key,
+		       struct pl_obj_layout *layout)
+{
+	struct pl_layout_alloc_arg	 arg = {0};
+	unsigned int			 idx = pl_layout_key2shard(key);
+	struct daos_lru_cache		*lru = cache->plc_shards[idx].lcs_lru;
+	struct daos_llink		*llink;
+	int				 rc;
+
+	if (layout->ol_nr > PL_LCACHE_SHARD_MAX)
+		return;
+
+	rc = pl_obj_layout_dup(layout, &arg.pla_layout);
+	if (rc != 0)
+		return;
+
+	D_MUTEX_LOCK(&cache->plc_shards[idx].lcs_lock);
+	rc = daos_lru_ref_hold(lru, key, sizeof(*key), &arg, &llink);
+	if (rc == 0)
+		daos_lru_ref_release(lru, llink);
+	D_MUTEX_UNLOCK(&cache->plc_shards[idx].lcs_lock);
+
+	/* Failed, or someone else has cached the same layout */
+	if (!arg.pla_consumed)
+		pl_obj_layout_free(arg.pla_layout);
+}
+
 static int
 pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 		     struct pl_map **pl_mapp)
@@ -83,8 +350,16 @@ pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 	map->pl_connects = 0;
 	map->pl_type = mia->ia_type;
 	map->pl_ops  = dict->pd_ops;
+	map->pl_lcache = NULL;
 	D_INIT_LIST_HEAD(&map->pl_link);
 
+	if (pl_lcache_size != 0) {
+		/* Placement works fine without the cache */
+		rc = pl_layout_cache_create(&map->pl_lcache);
+		if (rc != 0)
+			D_WARN("Failed to create layout cache: "DF_RC"\n", DP_RC(rc));
+	}
+
 	*pl_mapp = map;
 	return 0;
 }
@@ -99,6 +374,8 @@ pl_map_destroy(struct pl_map *map)
 	D_ASSERT(map->pl_ops != NULL);
 	D_ASSERT(map->pl_ops->o_destroy != NULL);
 
+	if (map->pl_lcache != NULL)
+		pl_layout_cache_destroy(map->pl_lcache);
 	D_SPIN_DESTROY(&map->pl_lock);
 	map->pl_ops->o_destroy(map);
 }
@@ -122,10 +399,28 @@ pl_obj_place(struct pl_map *map, uint16_t layout_gl_version, struct daos_obj_md
 	     unsigned int mode, struct daos_obj_shard_md *shard_md,
 	     struct pl_obj_layout **layout_pp)
 {
+	struct pl_layout_key	key;
+	int			rc;
+
 	D_ASSERT(map->pl_ops != NULL);
 	D_ASSERT(map->pl_ops->o_obj_place != NULL);
 	D_ASSERT(layout_gl_version < MAX_OBJ_LAYOUT_VERSION);
-	return map->pl_ops->o_obj_place(map, layout_gl_version, md, mode, shard_md, layout_pp);
+
+	/* Layout of a single redundancy group isn't cached */
+	if (map->pl_lcache == NULL || shard_md != NULL)
+		return map->pl_ops->o_obj_place(map, layout_gl_version, md, mode, shard_md,
+						layout_pp);
+
+	pl_layout_key_init(map, layout_gl_version, md, mode, &key);
+	rc = pl_layout_cache_lookup(map->pl_lcache, &key, layout_pp);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
+	rc = map->pl_ops->o_obj_place(map, layout_gl_version, md, mode, NULL, layout_pp);
+	if (rc == 0)
+		pl_layout_cache_insert(map->pl_lcache, &key, *layout_pp);
+
+	return rc;
 }
 
 /**
@@ -445,6 +740,10 @@ pl_map_update(uuid_t uuid, struct pool_map *pool_map, bool connect,
 		/* transfer the pool connection count */
 		map->pl_connects = tmp->pl_connects;
 
+		/* cached layouts of the stale map are useless, release them now */
+		if (tmp->pl_lcache != NULL)
+			pl_layout_cache_evict(tmp->pl_lcache);
+
 		/* evict the old placement map for this pool */
 		d_hash_rec_delete_at(&pl_htable, link);
 		d_hash_rec_decref(&pl_htable, link);
@@ -564,6 +863,9 @@ pl_map_query(uuid_t po_uuid, struct pl_map_attr *attr)
 /** Initialize the placement module. */
 int pl_init(void)
 {
+	pl_lcache_size = PL_LCACHE_SIZE_DEF;
+	d_getenv_uint("DAOS_PL_LAYOUT_CACHE", &pl_lcache_size);
+
 	return d_hash_table_create_inplace(D_HASH_FT_NOLOCK, PL_HTABLE_BITS,
 					   NULL, &pl_hash_ops, &pl_htable);
 }
@@ -2305,6 +2305,112 @@ fail_multiple_ranks(void **state)
 	jtc_fini(&ctx);
 }
 
+static bool
+layout_same(struct pl_obj_layout *lo_1, struct pl_obj_layout *lo_2)
+{
+	struct pl_obj_shard	*s_1;
+	struct pl_obj_shard	*s_2;
+	int			 i;
+
+	if (lo_1->ol_ver != lo_2->ol_ver || lo_1->ol_grp_size != lo_2->ol_grp_size ||
+	    lo_1->ol_grp_nr != lo_2->ol_grp_nr || lo_1->ol_nr != lo_2->ol_nr ||
+	    lo_1->ol_shard_peers != lo_2->ol_shard_peers)
+		return false;
+
+	for (i = 0; i < lo_1->ol_nr; i++) {
+		s_1 = &lo_1->ol_shards[i];
+		s_2 = &lo_2->ol_shards[i];
+		if (s_1->po_shard != s_2->po_shard || s_1->po_target != s_2->po_target ||
+		    s_1->po_fseq != s_2->po_fseq || s_1->po_rank != s_2->po_rank ||
+		    s_1->po_index != s_2->po_index || s_1->po_rebuilding != s_2->po_rebuilding ||
+		    s_1->po_reintegrating != s_2->po_reintegrating)
+			return false;
+	}
+
+	return true;
+}
+
+/* Place objects with and without the layout cache, for every field of the object metadata */
+static void
+layout_cache_check(struct pl_map *pl_map, struct pl_map *pl_map_nc)
+{
+	daos_oclass_id_t	 ocs[] = {OC_S1, OC_RP_3G2, OC_EC_4P2G1};
+	unsigned int		 modes[] = {DAOS_OO_RW, DAOS_OO_RO};
+	struct pl_obj_layout	*cached;
+	struct pl_obj_layout	*layout;
+	struct daos_obj_md	 md;
+	uint32_t		 layout_ver;
+	int			 i;
+	int			 j;
+	int			 k;
+	int			 n;
+
+	for (i = 0; i < ARRAY_SIZE(ocs); i++) {
+		for (n = 0; n < 32; n++) {
+			memset(&md, 0, sizeof(md));
+			gen_oid(&md.omd_id, n, UINT64_MAX, ocs[i]);
+			md.omd_ver = pool_map_get_version(pl_map->pl_poolmap);
+
+			for (layout_ver = 0; layout_ver <= PLT_LAYOUT_VERSION; layout_ver++) {
+				for (j = 0; j < ARRAY_SIZE(modes); j++) {
+					for (k = 0; k < 3; k++) {
+						md.omd_pda      = k == 1 ? 1 : 0;
+						md.omd_fdom_lvl = k == 2 ? PO_COMP_TP_RANK : 0;
+						md.omd_pdom_lvl = k == 2 ? PO_COMP_TP_ROOT : 0;
+
+						/* miss then hit */
+						assert_success(pl_obj_place(pl_map, layout_ver, &md,
+									    modes[j], NULL, &cached));
+						pl_obj_layout_free(cached);
+						assert_success(pl_obj_place(pl_map, layout_ver, &md,
+									    modes[j], NULL, &cached));
+						assert_success(pl_obj_place(pl_map_nc, layout_ver, &md,
+									    modes[j], NULL, &layout));
+						assert_true(layout_same(cached, layout));
+						pl_obj_layout_free(cached);
+						pl_obj_layout_free(layout);
+					}
+				}
+			}
+		}
+	}
+}
+
+static void
+layout_cache_matches_uncached(void **state)
+{
+	struct pool_map		*po_map;
+	struct pl_map		*pl_map;
+	struct pl_map		*pl_map_nc;
+	struct pl_map_init_attr	 mia;
+
+	gen_maps(1, 8, 1, 4, &po_map, &pl_map);
+
+	/* Same as DAOS_PL_LAYOUT_CACHE=0, reset by pl_init() */
+	pl_layout_cache_size_set(0);
+	mia.ia_type         = PL_TYPE_JUMP_MAP;
+	mia.ia_ring.domain  = fail_domain_node ? PO_COMP_TP_NODE : PO_COMP_TP_RANK;
+	assert_success(pl_map_create(po_map, &mia, &pl_map_nc));
+
+	/* The pool map is updated in place, every step is a new map version */
+	layout_cache_check(pl_map, pl_map_nc);
+	plt_fail_tgt(1, NULL, po_map, false);
+	layout_cache_check(pl_map, pl_map_nc);
+	plt_fail_tgt_out(1, NULL, po_map, false);
+	layout_cache_check(pl_map, pl_map_nc);
+	plt_fail_tgt(9, NULL, po_map, false);
+	layout_cache_check(pl_map, pl_map_nc);
+	plt_reint_tgt(1, NULL, po_map, false);
+	layout_cache_check(pl_map, pl_map_nc);
+	plt_drain_tgt(17, NULL, po_map, false);
+	layout_cache_check(pl_map, pl_map_nc);
+	plt_reint_tgt_up(1, NULL, po_map, false);
+	layout_cache_check(pl_map, pl_map_nc);
+
+	pl_map_decref(pl_map_nc);
+	free_pool_and_placement_map(po_map, pl_map);
+}
+
 /*
  * ------------------------------------------------
  * End Test Cases
@@ -2600,6 +2706,7 @@ static const struct CMUnitTest tests[] = {
     T("fail reintegrate ranks", fail_reintegrate_multiple_ranks),
     T("fail multiple ranks", fail_multiple_ranks),
     T("Basic DOWN2UP test", basic_down2up_test),
+    T("Layout cache returns the computed layouts", layout_cache_matches_uncached),
 };
 
 int
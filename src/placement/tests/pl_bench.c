@@ -35,6 +35,8 @@ extern void obj_class_fini(void);
 #define DEFAULT_ADDITION_NUM_TO_ADD 32
 #define DEFAULT_ADDITION_TEST_ENTRIES 100000
 
+#define DEFAULT_CACHE_WORKING_SET 4096
+
 static void
 print_usage(const char *prog_name, const char *const ops[], uint32_t num_ops)
 {
@@ -265,6 +267,138 @@ benchmark_placement(int argc, char **argv, uint32_t num_domains,
 	D_FREE(layout_table);
 }
 
+static void
+benchmark_layout_cache_usage()
+{
+	D_PRINT("Layout cache benchmark usage: -- [optional arguments]\n"
+		"\n"
+		"Optional Arguments\n"
+		"  --working-set <num>\n"
+		"      Short version: -w\n"
+		"      Number of distinct objects placed over and over again\n"
+		"\n"
+		"      Default: %u\n"
+		"\n"
+		"  --obj-class <class>\n"
+		"      Short version: -c\n"
+		"      Object class name, e.g. RP_3G1, EC_4P2G1\n"
+		"\n"
+		"      Default: RP_3G1\n",
+		DEFAULT_CACHE_WORKING_SET);
+}
+
+/* Place @working_set objects BENCHMARK_COUNT times in total, return placements per second */
+static long long
+layout_cache_run(uint32_t num_domains, uint32_t nodes_per_domain, uint32_t vos_per_target,
+		 struct daos_obj_md *obj_table, uint32_t working_set, unsigned int cache_size)
+{
+	struct benchmark_handle	*bench_hdl;
+	struct pool_map		*pool_map;
+	struct pl_map		*pl_map;
+	struct pl_obj_layout	*layout;
+	long long		 ops;
+	int			 i;
+	int			 rc;
+
+	/* Cache size only applies to placement maps created afterwards */
+	pl_layout_cache_size_set(cache_size);
+	gen_pool_and_placement_map(1, num_domains, nodes_per_domain, vos_per_target,
+				   PL_TYPE_JUMP_MAP, PO_COMP_TP_RANK, &pool_map, &pl_map);
+	D_ASSERT(pool_map != NULL);
+	D_ASSERT(pl_map != NULL);
+
+	bench_hdl = benchmark_alloc();
+	D_ASSERT(bench_hdl != NULL);
+
+	benchmark_start(bench_hdl);
+	for (i = 0; i < BENCHMARK_COUNT; i++) {
+		rc = pl_obj_place(pl_map, 0, &obj_table[i % working_set], 0, NULL, &layout);
+		D_ASSERT(rc == 0);
+		pl_obj_layout_free(layout);
+	}
+	benchmark_stop(bench_hdl);
+
+	ops = NANOSECONDS_PER_SECOND * BENCHMARK_COUNT / bench_hdl->wallclock_delta_ns;
+	D_PRINT("%u,%u,%d,%lld,%lld,%lld\n", cache_size, working_set, BENCHMARK_COUNT,
+		bench_hdl->wallclock_delta_ns, bench_hdl->thread_delta_ns, ops);
+
+	benchmark_free(bench_hdl);
+	free_pool_and_placement_map(pool_map, pl_map);
+	return ops;
+}
+
+static void
+benchmark_layout_cache(int argc, char **argv, uint32_t num_domains,
+		       uint32_t nodes_per_domain, uint32_t vos_per_target)
+{
+	struct daos_obj_md	*obj_table;
+	uint32_t		 working_set = DEFAULT_CACHE_WORKING_SET;
+	daos_oclass_id_t	 oclass = OC_RP_3G1;
+	long long		 ops_nocache;
+	long long		 ops_cache;
+	int			 i;
+	int			 rc;
+
+	while (1) {
+		static struct option long_options[] = {
+			{"working-set", required_argument, 0, 'w'},
+			{"obj-class", required_argument, 0, 'c'},
+			{0, 0, 0, 0}
+		};
+		int c;
+
+		c = getopt_long(argc, argv, "w:c:", long_options, NULL);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'w':
+			if (sscanf(optarg, "%u", &working_set) != 1 || working_set == 0) {
+				D_PRINT("ERROR: Invalid working-set '%s'\n", optarg);
+				benchmark_layout_cache_usage();
+				return;
+			}
+			break;
+		case 'c':
+			oclass = daos_oclass_name2id(optarg);
+			if (oclass == OC_UNKNOWN) {
+				D_PRINT("ERROR: Unknown obj-class '%s'\n", optarg);
+				benchmark_layout_cache_usage();
+				return;
+			}
+			break;
+		case '?':
+		default:
+			D_PRINT("ERROR: Unrecognized argument '%s'\n", optarg);
+			benchmark_layout_cache_usage();
+			return;
+		}
+	}
+
+	D_ALLOC_ARRAY(obj_table, working_set);
+	D_ASSERT(obj_table != NULL);
+
+	for (i = 0; i < working_set; i++) {
+		obj_table[i].omd_id.lo = rand();
+		obj_table[i].omd_id.hi = 5;
+		rc = daos_obj_set_oid_by_class(&obj_table[i].omd_id, 0, oclass, 0);
+		D_ASSERT(rc == 0);
+		obj_table[i].omd_ver = 1;
+	}
+
+	D_PRINT("\nLayout cache benchmark results:\n");
+	D_PRINT("# Cache size, Working set, Iterations, Wallclock time (ns), thread time (ns), "
+		"Wallclock placements per second\n");
+	ops_nocache = layout_cache_run(num_domains, nodes_per_domain, vos_per_target, obj_table,
+				       working_set, 0);
+	/* Large enough to hold the whole working set */
+	ops_cache = layout_cache_run(num_domains, nodes_per_domain, vos_per_target, obj_table,
+				     working_set, working_set * 2);
+	D_PRINT("Speedup with layout cache: %.2fx\n", (double)ops_cache / ops_nocache);
+
+	D_FREE(obj_table);
+}
+
 void
 benchmark_add_data_movement_usage()
 {
@@ -592,10 +726,12 @@ main(int argc, char **argv)
 	test_op_t op_fn[] = {
 		benchmark_placement,
 		benchmark_add_data_movement,
+		benchmark_layout_cache,
 	};
 	const char *const op_names[] = {
 		"benchmark-placement",
 		"benchmark-add",
+		"benchmark-cache",
 	};
 	D_ASSERT(ARRAY_SIZE(op_fn) == ARRAY_SIZE(op_names));
 
@@ -41,6 +41,7 @@ struct rebuild_send_arg {
 	daos_unit_oid_t			*oids;
 	daos_epoch_t			*ephs;
 	daos_epoch_t			*punched_ephs;
+	daos_epoch_t			*last_ephs;
 	uuid_t				cont_uuid;
 	unsigned int			*shards;
 	int				count;
@@ -50,6 +51,8 @@ struct rebuild_send_arg {
 struct rebuild_obj_val {
 	daos_epoch_t    eph;
 	daos_epoch_t	punched_eph;
+	/* last update/punch epoch of the object, 0 if it can not be used */
+	daos_epoch_t	last_eph;
 	uint32_t	shard;
 };
 
@@ -61,6 +64,7 @@ rebuild_obj_fill_buf(daos_handle_t ih, d_iov_t *key_iov,
 	daos_unit_oid_t		*oids = arg->oids;
 	daos_epoch_t		*ephs = arg->ephs;
 	daos_epoch_t		*punched_ephs = arg->punched_ephs;
+	daos_epoch_t		*last_ephs = arg->last_ephs;
 	daos_unit_oid_t		*oid = key_iov->iov_buf;
 	struct rebuild_obj_val	*obj_val = val_iov->iov_buf;
 	unsigned int		*shards = arg->shards;
@@ -71,6 +75,7 @@ rebuild_obj_fill_buf(daos_handle_t ih, d_iov_t *key_iov,
 	oids[count] = *oid;
 	ephs[count] = obj_val->eph;
 	punched_ephs[count] = obj_val->punched_eph;
+	last_ephs[count] = obj_val->last_eph;
 	shards[count] = obj_val->shard;
 	arg->count++;
 
@@ -131,7 +136,8 @@ rebuild_obj_send_cb(struct tree_cache_root *root, struct rebuild_send_arg *arg)
 					    rpt->rt_coh_uuid, arg->cont_uuid,
 					    arg->tgt_id, rpt->rt_rebuild_ver,
 					    rpt->rt_rebuild_gen, rpt->rt_stable_epoch,
-					    arg->oids, arg->ephs, arg->punched_ephs, arg->shards,
+					    arg->oids, arg->ephs, arg->punched_ephs, arg->last_ephs,
+					    arg->shards,
 					    arg->count, rpt->rt_new_layout_ver, rpt->rt_rebuild_op,
 					    &enqueue_id, &max_delay);
 		/* If it does not need retry */
@@ -303,6 +309,7 @@ rebuild_objects_send_ult(void *data)
 	daos_unit_oid_t			*oids = NULL;
 	daos_epoch_t			*ephs = NULL;
 	daos_epoch_t			*punched_ephs = NULL;
+	daos_epoch_t			*last_ephs = NULL;
 	unsigned int			*shards = NULL;
 	int				rc = 0;
 	uint64_t                         rebuild_send_wait_start;
@@ -335,11 +342,16 @@ rebuild_objects_send_ult(void *data)
 	if (punched_ephs == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
+	D_ALLOC_ARRAY(last_ephs, REBUILD_SEND_LIMIT);
+	if (last_ephs == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
 	arg.count = 0;
 	arg.oids = oids;
 	arg.shards = shards;
 	arg.ephs = ephs;
 	arg.punched_ephs = punched_ephs;
+	arg.last_ephs = last_ephs;
 	arg.rpt = rpt;
 	arg.tls          = tls;
 
@@ -412,6 +424,8 @@ out:
 		D_FREE(ephs);
 	if (punched_ephs != NULL)
 		D_FREE(punched_ephs);
+	if (last_ephs != NULL)
+		D_FREE(last_ephs);
 	if (rc != 0 && tls->rebuild_pool_status == 0) {
 		DL_ERROR(rc, DF_RB " objects send error", DP_RB_RPT(rpt));
 		tls->rebuild_pool_status = rc;
@@ -441,7 +455,7 @@ rebuild_scan_done(void *data)
 static int
 rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 		      daos_unit_oid_t oid, unsigned int tgt_id, unsigned int shard,
-		      daos_epoch_t epoch, daos_epoch_t punched_epoch)
+		      daos_epoch_t epoch, daos_epoch_t punched_epoch, daos_epoch_t last_epoch)
 {
 	struct rebuild_pool_tls *tls;
 	struct rebuild_obj_val	val;
@@ -456,6 +470,7 @@ rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 	tls->rebuild_pool_obj_count++;
 	val.eph = epoch;
 	val.punched_eph = punched_epoch;
+	val.last_eph = last_epoch;
 	val.shard = shard;
 	d_iov_set(&val_iov, &val, sizeof(struct rebuild_obj_val));
 	oid.id_shard = shard; /* Convert the OID to rebuilt one */
@@ -492,6 +507,8 @@ struct rebuild_scan_arg {
 	int				snapshot_cnt;
 	int32_t                          yield_cnt;
 	struct ds_cont_child		*cont_child;
+	/* push the objects of the container instead of letting targets pull them */
+	bool                             push;
 };
 
 /**
@@ -707,6 +724,7 @@ struct rebuild_obj_arg {
 	uuid_t				co_uuid;
 	daos_epoch_t			epoch;
 	daos_epoch_t			punched_epoch;
+	daos_epoch_t			last_epoch;
 	daos_epoch_t			max_eph;
 	uint32_t			shard;
 	uint32_t			tgt_index;
@@ -735,7 +753,7 @@ rebuild_obj_ult(void *data)
 	ds_migrate_object(rpt->rt_pool_uuid, rpt->rt_poh_uuid, rpt->rt_coh_uuid, arg->co_uuid,
 			  rpt->rt_rebuild_ver, rpt->rt_rebuild_gen, rpt->rt_stable_epoch,
 			  rpt->rt_rebuild_op, &arg->oid, &arg->epoch, &arg->punched_epoch,
-			  &arg->shard, 1, arg->tgt_index, rpt->rt_new_layout_ver);
+			  &arg->last_epoch, &arg->shard, 1, arg->tgt_index, rpt->rt_new_layout_ver);
 out:
 	rpt_put(rpt);
 	D_FREE(arg);
@@ -744,7 +762,7 @@ out:
 static int
 rebuild_object_local(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 		     daos_unit_oid_t oid, unsigned int tgt_index, unsigned int shard,
-		     daos_epoch_t eph, daos_epoch_t punched_eph)
+		     daos_epoch_t eph, daos_epoch_t punched_eph, daos_epoch_t last_eph)
 {
 	struct rebuild_obj_arg	*arg;
 	int			rc;
@@ -759,6 +777,7 @@ rebuild_object_local(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 	arg->oid.id_shard = shard; /* Convert the OID to rebuilt one */
 	arg->epoch = eph;
 	arg->punched_epoch = punched_eph;
+	arg->last_epoch = last_eph;
 	uuid_copy(arg->co_uuid, co_uuid);
 	arg->tgt_index = tgt_index;
 	arg->shard = shard;
@@ -773,13 +792,15 @@ rebuild_object_local(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 }
 
 static int
-rebuild_object(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid, daos_unit_oid_t oid,
-	       unsigned int tgt, uint32_t shard, d_rank_t myrank, vos_iter_entry_t *ent)
+rebuild_object(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid, daos_handle_t coh,
+	       daos_unit_oid_t oid, unsigned int tgt, uint32_t shard, d_rank_t myrank,
+	       struct daos_oclass_attr *oc_attr, vos_iter_entry_t *ent, bool push)
 {
 	uint32_t		mytarget = dss_get_module_info()->dmi_tgt_id;
 	struct pool_target	*target;
 	daos_epoch_t		eph;
 	daos_epoch_t		punched_eph;
+	daos_epoch_t		last_eph;
 	int			rc;
 
 	rc = pool_map_find_target(rpt->rt_pool->sp_map, tgt, &target);
@@ -801,11 +822,38 @@ rebuild_object(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid, daos_unit_o
 		punched_eph = 0;
 	}
 
+	/*
+	 * Every update of a replicated object lands on all of its shards, so the last
+	 * update epoch of this shard tells a reintegrating target whether its own copy,
+	 * complete up to its stable epoch, is still current. EC shards do not see every
+	 * update, so their objects are always migrated.
+	 */
+	last_eph = daos_oclass_is_ec(oc_attr) ? 0 : ent->ie_last_update;
+
+	/*
+	 * A reintegrating target only keeps the objects that are migrated by the pull path.
+	 * A punched object without data is pushed as the object punch alone.
+	 */
+	if (push && target->ta_comp.co_status != PO_COMP_ST_UP) {
+		rc = ds_migrate_push_object(rpt->rt_pool_uuid, co_uuid, coh, rpt->rt_rebuild_ver,
+					    rpt->rt_rebuild_gen, rpt->rt_stable_epoch, punched_eph,
+					    oid, shard, target->ta_comp.co_rank,
+					    target->ta_comp.co_index);
+		if (rc == 0)
+			return 0;
+
+		DL_INFO(rc, DF_RB " " DF_UOID " push to %u/%u failed, fall back to pull",
+			DP_RB_RPT(rpt), DP_UOID(oid), target->ta_comp.co_rank,
+			target->ta_comp.co_index);
+		rc = 0;
+	}
+
 	if (myrank == target->ta_comp.co_rank)
 		rc = rebuild_object_local(rpt, co_uuid, oid, target->ta_comp.co_index, shard,
-					  eph, punched_eph);
+					  eph, punched_eph, last_eph);
 	else
-		rc = rebuild_object_insert(rpt, co_uuid, oid, tgt, shard, eph, punched_eph);
+		rc = rebuild_object_insert(rpt, co_uuid, oid, tgt, shard, eph, punched_eph,
+					   last_eph);
 
 	return rc;
 }
@@ -829,6 +877,7 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 	uint32_t                         grp_nr;
 	int				rebuild_nr = 0;
 	d_rank_t			myrank;
+	bool                             push;
 	int				i;
 	int				rc = 0;
 
@@ -856,6 +905,8 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 
 	grp_size = daos_oclass_grp_size(oc_attr);
 	grp_nr   = daos_obj_id2grp_nr(oid.id_pub);
+	/* EC objects need parity regeneration on the target, always pull them. */
+	push     = arg->push && !daos_oclass_is_ec(oc_attr);
 	/* appropriate yield based on shard number */
 	arg->yield_cnt -= roundup(grp_size * grp_nr, 128) / 128;
 
@@ -927,10 +978,15 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 			continue;
 		}
 
-		rc = rebuild_object(rpt, arg->co_uuid, oid, tgts[i], shards[i], myrank, ent);
+		rc = rebuild_object(rpt, arg->co_uuid, param->ip_hdl, oid, tgts[i], shards[i],
+				    myrank, oc_attr, ent, push);
 		if (rc)
 			D_GOTO(out, rc);
 
+		/* Pushing the object yields, make the iterator re-probe. */
+		if (push)
+			*acts |= VOS_ITER_CB_YIELD;
+
 		arg->yield_cnt--;
 	}
 
@@ -1083,6 +1139,15 @@ rebuild_container_scan_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 	if (snapshot_cnt > 0)
 		param.ip_flags |= VOS_IT_PUNCHED;
 
+	/*
+	 * Pushing only streams the data visible at the stable epoch, so it is limited to
+	 * the rebuild of containers without snapshots, and without checksums which would
+	 * have to be carried along with the data.
+	 */
+	arg->push = ds_migrate_push_enabled() && rpt->rt_rebuild_op == RB_OP_REBUILD &&
+		    rpt->rt_stable_epoch != 0 && snapshot_cnt == 0 &&
+		    !arg->co_props.dcp_csum_enabled;
+
 	rc = vos_iterate(&param, VOS_ITER_OBJ, false, &anchor,
 			 rebuild_obj_scan_cb, NULL, arg, dth);
 	dtx_end(dth, NULL, rc);
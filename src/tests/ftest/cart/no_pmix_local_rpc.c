@@ -0,0 +1,245 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This test verifies the in-process delivery of RPCs registered with
+ * CRT_RPC_FEAT_LOCAL, see D_RPC_LOCAL.
+ *
+ * A single server rank creates two contexts and sends echo RPCs from the first
+ * one to the second one. The handler checks the data it gets and reports whether
+ * the input buffer is the one of the origin, which is only the case when the RPC
+ * was not serialized. The same is then done with D_RPC_LOCAL set to 0, when the
+ * RPCs shall go through the network layer.
+ *
+ * Every other RPC carries a trace ID, which the handler returns, to check that
+ * it is encoded in and decoded from the request header, see
+ * crt_req_set_trace_id().
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <assert.h>
+#include <semaphore.h>
+#include <cart/api.h>
+#include "crt_utils.h"
+
+#define NUM_CTX		2
+#define NUM_RPCS	1000
+#define ECHO_SIZE	4096
+
+#define MY_BASE		0x010000000
+#define MY_VER		0
+
+#define CRT_ISEQ_RPC_LOCAL_ECHO	/* input fields */		 \
+	((uint64_t)		(seq)			CRT_VAR) \
+	((uint64_t)		(addr)			CRT_VAR) \
+	((d_iov_t)		(data)			CRT_VAR)
+
+#define CRT_OSEQ_RPC_LOCAL_ECHO	/* output fields */		 \
+	((uint64_t)		(seq)			CRT_VAR) \
+	((uint64_t)		(sum)			CRT_VAR) \
+	((uint64_t)		(trace_id)		CRT_VAR) \
+	((uint32_t)		(local)			CRT_VAR) \
+	((int32_t)		(ctx_idx)		CRT_VAR)
+
+CRT_RPC_DECLARE(RPC_LOCAL_ECHO, CRT_ISEQ_RPC_LOCAL_ECHO, CRT_OSEQ_RPC_LOCAL_ECHO)
+CRT_RPC_DEFINE(RPC_LOCAL_ECHO, CRT_ISEQ_RPC_LOCAL_ECHO, CRT_OSEQ_RPC_LOCAL_ECHO)
+
+enum {
+	RPC_LOCAL_ECHO = CRT_PROTO_OPC(MY_BASE, MY_VER, 0),
+};
+
+static crt_context_t	crt_ctx[NUM_CTX];
+static sem_t		done_sem;
+static ATOMIC int	nr_local;
+static ATOMIC int	nr_replies;
+
+/* trace ID of the echo \a seq, zero if it is not traced */
+static uint64_t
+echo_trace_id(uint64_t seq)
+{
+	return seq % 2 == 0 ? 0 : (0xabcdULL << 48) | seq;
+}
+
+static uint64_t
+echo_sum(const d_iov_t *iov)
+{
+	const unsigned char	*buf = iov->iov_buf;
+	uint64_t		 sum = 0;
+	size_t			 i;
+
+	for (i = 0; i < iov->iov_len; i++)
+		sum += buf[i];
+
+	return sum;
+}
+
+static int
+handler_local_echo(crt_rpc_t *rpc)
+{
+	struct RPC_LOCAL_ECHO_in	*input = crt_req_get(rpc);
+	struct RPC_LOCAL_ECHO_out	*output = crt_reply_get(rpc);
+	int				 rc;
+
+	output->seq   = input->seq;
+	output->sum   = echo_sum(&input->data);
+	output->local = (uint64_t)input->data.iov_buf == input->addr;
+
+	rc = crt_context_idx(rpc->cr_ctx, &output->ctx_idx);
+	D_ASSERTF(rc == 0, "crt_context_idx() failed; rc=%d\n", rc);
+
+	rc = crt_req_get_trace_id(rpc, &output->trace_id);
+	D_ASSERTF(rc == 0, "crt_req_get_trace_id() failed; rc=%d\n", rc);
+
+	rc = crt_reply_send(rpc);
+	D_ASSERTF(rc == 0, "crt_reply_send() failed; rc=%d\n", rc);
+
+	return 0;
+}
+
+static struct crt_proto_rpc_format my_proto_rpc_fmt[] = {
+	{
+		.prf_flags	= CRT_RPC_FEAT_LOCAL,
+		.prf_req_fmt	= &CQF_RPC_LOCAL_ECHO,
+		.prf_hdlr	= (void *)handler_local_echo,
+		.prf_co_ops	= NULL,
+	}
+};
+
+static struct crt_proto_format my_proto_fmt = {
+	.cpf_name = "local-rpc-proto",
+	.cpf_ver = MY_VER,
+	.cpf_count = ARRAY_SIZE(my_proto_rpc_fmt),
+	.cpf_prf = &my_proto_rpc_fmt[0],
+	.cpf_base = MY_BASE,
+};
+
+static void
+echo_cb(const struct crt_cb_info *info)
+{
+	struct RPC_LOCAL_ECHO_in	*input = crt_req_get(info->cci_rpc);
+	struct RPC_LOCAL_ECHO_out	*output = crt_reply_get(info->cci_rpc);
+
+	D_ASSERTF(info->cci_rc == 0, "echo %lu failed; rc=%d\n", input->seq, info->cci_rc);
+	D_ASSERTF(output->seq == input->seq, "echo %lu got the reply of %lu\n", input->seq,
+		  output->seq);
+	D_ASSERTF(output->sum == echo_sum(&input->data), "echo %lu got a bad sum\n", input->seq);
+	D_ASSERTF(output->ctx_idx == 1, "echo %lu handled by context %d\n", input->seq,
+		  output->ctx_idx);
+	D_ASSERTF(output->trace_id == echo_trace_id(input->seq),
+		  "echo %lu got trace ID %#lx instead of %#lx\n", input->seq, output->trace_id,
+		  echo_trace_id(input->seq));
+
+	if (output->local)
+		atomic_fetch_add(&nr_local, 1);
+	if (atomic_fetch_add(&nr_replies, 1) + 1 == NUM_RPCS)
+		sem_post(&done_sem);
+}
+
+static void
+run_echo(bool expect_local)
+{
+	pthread_t	 progress_thread[NUM_CTX];
+	crt_endpoint_t	 ep = {.ep_rank = 0, .ep_tag = 1};
+	crt_rpc_t	*rpc;
+	struct RPC_LOCAL_ECHO_in *input;
+	char		*bufs;
+	int		 i;
+	int		 rc;
+
+	rc = crt_init(0, CRT_FLAG_BIT_SERVER | CRT_FLAG_BIT_AUTO_SWIM_DISABLE);
+	D_ASSERTF(rc == 0, "crt_init() failed; rc=%d\n", rc);
+
+	/* rank, num_attach_retries, is_server, assert_on_error */
+	crtu_test_init(0, 20, true, true);
+	crtu_set_shutdown_delay(0);
+
+	rc = crt_rank_self_set(0, 1 /* group_version_min */);
+	D_ASSERTF(rc == 0, "crt_rank_self_set(0) failed; rc=%d\n", rc);
+
+	rc = crt_proto_register(&my_proto_fmt);
+	D_ASSERTF(rc == 0, "crt_proto_register() failed; rc=%d\n", rc);
+
+	for (i = 0; i < NUM_CTX; i++) {
+		rc = crt_context_create(&crt_ctx[i]);
+		D_ASSERTF(rc == 0, "crt_context_create() failed; rc=%d\n", rc);
+
+		rc = pthread_create(&progress_thread[i], 0, crtu_progress_fn, &crt_ctx[i]);
+		D_ASSERTF(rc == 0, "pthread_create() failed; rc=%d\n", rc);
+	}
+
+	/* the input points to these buffers until the replies come back */
+	D_ALLOC(bufs, NUM_RPCS * ECHO_SIZE);
+	D_ASSERTF(bufs != NULL, "Failed to allocate the echo buffers\n");
+
+	atomic_store(&nr_local, 0);
+	atomic_store(&nr_replies, 0);
+	for (i = 0; i < NUM_RPCS; i++) {
+		rc = crt_req_create(crt_ctx[0], &ep, RPC_LOCAL_ECHO, &rpc);
+		D_ASSERTF(rc == 0, "crt_req_create() failed; rc=%d\n", rc);
+
+		memset(&bufs[i * ECHO_SIZE], i, ECHO_SIZE);
+		input       = crt_req_get(rpc);
+		input->seq  = i;
+		input->addr = (uint64_t)&bufs[i * ECHO_SIZE];
+		d_iov_set(&input->data, &bufs[i * ECHO_SIZE], ECHO_SIZE);
+
+		rc = crt_req_set_trace_id(rpc, echo_trace_id(i));
+		D_ASSERTF(rc == 0, "crt_req_set_trace_id() failed; rc=%d\n", rc);
+
+		rc = crt_req_send(rpc, echo_cb, NULL);
+		D_ASSERTF(rc == 0, "crt_req_send() failed; rc=%d\n", rc);
+	}
+
+	crtu_sem_timedwait(&done_sem, 60, __LINE__);
+
+	if (expect_local)
+		D_ASSERTF(atomic_load(&nr_local) == NUM_RPCS,
+			  "only %d of %d RPCs delivered in process\n", atomic_load(&nr_local),
+			  NUM_RPCS);
+	else
+		D_ASSERTF(atomic_load(&nr_local) == 0,
+			  "%d RPCs delivered in process with D_RPC_LOCAL=0\n",
+			  atomic_load(&nr_local));
+	DBG_PRINT("%d echo RPCs, %d delivered in process\n", NUM_RPCS, atomic_load(&nr_local));
+
+	crtu_progress_stop();
+	for (i = 0; i < NUM_CTX; i++)
+		pthread_join(progress_thread[i], NULL);
+
+	D_FREE(bufs);
+
+	rc = crt_finalize();
+	D_ASSERTF(rc == 0, "crt_finalize() failed; rc=%d\n", rc);
+}
+
+int main(int argc, char **argv)
+{
+	int	rc;
+
+	/* Set these 2 if they are not set so that test still runs by default */
+	setenv("D_PROVIDER", "ofi+tcp", 0);
+	setenv("D_INTERFACE", "eth0", 0);
+
+	rc = d_log_init();
+	assert(rc == 0);
+
+	rc = sem_init(&done_sem, 0, 0);
+	D_ASSERTF(rc == 0, "sem_init() failed; rc=%d\n", rc);
+
+	unsetenv("D_RPC_LOCAL");
+	run_echo(true);
+	DBG_PRINT("In-process delivery PASSED\n");
+
+	setenv("D_RPC_LOCAL", "0", 1);
+	run_echo(false);
+	DBG_PRINT("Delivery through the network layer PASSED\n");
+
+	sem_destroy(&done_sem);
+	d_log_fini();
+
+	return 0;
+}
@@ -10,7 +10,8 @@ from cart_utils import CartTest
 class CartMultisendOneNodeTest(CartTest):
     # pylint: disable=too-few-public-methods
     """Run multi-send test that launches 16 servers and splits bulk
-       transfers among them using different parameters.
+       transfers among them using different parameters, then sends small
+       RPCs to them with and without coalescing.
 
     :avocado: recursive
     """
@@ -0,0 +1,78 @@
+'''
+  (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+'''
+import json
+import os
+
+from cart_utils import CartTest
+
+
+class CartSelfOneNodeTest(CartTest):
+    # pylint: disable=too-few-public-methods
+    """Runs CaRT self test against a loopback group.
+
+    :avocado: recursive
+    """
+
+    def test_cart_selftest_one_node(self):
+        """Test CaRT Self Test percentiles, in-flight sweeps and JSON output on a single node.
+
+        :avocado: tags=all,pr,daily_regression
+        :avocado: tags=vm
+        :avocado: tags=cart,selftest
+        :avocado: tags=CartSelfOneNodeTest,test_cart_selftest_one_node
+        """
+        daos_test_shared_dir = os.getenv('DAOS_TEST_SHARED_DIR', os.getenv('HOME'))
+        output_file = os.path.join(daos_test_shared_dir, "selftest_one_node.json")
+        if os.path.exists(output_file):
+            os.remove(output_file)
+
+        srvcmd = self.build_cmd(self.env, "test_servers")
+
+        try:
+            srv_rtn = self.launch_cmd_bg(srvcmd)
+        # pylint: disable=broad-except
+        except Exception as error:
+            self.log.info("Exception in launching server : %s", error)
+            self.fail("Test failed.\n")
+
+        # Verify the server is still running.
+        if not self.check_process(srv_rtn):
+            procrtn = self.stop_process(srv_rtn)
+            self.fail("Server did not launch, return code {}".format(procrtn))
+
+        clicmd = self.build_cmd(self.env, "test_clients", index=0)
+        self.launch_test(clicmd + " --output-file " + output_file, srv_rtn)
+        clicmd = self.build_cmd(self.env, "test_clients", index=1)
+        self.launch_test(clicmd, srv_rtn)
+
+        # Give few seconds for servers to fully shut down before exiting
+        # from this test.
+        if not self.wait_process(srv_rtn, 5):
+            self.stop_process(srv_rtn)
+
+        with open(output_file, "r", encoding="utf-8") as file:
+            output = json.load(file)
+        self.log.info("self_test results: %s", json.dumps(output, indent=2))
+
+        num_results = self.params.get("num_results", "/run/tests/*/")
+        results = output["results"]
+        if len(results) != num_results:
+            self.fail("Got {} results, expected {}".format(len(results), num_results))
+        if sorted({result["max_inflight"] for result in results}) != [1, 8]:
+            self.fail("Missing results of the in-flight sweep")
+
+        for result in results:
+            summaries = [result] + result["endpoints"]
+            if len(result["endpoints"]) != 2:
+                self.fail("Expected the results of 2 endpoints: {}".format(result))
+            for summary in summaries:
+                lat = summary["latency_ns"]
+                if summary["failed"] != 0 or summary["passed"] == 0:
+                    self.fail("RPCs failed: {}".format(summary))
+                if not 0 < lat["min"] <= lat["p50"] <= lat["p99"] <= lat["p99_9"] <= lat["max"]:
+                    self.fail("Inconsistent latency percentiles: {}".format(lat))
+            if sum(endpt["passed"] for endpt in result["endpoints"]) != result["passed"]:
+                self.fail("Endpoint results do not add up: {}".format(result))
@@ -37,6 +37,62 @@ handler_ping(crt_rpc_t *rpc)
 	return 0;
 }
 
+#define ECHO_DATA_MAX	64
+
+static char echo_data[ECHO_DATA_MAX];
+
+static void
+echo_cb(const struct crt_cb_info *info)
+{
+	struct RPC_ECHO_in	*input = crt_req_get(info->cci_rpc);
+	struct RPC_ECHO_out	*output = crt_reply_get(info->cci_rpc);
+
+	D_ASSERTF(info->cci_rc == 0, "echo rpc failed. rc: %d\n", info->cci_rc);
+	/* each reply must be matched with its own request, whether coalesced or not */
+	D_ASSERTF(output->seq == input->seq, "echo %lu got the reply of %lu\n", input->seq,
+		  output->seq);
+	D_ASSERTF(output->sum == echo_sum(&input->data), "echo %lu bad sum %lu\n", input->seq,
+		  output->sum);
+
+	sem_post(&test.tg_token_to_proceed);
+}
+
+/* Send many small RPCs at once to all ranks, so that they get coalesced when enabled */
+static void
+test_echo(crt_group_t *grp)
+{
+	struct RPC_ECHO_in	*input;
+	crt_endpoint_t		 server_ep = {0};
+	crt_rpc_t		*rpc_req;
+	int			 i;
+	int			 rc;
+
+	for (i = 0; i < ECHO_DATA_MAX; i++)
+		echo_data[i] = i + 1;
+
+	server_ep.ep_grp = grp;
+	for (i = 0; i < test.tg_num_echo; i++) {
+		server_ep.ep_rank = i % test.tg_remote_group_size;
+
+		rc = crt_req_create(test.tg_crt_ctx[i % test.tg_num_ctx], &server_ep, RPC_ECHO,
+				    &rpc_req);
+		D_ASSERTF(rc == 0 && rpc_req != NULL, "crt_req_create() failed,"
+			  " rc: %d rpc_req: %p\n", rc, rpc_req);
+
+		input = crt_req_get(rpc_req);
+		input->seq = i;
+		d_iov_set(&input->data, echo_data, i % ECHO_DATA_MAX + 1);
+
+		rc = crt_req_send(rpc_req, echo_cb, NULL);
+		D_ASSERTF(rc == 0, "crt_req_send() failed. rc: %d\n", rc);
+	}
+
+	for (i = 0; i < test.tg_num_echo; i++)
+		crtu_sem_timedwait(&test.tg_token_to_proceed, 61, __LINE__);
+
+	DBG_PRINT("%d echo RPCs replied\n", test.tg_num_echo);
+}
+
 static void
 test_run()
 {
@@ -207,6 +263,9 @@ test_run()
 			  test.tg_force_rank, time_delta/num_iterations, num_iterations);
 	}
 
+	if (test.tg_num_echo > 0)
+		test_echo(grp);
+
 	/* SHUTDOWN servers */
 	if (test.tg_do_shutdown) {
 		for (i = 0; i < test.tg_remote_group_size; i++) {
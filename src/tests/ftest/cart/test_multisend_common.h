@@ -34,7 +34,8 @@
 
 enum {
 	RPC_PING = CRT_PROTO_OPC(MY_BASE, MY_VER, 0),
-	RPC_SHUTDOWN
+	RPC_SHUTDOWN,
+	RPC_ECHO,
 } rpc_id_t;
 
 #define CRT_ISEQ_RPC_PING	/* input fields */		 \
@@ -52,11 +53,22 @@ enum {
 #define CRT_OSEQ_RPC_SHUTDOWN	/* output fields */		 \
 	((uint64_t)		(field)			CRT_VAR)
 
+/* small RPC which may be coalesced, see D_RPC_COALESCE_DELAY */
+#define CRT_ISEQ_RPC_ECHO	/* input fields */		 \
+	((uint64_t)		(seq)			CRT_VAR) \
+	((d_iov_t)		(data)			CRT_VAR)
+
+#define CRT_OSEQ_RPC_ECHO	/* output fields */		 \
+	((uint64_t)		(seq)			CRT_VAR) \
+	((uint64_t)		(sum)			CRT_VAR)
+
 static int handler_ping(crt_rpc_t *rpc);
 static int handler_shutdown(crt_rpc_t *rpc);
+static int handler_echo(crt_rpc_t *rpc);
 
 RPC_DECLARE(RPC_PING);
 RPC_DECLARE(RPC_SHUTDOWN);
+RPC_DECLARE(RPC_ECHO);
 
 struct crt_proto_rpc_format my_proto_rpc_fmt[] = {
 	{
@@ -69,6 +81,11 @@ struct crt_proto_rpc_format my_proto_rpc_fmt[] = {
 		.prf_req_fmt	= &CQF_RPC_SHUTDOWN,
 		.prf_hdlr	= (void *)handler_shutdown,
 		.prf_co_ops	= NULL,
+	}, {
+		.prf_flags	= CRT_RPC_FEAT_COALESCE,
+		.prf_req_fmt	= &CQF_RPC_ECHO,
+		.prf_hdlr	= (void *)handler_echo,
+		.prf_co_ops	= NULL,
 	}
 };
 
@@ -109,6 +126,7 @@ struct test_global_t {
 	int			 tg_num_iterations;
 	int			 tg_chunk_size_kb;
 	int			 tg_force_rank;
+	int			 tg_num_echo;
 };
 
 struct test_global_t test = {0};
@@ -123,11 +141,37 @@ handler_shutdown(crt_rpc_t *rpc)
 	return 0;
 }
 
+static uint64_t
+echo_sum(d_iov_t *data)
+{
+	uint64_t	sum = 0;
+	size_t		i;
+
+	for (i = 0; i < data->iov_len; i++)
+		sum += ((unsigned char *)data->iov_buf)[i];
+	return sum;
+}
+
+static int
+handler_echo(crt_rpc_t *rpc)
+{
+	struct RPC_ECHO_in	*input = crt_req_get(rpc);
+	struct RPC_ECHO_out	*output = crt_reply_get(rpc);
+	int			 rc;
+
+	output->seq = input->seq;
+	output->sum = echo_sum(&input->data);
+	rc = crt_reply_send(rpc);
+	if (rc != 0)
+		D_ERROR("reply failed; rc=%d\n", rc);
+	return 0;
+}
+
 
 static void
 show_usage(void)
 {
-	printf("Usage: ./test_multisend_client [-acfspqmex]\n");
+	printf("Usage: ./test_multisend_client [-acfspqmexk]\n");
 	printf("Options:\n");
 	printf("-a [--attach-to <group_name>] : server group to attach to\n");
 	printf("-s [--cfg-path <path>]: path to attach info file\n");
@@ -138,6 +182,7 @@ show_usage(void)
 	printf("-x: When set performs DMA_PUT to client instead of DMA_GET\n");
 	printf("-m: Mode. 1 - Synchronous, 2 - Asynchronous\n");
 	printf("-q: Shut servers down at the end of the run\n");
+	printf("-k <num>: Number of small echo RPCs to send after the bulk transfers\n");
 }
 
 int
@@ -160,7 +205,7 @@ test_parse_args(int argc, char **argv)
 	test.tg_force_rank = -1;
 
 	while (1) {
-		rc = getopt_long(argc, argv, "g:c:n:a:s:p:m:e:f:xq", long_options,
+		rc = getopt_long(argc, argv, "g:c:n:a:s:p:m:e:f:k:xq", long_options,
 				 &option_index);
 		if (rc == -1)
 			break;
@@ -185,6 +230,9 @@ test_parse_args(int argc, char **argv)
 		case 'g':
 			test.tg_local_group_name =  optarg;
 			break;
+		case 'k':
+			test.tg_num_echo = atoi(optarg);
+			break;
 		case 'm':
 			test.tg_test_mode = atoi(optarg);
 			if ((test.tg_test_mode != TEST_MODE_ASYNC) &&
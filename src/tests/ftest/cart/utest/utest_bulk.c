@@ -0,0 +1,285 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of CaRT testing.
+ *
+ * It checks the bulk registration cache (D_BULK_CACHE_SIZE): registrations of
+ * the same buffer are reused, and a buffer invalidated, unmapped and mapped
+ * again at the same address is registered again instead of being served by the
+ * registration of the previous mapping.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <cmocka.h>
+#include <cart/api.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_producer.h>
+#include <gurt/telemetry_consumer.h>
+#include "../cart/crt_internal.h"
+
+#define BULK_BUF_SIZE	(1 << 20)
+/* must match D_BULK_CACHE_SIZE set in init_tests() */
+#define BULK_CACHE_SIZE	4
+
+static crt_context_t	bulk_ctx;
+
+struct bulk_cache_stats {
+	uint64_t	hit;
+	uint64_t	miss;
+	uint64_t	evict;
+};
+
+static void
+cache_stats(struct bulk_cache_stats *stats)
+{
+	struct crt_context	*ctx = bulk_ctx;
+
+	assert_rc_equal(d_tm_get_counter(NULL, &stats->hit, ctx->cc_metrics.CM_BULK_CACHE_HIT), 0);
+	assert_rc_equal(d_tm_get_counter(NULL, &stats->miss, ctx->cc_metrics.CM_BULK_CACHE_MISS),
+			0);
+	assert_rc_equal(d_tm_get_counter(NULL, &stats->evict, ctx->cc_metrics.CM_BULK_CACHE_EVICT),
+			0);
+}
+
+/* Check the cache counters moved by the given amounts since \a prev */
+static void
+cache_check(struct bulk_cache_stats *prev, uint64_t hit, uint64_t miss, uint64_t evict)
+{
+	struct bulk_cache_stats	cur;
+
+	cache_stats(&cur);
+	assert_int_equal(cur.hit - prev->hit, hit);
+	assert_int_equal(cur.miss - prev->miss, miss);
+	assert_int_equal(cur.evict - prev->evict, evict);
+	*prev = cur;
+}
+
+static crt_bulk_t
+bulk_create(void *buf, size_t size, char pattern)
+{
+	d_sg_list_t	 sgl;
+	d_sg_list_t	 out;
+	d_iov_t		 iov;
+	d_iov_t		 out_iov;
+	crt_bulk_t	 bulk;
+	size_t		 len;
+	int		 rc;
+
+	memset(buf, pattern, size);
+	d_iov_set(&iov, buf, size);
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs   = &iov;
+
+	rc = crt_bulk_create(bulk_ctx, &sgl, CRT_BULK_RW, &bulk);
+	assert_rc_equal(rc, 0);
+
+	rc = crt_bulk_get_len(bulk, &len);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(len, size);
+
+	d_iov_set(&out_iov, NULL, 0);
+	out.sg_nr     = 1;
+	out.sg_nr_out = 0;
+	out.sg_iovs   = &out_iov;
+	rc = crt_bulk_access(bulk, &out);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(out.sg_nr_out, 1);
+	assert_ptr_equal(out_iov.iov_buf, buf);
+	assert_int_equal(out_iov.iov_len, size);
+	assert_int_equal(((char *)out_iov.iov_buf)[size - 1], pattern);
+
+	return bulk;
+}
+
+static void
+bulk_check(void *buf, char pattern)
+{
+	assert_rc_equal(crt_bulk_free(bulk_create(buf, BULK_BUF_SIZE, pattern)), 0);
+}
+
+static void *
+buf_map(void *addr)
+{
+	void	*buf;
+
+	buf = mmap(addr, BULK_BUF_SIZE, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS | (addr != NULL ? MAP_FIXED : 0), -1, 0);
+	assert_true(buf != MAP_FAILED);
+	if (addr != NULL)
+		assert_ptr_equal(buf, addr);
+
+	return buf;
+}
+
+static void
+test_bulk_cache_reuse(void **state)
+{
+	struct bulk_cache_stats	 stats;
+	crt_bulk_t		 bulk;
+	void			*buf;
+
+	cache_stats(&stats);
+	buf = buf_map(NULL);
+
+	/* the first registration misses, the following ones reuse it */
+	bulk_check(buf, 'a');
+	cache_check(&stats, 0, 1, 0);
+	bulk_check(buf, 'b');
+	bulk_check(buf, 'c');
+	cache_check(&stats, 2, 0, 0);
+
+	/* a different range of the same buffer is a different registration */
+	assert_rc_equal(crt_bulk_free(bulk_create(buf, BULK_BUF_SIZE / 2, 'd')), 0);
+	cache_check(&stats, 0, 1, 0);
+
+	/* binding a shared handle gives the bulk its own, the cache keeps its entry */
+	bulk = bulk_create(buf, BULK_BUF_SIZE, 'e');
+	assert_true(((struct crt_bulk *)bulk)->cached);
+	assert_rc_equal(crt_bulk_bind(bulk, bulk_ctx), 0);
+	assert_false(((struct crt_bulk *)bulk)->cached);
+	assert_rc_equal(crt_bulk_free(bulk), 0);
+	bulk_check(buf, 'f');
+	cache_check(&stats, 2, 0, 0);
+
+	assert_rc_equal(crt_bulk_cache_invalidate(NULL, 0), 0);
+	cache_check(&stats, 0, 0, 2);
+	assert_int_equal(munmap(buf, BULK_BUF_SIZE), 0);
+}
+
+static void
+test_bulk_cache_remap(void **state)
+{
+	struct bulk_cache_stats	 stats;
+	crt_bulk_t		 bulk;
+	char			*buf;
+	int			 i;
+
+	cache_stats(&stats);
+	buf = buf_map(NULL);
+	bulk_check(buf, 'a');
+	bulk_check(buf, 'b');
+	cache_check(&stats, 1, 1, 0);
+
+	/*
+	 * Free the pages and map new ones at the same address, several times.
+	 * Each new mapping must be registered again: a hit would hand out the
+	 * registration of the previous pages.
+	 */
+	for (i = 0; i < 3; i++) {
+		assert_rc_equal(crt_bulk_cache_invalidate(buf, BULK_BUF_SIZE), 0);
+		cache_check(&stats, 0, 0, 1);
+		assert_int_equal(munmap(buf, BULK_BUF_SIZE), 0);
+		buf_map(buf);
+
+		bulk_check(buf, 'c' + i);
+		cache_check(&stats, 0, 1, 0);
+	}
+
+	/* invalidating any overlapping range drops the registration */
+	assert_rc_equal(crt_bulk_cache_invalidate(buf + BULK_BUF_SIZE - 1, 1), 0);
+	cache_check(&stats, 0, 0, 1);
+	assert_rc_equal(crt_bulk_cache_invalidate(buf + BULK_BUF_SIZE, 1), 0);
+	cache_check(&stats, 0, 0, 0);
+
+	/* a bulk still in use keeps its registration until it is freed */
+	bulk = bulk_create(buf, BULK_BUF_SIZE, 'x');
+	assert_rc_equal(crt_bulk_cache_invalidate(buf, BULK_BUF_SIZE), 0);
+	cache_check(&stats, 0, 1, 1);
+	bulk_check(buf, 'y');
+	assert_rc_equal(crt_bulk_free(bulk), 0);
+	cache_check(&stats, 0, 1, 0);
+
+	assert_rc_equal(crt_bulk_cache_invalidate(buf, BULK_BUF_SIZE), 0);
+	assert_int_equal(munmap(buf, BULK_BUF_SIZE), 0);
+
+	assert_rc_equal(crt_bulk_cache_invalidate(buf, 0), -DER_INVAL);
+	assert_rc_equal(crt_bulk_cache_invalidate(NULL, 1), -DER_INVAL);
+}
+
+static void
+test_bulk_cache_evict(void **state)
+{
+	struct bulk_cache_stats	 stats;
+	char			*buf;
+	int			 i;
+
+	cache_stats(&stats);
+	buf = buf_map(NULL);
+
+	/* one more registration than the cache holds evicts the oldest one */
+	for (i = 0; i <= BULK_CACHE_SIZE; i++)
+		assert_rc_equal(crt_bulk_free(bulk_create(buf + i, BULK_BUF_SIZE / 2, 'a')), 0);
+	cache_check(&stats, 0, BULK_CACHE_SIZE + 1, 1);
+
+	assert_rc_equal(crt_bulk_free(bulk_create(buf + BULK_CACHE_SIZE, BULK_BUF_SIZE / 2, 'b')),
+			0);
+	cache_check(&stats, 1, 0, 0);
+	assert_rc_equal(crt_bulk_free(bulk_create(buf, BULK_BUF_SIZE / 2, 'c')), 0);
+	cache_check(&stats, 0, 1, 1);
+
+	assert_rc_equal(crt_bulk_cache_invalidate(NULL, 0), 0);
+	cache_check(&stats, 0, 0, BULK_CACHE_SIZE);
+	assert_int_equal(munmap(buf, BULK_BUF_SIZE), 0);
+}
+
+static int
+init_tests(void **state)
+{
+	crt_init_options_t	opts = {0};
+	int			rc;
+
+	d_setenv("D_BULK_CACHE_SIZE", "4", 1);
+
+	/* the cache counters are read back from the telemetry */
+	rc = d_tm_init(getpid(), D_TM_SHARED_MEMORY_SIZE, 0);
+	if (rc != 0)
+		return rc;
+
+	opts.cio_provider    = getenv("D_PROVIDER") ? : "ofi+tcp";
+	opts.cio_interface   = getenv("D_INTERFACE") ? : "lo";
+	opts.cio_domain      = getenv("D_DOMAIN") ? : "lo";
+	opts.cio_use_sensors = 1;
+
+	rc = crt_init_opt(NULL, 0, &opts);
+	if (rc != 0)
+		return rc;
+
+	return crt_context_create(&bulk_ctx);
+}
+
+static int
+fini_tests(void **state)
+{
+	int rc;
+
+	rc = crt_context_destroy(bulk_ctx, false);
+	if (rc != 0)
+		return rc;
+
+	rc = crt_finalize();
+	d_tm_fini();
+	return rc;
+}
+
+int
+main(int argc, char *argv[])
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test(test_bulk_cache_reuse),
+	    cmocka_unit_test(test_bulk_cache_remap),
+	    cmocka_unit_test(test_bulk_cache_evict),
+	};
+
+	d_register_alt_assert(mock_assert);
+
+	return cmocka_run_group_tests_name("utest_bulk", tests, init_tests, fini_tests);
+}
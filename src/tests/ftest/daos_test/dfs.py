@@ -67,3 +67,19 @@ class DaosCoreTestDfs(DaosCoreBase):
         :avocado: tags=DaosCoreTestDfs,test_daos_dfs_sys
         """
         self.run_subtest(os.path.join(self.bin, "dfs_test"))
+
+    def test_daos_dfs_ds3(self):
+        """Run the DAOS S3 unit tests.
+
+        Test Description:
+            Run dfs_test -d
+
+        Use cases:
+            DAOS S3 composed objects of multipart uploads
+
+        :avocado: tags=all,pr,full_regression
+        :avocado: tags=hw,large
+        :avocado: tags=daos_test,dfs_test,dfs,ds3
+        :avocado: tags=DaosCoreTestDfs,test_daos_dfs_ds3
+        """
+        self.run_subtest(os.path.join(self.bin, "dfs_test"))
@@ -5,11 +5,12 @@
   SPDX-License-Identifier: BSD-2-Clause-Patent
 """
 import hashlib
+import random
 
 from apricot import TestWithServers
 from dfuse_utils import get_dfuse, start_dfuse
 from io_utilities import DirectoryTreeCommand
-from pydaos.torch import Dataset, IterableDataset
+from pydaos.torch import Dataset, IterableDataset, pack_dataset
 from run_utils import run_remote
 from torch.utils.data import DataLoader
 
@@ -185,6 +186,158 @@ class PytorchDatasetsTest(TestWithServers):
             for batch_size in batch_sizes:
                 self._test_dataloader(dataset, expected, batch_size, procs)
 
+    def test_packed_dataset(self):
+        """Test the datasets on samples packed by pack_dataset.
+
+        Test Description: Ensure that the samples read from a packed dataset are the ones that
+        were packed, directly and with DataLoader.
+
+        :avocado: tags=all,full_regression
+        :avocado: tags=vm
+        :avocado: tags=dfuse,pytorch
+        :avocado: tags=PytorchDatasetsTest,test_packed_dataset
+        """
+        pool = self.get_pool()
+        container = self.get_container(pool)
+        dfuse = get_dfuse(self, self.hostlist_clients)
+        start_dfuse(self, dfuse, pool, container)
+
+        root_dir = dfuse.mount_dir.value
+
+        height = self.params.get("tree_height", "/run/packed_dataset/*")
+        subdirs = self.params.get("subdirs", "/run/packed_dataset/*")
+        files_per_node = self.params.get("files_per_node", "/run/packed_dataset/*")
+        file_size = self.params.get("file_size", "/run/packed_dataset/*", 4096)
+        pack_size = self.params.get("pack_size", "/run/packed_dataset/*")
+        batch_sizes = self.params.get("batch_size", "/run/packed_dataset/*")
+        processes = self.params.get("processes", "/run/packed_dataset/*")
+
+        self._create_test_files(root_dir, height, subdirs, files_per_node, file_size, file_size)
+
+        expected = self._get_test_files_hashmap(root_dir, self.hostlist_clients)
+        names = self._get_test_files_names(root_dir, self.hostlist_clients)
+
+        count = pack_dataset(pool.identifier, container.identifier, src="/", dst="/packed",
+                             pack_size=pack_size)
+        if count != len(names):
+            self.fail(f"{count} samples packed instead of {len(names)}")
+
+        # the samples are stored back to back, a pack file only holds the ones that fit
+        per_pack = pack_size // file_size
+        packs = self._get_test_files_names(f"{root_dir}/packed", self.hostlist_clients)
+        nr_packs = len([name for name in packs if name.startswith("pack.")])
+        if nr_packs != (count + per_pack - 1) // per_pack:
+            self.fail(f"{count} samples of {file_size} bytes stored in {nr_packs} packs of "
+                      f"{pack_size} bytes")
+
+        dataset = Dataset(pool.identifier, container.identifier, path="/packed")
+        packed_names = set(obj[0] for obj in dataset.objects)
+        if packed_names != names:
+            self.fail(f"packed dataset lists {sorted(packed_names ^ names)} differently")
+        if self._get_dataset_hashmap(dataset) != expected:
+            self.fail("packed dataset did not fetch all samples")
+        for procs in processes:
+            for batch_size in batch_sizes:
+                self._test_dataloader(dataset, expected, batch_size, procs)
+
+        dataset = IterableDataset(pool.identifier, container.identifier, path="/packed")
+        if self._get_dataset_hashmap(dataset) != expected:
+            self.fail("packed iterable dataset did not fetch all samples")
+        for procs in processes:
+            for batch_size in batch_sizes:
+                self._test_dataloader(dataset, expected, batch_size, procs)
+
+    def test_prefetch_dataset(self):
+        """Test the datasets prefetching their batches.
+
+        Test Description: Ensure that the prefetched samples are the ones that were seeded and
+        that they are copies, still valid once their buffers are reused.
+
+        :avocado: tags=all,full_regression
+        :avocado: tags=vm
+        :avocado: tags=dfuse,pytorch
+        :avocado: tags=PytorchDatasetsTest,test_prefetch_dataset
+        """
+        pool = self.get_pool()
+        container = self.get_container(pool)
+        dfuse = get_dfuse(self, self.hostlist_clients)
+        start_dfuse(self, dfuse, pool, container)
+
+        root_dir = dfuse.mount_dir.value
+
+        height = self.params.get("tree_height", "/run/prefetch_dataset/*")
+        subdirs = self.params.get("subdirs", "/run/prefetch_dataset/*")
+        files_per_node = self.params.get("files_per_node", "/run/prefetch_dataset/*")
+        file_min_size = self.params.get("file_min_size", "/run/prefetch_dataset/*", 4096)
+        file_max_size = self.params.get("file_max_size", "/run/prefetch_dataset/*", 4096)
+        prefetch = self.params.get("prefetch", "/run/prefetch_dataset/*")
+        batch_size = self.params.get("batch_size", "/run/prefetch_dataset/*")
+        processes = self.params.get("processes", "/run/prefetch_dataset/*")
+
+        self._create_test_files(root_dir, height, subdirs, files_per_node,
+                                file_min_size, file_max_size)
+
+        expected = self._get_test_files_hashmap(root_dir, self.hostlist_clients)
+
+        with Dataset(pool.identifier, container.identifier, prefetch=prefetch) as dataset:
+            order = list(range(len(dataset)))
+            random.shuffle(order)
+            dataset.set_epoch_order(order, batch_size)
+
+            # the samples of all the batches are kept while the buffers are reused
+            samples = []
+            for i in range(0, len(order), batch_size):
+                samples.extend(dataset.__getitems__(order[i:i + batch_size]))
+            self._check_prefetched(samples, expected, "dataset")
+
+            # the samples are pickled by the DataLoader workers
+            for procs in processes:
+                dataset.set_epoch_order(order, batch_size)
+                loader = DataLoader(dataset,
+                                    batch_size=batch_size,
+                                    sampler=order,
+                                    num_workers=procs,
+                                    collate_fn=lambda x: x,
+                                    worker_init_fn=dataset.worker_init,
+                                    drop_last=False)
+                self._check_prefetched([s for batch in loader for s in batch], expected,
+                                       f"DataLoader with nproc={procs}")
+
+        with IterableDataset(pool.identifier, container.identifier, batch_size=batch_size,
+                             prefetch=prefetch) as dataset:
+            self._check_prefetched(list(dataset), expected, "iterable dataset")
+
+        # views of the reused buffers only on request, valid while they are referenced
+        with IterableDataset(pool.identifier, container.identifier, batch_size=batch_size,
+                             prefetch=prefetch, prefetch_zero_copy=True) as dataset:
+            samples = list(dataset)
+            if not all(isinstance(sample, memoryview) for sample in samples):
+                self.fail("zero-copy prefetch did not return memoryview samples")
+            self._check_prefetched([bytes(sample) for sample in samples], expected,
+                                   "zero-copy iterable dataset")
+
+    def _check_prefetched(self, samples, expected, what):
+        """Check that the prefetched samples are bytes copies of the expected ones"""
+
+        if not all(isinstance(sample, bytes) for sample in samples):
+            self.fail(f"{what} did not return bytes samples")
+        actual = {}
+        for sample in samples:
+            h = hashlib.md5(sample).hexdigest()  # nosec
+            actual[h] = actual.get(h, 0) + 1
+        if actual != expected:
+            self.fail(f"{what} did not prefetch all samples")
+
+    @staticmethod
+    def _get_dataset_hashmap(dataset):
+        """Map all samples of a dataset to their md5 hash"""
+
+        actual = {}
+        for content in dataset:
+            h = hashlib.md5(content).hexdigest()  # nosec
+            actual[h] = actual.get(h, 0) + 1
+        return actual
+
     def _test_dataloader(self, dataset, expected, batch_size, processes):
         """With the given dataset and parameters load all samples using DataLoader
         and check if all expected samples are fetched"""
@@ -229,6 +382,17 @@ class PytorchDatasetsTest(TestWithServers):
             self.fail(
                 f"Error running '{dir_tree.command}' for '{path}' on {result.failed_hosts}")
 
+    def _get_test_files_names(self, root_dir, hostlist):
+        """Get the paths relative to the root of all files in the directory tree"""
+
+        cmd = f'find {root_dir} -type f -printf "%P\\n"'
+        result = run_remote(self.log, hostlist, cmd)
+
+        if not result.passed:
+            self.fail(f'"{cmd}" failed on {result.failed_hosts}')
+
+        return set(line.strip() for line in result.output[0].stdout if line.strip())
+
     def _get_test_files_hashmap(self, root_dir, hostlist):
         """Map all files in the directory tree to their md5 hash"""
 
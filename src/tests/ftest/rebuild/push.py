@@ -0,0 +1,85 @@
+"""
+  (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+"""
+from rebuild_test_base import RebuildTestBase
+
+
+class RbldPush(RebuildTestBase):
+    """Test class for push-based rebuild.
+
+    Test Class Description:
+        This class contains tests for rebuilding replicated objects with
+        D_MIGRATE_PUSH set on the engines, including punched objects and
+        punched records.
+
+    :avocado: recursive
+    """
+
+    def __init__(self, *args, **kwargs):
+        """Initialize a RbldPush object."""
+        super().__init__(*args, **kwargs)
+        self.punch_type = None
+
+    def create_test_container(self):
+        """Create a container, write objects and punch half of them before rebuild."""
+        super().create_test_container()
+        if self.punch_type == "object":
+            indices = [
+                index for index in range(self.container.object_qty.value) if index % 2]
+            self.assertEqual(
+                self.container.punch_objects(indices), len(indices),
+                "Error punching objects before rebuild")
+        elif self.punch_type == "record":
+            indices = [
+                index for index in range(self.container.record_qty.value) if index % 2]
+            self.assertEqual(
+                self.container.punch_records(indices),
+                len(indices) * self.container.object_qty.value,
+                "Error punching records before rebuild")
+
+    def update_pool_verify(self):
+        """Every pushed object is accounted once in the rebuild progress."""
+        super().update_pool_verify()
+        self.rebuild_checks["rs_obj_nr"] = ">0"
+
+    def test_rebuild_push(self):
+        """Test Description:
+            Rebuild replicated objects with push-based rebuild. Rebuild should
+            complete successfully and all of the data should be accessible.
+
+        :avocado: tags=all,full_regression
+        :avocado: tags=vm
+        :avocado: tags=rebuild
+        :avocado: tags=RbldPush,test_rebuild_push
+        """
+        self.execute_rebuild_test()
+
+    def test_rebuild_push_punched_objects(self):
+        """Test Description:
+            Punch half of the objects before a push-based rebuild. Rebuild
+            should complete successfully, the punched objects should not come
+            back and the remaining data should be accessible.
+
+        :avocado: tags=all,full_regression
+        :avocado: tags=vm
+        :avocado: tags=rebuild
+        :avocado: tags=RbldPush,test_rebuild_push_punched_objects
+        """
+        self.punch_type = "object"
+        self.execute_rebuild_test()
+
+    def test_rebuild_push_punched_records(self):
+        """Test Description:
+            Punch half of the records of each object before a push-based
+            rebuild. Rebuild should complete successfully, the punched records
+            should not come back and the remaining data should be accessible.
+
+        :avocado: tags=all,full_regression
+        :avocado: tags=vm
+        :avocado: tags=rebuild
+        :avocado: tags=RbldPush,test_rebuild_push_punched_records
+        """
+        self.punch_type = "record"
+        self.execute_rebuild_test()
@@ -0,0 +1,60 @@
+"""
+  (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+"""
+from rebuild_test_base import RebuildTestBase
+from telemetry_utils import TelemetryUtils
+
+
+class RbldQos(RebuildTestBase):
+    """Test class for the rebuild & aggregation QoS controller.
+
+    Test Class Description:
+        This class contains tests for throttling rebuild with
+        DAOS_SCHED_QOS_LATENCY set on the engines while the container is read.
+
+    :avocado: recursive
+    """
+
+    QOS_METRICS = ["engine_sched_qos_ratio", "engine_sched_qos_latency"]
+
+    def __init__(self, *args, **kwargs):
+        """Initialize a RbldQos object."""
+        super().__init__(*args, **kwargs)
+        self.qos_values = {name: [] for name in self.QOS_METRICS}
+
+    def execute_during_rebuild(self):
+        """Read the container while rebuilding and sample the QoS metrics."""
+        telemetry = TelemetryUtils(self.get_dmg_command(), self.server_managers[0].hosts)
+        for _ in range(self.params.get("read_loops", "/run/qos/*", 10)):
+            self.verify_container_data()
+            info = telemetry.get_metrics(",".join(self.QOS_METRICS))
+            for host_info in info.values():
+                for name in self.QOS_METRICS:
+                    for metric in host_info.get(name, {}).get("metrics", []):
+                        self.qos_values[name].append(metric["value"])
+
+    def test_rebuild_qos(self):
+        """Test Description:
+            Rebuild with a foreground latency target lower than the latency
+            of the reads issued during rebuild. The latency measured from the
+            arrival of the reads should be reported, the CPU percentage of
+            rebuild should stay within its bounds and rebuild should complete
+            with all of the data accessible.
+
+        :avocado: tags=all,full_regression
+        :avocado: tags=vm
+        :avocado: tags=rebuild
+        :avocado: tags=RbldQos,test_rebuild_qos
+        """
+        self.execute_rebuild_test()
+
+        self.log.info("QoS metrics during rebuild: %s", self.qos_values)
+        self.assertTrue(
+            self.qos_values["engine_sched_qos_ratio"], "No QoS ratio reported during rebuild")
+        for ratio in self.qos_values["engine_sched_qos_ratio"]:
+            self.assertTrue(5 <= ratio <= 90, "QoS ratio {} out of [5, 90]".format(ratio))
+        self.assertTrue(
+            any(lat > 0 for lat in self.qos_values["engine_sched_qos_latency"]),
+            "No foreground latency sampled during rebuild")
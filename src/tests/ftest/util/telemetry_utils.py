@@ -99,6 +99,7 @@ class TelemetryUtils():
         "engine_pool_ops_key_query",
         "engine_pool_ops_key2anchor",
         "engine_pool_ops_migrate",
+        "engine_pool_ops_migrate_push",
         "engine_pool_ops_obj_enum",
         "engine_pool_ops_obj_punch",
         "engine_pool_ops_obj_sync",
@@ -279,6 +280,10 @@ class TelemetryUtils():
         _gen_stats_metrics("engine_io_ops_migrate_active")
     ENGINE_IO_OPS_MIGRATE_LATENCY_METRICS = \
         _gen_stats_metrics("engine_io_ops_migrate_latency")
+    ENGINE_IO_OPS_MIGRATE_PUSH_ACTIVE_METRICS = \
+        _gen_stats_metrics("engine_io_ops_migrate_push_active")
+    ENGINE_IO_OPS_MIGRATE_PUSH_LATENCY_METRICS = \
+        _gen_stats_metrics("engine_io_ops_migrate_push_latency")
     ENGINE_IO_OPS_OBJ_COLL_PUNCH_ACTIVE_METRICS = \
         _gen_stats_metrics("engine_io_ops_obj_coll_punch_active")
     ENGINE_IO_OPS_OBJ_COLL_PUNCH_LATENCY_METRICS = \
@@ -352,6 +357,8 @@ class TelemetryUtils():
         ENGINE_IO_OPS_KEY2ANCHOR_LATENCY_METRICS +\
         ENGINE_IO_OPS_MIGRATE_ACTIVE_METRICS +\
         ENGINE_IO_OPS_MIGRATE_LATENCY_METRICS +\
+        ENGINE_IO_OPS_MIGRATE_PUSH_ACTIVE_METRICS +\
+        ENGINE_IO_OPS_MIGRATE_PUSH_LATENCY_METRICS +\
         ENGINE_IO_OPS_OBJ_COLL_PUNCH_ACTIVE_METRICS +\
         ENGINE_IO_OPS_OBJ_COLL_PUNCH_LATENCY_METRICS +\
         ENGINE_IO_OPS_OBJ_COLL_QUERY_ACTIVE_METRICS +\
@@ -915,6 +922,7 @@ class ClientTelemetryUtils(TelemetryUtils):
         "client_pool_ops_key2anchor",
         "client_pool_ops_key_query",
         "client_pool_ops_migrate",
+        "client_pool_ops_migrate_push",
         "client_pool_ops_obj_coll_punch",
         "client_pool_ops_obj_coll_query",
         "client_pool_ops_obj_enum",
@@ -978,6 +986,10 @@ class ClientTelemetryUtils(TelemetryUtils):
         _gen_stats_metrics("client_io_ops_migrate_active")
     CLIENT_IO_OPS_MIGRATE_LATENCY_METRICS = \
         _gen_stats_metrics("client_io_ops_migrate_latency")
+    CLIENT_IO_OPS_MIGRATE_PUSH_ACTIVE_METRICS = \
+        _gen_stats_metrics("client_io_ops_migrate_push_active")
+    CLIENT_IO_OPS_MIGRATE_PUSH_LATENCY_METRICS = \
+        _gen_stats_metrics("client_io_ops_migrate_push_latency")
     CLIENT_IO_OPS_OBJ_COLL_PUNCH_ACTIVE_METRICS = \
         _gen_stats_metrics("client_io_ops_obj_coll_punch_active")
     CLIENT_IO_OPS_OBJ_COLL_PUNCH_LATENCY_METRICS = \
@@ -1041,6 +1053,8 @@ class ClientTelemetryUtils(TelemetryUtils):
         CLIENT_IO_OPS_KEY_QUERY_LATENCY_METRICS +\
         CLIENT_IO_OPS_MIGRATE_ACTIVE_METRICS +\
         CLIENT_IO_OPS_MIGRATE_LATENCY_METRICS +\
+        CLIENT_IO_OPS_MIGRATE_PUSH_ACTIVE_METRICS +\
+        CLIENT_IO_OPS_MIGRATE_PUSH_LATENCY_METRICS +\
         CLIENT_IO_OPS_OBJ_COLL_PUNCH_ACTIVE_METRICS +\
         CLIENT_IO_OPS_OBJ_COLL_PUNCH_LATENCY_METRICS +\
         CLIENT_IO_OPS_OBJ_COLL_QUERY_ACTIVE_METRICS +\
@@ -58,6 +58,9 @@ class DFuse():
         self._sp = None
         self.log_flush = False
         self.log_mask = None
+        # Size of the write-back buffers in MiB, and fault injection config file
+        self.write_buffer = None
+        self.fi_config = None
         self.log_file = None
         self._ro = ro
         self.dump_h = dump_h
@@ -102,6 +105,8 @@ class DFuse():
         my_env['DAOS_AGENT_DRPC_DIR'] = self._daos.agent_dir
         if self.log_mask:
             my_env['D_LOG_MASK'] = self.log_mask
+        if self.fi_config:
+            my_env['D_FI_CONFIG'] = self.fi_config
         if self.conf.args.dtx == 'yes':
             my_env['DFS_USE_DTX'] = '1'
 
@@ -134,6 +139,9 @@ class DFuse():
             if not self.wbcache:
                 cmd.append('--disable-wb-cache')
 
+        if self.write_buffer:
+            cmd.extend(['--write-buffer', str(self.write_buffer)])
+
         if self.dump_h:
             cmd.extend(['--dump-handles', self.file_h])
         if self.read_h:
@@ -27,6 +27,7 @@ from os.path import join
 
 import tabulate
 import xattr
+import yaml
 
 from .base import NLTestFail, set_active_test
 from .client import (check_dir_attr, check_file_attr, create_cont, destroy_container, run_daos_cmd,
@@ -1001,6 +1002,41 @@ class PosixTests():
 
         assert len(expected_keys) == 0, 'Expected key not found'
 
+    def test_wb_error(self):
+        """Test that a failed write-back write is reported by fsync
+
+        getattr waits for the write-back writes but must leave the error for the next fsync, which
+        reports it once.  Write-back writes are made to fail with fault injection.
+        """
+        faults = {'fault_config': [{'id': 102,
+                                    'probability_x': 1,
+                                    'probability_y': 1,
+                                    'max_faults': 1}]}
+
+        with tempfile.NamedTemporaryFile(prefix='fi_', suffix='.yaml') as fi_file:
+            fi_file.write(yaml.dump(faults, encoding='utf=8'))
+            fi_file.flush()
+
+            dfuse = DFuse(self.server, self.conf, container=self.container, caching=True)
+            dfuse.write_buffer = 1
+            dfuse.fi_config = fi_file.name
+            dfuse.start(v_hint='wb_error')
+            try:
+                ofd = os.open(join(dfuse.dir, 'wb_file'), os.O_CREAT | os.O_RDWR)
+                os.write(ofd, b'a' * 4096)
+                print(os.fstat(ofd))
+                try:
+                    os.fsync(ofd)
+                    assert False, 'fsync should report the write-back failure'
+                except OSError as error:
+                    assert error.errno == errno.EIO, error
+                # The error is reported once.
+                os.fsync(ofd)
+                os.close(ofd)
+            finally:
+                if dfuse.stop():
+                    self.fatal_errors = True
+
     @needs_dfuse_with_opt(wbcache=True, caching_variants=[True])
     def test_stat_before_open(self):
         """Run open/close in a loop on the same file
@@ -2547,6 +2583,44 @@ class PosixTests():
         self.server.run_daos_client_cmd_pil4dfs(['cp', '/usr/bin/mkdir', file6])
         self.server.run_daos_client_cmd_pil4dfs(['file', file6])
 
+    def test_pil4dfs_async_unlink_fork(self):
+        """Fork while files are removed asynchronously by pil4dfs
+
+        A thread removes files while the main one forks, the children must not wait for the
+        removals queued by their parent.
+        """
+        script = '''
+import os
+import signal
+import threading
+
+NR_FILES = 500
+os.mkdir('dir')
+for i in range(NR_FILES):
+    with open(f'dir/file_{i}', 'w') as fd:
+        fd.write('Hello World!')
+
+remover = threading.Thread(target=lambda: [os.unlink(f'dir/file_{i}') for i in range(NR_FILES)])
+remover.start()
+forks = 0
+while remover.is_alive() or forks == 0:
+    pid = os.fork()
+    if pid == 0:
+        signal.alarm(60)
+        os.listdir('dir')
+        os._exit(0)
+    _, status = os.waitpid(pid, 0)
+    assert os.waitstatus_to_exitcode(status) == 0, status
+    forks += 1
+remover.join()
+
+assert os.listdir('dir') == [], os.listdir('dir')
+print(f'{forks} forks')
+'''
+        self.server.run_daos_client_cmd_pil4dfs(['python3', '-c', script],
+                                                container=self.container,
+                                                env={'D_IL_ASYNC_META_THREADS': '4'})
+
     @needs_dfuse_with_opt(caching_variants=[False], ro=True)
     def test_mount_ro(self):
         """Check that mounting read-only does not allow write access"""
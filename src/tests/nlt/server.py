@@ -588,7 +588,8 @@ class DaosServer():
             rc.returncode = 0
         assert rc.returncode == 0, rc
 
-    def run_daos_client_cmd_pil4dfs(self, cmd, check=True, container=None, report=True):
+    def run_daos_client_cmd_pil4dfs(self, cmd, check=True, container=None, report=True,
+                                    env=None):
         """Run a DAOS client with libpil4dfs.so
 
         Run a command, returning what subprocess.run() would.
@@ -597,6 +598,8 @@ class DaosServer():
         directory as a "mount point" and run the command from that directory so that paths can be
         relative.
 
+        Variables of env are added to the environment of the command.
+
         Looks like valgrind and libpil4dfs.so do not work together sometime. Disable valgrind at
         this moment. Will revisit this issue later.
         """
@@ -632,6 +635,9 @@ class DaosServer():
         if self.conf.args.client_debug:
             cmd_env['D_LOG_MASK'] = self.conf.args.client_debug
 
+        if env is not None:
+            cmd_env.update(env)
+
         print('Run command: ')
         print(cmd)
         rc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, cwd=cwd,
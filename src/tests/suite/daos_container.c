@@ -1046,6 +1046,86 @@ co_create_label_rf_async_retry(void **state)
 	print_message("success\n");
 }
 
+static void
+co_diff_update(daos_handle_t coh, daos_obj_id_t oid, test_arg_t *arg)
+{
+	struct ioreq req;
+	uint64_t     val = oid.lo;
+
+	ioreq_init(&req, coh, oid, DAOS_IOD_SINGLE, arg);
+	insert_single("dkey", "akey", 0, &val, sizeof(val), DAOS_TX_NONE, &req);
+	ioreq_fini(&req);
+}
+
+static void
+co_diff(void **state)
+{
+	test_arg_t            *arg = *state;
+	const char            *label = "co_diff_cont";
+	daos_cont_diff_entry_t ents[8];
+	daos_obj_id_t          oids[3];
+	int                    found[3] = {0};
+	daos_pool_info_t       info     = {0};
+	daos_epoch_range_t     epr;
+	daos_anchor_t          anchor;
+	daos_handle_t          coh;
+	uint32_t               nr;
+	uint32_t               tgt;
+	uint32_t               i;
+	uint32_t               j;
+	int                    rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = daos_cont_create_with_label(arg->pool.poh, label, NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_open(arg->pool.poh, label, DAOS_COO_RW, &coh, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_pool_query(arg->pool.poh, NULL, &info, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < ARRAY_SIZE(oids); i++)
+		oids[i] = daos_test_oid_gen(coh, OC_S1, 0, 0, arg->myrank);
+
+	/* oids[0] is only updated out of the range, oids[1] only in it, oids[2] in both */
+	co_diff_update(coh, oids[0], arg);
+	co_diff_update(coh, oids[2], arg);
+	rc = daos_cont_create_snap(coh, &epr.epr_lo, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	co_diff_update(coh, oids[1], arg);
+	co_diff_update(coh, oids[2], arg);
+	rc = daos_cont_create_snap(coh, &epr.epr_hi, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	co_diff_update(coh, oids[0], arg);
+	co_diff_update(coh, oids[2], arg);
+
+	print_message("listing objects modified in " DF_X64 "-" DF_X64 " on %u targets\n",
+		      epr.epr_lo, epr.epr_hi, info.pi_ntargets);
+	for (tgt = 0; tgt < info.pi_ntargets; tgt++) {
+		memset(&anchor, 0, sizeof(anchor));
+		while (!daos_anchor_is_eof(&anchor)) {
+			nr = ARRAY_SIZE(ents);
+			rc = daos_cont_diff(coh, &epr, tgt, &anchor, &nr, ents, NULL);
+			assert_rc_equal(rc, 0);
+			for (i = 0; i < nr; i++) {
+				for (j = 0; j < ARRAY_SIZE(oids); j++) {
+					if (daos_oid_cmp(ents[i].de_oid, oids[j]) == 0)
+						found[j]++;
+				}
+			}
+		}
+	}
+	assert_int_equal(found[0], 0);
+	assert_int_equal(found[1], 1);
+	assert_int_equal(found[2], 1);
+
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_destroy(arg->pool.poh, label, 1 /* force */, NULL);
+	assert_rc_equal(rc, 0);
+}
+
 static void
 co_acl_get(test_arg_t *arg, struct daos_acl *exp_acl,
 	   const char *exp_owner, const char *exp_owner_grp)
@@ -4267,6 +4347,7 @@ static const struct CMUnitTest co_tests[] = {
      test_case_teardown},
     {"CONT38: retry async cont create with label and RF", co_create_label_rf_async_retry, NULL,
      test_case_teardown},
+    {"CONT39: list objects modified between snapshots", co_diff, NULL, test_case_teardown},
 };
 
 int
@@ -16,6 +16,7 @@
 #include <sys/wait.h>
 
 #include "daos_test.h"
+#include "daos_iotest.h"
 #include <daos_prop.h>
 #include <daos/pool.h>
 #include <daos/mgmt.h>
@@ -311,6 +312,85 @@ inc_reint5(void **state)
 	ir_race(arg, false);
 }
 
+#define IR_OBJ_NR 8
+
+static void
+ir_obj_update(daos_handle_t coh, daos_obj_id_t oid, const char *dkey, const char *value,
+	      test_arg_t *arg)
+{
+	struct ioreq req;
+
+	ioreq_init(&req, coh, oid, DAOS_IOD_ARRAY, arg);
+	insert_single(dkey, "a_key", 0, (void *)value, strlen(value) + 1, DAOS_TX_NONE, &req);
+	ioreq_fini(&req);
+}
+
+static void
+ir_obj_verify(daos_handle_t coh, daos_obj_id_t oid, const char *dkey, const char *value,
+	      test_arg_t *arg)
+{
+	struct ioreq req;
+	char         buf[32] = {0};
+	int          rc;
+
+	ioreq_init(&req, coh, oid, DAOS_IOD_ARRAY, arg);
+	lookup_single(dkey, "a_key", 0, buf, sizeof(buf), DAOS_TX_NONE, &req);
+	assert_string_equal(buf, value);
+	ioreq_fini(&req);
+
+	/* All of the replicas, including the reintegrated one, must be consistent */
+	rc = daos_obj_verify(coh, oid, DAOS_EPOCH_MAX);
+	assert_rc_equal(rc, 0);
+}
+
+static void
+inc_reint6(void **state)
+{
+	test_arg_t       *arg  = *state;
+	struct test_pool *pool = &arg->pool;
+	struct test_cont  cont = {0};
+	daos_obj_id_t     oids[IR_OBJ_NR];
+	int               rc;
+	int               i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	if (!test_runable(arg, 4))
+		return;
+
+	print_message("INC_REINT6: objects unchanged while the rank was out are kept\n");
+
+	ir_cont_create(arg, &cont);
+
+	for (i = 0; i < IR_OBJ_NR; i++) {
+		oids[i] = daos_test_oid_gen(cont.coh, OC_RP_3G1, 0, 0, arg->myrank);
+		oids[i] = dts_oid_set_rank(oids[i], 1);
+		ir_obj_update(cont.coh, oids[i], "dkey_0", "before", arg);
+	}
+
+	ir_rank_exclude(arg, 1);
+
+	/* Only half of the objects are modified, the others are skipped by the reintegration */
+	for (i = 0; i < IR_OBJ_NR; i += 2) {
+		ir_obj_update(cont.coh, oids[i], "dkey_0", "after", arg);
+		ir_obj_update(cont.coh, oids[i], "dkey_1", "after", arg);
+	}
+
+	print_message("Incrementally reintegrate rank 1 for pool " DF_UUID "\n",
+		      DP_UUID(pool->pool_uuid));
+
+	rc = ir_rank_reint(arg, 1, true);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < IR_OBJ_NR; i++) {
+		ir_obj_verify(cont.coh, oids[i], "dkey_0", i % 2 == 0 ? "after" : "before", arg);
+		if (i % 2 == 0)
+			ir_obj_verify(cont.coh, oids[i], "dkey_1", "after", arg);
+	}
+
+	ir_cont_destroy(arg, &cont);
+}
+
 static int
 ir_sub_setup(void **state)
 {
@@ -354,6 +434,8 @@ static const struct CMUnitTest ir_tests[] = {
 	 inc_reint4, ir_sub_setup, ir_sub_teardown},
 	{"INC_REINT5: race between container recovery and container destroy",
 	 inc_reint5, ir_sub_setup, ir_sub_teardown},
+	{"INC_REINT6: objects unchanged while the rank was out are kept",
+	 inc_reint6, ir_sub_setup, ir_sub_teardown},
 };
 /* clang-format on */
 
@@ -2009,6 +2009,88 @@ simple_pipeline_dfs(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+#define CONT_PIPELINE_NR_OBJS	3
+
+static void
+cont_pipeline(void **state)
+{
+	test_arg_t		*arg = *state;
+	daos_obj_id_t		oid;
+	daos_handle_t		coh, oh;
+	daos_pipeline_t		pipeline3;
+	static char		*fields[NR_IODS] = {"Owner", "Species", "Sex", "Age"};
+	daos_iod_t		iods[NR_IODS];
+	d_sg_list_t		sgl_aggr;
+	d_iov_t			iov_aggr;
+	double			sum_age;
+	daos_pipeline_stats_t	stats = {0};
+	uint32_t		i;
+	int			rc;
+
+	skip_if_pipeline_disabled();
+
+	rc = daos_cont_create_with_label(arg->pool.poh, "cont_pipeline", NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_cont_open(arg->pool.poh, "cont_pipeline", DAOS_COO_RW, &coh, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	/** the same records in several objects */
+	for (i = 0; i < CONT_PIPELINE_NR_OBJS; i++) {
+		oid.hi = 0;
+		oid.lo = 4 + i;
+		daos_obj_generate_oid(coh, &oid, DAOS_OT_MULTI_LEXICAL, i == 0 ? OC_SX : OC_S1,
+				      0, 0);
+
+		rc = daos_obj_open(coh, oid, DAOS_OO_RW, &oh, NULL);
+		assert_rc_equal(rc, 0);
+		insert_simple_records(oh, fields);
+		rc = daos_obj_close(oh, NULL);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < NR_IODS; i++) {
+		iods[i].iod_nr    = 1;
+		iods[i].iod_size  = STRING_MAX_LEN;
+		iods[i].iod_recxs = NULL;
+		iods[i].iod_type  = DAOS_IOD_SINGLE;
+		d_iov_set(&iods[i].iod_name, (void *)fields[i], strlen(fields[i]));
+	}
+	d_iov_set(&iov_aggr, &sum_age, sizeof(sum_age));
+	sgl_aggr.sg_nr     = 1;
+	sgl_aggr.sg_nr_out = 0;
+	sgl_aggr.sg_iovs   = &iov_aggr;
+
+	/** FILTER "Owner == Benny", AGGREGATE "SUM(age)" */
+	daos_pipeline_init(&pipeline3);
+	build_simple_pipeline_three(&pipeline3);
+	rc = daos_pipeline_check(&pipeline3);
+	assert_rc_equal(rc, 0);
+
+	print_message("filtering container by (Owner=Benny), aggregating by SUM(age):\n");
+	rc = daos_pipeline_run_cont(coh, &pipeline3, 0, NR_IODS, iods, &sgl_aggr, &stats, NULL);
+	assert_rc_equal(rc, 0);
+	print_message("\tSUM(age)=%f, %zu objects and %zu dkeys scanned\n", sum_age,
+		      stats.nr_objs, stats.nr_dkeys);
+	/** Benny's pets are 1 and 7 years old */
+	assert_int_equal(sgl_aggr.sg_nr_out, 1);
+	assert_true(sum_age == 8.0 * CONT_PIPELINE_NR_OBJS);
+	assert_true(stats.nr_objs >= CONT_PIPELINE_NR_OBJS);
+
+	/** records are only returned by daos_pipeline_run() */
+	sgl_aggr.sg_nr = 0;
+	rc = daos_pipeline_run_cont(coh, &pipeline3, 0, NR_IODS, iods, &sgl_aggr, NULL, NULL);
+	assert_rc_equal(rc, -DER_INVAL);
+
+	rc = free_pipeline(&pipeline3);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_destroy(arg->pool.poh, "cont_pipeline", 0, NULL);
+	assert_rc_equal(rc, 0);
+}
+
 static const struct CMUnitTest pipeline_tests[] = {
 	{"DAOS_PIPELINE1: Testing daos_pipeline_check",
 	 check_pipelines, async_disable, NULL},
@@ -2018,6 +2100,8 @@ static const struct CMUnitTest pipeline_tests[] = {
 	 simple_pipeline_arrays, async_disable, NULL},
 	{"DAOS_PIPELINE4: Testing simple pipeline for DFS Entry",
 	 simple_pipeline_dfs, async_disable, NULL},
+	{"DAOS_PIPELINE5: Testing pipeline on a whole container",
+	 cont_pipeline, async_disable, NULL},
 };
 
 int
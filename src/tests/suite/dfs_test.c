@@ -20,7 +20,7 @@
  * all will be run if no test is specified. Tests will be run in order
  * so tests that kill nodes must be last.
  */
-#define TESTS "pus"
+#define TESTS "pusd"
 static const char *all_tests = TESTS;
 
 static void
@@ -34,6 +34,7 @@ print_usage(int rank)
 	print_message("dfs_test -p|--parallel\n");
 	print_message("dfs_test -u|--unit\n");
 	print_message("dfs_test -s|--sys\n");
+	print_message("dfs_test -d|--ds3\n");
 	print_message("Default <daos_tests> runs all tests\n=============\n");
 	print_message("dfs_test -t|--subtests SUBTESTS\n");
 	print_message("dfs_test -E|--exclude TESTS\n");
@@ -70,6 +71,12 @@ run_specified_tests(const char *tests, int rank, int size,
 			daos_test_print(rank, "=====================");
 			nr_failed += run_dfs_sys_unit_test(rank, size, sub_tests, sub_tests_size);
 			break;
+		case 'd':
+			daos_test_print(rank, "\n\n=================");
+			daos_test_print(rank, "DS3 unit tests..");
+			daos_test_print(rank, "=====================");
+			nr_failed += run_ds3_unit_test(rank, size, sub_tests, sub_tests_size);
+			break;
 
 		default:
 			D_ASSERT(0);
@@ -113,6 +120,7 @@ main(int argc, char **argv)
 					       {"subtests", required_argument, NULL, 't'},
 					       {"unit", no_argument, NULL, 'u'},
 					       {"sys", no_argument, NULL, 's'},
+					       {"ds3", no_argument, NULL, 'd'},
 					       {NULL, 0, NULL, 0}};
 
 	rc = daos_init();
@@ -123,7 +131,7 @@ main(int argc, char **argv)
 
 	memset(tests, 0, sizeof(tests));
 
-	while ((opt = getopt_long(argc, argv, "aE:n:pst:u", long_options, &index)) != -1) {
+	while ((opt = getopt_long(argc, argv, "adE:n:pst:u", long_options, &index)) != -1) {
 		if (strchr(all_tests, opt) != NULL) {
 			tests[ntests] = opt;
 			ntests++;
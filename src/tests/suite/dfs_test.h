@@ -23,6 +23,8 @@ int
 run_dfs_par_test(int rank, int size, int *sub_tests, int sub_tests_size);
 int
 run_dfs_sys_unit_test(int rank, int size, int *sub_tests, int sub_tests_size);
+int
+run_ds3_unit_test(int rank, int size, int *sub_tests, int sub_tests_size);
 
 static inline void
 dfs_test_share(daos_handle_t poh, daos_handle_t coh, int rank, dfs_t **dfs)
@@ -0,0 +1,413 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Unit tests of the objects of libds3 composed of the parts of a multipart upload.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include "dfs_test.h"
+#include <daos_s3.h>
+
+#define DS3_TEST_BUCKET	"ds3_test_bucket"
+#define DS3_TEST_PARTS	3
+
+/** pool and bucket handles used for all tests */
+static ds3_t		*ds3;
+static ds3_bucket_t	*ds3b;
+
+/** Sizes of the parts, the last one is shorter */
+static const daos_size_t part_sizes[DS3_TEST_PARTS] = {1048576, 1048576, 4000};
+static const uint64_t	 part_nums[DS3_TEST_PARTS]  = {1, 2, 3};
+
+/** Byte at \a off of the object written with \a seed */
+static char
+obj_byte(char seed, daos_off_t off)
+{
+	return seed + off % 251;
+}
+
+static void
+obj_check(const char *buf, char seed, daos_off_t off, daos_size_t size)
+{
+	daos_size_t i;
+
+	for (i = 0; i < size; i++)
+		if (buf[i] != obj_byte(seed, off + i))
+			fail_msg("byte " DF_U64 " differs", off + i);
+}
+
+/** Upload parts of \a part_sizes with the data of \a seed, return the object size */
+static daos_size_t
+upload_parts(const char *upload_id, const char *key, char seed)
+{
+	struct ds3_multipart_upload_info info = {0};
+	struct ds3_multipart_part_info	 part_info = {0};
+	ds3_part_t			*ds3p;
+	daos_off_t			 off = 0;
+	daos_size_t			 size;
+	daos_size_t			 i;
+	char				*buf;
+	int				 p;
+	int				 rc;
+
+	strncpy(info.upload_id, upload_id, sizeof(info.upload_id) - 1);
+	strncpy(info.key, key, sizeof(info.key) - 1);
+	info.encoded	    = "upload";
+	info.encoded_length = strlen("upload");
+	rc = ds3_upload_init(&info, DS3_TEST_BUCKET, ds3);
+	assert_int_equal(rc, 0);
+
+	for (p = 0; p < DS3_TEST_PARTS; p++) {
+		D_ALLOC(buf, part_sizes[p]);
+		assert_non_null(buf);
+		for (i = 0; i < part_sizes[p]; i++)
+			buf[i] = obj_byte(seed, off + i);
+
+		rc = ds3_part_open(DS3_TEST_BUCKET, upload_id, part_nums[p], true, &ds3p, ds3);
+		assert_int_equal(rc, 0);
+		size = part_sizes[p];
+		rc   = ds3_part_write(buf, 0, &size, ds3p, ds3, NULL);
+		assert_int_equal(rc, 0);
+		part_info.part_num	 = part_nums[p];
+		part_info.encoded	 = "part";
+		part_info.encoded_length = strlen("part");
+		rc = ds3_part_set_info(&part_info, ds3p, ds3, NULL);
+		assert_int_equal(rc, 0);
+		rc = ds3_part_close(ds3p);
+		assert_int_equal(rc, 0);
+
+		D_FREE(buf);
+		off += part_sizes[p];
+	}
+
+	return off;
+}
+
+/** Read \a size bytes at \a off of \a ds3o, return the size read */
+static daos_size_t
+obj_read(test_arg_t *arg, ds3_obj_t *ds3o, char *buf, daos_off_t off, daos_size_t size)
+{
+	daos_event_t  ev;
+	daos_event_t *evp;
+	int	      rc;
+
+	if (arg->async) {
+		rc = daos_event_init(&ev, arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	rc = ds3_obj_read(buf, off, &size, ds3b, ds3o, arg->async ? &ev : NULL);
+	assert_int_equal(rc, 0);
+	if (arg->async) {
+		/** Wait for completion */
+		rc = daos_eq_poll(arg->eq, 0, DAOS_EQ_WAIT, 1, &evp);
+		assert_rc_equal(rc, 1);
+		assert_ptr_equal(evp, &ev);
+		assert_int_equal(evp->ev_error, 0);
+
+		rc = daos_event_fini(&ev);
+		assert_rc_equal(rc, 0);
+	}
+
+	return size;
+}
+
+/** Whether the parts of \a upload_id are still kept in the metadata container */
+static bool
+composed_exists(test_arg_t *arg, const char *upload_id)
+{
+	dfs_t		*meta_dfs;
+	struct stat	 stbuf;
+	char		 path[128];
+	int		 rc;
+
+	rc = dfs_connect(arg->pool.pool_str, arg->group, "_METADATA", O_RDWR, NULL, &meta_dfs);
+	assert_int_equal(rc, 0);
+	snprintf(path, sizeof(path), "/composed/%s/%s", DS3_TEST_BUCKET, upload_id);
+	rc = dfs_stat(meta_dfs, NULL, path, &stbuf);
+	assert_true(rc == 0 || rc == ENOENT);
+	assert_int_equal(dfs_disconnect(meta_dfs), 0);
+
+	return rc == 0;
+}
+
+static void
+ds3_test_compose_read(void **state)
+{
+	test_arg_t	*arg = *state;
+	ds3_obj_t	*ds3o;
+	dfs_t		*dfs;
+	struct stat	 stbuf;
+	daos_size_t	 total;
+	daos_size_t	 size;
+	daos_off_t	 off;
+	char		*buf;
+	int		 rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	total = upload_parts("read", "dir/read", 'r');
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "read", DS3_TEST_PARTS, part_nums, "dir/read",
+				 &size, &ds3o, ds3b, ds3);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, total);
+
+	D_ALLOC(buf, total + 100);
+	assert_non_null(buf);
+
+	/** the whole object */
+	size = obj_read(arg, ds3o, buf, 0, total + 100);
+	assert_int_equal(size, total);
+	obj_check(buf, 'r', 0, total);
+
+	/** across the first two parts */
+	off  = part_sizes[0] - 10;
+	size = obj_read(arg, ds3o, buf, off, 20);
+	assert_int_equal(size, 20);
+	obj_check(buf, 'r', off, size);
+
+	/** the tail of the object */
+	off  = total - 100;
+	size = obj_read(arg, ds3o, buf, off, 1000);
+	assert_int_equal(size, 100);
+	obj_check(buf, 'r', off, size);
+
+	/** past the end of the object */
+	size = obj_read(arg, ds3o, buf, total + 10, 1000);
+	assert_int_equal(size, 0);
+
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+
+	/** only libds3 reads the parts, through DFS the object is an empty file */
+	rc = dfs_connect(arg->pool.pool_str, arg->group, DS3_TEST_BUCKET, O_RDONLY, NULL, &dfs);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "/dir/read", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 0);
+	assert_int_equal(dfs_disconnect(dfs), 0);
+
+	rc = ds3_obj_destroy("dir/read", ds3b);
+	assert_int_equal(rc, 0);
+	D_FREE(buf);
+}
+
+static void
+ds3_test_compose_overwrite(void **state)
+{
+	test_arg_t	*arg = *state;
+	ds3_obj_t	*ds3o;
+	daos_size_t	 size;
+	char		 buf[64];
+	int		 i;
+	int		 rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	/** a plain object */
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = obj_byte('o', i);
+	rc = ds3_obj_create("overwrite", &ds3o, ds3b);
+	assert_int_equal(rc, 0);
+	size = sizeof(buf);
+	rc   = ds3_obj_write(buf, 0, &size, ds3b, ds3o, NULL);
+	assert_int_equal(rc, 0);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+
+	/** replaced by a composed object */
+	upload_parts("overwrite1", "overwrite", 'a');
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "overwrite1", DS3_TEST_PARTS, part_nums,
+				 "overwrite", NULL, &ds3o, ds3b, ds3);
+	assert_int_equal(rc, 0);
+	size = obj_read(arg, ds3o, buf, 0, sizeof(buf));
+	assert_int_equal(size, sizeof(buf));
+	obj_check(buf, 'a', 0, size);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+	assert_true(composed_exists(arg, "overwrite1"));
+
+	/** replaced by another one, which drops the parts of the first one */
+	upload_parts("overwrite2", "overwrite", 'b');
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "overwrite2", DS3_TEST_PARTS, part_nums,
+				 "overwrite", NULL, &ds3o, ds3b, ds3);
+	assert_int_equal(rc, 0);
+	size = obj_read(arg, ds3o, buf, 0, sizeof(buf));
+	obj_check(buf, 'b', 0, size);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+	assert_false(composed_exists(arg, "overwrite1"));
+	assert_true(composed_exists(arg, "overwrite2"));
+
+	/** the object is removed before its parts */
+	rc = ds3_obj_destroy("overwrite", ds3b);
+	assert_int_equal(rc, 0);
+	rc = ds3_obj_open("overwrite", &ds3o, ds3b);
+	assert_int_equal(rc, -ENOENT);
+	assert_false(composed_exists(arg, "overwrite2"));
+
+	rc = ds3_upload_remove(DS3_TEST_BUCKET, "overwrite1", ds3);
+	assert_int_equal(rc, 0);
+	rc = ds3_upload_remove(DS3_TEST_BUCKET, "overwrite2", ds3);
+	assert_int_equal(rc, 0);
+}
+
+static void
+ds3_test_compose_failed(void **state)
+{
+	test_arg_t			*arg = *state;
+	struct ds3_multipart_part_info	 parts[DS3_TEST_PARTS];
+	ds3_obj_t			*ds3o;
+	uint32_t			 npart = DS3_TEST_PARTS;
+	char				 encoded[DS3_TEST_PARTS][16];
+	uint32_t			 marker = 0;
+	bool				 is_truncated;
+	daos_size_t			 size;
+	char				 buf[64];
+	int				 i;
+	int				 rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	for (i = 0; i < DS3_TEST_PARTS; i++) {
+		parts[i].encoded	= encoded[i];
+		parts[i].encoded_length = sizeof(encoded[i]);
+	}
+
+	/** the previous object is kept when the completion fails */
+	upload_parts("failed1", "failed", 'c');
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "failed1", DS3_TEST_PARTS, part_nums, "failed",
+				 NULL, &ds3o, ds3b, ds3);
+	assert_int_equal(rc, 0);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+
+	/** a missing part */
+	upload_parts("failed2", "failed", 'd');
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "failed2", DS3_TEST_PARTS,
+				 (uint64_t []){1, 2, 4}, "failed", NULL, &ds3o, ds3b, ds3);
+	assert_int_equal(rc, -EINVAL);
+
+	/** a key that is a directory, which fails the rename */
+	rc = ds3_obj_create("failed_dir/obj", &ds3o, ds3b);
+	assert_int_equal(rc, 0);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "failed2", DS3_TEST_PARTS, part_nums,
+				 "failed_dir", NULL, &ds3o, ds3b, ds3);
+	assert_int_not_equal(rc, 0);
+
+	rc = ds3_obj_open("failed", &ds3o, ds3b);
+	assert_int_equal(rc, 0);
+	size = obj_read(arg, ds3o, buf, 0, sizeof(buf));
+	assert_int_equal(size, sizeof(buf));
+	obj_check(buf, 'c', 0, size);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+
+	/** and the parts of the upload are back in place */
+	rc = ds3_upload_list_parts(DS3_TEST_BUCKET, "failed2", &npart, parts, &marker,
+				   &is_truncated, ds3);
+	assert_int_equal(rc, 0);
+	assert_int_equal(npart, DS3_TEST_PARTS);
+	assert_false(composed_exists(arg, "failed2"));
+
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, "failed2", DS3_TEST_PARTS, part_nums, "failed",
+				 NULL, &ds3o, ds3b, ds3);
+	assert_int_equal(rc, 0);
+	size = obj_read(arg, ds3o, buf, 0, sizeof(buf));
+	obj_check(buf, 'd', 0, size);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+
+	rc = ds3_obj_destroy("failed", ds3b);
+	assert_int_equal(rc, 0);
+	rc = ds3_obj_destroy("failed_dir/obj", ds3b);
+	assert_int_equal(rc, 0);
+	rc = ds3_upload_remove(DS3_TEST_BUCKET, "failed1", ds3);
+	assert_int_equal(rc, 0);
+	rc = ds3_upload_remove(DS3_TEST_BUCKET, "failed2", ds3);
+	assert_int_equal(rc, 0);
+}
+
+static const struct CMUnitTest ds3_unit_tests[] = {
+	{ "DS3_UNIT_TEST1: composed object read",
+	  ds3_test_compose_read, async_disable, test_case_teardown},
+	{ "DS3_UNIT_TEST2: composed object read (async)",
+	  ds3_test_compose_read, async_enable, test_case_teardown},
+	{ "DS3_UNIT_TEST3: composed object overwrite and destroy",
+	  ds3_test_compose_overwrite, async_disable, test_case_teardown},
+	{ "DS3_UNIT_TEST4: failed upload completion",
+	  ds3_test_compose_failed, async_disable, test_case_teardown},
+};
+
+static int
+ds3_setup(void **state)
+{
+	struct ds3_bucket_info	 info = {0};
+	test_arg_t		*arg;
+	int			 rc;
+
+	rc = test_setup(state, SETUP_POOL_CONNECT, true, DEFAULT_POOL_SIZE, 0, NULL);
+	if (rc != 0)
+		return rc;
+
+	arg = *state;
+	if (arg->myrank != 0)
+		return 0;
+
+	rc = ds3_connect(arg->pool.pool_str, arg->group, &ds3, NULL);
+	assert_int_equal(rc, 0);
+
+	strncpy(info.name, DS3_TEST_BUCKET, sizeof(info.name) - 1);
+	info.encoded	    = "bucket";
+	info.encoded_length = strlen("bucket");
+	rc = ds3_bucket_create(DS3_TEST_BUCKET, &info, NULL, ds3, NULL);
+	assert_int_equal(rc, 0);
+	rc = ds3_bucket_open(DS3_TEST_BUCKET, &ds3b, ds3, NULL);
+	assert_int_equal(rc, 0);
+
+	return 0;
+}
+
+static int
+ds3_teardown(void **state)
+{
+	test_arg_t	*arg = *state;
+	int		 rc;
+
+	if (arg->myrank == 0) {
+		rc = ds3_bucket_close(ds3b, NULL);
+		assert_int_equal(rc, 0);
+		rc = ds3_bucket_destroy(DS3_TEST_BUCKET, true, ds3, NULL);
+		assert_int_equal(rc, 0);
+		rc = ds3_disconnect(ds3, NULL);
+		assert_int_equal(rc, 0);
+	}
+	par_barrier(PAR_COMM_WORLD);
+
+	return test_teardown(state);
+}
+
+int
+run_ds3_unit_test(int rank, int size, int *sub_tests, int sub_tests_size)
+{
+	int rc = 0;
+	int selected = sub_tests_size;
+
+	if (sub_tests_size == 0) {
+		sub_tests = NULL;
+		selected  = ARRAY_SIZE(ds3_unit_tests);
+	}
+
+	par_barrier(PAR_COMM_WORLD);
+	rc = run_daos_sub_tests("DAOS_S3_Unit", ds3_unit_tests, ARRAY_SIZE(ds3_unit_tests),
+				sub_tests, selected, ds3_setup, ds3_teardown);
+	par_barrier(PAR_COMM_WORLD);
+	return rc;
+}
@@ -12,7 +12,9 @@
 #include <stdint.h>
 #include <getopt.h>
 #include <string.h>
+#include <strings.h>
 #include <math.h>
+#include <errno.h>
 
 #include "self_test_lib.h"
 #include "crt_utils.h"
@@ -27,6 +29,83 @@
 #define SELF_TEST_MAX_LIST_STR_LEN (1 << 16)
 #define SELF_TEST_MAX_NUM_ENDPOINTS (UINT32_MAX)
 
+/* Output formats of the results */
+enum st_output_format {
+	ST_OUTPUT_TEXT,
+	ST_OUTPUT_JSON,
+	ST_OUTPUT_CSV,
+};
+
+/* Latency distribution of a set of repetitions, in nanoseconds */
+struct st_lat_summary {
+	uint32_t num_passed;
+	uint32_t num_failed;
+	int64_t  min;
+	int64_t  p25;
+	int64_t  p50;
+	int64_t  p75;
+	int64_t  p99;
+	int64_t  p999;
+	int64_t  max;
+	int64_t  avg;
+	double   std_dev;
+};
+
+/*
+ * Returns the nearest-rank percentile \a pct of the num_passed sorted latencies
+ * starting at \a passed
+ */
+static int64_t
+st_percentile(struct st_latency *passed, uint32_t num_passed, double pct)
+{
+	uint32_t idx;
+
+	idx = (uint32_t)ceil(pct / 100.0 * num_passed);
+	if (idx > 0)
+		idx--;
+	if (idx >= num_passed)
+		idx = num_passed - 1;
+
+	return passed[idx].val;
+}
+
+/*
+ * Summarizes num_latencies latencies sorted by val, failures first (their val
+ * being -1)
+ */
+static void
+st_summarize(struct st_latency *latencies, uint32_t num_latencies, struct st_lat_summary *sum)
+{
+	struct st_latency *passed;
+	uint32_t           i;
+
+	memset(sum, 0, sizeof(*sum));
+	for (i = 0; i < num_latencies; i++)
+		if (latencies[i].cci_rc < 0)
+			sum->num_failed++;
+	sum->num_passed = num_latencies - sum->num_failed;
+	if (sum->num_passed == 0)
+		return;
+
+	passed    = &latencies[sum->num_failed];
+	sum->min  = passed[0].val;
+	sum->p25  = st_percentile(passed, sum->num_passed, 25.0);
+	sum->p50  = st_percentile(passed, sum->num_passed, 50.0);
+	sum->p75  = st_percentile(passed, sum->num_passed, 75.0);
+	sum->p99  = st_percentile(passed, sum->num_passed, 99.0);
+	sum->p999 = st_percentile(passed, sum->num_passed, 99.9);
+	sum->max  = passed[sum->num_passed - 1].val;
+
+	for (i = 0; i < sum->num_passed; i++)
+		sum->avg += passed[i].val;
+	sum->avg /= sum->num_passed;
+
+	for (i = 0; i < sum->num_passed; i++)
+		sum->std_dev += pow(passed[i].val - sum->avg, 2);
+	sum->std_dev /= sum->num_passed;
+	sum->std_dev = sqrt(sum->std_dev);
+}
+
 /*
  * Iterates over a list of failing latency measurements and prints out the
  * count of each type of failure, along with the error string and code
@@ -34,7 +113,7 @@
  * The input latencies must be sorted by cci_rc to group all same cci_rc values
  * together into contiguous blocks (-1 -1 -1, -2 -2 -2, etc.)
  */
-static void print_fail_counts(struct st_latency *latencies,
+static void print_fail_counts(FILE *out, struct st_latency *latencies,
 			      uint32_t num_latencies,
 			      const char *prefix)
 {
@@ -54,10 +133,10 @@ static void print_fail_counts(struct st_latency *latencies,
 		    latencies[local_rep].cci_rc == 0 ||
 		    latencies[last_err_idx].cci_rc !=
 		    latencies[local_rep].cci_rc) {
-			printf("%s%u: -%s (%d)\n", prefix,
-			       local_rep - last_err_idx,
-			       d_errstr(-latencies[last_err_idx].cci_rc),
-			       latencies[last_err_idx].cci_rc);
+			fprintf(out, "%s%u: -%s (%d)\n", prefix,
+				local_rep - last_err_idx,
+				d_errstr(-latencies[last_err_idx].cci_rc),
+				latencies[last_err_idx].cci_rc);
 			last_err_idx = local_rep;
 		}
 
@@ -71,17 +150,47 @@ static void print_fail_counts(struct st_latency *latencies,
 
 }
 
-static void print_results(struct st_latency *latencies,
-			  struct crt_st_start_params *test_params,
-			  int64_t test_duration_ns, int output_megabits)
+static void
+print_json_summary(FILE *out, struct st_lat_summary *sum)
+{
+	fprintf(out,
+		"\"passed\": %u, \"failed\": %u, \"latency_ns\": {\"min\": %ld, \"p25\": %ld, "
+		"\"p50\": %ld, \"p75\": %ld, \"p99\": %ld, \"p99_9\": %ld, \"max\": %ld, "
+		"\"avg\": %ld, \"std_dev\": %.2f}",
+		sum->num_passed, sum->num_failed, sum->min, sum->p25, sum->p50, sum->p75, sum->p99,
+		sum->p999, sum->max, sum->avg, sum->std_dev);
+}
+
+static void
+print_csv_row(FILE *out, struct crt_st_start_params *test_params, crt_endpoint_t *ms_endpt,
+	      struct st_latency *endpt, struct st_lat_summary *sum, double throughput,
+	      double bandwidth)
+{
+	fprintf(out, "%u:%u,", ms_endpt->ep_rank, ms_endpt->ep_tag);
+	if (endpt == NULL)
+		fprintf(out, "all,");
+	else
+		fprintf(out, "%u:%u,", endpt->rank, endpt->tag);
+	fprintf(out, "%s,%d,%s,%d,%d,%u,%u,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%.2f,",
+		crt_st_msg_type_str[test_params->send_type], test_params->send_size,
+		crt_st_msg_type_str[test_params->reply_type], test_params->reply_size,
+		test_params->max_inflight, sum->num_passed, sum->num_failed, sum->min, sum->p25,
+		sum->p50, sum->p75, sum->p99, sum->p999, sum->max, sum->avg, sum->std_dev);
+	if (endpt == NULL)
+		fprintf(out, "%.0f,%.2f\n", throughput, bandwidth / (1024.0F * 1024.0F));
+	else
+		fprintf(out, ",\n");
+}
+
+static void
+print_results(FILE *out, enum st_output_format format, struct st_latency *latencies,
+	      struct crt_st_start_params *test_params, crt_endpoint_t *ms_endpt,
+	      int64_t test_duration_ns, int output_megabits)
 {
-	uint32_t	 local_rep;
-	uint32_t	 num_failed = 0;
-	uint32_t	 num_passed = 0;
-	double		 latency_std_dev;
-	int64_t		 latency_avg;
-	double		 throughput;
-	double		 bandwidth;
+	uint32_t              local_rep;
+	struct st_lat_summary sum;
+	double                throughput;
+	double                bandwidth;
 
 	/* Check for bugs */
 	D_ASSERT(latencies != NULL);
@@ -96,41 +205,14 @@ static void print_results(struct st_latency *latencies,
 	bandwidth = throughput * (test_params->send_size +
 				  test_params->reply_size);
 
-	/* Print the results for this size */
-	if (output_megabits)
-		printf("\tRPC Bandwidth (Mbits/sec): %.2f\n",
-		       bandwidth * 8.0F / 1000000.0F);
-	else
-		printf("\tRPC Bandwidth (MB/sec): %.2f\n",
-		       bandwidth / (1024.0F * 1024.0F));
-	printf("\tRPC Throughput (RPCs/sec): %.0f\n", throughput);
-
-
-	/* Figure out how many repetitions were errors */
-	num_failed = 0;
+	/* Since failed RPCs have no latency, overwrite it with -1 so they
+	 * sort before any passing RPCs. This segments the latencies into two
+	 * sections - from [0:num_failed] will be -1, and from [num_failed:]
+	 * will be successful RPC latencies
+	 */
 	for (local_rep = 0; local_rep < test_params->rep_count; local_rep++)
-		if (latencies[local_rep].cci_rc < 0) {
-			num_failed++;
-
-			/* Since this RPC failed, overwrite its latency
-			 * with -1 so it will sort before any passing
-			 * RPCs. This segments the latencies into two
-			 * sections - from [0:num_failed] will be -1,
-			 * and from [num_failed:] will be successful RPC
-			 * latencies
-			 */
+		if (latencies[local_rep].cci_rc < 0)
 			latencies[local_rep].val = -1;
-		}
-
-	/*
-	 * Compute number successful and exit early if none worked to
-	 * guard against overflow and divide by zero later
-	 */
-	num_passed = test_params->rep_count - num_failed;
-	if (num_passed == 0) {
-		printf("\tAll RPCs for this message size failed\n");
-		return;
-	}
 
 	/*
 	 * Sort the latencies by: (in descending order of precedence)
@@ -141,44 +223,66 @@ static void print_results(struct st_latency *latencies,
 	 */
 	qsort(latencies, test_params->rep_count,
 	      sizeof(latencies[0]), st_compare_latencies_by_vals);
+	st_summarize(latencies, test_params->rep_count, &sum);
+
+	switch (format) {
+	case ST_OUTPUT_TEXT:
+		/* Print the results for this size */
+		if (output_megabits)
+			fprintf(out, "\tRPC Bandwidth (Mbits/sec): %.2f\n",
+				bandwidth * 8.0F / 1000000.0F);
+		else
+			fprintf(out, "\tRPC Bandwidth (MB/sec): %.2f\n",
+				bandwidth / (1024.0F * 1024.0F));
+		fprintf(out, "\tRPC Throughput (RPCs/sec): %.0f\n", throughput);
+
+		/* Nothing more to report if none worked */
+		if (sum.num_passed == 0) {
+			fprintf(out, "\tAll RPCs for this message size failed\n");
+			return;
+		}
 
-	/* Compute average and standard deviation of all results */
-	latency_avg = 0;
-	for (local_rep = num_failed; local_rep < test_params->rep_count;
-	     local_rep++)
-		latency_avg += latencies[local_rep].val;
-	latency_avg /= test_params->rep_count;
-
-	latency_std_dev = 0;
-	for (local_rep = num_failed; local_rep < test_params->rep_count;
-	     local_rep++)
-		latency_std_dev +=
-			pow(latencies[local_rep].val - latency_avg,
-			    2);
-	latency_std_dev /= num_passed;
-	latency_std_dev = sqrt(latency_std_dev);
-
-	/* Print latency summary results */
-	printf("\tRPC Latencies (us):\n"
-	       "\t\tMin    : %ld\n"
-	       "\t\t25th  %%: %ld\n"
-	       "\t\tMedian : %ld\n"
-	       "\t\t75th  %%: %ld\n"
-	       "\t\tMax    : %ld\n"
-	       "\t\tAverage: %ld\n"
-	       "\t\tStd Dev: %.2f\n",
-	       latencies[num_failed].val / 1000,
-	       latencies[num_failed + num_passed / 4].val / 1000,
-	       latencies[num_failed + num_passed / 2].val / 1000,
-	       latencies[num_failed + num_passed*3/4].val / 1000,
-	       latencies[test_params->rep_count - 1].val / 1000,
-	       latency_avg / 1000, latency_std_dev / 1000);
-
-	/* Print error summary results */
-	printf("\tRPC Failures: %u\n", num_failed);
-	/* print_fail_counts(&latencies[0], num_failed, "\t\t"); */
-
-	printf("\n");
+		/* Print latency summary results */
+		fprintf(out,
+			"\tRPC Latencies (us):\n"
+			"\t\tMin    : %ld\n"
+			"\t\t25th  %%: %ld\n"
+			"\t\tMedian : %ld\n"
+			"\t\t75th  %%: %ld\n"
+			"\t\t99th  %%: %ld\n"
+			"\t\t99.9th%%: %ld\n"
+			"\t\tMax    : %ld\n"
+			"\t\tAverage: %ld\n"
+			"\t\tStd Dev: %.2f\n",
+			sum.min / 1000, sum.p25 / 1000, sum.p50 / 1000, sum.p75 / 1000,
+			sum.p99 / 1000, sum.p999 / 1000, sum.max / 1000, sum.avg / 1000,
+			sum.std_dev / 1000);
+
+		/* Print error summary results */
+		fprintf(out, "\tRPC Failures: %u\n", sum.num_failed);
+		/* print_fail_counts(out, &latencies[0], sum.num_failed, "\t\t"); */
+
+		fprintf(out, "\n");
+		fprintf(out, "\tEndpoint results (rank:tag - Median / 99th %% / 99.9th %% / Max "
+			     "Latency (us)):\n");
+		break;
+	case ST_OUTPUT_JSON:
+		fprintf(out,
+			"\n    {\"master\": \"%u:%u\", \"send_type\": \"%s\", \"send_size\": %d, "
+			"\"reply_type\": \"%s\", \"reply_size\": %d, \"max_inflight\": %d, "
+			"\"duration_ns\": %ld, \"throughput_rpcs\": %.0f, \"bandwidth_MBps\": %.2f, ",
+			ms_endpt->ep_rank, ms_endpt->ep_tag,
+			crt_st_msg_type_str[test_params->send_type], test_params->send_size,
+			crt_st_msg_type_str[test_params->reply_type], test_params->reply_size,
+			test_params->max_inflight, test_duration_ns, throughput,
+			bandwidth / (1024.0F * 1024.0F));
+		print_json_summary(out, &sum);
+		fprintf(out, ",\n     \"endpoints\": [");
+		break;
+	case ST_OUTPUT_CSV:
+		print_csv_row(out, test_params, ms_endpt, NULL, &sum, throughput, bandwidth);
+		break;
+	}
 
 	/*
 	 * Sort the latencies by: (in descending order of precedence)
@@ -192,56 +296,49 @@ static void print_results(struct st_latency *latencies,
 	qsort(latencies, test_params->rep_count,
 	      sizeof(latencies[0]), st_compare_latencies_by_ranks);
 
-	printf("\tEndpoint results (rank:tag - Median Latency (us)):\n");
-
 	/* Iterate over each rank / tag pair */
 	local_rep = 0;
 	do {
 		uint32_t rank      = latencies[local_rep].rank;
 		uint32_t tag       = latencies[local_rep].tag;
-		uint32_t rep_count = test_params->rep_count;
 		uint32_t start_idx = local_rep;
-		uint32_t last_idx;
-		uint32_t median_idx;
-
-		/* Compute start, last, and num_failed for this rank/tag */
-		num_failed = 0;
-		while (1) {
-			if (latencies[local_rep].rank != rank ||
-			    latencies[local_rep].tag != tag)
-				break;
-
-			if (latencies[local_rep].cci_rc < 0)
-				num_failed++;
 
+		/* Find the last repetition of this rank/tag */
+		while (local_rep < test_params->rep_count && latencies[local_rep].rank == rank &&
+		       latencies[local_rep].tag == tag)
 			local_rep++;
-			if (local_rep >= rep_count)
-				break;
-		}
-		last_idx = local_rep - 1;
-		D_ASSERT(start_idx + num_failed <= last_idx + 1);
-
-		printf("\t\t%u:%u - ", rank, tag);
-		if (start_idx + num_failed == last_idx + 1) {
-			printf("NA\n");
-		} else {
-			/* Compute median index */
-			median_idx =
-			    start_idx + num_failed + (last_idx - start_idx - num_failed) / 2;
-			D_ASSERT(median_idx <= last_idx);
-			D_ASSERT(median_idx >= start_idx + num_failed);
-
-			printf("%ld\n", latencies[median_idx].val / 1000);
+		st_summarize(&latencies[start_idx], local_rep - start_idx, &sum);
+
+		switch (format) {
+		case ST_OUTPUT_TEXT:
+			fprintf(out, "\t\t%u:%u - ", rank, tag);
+			if (sum.num_passed == 0)
+				fprintf(out, "NA\n");
+			else
+				fprintf(out, "%ld / %ld / %ld / %ld\n", sum.p50 / 1000,
+					sum.p99 / 1000, sum.p999 / 1000, sum.max / 1000);
+
+			if (sum.num_failed > 0)
+				fprintf(out, "\t\t\tFailures: %u/%u\n", sum.num_failed,
+					local_rep - start_idx);
+			print_fail_counts(out, &latencies[start_idx], sum.num_failed, "\t\t\t");
+			break;
+		case ST_OUTPUT_JSON:
+			fprintf(out, "%s\n       {\"endpoint\": \"%u:%u\", ",
+				start_idx == 0 ? "" : ",", rank, tag);
+			print_json_summary(out, &sum);
+			fprintf(out, "}");
+			break;
+		case ST_OUTPUT_CSV:
+			print_csv_row(out, test_params, ms_endpt, &latencies[start_idx], &sum, 0, 0);
+			break;
 		}
-
-		if (num_failed > 0)
-			printf("\t\t\tFailures: %u/%u\n", num_failed, last_idx - start_idx + 1);
-		print_fail_counts(&latencies[start_idx], num_failed, "\t\t\t");
-
 	} while (local_rep < test_params->rep_count);
 
-	printf("\n");
-
+	if (format == ST_OUTPUT_TEXT)
+		fprintf(out, "\n");
+	else if (format == ST_OUTPUT_JSON)
+		fprintf(out, "]}");
 }
 
 static void
@@ -365,16 +462,24 @@ print_usage(const char *prog_name, const char *msg_sizes_str, int rep_count, int
 	    "        self-test will have no impact on that workload beyond consuming\n"
 	    "        additional network and compute resources\n"
 	    "\n"
+	    "      Test endpoints on the same rank as a master endpoint are served\n"
+	    "        in process, without going through the network stack. Setting\n"
+	    "        D_RPC_LOCAL=0 in the environment of the engines measures the\n"
+	    "        same test through the loopback path of the provider instead\n"
+	    "\n"
 	    "  --repetitions-per-size <N>\n"
 	    "      Short version: -r\n"
 	    "      Number of samples per message size per endpt.\n"
 	    "      RPCs for each particular size will be repeated this many times per endpt.\n"
 	    "      Default: %d\n"
 	    "\n"
-	    "  --max-inflight-rpcs <N>\n"
+	    "  --max-inflight-rpcs <N[,N...]>\n"
 	    "      Short version: -i\n"
 	    "      Maximum number of RPCs allowed to be executing concurrently.\n"
 	    "\n"
+	    "      A comma-separated list sweeps each message size over each value,\n"
+	    "        for example --max-inflight-rpcs 1,16,64\n"
+	    "\n"
 	    "      Note that at the beginning of each test run, a buffer of size send_size\n"
 	    "        is allocated for each in-flight RPC (total max_inflight * send_size).\n"
 	    "        This could be a lot of memory. Also, if the reply uses bulk, the\n"
@@ -423,7 +528,19 @@ print_usage(const char *prog_name, const char *msg_sizes_str, int rep_count, int
 	    "  --no-sync\n"
 	    "      Short version: -n\n"
 	    "      This option avoids pinging each rank in the group before running the test\n"
-	    "      Only applicable when running in without agent (without -u option)\n",
+	    "      Only applicable when running in without agent (without -u option)\n"
+	    "\n"
+	    "  --output-format <text|json|csv>\n"
+	    "      Short version: -f\n"
+	    "      Format of the results. json and csv report, for each message size,\n"
+	    "        in-flight limit and master endpoint, the latency percentiles (in ns)\n"
+	    "        of all RPCs and of the RPCs to each test endpoint\n"
+	    "\n"
+	    "      Default: text\n"
+	    "\n"
+	    "  --output-file <path>\n"
+	    "      Short version: -o\n"
+	    "      Write the results to <path> instead of the standard output\n",
 	    prog_name, UINT32_MAX, CRT_SELF_TEST_AUTO_BULK_THRESH, msg_sizes_str, rep_count,
 	    max_inflight, CRT_ST_BUF_ALIGN_MIN, CRT_ST_BUF_ALIGN_MIN);
 }
@@ -862,18 +979,22 @@ int parse_message_sizes_string(const char *pch,
 }
 
 static void
-print_size_results(struct crt_st_start_params *test_params, struct st_master_endpt *ms_endpts,
-		   uint32_t num_ms_endpts, struct st_latency **latencies, int output_megabits)
+print_size_results(FILE *out, enum st_output_format format, struct crt_st_start_params *test_params,
+		   struct st_master_endpt *ms_endpts, uint32_t num_ms_endpts,
+		   struct st_latency **latencies, int output_megabits, int *nr_results)
 {
 	int m_idx;
 
 	/* Print the results for this size */
-	printf("##################################################\n");
-	printf("Results for message size (%d-%s %d-%s)"
-	       " (max_inflight_rpcs = %d):\n\n",
-	       test_params->send_size, crt_st_msg_type_str[test_params->send_type],
-	       test_params->reply_size, crt_st_msg_type_str[test_params->reply_type],
-	       test_params->max_inflight);
+	if (format == ST_OUTPUT_TEXT) {
+		fprintf(out, "##################################################\n");
+		fprintf(out,
+			"Results for message size (%d-%s %d-%s)"
+			" (max_inflight_rpcs = %d):\n\n",
+			test_params->send_size, crt_st_msg_type_str[test_params->send_type],
+			test_params->reply_size, crt_st_msg_type_str[test_params->reply_type],
+			test_params->max_inflight);
+	}
 
 	for (m_idx = 0; m_idx < num_ms_endpts; m_idx++) {
 		int print_count;
@@ -882,17 +1003,22 @@ print_size_results(struct crt_st_start_params *test_params, struct st_master_end
 		if (ms_endpts[m_idx].test_failed != 0)
 			continue;
 
-		/* Print a header for this endpoint and store number of chars */
-		printf("Master Endpoint %u:%u%n\n", ms_endpts[m_idx].endpt.ep_rank,
-		       ms_endpts[m_idx].endpt.ep_tag, &print_count);
-
-		/* Print a nice line under the header of the right length */
-		for (; print_count > 0; print_count--)
-			printf("-");
-		printf("\n");
+		if (format == ST_OUTPUT_TEXT) {
+			/* Print a header for this endpoint and store number of chars */
+			fprintf(out, "Master Endpoint %u:%u%n\n", ms_endpts[m_idx].endpt.ep_rank,
+				ms_endpts[m_idx].endpt.ep_tag, &print_count);
+
+			/* Print a nice line under the header of the right length */
+			for (; print_count > 0; print_count--)
+				fprintf(out, "-");
+			fprintf(out, "\n");
+		} else if (format == ST_OUTPUT_JSON && *nr_results > 0) {
+			fprintf(out, ",");
+		}
 
-		print_results(latencies[m_idx], test_params,
+		print_results(out, format, latencies[m_idx], test_params, &ms_endpts[m_idx].endpt,
 			      ms_endpts[m_idx].reply.test_duration_ns, output_megabits);
+		(*nr_results)++;
 	}
 }
 
@@ -908,6 +1034,10 @@ int main(int argc, char *argv[])
 	char				*msg_sizes_str = default_msg_sizes_str;
 	int				 rep_count = default_rep_count;
 	int				 max_inflight = default_max_inflight;
+	char				*inflight_str = NULL;
+	int				*all_inflight = NULL;
+	int				 num_inflight = 0;
+	struct st_size_params		*sweep_params = NULL;
 	struct st_size_params		*all_params = NULL;
 	char				*sizes_ptr = NULL;
 	char				*pch = NULL;
@@ -929,6 +1059,10 @@ int main(int argc, char *argv[])
 	bool                             randomize_eps     = false;
 	bool                             use_agent         = false;
 	bool                             no_sync           = false;
+	enum st_output_format            output_format     = ST_OUTPUT_TEXT;
+	char                            *output_path       = NULL;
+	FILE                            *out               = stdout;
+	int                              num_results       = 0;
 
 	ret = d_log_init();
 	if (ret != 0) {
@@ -950,10 +1084,12 @@ int main(int argc, char *argv[])
 		    {"path", required_argument, 0, 'p'},
 		    {"use-daos-agent-env", no_argument, 0, 'u'},
 		    {"no-sync", no_argument, 0, 'n'},
+		    {"output-format", required_argument, 0, 'f'},
+		    {"output-file", required_argument, 0, 'o'},
 		    {"help", no_argument, 0, 'h'},
 		    {0, 0, 0, 0}};
 
-		c = getopt_long(argc, argv, "g:m:e:s:r:i:a:bhqp:un", long_options, NULL);
+		c = getopt_long(argc, argv, "g:m:e:s:r:i:a:bhqp:unf:o:", long_options, NULL);
 		if (c == -1)
 			break;
 
@@ -980,13 +1116,7 @@ int main(int argc, char *argv[])
 			}
 			break;
 		case 'i':
-			ret = sscanf(optarg, "%d", &max_inflight);
-			if (ret != 1) {
-				max_inflight = default_max_inflight;
-				printf("Warning: Invalid max-inflight-rpcs\n"
-				       "  Using default value %d instead\n",
-				       max_inflight);
-			}
+			inflight_str = optarg;
 			break;
 		case 'a':
 			ret = sscanf(optarg, "%" SCNd16, &buf_alignment);
@@ -1014,6 +1144,23 @@ int main(int argc, char *argv[])
 		case 'q':
 			randomize_eps = true;
 			break;
+		case 'f':
+			if (strcasecmp(optarg, "text") == 0) {
+				output_format = ST_OUTPUT_TEXT;
+			} else if (strcasecmp(optarg, "json") == 0) {
+				output_format = ST_OUTPUT_JSON;
+			} else if (strcasecmp(optarg, "csv") == 0) {
+				output_format = ST_OUTPUT_CSV;
+			} else {
+				printf("Warning: Invalid output-format '%s'\n"
+				       "  Using text output instead\n",
+				       optarg);
+				output_format = ST_OUTPUT_TEXT;
+			}
+			break;
+		case 'o':
+			output_path = optarg;
+			break;
 
 		case 'h':
 		case '?':
@@ -1170,18 +1317,61 @@ int main(int argc, char *argv[])
 		       SELF_TEST_MAX_REPETITIONS, rep_count);
 		D_GOTO(cleanup, ret = -DER_INVAL);
 	}
-	if ((max_inflight <= 0) || (max_inflight > SELF_TEST_MAX_INFLIGHT)) {
-		printf("Invalid --max-inflight-rpcs argument\n"
-		       "  Expected value in range (0:%d], got %d\n",
-		       SELF_TEST_MAX_INFLIGHT, max_inflight);
-		D_GOTO(cleanup, ret = -DER_INVAL);
-	}
 
 	/*
-	 * No reason to have max_inflight bigger than the total number of RPCs
-	 * each session
+	 * Parse the comma-separated list of in-flight limits, each message
+	 * size is tested with each of them
 	 */
-	max_inflight = max_inflight > rep_count ? rep_count : max_inflight;
+	num_inflight = 1;
+	for (pch = inflight_str; pch != NULL && *pch != '\0'; pch++)
+		if (*pch == ',')
+			num_inflight++;
+	D_ALLOC_ARRAY(all_inflight, num_inflight);
+	if (all_inflight == NULL)
+		D_GOTO(cleanup, ret = -DER_NOMEM);
+	if (inflight_str == NULL) {
+		all_inflight[0] = max_inflight;
+	} else {
+		num_inflight = 0;
+		pch          = strtok(inflight_str, ",");
+		while (pch != NULL) {
+			ret = sscanf(pch, "%d", &all_inflight[num_inflight]);
+			if (ret != 1)
+				all_inflight[num_inflight] = 0;
+			num_inflight++;
+			pch = strtok(NULL, ",");
+		}
+	}
+
+	for (j = 0; j < num_inflight; j++) {
+		if ((all_inflight[j] <= 0) || (all_inflight[j] > SELF_TEST_MAX_INFLIGHT)) {
+			printf("Invalid --max-inflight-rpcs argument\n"
+			       "  Expected values in range (0:%d], got %d\n",
+			       SELF_TEST_MAX_INFLIGHT, all_inflight[j]);
+			D_GOTO(cleanup, ret = -DER_INVAL);
+		}
+
+		/*
+		 * No reason to have max_inflight bigger than the total number
+		 * of RPCs each session
+		 */
+		if (all_inflight[j] > rep_count)
+			all_inflight[j] = rep_count;
+	}
+	if (num_inflight == 0) {
+		printf("No valid --max-inflight-rpcs given\n");
+		D_GOTO(cleanup, ret = -DER_INVAL);
+	}
+	max_inflight = all_inflight[0];
+
+	if (output_path != NULL) {
+		out = fopen(output_path, "w");
+		if (out == NULL) {
+			printf("Failed to open --output-file %s: %s\n", output_path,
+			       strerror(errno));
+			D_GOTO(cleanup, ret = d_errno2der(errno));
+		}
+	}
 
 	/********************* Print out parameters *********************/
 	printf("Self Test Parameters:\n"
@@ -1203,8 +1393,29 @@ int main(int argc, char *argv[])
 	else
 		printf("  Buffer addresses end with:  %d\n", buf_alignment);
 	printf("  Repetitions per size:       %d\n"
-	       "  Max in-flight RPCs:          %d\n\n",
-	       rep_count, max_inflight);
+	       "  Max in-flight RPCs:         ",
+	       rep_count);
+	for (j = 0; j < num_inflight; j++)
+		printf("%s%d", j > 0 ? ", " : " ", all_inflight[j]);
+	printf("\n\n");
+
+	/* Sweep each message size over each in-flight limit */
+	if (num_inflight > 1) {
+		int k;
+
+		D_ALLOC_ARRAY(sweep_params, num_msg_sizes * num_inflight);
+		if (sweep_params == NULL)
+			D_GOTO(cleanup, ret = -DER_NOMEM);
+		for (j = 0; j < num_msg_sizes; j++)
+			for (k = 0; k < num_inflight; k++) {
+				sweep_params[j * num_inflight + k] = all_params[j];
+				sweep_params[j * num_inflight + k].max_inflight = all_inflight[k];
+			}
+		D_FREE(all_params);
+		all_params = sweep_params;
+		sweep_params = NULL;
+		num_msg_sizes *= num_inflight;
+	}
 
 	/********************* Run the self test *********************/
 	ret = run_self_test(all_params, num_msg_sizes, rep_count, max_inflight, dest_name,
@@ -1217,12 +1428,19 @@ int main(int argc, char *argv[])
 	}
 
 	/********************* Print the results *********************/
+	if (output_format == ST_OUTPUT_JSON)
+		fprintf(out, "{\"group\": \"%s\", \"repetitions\": %d, \"results\": [", dest_name,
+			rep_count);
+	else if (output_format == ST_OUTPUT_CSV)
+		fprintf(out, "master,endpoint,send_type,send_size,reply_type,reply_size,"
+			     "max_inflight,passed,failed,min_ns,p25_ns,p50_ns,p75_ns,p99_ns,"
+			     "p99_9_ns,max_ns,avg_ns,std_dev_ns,throughput_rpcs,bandwidth_MBps\n");
 	for (j = 0; j < num_msg_sizes; j++) {
 		struct crt_st_start_params test_params = {0};
 
 		/* Set test parameters for display */
 		test_params.rep_count     = rep_count;
-		test_params.max_inflight  = max_inflight;
+		test_params.max_inflight  = all_params[j].max_inflight ?: max_inflight;
 		test_params.send_size     = all_params[j].send_size;
 		test_params.reply_size    = all_params[j].reply_size;
 		test_params.send_type     = all_params[j].send_type;
@@ -1231,9 +1449,11 @@ int main(int argc, char *argv[])
 		test_params.srv_grp       = dest_name;
 
 		D_ASSERT(size_latencies[j] != NULL);
-		print_size_results(&test_params, ms_endpts, num_ms_endpts, size_latencies[j],
-				   output_megabits);
+		print_size_results(out, output_format, &test_params, ms_endpts, num_ms_endpts,
+				   size_latencies[j], output_megabits, &num_results);
 	}
+	if (output_format == ST_OUTPUT_JSON)
+		fprintf(out, "\n]}\n");
 	/********************* Clean up *********************/
 cleanup:
 	free_size_latencies(size_latencies, num_msg_sizes, num_ms_endpts);
@@ -1241,6 +1461,9 @@ cleanup:
 	D_FREE(ms_endpts_opt);
 	D_FREE(tgt_endpts);
 	D_FREE(all_params);
+	D_FREE(all_inflight);
+	if (out != stdout)
+		fclose(out);
 
 	self_test_fini(use_agent);
 	d_log_fini();
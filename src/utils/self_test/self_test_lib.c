@@ -729,7 +729,7 @@ run_self_test(struct st_size_params all_params[], int num_msg_sizes, int rep_cou
 		/* Set test parameters to send to the test node */
 		d_iov_set(&test_params.endpts, endpts, num_endpts * sizeof(*endpts));
 		test_params.rep_count     = rep_count;
-		test_params.max_inflight  = max_inflight;
+		test_params.max_inflight  = all_params[size_idx].max_inflight ?: max_inflight;
 		test_params.send_size     = all_params[size_idx].send_size;
 		test_params.reply_size    = all_params[size_idx].reply_size;
 		test_params.send_type     = all_params[size_idx].send_type;
@@ -24,6 +24,8 @@ struct st_size_params {
 		};
 		uint32_t flags;
 	};
+	/* 0 to use the max_inflight argument of run_self_test() */
+	uint32_t max_inflight;
 };
 
 struct st_endpoint {
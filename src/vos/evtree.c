@@ -2705,6 +2705,7 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 						 intent);
 			/* Skip the unavailable record. */
 			if (rc == ALB_UNAVAILABLE) {
+				ent_array->ea_unavail_nr++;
 				continue;
 			}
 
@@ -2896,6 +2897,47 @@ evt_find(daos_handle_t toh, const struct evt_filter *filter,
 	return rc;
 }
 
+int
+evt_ent_array_load(struct evt_entry_array *ent_array, const struct evt_entry *ents,
+		   uint32_t nr, uint32_t inob, const struct evt_extent *ext)
+{
+	struct evt_entry	*ent;
+	daos_off_t		 diff;
+	int			 i;
+
+	D_ASSERT(ent_array->ea_ent_nr == 0);
+	if (nr > ent_array->ea_size && ent_array_resize(NULL, ent_array, nr))
+		return -DER_NOMEM;
+	if (ent_array->ea_max < ent_array->ea_size)
+		ent_array->ea_max = ent_array->ea_size;
+	ent_array->ea_inob = inob;
+
+	for (i = 0; i < nr; i++) {
+		if (ents[i].en_sel_ext.ex_hi < ext->ex_lo ||
+		    ents[i].en_sel_ext.ex_lo > ext->ex_hi)
+			continue;
+
+		ent_array->ea_ents[ent_array->ea_ent_nr].le_prev = NULL;
+		ent = &ent_array->ea_ents[ent_array->ea_ent_nr++].le_ent;
+		*ent = ents[i];
+
+		if (ent->en_sel_ext.ex_lo < ext->ex_lo) {
+			diff = ext->ex_lo - ent->en_sel_ext.ex_lo;
+			ent->en_sel_ext.ex_lo = ext->ex_lo;
+			ent->en_visibility |= EVT_PARTIAL;
+			if (!bio_addr_is_hole(&ent->en_addr))
+				ent->en_addr.ba_off += diff * inob;
+		}
+
+		if (ent->en_sel_ext.ex_hi > ext->ex_hi) {
+			ent->en_sel_ext.ex_hi = ext->ex_hi;
+			ent->en_visibility |= EVT_PARTIAL;
+		}
+	}
+
+	return 0;
+}
+
 /** move the probing trace forward */
 bool
 evt_move_trace(struct evt_context *tcx)
@@ -853,6 +853,226 @@ dtx_18(void **state)
 	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
 }
 
+/* More committed DTX blobs than summarized per call of vos_dtx_cmt_reindex() */
+#define DTX_19_NR	2000
+#define DTX_19_BATCH	200
+
+/* Committed DTX lookups before and while the committed DTX table is reindexed */
+static void
+dtx_19(void **state)
+{
+	struct io_test_args *args = *state;
+	struct dtx_id       *xid;
+	struct dtx_id        unknown;
+	daos_iod_t           iod = {0};
+	d_sg_list_t          sgl = {0};
+	daos_recx_t          rex = {0};
+	daos_key_t           dkey;
+	daos_key_t           akey;
+	d_iov_t              val_iov;
+	uint64_t             epoch;
+	char                 dkey_buf[UPDATE_DKEY_SIZE];
+	char                 akey_buf[UPDATE_AKEY_SIZE];
+	char                 update_buf[UPDATE_BUF_SIZE];
+	int                  steps;
+	int                  rc;
+	int                  i;
+
+	D_ALLOC_ARRAY(xid, DTX_19_NR);
+	assert_non_null(xid);
+
+	for (i = 0; i < DTX_19_NR; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey,
+				    dkey_buf, &akey, akey_buf, &iod, &sgl,
+				    &rex, update_buf, UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, true);
+		assert_rc_equal(rc, 0);
+
+		xid[i] = dth->dth_xid;
+
+		vts_dtx_end(dth);
+	}
+
+	for (i = 0; i < DTX_19_NR; i += DTX_19_BATCH) {
+		rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[i], DTX_19_BATCH, false, NULL);
+		assert_rc_equal(rc, DTX_19_BATCH);
+	}
+	daos_dti_gen_unique(&unknown);
+
+	/* Drop the committed DTX table, as on restart. */
+	rc = vos_dtx_cache_reset(args->ctx.tc_co_hdl, true);
+	assert_rc_equal(rc, 0);
+
+	/* The lookups cannot tell until the blobs are summarized. */
+	rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[0], NULL, NULL, NULL, false);
+	assert_rc_equal(rc, -DER_INPROGRESS);
+
+	/* The reindex ULT summarizes the blobs a few at a time, before reindexing them. */
+	for (steps = 0; ; steps++) {
+		rc = vos_dtx_cmt_reindex(args->ctx.tc_co_hdl);
+		assert_rc_equal(rc, 0);
+
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[DTX_19_NR - 1], NULL, NULL, NULL,
+				   false);
+		if (rc != -DER_INPROGRESS)
+			break;
+	}
+	assert_int_equal(rc, DTX_ST_COMMITTED);
+	assert_true(steps > 0);
+	print_message("Summarized the committed DTX blobs in %d steps\n", steps + 1);
+
+	for (i = 0; i < DTX_19_NR; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+	}
+	rc = vos_dtx_check(args->ctx.tc_co_hdl, &unknown, NULL, NULL, NULL, false);
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	/* Partly reindexed, the DTXs are found in the table or in the summaries. */
+	do {
+		rc = vos_dtx_cmt_reindex(args->ctx.tc_co_hdl);
+		assert_true(rc >= 0);
+
+		for (i = 0; i < DTX_19_NR; i += DTX_19_NR / 20) {
+			assert_int_equal(vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL,
+						       NULL, false), DTX_ST_COMMITTED);
+		}
+		assert_rc_equal(vos_dtx_check(args->ctx.tc_co_hdl, &unknown, NULL, NULL, NULL,
+					      false), -DER_NONEXIST);
+	} while (rc == 0);
+
+	for (i = 0; i < DTX_19_NR; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+	}
+
+	D_FREE(xid);
+}
+
+#define DTX_20_NR	4000
+#define DTX_20_BATCH	200
+
+/* The committed DTX filter is sized from the committed DTXs, between 2^12 counters and the max */
+static void
+dtx_20_check_filter(struct vos_container *cont)
+{
+	uint64_t need = max((uint64_t)cont->vc_dtx_committed_count * 8, 1 << 12);
+	uint32_t size = cont->vc_dtx_cmt_filter_mask + 1;
+
+	assert_non_null(cont->vc_dtx_cmt_filter);
+	assert_true(size >= min(need, vos_dtx_cmt_filter_size));
+	assert_true(size < need * 2);
+}
+
+static void
+dtx_20(void **state)
+{
+	struct io_test_args  *args = *state;
+	struct vos_container *cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+	struct dtx_id        *xid;
+	struct dtx_id         unknown;
+	daos_iod_t            iod = {0};
+	d_sg_list_t           sgl = {0};
+	daos_recx_t           rex = {0};
+	daos_key_t            dkey;
+	daos_key_t            akey;
+	d_iov_t               val_iov;
+	uint64_t              epoch;
+	uint32_t              first_size = 0;
+	char                  dkey_buf[UPDATE_DKEY_SIZE];
+	char                  akey_buf[UPDATE_AKEY_SIZE];
+	char                  update_buf[UPDATE_BUF_SIZE];
+	int                   rc;
+	int                   i;
+
+	if (vos_dtx_cmt_filter_size == 0) {
+		print_message("Committed DTX filter disabled, skip\n");
+		skip();
+	}
+
+	/* Nothing is allocated until the first commit. */
+	assert_int_equal(cont->vc_dtx_committed_count, 0);
+	assert_null(cont->vc_dtx_cmt_filter);
+
+	D_ALLOC_ARRAY(xid, DTX_20_NR);
+	assert_non_null(xid);
+
+	for (i = 0; i < DTX_20_NR; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey,
+				    dkey_buf, &akey, akey_buf, &iod, &sgl,
+				    &rex, update_buf, UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, true);
+		assert_rc_equal(rc, 0);
+
+		xid[i] = dth->dth_xid;
+
+		vts_dtx_end(dth);
+	}
+
+	/* The filter grows with the committed DTXs. */
+	for (i = 0; i < DTX_20_NR; i += DTX_20_BATCH) {
+		rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[i], DTX_20_BATCH, false, NULL);
+		assert_rc_equal(rc, DTX_20_BATCH);
+		dtx_20_check_filter(cont);
+		if (first_size == 0)
+			first_size = cont->vc_dtx_cmt_filter_mask + 1;
+	}
+	print_message("Committed DTX filter grew from %u to %u counters\n", first_size,
+		      cont->vc_dtx_cmt_filter_mask + 1);
+	if (vos_dtx_cmt_filter_size > first_size)
+		assert_true(cont->vc_dtx_cmt_filter_mask + 1 > first_size);
+
+	/* No false negative after the resizes. */
+	for (i = 0; i < DTX_20_NR; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+	}
+	daos_dti_gen_unique(&unknown);
+	rc = vos_dtx_check(args->ctx.tc_co_hdl, &unknown, NULL, NULL, NULL, false);
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	/* Dropped on restart, sized again by the reindex for all the committed DTXs. */
+	rc = vos_dtx_cache_reset(args->ctx.tc_co_hdl, true);
+	assert_rc_equal(rc, 0);
+	assert_null(cont->vc_dtx_cmt_filter);
+
+	do {
+		rc = vos_dtx_cmt_reindex(args->ctx.tc_co_hdl);
+		assert_true(rc >= 0);
+	} while (rc == 0);
+	assert_int_equal(cont->vc_dtx_committed_count, DTX_20_NR);
+	dtx_20_check_filter(cont);
+
+	for (i = 0; i < DTX_20_NR; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+	}
+	rc = vos_dtx_check(args->ctx.tc_co_hdl, &unknown, NULL, NULL, NULL, false);
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	D_FREE(xid);
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -887,6 +1107,10 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_17, NULL, dtx_tst_teardown },
 	{ "VOS518: DTX aggregation",
 	  dtx_18, NULL, dtx_tst_teardown },
+	{ "VOS519: committed DTX lookups during reindex",
+	  dtx_19, NULL, dtx_tst_teardown },
+	{ "VOS520: committed DTX filter sized from the committed DTXs",
+	  dtx_20, NULL, dtx_tst_teardown },
 };
 
 int
@@ -2445,6 +2445,94 @@ io_fetch_hole(void **state)
 	assert_memory_equal(ground_truth, fetch_buf, 3 * 1024);
 }
 
+static void
+io_fetch_neighbor_ranges(void **state)
+{
+	struct io_test_args	*arg = *state;
+	d_iov_t			 val_iov;
+	daos_key_t		 dkey;
+	daos_key_t		 akey;
+	daos_recx_t		 rex;
+	daos_iod_t		 iod;
+	d_sg_list_t		 sgl;
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_buf[UPDATE_AKEY_SIZE];
+	char			 update_buf[16 * 1024];
+	char			 fetch_buf[4 * 1024];
+	char			 ground_truth[16 * 1024];
+	char			 orig[16 * 1024];
+	daos_epoch_t		 epoch = 1;
+	int			 i;
+	int			 rc;
+
+	memset(&iod, 0, sizeof(iod));
+	memset(&sgl, 0, sizeof(sgl));
+
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	vts_key_gen(&akey_buf[0], arg->akey_size, false, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+	set_iov(&akey, &akey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_AKEY_UINT64));
+
+	iod.iod_type = DAOS_IOD_ARRAY;
+	iod.iod_size = 1;
+	iod.iod_name = akey;
+	iod.iod_recxs = &rex;
+	iod.iod_nr = 1;
+	sgl.sg_iovs = &val_iov;
+	sgl.sg_nr = 1;
+
+	/* Write 16K as a single extent */
+	dts_buf_render(&update_buf[0], sizeof(update_buf));
+	memcpy(ground_truth, update_buf, sizeof(update_buf));
+	memcpy(orig, update_buf, sizeof(update_buf));
+	rex.rx_idx = 0;
+	rex.rx_nr = sizeof(update_buf);
+	d_iov_set(&val_iov, &update_buf[0], sizeof(update_buf));
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, epoch++, 0, 0, &dkey, 1, &iod, NULL,
+			    &sgl);
+	assert_rc_equal(rc, 0);
+	inc_cntr(arg->ta_flags);
+
+	/* Sequential 4K fetches, the later ones are served by the visibility cache */
+	for (i = 0; i < 4; i++) {
+		rex.rx_idx = i * sizeof(fetch_buf);
+		rex.rx_nr = sizeof(fetch_buf);
+		d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+		rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, epoch++, 0, &dkey, 1, &iod,
+				   &sgl);
+		assert_rc_equal(rc, 0);
+		assert_memory_equal(&ground_truth[rex.rx_idx], fetch_buf, sizeof(fetch_buf));
+	}
+
+	/* Overwrite the middle of the second 4K, it must be visible to the next fetches */
+	memset(update_buf, 'x', 1024);
+	memcpy(&ground_truth[5 * 1024], update_buf, 1024);
+	rex.rx_idx = 5 * 1024;
+	rex.rx_nr = 1024;
+	d_iov_set(&val_iov, &update_buf[0], 1024);
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, epoch++, 0, 0, &dkey, 1, &iod, NULL,
+			    &sgl);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < 4; i++) {
+		rex.rx_idx = i * sizeof(fetch_buf);
+		rex.rx_nr = sizeof(fetch_buf);
+		d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+		rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, epoch++, 0, &dkey, 1, &iod,
+				   &sgl);
+		assert_rc_equal(rc, 0);
+		assert_memory_equal(&ground_truth[rex.rx_idx], fetch_buf, sizeof(fetch_buf));
+	}
+
+	/* Fetch at the first epoch must not see the overwrite */
+	rex.rx_idx = 4 * 1024;
+	rex.rx_nr = sizeof(fetch_buf);
+	d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+	rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 1, 0, &dkey, 1, &iod, &sgl);
+	assert_rc_equal(rc, 0);
+	assert_memory_equal(&orig[4 * 1024], fetch_buf, sizeof(fetch_buf));
+}
+
 static void
 io_pool_overflow_test(void **state)
 {
@@ -3549,6 +3637,7 @@ static const struct CMUnitTest io_tests[] = {
     {"VOS206: Simple scatter-gather list test, multiple update buffers", io_sgl_update, NULL, NULL},
     {"VOS207: Simple scatter-gather list test, multiple fetch buffers", io_sgl_fetch, NULL, NULL},
     {"VOS208: Extent hole test", io_fetch_hole, NULL, NULL},
+    {"VOS209: Neighboring range fetch test", io_fetch_neighbor_ranges, NULL, NULL},
     {"VOS220: 100K update/fetch/verify test", io_multiple_dkey, NULL, NULL},
     {"VOS222: overwrite test", io_idx_overwrite, NULL, NULL},
     {"VOS245.0: Object iter test (for oid)", oid_iter_test, oid_iter_test_setup, NULL},
@@ -573,6 +573,21 @@ vos_tls_init(int tags, int xs_id, int tgt_id)
 		if (rc)
 			D_WARN("Failed to create invalid DTX cnt sensor: " DF_RC "\n", DP_RC(rc));
 
+		rc = d_tm_add_metric(&tls->vtl_dtx_cmt_filter_neg, D_TM_COUNTER,
+				     "Number of committed DTX lookups answered by the filter", NULL,
+				     "io/dtx/committed_filter/negative/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create DTX filter negative sensor: " DF_RC "\n",
+			       DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_dtx_cmt_filter_fp, D_TM_COUNTER,
+				     "Number of committed DTX lookups passing the filter but missing "
+				     "the table, false positive rate is fp / (fp + negative)", NULL,
+				     "io/dtx/committed_filter/false_positive/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create DTX filter false positive sensor: " DF_RC "\n",
+			       DP_RC(rc));
+
 		rc = d_tm_add_metric(&tls->vtl_obj_cnt, D_TM_GAUGE,
 				     "Number of cached vos object", "entry",
 				     "mem/vos/vos_obj_%u/tgt_%u",
@@ -723,6 +738,21 @@ vos_mod_init(void)
 	d_getenv_bool("DAOS_SKIP_OLD_PARTIAL_DTX", &vos_skip_old_partial_dtx);
 	D_INFO("%s old partial committed DTX record\n", vos_skip_old_partial_dtx ? "Skip" : "Keep");
 
+	d_getenv_bool("DAOS_VOS_VIS_CACHE", &vos_vis_cache_enabled);
+	D_INFO("Object visibility cache is %s\n", vos_vis_cache_enabled ? "enabled" : "disabled");
+
+	vos_dtx_cmt_filter_size = VOS_DTX_CMT_FILTER_DEF;
+	d_getenv_uint("DAOS_DTX_CMT_FILTER_SIZE", &vos_dtx_cmt_filter_size);
+	if (vos_dtx_cmt_filter_size > VOS_DTX_CMT_FILTER_MAX) {
+		D_WARN("Invalid DAOS_DTX_CMT_FILTER_SIZE value, valid range [0, %u], set it as "
+		       "default %u\n", VOS_DTX_CMT_FILTER_MAX, VOS_DTX_CMT_FILTER_DEF);
+		vos_dtx_cmt_filter_size = VOS_DTX_CMT_FILTER_DEF;
+	}
+	/* Round down to 2^n counters */
+	if (vos_dtx_cmt_filter_size != 0)
+		vos_dtx_cmt_filter_size = 1U << (31 - __builtin_clz(vos_dtx_cmt_filter_size));
+	D_INFO("Set committed DTX filter as up to %u counters\n", vos_dtx_cmt_filter_size);
+
 	vos_agg_gap = VOS_AGG_GAP_DEF;
 	d_getenv_uint("DAOS_VOS_AGG_GAP", &vos_agg_gap);
 	if (vos_agg_gap < VOS_AGG_GAP_MIN || vos_agg_gap > VOS_AGG_GAP_MAX) {
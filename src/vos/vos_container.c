@@ -194,6 +194,8 @@ cont_free_internal(struct vos_container *cont)
 		dbtree_destroy(cont->vc_dtx_active_hdl, NULL);
 	if (daos_handle_is_valid(cont->vc_dtx_committed_hdl))
 		dbtree_destroy(cont->vc_dtx_committed_hdl, NULL);
+	vos_dtx_cmt_sum_free(cont);
+	vos_dtx_cmt_filter_fini(cont);
 
 	if (cont->vc_dtx_array)
 		lrua_array_free(cont->vc_dtx_array);
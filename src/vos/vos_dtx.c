@@ -26,6 +26,57 @@
 #define DTX_ACT_BLOB_MAGIC	0x14130a2b
 #define DTX_CMT_BLOB_MAGIC	0x2502191c
 
+/* Bloom filter bits and hashes in the summary of a committed DTX blob, about 2% false positive */
+#define DTX_CMT_SUM_BITS	1024
+#define DTX_CMT_SUM_HASHES	4
+
+/* Committed DTX blobs summarized per call of vos_dtx_cmt_reindex(), before the reindex */
+#define DTX_CMT_SUM_BATCH	16
+
+/*
+ * DRAM summary of a committed DTX blob that is not reindexed yet: the range of the DTX
+ * timestamps and a bloom filter of the DTX IDs, only the blobs matching them are searched.
+ */
+struct vos_dtx_cmt_sum {
+	umem_off_t	dcs_off;
+	uint64_t	dcs_hlc_min;
+	uint64_t	dcs_hlc_max;
+	uint64_t	dcs_bloom[DTX_CMT_SUM_BITS / 64];
+};
+
+/*
+ * Summaries of the committed DTX blobs not reindexed yet, in the order of the blobs. They are
+ * built by the reindex ULT, a few blobs per call, before the reindex itself. They are also
+ * ordered by dcs_hlc_min in dcss_order, dcss_hlc_max[i] being the highest dcs_hlc_max of the
+ * first i + 1 of them in that order, so that a lookup only checks the summaries which may cover
+ * the timestamp of the DTX.
+ */
+struct vos_dtx_cmt_sums {
+	struct vos_dtx_cmt_sum	*dcss_sums;
+	uint32_t		*dcss_order;
+	uint64_t		*dcss_hlc_max;
+	/* The next blob to summarize. */
+	umem_off_t		 dcss_pos;
+	/* The summaries before this one have been reindexed or released. */
+	uint32_t		 dcss_start;
+	/* The committed DTXs in the summarized blobs, to size the committed DTX filter. */
+	uint64_t		 dcss_ents;
+	uint32_t		 dcss_nr;
+	uint32_t		 dcss_cap;
+	uint32_t		 dcss_ready : 1, dcss_failed : 1;
+};
+
+/* Hashes for each DTX in the committed DTX filter */
+#define DTX_CMT_FILTER_HASHES	3
+
+/*
+ * Counters of the committed DTX filter per committed DTX, about 3% false positives, and its
+ * smallest size. It is shrunk when DTX_CMT_FILTER_SHRINK times larger than needed.
+ */
+#define DTX_CMT_FILTER_RATIO	8
+#define DTX_CMT_FILTER_MIN	(1 << 12)
+#define DTX_CMT_FILTER_SHRINK	4
+
 #define DTX_UMOFF_TYPES		(DTX_UMOFF_ILOG | DTX_UMOFF_SVT | DTX_UMOFF_EVT)
 #define DTX_INDEX_INVAL		(int32_t)(-1)
 
@@ -45,6 +96,8 @@
 	} while (0)
 
 bool vos_skip_old_partial_dtx;
+/* Counters in the committed DTX filter of each container, zero to disable the filter. */
+uint32_t vos_dtx_cmt_filter_size;
 
 static inline uint32_t
 dtx_umoff_flag2type(umem_off_t umoff)
@@ -339,12 +392,161 @@ static btr_ops_t dtx_active_btr_ops = {
 	.to_rec_update	= dtx_act_ent_update,
 };
 
+/*
+ * Counting bloom filter of the committed DTX table, most lookups are for the DTXs that have
+ * never been committed on this container and the filter answers them without the btree. The
+ * counters reaching the maximum are never decreased, that only costs some false positives.
+ */
+static inline uint32_t
+dtx_cmt_filter_slot(struct vos_container *cont, uint64_t hash, int i)
+{
+	return ((uint32_t)hash + i * (uint32_t)(hash >> 32)) & cont->vc_dtx_cmt_filter_mask;
+}
+
+static void
+dtx_cmt_filter_add(struct vos_container *cont, struct dtx_id *xid)
+{
+	uint64_t hash;
+	uint8_t *cnt;
+	int      i;
+
+	if (cont->vc_dtx_cmt_filter == NULL)
+		return;
+
+	hash = d_hash_murmur64((unsigned char *)xid, sizeof(*xid), 0);
+	for (i = 0; i < DTX_CMT_FILTER_HASHES; i++) {
+		cnt = &cont->vc_dtx_cmt_filter[dtx_cmt_filter_slot(cont, hash, i)];
+		if (*cnt < UINT8_MAX)
+			(*cnt)++;
+	}
+}
+
+static void
+dtx_cmt_filter_del(struct vos_container *cont, struct dtx_id *xid)
+{
+	uint64_t hash;
+	uint8_t *cnt;
+	int      i;
+
+	if (cont->vc_dtx_cmt_filter == NULL)
+		return;
+
+	hash = d_hash_murmur64((unsigned char *)xid, sizeof(*xid), 0);
+	for (i = 0; i < DTX_CMT_FILTER_HASHES; i++) {
+		cnt = &cont->vc_dtx_cmt_filter[dtx_cmt_filter_slot(cont, hash, i)];
+		if (*cnt > 0 && *cnt < UINT8_MAX)
+			(*cnt)--;
+	}
+}
+
+static bool
+dtx_cmt_filter_test(struct vos_container *cont, struct dtx_id *xid)
+{
+	uint64_t hash;
+	int      i;
+
+	if (cont->vc_dtx_cmt_filter == NULL)
+		return true;
+
+	hash = d_hash_murmur64((unsigned char *)xid, sizeof(*xid), 0);
+	for (i = 0; i < DTX_CMT_FILTER_HASHES; i++) {
+		if (cont->vc_dtx_cmt_filter[dtx_cmt_filter_slot(cont, hash, i)] == 0)
+			return false;
+	}
+
+	return true;
+}
+
+static int
+dtx_cmt_filter_fill_cb(daos_handle_t ih, d_iov_t *key, d_iov_t *val, void *arg)
+{
+	dtx_cmt_filter_add(arg, key->iov_buf);
+	return 0;
+}
+
+/*
+ * Size the filter for \a count committed DTXs, between DTX_CMT_FILTER_MIN and
+ * vos_dtx_cmt_filter_size counters, and fill it from the committed DTX table. It is allocated on
+ * the first commit, then only reallocated when too small or much too large, so the table is
+ * walked once per doubling of the committed DTXs. The container keeps the old filter, or runs
+ * without it, on failure.
+ */
+static void
+dtx_cmt_filter_resize(struct vos_container *cont, uint64_t count)
+{
+	uint8_t  *old      = cont->vc_dtx_cmt_filter;
+	uint32_t  old_size = old != NULL ? cont->vc_dtx_cmt_filter_mask + 1 : 0;
+	uint64_t  size;
+	int       rc;
+
+	if (vos_dtx_cmt_filter_size == 0 || daos_handle_is_inval(cont->vc_dtx_committed_hdl))
+		return;
+
+	size = max(count * DTX_CMT_FILTER_RATIO, DTX_CMT_FILTER_MIN);
+	/* Round up to 2^n counters */
+	size = 1ULL << (64 - __builtin_clzll(size - 1));
+	size = min(size, vos_dtx_cmt_filter_size);
+	if (size <= old_size && size * DTX_CMT_FILTER_SHRINK > old_size)
+		return;
+
+	D_ALLOC(cont->vc_dtx_cmt_filter, size);
+	if (cont->vc_dtx_cmt_filter == NULL) {
+		D_WARN("Failed to size committed DTX filter of " DF_UUID " as %lu counters\n",
+		       DP_UUID(cont->vc_id), size);
+		cont->vc_dtx_cmt_filter = old;
+		return;
+	}
+	cont->vc_dtx_cmt_filter_mask = size - 1;
+
+	rc = dbtree_iterate(cont->vc_dtx_committed_hdl, DAOS_INTENT_DEFAULT, false,
+			    dtx_cmt_filter_fill_cb, cont);
+	if (rc != 0) {
+		DL_WARN(rc, "Failed to fill committed DTX filter of " DF_UUID,
+			DP_UUID(cont->vc_id));
+		D_FREE(cont->vc_dtx_cmt_filter);
+		cont->vc_dtx_cmt_filter      = old;
+		cont->vc_dtx_cmt_filter_mask = old_size - 1;
+		return;
+	}
+
+	D_FREE(old);
+	D_DEBUG(DB_TRACE, "Sized committed DTX filter of " DF_UUID " as %lu counters for %lu DTXs\n",
+		DP_UUID(cont->vc_id), size, count);
+}
+
+void
+vos_dtx_cmt_filter_fini(struct vos_container *cont)
+{
+	D_FREE(cont->vc_dtx_cmt_filter);
+	cont->vc_dtx_cmt_filter_mask = 0;
+}
+
+/* Lookup the committed DTX table, the DTX that is not in the filter is not searched. */
+static int
+dtx_cmt_lookup(struct vos_container *cont, d_iov_t *kiov)
+{
+	struct vos_tls *tls = vos_tls_get(cont->vc_pool->vp_sysdb);
+	int             rc;
+
+	if (!dtx_cmt_filter_test(cont, kiov->iov_buf)) {
+		d_tm_inc_counter(tls->vtl_dtx_cmt_filter_neg, 1);
+		return -DER_NONEXIST;
+	}
+
+	rc = dbtree_lookup(cont->vc_dtx_committed_hdl, kiov, NULL);
+	if (rc == -DER_NONEXIST && cont->vc_dtx_cmt_filter != NULL)
+		d_tm_inc_counter(tls->vtl_dtx_cmt_filter_fp, 1);
+
+	return rc;
+}
+
 static int
 dtx_cmt_ent_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		  d_iov_t *val_iov, struct btr_record *rec, d_iov_t *val_out)
 {
 	/* No payload for committed DTX entry in DRAM, only the key (dtx_id). */
 	rec->rec_off = UMOFF_NULL;
+	dtx_cmt_filter_add(tins->ti_priv, key_iov->iov_buf);
 	return 0;
 }
 
@@ -353,6 +555,7 @@ dtx_cmt_ent_free(struct btr_instance *tins, struct btr_record *rec,
 		 void *args)
 {
 	D_ASSERT(rec->rec_off == UMOFF_NULL);
+	dtx_cmt_filter_del(tins->ti_priv, (struct dtx_id *)&rec->rec_hkey[0]);
 	return 0;
 }
 
@@ -830,7 +1033,7 @@ vos_dtx_commit_one(struct vos_container *cont, struct vos_dtx_blob_df *dbd, uint
 		d_iov_set(&riov, NULL, 0);
 		rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 		if (rc == -DER_NONEXIST) {
-			rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, NULL);
+			rc = dtx_cmt_lookup(cont, &kiov);
 			if (rc == 0)
 				rc = -DER_ALREADY;
 		}
@@ -1834,7 +2037,7 @@ vos_dtx_validation(struct dtx_handle *dth)
 		rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 		if (rc != 0) {
 			if (rc == -DER_NONEXIST) {
-				rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, NULL);
+				rc = dtx_cmt_lookup(cont, &kiov);
 				if (rc == 0)
 					D_GOTO(out, rc = DTX_ST_COMMITTED);
 			}
@@ -2223,6 +2426,229 @@ vos_dtx_pack_mbs(struct umem_instance *umm, struct vos_dtx_act_ent *dae,
 	return 0;
 }
 
+static inline uint32_t
+dtx_cmt_sum_bit(uint64_t hash, int i)
+{
+	return ((uint32_t)hash + i * (uint32_t)(hash >> 32)) % DTX_CMT_SUM_BITS;
+}
+
+void
+vos_dtx_cmt_sum_free(struct vos_container *cont)
+{
+	struct vos_dtx_cmt_sums *sums = cont->vc_cmt_dtx_sums;
+
+	if (sums == NULL)
+		return;
+
+	D_FREE(sums->dcss_sums);
+	D_FREE(sums->dcss_order);
+	D_FREE(sums->dcss_hlc_max);
+	D_FREE(sums);
+	cont->vc_cmt_dtx_sums = NULL;
+}
+
+/*
+ * The blob has been reindexed or released, its summary is not needed any more. \a next_off is
+ * the blob following it.
+ */
+static void
+vos_dtx_cmt_sum_drop(struct vos_container *cont, umem_off_t dbd_off, umem_off_t next_off)
+{
+	struct vos_dtx_cmt_sums *sums = cont->vc_cmt_dtx_sums;
+
+	if (sums == NULL)
+		return;
+
+	if (sums->dcss_start < sums->dcss_nr && sums->dcss_sums[sums->dcss_start].dcs_off == dbd_off)
+		sums->dcss_start++;
+
+	/* Released by the aggregation before being summarized. */
+	if (sums->dcss_pos == dbd_off)
+		sums->dcss_pos = next_off;
+}
+
+static int
+vos_dtx_cmt_sum_grow(struct vos_dtx_cmt_sums *sums)
+{
+	struct vos_dtx_cmt_sum *tmp_sums;
+	uint32_t               *tmp_order;
+	uint64_t               *tmp_max;
+	uint32_t                cap = max(sums->dcss_cap * 2, DTX_CMT_SUM_BATCH * 4);
+
+	D_REALLOC_ARRAY(tmp_sums, sums->dcss_sums, sums->dcss_cap, cap);
+	if (tmp_sums == NULL)
+		return -DER_NOMEM;
+	sums->dcss_sums = tmp_sums;
+
+	D_REALLOC_ARRAY(tmp_order, sums->dcss_order, sums->dcss_cap, cap);
+	if (tmp_order == NULL)
+		return -DER_NOMEM;
+	sums->dcss_order = tmp_order;
+
+	D_REALLOC_ARRAY(tmp_max, sums->dcss_hlc_max, sums->dcss_cap, cap);
+	if (tmp_max == NULL)
+		return -DER_NOMEM;
+	sums->dcss_hlc_max = tmp_max;
+
+	sums->dcss_cap = cap;
+	return 0;
+}
+
+/*
+ * Summarize up to DTX_CMT_SUM_BATCH committed DTX blobs from the reindex position. The entries
+ * committed after that are in the committed DTX table, then the summaries never need to be
+ * refreshed. Return false if some blobs remain to be summarized. The lookups keep returning
+ * -DER_INPROGRESS until the reindex is done if the summaries cannot be built.
+ */
+static bool
+vos_dtx_cmt_sum_build(struct vos_container *cont)
+{
+	struct umem_instance    *umm  = vos_cont2umm(cont);
+	struct vos_dtx_cmt_sums *sums = cont->vc_cmt_dtx_sums;
+	struct vos_dtx_cmt_sum  *sum;
+	struct vos_dtx_blob_df  *dbd;
+	uint64_t                 hash;
+	uint32_t                 idx;
+	uint32_t                 pos;
+	int                      i;
+	int                      j;
+	int                      k;
+	int                      rc = 0;
+
+	if (sums == NULL) {
+		D_ALLOC_PTR(sums);
+		if (sums == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		sums->dcss_pos        = cont->vc_cmt_dtx_reindex_pos;
+		cont->vc_cmt_dtx_sums = sums;
+	}
+
+	if (sums->dcss_ready || sums->dcss_failed)
+		return true;
+
+	for (i = 0; i < DTX_CMT_SUM_BATCH && !UMOFF_IS_NULL(sums->dcss_pos); i++) {
+		if (sums->dcss_nr == sums->dcss_cap) {
+			rc = vos_dtx_cmt_sum_grow(sums);
+			if (rc != 0)
+				goto out;
+		}
+
+		dbd = umem_off2ptr(umm, sums->dcss_pos);
+		D_ASSERTF(dbd->dbd_magic == DTX_CMT_BLOB_MAGIC,
+			  "Corrupted committed DTX blob (3) %x\n", dbd->dbd_magic);
+
+		idx = sums->dcss_nr++;
+		sum = &sums->dcss_sums[idx];
+		memset(sum, 0, sizeof(*sum));
+		sum->dcs_off     = sums->dcss_pos;
+		sum->dcs_hlc_min = UINT64_MAX;
+		sums->dcss_ents += dbd->dbd_count;
+		for (j = 0; j < dbd->dbd_count; j++) {
+			struct dtx_id *xid = &dbd->dbd_committed_data[j].dce_xid;
+
+			sum->dcs_hlc_min = min(sum->dcs_hlc_min, xid->dti_hlc);
+			sum->dcs_hlc_max = max(sum->dcs_hlc_max, xid->dti_hlc);
+			hash = d_hash_murmur64((unsigned char *)xid, sizeof(*xid), 0);
+			for (k = 0; k < DTX_CMT_SUM_HASHES; k++)
+				setbit64(sum->dcs_bloom, dtx_cmt_sum_bit(hash, k));
+		}
+
+		/* Insertion sort, the blobs are mostly committed in timestamp order. */
+		for (pos = idx; pos > 0 &&
+		     sums->dcss_sums[sums->dcss_order[pos - 1]].dcs_hlc_min > sum->dcs_hlc_min; pos--)
+			sums->dcss_order[pos] = sums->dcss_order[pos - 1];
+		sums->dcss_order[pos] = idx;
+		for (; pos <= idx; pos++)
+			sums->dcss_hlc_max[pos] =
+			    max(pos == 0 ? 0 : sums->dcss_hlc_max[pos - 1],
+				sums->dcss_sums[sums->dcss_order[pos]].dcs_hlc_max);
+
+		sums->dcss_pos = dbd->dbd_next;
+	}
+
+	if (!UMOFF_IS_NULL(sums->dcss_pos))
+		return false;
+
+	sums->dcss_ready = 1;
+	/* The reindex adds the summarized DTXs to the filter, size it for all of them. */
+	dtx_cmt_filter_resize(cont, cont->vc_dtx_committed_count + sums->dcss_ents);
+	D_DEBUG(DB_TRACE, "Summarized %u committed DTX blobs for " DF_UUID "/" DF_UUID "\n",
+		sums->dcss_nr, DP_UUID(cont->vc_pool->vp_id), DP_UUID(cont->vc_id));
+
+out:
+	if (rc != 0) {
+		DL_WARN(rc, "Failed to summarize committed DTX blobs for " DF_UUID,
+			DP_UUID(cont->vc_id));
+		if (sums != NULL) {
+			D_FREE(sums->dcss_sums);
+			D_FREE(sums->dcss_order);
+			D_FREE(sums->dcss_hlc_max);
+			sums->dcss_nr     = 0;
+			sums->dcss_cap    = 0;
+			sums->dcss_failed = 1;
+		}
+	}
+	return true;
+}
+
+/*
+ * Search the committed DTX blobs not reindexed yet, instead of asking the caller to retry
+ * until the reindex is done, that may take a long time with millions of committed DTXs. The
+ * caller still retries until the reindex ULT has summarized the blobs.
+ */
+static int
+vos_dtx_cmt_lookup_unindexed(struct vos_container *cont, struct dtx_id *dti)
+{
+	struct umem_instance    *umm  = vos_cont2umm(cont);
+	struct vos_dtx_cmt_sums *sums = cont->vc_cmt_dtx_sums;
+	struct vos_dtx_cmt_sum  *sum;
+	struct vos_dtx_blob_df  *dbd;
+	uint64_t                 hash;
+	uint32_t                 idx;
+	uint32_t                 lo;
+	uint32_t                 hi;
+	uint32_t                 i;
+	int                      j;
+
+	if (sums == NULL || !sums->dcss_ready)
+		return -DER_INPROGRESS;
+
+	/* The summaries starting at or before the timestamp of the DTX. */
+	lo = 0;
+	hi = sums->dcss_nr;
+	while (lo < hi) {
+		i = lo + (hi - lo) / 2;
+		if (sums->dcss_sums[sums->dcss_order[i]].dcs_hlc_min <= dti->dti_hlc)
+			lo = i + 1;
+		else
+			hi = i;
+	}
+
+	/* Walk back while the summaries may cover it. */
+	hash = d_hash_murmur64((unsigned char *)dti, sizeof(*dti), 0);
+	for (i = lo; i > 0 && sums->dcss_hlc_max[i - 1] >= dti->dti_hlc; i--) {
+		idx = sums->dcss_order[i - 1];
+		sum = &sums->dcss_sums[idx];
+		if (idx < sums->dcss_start || dti->dti_hlc > sum->dcs_hlc_max)
+			continue;
+
+		for (j = 0; j < DTX_CMT_SUM_HASHES; j++) {
+			if (!isset64(sum->dcs_bloom, dtx_cmt_sum_bit(hash, j)))
+				break;
+		}
+		if (j < DTX_CMT_SUM_HASHES)
+			continue;
+
+		dbd = umem_off2ptr(umm, sum->dcs_off);
+		for (j = 0; j < dbd->dbd_count; j++) {
+			if (daos_dti_equal(&dbd->dbd_committed_data[j].dce_xid, dti))
+				return 0;
+		}
+	}
+
+	return -DER_NONEXIST;
+}
+
 int
 vos_dtx_check(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t *epoch,
 	      uint32_t *pm_ver, struct dtx_cos_key *dck, bool for_refresh)
@@ -2326,14 +2752,13 @@ vos_dtx_check(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t *epoch,
 	}
 
 	if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, NULL);
+		rc = dtx_cmt_lookup(cont, &kiov);
+		if (rc == -DER_NONEXIST && !cont->vc_cmt_dtx_indexed)
+			rc = vos_dtx_cmt_lookup_unindexed(cont, dti);
 		if (rc == 0)
 			return DTX_ST_COMMITTED;
 	}
 
-	if (rc == -DER_NONEXIST && !cont->vc_cmt_dtx_indexed)
-		rc = -DER_INPROGRESS;
-
 	return rc;
 }
 
@@ -2359,11 +2784,11 @@ vos_dtx_load_mbs(daos_handle_t coh, struct dtx_id *dti, daos_unit_oid_t *oid,
 		if (rc == 0 && oid != NULL)
 			*oid = DAE_OID(dae);
 	} else if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, NULL);
+		rc = dtx_cmt_lookup(cont, &kiov);
+		if (rc == -DER_NONEXIST && !cont->vc_cmt_dtx_indexed)
+			rc = vos_dtx_cmt_lookup_unindexed(cont, dti);
 		if (rc == 0)
 			rc = 1;
-		else if (rc == -DER_NONEXIST && !cont->vc_cmt_dtx_indexed)
-			rc = -DER_INPROGRESS;
 	}
 
 	return rc;
@@ -2884,6 +3309,10 @@ pin_objects:
 		idx += pinned;
 		goto pin_objects;
 	}
+
+	/* The count is partial until the table is reindexed, the reindex sizes the filter. */
+	if (tot_committed > 0 && cont->vc_cmt_dtx_indexed)
+		dtx_cmt_filter_resize(cont, cont->vc_dtx_committed_count);
 out:
 	D_FREE(daes);
 	D_FREE(cmts);
@@ -3000,7 +3429,7 @@ vos_dtx_abort(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t epoch, uint32_
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 	if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, NULL);
+		rc = dtx_cmt_lookup(cont, &kiov);
 		if (rc == 0) {
 			D_ERROR("NOT allow to abort a committed DTX (1) "DF_DTI"\n", DP_DTI(dti));
 			D_GOTO(out, rc = -DER_NO_PERM);
@@ -3200,7 +3629,7 @@ vos_dtx_set_flags_one(struct vos_container *cont, struct dtx_id *dti, uint32_t f
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 	if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, NULL);
+		rc = dtx_cmt_lookup(cont, &kiov);
 		if (rc == 0) {
 			D_ERROR("Not allow to set flag %s on committed (1) DTX entry "DF_DTI"\n",
 				vos_dtx_flags2name(flags), DP_DTI(dti));
@@ -3441,6 +3870,7 @@ out_tx_end:
 
 	if (is_dbd_freed) {
 		cont->vc_cmt_dtx_reindex_pos = dbd_next_off;
+		vos_dtx_cmt_sum_drop(cont, dbd_off, dbd_next_off);
 		D_DEBUG(DB_TRACE,
 			"Removed blob of DTX committed entries %p (" UMOFF_PF ") of cont " DF_UUID,
 			dbd, UMOFF_P(dbd_off), DP_UUID(cont->vc_id));
@@ -3484,6 +3914,10 @@ vos_dtx_aggregate(daos_handle_t coh, const uint64_t *cmt_time)
 	if (rc == 1 && UMOFF_IS_NULL(cont_df->cd_dtx_committed_head))
 		rc = 0;
 
+	/* Shrink the committed DTX filter if the aggregation removed most of the DTXs. */
+	if (rc >= 0 && cont->vc_cmt_dtx_indexed)
+		dtx_cmt_filter_resize(cont, cont->vc_dtx_committed_count);
+
 	return rc;
 }
 
@@ -3793,6 +4227,10 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 	D_ASSERTF(dbd->dbd_magic == DTX_CMT_BLOB_MAGIC,
 		  "Corrupted committed DTX blob (2) %x\n", dbd->dbd_magic);
 
+	/* The blobs are summarized first, the lookups search them until they are reindexed. */
+	if (!vos_dtx_cmt_sum_build(cont))
+		return 0;
+
 	for (i = 0; i < dbd->dbd_count; i++) {
 		struct vos_dtx_cmt_ent_df *dce_df = &dbd->dbd_committed_data[i];
 
@@ -3816,6 +4254,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 	if (dbd->dbd_count < dbd->dbd_cap || UMOFF_IS_NULL(dbd->dbd_next))
 		D_GOTO(out, rc = 1);
 
+	vos_dtx_cmt_sum_drop(cont, cont->vc_cmt_dtx_reindex_pos, dbd->dbd_next);
 	cont->vc_cmt_dtx_reindex_pos = dbd->dbd_next;
 
 out:
@@ -3826,8 +4265,10 @@ out:
 	}
 
 	if (rc > 0) {
+		vos_dtx_cmt_sum_free(cont);
 		cont->vc_cmt_dtx_reindex_pos = UMOFF_NULL;
 		cont->vc_cmt_dtx_indexed = 1;
+		dtx_cmt_filter_resize(cont, cont->vc_dtx_committed_count);
 		D_INFO("Reindexed committed DTX table (%u entries) for " DF_UUID "/" DF_UUID "\n",
 		       cont->vc_dtx_committed_count, DP_UUID(cont->vc_pool->vp_id),
 		       DP_UUID(cont->vc_id));
@@ -4185,10 +4626,14 @@ cmt:
 			  "Unexpected committed DTX entries count for " DF_UUID ": %u vs %u\n",
 			  DP_UUID(cont->vc_id), cont->vc_pool->vp_dtx_committed_count, count);
 
+		/* Sized again from the committed DTXs found by the reindex. */
+		vos_dtx_cmt_filter_fini(cont);
+
 		cont->vc_dtx_committed_hdl   = DAOS_HDL_INVAL;
 		cont->vc_dtx_committed_count = 0;
 		cont->vc_cmt_dtx_indexed     = 0;
 		cont->vc_cmt_dtx_reindex_pos = cont->vc_cont_df->cd_dtx_committed_head;
+		vos_dtx_cmt_sum_free(cont);
 		cont->vc_dtx_reset           = 0;
 		cont->vc_pool->vp_dtx_committed_count -= count;
 		d_tm_dec_gauge(vos_tls_get(false)->vtl_committed, count);
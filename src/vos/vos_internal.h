@@ -153,6 +153,13 @@ extern uint32_t vos_agg_gap;
 extern unsigned int vos_agg_nvme_thresh;
 extern bool vos_dkey_punch_propagate;
 extern bool vos_skip_old_partial_dtx;
+extern bool vos_vis_cache_enabled;
+
+/* The largest size of the committed DTX filter of a container, it is sized from its DTXs. */
+#define VOS_DTX_CMT_FILTER_DEF	(1 << 18)
+#define VOS_DTX_CMT_FILTER_MAX	(1 << 26)
+
+extern uint32_t vos_dtx_cmt_filter_size;
 
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
@@ -419,6 +426,9 @@ struct vos_container {
 	uint64_t		vc_dtx_reject_ts;
 	/* The count of committed DTXs. */
 	uint32_t		vc_dtx_committed_count;
+	/* Counting bloom filter of the committed DTX table, and its size minus one. */
+	uint8_t			*vc_dtx_cmt_filter;
+	uint32_t		vc_dtx_cmt_filter_mask;
 	/** Index for timestamp lookup */
 	uint32_t		*vc_ts_idx;
 	/** Direct pointer to the VOS container */
@@ -442,6 +452,8 @@ struct vos_container {
 	uint64_t		vc_io_nospc_ts;
 	/* The (next) position for committed DTX entries reindex. */
 	umem_off_t		vc_cmt_dtx_reindex_pos;
+	/* Summaries of the committed DTX blobs not reindexed yet, lookups search them. */
+	struct vos_dtx_cmt_sums	*vc_cmt_dtx_sums;
 	/* The epoch for the latest committed solo DTX. Any solo
 	 * * transaction with older epoch must have been committed.
 	 */
@@ -851,6 +863,23 @@ vos_dtx_post_handle(struct vos_container *cont, struct vos_dtx_act_ent **daes, b
 int
 vos_dtx_act_reindex(struct vos_container *cont);
 
+/**
+ * Release the summaries of the committed DTX blobs that are not reindexed yet.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ */
+void
+vos_dtx_cmt_sum_free(struct vos_container *cont);
+
+/**
+ * Release the filter of the committed DTX table, it is allocated on the first commit or by the
+ * reindex and sized from the count of committed DTXs.
+ *
+ * \param cont	[IN]	Pointer to the container.
+ */
+void
+vos_dtx_cmt_filter_fini(struct vos_container *cont);
+
 int
 vos_dtx_record_oid(struct dtx_handle *dth, struct vos_container *cont, daos_unit_oid_t oid);
 
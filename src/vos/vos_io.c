@@ -600,8 +600,11 @@ vos_ioc_destroy(struct vos_io_context *ioc, bool evict)
 
 	dcs_csum_info_list_fini(&ioc->ic_csum_list);
 
-	if (ioc->ic_obj)
+	if (ioc->ic_obj) {
+		if (ioc->ic_update)
+			vos_obj_vis_invalidate(ioc->ic_obj);
 		vos_obj_release(ioc->ic_obj, 0, evict);
+	}
 
 	vos_ioc_reserve_fini(ioc);
 	vos_ilog_fetch_finish(&ioc->ic_dkey_info);
@@ -1047,9 +1050,82 @@ save_recx(struct vos_io_context *ioc, uint64_t rx_idx, uint64_t rx_nr,
 	return daos_recx_ep_add(recx_list, &recx_ep);
 }
 
+/**
+ * The object visibility cache can be used when all writes to the object are
+ * visible at the fetch epoch, and the visibility doesn't depend on the DTX of
+ * a transactional read. The cached entries reference checksums in SCM, which
+ * aren't pinned for evictable pools.
+ */
+static inline bool
+vis_cacheable(struct vos_io_context *ioc, const struct evt_filter *filter)
+{
+	struct vos_pool *pool = ioc->ic_cont->vc_pool;
+
+	return vos_vis_cache_enabled && !vos_pool_is_evictable(pool) &&
+	       !dtx_is_valid_handle(vos_dth_get(pool->vp_sysdb)) &&
+	       ioc->ic_obj->obj_df != NULL && filter->fr_epoch >= ioc->ic_obj->obj_df->vo_max_write;
+}
+
+/**
+ * Find the visible extents for \a filter, from the object visibility cache if
+ * possible. On cache miss, the whole aligned extent window around the fetched
+ * range is looked up and cached, so the following fetches of neighboring ranges
+ * don't have to walk the tree again. A window which can't be cached is marked
+ * in the cache, so the following fetches only look up their own range.
+ */
+static int
+akey_find_visible(struct vos_io_context *ioc, daos_handle_t toh, struct vos_krec_df *krec,
+		  const struct evt_filter *filter)
+{
+	struct vos_object	*obj = ioc->ic_obj;
+	struct dtx_handle	*dth;
+	struct evt_filter	 win_filter;
+	daos_size_t		 rsize;
+	uint64_t		 win;
+	int			 rc;
+
+	if (!vis_cacheable(ioc, filter))
+		return evt_find(toh, filter, ioc->ic_ent_array);
+
+	rc = vos_obj_vis_lookup(obj, krec, filter, ioc->ic_ent_array);
+	if (rc == -DER_NOTAPPLICABLE)
+		return evt_find(toh, filter, ioc->ic_ent_array);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
+	rsize = ioc->ic_iods[ioc->ic_sgl_at].iod_size;
+	if (rsize == DAOS_REC_ANY || rsize > VOS_VIS_CACHE_WINDOW)
+		rsize = VOS_VIS_CACHE_WINDOW;
+	win = VOS_VIS_CACHE_WINDOW / rsize;
+
+	win_filter = *filter;
+	win_filter.fr_ex.ex_lo = rounddown(filter->fr_ex.ex_lo, win);
+	if (filter->fr_ex.ex_hi < UINT64_MAX - win)
+		win_filter.fr_ex.ex_hi = rounddown(filter->fr_ex.ex_hi, win) + win - 1;
+
+	/* Look up the window without DTX handle, so uncommitted extents out of the fetched
+	 * range neither fail the fetch nor get recorded for DTX refresh, they only make
+	 * the window uncacheable.
+	 */
+	dth = clear_cur_dth(ioc->ic_cont->vc_pool);
+	rc = evt_find(toh, &win_filter, ioc->ic_ent_array);
+	restore_cur_dth(ioc->ic_cont->vc_pool, dth);
+	if (rc == 0)
+		vos_obj_vis_save(obj, krec, &win_filter, ioc->ic_ent_array);
+
+	evt_ent_array_fini(ioc->ic_ent_array);
+	evt_ent_array_init(ioc->ic_ent_array, 0);
+
+	rc = vos_obj_vis_lookup(obj, krec, filter, ioc->ic_ent_array);
+	if (rc != -DER_NONEXIST && rc != -DER_NOTAPPLICABLE)
+		return rc;
+
+	return evt_find(toh, filter, ioc->ic_ent_array);
+}
+
 /** Fetch an extent from an akey */
 static int
-akey_fetch_recx(daos_handle_t toh, const daos_epoch_range_t *epr,
+akey_fetch_recx(daos_handle_t toh, struct vos_krec_df *krec, const daos_epoch_range_t *epr,
 		daos_recx_t *recx, daos_epoch_t shadow_ep, daos_size_t *rsize_p,
 		struct vos_io_context *ioc)
 {
@@ -1081,7 +1157,7 @@ akey_fetch_recx(daos_handle_t toh, const daos_epoch_range_t *epr,
 		ioc->ic_akey_info.ii_prior_punch.pr_minor_epc;
 	evt_ent_array_init(ioc->ic_ent_array, 0);
 
-	rc = evt_find(toh, &filter, ioc->ic_ent_array);
+	rc = akey_find_visible(ioc, toh, krec, &filter);
 	if (rc != 0 || vos_dtx_hit_inprogress(standalone))
 		D_GOTO(failed, rc = (rc == 0 ? -DER_INPROGRESS : rc));
 
@@ -1384,7 +1460,7 @@ has_uncertainty(const struct vos_io_context *ioc,
 
 static int
 fetch_value(struct vos_io_context *ioc, daos_iod_t *iod, daos_handle_t toh,
-	    const daos_epoch_range_t *epr, bool standalone)
+	    struct vos_krec_df *krec, const daos_epoch_range_t *epr, bool standalone)
 {
 	struct daos_recx_ep_list *shadow;
 	int                       rc = 0;
@@ -1419,7 +1495,7 @@ fetch_value(struct vos_io_context *ioc, daos_iod_t *iod, daos_handle_t toh,
 		while (iod_recx.rx_nr > 0) {
 			akey_fetch_recx_get(&iod_recx, shadow, &fetch_recx,
 					    &shadow_ep);
-			rc = akey_fetch_recx(toh, epr, &fetch_recx, shadow_ep, &rsize, ioc);
+			rc = akey_fetch_recx(toh, krec, epr, &fetch_recx, shadow_ep, &rsize, ioc);
 
 			if (vos_dtx_continue_detect(rc, standalone))
 				continue;
@@ -1531,7 +1607,7 @@ akey_fetch(struct vos_io_context *ioc, daos_handle_t ak_toh)
 	}
 
 fetch_value:
-	rc = fetch_value(ioc, iod, toh, &val_epr, standalone);
+	rc = fetch_value(ioc, iod, toh, krec, &val_epr, standalone);
 out:
 	if (daos_handle_is_valid(toh))
 		key_tree_release(toh, is_array);
@@ -1617,7 +1693,7 @@ dkey_fetch(struct vos_io_context *ioc, daos_key_t *dkey)
 fetch_akey:
 	if (krec->kr_bmap & KREC_BF_NO_AKEY) {
 		iod_set_cursor(ioc, 0);
-		rc = fetch_value(ioc, &ioc->ic_iods[0], toh, &ioc->ic_epr, standalone);
+		rc = fetch_value(ioc, &ioc->ic_iods[0], toh, krec, &ioc->ic_epr, standalone);
 	} else {
 		for (i = 0; i < ioc->ic_iod_nr; i++) {
 			iod_set_cursor(ioc, i);
@@ -2768,6 +2768,9 @@ vos_obj_iter_process(struct vos_iterator *iter, vos_iter_proc_op_t op,
 {
 	struct vos_obj_iter *oiter = vos_iter2oiter(iter);
 
+	if (oiter->it_obj != NULL)
+		vos_obj_vis_invalidate(oiter->it_obj);
+
 	switch (op) {
 	case VOS_ITER_PROC_OP_DELETE:
 		switch (iter->it_type) {
@@ -28,6 +28,52 @@
 /* Internal container handle structure */
 struct vos_container;
 
+/** Number of array akeys with cached visible extents per object */
+#define VOS_VIS_CACHE_SLOTS	4
+/** Maximum number of visible extents cached for one akey */
+#define VOS_VIS_CACHE_ENTS	256
+/** Bytes of the array looked up on visibility cache miss */
+#define VOS_VIS_CACHE_WINDOW	(1UL << 20)
+
+/**
+ * Visible extents of an array akey returned by evt_find() over an extent
+ * window, reused by following fetches of neighboring ranges.
+ */
+struct vos_vis_slot {
+	/** The akey record, NULL for unused slot */
+	struct vos_krec_df		*vs_krec;
+	/** Sorted visible extents */
+	struct evt_entry		*vs_ents;
+	/** Object generation when the slot was filled */
+	uint64_t			 vs_gen;
+	/** Object max write epoch when the slot was filled */
+	daos_epoch_t			 vs_max_write;
+	/** Low epoch of the filter */
+	daos_epoch_t			 vs_epr_lo;
+	/** Higher level punch epoch of the filter */
+	daos_epoch_t			 vs_punch_epc;
+	/** Extent window looked up */
+	struct evt_extent		 vs_ext;
+	/** Number of bytes per index */
+	uint32_t			 vs_inob;
+	/** Number of entries in vs_ents */
+	uint32_t			 vs_ent_nr;
+	/** Number of entries allocated for vs_ents */
+	uint32_t			 vs_ent_cap;
+	/** Last access tick for replacement */
+	uint32_t			 vs_tick;
+	/** Minor epoch of higher level punch */
+	uint16_t			 vs_punch_minor_epc;
+	/** The window has too many or not yet committed extents, don't look it up again */
+	uint16_t			 vs_uncacheable:1;
+};
+
+/** Per-object visibility cache */
+struct vos_vis_cache {
+	uint32_t			 vc_tick;
+	struct vos_vis_slot		 vc_slots[VOS_VIS_CACHE_SLOTS];
+};
+
 /**
  * A cached object (DRAM data structure).
  */
@@ -50,6 +96,10 @@ struct vos_object {
 	struct vos_container		*obj_cont;
 	/* Handle for the pinned object */
 	struct umem_pin_handle		*obj_pin_hdl;
+	/** Visible extents cache of recently fetched array akeys */
+	struct vos_vis_cache		*obj_vis_cache;
+	/** Bumped on object modification, invalidates obj_vis_cache */
+	uint64_t			 obj_vis_gen;
 	/** Bucket IDs for the object */
 	uint32_t			obj_bkt_ids[VOS_OBJ_BKTS_MAX];
 	ABT_mutex			obj_mutex;
@@ -124,6 +174,35 @@ void vos_obj_evict(struct vos_object *obj);
 
 int vos_obj_evict_by_oid(struct vos_container *cont, daos_unit_oid_t oid);
 
+/**
+ * Look up visible extents of akey \a krec matching \a filter in the object
+ * visibility cache, clipped to the filter extent.
+ *
+ * \return	0			Cache hit, \a ent_array is filled
+ *		-DER_NONEXIST		Cache miss
+ *		-DER_NOTAPPLICABLE	The window is known to be uncacheable
+ *		-DER_NOMEM		Out of memory
+ */
+int
+vos_obj_vis_lookup(struct vos_object *obj, struct vos_krec_df *krec,
+		   const struct evt_filter *filter, struct evt_entry_array *ent_array);
+
+/**
+ * Save the visible extents \a ent_array returned by evt_find() with \a filter
+ * on akey \a krec into the object visibility cache. If they are not cacheable,
+ * the window is remembered as such until the object is modified.
+ */
+void
+vos_obj_vis_save(struct vos_object *obj, struct vos_krec_df *krec,
+		 const struct evt_filter *filter, struct evt_entry_array *ent_array);
+
+/** Invalidate cached visible extents of the object, called on modification */
+static inline void
+vos_obj_vis_invalidate(struct vos_object *obj)
+{
+	obj->obj_vis_gen++;
+}
+
 static inline bool
 vos_obj_is_evicted(struct vos_object *obj)
 {
@@ -27,6 +27,9 @@
 #include "vos_internal.h"
 #include <daos_errno.h>
 
+/** Look up visible extents through the object visibility cache, DAOS_VOS_VIS_CACHE */
+bool vos_vis_cache_enabled = true;
+
 /**
  * Local type for VOS LRU key
  * VOS LRU key must consist of
@@ -136,9 +139,24 @@ obj_lop_rec_hash(struct daos_llink *llink)
 	return d_hash_string_u32((const char *)&lkey, sizeof(lkey));
 }
 
+static void
+obj_vis_cache_free(struct vos_object *obj)
+{
+	struct vos_vis_cache	*cache = obj->obj_vis_cache;
+	int			 i;
+
+	if (cache == NULL)
+		return;
+
+	for (i = 0; i < VOS_VIS_CACHE_SLOTS; i++)
+		D_FREE(cache->vc_slots[i].vs_ents);
+	D_FREE(obj->obj_vis_cache);
+}
+
 static inline void
 clean_object(struct vos_object *obj)
 {
+	obj_vis_cache_free(obj);
 	vos_ilog_fetch_finish(&obj->obj_ilog_info);
 	if (obj->obj_cont != NULL)
 		vos_cont_decref(obj->obj_cont);
@@ -424,6 +442,9 @@ vos_obj_release(struct vos_object *obj, uint64_t flags, bool evict)
 	else if (flags & VOS_OBJ_DISCARD)
 		obj->obj_discard = 0;
 
+	if (flags & (VOS_OBJ_AGGREGATE | VOS_OBJ_DISCARD))
+		vos_obj_vis_invalidate(obj);
+
 	obj_release(occ, obj, evict);
 }
 
@@ -672,6 +693,10 @@ vos_obj_hold(struct vos_container *cont, daos_unit_oid_t oid, daos_epoch_range_t
 	if (obj->obj_zombie)
 		D_GOTO(failed, rc = -DER_AGAIN);
 
+	/* Any hold other than plain fetch may modify the object */
+	if (intent != DAOS_INTENT_DEFAULT || (flags & (VOS_OBJ_AGGREGATE | VOS_OBJ_DISCARD)))
+		vos_obj_vis_invalidate(obj);
+
 	if (check_discard(obj, flags)) {
 		/** Cleanup so unit test that triggers doesn't corrupt the state */
 		obj_release(occ, obj, false);
@@ -784,6 +809,125 @@ fail_log:
 	return	rc;
 }
 
+static bool
+obj_vis_slot_match(struct vos_object *obj, struct vos_vis_slot *slot,
+		   const struct evt_filter *filter)
+{
+	/* The tree is unchanged, and all writes are below the requested epoch so neither
+	 * the epoch nor the uncertainty range alters the visible extents.
+	 */
+	return slot->vs_gen == obj->obj_vis_gen &&
+	       slot->vs_max_write == obj->obj_df->vo_max_write &&
+	       filter->fr_epoch >= slot->vs_max_write &&
+	       filter->fr_epr.epr_lo == slot->vs_epr_lo &&
+	       filter->fr_punch_epc == slot->vs_punch_epc &&
+	       filter->fr_punch_minor_epc == slot->vs_punch_minor_epc &&
+	       filter->fr_ex.ex_lo >= slot->vs_ext.ex_lo &&
+	       filter->fr_ex.ex_hi <= slot->vs_ext.ex_hi;
+}
+
+int
+vos_obj_vis_lookup(struct vos_object *obj, struct vos_krec_df *krec,
+		   const struct evt_filter *filter, struct evt_entry_array *ent_array)
+{
+	struct vos_vis_cache	*cache = obj->obj_vis_cache;
+	struct vos_vis_slot	*slot;
+	int			 i;
+
+	if (cache == NULL || obj->obj_df == NULL)
+		return -DER_NONEXIST;
+
+	for (i = 0; i < VOS_VIS_CACHE_SLOTS; i++) {
+		slot = &cache->vc_slots[i];
+		if (slot->vs_krec != krec)
+			continue;
+
+		if (!obj_vis_slot_match(obj, slot, filter))
+			return -DER_NONEXIST;
+
+		slot->vs_tick = ++cache->vc_tick;
+		if (slot->vs_uncacheable)
+			return -DER_NOTAPPLICABLE;
+
+		return evt_ent_array_load(ent_array, slot->vs_ents, slot->vs_ent_nr,
+					  slot->vs_inob, &filter->fr_ex);
+	}
+
+	return -DER_NONEXIST;
+}
+
+void
+vos_obj_vis_save(struct vos_object *obj, struct vos_krec_df *krec,
+		 const struct evt_filter *filter, struct evt_entry_array *ent_array)
+{
+	struct vos_vis_cache	*cache;
+	struct vos_vis_slot	*slot = NULL;
+	struct evt_entry	*ent;
+	bool			 uncacheable = false;
+	int			 i;
+
+	if (obj->obj_df == NULL || filter->fr_epoch < obj->obj_df->vo_max_write)
+		return;
+
+	/* Extents of not yet committed or aborted DTX may change visibility later */
+	if (ent_array->ea_unavail_nr != 0 || ent_array->ea_ent_nr > VOS_VIS_CACHE_ENTS) {
+		uncacheable = true;
+	} else {
+		evt_ent_array_for_each(ent, ent_array) {
+			if (ent->en_avail_rc != ALB_AVAILABLE_CLEAN) {
+				uncacheable = true;
+				break;
+			}
+		}
+	}
+
+	if (obj->obj_vis_cache == NULL) {
+		D_ALLOC_PTR(obj->obj_vis_cache);
+		if (obj->obj_vis_cache == NULL)
+			return;
+	}
+	cache = obj->obj_vis_cache;
+
+	for (i = 0; i < VOS_VIS_CACHE_SLOTS; i++) {
+		if (cache->vc_slots[i].vs_krec == krec) {
+			slot = &cache->vc_slots[i];
+			break;
+		}
+		if (slot == NULL || cache->vc_slots[i].vs_tick < slot->vs_tick)
+			slot = &cache->vc_slots[i];
+	}
+
+	slot->vs_krec = NULL;
+	if (uncacheable) {
+		slot->vs_ent_nr = 0;
+	} else {
+		if (slot->vs_ent_cap < ent_array->ea_ent_nr) {
+			D_FREE(slot->vs_ents);
+			slot->vs_ent_cap = 0;
+			D_ALLOC_ARRAY(slot->vs_ents, ent_array->ea_ent_nr);
+			if (slot->vs_ents == NULL)
+				return;
+			slot->vs_ent_cap = ent_array->ea_ent_nr;
+		}
+
+		i = 0;
+		evt_ent_array_for_each(ent, ent_array)
+			slot->vs_ents[i++] = *ent;
+		slot->vs_ent_nr = ent_array->ea_ent_nr;
+	}
+
+	slot->vs_krec            = krec;
+	slot->vs_uncacheable     = uncacheable;
+	slot->vs_inob            = ent_array->ea_inob;
+	slot->vs_gen             = obj->obj_vis_gen;
+	slot->vs_max_write       = obj->obj_df->vo_max_write;
+	slot->vs_epr_lo          = filter->fr_epr.epr_lo;
+	slot->vs_punch_epc       = filter->fr_punch_epc;
+	slot->vs_punch_minor_epc = filter->fr_punch_minor_epc;
+	slot->vs_ext             = filter->fr_ex;
+	slot->vs_tick            = ++cache->vc_tick;
+}
+
 void
 vos_obj_evict(struct vos_object *obj)
 {
@@ -984,6 +1128,8 @@ vos_obj_acquire(struct vos_container *cont, daos_unit_oid_t oid, bool pin,
 		return -DER_AGAIN;
 	}
 
+	vos_obj_vis_invalidate(obj);
+
 	/* Lookup OI table if the cached object is negative */
 	if (obj->obj_df == NULL) {
 		obj->obj_sync_epoch = 0;
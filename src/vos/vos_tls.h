@@ -66,6 +66,8 @@ struct vos_tls {
 	};
 	struct d_tm_node_t		 *vtl_committed;
 	struct d_tm_node_t		 *vtl_invalid_dtx;
+	struct d_tm_node_t		 *vtl_dtx_cmt_filter_neg;
+	struct d_tm_node_t		 *vtl_dtx_cmt_filter_fp;
 	struct d_tm_node_t		 *vtl_obj_cnt;
 	struct d_tm_node_t		 *vtl_lru_alloc_size;
 };